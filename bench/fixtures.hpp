@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file fixtures.hpp
+ * @brief Shared, deterministic inputs for the battlemon benchmarks
+ *
+ * Every benchmark draws its inputs from fixed seeds so runs are comparable
+ * across commits: the same rental pairs, the same damage parameters and the
+ * same battle RNG streams every time.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "data/move.hpp"
+#include "data/rental_packed.hpp"
+#include "logic/calc/damage.hpp"
+#include "logic/setup/rental.hpp"
+#include "logic/state/context.hpp"
+#include "logic/state/field.hpp"
+#include "logic/state/side.hpp"
+#include "types/models/move.hpp"
+#include "util/random.hpp"
+
+namespace bench {
+
+/// Seed every benchmark input is derived from
+inline constexpr uint64_t BENCH_SEED = 0xBA771E5EEDull;
+
+// Inputs cycle through a power-of-two pool so indexing is a mask
+inline constexpr size_t INPUT_POOL = 1024;
+
+// ============================================================================
+//                               RENTAL PAIRS
+// ============================================================================
+
+struct RentalPair {
+    uint16_t p1;
+    uint16_t p2;
+    uint64_t seed;  // Battle seed (policy stream is derived from it)
+};
+
+/// INPUT_POOL rental pairs with their battle seeds
+inline std::vector<RentalPair> make_rental_pairs() {
+    util::random::Rng rng{};
+    rng.seed(BENCH_SEED, 1);
+
+    std::vector<RentalPair> pairs(INPUT_POOL);
+    for (auto& pair : pairs) {
+        pair.p1 = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+        pair.p2 = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+        pair.seed = util::random::mix64(rng.next());
+    }
+    return pairs;
+}
+
+// ============================================================================
+//                             DAMAGE PARAMETERS
+// ============================================================================
+
+/// INPUT_POOL damage inputs drawn from real rental matchups and their moves
+inline std::vector<logic::calc::DamageParams> make_damage_params() {
+    util::random::Rng rng{};
+    rng.seed(BENCH_SEED, 2);
+
+    std::vector<logic::calc::DamageParams> params(INPUT_POOL);
+    for (auto& p : params) {
+        const size_t atk_index = rng.random(logic::setup::RENTAL_COUNT);
+        const size_t def_index = rng.random(logic::setup::RENTAL_COUNT);
+        const types::Rental atk_rental = data::rental(atk_index);
+        const auto atk = logic::setup::setup_rental(atk_index, 50);
+        const auto def = logic::setup::setup_rental(def_index, 50);
+        const auto& move = data::g_MOVE_HOT[static_cast<size_t>(atk_rental.moves[rng.random(4)])];
+
+        const bool physical = logic::calc::is_physical_type(move.type);
+        p.level = 50;
+        p.attack = physical ? atk.active.attack : atk.active.sp_attack;
+        p.attack_stage = static_cast<int8_t>(rng.random(5)) - 2;
+        p.attacker_type1 = atk.active.type1;
+        p.attacker_type2 = atk.active.type2;
+        p.defense = physical ? def.active.defense : def.active.sp_defense;
+        p.defense_stage = static_cast<int8_t>(rng.random(5)) - 2;
+        p.defender_type1 = def.active.type1;
+        p.defender_type2 = def.active.type2;
+        p.power = move.power ? move.power : 40;
+        p.move_type = move.type;
+    }
+    return params;
+}
+
+// ============================================================================
+//                              EFFECT FIXTURE
+// ============================================================================
+//
+// A wired BattleContext over two rentals (attacker = side 0) for running a
+// single move effect. reset() restores the pristine state so every iteration
+// executes the effect from the same starting point; its cost is measured on
+// its own by the meso "reset" baseline.
+//
+// ============================================================================
+
+struct EffectFixture {
+    dsl::BattleState state{};
+    util::random::Rng rng{};
+    dsl::BattleContext ctx{};
+
+    dsl::BattleState pristine{};
+
+    EffectFixture(const types::Rental& attacker, const types::Rental& defender) {
+        logic::setup::setup_battle(ctx, pristine, attacker, defender, 50);
+        ctx.state = &state;
+        ctx.rng = &rng;
+
+        rng.seed(BENCH_SEED, 3);
+        reset();
+    }
+
+    void reset() {
+        state = pristine;
+        ctx.result = dsl::EffectResult{};
+        ctx.override = dsl::DamageOverride{};
+        ctx.loop_iteration = 0;
+    }
+
+    void use(types::enums::Move move) {
+        ctx.move = &data::g_MOVE_HOT[static_cast<size_t>(move)];
+    }
+};
+
+}  // namespace bench
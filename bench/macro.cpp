@@ -0,0 +1,125 @@
+/**
+ * @file macro.cpp
+ * @brief Macro benchmarks: whole turns and whole battles
+ *
+ * Battles come from a fixed pool of rental pairs and seeds
+ * (bench::make_rental_pairs()), played with the uniform random move policy.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/battle.hpp"
+#include "engine/observation.hpp"
+#include "engine/policy.hpp"
+#include "engine/simulate.hpp"
+#include "fixtures.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+struct PreparedBattle {
+    engine::BattleEngine battle;
+    engine::BattleEngine::Snapshot start;
+    util::random::Rng policy_rng;
+};
+
+std::vector<PreparedBattle> prepare_battles(uint8_t level) {
+    const auto pairs = bench::make_rental_pairs();
+
+    std::vector<PreparedBattle> battles(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        util::random::Rng root{};
+        root.seed(pairs[i].seed, pairs[i].seed);
+
+        auto& prepared = battles[i];
+        prepared.battle.init(pairs[i].p1, pairs[i].p2, level, root.split(0));
+        prepared.start = prepared.battle.save();
+        prepared.policy_rng = root.split(1);
+    }
+    return battles;
+}
+
+// ============================================================================
+//                                 TURNS
+// ============================================================================
+
+// Turns are played through the battle pool; a finished battle is restored to
+// its starting snapshot (restore cost is included, roughly once per 6 turns)
+void BM_ExecuteTurn(benchmark::State& state) {
+    auto battles = prepare_battles(static_cast<uint8_t>(state.range(0)));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto& prepared = battles[i++ & (bench::INPUT_POOL - 1)];
+        auto& battle = prepared.battle;
+        if (battle.result() != engine::BattleResult::ONGOING) {
+            battle.restore(prepared.start);
+        }
+        const auto p1 = engine::random_move_policy(battle, 0, prepared.policy_rng);
+        const auto p2 = engine::random_move_policy(battle, 1, prepared.policy_rng);
+        battle.execute_turn(p1, p2);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteTurn)->Arg(50)->Arg(100);
+
+// ============================================================================
+//                                BATTLES
+// ============================================================================
+
+// Complete battles from init() onwards, reported as battles/s
+void BM_FullBattle(benchmark::State& state) {
+    const uint8_t level = static_cast<uint8_t>(state.range(0));
+    const auto pairs = bench::make_rental_pairs();
+
+    engine::BattleEngine battle{};
+    size_t turns = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& pair = pairs[i++ & (bench::INPUT_POOL - 1)];
+        util::random::Rng root{};
+        root.seed(pair.seed, pair.seed);
+        util::random::Rng policy_rng = root.split(1);
+
+        battle.init(pair.p1, pair.p2, level, root.split(0));
+        const auto outcome = engine::run_battle(battle, engine::random_move_policy,
+                                                engine::random_move_policy, policy_rng);
+        turns += outcome.turns;
+        benchmark::DoNotOptimize(outcome);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["turns/battle"] =
+        benchmark::Counter(static_cast<double>(turns) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_FullBattle)->Arg(50)->Arg(100);
+
+// ============================================================================
+//                              OBSERVATIONS
+// ============================================================================
+
+// The whole pool encoded into one contiguous buffer per iteration, reported
+// as observations/s
+template <typename T>
+void BM_EncodeObservations(benchmark::State& state) {
+    const auto battles = prepare_battles(50);
+    std::vector<const engine::BattleEngine*> pool(battles.size());
+    for (size_t i = 0; i < battles.size(); ++i) {
+        pool[i] = &battles[i].battle;
+    }
+    std::vector<T> out(pool.size() * engine::OBSERVATION_SIZE);
+
+    for (auto _ : state) {
+        engine::encode_observations(pool.data(), pool.size(), 0, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pool.size()));
+}
+BENCHMARK(BM_EncodeObservations<float>);
+BENCHMARK(BM_EncodeObservations<int8_t>);
+
+}  // namespace
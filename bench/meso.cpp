@@ -0,0 +1,112 @@
+/**
+ * @file meso.cpp
+ * @brief Meso benchmarks: move effect routines through dispatch_move_effect
+ *
+ * One benchmark per implemented routine (named after the routine, run with a
+ * move that maps to it), plus a sweep over the whole move table. Stubbed
+ * effects currently dispatch to Hit, so replacing a stub with its real routine
+ * shows up in the sweep.
+ *
+ * Every iteration starts from the same state (EffectFixture::reset()); the
+ * "Reset" benchmark measures that overhead on its own.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "data/move.hpp"
+#include "data/rental_packed.hpp"
+#include "engine/dispatch.hpp"
+#include "fixtures.hpp"
+#include "types/enums/move.hpp"
+
+namespace {
+
+using types::enums::Move;
+
+// Abra vs. Aipom: both Normal-hittable, no damage immunities
+bench::EffectFixture make_fixture() {
+    return bench::EffectFixture{data::rental(0), data::rental(1)};
+}
+
+void BM_Reset(benchmark::State& state) {
+    auto fixture = make_fixture();
+    fixture.use(Move::TACKLE);
+
+    for (auto _ : state) {
+        fixture.reset();
+        benchmark::DoNotOptimize(fixture.state);
+    }
+}
+BENCHMARK(BM_Reset);
+
+void BM_Dispatch(benchmark::State& state, Move move) {
+    auto fixture = make_fixture();
+    fixture.use(move);
+    const auto effect = fixture.ctx.move->effect;
+
+    for (auto _ : state) {
+        fixture.reset();
+        engine::dispatch_move_effect(effect, fixture.ctx);
+        benchmark::DoNotOptimize(fixture.state);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ============================================================================
+//                             ROUTINES
+// ============================================================================
+
+// hit.hpp
+BENCHMARK_CAPTURE(BM_Dispatch, Hit, Move::TACKLE);
+BENCHMARK_CAPTURE(BM_Dispatch, Absorb, Move::ABSORB);
+BENCHMARK_CAPTURE(BM_Dispatch, TakeDown, Move::TAKE_DOWN);
+BENCHMARK_CAPTURE(BM_Dispatch, DragonRage, Move::DRAGON_RAGE);
+BENCHMARK_CAPTURE(BM_Dispatch, PoisonHit, Move::POISON_STING);
+BENCHMARK_CAPTURE(BM_Dispatch, Pursuit, Move::PURSUIT);
+
+// stat.hpp
+BENCHMARK_CAPTURE(BM_Dispatch, AttackUp2, Move::SWORDS_DANCE);
+BENCHMARK_CAPTURE(BM_Dispatch, AttackDown1, Move::GROWL);
+BENCHMARK_CAPTURE(BM_Dispatch, Haze, Move::HAZE);
+
+// status.hpp
+BENCHMARK_CAPTURE(BM_Dispatch, Poison, Move::POISON_POWDER);
+BENCHMARK_CAPTURE(BM_Dispatch, Recover, Move::RECOVER);
+
+// field.hpp
+BENCHMARK_CAPTURE(BM_Dispatch, LightScreen, Move::LIGHT_SCREEN);
+BENCHMARK_CAPTURE(BM_Dispatch, Reflect, Move::REFLECT);
+BENCHMARK_CAPTURE(BM_Dispatch, Sandstorm, Move::SANDSTORM);
+BENCHMARK_CAPTURE(BM_Dispatch, SunnyDay, Move::SUNNY_DAY);
+BENCHMARK_CAPTURE(BM_Dispatch, RainDance, Move::RAIN_DANCE);
+BENCHMARK_CAPTURE(BM_Dispatch, HailEffect, Move::HAIL);
+BENCHMARK_CAPTURE(BM_Dispatch, MagicCoat, Move::MAGIC_COAT);
+
+// composite.hpp (SkyAttack from a reset state is always the charge turn)
+BENCHMARK_CAPTURE(BM_Dispatch, SkyAttack, Move::SKY_ATTACK);
+BENCHMARK_CAPTURE(BM_Dispatch, BatonPass, Move::BATON_PASS);
+BENCHMARK_CAPTURE(BM_Dispatch, PerishSong, Move::PERISH_SONG);
+
+// ============================================================================
+//                            MOVE TABLE SWEEP
+// ============================================================================
+
+// One move per iteration, cycling through every move in g_MOVE_HOT
+void BM_DispatchAllMoves(benchmark::State& state) {
+    auto fixture = make_fixture();
+
+    size_t i = 1;  // Skip Move::NONE
+    for (auto _ : state) {
+        fixture.reset();
+        fixture.ctx.move = &data::g_MOVE_HOT[i];
+        engine::dispatch_move_effect(fixture.ctx.move->effect, fixture.ctx);
+        benchmark::DoNotOptimize(fixture.state);
+        i = (i + 1 < data::MOVE_COUNT) ? i + 1 : 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DispatchAllMoves);
+
+}  // namespace
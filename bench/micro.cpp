@@ -0,0 +1,259 @@
+/**
+ * @file micro.cpp
+ * @brief Micro benchmarks: individual damage-pipeline calculations
+ *
+ * Each benchmark cycles through a fixed pool of realistic inputs so the
+ * compiler cannot fold the call and branch predictors see real variety.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "data/rental.hpp"
+#include "data/rental_packed.hpp"
+#include "data/species.hpp"
+#include "engine/battle_batch.hpp"
+#include "fixtures.hpp"
+#include "logic/calc/accuracy.hpp"
+#include "logic/calc/damage.hpp"
+#include "logic/calc/move_scores.hpp"
+#include "logic/calc/stat_stages.hpp"
+#include "logic/calc/stats.hpp"
+#include "logic/calc/type_effectiveness.hpp"
+#include "logic/setup/rental.hpp"
+#include "logic/state/packed.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using namespace logic::calc;
+
+// ============================================================================
+//                               DAMAGE
+// ============================================================================
+
+void BM_CalculateDamage(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+    util::random::Rng rng{};
+    rng.seed(bench::BENCH_SEED, 10);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculate_damage(rng, params[i++ & (bench::INPUT_POOL - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateDamage);
+
+void BM_CalculateDamageDistribution(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            calculate_damage_distribution(params[i++ & (bench::INPUT_POOL - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateDamageDistribution);
+
+void BM_BattleBatchResolve(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+    util::random::Rng rng{};
+    rng.seed(bench::BENCH_SEED, 10);
+
+    engine::BattleBatch<64> batch{};
+    size_t i = 0;
+    for (auto _ : state) {
+        for (size_t lane = 0; lane < batch.LANES; ++lane) {
+            batch.load_hit(lane, params[i++ & (bench::INPUT_POOL - 1)], rng);
+        }
+        batch.resolve();
+        benchmark::DoNotOptimize(batch.damage);
+    }
+    state.SetItemsProcessed(state.iterations() * batch.LANES);
+}
+BENCHMARK(BM_BattleBatchResolve);
+
+void BM_ScoreMoves(benchmark::State& state) {
+    const auto pairs = bench::make_rental_pairs();
+    std::vector<logic::setup::RentalSetup> setups(bench::INPUT_POOL);
+    std::vector<types::Rental> rentals(bench::INPUT_POOL);
+    for (size_t k = 0; k < bench::INPUT_POOL; ++k) {
+        setups[k] = logic::setup::setup_rental(pairs[k].p1, 50);
+        rentals[k] = data::rental(pairs[k].p1);
+    }
+
+    // 4 moves x 6 targets: the attacker's moves against the next six pool entries
+    size_t i = 0;
+    for (auto _ : state) {
+        const size_t a = i++ & (bench::INPUT_POOL - 1);
+        const types::MoveHot* moves[SCORE_MOVES];
+        for (uint8_t m = 0; m < SCORE_MOVES; ++m) {
+            moves[m] = &data::g_MOVE_HOT[static_cast<size_t>(rentals[a].moves[m])];
+        }
+        ScoreTarget targets[MAX_SCORE_TARGETS];
+        for (uint8_t t = 0; t < MAX_SCORE_TARGETS; ++t) {
+            const auto& target = setups[(a + 1 + t) & (bench::INPUT_POOL - 1)];
+            targets[t] = {&target.active, &target.slot};
+        }
+        benchmark::DoNotOptimize(score_moves(setups[a].active, setups[a].slot, moves, targets,
+                                             MAX_SCORE_TARGETS));
+    }
+    state.SetItemsProcessed(state.iterations() * SCORE_MOVES * MAX_SCORE_TARGETS);
+}
+BENCHMARK(BM_ScoreMoves);
+
+// ============================================================================
+//                           TYPE EFFECTIVENESS
+// ============================================================================
+
+void BM_TypeEffectiveness(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& p = params[i++ & (bench::INPUT_POOL - 1)];
+        benchmark::DoNotOptimize(
+            get_type_effectiveness(p.move_type, p.defender_type1, p.defender_type2));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TypeEffectiveness);
+
+// Cached per-mon row (ActiveMon::effectiveness_against)
+void BM_DefenseRowLookup(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+    std::vector<DefenseRow> rows;
+    rows.reserve(params.size());
+    for (const auto& p : params) {
+        rows.push_back(make_defense_row(p.defender_type1, p.defender_type2));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const size_t index = i++ & (bench::INPUT_POOL - 1);
+        benchmark::DoNotOptimize(rows[index][params[index].move_type]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DefenseRowLookup);
+
+// ============================================================================
+//                                 STATS
+// ============================================================================
+
+// Full calculation (what setup_rental did before the precomputed table)
+void BM_CalcStats(benchmark::State& state) {
+    const uint8_t level = static_cast<uint8_t>(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& rental = data::g_RENTAL_SETS[i++ % logic::setup::RENTAL_COUNT];
+        benchmark::DoNotOptimize(logic::setup::compute_rental_stats(rental, level));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalcStats)->Arg(50)->Arg(100);
+
+void BM_SetupRental(benchmark::State& state) {
+    const uint8_t level = static_cast<uint8_t>(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const size_t index = i++ % logic::setup::RENTAL_COUNT;
+        benchmark::DoNotOptimize(logic::setup::setup_rental(index, level));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetupRental)->Arg(50)->Arg(100);
+
+// One packed record -> types::Rental (what a table rental lookup costs)
+void BM_DecodeRental(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data::rental(i++ % logic::setup::RENTAL_COUNT));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeRental);
+
+// SlotState + MonState <-> storage form (search-node save and visit)
+void BM_PackSlotMon(benchmark::State& state) {
+    logic::state::SlotState slot{};
+    slot.atk_stage = 2;
+    slot.volatiles = logic::state::volatile_flags::CONFUSED;
+    slot.confusion_turns = 3;
+    logic::state::MonState mon{150, 180, logic::state::Status::BURN, 0, 1, {15, 10, 5, 20}};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(slot);
+        benchmark::DoNotOptimize(logic::state::pack(slot));
+        benchmark::DoNotOptimize(logic::state::pack(mon));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PackSlotMon);
+
+void BM_UnpackSlotMon(benchmark::State& state) {
+    logic::state::SlotState slot{};
+    slot.atk_stage = 2;
+    slot.volatiles = logic::state::volatile_flags::CONFUSED;
+    slot.confusion_turns = 3;
+    const logic::state::MonState mon{150, 180, logic::state::Status::BURN, 0, 1, {15, 10, 5, 20}};
+    logic::state::PackedSlotState packed_slot = logic::state::pack(slot);
+    logic::state::PackedMonState packed_mon = logic::state::pack(mon);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(packed_slot);
+        benchmark::DoNotOptimize(packed_mon);
+        benchmark::DoNotOptimize(logic::state::unpack(packed_slot));
+        benchmark::DoNotOptimize(logic::state::unpack(packed_mon));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnpackSlotMon);
+
+void BM_ApplyStatStage(benchmark::State& state) {
+    const auto params = bench::make_damage_params();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& p = params[i & (bench::INPUT_POOL - 1)];
+        const int8_t stage = static_cast<int8_t>(i % 13) + MIN_STAT_STAGE;
+        benchmark::DoNotOptimize(apply_stat_stage(p.attack, stage));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ApplyStatStage);
+
+// ============================================================================
+//                               ACCURACY
+// ============================================================================
+
+void BM_CheckAccuracy(benchmark::State& state) {
+    util::random::Rng rng{};
+    rng.seed(bench::BENCH_SEED, 11);
+
+    std::vector<uint8_t> accuracy(bench::INPUT_POOL);
+    std::vector<int8_t> stages(bench::INPUT_POOL);
+    for (size_t i = 0; i < bench::INPUT_POOL; ++i) {
+        accuracy[i] = static_cast<uint8_t>(50 + rng.random(51));
+        stages[i] = static_cast<int8_t>(rng.random(5)) - 2;
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const size_t k = i++ & (bench::INPUT_POOL - 1);
+        benchmark::DoNotOptimize(
+            check_accuracy(rng, accuracy[k], stages[k], stages[(k + 1) & (bench::INPUT_POOL - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CheckAccuracy);
+
+}  // namespace
@@ -0,0 +1,232 @@
+#include "batch.hpp"
+
+#include <algorithm>
+
+#include "data/rental.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+namespace {
+
+constexpr uint16_t RENTAL_COUNT = sizeof(data::g_RENTAL_SETS) / sizeof(data::g_RENTAL_SETS[0]);
+
+constexpr uint64_t pack_range(size_t begin, size_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | static_cast<uint32_t>(end);
+}
+
+constexpr size_t range_begin(uint64_t range) { return static_cast<size_t>(range >> 32); }
+constexpr size_t range_end(uint64_t range) { return static_cast<size_t>(range & 0xFFFFFFFFu); }
+
+}  // namespace
+
+// ============================================================================
+//                               BATCH JOBS
+// ============================================================================
+
+BattleOutcome run_job(const BatchJob& job, BattleLogWriter* log) {
+    util::random::Rng root{};
+    root.seed(job.seed, job.seed);
+
+    BattleEngine battle;
+    battle.set_common_random_numbers(job.common_random_numbers);
+    battle.init(job.rental_a, job.rental_b, job.level, root.split(0));
+
+    battle.attach_log(log);
+
+    util::random::Rng policy_rng = root.split(1);
+    const BattleOutcome outcome =
+        run_battle(battle, job.policy_a, job.policy_b, policy_rng, job.max_turns);
+    if (log) {
+        log->finish(checkpoint_fingerprint(battle));
+    }
+    return outcome;
+}
+
+std::vector<BatchJob> make_sweep_jobs(uint64_t master_seed, uint8_t level, Policy policy) {
+    std::vector<BatchJob> jobs(static_cast<size_t>(RENTAL_COUNT) * RENTAL_COUNT);
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        auto& job = jobs[i];
+        job.rental_a = static_cast<uint16_t>(i / RENTAL_COUNT);
+        job.rental_b = static_cast<uint16_t>(i % RENTAL_COUNT);
+        job.policy_a = policy;
+        job.policy_b = policy;
+        job.seed = util::random::mix64(master_seed + i);
+        job.level = level;
+    }
+    return jobs;
+}
+
+BatchTotals summarize(std::span<const BattleOutcome> outcomes) {
+    BatchTotals totals{};
+    for (const auto& outcome : outcomes) {
+        totals.turns += outcome.turns;
+        switch (outcome.result) {
+            case BattleResult::P1_WINS:
+                ++totals.p1_wins;
+                break;
+            case BattleResult::P2_WINS:
+                ++totals.p2_wins;
+                break;
+            case BattleResult::ONGOING:
+                ++totals.unfinished;
+                break;
+        }
+    }
+    return totals;
+}
+
+// ============================================================================
+//                              BATCH RUNNER
+// ============================================================================
+
+BatchRunner::BatchRunner(unsigned thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    worker_count_ = thread_count;
+    queues_ = std::make_unique<WorkQueue[]>(worker_count_);
+
+    threads_.reserve(worker_count_ - 1);
+    for (unsigned worker = 1; worker < worker_count_; ++worker) {
+        threads_.emplace_back(&BatchRunner::worker_main, this, worker);
+    }
+}
+
+BatchRunner::~BatchRunner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void BatchRunner::run(std::span<const BatchJob> jobs, std::span<BattleOutcome> results) {
+    const RangeFn fn = [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = run_job(jobs[i]);
+        }
+    };
+    parallel_for(jobs.size(), fn);
+}
+
+std::vector<BattleOutcome> BatchRunner::run(std::span<const BatchJob> jobs) {
+    std::vector<BattleOutcome> results(jobs.size());
+    run(jobs, results);
+    return results;
+}
+
+void BatchRunner::parallel_for(size_t count, const RangeFn& fn, size_t grain) {
+    if (count == 0) {
+        return;
+    }
+
+    // Even split up front; stealing rebalances whatever turns out uneven
+    const size_t per_worker = (count + worker_count_ - 1) / worker_count_;
+    for (unsigned worker = 0; worker < worker_count_; ++worker) {
+        const size_t begin = std::min(count, per_worker * worker);
+        const size_t end = std::min(count, begin + per_worker);
+        queues_[worker].range.store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &fn;
+        grain_ = std::max<size_t>(1, grain);
+        running_ = worker_count_ - 1;
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return running_ == 0; });
+    task_ = nullptr;
+}
+
+void BatchRunner::worker_main(unsigned worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--running_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+void BatchRunner::drain(unsigned worker) {
+    size_t begin = 0;
+    size_t end = 0;
+    do {
+        while (pop(worker, begin, end)) {
+            (*task_)(worker, begin, end);
+        }
+    } while (steal(worker));
+}
+
+bool BatchRunner::pop(unsigned worker, size_t& begin, size_t& end) {
+    auto& range = queues_[worker].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+
+    for (;;) {
+        const size_t first = range_begin(current);
+        const size_t last = range_end(current);
+        if (first >= last) {
+            return false;
+        }
+
+        const size_t next = std::min(last, first + grain_);
+        if (range.compare_exchange_weak(current, pack_range(next, last),
+                                        std::memory_order_acq_rel)) {
+            begin = first;
+            end = next;
+            return true;
+        }
+    }
+}
+
+bool BatchRunner::steal(unsigned thief) {
+    for (unsigned offset = 1; offset < worker_count_; ++offset) {
+        auto& victim = queues_[(thief + offset) % worker_count_].range;
+        uint64_t current = victim.load(std::memory_order_acquire);
+
+        for (;;) {
+            const size_t first = range_begin(current);
+            const size_t last = range_end(current);
+            if (first >= last) {
+                break;
+            }
+
+            // Take the back half (or everything if it's down to one chunk)
+            const size_t remaining = last - first;
+            const size_t split = (remaining <= grain_) ? first : first + remaining / 2;
+            if (victim.compare_exchange_weak(current, pack_range(first, split),
+                                             std::memory_order_acq_rel)) {
+                // Our own queue is empty, and thieves never write an empty range
+                queues_[thief].range.store(pack_range(split, last), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+}  // namespace engine
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file batch.hpp
+ * @brief Multithreaded batch battle simulation (host only)
+ *
+ * BatchRunner plays many independent battles on a persistent work-stealing
+ * thread pool. Every battle owns its RNG stream (derived from the job seed),
+ * so results are bit-identical regardless of thread count or scheduling.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "engine/battle_log.hpp"
+#include "engine/policy.hpp"
+#include "engine/simulate.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                               BATCH JOBS
+// ============================================================================
+
+/// One battle to simulate: rentals are indices into data::g_RENTAL_SETS
+struct BatchJob {
+    uint16_t rental_a{0};
+    uint16_t rental_b{0};
+    Policy policy_a{random_move_policy};
+    Policy policy_b{random_move_policy};
+    uint64_t seed{0};  // Battle and policy streams are derived from this alone
+    uint8_t level{50};
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+    bool common_random_numbers{false};  // See BattleEngine::set_common_random_numbers()
+};
+
+/// Aggregate of a batch of outcomes
+struct BatchTotals {
+    uint64_t p1_wins{0};
+    uint64_t p2_wins{0};
+    uint64_t unfinished{0};
+    uint64_t turns{0};
+};
+
+/**
+ * @brief Play a single job to completion (what each worker runs).
+ *
+ * Deterministic in the job alone: rerun any outlier from its BatchJob.
+ *
+ * @param job Battle to play
+ * @param log Optional writer that receives the finished battle log
+ */
+BattleOutcome run_job(const BatchJob& job, BattleLogWriter* log = nullptr);
+
+/**
+ * @brief Jobs for a full g_RENTAL_SETS x g_RENTAL_SETS sweep.
+ *
+ * Job i plays (i / N) vs (i % N) with seed mix64(master_seed + i).
+ */
+std::vector<BatchJob> make_sweep_jobs(uint64_t master_seed, uint8_t level = 50,
+                                      Policy policy = random_move_policy);
+
+/// Sum outcomes into win/turn totals
+BatchTotals summarize(std::span<const BattleOutcome> outcomes);
+
+// ============================================================================
+//                              BATCH RUNNER
+// ============================================================================
+//
+// Work distribution:
+//   - The index space is cut into one contiguous range per worker
+//   - Owners pop `grain`-sized chunks from the front of their range
+//   - Idle workers steal the back half of another worker's range
+//   - A range is a packed (begin, end) pair updated by CAS, so the pool
+//     never takes a lock while work remains
+//
+// The calling thread participates as worker 0.
+//
+// ============================================================================
+
+class BatchRunner {
+   public:
+    /// Range callback: process indices [begin, end) on worker `worker`
+    using RangeFn = std::function<void(unsigned worker, size_t begin, size_t end)>;
+
+    /**
+     * @param thread_count Worker count including the caller (0 = all hardware threads)
+     */
+    explicit BatchRunner(unsigned thread_count = 0);
+    ~BatchRunner();
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    [[nodiscard]] unsigned thread_count() const { return worker_count_; }
+
+    /**
+     * @brief Simulate every job; results[i] is the outcome of jobs[i].
+     */
+    void run(std::span<const BatchJob> jobs, std::span<BattleOutcome> results);
+
+    [[nodiscard]] std::vector<BattleOutcome> run(std::span<const BatchJob> jobs);
+
+    /**
+     * @brief Run fn over [0, count) in work-stealing chunks.
+     *
+     * Blocks until every index has been processed. Worker ids are stable in
+     * [0, thread_count()) so callers can keep per-worker scratch state.
+     *
+     * @param count Number of indices
+     * @param fn Range callback
+     * @param grain Chunk size popped per step
+     */
+    void parallel_for(size_t count, const RangeFn& fn, size_t grain = 64);
+
+   private:
+    // Packed [begin, end) range, one cache line per worker
+    struct alignas(64) WorkQueue {
+        std::atomic<uint64_t> range{0};
+    };
+
+    void worker_main(unsigned worker);
+    void drain(unsigned worker);
+    bool pop(unsigned worker, size_t& begin, size_t& end);
+    bool steal(unsigned thief);
+
+    unsigned worker_count_{1};
+    std::unique_ptr<WorkQueue[]> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_{0};
+    unsigned running_{0};
+    bool stopping_{false};
+
+    const RangeFn* task_{nullptr};
+    size_t grain_{64};
+};
+
+}  // namespace engine
@@ -0,0 +1,309 @@
+#pragma once
+
+/**
+ * @file battle_batch.hpp
+ * @brief Lockstep hit resolution for N battles in structure-of-arrays lanes (host only)
+ *
+ * BattleBatch<N> holds one pending hit per battle, each input in its own
+ * contiguous lane array (attack, defense, stages, types, HP, ...), and
+ * resolves all N at once. The arithmetic steps of calculate_damage() --
+ * stat stages, base damage, crit multiplier, STAB, type effectiveness, the
+ * damage roll and the minimum / clamp -- are a pass over every lane each:
+ * straight-line loops with per-lane selects instead of branches, which the
+ * compiler vectorizes for the build's -march (AVX2, AVX-512, NEON) with no
+ * intrinsics in the source. Lanes without a hit (a miss, an empty slot)
+ * and forced or skipped rolls are masks too: a masked-out lane still runs
+ * the arithmetic and its result is discarded.
+ *
+ * The draws are lanes as well. Each lane's RNG is its own PCG32 stream
+ * (state and increment in two lane arrays), stepped only where the lane
+ * draws, in the order calculate_damage() draws: crit, then roll. Every
+ * lane is bit-exact with calculate_damage() on the same params and Rng,
+ * including the Rng state it leaves behind. The batch steps the lane
+ * streams directly: draw tapes and site streams (search-side, one battle
+ * at a time) are not consulted.
+ *
+ * Runtime divisions (by the defense, a stage ratio's denominator or a
+ * crit chance) are done in double precision. Every dividend fits in 32 bits
+ * and every divisor in 16, so the quotient is never within rounding of an
+ * integer it is not and truncating it gives the integer quotient.
+ *
+ * Typical use: fill lanes with load_hit(), resolve(), read damage[] and
+ * critical[], or apply_to_hp() after loading defender_hp[].
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "logic/calc/critical.hpp"
+#include "logic/calc/damage.hpp"
+#include "logic/calc/stat_stages.hpp"
+#include "logic/calc/type_effectiveness.hpp"
+#include "types/enums/type.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                              LANE KERNELS
+// ============================================================================
+
+namespace batch_detail {
+
+using logic::calc::TYPE_COUNT;
+
+/// n / d for n < 2^32, 0 < d < 2^16 (exact, see the file comment)
+inline uint32_t divide(uint32_t n, uint32_t d) {
+    return static_cast<uint32_t>(static_cast<double>(n) / static_cast<double>(d));
+}
+
+/// take ? a : b as a mask blend (several ?: in one loop stop GCC's if-conversion)
+inline uint32_t select(uint32_t take, uint32_t a, uint32_t b) {
+    const uint32_t mask = 0u - take;
+    return (a & mask) | (b & ~mask);
+}
+
+/// One PCG32 step (util::random::Rng::next) on a lane's state
+inline uint32_t pcg_output(uint64_t oldstate) {
+    const auto xorshifted = static_cast<uint32_t>(((oldstate >> 18u) ^ oldstate) >> 27u);
+    const auto rot = static_cast<uint32_t>(oldstate >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+// Lane tables: 32-bit entries, the width vector gathers load
+
+struct ChartTable {
+    uint32_t entries[TYPE_COUNT * TYPE_COUNT];
+};
+
+consteval ChartTable make_chart_table() {
+    ChartTable table{};
+    for (uint8_t atk = 0; atk < TYPE_COUNT; ++atk) {
+        for (uint8_t def = 0; def < TYPE_COUNT; ++def) {
+            table.entries[atk * TYPE_COUNT + def] = logic::calc::TYPE_CHART[atk][def];
+        }
+    }
+    return table;
+}
+
+/// TYPE_CHART flattened, [attacking * TYPE_COUNT + defending]
+inline constexpr ChartTable CHART = make_chart_table();
+
+struct StageTable {
+    uint32_t numerator[13];
+    uint32_t denominator[13];
+};
+
+consteval StageTable make_stage_table() {
+    StageTable table{};
+    for (uint8_t i = 0; i < 13; ++i) {
+        table.numerator[i] = logic::calc::STAT_STAGE_SCALES[i].numerator;
+        table.denominator[i] = logic::calc::STAT_STAGE_SCALES[i].denominator;
+    }
+    return table;
+}
+
+/// STAT_STAGE_SCALES as the ratio apply_stat_stage() computes on host
+inline constexpr StageTable STAGES = make_stage_table();
+
+/// CRIT_CHANCE by stage; stages past MAX_CRIT_STAGE read a 1 (and never draw)
+inline constexpr uint32_t CRIT_DENOMINATOR[8] = {
+    logic::calc::CRIT_CHANCE[0], logic::calc::CRIT_CHANCE[1], logic::calc::CRIT_CHANCE[2],
+    logic::calc::CRIT_CHANCE[3], logic::calc::CRIT_CHANCE[4], 1, 1, 1};
+
+static_assert(logic::calc::MAX_CRIT_STAGE == 4 && logic::calc::DAMAGE_ROLL_COUNT == 16,
+              "lane tables and the roll mask follow the Gen III constants");
+
+}  // namespace batch_detail
+
+// Per-lane flags
+namespace batch_flags {
+inline constexpr uint8_t HIT = 1 << 0;          // Lane has a hit to resolve
+inline constexpr uint8_t FORCE_CRIT = 1 << 1;   // DamageParams::is_critical
+inline constexpr uint8_t SKIP_RANDOM = 1 << 2;  // DamageParams::skip_random
+}  // namespace batch_flags
+
+// ============================================================================
+//                              BATTLE BATCH
+// ============================================================================
+
+template <size_t N>
+struct BattleBatch {
+    static_assert(N > 0 && N % 8 == 0, "lanes come in whole vectors of 8");
+
+    static constexpr size_t LANES = N;
+
+    // Hit inputs (load_hit)
+    alignas(64) uint32_t level[N];
+    alignas(64) uint32_t power[N];
+    alignas(64) uint32_t attack[N];
+    alignas(64) uint32_t defense[N];
+    alignas(64) int8_t attack_stage[N];
+    alignas(64) int8_t defense_stage[N];
+    alignas(64) uint8_t move_type[N];
+    alignas(64) uint8_t attacker_type1[N];
+    alignas(64) uint8_t attacker_type2[N];
+    alignas(64) uint8_t defender_type1[N];
+    alignas(64) uint8_t defender_type2[N];
+    alignas(64) uint16_t effectiveness[N];  // EFFECTIVENESS_FROM_TYPES = look it up
+    alignas(64) uint8_t crit_stage[N];
+    alignas(64) uint8_t flags[N];  // batch_flags
+
+    // Lane RNGs (util::random::Rng split into state and increment lanes)
+    alignas(64) uint64_t rng_state[N];
+    alignas(64) uint64_t rng_inc[N];
+
+    // Defender HP (apply_to_hp)
+    alignas(64) uint16_t defender_hp[N];
+
+    // Hit results (resolve); 0 on lanes without HIT. effectiveness[]
+    // then holds the resolved value.
+    alignas(64) uint16_t damage[N];
+    alignas(64) uint8_t critical[N];  // 1 = critical hit
+
+    /// Clear every lane to "no hit"
+    void clear() {
+        for (size_t i = 0; i < N; ++i) {
+            flags[i] = 0;
+        }
+    }
+
+    /// Queue `params` as lane `lane`'s hit, drawing from `lane_rng`
+    void load_hit(size_t lane, const logic::calc::DamageParams& params,
+                  const util::random::Rng& lane_rng) {
+        level[lane] = params.level;
+        power[lane] = params.power;
+        attack[lane] = params.attack;
+        defense[lane] = params.defense;
+        attack_stage[lane] = params.attack_stage;
+        defense_stage[lane] = params.defense_stage;
+        move_type[lane] = static_cast<uint8_t>(params.move_type);
+        attacker_type1[lane] = static_cast<uint8_t>(params.attacker_type1);
+        attacker_type2[lane] = static_cast<uint8_t>(params.attacker_type2);
+        defender_type1[lane] = static_cast<uint8_t>(params.defender_type1);
+        defender_type2[lane] = static_cast<uint8_t>(params.defender_type2);
+        effectiveness[lane] = params.effectiveness;
+        crit_stage[lane] = params.crit_stage;
+        flags[lane] = static_cast<uint8_t>(
+            batch_flags::HIT | (params.is_critical ? batch_flags::FORCE_CRIT : 0) |
+            (params.skip_random ? batch_flags::SKIP_RANDOM : 0));
+        rng_state[lane] = lane_rng.state;
+        rng_inc[lane] = lane_rng.inc;
+    }
+
+    /// Lane `lane`'s RNG as the hit left it
+    [[nodiscard]] util::random::Rng rng(size_t lane) const {
+        return util::random::Rng{rng_state[lane], rng_inc[lane]};
+    }
+
+    /// Resolve every lane's hit into damage[] and critical[]
+    void resolve() {
+        resolve_criticals();
+        resolve_effectiveness();
+        resolve_unrolled();
+        resolve_rolls();
+    }
+
+    /// Subtract each hit lane's damage from defender_hp (at least to 0)
+    void apply_to_hp() {
+        for (size_t i = 0; i < N; ++i) {
+            const uint16_t hp = defender_hp[i];
+            defender_hp[i] = hp > damage[i] ? static_cast<uint16_t>(hp - damage[i]) : 0;
+        }
+    }
+
+   private:
+    // ------------------------------------------------------------------------
+    // Passes, in calculate_damage() order. Each is one branch-free loop.
+    // ------------------------------------------------------------------------
+
+    /// Step lane i's PCG32 stream if `step`; the draw (meaningless otherwise)
+    uint32_t draw(size_t i, uint32_t step) {
+        const uint64_t oldstate = rng_state[i];
+        const uint64_t stepped = oldstate * util::random::PCG32_MULTIPLIER + rng_inc[i];
+        rng_state[i] = step ? stepped : oldstate;
+        return batch_detail::pcg_output(oldstate);
+    }
+
+    /// resolve_critical_hit(): roll_critical's chance(1, CRIT_CHANCE[stage]) draw
+    void resolve_criticals() {
+        using namespace batch_flags;
+        for (size_t i = 0; i < N; ++i) {
+            const uint32_t lane_flags = flags[i] & (HIT | FORCE_CRIT);
+            const uint32_t stage = crit_stage[i];
+            const uint32_t forced = lane_flags == (HIT | FORCE_CRIT);
+            const uint32_t rolls = (lane_flags == HIT) & (stage <= logic::calc::MAX_CRIT_STAGE);
+            const uint32_t value = draw(i, rolls);
+            const uint32_t chance = batch_detail::CRIT_DENOMINATOR[stage > 5 ? 5 : stage];
+            const uint32_t hit = value - chance * batch_detail::divide(value, chance) == 0;
+            critical[i] = static_cast<uint8_t>(forced | (rolls & hit));
+        }
+    }
+
+    /// resolve_effectiveness(): two chart loads and a multiply per lane
+    void resolve_effectiveness() {
+        const uint32_t* chart = batch_detail::CHART.entries;
+        for (size_t i = 0; i < N; ++i) {
+            const uint32_t row = move_type[i] * batch_detail::TYPE_COUNT;
+            const uint32_t looked_up = chart[row + defender_type1[i]] *
+                                       chart[row + defender_type2[i]];
+            const bool from_types = effectiveness[i] == logic::calc::EFFECTIVENESS_FROM_TYPES;
+            effectiveness[i] = static_cast<uint16_t>(from_types ? looked_up : effectiveness[i]);
+        }
+    }
+
+    /// calc_unrolled_damage(): stages, base damage, crit, STAB, effectiveness
+    void resolve_unrolled() {
+        using batch_detail::divide;
+        using batch_detail::select;
+        using batch_detail::STAGES;
+
+        for (size_t i = 0; i < N; ++i) {
+            // Crits ignore the attacker's drops and the defender's boosts
+            const uint32_t crit = critical[i];
+            const int32_t raw_atk_stage = attack_stage[i];
+            const int32_t raw_def_stage = defense_stage[i];
+            const int32_t atk_stage = raw_atk_stage & -int32_t(!(crit & (raw_atk_stage < 0)));
+            const int32_t def_stage = raw_def_stage & -int32_t(!(crit & (raw_def_stage > 0)));
+            const uint32_t atk = divide(attack[i] * STAGES.numerator[atk_stage + 6],
+                                        STAGES.denominator[atk_stage + 6]) &
+                                 0xFFFF;
+            const uint32_t staged_def = divide(defense[i] * STAGES.numerator[def_stage + 6],
+                                               STAGES.denominator[def_stage + 6]) &
+                                        0xFFFF;
+            const uint32_t def = select(staged_def == 0, 1u, staged_def);
+
+            uint32_t value = level[i] * 2u / 5u + 2u;
+            value = divide(value * power[i] * atk, def);
+            value = value / 50u + 2u;
+            value *= select(crit, logic::calc::CRIT_MULTIPLIER, 1u);
+
+            const uint32_t stab = (move_type[i] == attacker_type1[i]) |
+                                  (move_type[i] == attacker_type2[i]);
+            value = select(stab, value * 3u / 2u, value);
+            unrolled_[i] = value * effectiveness[i] / logic::calc::effectiveness::DUAL_NEUTRAL;
+        }
+    }
+
+    /// apply_random_variance() and the minimum / clamp of calculate_damage()
+    void resolve_rolls() {
+        using namespace batch_flags;
+        using batch_detail::select;
+        for (size_t i = 0; i < N; ++i) {
+            const uint32_t lane_flags = flags[i];
+            const uint32_t rolls = (lane_flags & (HIT | SKIP_RANDOM)) == HIT;
+            // random(16) is the low 4 bits; roll r is factor 100 - r
+            const uint32_t roll = draw(i, rolls) & 15u;
+            const uint32_t unrolled = unrolled_[i];
+            uint32_t value = select(rolls, unrolled * (100u - roll) / 100u, unrolled);
+
+            value = select((value == 0) & (effectiveness[i] != 0), 1u, value);
+            value = select(value > 0xFFFF, 0xFFFF, value);
+            damage[i] = static_cast<uint16_t>(select(lane_flags & HIT, value, 0));
+        }
+    }
+
+    alignas(64) uint32_t unrolled_[N];
+};
+
+}  // namespace engine
@@ -0,0 +1,71 @@
+#include "book_builder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "engine/battle_log.hpp"
+#include "util/table_cache.hpp"
+
+namespace engine::book {
+
+std::vector<BookEntry> build_opening_book(BatchRunner& runner, std::span<const uint16_t> leads,
+                                          const BookBuildOptions& options,
+                                          BookBuildStats* stats) {
+    std::vector<uint16_t> rentals(leads.begin(), leads.end());
+    std::sort(rentals.begin(), rentals.end());
+    rentals.erase(std::unique(rentals.begin(), rentals.end()), rentals.end());
+
+    const size_t count = rentals.size();
+    std::vector<BookEntry> entries(count * count);
+    if (entries.empty() || entries.size() > BOOK_MAX_ENTRIES)
+        return {};
+
+    ai::SearchLimits limits{};
+    limits.max_depth = options.max_depth;
+    limits.chance_samples = options.chance_samples;
+    limits.exact_chance = options.exact_chance;
+    limits.weights = options.weights;
+
+    std::vector<std::unique_ptr<BookTranspositionTable>> tables(runner.thread_count());
+    for (auto& table : tables)
+        table = std::make_unique<BookTranspositionTable>();
+
+    // Rentals are sorted, so entry i = (i / count, i % count) is already in book order
+    std::atomic<uint64_t> nodes{0};
+    runner.parallel_for(
+        entries.size(),
+        [&](unsigned worker, size_t begin, size_t end) {
+            BookTranspositionTable& table = *tables[worker];
+            for (size_t i = begin; i < end; ++i) {
+                const uint16_t own = rentals[i / count];
+                const uint16_t opponent = rentals[i % count];
+                table.clear();
+                ai::Searcher<BookTranspositionTable> searcher(table, limits);
+
+                BattleEngine battle;
+                util::random::Rng stream{};
+                stream.seed(own, opponent);
+                battle.init(own, opponent, options.level, stream);
+                const ai::SearchResult result = searcher.search(battle, 0);
+
+                entries[i] = BookEntry{own, opponent, result.value, encode_action(result.action),
+                                       result.depth};
+                nodes.fetch_add(result.nodes, std::memory_order_relaxed);
+            }
+        },
+        1);
+
+    if (stats)
+        stats->nodes = nodes.load();
+    return entries;
+}
+
+bool write_opening_book(std::span<const BookEntry> entries, uint8_t level, const char* name) {
+    if (entries.empty() || entries.size() > BOOK_MAX_ENTRIES)
+        return false;
+    return util::cache::write_cache(name, book_fingerprint(level), entries.data(),
+                                    static_cast<uint32_t>(entries.size_bytes()));
+}
+
+}  // namespace engine::book
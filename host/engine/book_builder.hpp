@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @file book_builder.hpp
+ * @brief Offline search of the opening book (engine/opening_book.hpp) (host only)
+ *
+ * Every ordered pair of the lead rentals gets one deep search of its
+ * opening position, from player 1's view, with a host-sized transposition
+ * table. The search is a function of the position alone (its chance
+ * streams come from the state hash), so a book comes out the same on any
+ * thread count.
+ */
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "batch.hpp"
+#include "engine/ai.hpp"
+#include "engine/opening_book.hpp"
+
+namespace engine::book {
+
+/// Host search table: 16384 buckets x 4 entries x 8 bytes = 512 KB per worker
+using BookTranspositionTable = TranspositionTable<16384>;
+
+struct BookBuildOptions {
+    uint8_t level{50};
+    uint8_t max_depth{ai::MAX_SEARCH_DEPTH};
+    uint8_t chance_samples{8};
+    bool exact_chance{false};
+    const ai::EvalWeights* weights{nullptr};  // nullptr = DEFAULT_EVAL_WEIGHTS
+};
+
+struct BookBuildStats {
+    uint64_t nodes{0};  // Turns executed by all searches
+};
+
+/**
+ * @brief Book entries of every (own, opponent) pair of `leads`, sorted.
+ *
+ * Duplicate leads are searched once. At most BOOK_MAX_ENTRIES pairs: the
+ * caller picks at most that many squared leads.
+ */
+std::vector<BookEntry> build_opening_book(BatchRunner& runner, std::span<const uint16_t> leads,
+                                          const BookBuildOptions& options,
+                                          BookBuildStats* stats = nullptr);
+
+/**
+ * @brief Write `entries` (sorted, at most BOOK_MAX_ENTRIES) as the book AppVar for `level`.
+ */
+bool write_opening_book(std::span<const BookEntry> entries, uint8_t level,
+                        const char* name = BOOK_APPVAR);
+
+}  // namespace engine::book
@@ -0,0 +1,83 @@
+#include "estimate.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "util/random.hpp"
+
+namespace engine {
+
+void wilson_interval(double successes, double trials, double z, double& lower, double& upper) {
+    if (trials <= 0.0) {
+        lower = 0.0;
+        upper = 1.0;
+        return;
+    }
+    const double p = successes / trials;
+    const double z2 = z * z;
+    const double denominator = 1.0 + z2 / trials;
+    const double center = (p + z2 / (2.0 * trials)) / denominator;
+    const double half = z * std::sqrt(p * (1.0 - p) / trials + z2 / (4.0 * trials * trials)) /
+                        denominator;
+    lower = std::fmax(0.0, center - half);
+    upper = std::fmin(1.0, center + half);
+}
+
+double normal_quantile(double delta) {
+    // erfc(z / sqrt 2) is decreasing in z: bisect
+    double lo = 0.0;
+    double hi = 40.0;
+    for (int i = 0; i < 100; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid / std::sqrt(2.0)) > delta) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+WinRateEstimate estimate_win_rate(BatchRunner& runner, uint16_t rental_a, uint16_t rental_b,
+                                  Policy policy_a, Policy policy_b, double epsilon, double delta,
+                                  const EstimateOptions& options) {
+    WinRateEstimate estimate{};
+    const uint32_t batch_size = options.batch_size ? options.batch_size : 1;
+
+    std::vector<BatchJob> jobs;
+    std::vector<BattleOutcome> outcomes;
+    for (uint64_t look = 1; estimate.battles < options.max_battles; ++look) {
+        const uint64_t remaining = options.max_battles - estimate.battles;
+        jobs.resize(remaining < batch_size ? remaining : batch_size);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            BatchJob& job = jobs[i];
+            job.rental_a = rental_a;
+            job.rental_b = rental_b;
+            job.policy_a = policy_a;
+            job.policy_b = policy_b;
+            job.seed = util::random::mix64(options.seed + estimate.battles + i);
+            job.level = options.level;
+            job.max_turns = options.max_turns;
+        }
+        outcomes.resize(jobs.size());
+        runner.run(jobs, outcomes);
+
+        const BatchTotals totals = summarize(outcomes);
+        estimate.battles += jobs.size();
+        estimate.p1_wins += totals.p1_wins;
+        estimate.unfinished += totals.unfinished;
+
+        const double wins = estimate.p1_wins + 0.5 * estimate.unfinished;
+        const double trials = static_cast<double>(estimate.battles);
+        const double z = normal_quantile(delta / (static_cast<double>(look) * (look + 1)));
+        estimate.win_rate = wins / trials;
+        wilson_interval(wins, trials, z, estimate.lower, estimate.upper);
+        if (estimate.upper - estimate.lower <= 2.0 * epsilon) {
+            estimate.converged = true;
+            break;
+        }
+    }
+    return estimate;
+}
+
+}  // namespace engine
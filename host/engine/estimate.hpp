@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * @file estimate.hpp
+ * @brief Sequential Monte Carlo win-rate estimation (host only)
+ *
+ * Plays a matchup in batches on a BatchRunner and stops as soon as the
+ * confidence interval on player 1's win rate is narrow enough, so lopsided
+ * matchups finish after a few hundred battles instead of a fixed count.
+ *
+ * The interval is the Wilson score interval. Checking it after every batch
+ * is a sequence of tests, so the error budget is split across looks
+ * (delta_k = delta / (k (k + 1)), which sums to delta): the returned
+ * interval covers the true rate with probability at least 1 - delta no
+ * matter when the estimator stops.
+ *
+ * Battle i of an estimate is seeded from (seed, i) alone and the stopping
+ * check only runs between batches, so an estimate is reproducible and
+ * independent of the thread count.
+ */
+
+#include <cstdint>
+
+#include "batch.hpp"
+
+namespace engine {
+
+struct EstimateOptions {
+    uint64_t seed{0x5EC0'0001};
+    uint32_t batch_size{256};      // Battles between stopping checks
+    uint64_t max_battles{100000};  // Hard cap (reported as not converged)
+    uint8_t level{50};
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+};
+
+struct WinRateEstimate {
+    double win_rate{0.0};  // Player 1 wins (+ half of unfinished) / battles
+    double lower{0.0};     // Confidence interval on win_rate
+    double upper{1.0};
+    uint64_t battles{0};
+    uint64_t p1_wins{0};
+    uint64_t unfinished{0};  // Hit the turn cap: counted as half a win
+    bool converged{false};   // Interval half-width reached epsilon
+};
+
+/**
+ * @brief Wilson score interval for `successes` out of `trials`.
+ *
+ * @param z Normal quantile of the confidence level
+ */
+void wilson_interval(double successes, double trials, double z, double& lower, double& upper);
+
+/// Two-sided normal quantile: P(|Z| > z) = delta
+double normal_quantile(double delta);
+
+/**
+ * @brief Estimate player 1's win rate in rental_a vs. rental_b.
+ *
+ * @param runner Thread pool to play on
+ * @param rental_a Player 1 (index into data::g_RENTAL_SETS)
+ * @param rental_b Player 2
+ * @param policy_a Player 1's policy
+ * @param policy_b Player 2's policy
+ * @param epsilon Target half-width of the interval
+ * @param delta Allowed probability that the interval misses the true rate
+ * @param options Seed, batch size and caps
+ */
+WinRateEstimate estimate_win_rate(BatchRunner& runner, uint16_t rental_a, uint16_t rental_b,
+                                  Policy policy_a, Policy policy_b, double epsilon, double delta,
+                                  const EstimateOptions& options = {});
+
+}  // namespace engine
@@ -0,0 +1,136 @@
+#include "eval_tuning.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+namespace {
+
+// Loss partial sums are taken over fixed chunks and added in chunk order
+constexpr size_t LOSS_CHUNK = 4096;
+
+/// Turn-start positions of game `index`, with the game's result filled in
+std::vector<EvalSample> play_sample_game(const EvalSampleOptions& options, uint32_t index) {
+    const uint64_t seed = util::random::mix64(options.seed + index);
+    util::random::Rng pairing{};
+    pairing.seed(seed, ~seed);
+    const auto rental_a = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+    const auto rental_b = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+
+    util::random::Rng root{};
+    root.seed(seed, seed);
+    BattleEngine battle;
+    battle.init(rental_a, rental_b, options.level, root.split(0));
+    util::random::Rng policy_rng = root.split(1);
+
+    std::vector<EvalSample> samples;
+    for (uint16_t turn = 0; turn < options.max_turns && battle.result() == BattleResult::ONGOING;
+         ++turn) {
+        samples.push_back(EvalSample{ai::eval_features(battle.state(), 0), 1});
+        const BattleAction p1 = options.policy_a(battle, 0, policy_rng);
+        const BattleAction p2 = options.policy_b(battle, 1, policy_rng);
+        battle.execute_turn(p1, p2);
+    }
+
+    const BattleResult result = battle.result();
+    const uint8_t half_points = result == BattleResult::P1_WINS   ? 2
+                                : result == BattleResult::P2_WINS ? 0
+                                                                  : 1;
+    for (auto& sample : samples) {
+        sample.result = half_points;
+    }
+    return samples;
+}
+
+}  // namespace
+
+std::vector<EvalSample> collect_eval_samples(BatchRunner& runner,
+                                             const EvalSampleOptions& options) {
+    std::vector<std::vector<EvalSample>> games(options.games);
+    runner.parallel_for(
+        options.games,
+        [&](unsigned, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                games[i] = play_sample_game(options, static_cast<uint32_t>(i));
+            }
+        },
+        16);
+
+    std::vector<EvalSample> samples;
+    for (const auto& game : games) {
+        samples.insert(samples.end(), game.begin(), game.end());
+    }
+    return samples;
+}
+
+double eval_loss(BatchRunner& runner, std::span<const EvalSample> samples,
+                 const ai::EvalWeights& weights, double scale) {
+    if (samples.empty())
+        return 0.0;
+
+    const size_t chunks = (samples.size() + LOSS_CHUNK - 1) / LOSS_CHUNK;
+    std::vector<double> partial(chunks, 0.0);
+    runner.parallel_for(
+        chunks,
+        [&](unsigned, size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                const size_t first = c * LOSS_CHUNK;
+                const size_t last = std::min(first + LOSS_CHUNK, samples.size());
+                double sum = 0.0;
+                for (size_t i = first; i < last; ++i) {
+                    const double score = ai::score_features(samples[i].features, weights);
+                    const double predicted = 1.0 / (1.0 + std::exp(-score / scale));
+                    const double error = samples[i].result * 0.5 - predicted;
+                    sum += error * error;
+                }
+                partial[c] = sum;
+            }
+        },
+        1);
+
+    double total = 0.0;
+    for (const double sum : partial) {
+        total += sum;
+    }
+    return total / static_cast<double>(samples.size());
+}
+
+ai::EvalWeights tune_eval_weights(BatchRunner& runner, std::span<const EvalSample> samples,
+                                  const ai::EvalWeights& start, const EvalTuneOptions& options,
+                                  double& loss) {
+    ai::EvalWeights best = start;
+    loss = eval_loss(runner, samples, best, options.scale);
+
+    int16_t step = options.first_step < 1 ? 1 : options.first_step;
+    for (uint16_t pass = 0; pass < options.max_passes; ++pass) {
+        bool improved = false;
+        for (uint8_t f = 0; f < ai::EVAL_FEATURE_COUNT; ++f) {
+            for (const int sign : {1, -1}) {
+                const int moved = best.weight[f] + sign * step;
+                if (moved > ai::EVAL_MAX_WEIGHT || moved < -ai::EVAL_MAX_WEIGHT)
+                    continue;
+                ai::EvalWeights trial = best;
+                trial.weight[f] = static_cast<int16_t>(moved);
+                const double trial_loss = eval_loss(runner, samples, trial, options.scale);
+                if (trial_loss < loss) {
+                    best = trial;
+                    loss = trial_loss;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+        if (!improved) {
+            if (step == 1)
+                break;
+            step = static_cast<int16_t>(step / 2);
+        }
+    }
+    return best;
+}
+
+}  // namespace engine
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file eval_tuning.hpp
+ * @brief Fitting the search's evaluation weights to simulated games (host only)
+ *
+ * Texel-style tuning: every position of a set of simulated games is labelled
+ * with the game's result from player 1's view (1 win, 1/2 unfinished, 0
+ * loss), and the weights minimize the mean squared error between the label
+ * and sigmoid(evaluate() / scale). The search is local and integer, over
+ * the same fixed-point weights and score the calculator computes, so the
+ * fitted weights export as they are (engine/eval.hpp, write_eval_weights()).
+ *
+ * Game i is seeded from (seed, i) alone and losses are summed in a fixed
+ * chunk order, so a fit is reproducible and independent of the thread count.
+ */
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "batch.hpp"
+#include "engine/eval.hpp"
+
+namespace engine {
+
+struct EvalSample {
+    ai::EvalFeatures features{};  // Player 1's view
+    uint8_t result{1};            // Player 1's result in half points (0, 1 or 2)
+};
+
+struct EvalSampleOptions {
+    uint32_t games{20000};
+    uint64_t seed{0x4556'414C};
+    uint8_t level{50};
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+    Policy policy_a{greedy_damage_policy};
+    Policy policy_b{greedy_damage_policy};
+};
+
+struct EvalTuneOptions {
+    double scale{1000.0};       // Score of a 73% (sigmoid(1)) position
+    uint16_t max_passes{200};   // Passes over the weights
+    int16_t first_step{256};    // Largest weight step tried; halved down to 1
+};
+
+/**
+ * @brief Every turn-start position of `options.games` random pairings.
+ *
+ * Game i pairs rentals like battlemon_sim's random jobs for job seed
+ * mix64(seed + i) and is played by the options' policies.
+ */
+std::vector<EvalSample> collect_eval_samples(BatchRunner& runner,
+                                             const EvalSampleOptions& options);
+
+/**
+ * @brief Mean squared error of `weights` on `samples`.
+ */
+double eval_loss(BatchRunner& runner, std::span<const EvalSample> samples,
+                 const ai::EvalWeights& weights, double scale);
+
+/**
+ * @brief Local search from `start` for the weights with the lowest eval_loss().
+ *
+ * @param[out] loss Loss of the returned weights
+ */
+ai::EvalWeights tune_eval_weights(BatchRunner& runner, std::span<const EvalSample> samples,
+                                  const ai::EvalWeights& start, const EvalTuneOptions& options,
+                                  double& loss);
+
+}  // namespace engine
@@ -0,0 +1,237 @@
+#include "factory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace engine::factory {
+
+namespace {
+
+using util::random::Rng;
+
+/// `count` distinct rentals, none of them in `exclude`
+void draw_distinct(Rng& rng, uint16_t* out, size_t count, std::span<const uint16_t> exclude) {
+    constexpr auto rental_count = static_cast<uint16_t>(logic::setup::RENTAL_COUNT);
+    for (size_t i = 0; i < count;) {
+        const uint16_t candidate = rng.random(rental_count);
+        const bool taken = std::find(out, out + i, candidate) != out + i ||
+                           std::find(exclude.begin(), exclude.end(), candidate) != exclude.end();
+        if (!taken)
+            out[i++] = candidate;
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+//                              STRATEGIES
+// ============================================================================
+
+Team random_draft(const StrategyContext&, const Pool& pool, Rng& rng) {
+    Pool shuffled = pool;
+    for (uint8_t i = 0; i < TEAM_SIZE; ++i) {
+        const auto j = static_cast<uint8_t>(i + rng.random(POOL_SIZE - i));
+        std::swap(shuffled[i], shuffled[j]);
+    }
+    return Team{shuffled[0], shuffled[1], shuffled[2]};
+}
+
+SwapChoice never_swap(const StrategyContext&, const Team&, const Team&, Rng&) { return {}; }
+
+Team rated_draft(const StrategyContext& context, const Pool& pool, Rng& rng) {
+    if (context.ratings.empty())
+        return random_draft(context, pool, rng);
+
+    Pool ranked = pool;
+    std::stable_sort(ranked.begin(), ranked.end(), [&](uint16_t a, uint16_t b) {
+        return context.ratings[a] > context.ratings[b];
+    });
+    return Team{ranked[0], ranked[1], ranked[2]};
+}
+
+SwapChoice rated_swap(const StrategyContext& context, const Team& team, const Team& opponent,
+                      Rng&) {
+    if (context.ratings.empty())
+        return {};
+
+    int8_t worst = 0;
+    int8_t best = 0;
+    for (int8_t i = 1; i < TEAM_SIZE; ++i) {
+        if (context.ratings[team[i]] < context.ratings[team[worst]])
+            worst = i;
+        if (context.ratings[opponent[i]] > context.ratings[opponent[best]])
+            best = i;
+    }
+    if (context.ratings[opponent[best]] <= context.ratings[team[worst]])
+        return {};
+    return SwapChoice{worst, best};
+}
+
+// ============================================================================
+//                             STREAK REPORT
+// ============================================================================
+
+double StreakReport::mean() const {
+    if (runs == 0)
+        return 0.0;
+    double total = 0.0;
+    for (size_t streak = 0; streak < histogram.size(); ++streak) {
+        total += static_cast<double>(streak) * histogram[streak];
+    }
+    return total / static_cast<double>(runs);
+}
+
+uint16_t StreakReport::quantile(double q) const {
+    const auto target = static_cast<uint64_t>(std::ceil(q * static_cast<double>(runs)));
+    uint64_t seen = 0;
+    for (size_t streak = 0; streak < histogram.size(); ++streak) {
+        seen += histogram[streak];
+        if (seen >= target && seen > 0)
+            return static_cast<uint16_t>(streak);
+    }
+    return static_cast<uint16_t>(histogram.empty() ? 0 : histogram.size() - 1);
+}
+
+// ============================================================================
+//                             RUN SIMULATOR
+// ============================================================================
+
+RunSimulator::RunSimulator(BatchRunner& runner, const DraftStrategy& strategy,
+                           const RunOptions& options)
+    : runner_(runner), strategy_(strategy), options_(options) {
+    const MatchupMatrixView* matrix = options_.matrix;
+    if (!matrix || !matrix->valid() || matrix->rental_count() != logic::setup::RENTAL_COUNT)
+        return;
+
+    // Rating: mean win rate over every opponent, playing either side
+    const size_t count = matrix->rental_count();
+    ratings_.resize(count);
+    for (size_t r = 0; r < count; ++r) {
+        double total = 0.0;
+        for (size_t o = 0; o < count; ++o) {
+            total += matrix->cell(r, o).win_rate + (1.0 - matrix->cell(o, r).win_rate);
+        }
+        ratings_[r] = static_cast<float>(total / (2.0 * static_cast<double>(count)));
+    }
+    context_ = StrategyContext{matrix, ratings_};
+
+    // The matrix only stands in for fights played the way it was generated
+    const MatrixHeader& header = matrix->header();
+    const Policy generated = matrix_policy(static_cast<MatrixPolicy>(header.policy));
+    fast_path_ = options_.matrix_fast_path && header.level == options_.level &&
+                 header.max_turns == options_.max_turns && options_.player == generated &&
+                 options_.opponent == generated;
+}
+
+bool RunSimulator::trainer_battle(const Team& team, const Team& opponent, Rng& rng,
+                                  RunResult& result) const {
+    if (fast_path_)
+        return matrix_battle(team, opponent, rng, result);
+
+    PartyRentals parties[2];
+    for (uint8_t i = 0; i < TEAM_SIZE; ++i) {
+        parties[0].rentals[i] = team[i];
+        parties[1].rentals[i] = opponent[i];
+    }
+    parties[0].size = parties[1].size = TEAM_SIZE;
+
+    const Rng fight = rng.split(rng.next());
+    BattleEngine battle;
+    battle.init(parties[0], parties[1], options_.level, fight.split(0));
+    Rng policy_rng = fight.split(1);
+    const BattleOutcome outcome =
+        run_battle(battle, options_.player, options_.opponent, policy_rng, options_.max_turns);
+    result.turns += outcome.turns;
+
+    // Every knockout ends one fight
+    for (const dsl::Party& party : battle.state().parties) {
+        for (uint8_t i = 0; i < party.size; ++i) {
+            result.fights += party.mons[i].is_fainted();
+        }
+    }
+    return outcome.result == BattleResult::P1_WINS;
+}
+
+bool RunSimulator::matrix_battle(const Team& team, const Team& opponent, Rng& rng,
+                                 RunResult& result) const {
+    uint8_t mine = 0;
+    uint8_t theirs = 0;
+    while (mine < TEAM_SIZE && theirs < TEAM_SIZE) {
+        ++result.fights;
+        const float win_rate = options_.matrix->cell(team[mine], opponent[theirs]).win_rate;
+        const auto permille = static_cast<uint16_t>(std::lround(win_rate * 1000.0f));
+        if (rng.chance(permille, 1000)) {
+            ++theirs;
+        } else {
+            ++mine;
+        }
+    }
+    return theirs == TEAM_SIZE;
+}
+
+RunResult RunSimulator::play(uint64_t index) const {
+    const uint64_t seed = util::random::mix64(options_.seed + index);
+    Rng rng{};
+    rng.seed(seed, seed);
+
+    RunResult result{};
+    for (uint16_t round = 0; round < options_.max_rounds; ++round) {
+        Pool pool;
+        draw_distinct(rng, pool.data(), POOL_SIZE, {});
+        Team team = strategy_.draft(context_, pool, rng);
+
+        for (uint8_t battle = 0; battle < BATTLES_PER_ROUND; ++battle) {
+            Team opponent;
+            draw_distinct(rng, opponent.data(), TEAM_SIZE, team);
+            if (!trainer_battle(team, opponent, rng, result))
+                return result;
+            ++result.streak;
+
+            if (battle + 1 < BATTLES_PER_ROUND) {
+                const SwapChoice swap = strategy_.swap(context_, team, opponent, rng);
+                if (!swap.none())
+                    team[swap.own] = opponent[swap.theirs];
+            }
+        }
+    }
+    return result;
+}
+
+StreakReport RunSimulator::simulate(uint64_t runs) {
+    const size_t max_streak = static_cast<size_t>(options_.max_rounds) * BATTLES_PER_ROUND;
+    std::vector<StreakReport> partial(runner_.thread_count());
+    for (StreakReport& report : partial) {
+        report.histogram.assign(max_streak + 1, 0);
+    }
+
+    runner_.parallel_for(
+        runs,
+        [&](unsigned worker, size_t begin, size_t end) {
+            StreakReport& report = partial[worker];
+            for (size_t i = begin; i < end; ++i) {
+                const RunResult result = play(i);
+                ++report.histogram[result.streak];
+                ++report.runs;
+                report.fights += result.fights;
+                report.turns += result.turns;
+            }
+        },
+        16);
+
+    StreakReport total{};
+    total.histogram.assign(max_streak + 1, 0);
+    for (const StreakReport& report : partial) {
+        for (size_t s = 0; s <= max_streak; ++s) {
+            total.histogram[s] += report.histogram[s];
+        }
+        total.runs += report.runs;
+        total.fights += report.fights;
+        total.turns += report.turns;
+    }
+    return total;
+}
+
+}  // namespace engine::factory
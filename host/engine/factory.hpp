@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file factory.hpp
+ * @brief Battle Factory streak simulation over g_RENTAL_SETS (host only)
+ *
+ * A run is a sequence of rounds. Each round:
+ *   - draws POOL_SIZE rentals and lets the strategy draft TEAM_SIZE of them
+ *   - plays BATTLES_PER_ROUND trainer battles against random 3-mon teams
+ *   - after every win but the round's last, offers the strategy one swap of
+ *     a team member for one of the beaten trainer's rentals
+ * The run ends at the first lost battle (or after max_rounds); its streak is
+ * the number of battles won.
+ *
+ * A trainer battle is one 3v3 party battle (BattleEngine's PartyRentals
+ * init) led by each team's first rental; a side whose battler faints sends
+ * in its next living member in team order (engine::replace_fainted()). A
+ * battle that hits the turn cap loses it for the player.
+ *
+ * Run i is reproducible from (seed, i) alone, independent of thread count.
+ *
+ * Matrix fast path: given a MatchupMatrixView generated with the same level
+ * and policies, a battle is a chain of 1v1 fights in team order, each
+ * decided by one draw against its cell's win rate: the winner stays in and
+ * the loser's side sends its next rental. That skips the engine entirely
+ * but forgets the HP carried between fights (every fight starts fresh), so
+ * it is for screening strategies, not for final numbers.
+ */
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "batch.hpp"
+#include "engine/advisor.hpp"
+#include "matchup_matrix.hpp"
+
+namespace engine::factory {
+
+/// What a strategy may consult besides its own draft
+struct StrategyContext {
+    const MatchupMatrixView* matrix{nullptr};
+    std::span<const float> ratings;  // Mean matrix win rate of each rental (empty without matrix)
+};
+
+/// Draft and swap decisions; plain function pointers like engine::Policy
+struct DraftStrategy {
+    const char* name;
+    Team (*draft)(const StrategyContext& context, const Pool& pool, util::random::Rng& rng);
+    SwapChoice (*swap)(const StrategyContext& context, const Team& team, const Team& opponent,
+                       util::random::Rng& rng);
+};
+
+/// Draft 3 of the pool at random, never swap
+Team random_draft(const StrategyContext& context, const Pool& pool, util::random::Rng& rng);
+SwapChoice never_swap(const StrategyContext& context, const Team& team, const Team& opponent,
+                      util::random::Rng& rng);
+
+/// Draft the 3 best-rated rentals; swap the worst member for a better-rated opponent
+Team rated_draft(const StrategyContext& context, const Pool& pool, util::random::Rng& rng);
+SwapChoice rated_swap(const StrategyContext& context, const Team& team, const Team& opponent,
+                      util::random::Rng& rng);
+
+inline constexpr DraftStrategy RANDOM_STRATEGY{"random", random_draft, never_swap};
+
+/// Needs a matrix (falls back to random drafting without one)
+inline constexpr DraftStrategy RATED_STRATEGY{"rated", rated_draft, rated_swap};
+
+struct RunOptions {
+    uint64_t seed{0x46414354};
+    uint8_t level{50};
+    uint16_t max_rounds{10};  // Streak cap = max_rounds * BATTLES_PER_ROUND
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+    Policy player{random_move_policy};
+    Policy opponent{random_move_policy};
+    const MatchupMatrixView* matrix{nullptr};
+    bool matrix_fast_path{false};  // Decide fights from the matrix where allowed
+};
+
+/// Outcome of one run
+struct RunResult {
+    uint16_t streak{0};  // Battles won
+    uint32_t fights{0};  // Knockouts (or 1v1 fights drawn from the matrix)
+    uint32_t turns{0};   // Engine turns executed
+};
+
+/// Streak distribution over many runs
+struct StreakReport {
+    std::vector<uint64_t> histogram;  // histogram[s] = runs that ended on streak s
+    uint64_t runs{0};
+    uint64_t fights{0};
+    uint64_t turns{0};
+
+    [[nodiscard]] double mean() const;
+
+    /// Smallest streak s with at least fraction q of runs at or below it
+    [[nodiscard]] uint16_t quantile(double q) const;
+};
+
+class RunSimulator {
+   public:
+    RunSimulator(BatchRunner& runner, const DraftStrategy& strategy, const RunOptions& options);
+
+    /// Whether fights are decided from the matrix (requested and compatible)
+    [[nodiscard]] bool fast_path() const { return fast_path_; }
+
+    /// Play run `index` (deterministic in (seed, index))
+    [[nodiscard]] RunResult play(uint64_t index) const;
+
+    /// Play runs [0, runs) on every worker
+    StreakReport simulate(uint64_t runs);
+
+   private:
+    /// One 3v3 trainer battle; true if the player won
+    bool trainer_battle(const Team& team, const Team& opponent, util::random::Rng& rng,
+                        RunResult& result) const;
+
+    /// The same, as a chain of fights drawn from the matrix (fast path)
+    bool matrix_battle(const Team& team, const Team& opponent, util::random::Rng& rng,
+                       RunResult& result) const;
+
+    BatchRunner& runner_;
+    DraftStrategy strategy_;
+    RunOptions options_;
+    std::vector<float> ratings_;
+    StrategyContext context_{};
+    bool fast_path_{false};
+};
+
+}  // namespace engine::factory
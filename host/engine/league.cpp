@@ -0,0 +1,328 @@
+#include "league.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace engine::league {
+
+namespace {
+
+constexpr const char* CHECKPOINT_MAGIC = "battlemon-league";
+constexpr int CHECKPOINT_VERSION = 1;
+
+/// Both players' tables on one worker (cleared before every game)
+struct WorkerTables {
+    CalcTranspositionTable table[2];
+};
+
+/// Battle seed of a pair's `draft`-th draft (rentals and battle stream)
+uint64_t draft_seed(uint64_t seed, size_t pair, uint32_t draft) {
+    const uint64_t draft_key = static_cast<uint64_t>(pair) << 32 | draft;
+    return util::random::mix64(seed ^ util::random::mix64(draft_key));
+}
+
+ai::SearchLimits entrant_limits(const Entrant& entrant) {
+    ai::SearchLimits limits{};
+    limits.max_depth = entrant.max_depth;
+    limits.chance_samples = entrant.chance_samples;
+    limits.weights = &entrant.weights;
+    return limits;
+}
+
+/// One game between two entrants; player 1's half points
+uint8_t play_game(const Entrant& p1, const Entrant& p2, uint16_t rental_p1, uint16_t rental_p2,
+                  uint64_t seed, const LeagueOptions& options, WorkerTables& tables,
+                  uint16_t& turns) {
+    tables.table[0].clear();
+    tables.table[1].clear();
+    ai::Searcher<CalcTranspositionTable> first(tables.table[0], entrant_limits(p1));
+    ai::Searcher<CalcTranspositionTable> second(tables.table[1], entrant_limits(p2));
+
+    // Both games of a draft play the same battle stream
+    util::random::Rng stream{};
+    stream.seed(seed, seed);
+    BattleEngine battle;
+    battle.init(rental_p1, rental_p2, options.level, stream);
+    turns = 0;
+    while (battle.result() == BattleResult::ONGOING && turns < options.max_turns) {
+        const BattleAction a1 = first.search(battle, 0).action;
+        const BattleAction a2 = second.search(battle, 1).action;
+        battle.execute_turn(a1, a2);
+        ++turns;
+    }
+
+    const BattleResult result = battle.result();
+    return result == BattleResult::P1_WINS ? 2 : result == BattleResult::P2_WINS ? 0 : 1;
+}
+
+}  // namespace
+
+double expected_score(double rating, double opponent) {
+    return 1.0 / (1.0 + std::pow(10.0, (opponent - rating) / ELO_SCALE));
+}
+
+std::vector<Entrant> spawn_population(uint16_t count, uint64_t seed, uint8_t spread,
+                                      uint8_t max_depth, uint8_t chance_samples) {
+    std::vector<Entrant> population(count);
+    for (uint16_t i = 0; i < count; ++i) {
+        Entrant& entrant = population[i];
+        char name[8];
+        std::snprintf(name, sizeof(name), "e%u", static_cast<unsigned>(i));
+        entrant.name = name;
+        entrant.max_depth = max_depth;
+        entrant.chance_samples = chance_samples;
+        if (i == 0)
+            continue;
+
+        const uint64_t stream = util::random::mix64(seed + i);
+        util::random::Rng rng{};
+        rng.seed(stream, ~stream);
+        for (uint8_t f = 0; f < ai::EVAL_FEATURE_COUNT; ++f) {
+            const int32_t weight = entrant.weights.weight[f];
+            const int32_t percent = static_cast<int32_t>(rng.random(2 * spread + 1)) - spread;
+            const int32_t moved = weight + weight * percent / 100;
+            entrant.weights.weight[f] =
+                static_cast<int16_t>(std::clamp<int32_t>(moved, INT16_MIN, INT16_MAX));
+        }
+    }
+    return population;
+}
+
+// ============================================================================
+//                               SCHEDULING
+// ============================================================================
+
+League::League(std::vector<Entrant> population, const LeagueOptions& options)
+    : population_(std::move(population)),
+      options_(options),
+      pair_drafts_(population_.size() * population_.size(), 0) {}
+
+std::vector<Match> League::schedule() const {
+    const auto size = static_cast<uint16_t>(population_.size());
+    std::vector<Match> candidates;
+    for (uint16_t a = 0; a < size; ++a) {
+        for (uint16_t b = a + 1; b < size; ++b) {
+            const double p = expected_score(population_[a].rating, population_[b].rating);
+            const double repeats = static_cast<double>(drafts_between(a, b)) /
+                                   std::max<uint16_t>(1, options_.drafts_per_match);
+            candidates.push_back(Match{a, b, p * (1.0 - p) / (1.0 + repeats)});
+        }
+    }
+    // Stable: equal priorities keep pair order, so the schedule is deterministic
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Match& x, const Match& y) { return x.priority > y.priority; });
+
+    const size_t wanted = std::min<size_t>(
+        options_.matches_per_round > 0 ? options_.matches_per_round : size, candidates.size());
+    const size_t share = size > 0 ? (2 * wanted + size - 1) / size : 0;
+
+    // Best pairs first with every entrant held to its share; if the shares
+    // leave the round short, the best remaining pairs fill it
+    std::vector<Match> matches;
+    std::vector<size_t> load(size, 0);
+    std::vector<bool> taken(candidates.size(), false);
+    for (size_t i = 0; i < candidates.size() && matches.size() < wanted; ++i) {
+        const Match& match = candidates[i];
+        if (load[match.a] < share && load[match.b] < share) {
+            matches.push_back(match);
+            taken[i] = true;
+            ++load[match.a];
+            ++load[match.b];
+        }
+    }
+    for (size_t i = 0; i < candidates.size() && matches.size() < wanted; ++i) {
+        if (!taken[i])
+            matches.push_back(candidates[i]);
+    }
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const Match& x, const Match& y) { return x.priority > y.priority; });
+    return matches;
+}
+
+// ============================================================================
+//                                 ROUNDS
+// ============================================================================
+
+RoundReport League::play_round(BatchRunner& runner) {
+    RoundReport report{};
+    report.round = round_;
+    const std::vector<Match> matches = schedule();
+    const uint32_t drafts = options_.drafts_per_match;
+    const size_t games = matches.size() * drafts * 2;
+
+    // Game g: match g / (2 drafts), draft (g / 2) % drafts, the mirror game if g is odd
+    std::vector<uint8_t> points_a(games, 0);
+    std::vector<uint16_t> turns(games, 0);
+    std::vector<std::unique_ptr<WorkerTables>> tables(runner.thread_count());
+    for (auto& worker : tables)
+        worker = std::make_unique<WorkerTables>();
+
+    runner.parallel_for(
+        games,
+        [&](unsigned worker, size_t begin, size_t end) {
+            for (size_t g = begin; g < end; ++g) {
+                const Match& match = matches[g / (2 * drafts)];
+                const uint32_t draft = drafts_between(match.a, match.b) +
+                                       static_cast<uint32_t>((g / 2) % drafts);
+                const uint64_t seed =
+                    draft_seed(options_.seed, pair_index(match.a, match.b), draft);
+                util::random::Rng pairing{};
+                pairing.seed(seed, ~seed);
+                const auto x = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+                const auto y = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+
+                const Entrant& a = population_[match.a];
+                const Entrant& b = population_[match.b];
+                WorkerTables& scratch = *tables[worker];
+                if (g % 2 == 0) {
+                    points_a[g] = play_game(a, b, x, y, seed, options_, scratch, turns[g]);
+                } else {
+                    points_a[g] = 2 - play_game(b, a, x, y, seed, options_, scratch, turns[g]);
+                }
+            }
+        },
+        1);
+
+    // Ratings move game by game, in game order
+    for (size_t m = 0; m < matches.size(); ++m) {
+        const Match& match = matches[m];
+        Entrant& a = population_[match.a];
+        Entrant& b = population_[match.b];
+        MatchResult result{match, 0, 0, 0.0};
+        const double start = a.rating;
+        for (size_t g = m * 2 * drafts; g < (m + 1) * 2 * drafts; ++g) {
+            const double delta =
+                options_.k_factor * (points_a[g] / 2.0 - expected_score(a.rating, b.rating));
+            a.rating += delta;
+            b.rating -= delta;
+            a.points += points_a[g];
+            b.points += 2u - points_a[g];
+            ++a.games;
+            ++b.games;
+            ++result.games;
+            result.points_a += points_a[g];
+            report.turns += turns[g];
+        }
+        result.rating_change_a = a.rating - start;
+        pair_drafts_[pair_index(match.a, match.b)] += drafts;
+        report.games += result.games;
+        report.matches.push_back(result);
+    }
+    ++round_;
+    return report;
+}
+
+// ============================================================================
+//                              CHECKPOINTS
+// ============================================================================
+//
+// Text, one record per line:
+//
+//   battlemon-league 1
+//   round R
+//   entrants N
+//   name depth samples rating games points w0 ... w6     (N lines)
+//   pairs M
+//   a b drafts                                          (M lines, a < b)
+//
+// ============================================================================
+
+bool League::write(const char* path) const {
+    const std::string temporary = std::string(path) + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "w");
+    if (!file)
+        return false;
+
+    bool ok = std::fprintf(file, "%s %d\nround %u\nentrants %zu\n", CHECKPOINT_MAGIC,
+                           CHECKPOINT_VERSION, round_, population_.size()) > 0;
+    for (const Entrant& entrant : population_) {
+        ok = ok && std::fprintf(file, "%s %u %u %.17g %u %u", entrant.name.c_str(),
+                                entrant.max_depth, entrant.chance_samples, entrant.rating,
+                                entrant.games, entrant.points) > 0;
+        for (uint8_t f = 0; f < ai::EVAL_FEATURE_COUNT; ++f)
+            ok = ok && std::fprintf(file, " %d", entrant.weights.weight[f]) > 0;
+        ok = ok && std::fputc('\n', file) != EOF;
+    }
+
+    const auto size = static_cast<uint16_t>(population_.size());
+    size_t pairs = 0;
+    for (uint16_t a = 0; a < size; ++a) {
+        for (uint16_t b = a + 1; b < size; ++b)
+            pairs += drafts_between(a, b) > 0;
+    }
+    ok = ok && std::fprintf(file, "pairs %zu\n", pairs) > 0;
+    for (uint16_t a = 0; a < size; ++a) {
+        for (uint16_t b = a + 1; b < size; ++b) {
+            if (drafts_between(a, b) > 0)
+                ok = ok && std::fprintf(file, "%u %u %u\n", a, b, drafts_between(a, b)) > 0;
+        }
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool League::read(const char* path) {
+    std::FILE* file = std::fopen(path, "r");
+    if (!file)
+        return false;
+
+    char magic[32]{};
+    int version = 0;
+    unsigned round = 0;
+    size_t count = 0;
+    bool ok = std::fscanf(file, "%31s %d round %u entrants %zu", magic, &version, &round,
+                          &count) == 4 &&
+              std::string(magic) == CHECKPOINT_MAGIC && version == CHECKPOINT_VERSION &&
+              count <= UINT16_MAX;
+
+    std::vector<Entrant> population(ok ? count : 0);
+    for (Entrant& entrant : population) {
+        char name[64]{};
+        unsigned depth = 0;
+        unsigned samples = 0;
+        ok = ok && std::fscanf(file, "%63s %u %u %lf %u %u", name, &depth, &samples,
+                               &entrant.rating, &entrant.games, &entrant.points) == 6 &&
+             depth >= 1 && depth <= ai::MAX_SEARCH_DEPTH && samples >= 1 && samples <= 255;
+        for (uint8_t f = 0; ok && f < ai::EVAL_FEATURE_COUNT; ++f) {
+            int weight = 0;
+            ok = std::fscanf(file, "%d", &weight) == 1 && weight >= INT16_MIN &&
+                 weight <= INT16_MAX;
+            entrant.weights.weight[f] = static_cast<int16_t>(weight);
+        }
+        entrant.name = name;
+        entrant.max_depth = static_cast<uint8_t>(depth);
+        entrant.chance_samples = static_cast<uint8_t>(samples);
+    }
+
+    std::vector<uint32_t> pair_drafts(count * count, 0);
+    size_t pairs = 0;
+    ok = ok && std::fscanf(file, " pairs %zu", &pairs) == 1;
+    for (size_t i = 0; ok && i < pairs; ++i) {
+        unsigned a = 0;
+        unsigned b = 0;
+        unsigned drafts = 0;
+        ok = std::fscanf(file, "%u %u %u", &a, &b, &drafts) == 3 && a < b && b < count;
+        if (ok)
+            pair_drafts[static_cast<size_t>(a) * count + b] = drafts;
+    }
+    std::fclose(file);
+    if (!ok)
+        return false;
+
+    population_ = std::move(population);
+    pair_drafts_ = std::move(pair_drafts);
+    round_ = round;
+    return true;
+}
+
+}  // namespace engine::league
@@ -0,0 +1,146 @@
+#pragma once
+
+/**
+ * @file league.hpp
+ * @brief Self-play league over a population of search AI configurations (host only)
+ *
+ * An entrant is one configuration of engine::ai::Searcher: leaf weights,
+ * search depth and chance samples. The league plays rounds of matches
+ * between entrants and keeps an Elo rating per entrant, updated game by
+ * game in a fixed order.
+ *
+ * A match between entrants A and B is `drafts_per_match` drafts, and each
+ * draft is two games on the same battle seed: A plays rental x against B's
+ * rental y, then B plays x against A's y. The rental luck cancels within a
+ * draft, so a draft scores only the AIs.
+ *
+ * Scheduling spends the round's games where they are informative. A
+ * pairing's priority is the variance of a game between them under the
+ * ratings, p (1 - p) with p the Elo expected score. That is highest for
+ * equal ratings and falls off quickly for blowouts. The priority is then
+ * divided by (1 + earlier drafts between the two), so a close pair does not
+ * take every round. Each round takes the highest-priority pairs, with no
+ * entrant in more than its share of them.
+ *
+ * Round r is reproducible from (seed, r) and the ratings it starts from,
+ * independent of the thread count. A checkpoint (write_league()) saves the
+ * population and pair history as text, and a league resumed from it plays
+ * the same rounds it would have played without stopping.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "batch.hpp"
+#include "engine/ai.hpp"
+
+namespace engine::league {
+
+inline constexpr double INITIAL_RATING = 1500.0;
+
+/// Elo scale: a 400-point gap is 10:1 odds
+inline constexpr double ELO_SCALE = 400.0;
+
+struct Entrant {
+    std::string name;  // No whitespace (checkpoint field)
+    ai::EvalWeights weights{ai::DEFAULT_EVAL_WEIGHTS};
+    uint8_t max_depth{1};
+    uint8_t chance_samples{2};
+
+    double rating{INITIAL_RATING};
+    uint32_t games{0};
+    uint32_t points{0};  // Half points: win 2, unfinished 1, loss 0
+};
+
+struct LeagueOptions {
+    uint64_t seed{0x4C45'4147};
+    uint8_t level{50};
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+    uint16_t matches_per_round{0};  // 0 = one per entrant
+    uint16_t drafts_per_match{8};   // Two games each
+    double k_factor{16.0};          // Elo K per game
+};
+
+/// Player 1's Elo expected score against `opponent`
+double expected_score(double rating, double opponent);
+
+/**
+ * @brief `count` entrants: the built-in weights, then random perturbations of them.
+ *
+ * Entrant i > 0 moves each weight by a uniform step in [-spread, spread]
+ * percent, drawn from (seed, i). Names are "e0", "e1", ...
+ */
+std::vector<Entrant> spawn_population(uint16_t count, uint64_t seed, uint8_t spread = 25,
+                                      uint8_t max_depth = 1, uint8_t chance_samples = 2);
+
+/// One scheduled match
+struct Match {
+    uint16_t a{0};
+    uint16_t b{0};
+    double priority{0.0};
+};
+
+/// What a round played
+struct MatchResult {
+    Match match{};
+    uint32_t games{0};
+    uint32_t points_a{0};  // A's half points
+    double rating_change_a{0.0};
+};
+
+struct RoundReport {
+    uint32_t round{0};
+    std::vector<MatchResult> matches;
+    uint64_t games{0};
+    uint64_t turns{0};
+};
+
+class League {
+   public:
+    League(std::vector<Entrant> population, const LeagueOptions& options);
+
+    /// The next round's matches, highest priority first
+    [[nodiscard]] std::vector<Match> schedule() const;
+
+    /// Schedule, play and rate one round on every worker
+    RoundReport play_round(BatchRunner& runner);
+
+    [[nodiscard]] const std::vector<Entrant>& population() const { return population_; }
+    [[nodiscard]] const LeagueOptions& options() const { return options_; }
+
+    /// Rounds played (the next round's index)
+    [[nodiscard]] uint32_t round() const { return round_; }
+
+    /// Drafts played between entrants a and b so far
+    [[nodiscard]] uint32_t drafts_between(uint16_t a, uint16_t b) const {
+        return pair_drafts_[pair_index(a, b)];
+    }
+
+    /**
+     * @brief Save the league as text (replaced by rename, never in place).
+     *
+     * The options are not saved: a resumed league takes them from its caller.
+     */
+    bool write(const char* path) const;
+
+    /**
+     * @brief Load a league written by write().
+     *
+     * @return false if the file is missing or malformed (league unchanged)
+     */
+    bool read(const char* path);
+
+   private:
+    [[nodiscard]] size_t pair_index(uint16_t a, uint16_t b) const {
+        return a < b ? static_cast<size_t>(a) * population_.size() + b
+                     : static_cast<size_t>(b) * population_.size() + a;
+    }
+
+    std::vector<Entrant> population_;
+    LeagueOptions options_;
+    uint32_t round_{0};
+    std::vector<uint32_t> pair_drafts_;  // [min * size + max]
+};
+
+}  // namespace engine::league
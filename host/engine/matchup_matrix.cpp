@@ -0,0 +1,319 @@
+#include "matchup_matrix.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "data/move.hpp"
+#include "data/rental.hpp"
+#include "engine/ai.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/platform.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+namespace {
+
+/// Order-dependent fold of one field into a fingerprint
+constexpr uint64_t fold(uint64_t hash, uint64_t value) {
+    return util::random::mix64(hash ^ util::random::mix64(value));
+}
+
+/// Seed of battle k of cell (row, column): independent of which cells a run computes
+uint64_t cell_battle_seed(uint64_t seed, size_t row, size_t column, uint32_t k) {
+    const uint64_t cell = util::random::mix64(seed ^ util::random::mix64(row << 32 | column));
+    return util::random::mix64(cell + k);
+}
+
+}  // namespace
+
+Policy matrix_policy(MatrixPolicy policy) {
+    return policy == MatrixPolicy::SEARCH ? ai::search_policy : random_move_policy;
+}
+
+uint64_t rental_fingerprint(size_t index) {
+    const types::Rental rental = data::rental(index);
+    const types::Species& species = *logic::setup::lookup_species(rental.species);
+
+    uint64_t hash = fold(0, static_cast<uint64_t>(rental.species));
+    hash = fold(hash, static_cast<uint64_t>(rental.held_item));
+    hash = fold(hash, static_cast<uint64_t>(rental.nature));
+    hash = fold(hash, rental.ev_spread.bits);
+    hash = fold(hash, rental.ability_slot);
+
+    for (const uint8_t stat : species.stats) {
+        hash = fold(hash, stat);
+    }
+    hash = fold(hash, static_cast<uint64_t>(species.type1));
+    hash = fold(hash, static_cast<uint64_t>(species.type2));
+    hash = fold(hash, static_cast<uint64_t>(species.ability1));
+    hash = fold(hash, static_cast<uint64_t>(species.ability2));
+
+    for (const types::enums::Move id : rental.moves) {
+        const types::Move& move = data::g_MOVE_TABLE[static_cast<size_t>(id)];
+        hash = fold(hash, static_cast<uint64_t>(move.id));
+        hash = fold(hash, static_cast<uint64_t>(move.type));
+        hash = fold(hash, move.power);
+        hash = fold(hash, move.accuracy);
+        hash = fold(hash, move.pp);
+        hash = fold(hash, static_cast<uint8_t>(move.priority));
+        hash = fold(hash, static_cast<uint64_t>(move.effect));
+        hash = fold(hash, move.effect_chance);
+        hash = fold(hash, static_cast<uint64_t>(move.target));
+        hash = fold(hash, move.flags.bits);
+    }
+    return hash;
+}
+
+bool rental_uses_effect(size_t index, uint16_t effect) {
+    for (const types::enums::Move id : data::rental(index).moves) {
+        if (id != types::enums::Move::NONE &&
+            static_cast<uint16_t>(data::g_MOVE_TABLE[static_cast<size_t>(id)].effect) == effect)
+            return true;
+    }
+    return false;
+}
+
+size_t compute_matchups(BatchRunner& runner, const MatrixParams& params, size_t rental_count,
+                        std::span<const uint8_t> dirty, std::span<MatchupCell> cells) {
+    std::vector<uint32_t> pending;
+    for (size_t row = 0; row < rental_count; ++row) {
+        for (size_t column = 0; column < rental_count; ++column) {
+            if (dirty[row] || dirty[column])
+                pending.push_back(static_cast<uint32_t>(row * rental_count + column));
+        }
+    }
+
+    const Policy policy = matrix_policy(params.policy);
+    runner.parallel_for(
+        pending.size(),
+        [&](unsigned, size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) {
+                const size_t row = pending[p] / rental_count;
+                const size_t column = pending[p] % rental_count;
+
+                BatchJob job{};
+                job.rental_a = static_cast<uint16_t>(row);
+                job.rental_b = static_cast<uint16_t>(column);
+                job.policy_a = policy;
+                job.policy_b = policy;
+                job.level = params.level;
+                job.max_turns = params.max_turns;
+
+                BatchTotals totals{};
+                for (uint32_t k = 0; k < params.battles_per_pair; ++k) {
+                    job.seed = cell_battle_seed(params.seed, row, column, k);
+                    const BattleOutcome outcome = run_job(job);
+                    totals.turns += outcome.turns;
+                    if (outcome.result == BattleResult::P1_WINS) {
+                        ++totals.p1_wins;
+                    } else if (outcome.result == BattleResult::ONGOING) {
+                        ++totals.unfinished;
+                    }
+                }
+
+                const double battles = params.battles_per_pair ? params.battles_per_pair : 1;
+                cells[pending[p]] = MatchupCell{
+                    static_cast<float>((totals.p1_wins + 0.5 * totals.unfinished) / battles),
+                    static_cast<float>(totals.turns / battles)};
+            }
+        },
+        1);
+    return pending.size();
+}
+
+bool write_matrix(const char* path, const MatrixParams& params,
+                  std::span<const uint64_t> fingerprints, std::span<const MatchupCell> cells) {
+    MatrixHeader header{};
+    std::memcpy(header.magic, MATRIX_MAGIC, sizeof(header.magic));
+    header.version = MATRIX_VERSION;
+    header.header_size = sizeof(MatrixHeader);
+    header.rental_count = static_cast<uint32_t>(fingerprints.size());
+    header.battles_per_pair = params.battles_per_pair;
+    header.seed = params.seed;
+    header.rules_version = MATRIX_RULES_VERSION;
+    header.max_turns = params.max_turns;
+    header.level = params.level;
+    header.policy = static_cast<uint8_t>(params.policy);
+    header.cell_size = sizeof(MatchupCell);
+    header.fingerprints_offset = sizeof(MatrixHeader);
+    header.cells_offset = sizeof(MatrixHeader) + fingerprints.size_bytes();
+
+    // Readers may have the old file mapped: never write it in place
+    const std::string temporary = std::string(path) + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(fingerprints.data(), 1, fingerprints.size_bytes(), file) ==
+                   fingerprints.size_bytes();
+    ok = ok && std::fwrite(cells.data(), 1, cells.size_bytes(), file) == cells.size_bytes();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint8_t write_advisor_appvars(const MatchupMatrixView& matrix, const char* prefix) {
+    using factory::ADVISOR_PART_BYTES;
+    using factory::AdvisorPartHeader;
+
+    const uint32_t count = matrix.rental_count();
+    auto side_averaged = [&](size_t i, size_t j) {
+        const double win = 0.5 * (matrix.cell(i, j).win_rate + 1.0 - matrix.cell(j, i).win_rate);
+        return static_cast<uint8_t>(std::lround(255.0 * win));
+    };
+
+    std::vector<uint8_t> ratings(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t total = 0;
+        for (size_t j = 0; j < count; ++j) {
+            total += i == j ? factory::ADVISOR_EVEN : side_averaged(i, j);
+        }
+        ratings[i] = static_cast<uint8_t>((total + count / 2) / count);
+    }
+
+    // Whole rows per part; part 0 also carries the ratings
+    std::vector<std::vector<uint8_t>> parts;
+    std::vector<uint16_t> first_rows;
+    for (uint32_t row = 0; row < count;) {
+        std::vector<uint8_t> payload;
+        if (parts.empty())
+            payload = ratings;
+        first_rows.push_back(static_cast<uint16_t>(row));
+        while (row < count) {
+            const uint32_t length = count - row - 1;
+            if (sizeof(AdvisorPartHeader) + payload.size() + length > ADVISOR_PART_BYTES &&
+                row > first_rows.back())
+                break;
+            for (uint32_t column = row + 1; column < count; ++column) {
+                payload.push_back(side_averaged(row, column));
+            }
+            ++row;
+        }
+        parts.push_back(std::move(payload));
+    }
+    if (count == 0 || parts.size() > factory::ADVISOR_MAX_PARTS)
+        return 0;
+
+    for (size_t p = 0; p < parts.size(); ++p) {
+        const uint16_t end_row =
+            p + 1 < parts.size() ? first_rows[p + 1] : static_cast<uint16_t>(count);
+        AdvisorPartHeader header{};
+        std::memcpy(header.magic, factory::ADVISOR_MAGIC, sizeof(header.magic));
+        header.version = factory::ADVISOR_VERSION;
+        header.part = static_cast<uint8_t>(p);
+        header.part_count = static_cast<uint8_t>(parts.size());
+        header.rental_count = static_cast<uint16_t>(count);
+        header.first_row = first_rows[p];
+        header.row_count = static_cast<uint16_t>(end_row - first_rows[p]);
+
+        std::vector<uint8_t> bytes(sizeof(header));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        bytes.insert(bytes.end(), parts[p].begin(), parts[p].end());
+
+        const std::string name = std::string(prefix).substr(0, 7) + static_cast<char>('0' + p);
+        if (!util::platform::write_appvar(name.c_str(), bytes.data(), bytes.size()))
+            return 0;
+    }
+    return static_cast<uint8_t>(parts.size());
+}
+
+// ============================================================================
+//                            MATRIX VIEW (mmap)
+// ============================================================================
+
+MatchupMatrixView::~MatchupMatrixView() { close(); }
+
+MatchupMatrixView::MatchupMatrixView(MatchupMatrixView&& other) noexcept {
+    *this = std::move(other);
+}
+
+MatchupMatrixView& MatchupMatrixView::operator=(MatchupMatrixView&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapping_ = other.mapping_;
+        mapped_size_ = other.mapped_size_;
+        header_ = other.header_;
+        fingerprints_ = other.fingerprints_;
+        cells_ = other.cells_;
+        other.mapping_ = nullptr;
+        other.mapped_size_ = 0;
+        other.header_ = nullptr;
+        other.fingerprints_ = nullptr;
+        other.cells_ = nullptr;
+    }
+    return *this;
+}
+
+bool MatchupMatrixView::open(const char* path) {
+    close();
+
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MatrixHeader)) {
+        ::close(fd);
+        return false;
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED)
+        return false;
+
+    const auto* bytes = static_cast<const uint8_t*>(mapping);
+    const auto* header = reinterpret_cast<const MatrixHeader*>(bytes);
+    const uint64_t count = header->rental_count;
+    const bool valid =
+        std::memcmp(header->magic, MATRIX_MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == MATRIX_VERSION && header->header_size == sizeof(MatrixHeader) &&
+        header->cell_size == sizeof(MatchupCell) && header->fingerprints_offset % 8 == 0 &&
+        header->cells_offset % 8 == 0 &&
+        header->fingerprints_offset + count * sizeof(uint64_t) <= size &&
+        header->cells_offset + count * count * sizeof(MatchupCell) <= size;
+    if (!valid) {
+        ::munmap(mapping, size);
+        return false;
+    }
+
+    mapping_ = mapping;
+    mapped_size_ = size;
+    header_ = header;
+    fingerprints_ = reinterpret_cast<const uint64_t*>(bytes + header->fingerprints_offset);
+    cells_ = reinterpret_cast<const MatchupCell*>(bytes + header->cells_offset);
+    return true;
+}
+
+void MatchupMatrixView::close() {
+    if (mapping_)
+        ::munmap(mapping_, mapped_size_);
+    mapping_ = nullptr;
+    mapped_size_ = 0;
+    header_ = nullptr;
+    fingerprints_ = nullptr;
+    cells_ = nullptr;
+}
+
+MatrixParams MatchupMatrixView::params() const {
+    MatrixParams params{};
+    params.battles_per_pair = header_->battles_per_pair;
+    params.seed = header_->seed;
+    params.level = header_->level;
+    params.max_turns = header_->max_turns;
+    params.policy = static_cast<MatrixPolicy>(header_->policy);
+    return params;
+}
+
+}  // namespace engine
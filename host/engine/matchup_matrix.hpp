@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file matchup_matrix.hpp
+ * @brief Rental x rental matchup matrix: generation and zero-copy reading (host only)
+ *
+ * Cell (i, j) holds player 1's win rate and the expected battle length for
+ * g_RENTAL_SETS[i] (player 1) vs. g_RENTAL_SETS[j], estimated from a fixed
+ * number of battles under one policy.
+ *
+ * File layout (little-endian, every section 8-byte aligned):
+ *
+ *   MatrixHeader                       64 bytes
+ *   uint64_t fingerprints[N]           rental_fingerprint() of each row's rental
+ *   MatchupCell cells[N * N]           row-major, row = player 1
+ *
+ * Readers mmap the file (MatchupMatrixView) and index cells in place.
+ * Writers replace the file by rename, so a mapped old version stays valid.
+ *
+ * Incremental regeneration compares the stored fingerprints against the
+ * current data tables: only pairs that involve a changed rental (as row
+ * or column) are replayed. Battle k of cell (i, j) is seeded from
+ * (seed, i, j, k) alone, so a cell comes out the same whether it was
+ * computed in a full or an incremental run.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "batch.hpp"
+#include "engine/advisor.hpp"
+#include "engine/rules.hpp"
+
+namespace engine {
+
+inline constexpr char MATRIX_MAGIC[4] = {'B', 'M', 'M', 'X'};
+inline constexpr uint16_t MATRIX_VERSION = 1;
+
+/// Rules the cells were played under (engine/rules.hpp)
+inline constexpr uint32_t MATRIX_RULES_VERSION = RULES_VERSION;
+
+/// Policy both players use while generating a matrix
+enum class MatrixPolicy : uint8_t {
+    RANDOM = 0,  // random_move_policy
+    SEARCH = 1,  // ai::search_policy
+};
+
+struct MatchupCell {
+    float win_rate;        // Player 1 wins (+ half of unfinished) / battles
+    float expected_turns;  // Mean battle length
+};
+
+struct MatrixHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t rental_count;
+    uint32_t battles_per_pair;
+    uint64_t seed;
+    uint32_t rules_version;
+    uint16_t max_turns;
+    uint8_t level;
+    uint8_t policy;  // MatrixPolicy
+    uint16_t cell_size;
+    uint16_t reserved0;
+    uint32_t reserved1;
+    uint64_t fingerprints_offset;
+    uint64_t cells_offset;
+    uint64_t reserved2;
+};
+
+static_assert(sizeof(MatrixHeader) == 64, "matrix header is part of the file format");
+static_assert(sizeof(MatchupCell) == 8, "matrix cells are part of the file format");
+
+/// What a matrix was generated with (cells are only comparable if all match)
+struct MatrixParams {
+    uint32_t battles_per_pair{100};
+    uint64_t seed{0x4D41'5452};
+    uint8_t level{50};
+    uint16_t max_turns{DEFAULT_MAX_TURNS};
+    MatrixPolicy policy{MatrixPolicy::RANDOM};
+};
+
+/// Policy function of a MatrixPolicy
+Policy matrix_policy(MatrixPolicy policy);
+
+/**
+ * @brief Fingerprint of everything a rental's matchups depend on in the data.
+ *
+ * Covers the rental set, its species row and the move table rows of its
+ * moves (including their effect ids).
+ */
+uint64_t rental_fingerprint(size_t index);
+
+/// True if any of the rental's moves dispatches to `effect`
+bool rental_uses_effect(size_t index, uint16_t effect);
+
+/**
+ * @brief Play every pair (i, j) with dirty[i] or dirty[j] and fill its cell.
+ *
+ * @param rental_count N (the first N rental sets)
+ * @param dirty N flags
+ * @param cells N * N cells, row-major; other cells are left as they are
+ *
+ * @return Number of cells computed
+ */
+size_t compute_matchups(BatchRunner& runner, const MatrixParams& params, size_t rental_count,
+                        std::span<const uint8_t> dirty, std::span<MatchupCell> cells);
+
+/**
+ * @brief Write a matrix file (via a temporary file and rename).
+ *
+ * @return false on I/O failure
+ */
+bool write_matrix(const char* path, const MatrixParams& params,
+                  std::span<const uint64_t> fingerprints, std::span<const MatchupCell> cells);
+
+class MatchupMatrixView;
+
+/**
+ * @brief Quantize a matrix into factory::Advisor AppVars (engine/advisor.hpp).
+ *
+ * Writes "<prefix>0", "<prefix>1", ... through util::platform::write_appvar()
+ * (files `<prefix>N.bin` on host; convert each to .8xv with convbin).
+ *
+ * @return Number of parts written (0 on failure)
+ */
+uint8_t write_advisor_appvars(const MatchupMatrixView& matrix,
+                              const char* prefix = factory::ADVISOR_APPVAR_PREFIX);
+
+// ============================================================================
+//                            MATRIX VIEW (mmap)
+// ============================================================================
+
+class MatchupMatrixView {
+   public:
+    MatchupMatrixView() = default;
+    ~MatchupMatrixView();
+
+    MatchupMatrixView(MatchupMatrixView&& other) noexcept;
+    MatchupMatrixView& operator=(MatchupMatrixView&& other) noexcept;
+    MatchupMatrixView(const MatchupMatrixView&) = delete;
+    MatchupMatrixView& operator=(const MatchupMatrixView&) = delete;
+
+    /**
+     * @brief Map `path` read-only and validate its header and extent.
+     *
+     * @return false if the file is missing, truncated or not a version-1 matrix
+     */
+    bool open(const char* path);
+    void close();
+
+    [[nodiscard]] bool valid() const { return header_ != nullptr; }
+    [[nodiscard]] const MatrixHeader& header() const { return *header_; }
+    [[nodiscard]] uint32_t rental_count() const { return header_->rental_count; }
+
+    /// Generation parameters stored in the header
+    [[nodiscard]] MatrixParams params() const;
+
+    [[nodiscard]] std::span<const uint64_t> fingerprints() const {
+        return {fingerprints_, header_->rental_count};
+    }
+
+    /// Matchup of rental p1 (player 1) vs. rental p2
+    [[nodiscard]] const MatchupCell& cell(size_t p1, size_t p2) const {
+        return cells_[p1 * header_->rental_count + p2];
+    }
+
+    [[nodiscard]] std::span<const MatchupCell> cells() const {
+        return {cells_, static_cast<size_t>(header_->rental_count) * header_->rental_count};
+    }
+
+   private:
+    void* mapping_{nullptr};
+    size_t mapped_size_{0};
+    const MatrixHeader* header_{nullptr};
+    const uint64_t* fingerprints_{nullptr};
+    const MatchupCell* cells_{nullptr};
+};
+
+}  // namespace engine
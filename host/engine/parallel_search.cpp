@@ -0,0 +1,84 @@
+#include "parallel_search.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace engine::ai {
+
+SearchResult parallel_search(BatchRunner& runner, SharedTranspositionTable& table,
+                             const BattleEngine& battle, uint8_t side,
+                             const SearchLimits& limits) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    const ActionList mine = candidate_actions(battle, side);
+    const ActionList theirs = candidate_actions(battle, static_cast<uint8_t>(side ^ 1));
+    const size_t pairs = static_cast<size_t>(mine.count) * theirs.count;
+
+    const uint8_t max_depth =
+        limits.max_depth < MAX_SEARCH_DEPTH ? limits.max_depth : MAX_SEARCH_DEPTH;
+
+    // One searcher (engine copy + ply snapshots) per worker
+    std::vector<std::unique_ptr<Searcher<SharedTranspositionTable>>> searchers(
+        runner.thread_count());
+
+    table.new_search();
+    SearchResult result{mine.actions[0], 0, 0, 0};
+    std::vector<int16_t> values(pairs);
+
+    for (uint8_t depth = 1; depth <= max_depth; ++depth) {
+        SearchLimits round = limits;
+        if (limits.time_budget_ms) {
+            const auto spent =
+                std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+            if (spent.count() >= limits.time_budget_ms)
+                break;
+            round.time_budget_ms = limits.time_budget_ms - static_cast<uint32_t>(spent.count());
+        }
+        for (auto& searcher : searchers) {
+            searcher = std::make_unique<Searcher<SharedTranspositionTable>>(table, round);
+            searcher->begin(battle, side);
+        }
+
+        std::atomic<bool> aborted{false};
+        runner.parallel_for(
+            pairs,
+            [&](unsigned worker, size_t begin, size_t end) {
+                for (size_t i = begin; i < end && !aborted.load(std::memory_order_relaxed); ++i) {
+                    const BattleAction& action = mine.actions[i / theirs.count];
+                    const BattleAction& reply = theirs.actions[i % theirs.count];
+                    if (!searchers[worker]->pair_value(action, reply, depth, values[i])) {
+                        aborted.store(true, std::memory_order_relaxed);
+                    }
+                }
+            },
+            1);
+
+        for (const auto& searcher : searchers) {
+            result.nodes += searcher->nodes();
+        }
+        if (aborted.load(std::memory_order_relaxed))
+            break;
+
+        int16_t best_value = INT16_MIN;
+        for (uint8_t a = 0; a < mine.count; ++a) {
+            int16_t worst = INT16_MAX;
+            for (uint8_t r = 0; r < theirs.count; ++r) {
+                const int16_t value = values[static_cast<size_t>(a) * theirs.count + r];
+                if (value < worst)
+                    worst = value;
+            }
+            if (worst > best_value) {
+                best_value = worst;
+                result.action = mine.actions[a];
+            }
+        }
+        result.value = best_value;
+        result.depth = depth;
+    }
+    return result;
+}
+
+}  // namespace engine::ai
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @file parallel_search.hpp
+ * @brief Multithreaded search on the batch thread pool (host only)
+ *
+ * Runs the engine::ai expectiminimax with every worker of a BatchRunner.
+ * Each iteration of the deepening splits the root's (own action, reply)
+ * pairs across the workers, which share one lock-free transposition table;
+ * the pair values are then reduced to max-over-actions of min-over-replies
+ * exactly as the single-threaded search does.
+ */
+
+#include <cstdint>
+
+#include "batch.hpp"
+#include "engine/ai.hpp"
+#include "shared_transposition.hpp"
+
+namespace engine::ai {
+
+/**
+ * @brief Choose `side`'s action using every worker of `runner`.
+ *
+ * The time budget covers the whole search; the node budget applies to each
+ * worker per iteration. Values match the single-threaded search at the
+ * same depth, but which stored results get reused depends on scheduling.
+ *
+ * @param runner Thread pool to run on
+ * @param table Table shared by all workers (kept between calls)
+ * @param battle Battle to decide in (not modified)
+ * @param side 0 = player 1, 1 = player 2
+ * @param limits Search limits
+ */
+SearchResult parallel_search(BatchRunner& runner, SharedTranspositionTable& table,
+                             const BattleEngine& battle, uint8_t side,
+                             const SearchLimits& limits);
+
+}  // namespace engine::ai
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file shared_transposition.hpp
+ * @brief Lock-free transposition table shared by search threads (host only)
+ *
+ * Same buckets, packed data and replacement scheme as TranspositionTable
+ * (engine/transposition.hpp), sized at runtime. Every entry is one 64-bit
+ * atomic word:
+ *
+ *   high 32 bits: (hash >> 32) ^ data
+ *   low 32 bits:  data (pack_tt_data)
+ *
+ * A probe accepts an entry only if un-XORing the data gives back the hash
+ * check, so an entry that another thread is replacing or that belongs to a
+ * different position is rejected as a miss. Threads never lock: concurrent
+ * stores to one bucket may lose one of the results, which only costs a
+ * re-search.
+ */
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "engine/transposition.hpp"
+
+namespace engine {
+
+class SharedTranspositionTable {
+   public:
+    /**
+     * @param bytes Memory budget (rounded down to a power-of-two bucket count)
+     */
+    explicit SharedTranspositionTable(size_t bytes) {
+        const size_t buckets = bytes / sizeof(Bucket);
+        bucket_count_ = buckets > 1 ? std::bit_floor(buckets) : 1;
+        buckets_ = std::make_unique<Bucket[]>(bucket_count_);
+    }
+
+    [[nodiscard]] size_t bytes() const { return bucket_count_ * sizeof(Bucket); }
+
+    /// Empty every entry (not concurrently with probe/store)
+    void clear() {
+        for (size_t b = 0; b < bucket_count_; ++b) {
+            for (std::atomic<uint64_t>& word : buckets_[b].words) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Start a new search: older results become the first to be replaced
+    void new_search() {
+        const uint8_t next = (generation_.load(std::memory_order_relaxed) + 1) & 0x3;
+        generation_.store(next, std::memory_order_relaxed);
+    }
+
+    /// Look up a position; thread-safe
+    bool probe(uint64_t hash, TTData& out) const {
+        const Bucket& bucket = bucket_for(hash);
+        const uint32_t check = static_cast<uint32_t>(hash >> 32);
+        for (const std::atomic<uint64_t>& word : bucket.words) {
+            const uint64_t entry = word.load(std::memory_order_relaxed);
+            const auto data = static_cast<uint32_t>(entry);
+            if (entry_check(entry) == check && tt_bound(data) != TTBound::NONE) {
+                out = unpack_tt_data(data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Store a search result; thread-safe (see TranspositionTable::store)
+    void store(uint64_t hash, const TTData& data) {
+        Bucket& bucket = bucket_for(hash);
+        const uint32_t check = static_cast<uint32_t>(hash >> 32);
+        const uint8_t generation = generation_.load(std::memory_order_relaxed);
+        const uint32_t packed = pack_tt_data(data, generation);
+
+        std::atomic<uint64_t>* victim = &bucket.words[0];
+        uint16_t victim_priority = UINT16_MAX;
+        for (std::atomic<uint64_t>& word : bucket.words) {
+            const uint64_t entry = word.load(std::memory_order_relaxed);
+            const auto existing = static_cast<uint32_t>(entry);
+            if (tt_bound(existing) == TTBound::NONE) {
+                victim = &word;
+                break;
+            }
+            if (entry_check(entry) == check) {
+                if (tt_generation(existing) == generation &&
+                    unpack_tt_data(existing).depth > data.depth)
+                    return;
+                victim = &word;
+                break;
+            }
+            const uint16_t priority = tt_keep_priority(existing, generation);
+            if (priority < victim_priority) {
+                victim = &word;
+                victim_priority = priority;
+            }
+        }
+        victim->store(static_cast<uint64_t>(check ^ packed) << 32 | packed,
+                      std::memory_order_relaxed);
+    }
+
+   private:
+    struct alignas(32) Bucket {
+        std::atomic<uint64_t> words[TT_BUCKET_SIZE]{};
+    };
+
+    static uint32_t entry_check(uint64_t entry) {
+        return static_cast<uint32_t>(entry >> 32) ^ static_cast<uint32_t>(entry);
+    }
+
+    const Bucket& bucket_for(uint64_t hash) const {
+        return buckets_[static_cast<uint32_t>(hash) & (bucket_count_ - 1)];
+    }
+    Bucket& bucket_for(uint64_t hash) {
+        return buckets_[static_cast<uint32_t>(hash) & (bucket_count_ - 1)];
+    }
+
+    std::unique_ptr<Bucket[]> buckets_;
+    size_t bucket_count_{1};
+    std::atomic<uint8_t> generation_{0};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "table entries must be lock-free");
+
+}  // namespace engine
@@ -0,0 +1,339 @@
+#include "usage_report.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "data/move.hpp"
+#include "data/rental.hpp"
+#include "dsl/item/dispatch.hpp"
+#include "dsl/item/event_mask.hpp"
+#include "dsl/trace.hpp"
+#include "engine/battle.hpp"
+#include "engine/battle_log.hpp"
+#include "engine/dispatch.hpp"
+#include "logic/state/event_queue.hpp"
+
+namespace engine::usage {
+
+namespace {
+
+using types::enums::Effect;
+using types::enums::Item;
+using types::enums::Move;
+using util::profile::Section;
+
+// ============================================================================
+//                             ENUMERATOR NAMES
+// ============================================================================
+
+/// Unqualified name of an enumerator, from the compiler's signature
+template <auto Value>
+consteval std::string_view enumerator_name() {
+    std::string_view sig = __PRETTY_FUNCTION__;
+    const size_t start = sig.find("Value = ") + 8;
+    const size_t end = sig.find_first_of(";]", start);
+    const std::string_view name = sig.substr(start, end - start);
+    return name.substr(name.rfind(':') + 1);
+}
+
+template <typename Enum, size_t... Is>
+consteval std::array<std::string_view, sizeof...(Is)> enumerator_names(
+    std::index_sequence<Is...>) {
+    return {enumerator_name<static_cast<Enum>(Is)>()...};
+}
+
+constexpr auto EFFECT_NAMES = enumerator_names<Effect>(std::make_index_sequence<EFFECT_COUNT>{});
+constexpr auto ITEM_NAMES =
+    enumerator_names<Item>(std::make_index_sequence<dsl::item::ITEM_COUNT>{});
+constexpr auto MOVE_NAMES = enumerator_names<Move>(std::make_index_sequence<data::MOVE_COUNT>{});
+
+static_assert(EFFECT_NAMES[static_cast<size_t>(Effect::MULTI_HIT)] == "MULTI_HIT");
+static_assert(ITEM_NAMES[static_cast<size_t>(Item::LEFTOVERS)] == "LEFTOVERS");
+
+/// Type name without the namespaces commands and routines use (and EFFECT()'s prefix)
+std::string short_name(std::string_view name) {
+    std::string out(name);
+    for (const std::string_view prefix : {"logic::ops::", "logic::routines::", "logic::state::",
+                                          "types::enums::", "dsl::", "Effect_"}) {
+        for (size_t at; (at = out.find(prefix)) != std::string::npos;) {
+            out.erase(at, prefix.size());
+        }
+    }
+    // An action's full type (a Match of Branches) is not a useful row name
+    const size_t open = out.find('<');
+    if (open != std::string::npos && out.size() > 48) {
+        out.resize(open);
+        out += "<...>";
+    }
+    return out;
+}
+
+// ============================================================================
+//                              ROUTINE STEPS
+// ============================================================================
+
+template <typename Step>
+struct StepCommand {
+    using type = Step;
+};
+
+template <typename Cmd>
+struct StepCommand<dsl::WithArgs<Cmd>> {
+    using type = Cmd;
+};
+
+/// Steps of a body from `Stage` on, as Pipeline::run() executes them
+template <typename Stage, typename... Steps>
+struct StepList {
+    static void add(std::vector<RoutineStep>&) {}
+};
+
+template <typename Stage, typename Step, typename... Rest>
+struct StepList<Stage, Step, Rest...> {
+    static void add(std::vector<RoutineStep>& steps) {
+        using Cmd = typename StepCommand<Step>::type;
+        using Next = typename Cmd::output_stage;
+        const Section transition =
+            dsl::meta::Command<Cmd> ? dsl::TRANSITION_SECTION<Stage, Next> : Section::COUNT;
+        steps.push_back(RoutineStep{dsl::trace::type_name<Cmd>(), transition});
+        StepList<Next, Rest...>::add(steps);
+    }
+};
+
+template <typename Pipeline>
+struct BodySteps;
+
+template <dsl::Domain Allowed, typename... Steps>
+struct BodySteps<dsl::StepPipeline<Allowed, Steps...>> {
+    using list = StepList<dsl::Genesis, Steps...>;
+};
+
+// ============================================================================
+//                               RENTAL JOIN
+// ============================================================================
+
+struct RentalWeights {
+    std::array<uint64_t, EFFECT_COUNT> effect_slots{};
+    std::array<uint64_t, dsl::item::ITEM_COUNT> holders{};
+    uint64_t slots{0};
+};
+
+RentalWeights rental_weights() {
+    RentalWeights weights{};
+    for (const types::Rental& rental : data::g_RENTAL_SETS) {
+        ++weights.holders[static_cast<size_t>(rental.held_item)];
+        for (const Move move : rental.moves) {
+            if (move == Move::NONE)
+                continue;
+            const Effect effect = data::g_MOVE_TABLE[static_cast<size_t>(move)].effect;
+            ++weights.effect_slots[static_cast<size_t>(effect)];
+            ++weights.slots;
+        }
+    }
+    return weights;
+}
+
+/// Item events by their dispatch section, in EVENT_BIT order
+struct ItemEvent {
+    uint8_t bit;
+    Section section;
+};
+
+template <typename... Events>
+constexpr std::array<ItemEvent, sizeof...(Events)> item_events() {
+    return {ItemEvent{dsl::item::EVENT_BIT<Events>, dsl::item::EVENT_SECTION<Events>}...};
+}
+
+constexpr auto ITEM_EVENTS =
+    item_events<dsl::item::OnPreDamageCalc, dsl::item::OnPreDamageApply,
+                dsl::item::OnPostDamageApply, dsl::item::OnTurnStart, dsl::item::OnTurnEnd,
+                dsl::item::OnItemCheck>();
+
+std::string item_event_names(uint8_t mask) {
+    std::string names;
+    for (const ItemEvent& event : ITEM_EVENTS) {
+        if (!(mask & event.bit))
+            continue;
+        if (!names.empty())
+            names += ' ';
+        names += util::profile::SECTION_NAMES[static_cast<size_t>(event.section)];
+    }
+    return names.empty() ? "-" : names;
+}
+
+void sort_rows(std::vector<UsageRow>& rows) {
+    std::stable_sort(rows.begin(), rows.end(), [](const UsageRow& a, const UsageRow& b) {
+        return a.battle != b.battle ? a.battle > b.battle : a.rental > b.rental;
+    });
+}
+
+/// Row `name` of `rows`, added if missing
+UsageRow& row_named(std::vector<UsageRow>& rows, const std::string& name) {
+    for (UsageRow& row : rows) {
+        if (row.name == name)
+            return row;
+    }
+    rows.push_back(UsageRow{name, {}});
+    return rows.back();
+}
+
+/// Items with handlers the two battlers go into a turn holding (NONE for none)
+std::array<Item, 2> held_items(const BattleEngine& battle) {
+    const auto held = [](const logic::state::SlotState& slot) {
+        return slot.item_events != 0 ? slot.held_item : Item::NONE;
+    };
+    return {held(battle.p1_slot()), held(battle.p2_slot())};
+}
+
+void count_events(logic::state::EventQueue& queue, UsageCounts& counts) {
+    counts.dropped_events += queue.dropped();
+    logic::state::BattleEvent event;
+    while (queue.pop(event)) {
+        if (event.type == logic::state::EventType::MOVE_USED && event.value < data::MOVE_COUNT) {
+            ++counts.move_runs[event.value];
+            ++counts.effect_runs[static_cast<size_t>(data::g_MOVE_TABLE[event.value].effect)];
+        } else if (event.type == logic::state::EventType::ITEM &&
+                   event.value < dsl::item::ITEM_COUNT) {
+            ++counts.item_activations[event.value];
+        }
+    }
+    queue.clear();
+}
+
+}  // namespace
+
+// ============================================================================
+//                                 LOOKUPS
+// ============================================================================
+
+std::string_view effect_name(Effect effect) {
+    const auto index = static_cast<size_t>(effect);
+    return index < EFFECT_NAMES.size() ? EFFECT_NAMES[index] : "?";
+}
+
+std::string_view item_name(Item item) {
+    const auto index = static_cast<size_t>(item);
+    return index < ITEM_NAMES.size() ? ITEM_NAMES[index] : "?";
+}
+
+std::string_view move_name(Move move) {
+    const auto index = static_cast<size_t>(move);
+    return index < MOVE_NAMES.size() ? MOVE_NAMES[index] : "?";
+}
+
+RoutineInfo routine_of(Effect effect) {
+    RoutineInfo info{};
+    visit_effect_routine(effect, [&info, effect]<typename Routine>(RoutineTag<Routine>) {
+        info.name = dsl::trace::type_name<Routine>();
+        info.stub = std::is_same_v<Routine, logic::routines::Hit> && effect != Effect::HIT;
+        if constexpr (dsl::meta::Action<Routine>) {
+            info.steps.push_back(RoutineStep{info.name, Section::COUNT});
+        } else {
+            BodySteps<dsl::effect_steps_t<Routine>>::list::add(info.steps);
+        }
+    });
+    return info;
+}
+
+// ============================================================================
+//                                 REPLAY
+// ============================================================================
+
+UsageCounts::UsageCounts()
+    : effect_runs(EFFECT_COUNT),
+      move_runs(data::MOVE_COUNT),
+      item_activations(dsl::item::ITEM_COUNT),
+      holder_turns(dsl::item::ITEM_COUNT) {}
+
+bool tally_logs(const uint8_t* bytes, size_t size, UsageCounts& counts) {
+    BattleEngine battle;
+    logic::state::EventQueue queue;
+    for (size_t offset = 0; offset < size;) {
+        const size_t extent = log_extent(bytes + offset, size - offset);
+        if (extent == 0)
+            return false;
+        const BattleLog log{bytes + offset, extent};
+        offset += extent;
+        ++counts.battles;
+
+        ReplayStatus status = battle.init_from_log(log);
+        battle.attach_events(&queue);
+        BattleLogReader reader(log);
+        while (status == ReplayStatus::OK) {
+            const uint32_t turn = reader.turn();
+            const std::array<Item, 2> held = held_items(battle);
+            status = battle.replay_turns(reader, turn + 1);
+            count_events(queue, counts);
+            if (reader.turn() == turn)
+                break;  // End marker
+            ++counts.turns;
+            for (const Item item : held) {
+                if (item != Item::NONE)
+                    ++counts.holder_turns[static_cast<size_t>(item)];
+            }
+        }
+        battle.attach_events(nullptr);
+        counts.failed += status != ReplayStatus::OK;
+    }
+    return true;
+}
+
+// ============================================================================
+//                                 REPORT
+// ============================================================================
+
+UsageReport build_report(const UsageCounts& counts) {
+    const RentalWeights weights = rental_weights();
+    UsageReport report{};
+    report.rental_slots = weights.slots;
+    report.turns = counts.turns;
+
+    for (size_t e = 1; e < EFFECT_COUNT; ++e) {
+        const auto effect = static_cast<Effect>(e);
+        const uint64_t rental = weights.effect_slots[e];
+        const uint64_t battle = counts.effect_runs[e];
+        if (rental == 0 && battle == 0)
+            continue;
+
+        const RoutineInfo routine = routine_of(effect);
+        UsageRow row{std::string(effect_name(effect)),
+                     routine.name.empty() ? "(none)" : short_name(routine.name), rental, battle};
+        row.stub = routine.stub;
+        report.effects.push_back(row);
+        if (row.stub)
+            report.stubs.push_back(row);
+
+        for (const RoutineStep& step : routine.steps) {
+            UsageRow& command = row_named(report.commands, short_name(step.name));
+            command.rental += rental;
+            command.battle += battle;
+            if (step.transition == Section::COUNT)
+                continue;
+            UsageRow& transition = row_named(
+                report.transitions,
+                util::profile::SECTION_NAMES[static_cast<size_t>(step.transition)]);
+            transition.rental += rental;
+            transition.battle += battle;
+        }
+    }
+
+    for (size_t i = 1; i < dsl::item::ITEM_COUNT; ++i) {
+        if (weights.holders[i] == 0 && counts.holder_turns[i] == 0)
+            continue;
+        const auto item = static_cast<Item>(i);
+        UsageRow row{std::string(item_name(item)),
+                     item_event_names(dsl::item::item_event_mask(item)), weights.holders[i],
+                     counts.item_activations[i], counts.holder_turns[i]};
+        report.items.push_back(row);
+    }
+
+    sort_rows(report.effects);
+    sort_rows(report.stubs);
+    sort_rows(report.commands);
+    sort_rows(report.transitions);
+    sort_rows(report.items);
+    return report;
+}
+
+}  // namespace engine::usage
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file usage_report.hpp
+ * @brief What battles actually dispatch to, weighted by rental and battle usage (host only)
+ *
+ * Every row of the report carries two weights:
+ *
+ *   rental  the static join g_RENTAL_SETS -> g_MOVE_TABLE -> Effect: move
+ *           slots over every rental set whose move runs an effect (the
+ *           weight BATTLEMON_USAGE_ORDERED_DISPATCH lays the dispatch table
+ *           out by), or rental sets holding an item
+ *   battle  executions in battles replayed from logs (battlemon_sim --log)
+ *
+ * A replay runs with an event queue attached. MOVE_USED is emitted right
+ * before dispatch_move_effect(), so it counts effect runs exactly; ITEM
+ * events count item activations, and a turn started with an active,
+ * unconsumed item that has handlers is one holder turn of that item.
+ *
+ * Commands and stage transitions are not instrumented: counting them at
+ * runtime takes a tracer build (dsl/trace.hpp). Each routine's steps are
+ * read from its EFFECT() body instead (dsl::effect_steps_t) and weighted by
+ * the routine's runs. That is exact for straight-line routines. A step that
+ * is an action (Match, Branch) is one row whichever branch it takes, and a
+ * command that loops inside (the multi-hit commands) counts once per move.
+ * Transitions are named by their profiler section (util/profile.hpp), so
+ * the rows line up with a battlemon_profile cycle report.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types/enums/effect.hpp"
+#include "types/enums/item.hpp"
+#include "types/enums/move.hpp"
+#include "util/profile.hpp"
+
+namespace engine::usage {
+
+/// One step of a routine body
+struct RoutineStep {
+    std::string_view name;              // Command or action type
+    util::profile::Section transition;  // Section of the transition it fires (COUNT: action)
+};
+
+/// The routine an effect dispatches to in this build
+struct RoutineInfo {
+    std::string_view name;  // Empty for effects that run no routine
+    bool stub{false};       // A TODO effect running Hit (engine/dispatch.hpp)
+    std::vector<RoutineStep> steps;
+};
+
+RoutineInfo routine_of(types::enums::Effect effect);
+
+/// Enumerator names (as written in types/enums/)
+std::string_view effect_name(types::enums::Effect effect);
+std::string_view item_name(types::enums::Item item);
+std::string_view move_name(types::enums::Move move);
+
+/// What the replayed battles executed
+struct UsageCounts {
+    uint64_t battles{0};
+    uint64_t turns{0};
+    uint64_t failed{0};          // Logs that did not replay (their turns up to the failure count)
+    uint64_t dropped_events{0};  // Events a full queue overwrote (not counted)
+    std::vector<uint64_t> effect_runs;       // By Effect
+    std::vector<uint64_t> move_runs;         // By Move
+    std::vector<uint64_t> item_activations;  // By Item
+    std::vector<uint64_t> holder_turns;      // By Item
+
+    UsageCounts();
+};
+
+/**
+ * @brief Replay a file of concatenated battle logs into `counts`.
+ *
+ * @return false if the bytes are not a sequence of logs (counts so far are kept)
+ */
+bool tally_logs(const uint8_t* bytes, size_t size, UsageCounts& counts);
+
+struct UsageRow {
+    std::string name;
+    std::string detail;    // Effect: routine; item: events it has handlers for
+    uint64_t rental{0};    // Rental weight (move slots or holders)
+    uint64_t battle{0};    // Executions in the replayed battles
+    uint64_t exposure{0};  // Items: holder turns
+    bool stub{false};
+};
+
+/// Report tables, each sorted by battle count, then rental weight
+struct UsageReport {
+    std::vector<UsageRow> effects;      // Effects some rental move or battle uses
+    std::vector<UsageRow> stubs;        // The stub effects among them
+    std::vector<UsageRow> commands;     // By command type
+    std::vector<UsageRow> transitions;  // By profiler section
+    std::vector<UsageRow> items;        // Items some rental holds
+    uint64_t rental_slots{0};           // Move slots over every rental set
+    uint64_t turns{0};
+};
+
+UsageReport build_report(const UsageCounts& counts);
+
+}  // namespace engine::usage
@@ -0,0 +1,825 @@
+/**
+ * @file module.cpp
+ * @brief The `battlemon` Python extension: battles and a vectorized environment
+ *
+ *   import battlemon, numpy as np
+ *   env = battlemon.VecEnv(1024, seed=7, opponent="random")
+ *   obs = np.asarray(env.reset())              # (1024, OBSERVATION_SIZE) float32, no copy
+ *   obs, rewards, dones = env.step(actions)    # actions: 1024 move slots (any int buffer)
+ *
+ * Written against the CPython C API alone (no pybind11, no NumPy headers).
+ * Results are battlemon.Array objects: views of buffers the environment
+ * owns, exported through the buffer protocol, so np.asarray() and
+ * memoryview() wrap them without copying. step() overwrites them in place;
+ * copy a result to keep it past the next step.
+ *
+ * VecEnv.reset() and VecEnv.step() run every battle in C++ with the GIL
+ * released. Python threads can step separate environments at the same time;
+ * one environment must not be stepped from two threads at once.
+ *
+ * Build: cmake -DBATTLEMON_PYTHON=ON (see CMakeLists.txt).
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "engine/observation.hpp"
+#include "engine/policy.hpp"
+#include "engine/simulate.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+using engine::BattleEngine;
+using engine::BattleResult;
+
+/// Keyword lists as PyArg_ParseTupleAndKeywords takes them before 3.13
+template <size_t N>
+char** keywords(const char* (&list)[N]) {
+    return const_cast<char**>(list);
+}
+
+// ============================================================================
+//                                 ARRAY
+// ============================================================================
+//
+// A C-contiguous 1-D or 2-D view of memory another object owns (a VecEnv's
+// result buffers). Holds a reference to the owner, so a view outlives the
+// environment safely. The owner holds its views too, so both types are
+// GC types and the collector frees the cycle once nothing else refers to it.
+//
+// ============================================================================
+
+struct ArrayObject {
+    PyObject_HEAD
+    PyObject* owner;
+    void* data;
+    char format[2];
+    Py_ssize_t itemsize;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+PyTypeObject* g_array_type = nullptr;
+
+PyObject* make_array(PyObject* owner, void* data, char format, Py_ssize_t itemsize,
+                     Py_ssize_t rows, Py_ssize_t columns = 0) {
+    auto* array = PyObject_GC_New(ArrayObject, g_array_type);
+    if (array == nullptr)
+        return nullptr;
+    array->owner = Py_NewRef(owner);
+    array->data = data;
+    array->format[0] = format;
+    array->format[1] = '\0';
+    array->itemsize = itemsize;
+    array->ndim = columns == 0 ? 1 : 2;
+    array->shape[0] = rows;
+    array->shape[1] = columns;
+    array->strides[0] = columns == 0 ? itemsize : itemsize * columns;
+    array->strides[1] = itemsize;
+    PyObject_GC_Track(array);
+    return reinterpret_cast<PyObject*>(array);
+}
+
+int array_traverse(PyObject* self, visitproc visit, void* arg) {
+    Py_VISIT(reinterpret_cast<ArrayObject*>(self)->owner);
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+int array_clear(PyObject* self) {
+    auto* array = reinterpret_cast<ArrayObject*>(self);
+    Py_CLEAR(array->owner);
+    array->data = nullptr;
+    return 0;
+}
+
+void array_dealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    array_clear(self);
+    PyObject_GC_Del(self);
+    Py_DECREF(type);
+}
+
+int array_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    auto* array = reinterpret_cast<ArrayObject*>(self);
+    if (array->owner == nullptr) {
+        PyErr_SetString(PyExc_BufferError, "the array's owner is gone");
+        view->obj = nullptr;
+        return -1;
+    }
+    Py_ssize_t count = array->shape[0];
+    if (array->ndim == 2)
+        count *= array->shape[1];
+
+    view->obj = Py_NewRef(self);
+    view->buf = array->data;
+    view->len = count * array->itemsize;
+    view->readonly = 0;
+    view->itemsize = array->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? array->format : nullptr;
+    view->ndim = array->ndim;
+    view->shape = (flags & PyBUF_ND) ? array->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) ? array->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+PyObject* array_shape(PyObject* self, void*) {
+    auto* array = reinterpret_cast<ArrayObject*>(self);
+    return array->ndim == 1 ? Py_BuildValue("(n)", array->shape[0])
+                            : Py_BuildValue("(nn)", array->shape[0], array->shape[1]);
+}
+
+PyObject* array_format(PyObject* self, void*) {
+    return PyUnicode_FromString(reinterpret_cast<ArrayObject*>(self)->format);
+}
+
+Py_ssize_t array_length(PyObject* self) {
+    return reinterpret_cast<ArrayObject*>(self)->shape[0];
+}
+
+PyGetSetDef g_array_getset[] = {
+    {"shape", array_shape, nullptr, "Dimensions of the view", nullptr},
+    {"format", array_format, nullptr, "struct-module format of one element", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+PyType_Slot g_array_slots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(array_dealloc)},
+    {Py_tp_traverse, reinterpret_cast<void*>(array_traverse)},
+    {Py_tp_clear, reinterpret_cast<void*>(array_clear)},
+    {Py_tp_getset, g_array_getset},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(array_getbuffer)},
+    {Py_mp_length, reinterpret_cast<void*>(array_length)},
+    {Py_tp_doc, const_cast<char*>("View of a buffer owned by a battlemon object (buffer protocol)")},
+    {0, nullptr},
+};
+
+PyType_Spec g_array_spec = {"battlemon.Array", sizeof(ArrayObject), 0,
+                            Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, g_array_slots};
+
+// ============================================================================
+//                            ACTION BUFFERS
+// ============================================================================
+
+/// Read element i of an integer buffer of struct format `format`
+bool read_integer(const Py_buffer& view, Py_ssize_t i, long long& value) {
+    const char* format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=' || *format == '<')
+        ++format;
+    const char* at = static_cast<const char*>(view.buf) + i * view.itemsize;
+    switch (*format) {
+#define BATTLEMON_READ(code, type)                 \
+    case code: {                                   \
+        type element;                              \
+        std::memcpy(&element, at, sizeof(type));   \
+        value = static_cast<long long>(element);   \
+        return view.itemsize == sizeof(type);      \
+    }
+        BATTLEMON_READ('b', signed char)
+        BATTLEMON_READ('B', unsigned char)
+        BATTLEMON_READ('h', short)
+        BATTLEMON_READ('H', unsigned short)
+        BATTLEMON_READ('i', int)
+        BATTLEMON_READ('I', unsigned int)
+        BATTLEMON_READ('l', long)
+        BATTLEMON_READ('L', unsigned long)
+        BATTLEMON_READ('q', long long)
+        BATTLEMON_READ('Q', unsigned long long)
+#undef BATTLEMON_READ
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Copy `count` move slots out of any 1-D integer buffer.
+ *
+ * @return false with a Python exception set on a bad buffer or value
+ */
+bool read_actions(PyObject* object, size_t count, std::vector<uint8_t>& out) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(object, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+        return false;
+
+    bool ok = view.itemsize > 0 && static_cast<size_t>(view.len / view.itemsize) == count;
+    if (!ok)
+        PyErr_Format(PyExc_ValueError, "expected %zu actions", count);
+
+    out.resize(count);
+    for (size_t i = 0; ok && i < count; ++i) {
+        long long value = 0;
+        if (!read_integer(view, static_cast<Py_ssize_t>(i), value)) {
+            PyErr_SetString(PyExc_TypeError, "actions must be an integer buffer");
+            ok = false;
+        } else if (value < 0 || value > 3) {
+            PyErr_Format(PyExc_ValueError, "action %zu is %lld (move slots are 0-3)", i, value);
+            ok = false;
+        } else {
+            out[i] = static_cast<uint8_t>(value);
+        }
+    }
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+/// Move `slot` if it is legal for `side`, else its lowest legal move (slot 0 to Struggle)
+BattleAction legal_or_fallback(const BattleEngine& battle, uint8_t side, uint8_t slot) {
+    const engine::ActionMask moves = battle.legal_actions(side) & engine::ACTION_MOVES;
+    if (moves & (1u << slot))
+        return BattleAction::move(slot);
+    for (uint8_t bit = 0; bit < 4; ++bit) {
+        if (moves & (1u << bit))
+            return BattleAction::move(bit);
+    }
+    return BattleAction::move(0);
+}
+
+int result_code(BattleResult result) {
+    return result == BattleResult::ONGOING ? -1 : static_cast<int>(result);
+}
+
+bool check_side(int side) {
+    if (side == 0 || side == 1)
+        return true;
+    PyErr_SetString(PyExc_ValueError, "side must be 0 or 1");
+    return false;
+}
+
+// ============================================================================
+//                                 BATTLE
+// ============================================================================
+
+// The engine lives on the C++ heap: BattleState is cache-line aligned,
+// which Python's object allocator does not guarantee
+struct BattleObject {
+    PyObject_HEAD
+    BattleEngine* battle;
+};
+
+PyObject* battle_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"p1", "p2", "level", "seed", nullptr};
+    unsigned int p1 = 0;
+    unsigned int p2 = 0;
+    unsigned int level = 50;
+    unsigned long long seed = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "II|IK", keywords(kwlist), &p1, &p2, &level,
+                                     &seed))
+        return nullptr;
+    if (p1 >= logic::setup::RENTAL_COUNT || p2 >= logic::setup::RENTAL_COUNT) {
+        PyErr_Format(PyExc_ValueError, "rental index out of range (0-%u)",
+                     logic::setup::RENTAL_COUNT - 1u);
+        return nullptr;
+    }
+    if (level < 1 || level > 100) {
+        PyErr_SetString(PyExc_ValueError, "level must be 1-100");
+        return nullptr;
+    }
+
+    auto* self = reinterpret_cast<BattleObject*>(type->tp_alloc(type, 0));
+    if (self == nullptr)
+        return nullptr;
+    self->battle = new (std::nothrow) BattleEngine();
+    if (self->battle == nullptr) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    // Seeded like a batch job (engine/batch.cpp): the battle runs on split(0)
+    util::random::Rng root{};
+    root.seed(seed, seed);
+    self->battle->init(static_cast<uint16_t>(p1), static_cast<uint16_t>(p2),
+                      static_cast<uint8_t>(level), root.split(0));
+    return reinterpret_cast<PyObject*>(self);
+}
+
+void battle_dealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    delete reinterpret_cast<BattleObject*>(self)->battle;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+BattleEngine& battle_of(PyObject* self) {
+    return *reinterpret_cast<BattleObject*>(self)->battle;
+}
+
+PyObject* battle_step(PyObject* self, PyObject* args) {
+    int p1_move = 0;
+    int p2_move = 0;
+    if (!PyArg_ParseTuple(args, "ii", &p1_move, &p2_move))
+        return nullptr;
+    if (p1_move < 0 || p1_move > 3 || p2_move < 0 || p2_move > 3) {
+        PyErr_SetString(PyExc_ValueError, "move slots are 0-3");
+        return nullptr;
+    }
+    auto& battle = battle_of(self);
+    if (battle.result() != BattleResult::ONGOING) {
+        PyErr_SetString(PyExc_RuntimeError, "battle is over");
+        return nullptr;
+    }
+    battle.execute_turn(BattleAction::move(static_cast<uint8_t>(p1_move)),
+                        BattleAction::move(static_cast<uint8_t>(p2_move)));
+    return PyLong_FromLong(result_code(battle.result()));
+}
+
+PyObject* battle_legal_actions(PyObject* self, PyObject* args) {
+    int side = 0;
+    if (!PyArg_ParseTuple(args, "i", &side) || !check_side(side))
+        return nullptr;
+    return PyLong_FromLong(battle_of(self).legal_actions(static_cast<uint8_t>(side)));
+}
+
+PyObject* battle_hp(PyObject* self, PyObject* args) {
+    int side = 0;
+    if (!PyArg_ParseTuple(args, "i", &side) || !check_side(side))
+        return nullptr;
+    const auto& battle = battle_of(self);
+    const auto& mon = side == 0 ? battle.p1_mon() : battle.p2_mon();
+    return Py_BuildValue("(ii)", mon.current_hp, mon.max_hp);
+}
+
+/// observe(side, out=None): into a writable float32 / int8 buffer, or a new float32 one
+PyObject* battle_observe(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"side", "out", nullptr};
+    int side = 0;
+    PyObject* out = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|O", keywords(kwlist), &side, &out) ||
+        !check_side(side))
+        return nullptr;
+    const auto& battle = battle_of(self);
+
+    if (out == Py_None) {
+        PyObject* bytes = PyByteArray_FromStringAndSize(nullptr, engine::OBSERVATION_SIZE * 4);
+        if (bytes == nullptr)
+            return nullptr;
+        float features[engine::OBSERVATION_SIZE];
+        engine::encode_observation(battle, static_cast<uint8_t>(side), features);
+        std::memcpy(PyByteArray_AsString(bytes), features, sizeof(features));
+        PyObject* view = PyMemoryView_FromObject(bytes);
+        Py_DECREF(bytes);
+        if (view == nullptr)
+            return nullptr;
+        PyObject* cast = PyObject_CallMethod(view, "cast", "s", "f");
+        Py_DECREF(view);
+        return cast;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+        return nullptr;
+    const char* format = view.format ? view.format : "B";
+    const size_t count = static_cast<size_t>(view.len / view.itemsize);
+    bool ok = count >= engine::OBSERVATION_SIZE;
+    if (!ok) {
+        PyErr_Format(PyExc_ValueError, "out holds %zu features, needs %zu", count,
+                     engine::OBSERVATION_SIZE);
+    } else if (std::strcmp(format, "f") == 0 && view.itemsize == 4) {
+        engine::encode_observation(battle, static_cast<uint8_t>(side),
+                                   static_cast<float*>(view.buf));
+    } else if (std::strcmp(format, "b") == 0) {
+        engine::encode_observation(battle, static_cast<uint8_t>(side),
+                                   static_cast<int8_t*>(view.buf));
+    } else {
+        PyErr_SetString(PyExc_TypeError, "out must be a float32 or int8 buffer");
+        ok = false;
+    }
+    PyBuffer_Release(&view);
+    if (!ok)
+        return nullptr;
+    return Py_NewRef(out);
+}
+
+PyObject* battle_hash(PyObject* self, PyObject*) {
+    return PyLong_FromUnsignedLongLong(battle_of(self).hash());
+}
+
+PyObject* battle_save(PyObject* self, PyObject*) {
+    const BattleEngine::Snapshot snapshot = battle_of(self).save();
+    return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+}
+
+PyObject* battle_restore(PyObject* self, PyObject* arg) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_SIMPLE) != 0)
+        return nullptr;
+    if (static_cast<size_t>(view.len) != sizeof(BattleEngine::Snapshot)) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_ValueError, "not a snapshot of this build");
+        return nullptr;
+    }
+    BattleEngine::Snapshot snapshot;
+    std::memcpy(&snapshot, view.buf, sizeof(snapshot));
+    PyBuffer_Release(&view);
+    battle_of(self).restore(snapshot);
+    Py_RETURN_NONE;
+}
+
+PyObject* battle_result(PyObject* self, void*) {
+    return PyLong_FromLong(result_code(battle_of(self).result()));
+}
+
+PyObject* battle_rentals(PyObject* self, void*) {
+    const auto& battle = battle_of(self);
+    return Py_BuildValue("(ii)", battle.rental_index(0), battle.rental_index(1));
+}
+
+PyMethodDef g_battle_methods[] = {
+    {"step", battle_step, METH_VARARGS,
+     "step(p1_move, p2_move) -> result: play one turn (move slots 0-3)"},
+    {"legal_actions", battle_legal_actions, METH_VARARGS,
+     "legal_actions(side) -> mask: bits 0-3 are the legal move slots"},
+    {"hp", battle_hp, METH_VARARGS, "hp(side) -> (current, max)"},
+    {"observe", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(battle_observe)),
+     METH_VARARGS | METH_KEYWORDS,
+     "observe(side, out=None): OBSERVATION_SIZE features into out (float32 or int8), "
+     "or a new float32 memoryview"},
+    {"hash", battle_hash, METH_NOARGS, "hash() -> 64-bit state hash"},
+    {"save", battle_save, METH_NOARGS, "save() -> bytes: snapshot of the full state"},
+    {"restore", battle_restore, METH_O, "restore(snapshot): return to a save()d state"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyGetSetDef g_battle_getset[] = {
+    {"result", battle_result, nullptr, "-1 while ongoing, else the winning side", nullptr},
+    {"rentals", battle_rentals, nullptr, "(p1, p2) rental indices", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+PyType_Slot g_battle_slots[] = {
+    {Py_tp_new, reinterpret_cast<void*>(battle_new)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(battle_dealloc)},
+    {Py_tp_methods, g_battle_methods},
+    {Py_tp_getset, g_battle_getset},
+    {Py_tp_doc, const_cast<char*>("Battle(p1, p2, level=50, seed=0): one rental battle")},
+    {0, nullptr},
+};
+
+PyType_Spec g_battle_spec = {"battlemon.Battle", sizeof(BattleObject), 0, Py_TPFLAGS_DEFAULT,
+                             g_battle_slots};
+
+// ============================================================================
+//                        VECTORIZED ENVIRONMENT
+// ============================================================================
+//
+// N battles of the agent (side 0) against a built-in opponent policy. A step
+// plays one turn in every battle; a battle that ends is rewarded (+1 win,
+// -1 loss, 0 at the turn cap), flagged done and replaced by the next
+// episode, whose first observation is the one returned.
+//
+// Episode e of battle i is seeded from (seed, i, e) alone: a run replays
+// from its seed however the battles are stepped. Rentals are drawn from the
+// episode stream, the battle runs on split(0) and the opponent on split(1),
+// as batch jobs do.
+//
+// ============================================================================
+
+struct EnvSlot {
+    BattleEngine battle;
+    util::random::Rng opponent_rng;
+    uint32_t episode{0};
+    uint16_t turns{0};
+};
+
+struct VecEnvObject {
+    PyObject_HEAD
+    size_t count;
+    uint64_t seed;
+    uint8_t level;
+    uint16_t max_turns;
+    engine::Policy opponent;
+
+    std::vector<EnvSlot>* slots;
+    std::vector<float>* observations;  // count * OBSERVATION_SIZE
+    std::vector<float>* rewards;
+    std::vector<uint8_t>* dones;
+    std::vector<uint16_t>* legal;      // Agent's ActionMask per battle
+    std::vector<uint8_t>* actions;     // step() input, decoded
+
+    PyObject* observations_array;
+    PyObject* rewards_array;
+    PyObject* dones_array;
+    PyObject* legal_array;
+};
+
+/// Start episode slot.episode of battle `index`
+void start_episode(const VecEnvObject& env, size_t index, EnvSlot& slot) {
+    const uint64_t episode_seed = util::random::mix64(
+        util::random::mix64(env.seed ^ util::random::mix64(index)) + slot.episode);
+    util::random::Rng root{};
+    root.seed(episode_seed, episode_seed);
+
+    util::random::Rng draft = root.split(2);
+    const auto p1 = static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT));
+    const auto p2 = static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT));
+    slot.battle.init(p1, p2, env.level, root.split(0));
+    slot.opponent_rng = root.split(1);
+    slot.turns = 0;
+}
+
+void observe_slot(VecEnvObject& env, size_t index) {
+    const auto& battle = (*env.slots)[index].battle;
+    engine::encode_observation(battle, 0, env.observations->data() + index * engine::OBSERVATION_SIZE);
+    (*env.legal)[index] = battle.legal_actions(0);
+}
+
+/// Advance battle `index` by one turn with the agent's move `slot_choice`
+void step_slot(VecEnvObject& env, size_t index, uint8_t slot_choice) {
+    EnvSlot& slot = (*env.slots)[index];
+    auto& battle = slot.battle;
+
+    const BattleAction agent = legal_or_fallback(battle, 0, slot_choice);
+    const BattleAction opponent = env.opponent(battle, 1, slot.opponent_rng);
+    battle.execute_turn(agent, opponent);
+    ++slot.turns;
+
+    float reward = 0.0f;
+    bool done = true;
+    switch (battle.result()) {
+        case BattleResult::P1_WINS:
+            reward = 1.0f;
+            break;
+        case BattleResult::P2_WINS:
+            reward = -1.0f;
+            break;
+        default:
+            done = slot.turns >= env.max_turns;
+            break;
+    }
+    (*env.rewards)[index] = reward;
+    (*env.dones)[index] = done ? 1 : 0;
+    if (done) {
+        ++slot.episode;
+        start_episode(env, index, slot);
+    }
+    observe_slot(env, index);
+}
+
+bool parse_opponent(const char* name, engine::Policy& policy) {
+    if (std::strcmp(name, "random") == 0) {
+        policy = engine::random_move_policy;
+    } else if (std::strcmp(name, "greedy") == 0) {
+        policy = engine::greedy_damage_policy;
+    } else if (std::strcmp(name, "search") == 0) {
+        policy = engine::ai::search_policy;
+    } else {
+        PyErr_SetString(PyExc_ValueError, "opponent must be 'random', 'greedy' or 'search'");
+        return false;
+    }
+    return true;
+}
+
+void reset_all(VecEnvObject& env);
+int vecenv_clear(PyObject* self);
+
+PyObject* vecenv_new(PyTypeObject* type, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"num_envs", "seed", "level", "max_turns", "opponent", nullptr};
+    Py_ssize_t count = 0;
+    unsigned long long seed = 0;
+    unsigned int level = 50;
+    unsigned int max_turns = engine::DEFAULT_MAX_TURNS;
+    const char* opponent_name = "random";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|KIIs", keywords(kwlist), &count, &seed,
+                                     &level, &max_turns, &opponent_name))
+        return nullptr;
+    engine::Policy opponent = nullptr;
+    if (!parse_opponent(opponent_name, opponent))
+        return nullptr;
+    if (count < 1) {
+        PyErr_SetString(PyExc_ValueError, "num_envs must be at least 1");
+        return nullptr;
+    }
+    if (level < 1 || level > 100 || max_turns < 1 || max_turns > 0xFFFF) {
+        PyErr_SetString(PyExc_ValueError, "level must be 1-100 and max_turns 1-65535");
+        return nullptr;
+    }
+
+    auto* self = reinterpret_cast<VecEnvObject*>(type->tp_alloc(type, 0));
+    if (self == nullptr)
+        return nullptr;
+    self->count = static_cast<size_t>(count);
+    self->seed = seed;
+    self->level = static_cast<uint8_t>(level);
+    self->max_turns = static_cast<uint16_t>(max_turns);
+    self->opponent = opponent;
+
+    try {
+        self->slots = new std::vector<EnvSlot>(self->count);
+        self->observations = new std::vector<float>(self->count * engine::OBSERVATION_SIZE);
+        self->rewards = new std::vector<float>(self->count);
+        self->dones = new std::vector<uint8_t>(self->count);
+        self->legal = new std::vector<uint16_t>(self->count);
+        self->actions = new std::vector<uint8_t>(self->count);
+    } catch (const std::bad_alloc&) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    auto* owner = reinterpret_cast<PyObject*>(self);
+    self->observations_array =
+        make_array(owner, self->observations->data(), 'f', sizeof(float), count,
+                   static_cast<Py_ssize_t>(engine::OBSERVATION_SIZE));
+    self->rewards_array = make_array(owner, self->rewards->data(), 'f', sizeof(float), count);
+    self->dones_array = make_array(owner, self->dones->data(), 'B', sizeof(uint8_t), count);
+    self->legal_array = make_array(owner, self->legal->data(), 'H', sizeof(uint16_t), count);
+    if (!self->observations_array || !self->rewards_array || !self->dones_array ||
+        !self->legal_array) {
+        vecenv_clear(owner);  // The views made so far hold `self`
+        Py_DECREF(self);
+        return nullptr;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    reset_all(*self);
+    Py_END_ALLOW_THREADS
+    return owner;
+}
+
+// The environment and its result arrays reference each other: a cycle the
+// collector breaks through either side's tp_clear
+int vecenv_traverse(PyObject* self, visitproc visit, void* arg) {
+    auto* env = reinterpret_cast<VecEnvObject*>(self);
+    Py_VISIT(env->observations_array);
+    Py_VISIT(env->rewards_array);
+    Py_VISIT(env->dones_array);
+    Py_VISIT(env->legal_array);
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+int vecenv_clear(PyObject* self) {
+    auto* env = reinterpret_cast<VecEnvObject*>(self);
+    Py_CLEAR(env->observations_array);
+    Py_CLEAR(env->rewards_array);
+    Py_CLEAR(env->dones_array);
+    Py_CLEAR(env->legal_array);
+    return 0;
+}
+
+void vecenv_dealloc(PyObject* self) {
+    auto* env = reinterpret_cast<VecEnvObject*>(self);
+    PyTypeObject* type = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    vecenv_clear(self);
+    delete env->slots;
+    delete env->observations;
+    delete env->rewards;
+    delete env->dones;
+    delete env->legal;
+    delete env->actions;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/// Every battle back to episode 0 (call without the GIL)
+void reset_all(VecEnvObject& env) {
+    for (size_t i = 0; i < env.count; ++i) {
+        EnvSlot& slot = (*env.slots)[i];
+        slot.episode = 0;
+        start_episode(env, i, slot);
+        observe_slot(env, i);
+        (*env.rewards)[i] = 0.0f;
+        (*env.dones)[i] = 0;
+    }
+}
+
+PyObject* vecenv_reset(PyObject* self, PyObject*) {
+    auto& env = *reinterpret_cast<VecEnvObject*>(self);
+    Py_BEGIN_ALLOW_THREADS
+    reset_all(env);
+    Py_END_ALLOW_THREADS
+    return Py_NewRef(env.observations_array);
+}
+
+PyObject* vecenv_step(PyObject* self, PyObject* actions) {
+    auto& env = *reinterpret_cast<VecEnvObject*>(self);
+    if (!read_actions(actions, env.count, *env.actions))
+        return nullptr;
+    Py_BEGIN_ALLOW_THREADS
+    for (size_t i = 0; i < env.count; ++i) {
+        step_slot(env, i, (*env.actions)[i]);
+    }
+    Py_END_ALLOW_THREADS
+    return PyTuple_Pack(3, env.observations_array, env.rewards_array, env.dones_array);
+}
+
+PyObject* vecenv_battle_hash(PyObject* self, PyObject* arg) {
+    auto& env = *reinterpret_cast<VecEnvObject*>(self);
+    const Py_ssize_t index = PyLong_AsSsize_t(arg);
+    if (index == -1 && PyErr_Occurred())
+        return nullptr;
+    if (index < 0 || static_cast<size_t>(index) >= env.count) {
+        PyErr_SetString(PyExc_IndexError, "battle index out of range");
+        return nullptr;
+    }
+    return PyLong_FromUnsignedLongLong((*env.slots)[static_cast<size_t>(index)].battle.hash());
+}
+
+PyObject* vecenv_observations(PyObject* self, void*) {
+    return Py_NewRef(reinterpret_cast<VecEnvObject*>(self)->observations_array);
+}
+
+PyObject* vecenv_rewards(PyObject* self, void*) {
+    return Py_NewRef(reinterpret_cast<VecEnvObject*>(self)->rewards_array);
+}
+
+PyObject* vecenv_dones(PyObject* self, void*) {
+    return Py_NewRef(reinterpret_cast<VecEnvObject*>(self)->dones_array);
+}
+
+PyObject* vecenv_legal_actions(PyObject* self, void*) {
+    return Py_NewRef(reinterpret_cast<VecEnvObject*>(self)->legal_array);
+}
+
+PyObject* vecenv_num_envs(PyObject* self, void*) {
+    return PyLong_FromSize_t(reinterpret_cast<VecEnvObject*>(self)->count);
+}
+
+PyMethodDef g_vecenv_methods[] = {
+    {"reset", vecenv_reset, METH_NOARGS,
+     "reset() -> observations: restart every battle at episode 0"},
+    {"step", vecenv_step, METH_O,
+     "step(actions) -> (observations, rewards, dones): one turn in every battle. actions "
+     "is a buffer of num_envs move slots; an illegal slot plays the lowest legal move"},
+    {"battle_hash", vecenv_battle_hash, METH_O, "battle_hash(i) -> state hash of battle i"},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyGetSetDef g_vecenv_getset[] = {
+    {"observations", vecenv_observations, nullptr, "(num_envs, OBSERVATION_SIZE) float32",
+     nullptr},
+    {"rewards", vecenv_rewards, nullptr, "(num_envs,) float32 of the last step", nullptr},
+    {"dones", vecenv_dones, nullptr, "(num_envs,) uint8 of the last step", nullptr},
+    {"legal_actions", vecenv_legal_actions, nullptr,
+     "(num_envs,) uint16: the agent's legal move mask in each battle", nullptr},
+    {"num_envs", vecenv_num_envs, nullptr, "Number of battles", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+PyType_Slot g_vecenv_slots[] = {
+    {Py_tp_new, reinterpret_cast<void*>(vecenv_new)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(vecenv_dealloc)},
+    {Py_tp_traverse, reinterpret_cast<void*>(vecenv_traverse)},
+    {Py_tp_clear, reinterpret_cast<void*>(vecenv_clear)},
+    {Py_tp_methods, g_vecenv_methods},
+    {Py_tp_getset, g_vecenv_getset},
+    {Py_tp_doc, const_cast<char*>("VecEnv(num_envs, seed=0, level=50, max_turns=500, "
+                                  "opponent='random'): battles stepped in lockstep")},
+    {0, nullptr},
+};
+
+PyType_Spec g_vecenv_spec = {"battlemon.VecEnv", sizeof(VecEnvObject), 0,
+                             Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, g_vecenv_slots};
+
+// ============================================================================
+//                                 MODULE
+// ============================================================================
+
+bool add_type(PyObject* module, PyType_Spec& spec, PyTypeObject** out = nullptr) {
+    PyObject* type = PyType_FromSpec(&spec);
+    if (type == nullptr)
+        return false;
+    if (out != nullptr)
+        *out = reinterpret_cast<PyTypeObject*>(Py_NewRef(type));
+    const char* name = std::strchr(spec.name, '.') + 1;
+    if (PyModule_AddObject(module, name, type) != 0) {
+        Py_DECREF(type);
+        return false;
+    }
+    return true;
+}
+
+PyModuleDef g_module = {
+    PyModuleDef_HEAD_INIT, "battlemon", "Gen III battle engine: battles and a vectorized environment",
+    -1, nullptr, nullptr, nullptr, nullptr, nullptr,
+};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit_battlemon() {
+    PyObject* module = PyModule_Create(&g_module);
+    if (module == nullptr)
+        return nullptr;
+    if (!add_type(module, g_array_spec, &g_array_type) || !add_type(module, g_battle_spec) ||
+        !add_type(module, g_vecenv_spec) ||
+        PyModule_AddIntConstant(module, "OBSERVATION_SIZE", engine::OBSERVATION_SIZE) != 0 ||
+        PyModule_AddIntConstant(module, "RENTAL_COUNT", logic::setup::RENTAL_COUNT) != 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file fingerprint.hpp
+ * @brief Compile-time fingerprint of the authoring tables.
+ *
+ * Tables cached in AppVars (util/table_cache.hpp) are derived from the
+ * species, move and rental data. Their fingerprints fold in this one, so a
+ * build with edited data rejects caches written by an older build and
+ * rebuilds them.
+ */
+
+#include <cstdint>
+
+#include "move.hpp"
+#include "rental.hpp"
+#include "species.hpp"
+#include "util/table_cache.hpp"
+
+namespace data {
+
+namespace fingerprint_detail {
+
+using util::cache::fingerprint_mix;
+
+constexpr uint32_t species_fingerprint(uint32_t fingerprint) {
+    for (const types::Species& species : g_SPECIES_TABLE) {
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(species.id));
+        for (uint8_t stat : species.stats)
+            fingerprint = fingerprint_mix(fingerprint, stat);
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(species.type1));
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(species.type2));
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(species.ability1));
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(species.ability2));
+    }
+    return fingerprint;
+}
+
+constexpr uint32_t move_fingerprint(uint32_t fingerprint) {
+    for (const types::Move& move : g_MOVE_TABLE) {
+        const uint32_t fields[] = {
+            static_cast<uint32_t>(move.id),     static_cast<uint32_t>(move.type),
+            move.power,                         move.accuracy,
+            move.pp,                            static_cast<uint8_t>(move.priority),
+            static_cast<uint32_t>(move.effect), move.effect_chance,
+            static_cast<uint32_t>(move.target), move.flags.bits};
+        for (uint32_t field : fields)
+            fingerprint = fingerprint_mix(fingerprint, field);
+    }
+    return fingerprint;
+}
+
+constexpr uint32_t rental_fingerprint(uint32_t fingerprint) {
+    for (const types::Rental& rental : g_RENTAL_SETS) {
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(rental.species));
+        for (types::enums::Move move : rental.moves)
+            fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(move));
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(rental.held_item));
+        fingerprint = fingerprint_mix(fingerprint, static_cast<uint32_t>(rental.nature));
+        fingerprint = fingerprint_mix(fingerprint, rental.ev_spread.bits);
+        fingerprint = fingerprint_mix(fingerprint, rental.ability_slot);
+    }
+    return fingerprint;
+}
+
+}  // namespace fingerprint_detail
+
+/// Every field of g_SPECIES_TABLE, g_MOVE_TABLE and g_RENTAL_SETS
+inline constexpr uint32_t DATA_FINGERPRINT =
+    fingerprint_detail::rental_fingerprint(fingerprint_detail::move_fingerprint(
+        fingerprint_detail::species_fingerprint(util::cache::FINGERPRINT_BASIS)));
+
+}  // namespace data
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
 #include "types/models/move.hpp"
 
 namespace data {
@@ -379,4 +383,42 @@ constexpr types::Move g_MOVE_TABLE[] = {
     // clang-format on
 };
 
+// ============================================================================
+//                          HOT / COLD MOVE TABLES
+// ============================================================================
+//
+// g_MOVE_TABLE is the authoring table; the engine reads the derived tables.
+// Every row's id must equal its index: lookups index by enums::Move.
+//
+// ============================================================================
+
+inline constexpr size_t MOVE_COUNT = std::size(g_MOVE_TABLE);
+
+constexpr bool move_table_is_dense() {
+    for (size_t i = 0; i < MOVE_COUNT; ++i) {
+        if (static_cast<size_t>(g_MOVE_TABLE[i].id) != i)
+            return false;
+    }
+    return true;
+}
+
+static_assert(move_table_is_dense(),
+              "g_MOVE_TABLE must list every move once, in enums::Move order");
+static_assert(static_cast<size_t>(Move::WHIRLWIND) + 1 == MOVE_COUNT,
+              "g_MOVE_TABLE must cover every enums::Move value");
+
+template <typename Indices>
+struct MoveTables;
+
+template <size_t... Is>
+struct MoveTables<std::index_sequence<Is...>> {
+    static constexpr types::MoveHot hot[] = {types::hot_row(g_MOVE_TABLE[Is])...};
+    static constexpr types::MoveCold cold[] = {types::cold_row(g_MOVE_TABLE[Is])...};
+};
+
+inline constexpr const types::MoveHot (&g_MOVE_HOT)[MOVE_COUNT] =
+    MoveTables<std::make_index_sequence<MOVE_COUNT>>::hot;
+inline constexpr const types::MoveCold (&g_MOVE_COLD)[MOVE_COUNT] =
+    MoveTables<std::make_index_sequence<MOVE_COUNT>>::cold;
+
 }  // namespace data
\ No newline at end of file
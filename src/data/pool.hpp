@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file pool.hpp
+ * @brief Items and move effects the rental pool carries.
+ *
+ * A Factory battle fields only rental sets, so an item no set holds and an
+ * effect no set's move runs can never come up in one. A build without
+ * BATTLEMON_FEATURE_OFF_POOL (util/features.hpp) drops their handlers and
+ * routines: the item dispatch switch and event masks (dsl/item/) and the
+ * effect dispatch table (engine/dispatch.hpp) all ask item_in_build() and
+ * effect_in_build(), so they agree on what is compiled in.
+ */
+
+#include <cstddef>
+
+#include "move.hpp"
+#include "rental.hpp"
+#include "types/enums/effect.hpp"
+#include "types/enums/item.hpp"
+#include "util/features.hpp"
+
+namespace data {
+
+inline constexpr size_t POOL_ITEM_KEYS = static_cast<size_t>(types::enums::Item::WHITE_HERB) + 1;
+inline constexpr size_t POOL_EFFECT_KEYS = static_cast<size_t>(types::enums::Effect::UPROAR) + 1;
+
+/// What g_RENTAL_SETS uses, by Item and by Effect
+struct PoolUsage {
+    bool items[POOL_ITEM_KEYS]{};
+    bool effects[POOL_EFFECT_KEYS]{};
+};
+
+namespace pool_detail {
+
+consteval PoolUsage scan_pool() {
+    PoolUsage usage{};
+    for (const types::Rental& rental : g_RENTAL_SETS) {
+        usage.items[static_cast<size_t>(rental.held_item)] = true;
+        for (const types::enums::Move move : rental.moves) {
+            if (move == types::enums::Move::NONE)
+                continue;
+            const types::enums::Effect effect = g_MOVE_TABLE[static_cast<size_t>(move)].effect;
+            usage.effects[static_cast<size_t>(effect)] = true;
+        }
+    }
+    return usage;
+}
+
+inline constexpr PoolUsage POOL_USAGE = scan_pool();
+
+}  // namespace pool_detail
+
+/// Some rental set holds `item`
+constexpr bool pool_holds(types::enums::Item item) {
+    const auto index = static_cast<size_t>(item);
+    return index < POOL_ITEM_KEYS && pool_detail::POOL_USAGE.items[index];
+}
+
+/// Some rental set has a move that runs `effect`
+constexpr bool pool_carries(types::enums::Effect effect) {
+    const auto index = static_cast<size_t>(effect);
+    return index < POOL_EFFECT_KEYS && pool_detail::POOL_USAGE.effects[index];
+}
+
+/// `item`'s handlers are compiled into this build
+constexpr bool item_in_build(types::enums::Item item) {
+    return BATTLEMON_FEATURE_OFF_POOL || pool_holds(item);
+}
+
+/// `effect`'s routine is compiled into this build
+constexpr bool effect_in_build(types::enums::Effect effect) {
+    return BATTLEMON_FEATURE_OFF_POOL || pool_carries(effect);
+}
+
+static_assert(pool_holds(types::enums::Item::LEFTOVERS) && !pool_holds(types::enums::Item::ORAN_B));
+static_assert(pool_carries(types::enums::Effect::HIT) &&
+              pool_carries(types::enums::Effect::MULTI_HIT));
+
+}  // namespace data
@@ -6,7 +6,9 @@ namespace data {
 
 using namespace types::enums;
 
-constexpr types::Rental g_RENTAL_SETS[] = {
+// Authoring table: runtime code decodes rows from g_RENTAL_PACKED through
+// data::rental() (rental_packed.hpp)
+inline constexpr types::Rental g_RENTAL_SETS[] = {
     // clang-format off
     {Species::ABRA, {Move::MIMIC, Move::METRONOME, Move::FLASH, Move::SEISMIC_TOSS}, Item::TWISTED_SPOON, Nature::LONELY, 0b00'1001, 0},
     {Species::AIPOM, {Move::FURY_SWIPES, Move::SAND_ATTACK, Move::BATON_PASS, Move::AGILITY}, Item::SILK_SCARF, Nature::RELAXED, 0b00'0011, 0},
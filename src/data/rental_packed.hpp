@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "rental.hpp"
+#include "types/enums/item.hpp"
+#include "types/enums/move.hpp"
+#include "types/enums/nature.hpp"
+#include "types/enums/species.hpp"
+#include "types/models/rental.hpp"
+#include "util/bitpack.hpp"
+
+namespace data {
+
+// ============================================================================
+//                         PACKED RENTAL RECORDS
+// ============================================================================
+//
+// g_RENTAL_SETS is the authoring table: readable rows, consumed at compile
+// time by the stat table and the inverted indexes. What ships for runtime
+// lookups is g_RENTAL_PACKED, the same rows bit-packed into 8 bytes instead
+// of sizeof(types::Rental) (14 on the eZ80), decoded one record at a time by
+// rental(index):
+//
+//   bits    field           width
+//   0-8     species         9
+//   9-44    moves[0..3]     4 x 9
+//   45-51   held_item       7
+//   52-56   nature          5
+//   57-62   ev_spread       6
+//   63      ability_slot    1
+//
+// Records are little-endian byte arrays. No field spans more than two bytes,
+// so decoding a field is a 16-bit load, shift and mask - no 64-bit shifts,
+// which are library calls on the eZ80. The table is generated from
+// g_RENTAL_SETS at compile time and checked to round-trip exactly.
+//
+// ============================================================================
+
+inline constexpr size_t RENTAL_SET_COUNT = std::size(g_RENTAL_SETS);
+
+struct PackedRental {
+    uint8_t bytes[8];
+};
+
+static_assert(sizeof(PackedRental) == 8, "packed rentals are 64-bit records");
+
+using PackedField = util::bitpack::Field;
+
+inline constexpr PackedField PACKED_SPECIES{0, 9};
+inline constexpr PackedField PACKED_MOVES[4]{{9, 9}, {18, 9}, {27, 9}, {36, 9}};
+inline constexpr PackedField PACKED_ITEM{45, 7};
+inline constexpr PackedField PACKED_NATURE{52, 5};
+inline constexpr PackedField PACKED_EV_SPREAD{57, 6};
+inline constexpr PackedField PACKED_ABILITY_SLOT{63, 1};
+
+/// Read one field (at most 9 bits, within two bytes)
+template <PackedField Field>
+constexpr unsigned packed_field(const PackedRental& packed) {
+    return util::bitpack::read<Field>(packed.bytes);
+}
+
+// ============================================================================
+//                             ENCODING
+// ============================================================================
+
+using util::bitpack::fits;
+
+/// Every field of `rental` is representable in its packed width
+constexpr bool packable(const types::Rental& rental) {
+    for (const types::enums::Move move : rental.moves) {
+        if (!fits(static_cast<unsigned>(move), PACKED_MOVES[0]))
+            return false;
+    }
+    return fits(static_cast<unsigned>(rental.species), PACKED_SPECIES) &&
+           fits(static_cast<unsigned>(rental.held_item), PACKED_ITEM) &&
+           fits(static_cast<unsigned>(rental.nature), PACKED_NATURE) &&
+           fits(rental.ev_spread.bits, PACKED_EV_SPREAD) &&
+           fits(rental.ability_slot, PACKED_ABILITY_SLOT);
+}
+
+constexpr PackedRental pack_rental(const types::Rental& rental) {
+    uint64_t bits = 0;
+    const auto put = [&bits](unsigned value, PackedField field) {
+        bits |= static_cast<uint64_t>(value) << field.offset;
+    };
+    put(static_cast<unsigned>(rental.species), PACKED_SPECIES);
+    for (size_t i = 0; i < 4; ++i) {
+        put(static_cast<unsigned>(rental.moves[i]), PACKED_MOVES[i]);
+    }
+    put(static_cast<unsigned>(rental.held_item), PACKED_ITEM);
+    put(static_cast<unsigned>(rental.nature), PACKED_NATURE);
+    put(rental.ev_spread.bits, PACKED_EV_SPREAD);
+    put(rental.ability_slot, PACKED_ABILITY_SLOT);
+
+    PackedRental packed{};
+    for (size_t b = 0; b < sizeof(packed.bytes); ++b) {
+        packed.bytes[b] = static_cast<uint8_t>(bits >> (8 * b));
+    }
+    return packed;
+}
+
+constexpr types::Rental unpack_rental(const PackedRental& packed) {
+    using types::enums::Move;
+    types::Rental rental{};
+    rental.species = static_cast<types::enums::Species>(packed_field<PACKED_SPECIES>(packed));
+    rental.moves[0] = static_cast<Move>(packed_field<PACKED_MOVES[0]>(packed));
+    rental.moves[1] = static_cast<Move>(packed_field<PACKED_MOVES[1]>(packed));
+    rental.moves[2] = static_cast<Move>(packed_field<PACKED_MOVES[2]>(packed));
+    rental.moves[3] = static_cast<Move>(packed_field<PACKED_MOVES[3]>(packed));
+    rental.held_item = static_cast<types::enums::Item>(packed_field<PACKED_ITEM>(packed));
+    rental.nature = static_cast<types::enums::Nature>(packed_field<PACKED_NATURE>(packed));
+    rental.ev_spread =
+        types::EvSpread{static_cast<uint8_t>(packed_field<PACKED_EV_SPREAD>(packed))};
+    rental.ability_slot = static_cast<uint8_t>(packed_field<PACKED_ABILITY_SLOT>(packed));
+    return rental;
+}
+
+struct PackedRentalTable {
+    PackedRental entries[RENTAL_SET_COUNT];
+};
+
+constexpr PackedRentalTable build_packed_rentals() {
+    PackedRentalTable table{};
+    for (size_t i = 0; i < RENTAL_SET_COUNT; ++i) {
+        table.entries[i] = pack_rental(g_RENTAL_SETS[i]);
+    }
+    return table;
+}
+
+inline constexpr PackedRentalTable g_RENTAL_PACKED_TABLE = build_packed_rentals();
+
+inline constexpr const PackedRental (&g_RENTAL_PACKED)[RENTAL_SET_COUNT] =
+    g_RENTAL_PACKED_TABLE.entries;
+
+// ============================================================================
+//                              VALIDATION
+// ============================================================================
+
+constexpr bool same_rental(const types::Rental& a, const types::Rental& b) {
+    for (size_t i = 0; i < 4; ++i) {
+        if (a.moves[i] != b.moves[i])
+            return false;
+    }
+    return a.species == b.species && a.held_item == b.held_item && a.nature == b.nature &&
+           a.ev_spread.bits == b.ev_spread.bits && a.ability_slot == b.ability_slot;
+}
+
+constexpr bool packed_rentals_round_trip() {
+    for (size_t i = 0; i < RENTAL_SET_COUNT; ++i) {
+        if (!packable(g_RENTAL_SETS[i]) ||
+            !same_rental(unpack_rental(g_RENTAL_PACKED[i]), g_RENTAL_SETS[i]))
+            return false;
+    }
+    return true;
+}
+
+static_assert(packed_rentals_round_trip(),
+              "a rental field outgrew its packed width (see PACKED_* layout)");
+
+// ============================================================================
+//                               ACCESS
+// ============================================================================
+
+/**
+ * @brief Decode the rental at `index` in g_RENTAL_SETS.
+ *
+ * Runtime code reads rentals through this rather than g_RENTAL_SETS, so
+ * only the packed table is linked into the calculator build.
+ *
+ * @pre index < RENTAL_SET_COUNT
+ */
+constexpr types::Rental rental(size_t index) { return unpack_rental(g_RENTAL_PACKED[index]); }
+
+}  // namespace data
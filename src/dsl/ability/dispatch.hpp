@@ -0,0 +1,189 @@
+#pragma once
+
+#include "../../logic/state/context.hpp"
+#include "event_mask.hpp"
+#include "handler.hpp"
+#include "util/profile.hpp"
+
+namespace dsl::ability {
+
+// ============================================================================
+//                        ABILITY EVENT DISPATCHER
+// ============================================================================
+//
+// Routes events to ability handlers via switch-based dispatch, as
+// dsl::item::dispatch() does for items. The switch covers every ability
+// with ANY handler specialization; `if constexpr` drops the cases without
+// one for the event.
+//
+// ============================================================================
+
+/// Run `AbilityId`'s handler for `Event`, if it has one
+template <types::enums::Ability AbilityId, typename Event>
+inline void run(Event& event) {
+    if constexpr (AbilityHandler<AbilityId, Event>::handles)
+        AbilityHandler<AbilityId, Event>::execute(event);
+}
+
+/// Dispatch an event to the appropriate ability handler
+template <typename Event>
+void dispatch(types::enums::Ability ability, Event& event) {
+    using enum types::enums::Ability;
+
+    BATTLEMON_PROFILE_SCOPE(util::profile::Section::ABILITY);
+
+    // clang-format off
+    switch (ability) {
+        // ==== Entry ====
+        case INTIMIDATE:   run<INTIMIDATE>(event);   break;
+        case DRIZZLE:      run<DRIZZLE>(event);      break;
+        case DROUGHT:      run<DROUGHT>(event);      break;
+        case SAND_STREAM:  run<SAND_STREAM>(event);  break;
+
+        // ==== Stat drop and status immunities ====
+        case CLEAR_BODY:   run<CLEAR_BODY>(event);   break;
+        case WHITE_SMOKE:  run<WHITE_SMOKE>(event);  break;
+        case HYPER_CUTTER: run<HYPER_CUTTER>(event); break;
+        case KEEN_EYE:     run<KEEN_EYE>(event);     break;
+        case LIMBER:       run<LIMBER>(event);       break;
+        case INSOMNIA:     run<INSOMNIA>(event);     break;
+        case VITAL_SPIRIT: run<VITAL_SPIRIT>(event); break;
+        case IMMUNITY:     run<IMMUNITY>(event);     break;
+        case WATER_VEIL:   run<WATER_VEIL>(event);   break;
+        case MAGMA_ARMOR:  run<MAGMA_ARMOR>(event);  break;
+
+        // ==== Attacking ====
+        case HUGE_POWER:   run<HUGE_POWER>(event);   break;
+        case PURE_POWER:   run<PURE_POWER>(event);   break;
+        case HUSTLE:       run<HUSTLE>(event);       break;
+        case GUTS:         run<GUTS>(event);         break;
+        case BLAZE:        run<BLAZE>(event);        break;
+        case OVERGROW:     run<OVERGROW>(event);     break;
+        case TORRENT:      run<TORRENT>(event);      break;
+        case SWARM:        run<SWARM>(event);        break;
+
+        // ==== Defending ====
+        case THICK_FAT:    run<THICK_FAT>(event);    break;
+        case MARVEL_SCALE: run<MARVEL_SCALE>(event); break;
+        case LEVITATE:     run<LEVITATE>(event);     break;
+        case FLASH_FIRE:   run<FLASH_FIRE>(event);   break;
+        case VOLT_ABSORB:  run<VOLT_ABSORB>(event);  break;
+        case WATER_ABSORB: run<WATER_ABSORB>(event); break;
+        case WONDER_GUARD: run<WONDER_GUARD>(event); break;
+
+        // ==== Contact ====
+        case STATIC:       run<STATIC>(event);       break;
+        case FLAME_BODY:   run<FLAME_BODY>(event);   break;
+        case POISON_POINT: run<POISON_POINT>(event); break;
+        case EFFECT_SPORE: run<EFFECT_SPORE>(event); break;
+        case ROUGH_SKIN:   run<ROUGH_SKIN>(event);   break;
+
+        // ==== Speed and turn end ====
+        case SWIFT_SWIM:   run<SWIFT_SWIM>(event);   break;
+        case CHLOROPHYLL:  run<CHLOROPHYLL>(event);  break;
+        case SPEED_BOOST:  run<SPEED_BOOST>(event);  break;
+        case RAIN_DISH:    run<RAIN_DISH>(event);    break;
+        case SHED_SKIN:    run<SHED_SKIN>(event);    break;
+
+        // ==== Passive in a Factory single battle, or not modelled ====
+        default:
+            break;
+    }
+    // clang-format on
+}
+
+// ============================================================================
+//                      CONVENIENCE FIRE FUNCTIONS
+// ============================================================================
+//
+// Each first tests the holder's ability event mask
+// (BattleState::ability_events()), so a battler whose ability has no handler
+// for the event costs one AND.
+//
+// ============================================================================
+
+/// True if `slot_id`'s ability responds to `Event`
+template <typename Event>
+inline bool responds(const BattleContext& ctx, uint8_t slot_id) {
+    return ctx.state->ability_events(slot_id) & EVENT_BIT<Event>;
+}
+
+/// Fire OnSwitchIn for ctx's attacker (entering battle)
+inline void fire_switch_in(BattleContext& ctx) {
+    if (!responds<OnSwitchIn>(ctx, ctx.attacker_slot_id))
+        return;
+
+    OnSwitchIn event{ctx};
+    dispatch(ctx.state->ability(ctx.attacker_slot_id), event);
+}
+
+/// True if `slot_id`'s ability prevents its foe lowering the given stat
+inline bool stat_drop_blocked(const BattleContext& ctx, uint8_t slot_id, bool attack,
+                              bool accuracy) {
+    if (!responds<OnStatDrop>(ctx, slot_id))
+        return false;
+
+    bool blocked = false;
+    OnStatDrop event{attack, accuracy, blocked};
+    dispatch(ctx.state->ability(slot_id), event);
+    if (blocked)
+        detail::announce(slot_id, ctx.state->ability(slot_id));
+    return blocked;
+}
+
+/// True if `slot_id`'s ability prevents `status`
+inline bool status_blocked(const BattleContext& ctx, uint8_t slot_id,
+                           logic::state::Status status) {
+    if (!responds<OnStatusAttempt>(ctx, slot_id))
+        return false;
+
+    bool blocked = false;
+    OnStatusAttempt event{status, blocked};
+    dispatch(ctx.state->ability(slot_id), event);
+    return blocked;
+}
+
+/// Fire OnPreDamageCalc for the attacker's ability, then OnPreDamageTaken for the defender's
+inline void fire_pre_damage_calc(BattleContext& ctx, logic::calc::DamageParams& params) {
+    if (responds<OnPreDamageCalc>(ctx, ctx.attacker_slot_id)) {
+        OnPreDamageCalc event{params, ctx};
+        dispatch(ctx.state->ability(ctx.attacker_slot_id), event);
+    }
+    if (responds<OnPreDamageTaken>(ctx, ctx.defender_slot_id)) {
+        OnPreDamageTaken event{params, ctx};
+        dispatch(ctx.state->ability(ctx.defender_slot_id), event);
+    }
+}
+
+/// Fire OnContact for the defender's ability (the attacker made contact)
+inline void fire_contact(BattleContext& ctx) {
+    if (!responds<OnContact>(ctx, ctx.defender_slot_id))
+        return;
+
+    OnContact event{ctx};
+    dispatch(ctx.state->ability(ctx.defender_slot_id), event);
+}
+
+/// `slot_id`'s effective speed for turn order, after its ability
+inline uint16_t fire_speed_calc(BattleContext& ctx, uint8_t slot_id, uint16_t speed) {
+    if (!responds<OnSpeedCalc>(ctx, slot_id))
+        return speed;
+
+    const uint8_t prev_slot = ctx.attacker_slot_id;
+    ctx.attacker_slot_id = slot_id;
+    OnSpeedCalc event{speed, ctx};
+    dispatch(ctx.state->ability(slot_id), event);
+    ctx.attacker_slot_id = prev_slot;
+    return speed;
+}
+
+/// Fire OnTurnEnd for ctx's attacker
+inline void fire_turn_end(BattleContext& ctx) {
+    if (!responds<OnTurnEnd>(ctx, ctx.attacker_slot_id))
+        return;
+
+    OnTurnEnd event{ctx};
+    dispatch(ctx.state->ability(ctx.attacker_slot_id), event);
+}
+
+}  // namespace dsl::ability
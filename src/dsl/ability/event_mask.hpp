@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "../../types/enums/ability.hpp"
+#include "events.hpp"
+#include "handler.hpp"
+
+namespace dsl::ability {
+
+// ============================================================================
+//                          ABILITY EVENT MASKS
+// ============================================================================
+//
+// One bit per event, set for each ability that has an AbilityHandler
+// specialization for it; built from the `handles` constants like the item
+// masks (dsl/item/event_mask.hpp).
+//
+// Abilities never change in a Factory battle, so the mask is resolved once
+// per battle (BattleState::ability_events). Most Factory mons' abilities
+// have no handler at all: for them every ability fire site is one AND.
+//
+// ============================================================================
+
+/// Bit of an event in an ability event mask
+template <typename Event>
+inline constexpr uint8_t EVENT_BIT = 0;
+
+template <>
+inline constexpr uint8_t EVENT_BIT<OnSwitchIn> = 1 << 0;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnStatDrop> = 1 << 1;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnStatusAttempt> = 1 << 2;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnPreDamageCalc> = 1 << 3;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnPreDamageTaken> = 1 << 4;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnContact> = 1 << 5;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnSpeedCalc> = 1 << 6;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnTurnEnd> = 1 << 7;
+
+/// Number of Ability values (one past the last)
+inline constexpr size_t ABILITY_COUNT = static_cast<size_t>(types::enums::Ability::SHADOW_TAG) + 1;
+
+namespace event_mask_detail {
+
+template <types::enums::Ability AbilityId, typename Event>
+inline constexpr uint8_t handled_bit =
+    AbilityHandler<AbilityId, Event>::handles ? EVENT_BIT<Event> : 0;
+
+template <size_t I>
+inline constexpr uint8_t ability_mask = [] {
+    constexpr auto ability = static_cast<types::enums::Ability>(I);
+    return static_cast<uint8_t>(
+        handled_bit<ability, OnSwitchIn> | handled_bit<ability, OnStatDrop> |
+        handled_bit<ability, OnStatusAttempt> | handled_bit<ability, OnPreDamageCalc> |
+        handled_bit<ability, OnPreDamageTaken> | handled_bit<ability, OnContact> |
+        handled_bit<ability, OnSpeedCalc> | handled_bit<ability, OnTurnEnd>);
+}();
+
+template <typename Indices>
+struct MaskTable;
+
+template <size_t... Is>
+struct MaskTable<std::index_sequence<Is...>> {
+    static constexpr uint8_t entries[] = {ability_mask<Is>...};
+};
+
+}  // namespace event_mask_detail
+
+/// Event mask of every ability, indexed by Ability
+inline constexpr const uint8_t (&g_ABILITY_EVENT_MASKS)[ABILITY_COUNT] =
+    event_mask_detail::MaskTable<std::make_index_sequence<ABILITY_COUNT>>::entries;
+
+/// Events `ability` responds to (0 for abilities without handlers)
+constexpr uint8_t ability_event_mask(types::enums::Ability ability) {
+    const auto index = static_cast<size_t>(ability);
+    return index < ABILITY_COUNT ? g_ABILITY_EVENT_MASKS[index] : 0;
+}
+
+static_assert(ability_event_mask(types::enums::Ability::NONE) == 0);
+static_assert(ability_event_mask(types::enums::Ability::PICKUP) == 0);
+static_assert(ability_event_mask(types::enums::Ability::LEVITATE) == EVENT_BIT<OnPreDamageTaken>);
+static_assert(ability_event_mask(types::enums::Ability::SPEED_BOOST) == EVENT_BIT<OnTurnEnd>);
+static_assert(ability_event_mask(types::enums::Ability::INTIMIDATE) == EVENT_BIT<OnSwitchIn>);
+
+}  // namespace dsl::ability
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../../logic/calc/damage.hpp"
+#include "../../logic/state/mon.hpp"
+
+// Forward declare to avoid circular dependency
+namespace dsl {
+struct BattleContext;
+}
+
+namespace dsl::ability {
+
+// ============================================================================
+//                           ABILITY EVENT TYPES
+// ============================================================================
+//
+// The ability counterpart of dsl::item's events: fired at the same stage
+// boundaries, with mutable references for what the ability may change.
+//
+// The holder is named per event. Turn-level events follow the item
+// convention (the holder is ctx's attacker slot); damage events fire for
+// the attacker's ability before damage calculation and for the defender's
+// when it is hit.
+//
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Battle Events
+// ----------------------------------------------------------------------------
+
+/// Fires: when the holder enters battle (battle start, faster battler first, or
+///        a switch-in)
+/// Use: Intimidate, Drizzle, Drought, Sand Stream
+/// The holder is ctx's attacker slot, its foe the defender.
+struct OnSwitchIn {
+    const BattleContext& ctx;
+};
+
+/// Fires: when a stage of the holder would be lowered by its foe
+/// Use: Clear Body, White Smoke (any stat), Hyper Cutter (Attack), Keen Eye (accuracy)
+struct OnStatDrop {
+    const bool attack;    // Attack is the stat being lowered
+    const bool accuracy;  // Accuracy is the stat being lowered
+    bool& blocked;        // Set true to prevent the drop
+};
+
+/// Fires: when a primary status would be inflicted on the holder
+/// Use: Limber, Insomnia, Vital Spirit, Immunity, Water Veil, Magma Armor
+struct OnStatusAttempt {
+    const logic::state::Status status;
+    bool& blocked;  // Set true to prevent the status
+};
+
+// ----------------------------------------------------------------------------
+// Move Pipeline Events
+// ----------------------------------------------------------------------------
+
+/// Fires: AccuracyResolved -> DamageCalculated, for the attacker's ability
+/// Modifies: Damage calculation inputs (after the attacker's item)
+/// Use: Huge Power, Pure Power, Hustle, Guts, Blaze / Overgrow / Torrent / Swarm
+struct OnPreDamageCalc {
+    logic::calc::DamageParams& params;
+
+    const BattleContext& ctx;
+};
+
+/// Fires: AccuracyResolved -> DamageCalculated, for the defender's ability
+/// Modifies: Damage calculation inputs; effectiveness 0 makes the hit miss out
+/// Use: Thick Fat, Marvel Scale, Levitate, Volt / Water Absorb, Flash Fire,
+///      Wonder Guard
+struct OnPreDamageTaken {
+    logic::calc::DamageParams& params;
+
+    const BattleContext& ctx;
+};
+
+/// Fires: DamageApplied -> EffectApplied, for the defender's ability, when a
+///        contact move dealt damage
+/// Reacts: On the attacker (ctx's attacker slot)
+/// Use: Static, Flame Body, Poison Point, Effect Spore, Rough Skin
+struct OnContact {
+    const BattleContext& ctx;
+};
+
+// ----------------------------------------------------------------------------
+// Turn Pipeline Events
+// ----------------------------------------------------------------------------
+
+/// Fires: TurnGenesis -> PriorityDetermined, on each battler's effective speed
+/// Modifies: The speed turn order compares (not the slot's speed cache)
+/// Use: Swift Swim, Chlorophyll
+/// The holder is ctx's attacker slot.
+struct OnSpeedCalc {
+    uint16_t& speed;
+
+    const BattleContext& ctx;
+};
+
+/// Fires: ActionsResolved -> TurnEnd, before the holder's item (Gen III order)
+/// Modifies: The holder's HP, status or stages directly
+/// Use: Speed Boost, Rain Dish, Shed Skin
+/// The holder is ctx's attacker slot.
+struct OnTurnEnd {
+    const BattleContext& ctx;
+};
+
+}  // namespace dsl::ability
@@ -0,0 +1,98 @@
+/**
+ * @file handler.cpp
+ * @brief Out-of-line ability handlers that fire other abilities' checks
+ */
+
+#include "handler.hpp"
+
+#include "dispatch.hpp"
+#include "../../logic/ops/status.hpp"
+
+namespace dsl::ability {
+
+namespace {
+
+/// Give `slot_id`'s mon `status` unless it has one, is immune by type or is
+/// protected by its own ability; `source`'s ability is announced first
+void inflict(const BattleContext& ctx, uint8_t slot_id, logic::state::Status status,
+             uint8_t source, types::enums::Ability ability) {
+    using logic::state::Status;
+
+    logic::state::MonState* mon = ctx.mon(slot_id);
+    const ActiveMon& active = ctx.state->active(slot_id);
+    if (mon->is_fainted() || mon->has_status())
+        return;
+    if (active.has_trait(logic::ops::status_immunity(status)))
+        return;
+    if (status_blocked(ctx, slot_id, status))
+        return;
+
+    detail::announce(source, ability);
+    logic::state::assign(mon->status, status);
+    if (status == Status::SLEEP)
+        logic::state::assign(mon->sleep_turns, logic::ops::draw_sleep_turns(*ctx.rng));
+    if (status == Status::PARALYSIS)
+        ctx.slot(slot_id)->mark_speed_dirty();
+    logic::state::events::emit(logic::state::EventType::STATUS, slot_id,
+                               static_cast<uint16_t>(status));
+}
+
+/// Static, Flame Body, Poison Point: 1/3 chance to afflict a contact attacker
+void contact_status(const OnContact& event, logic::state::Status status,
+                    types::enums::Ability ability) {
+    if (event.ctx.attacker_mon()->is_fainted() ||
+        !event.ctx.rng->chance(1, 3, util::random::DrawSite::ABILITY))
+        return;
+    inflict(event.ctx, event.ctx.attacker_slot_id, status, event.ctx.defender_slot_id, ability);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+// INTIMIDATE - Lower the foe's Attack one stage on entry
+// ----------------------------------------------------------------------------
+
+void AbilityHandler<types::enums::Ability::INTIMIDATE, OnSwitchIn>::execute(OnSwitchIn& event) {
+    const uint8_t foe = event.ctx.defender_slot_id;
+    logic::state::SlotState* slot = event.ctx.slot(foe);
+    if (event.ctx.mon(foe)->is_fainted() || slot->atk_stage <= -6)
+        return;
+
+    detail::announce(event.ctx.attacker_slot_id, types::enums::Ability::INTIMIDATE);
+    if (stat_drop_blocked(event.ctx, foe, true, false))
+        return;
+    logic::state::assign(slot->atk_stage, static_cast<int8_t>(slot->atk_stage - 1));
+}
+
+// ----------------------------------------------------------------------------
+// STATIC / FLAME BODY / POISON POINT / EFFECT SPORE
+// ----------------------------------------------------------------------------
+
+void AbilityHandler<types::enums::Ability::STATIC, OnContact>::execute(OnContact& event) {
+    contact_status(event, logic::state::Status::PARALYSIS, types::enums::Ability::STATIC);
+}
+
+void AbilityHandler<types::enums::Ability::FLAME_BODY, OnContact>::execute(OnContact& event) {
+    contact_status(event, logic::state::Status::BURN, types::enums::Ability::FLAME_BODY);
+}
+
+void AbilityHandler<types::enums::Ability::POISON_POINT, OnContact>::execute(OnContact& event) {
+    contact_status(event, logic::state::Status::POISON, types::enums::Ability::POISON_POINT);
+}
+
+void AbilityHandler<types::enums::Ability::EFFECT_SPORE, OnContact>::execute(OnContact& event) {
+    using logic::state::Status;
+
+    if (event.ctx.attacker_mon()->is_fainted() ||
+        !event.ctx.rng->chance(1, 10, util::random::DrawSite::ABILITY))
+        return;
+
+    // pokeemerald rerolls Random() & 3 until it is not 0: poison, paralysis
+    // or sleep with equal odds
+    constexpr Status spores[] = {Status::POISON, Status::PARALYSIS, Status::SLEEP};
+    const Status status = spores[event.ctx.rng->random(3, util::random::DrawSite::ABILITY)];
+    inflict(event.ctx, event.ctx.attacker_slot_id, status, event.ctx.defender_slot_id,
+            types::enums::Ability::EFFECT_SPORE);
+}
+
+}  // namespace dsl::ability
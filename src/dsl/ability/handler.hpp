@@ -0,0 +1,450 @@
+#pragma once
+
+#include "../../logic/calc/damage.hpp"
+#include "../../logic/state/context.hpp"
+#include "../../logic/state/event_queue.hpp"
+#include "../../types/enums/ability.hpp"
+#include "../../types/enums/type.hpp"
+#include "events.hpp"
+
+namespace dsl::ability {
+
+// ============================================================================
+//                        ABILITY HANDLER TEMPLATE
+// ============================================================================
+//
+// Static dispatch via template specialization, as for items
+// (dsl/item/handler.hpp):
+//
+//   1. Primary template does nothing (default behavior)
+//   2. Specializations implement ability-specific behavior
+//   3. Dispatcher calls the handler for the battler's ability via switch
+//
+// Abilities with no effect in a single Factory battle (Pickup, Run Away,
+// Illuminate, the trapping and doubles-only abilities) have no handlers.
+// Not modelled yet: Hustle's accuracy cost, the Flash Fire boost, crit and
+// flinch immunities, Serene Grace, Shield Dust, Rock Head, Sturdy,
+// Synchronize, Natural Cure, Trace, Truant, Cloud Nine / Air Lock.
+//
+// ============================================================================
+
+/// Primary template - default no-op handler
+template <types::enums::Ability AbilityId, typename Event>
+struct AbilityHandler {
+    /// Returns true if this ability responds to this event
+    static constexpr bool handles = false;
+
+    /// No-op execute (never called if handles=false)
+    static void execute(Event&) {}
+};
+
+namespace detail {
+
+inline logic::state::Weather weather(const BattleContext& ctx) {
+    return ctx.state->field.weather;
+}
+
+/// Tell the UI an ability did something visible
+inline void announce(uint8_t slot_id, types::enums::Ability ability) {
+    logic::state::events::emit(logic::state::EventType::ABILITY, slot_id,
+                               static_cast<uint16_t>(ability));
+}
+
+/// max_hp / divisor, at least 1
+constexpr uint16_t fraction(const logic::state::MonState& mon, uint16_t divisor) {
+    const uint16_t amount = mon.max_hp / divisor;
+    return amount == 0 ? 1 : amount;
+}
+
+constexpr uint8_t status_bit(logic::state::Status status) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(status));
+}
+
+}  // namespace detail
+
+// ============================================================================
+//                      HANDLER SPECIALIZATIONS
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// INTIMIDATE - Lower the foe's Attack one stage on entry
+// (handler.cpp: the drop can itself be blocked by the foe's ability)
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::INTIMIDATE, OnSwitchIn> {
+    static constexpr bool handles = true;
+
+    static void execute(OnSwitchIn& event);
+};
+
+// ----------------------------------------------------------------------------
+// DRIZZLE / DROUGHT / SAND STREAM - Permanent weather on entry
+// ----------------------------------------------------------------------------
+
+template <types::enums::Ability AbilityId, logic::state::Weather W>
+struct SetWeather {
+    static constexpr bool handles = true;
+
+    static void execute(OnSwitchIn& event) {
+        logic::state::FieldState& field = event.ctx.state->field;
+        if (field.weather == W && field.weather_expiry == 0)
+            return;
+        logic::state::assign(field.weather, W);
+        logic::state::assign(field.weather_expiry, uint8_t{0});
+        detail::announce(event.ctx.attacker_slot_id, AbilityId);
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::DRIZZLE, OnSwitchIn>
+    : SetWeather<types::enums::Ability::DRIZZLE, logic::state::Weather::RAIN> {};
+template <>
+struct AbilityHandler<types::enums::Ability::DROUGHT, OnSwitchIn>
+    : SetWeather<types::enums::Ability::DROUGHT, logic::state::Weather::SUN> {};
+template <>
+struct AbilityHandler<types::enums::Ability::SAND_STREAM, OnSwitchIn>
+    : SetWeather<types::enums::Ability::SAND_STREAM, logic::state::Weather::SANDSTORM> {};
+
+// ----------------------------------------------------------------------------
+// CLEAR BODY / WHITE SMOKE / HYPER CUTTER / KEEN EYE - Block stat drops
+// ----------------------------------------------------------------------------
+
+struct BlockAllDrops {
+    static constexpr bool handles = true;
+
+    static void execute(OnStatDrop& event) { event.blocked = true; }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::CLEAR_BODY, OnStatDrop> : BlockAllDrops {};
+template <>
+struct AbilityHandler<types::enums::Ability::WHITE_SMOKE, OnStatDrop> : BlockAllDrops {};
+
+template <>
+struct AbilityHandler<types::enums::Ability::HYPER_CUTTER, OnStatDrop> {
+    static constexpr bool handles = true;
+
+    static void execute(OnStatDrop& event) {
+        if (event.attack)
+            event.blocked = true;
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::KEEN_EYE, OnStatDrop> {
+    static constexpr bool handles = true;
+
+    static void execute(OnStatDrop& event) {
+        if (event.accuracy)
+            event.blocked = true;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// LIMBER / INSOMNIA / VITAL SPIRIT / IMMUNITY / WATER VEIL / MAGMA ARMOR
+// Gen III: the holder cannot be given the status
+// ----------------------------------------------------------------------------
+
+template <uint8_t Blocks>
+struct BlockStatus {
+    static constexpr bool handles = true;
+
+    static void execute(OnStatusAttempt& event) {
+        if (Blocks & detail::status_bit(event.status))
+            event.blocked = true;
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::LIMBER, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::PARALYSIS)> {};
+template <>
+struct AbilityHandler<types::enums::Ability::INSOMNIA, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::SLEEP)> {};
+template <>
+struct AbilityHandler<types::enums::Ability::VITAL_SPIRIT, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::SLEEP)> {};
+template <>
+struct AbilityHandler<types::enums::Ability::IMMUNITY, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::POISON) |
+                  detail::status_bit(logic::state::Status::TOXIC)> {};
+template <>
+struct AbilityHandler<types::enums::Ability::WATER_VEIL, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::BURN)> {};
+template <>
+struct AbilityHandler<types::enums::Ability::MAGMA_ARMOR, OnStatusAttempt>
+    : BlockStatus<detail::status_bit(logic::state::Status::FREEZE)> {};
+
+// ----------------------------------------------------------------------------
+// HUGE POWER / PURE POWER - 2x Attack
+// HUSTLE - 1.5x Attack (the accuracy cost is not modelled)
+// GUTS - 1.5x Attack while statused
+// Gen III: physical moves only (the move's type decides)
+// ----------------------------------------------------------------------------
+
+template <uint8_t Numerator, uint8_t Denominator, bool WhileStatused>
+struct BoostAttack {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageCalc& event) {
+        if (!logic::calc::is_physical_type(event.params.move_type))
+            return;
+        if (WhileStatused && !event.ctx.attacker_mon()->has_status())
+            return;
+        event.params.attack = static_cast<uint16_t>(
+            static_cast<uint32_t>(event.params.attack) * Numerator / Denominator);
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::HUGE_POWER, OnPreDamageCalc>
+    : BoostAttack<2, 1, false> {};
+template <>
+struct AbilityHandler<types::enums::Ability::PURE_POWER, OnPreDamageCalc>
+    : BoostAttack<2, 1, false> {};
+template <>
+struct AbilityHandler<types::enums::Ability::HUSTLE, OnPreDamageCalc>
+    : BoostAttack<3, 2, false> {};
+template <>
+struct AbilityHandler<types::enums::Ability::GUTS, OnPreDamageCalc> : BoostAttack<3, 2, true> {};
+
+// ----------------------------------------------------------------------------
+// BLAZE / OVERGROW / TORRENT / SWARM - 1.5x power of one type at 1/3 HP
+// ----------------------------------------------------------------------------
+
+template <types::enums::Type T>
+struct PinchBoost {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageCalc& event) {
+        const logic::state::MonState* mon = event.ctx.attacker_mon();
+        if (event.params.move_type != T || mon->current_hp > mon->max_hp / 3)
+            return;
+        event.params.power = static_cast<uint16_t>(event.params.power * 3 / 2);
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::BLAZE, OnPreDamageCalc>
+    : PinchBoost<types::enums::Type::FIRE> {};
+template <>
+struct AbilityHandler<types::enums::Ability::OVERGROW, OnPreDamageCalc>
+    : PinchBoost<types::enums::Type::GRASS> {};
+template <>
+struct AbilityHandler<types::enums::Ability::TORRENT, OnPreDamageCalc>
+    : PinchBoost<types::enums::Type::WATER> {};
+template <>
+struct AbilityHandler<types::enums::Ability::SWARM, OnPreDamageCalc>
+    : PinchBoost<types::enums::Type::BUG> {};
+
+// ----------------------------------------------------------------------------
+// THICK FAT - Halve the attacker's Attack for Fire and Ice moves
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::THICK_FAT, OnPreDamageTaken> {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageTaken& event) {
+        const types::enums::Type type = event.params.move_type;
+        if (type == types::enums::Type::FIRE || type == types::enums::Type::ICE)
+            event.params.attack = static_cast<uint16_t>(event.params.attack / 2);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// MARVEL SCALE - 1.5x Defense while statused
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::MARVEL_SCALE, OnPreDamageTaken> {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageTaken& event) {
+        if (!logic::calc::is_physical_type(event.params.move_type) ||
+            !event.ctx.defender_mon()->has_status())
+            return;
+        event.params.defense = static_cast<uint16_t>(
+            static_cast<uint32_t>(event.params.defense) * 3 / 2);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// LEVITATE / FLASH FIRE - Immune to one type
+// VOLT ABSORB / WATER ABSORB - Immune, and heal 1/4 max HP instead
+// ----------------------------------------------------------------------------
+
+template <types::enums::Ability AbilityId, types::enums::Type T, bool Heals>
+struct AbsorbType {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageTaken& event) {
+        if (event.params.move_type != T)
+            return;
+        event.params.effectiveness = 0;
+        detail::announce(event.ctx.defender_slot_id, AbilityId);
+        if constexpr (Heals) {
+            logic::state::MonState* mon = event.ctx.defender_mon();
+            mon->heal(detail::fraction(*mon, 4));
+        }
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::LEVITATE, OnPreDamageTaken>
+    : AbsorbType<types::enums::Ability::LEVITATE, types::enums::Type::GROUND, false> {};
+template <>
+struct AbilityHandler<types::enums::Ability::FLASH_FIRE, OnPreDamageTaken>
+    : AbsorbType<types::enums::Ability::FLASH_FIRE, types::enums::Type::FIRE, false> {};
+template <>
+struct AbilityHandler<types::enums::Ability::VOLT_ABSORB, OnPreDamageTaken>
+    : AbsorbType<types::enums::Ability::VOLT_ABSORB, types::enums::Type::ELECTRIC, true> {};
+template <>
+struct AbilityHandler<types::enums::Ability::WATER_ABSORB, OnPreDamageTaken>
+    : AbsorbType<types::enums::Ability::WATER_ABSORB, types::enums::Type::WATER, true> {};
+
+// ----------------------------------------------------------------------------
+// WONDER GUARD - Only super effective hits land
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::WONDER_GUARD, OnPreDamageTaken> {
+    static constexpr bool handles = true;
+
+    static void execute(OnPreDamageTaken& event) {
+        if (logic::calc::is_super_effective(logic::calc::resolve_effectiveness(event.params)))
+            return;
+        event.params.effectiveness = 0;
+        detail::announce(event.ctx.defender_slot_id, types::enums::Ability::WONDER_GUARD);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// STATIC / FLAME BODY / POISON POINT / EFFECT SPORE / ROUGH SKIN
+// Gen III: 1/3 chance to status a contact attacker (Effect Spore: 1/10, then
+// poison, paralysis or sleep); Rough Skin takes 1/16 of its max HP
+// (handler.cpp: the status can be blocked by the attacker's ability)
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::STATIC, OnContact> {
+    static constexpr bool handles = true;
+
+    static void execute(OnContact& event);
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::FLAME_BODY, OnContact> {
+    static constexpr bool handles = true;
+
+    static void execute(OnContact& event);
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::POISON_POINT, OnContact> {
+    static constexpr bool handles = true;
+
+    static void execute(OnContact& event);
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::EFFECT_SPORE, OnContact> {
+    static constexpr bool handles = true;
+
+    static void execute(OnContact& event);
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::ROUGH_SKIN, OnContact> {
+    static constexpr bool handles = true;
+
+    static void execute(OnContact& event) {
+        logic::state::MonState* attacker = event.ctx.attacker_mon();
+        if (attacker->is_fainted())
+            return;
+        detail::announce(event.ctx.defender_slot_id, types::enums::Ability::ROUGH_SKIN);
+        attacker->apply_damage(detail::fraction(*attacker, 16));
+    }
+};
+
+// ----------------------------------------------------------------------------
+// SWIFT SWIM / CHLOROPHYLL - 2x Speed in rain / sun
+// ----------------------------------------------------------------------------
+
+template <logic::state::Weather W>
+struct WeatherSpeed {
+    static constexpr bool handles = true;
+
+    static void execute(OnSpeedCalc& event) {
+        if (detail::weather(event.ctx) == W)
+            event.speed = static_cast<uint16_t>(event.speed * 2);
+    }
+};
+
+template <>
+struct AbilityHandler<types::enums::Ability::SWIFT_SWIM, OnSpeedCalc>
+    : WeatherSpeed<logic::state::Weather::RAIN> {};
+template <>
+struct AbilityHandler<types::enums::Ability::CHLOROPHYLL, OnSpeedCalc>
+    : WeatherSpeed<logic::state::Weather::SUN> {};
+
+// ----------------------------------------------------------------------------
+// SPEED BOOST - +1 Speed at the end of every turn
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::SPEED_BOOST, OnTurnEnd> {
+    static constexpr bool handles = true;
+
+    static void execute(OnTurnEnd& event) {
+        logic::state::SlotState* slot = event.ctx.attacker_slot();
+        if (slot->spd_stage >= 6)
+            return;
+        detail::announce(event.ctx.attacker_slot_id, types::enums::Ability::SPEED_BOOST);
+        logic::state::assign(slot->spd_stage, static_cast<int8_t>(slot->spd_stage + 1));
+        slot->mark_speed_dirty();
+    }
+};
+
+// ----------------------------------------------------------------------------
+// RAIN DISH - Heal 1/16 max HP at the end of a rainy turn
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::RAIN_DISH, OnTurnEnd> {
+    static constexpr bool handles = true;
+
+    static void execute(OnTurnEnd& event) {
+        logic::state::MonState* mon = event.ctx.attacker_mon();
+        if (detail::weather(event.ctx) != logic::state::Weather::RAIN ||
+            mon->current_hp >= mon->max_hp)
+            return;
+        detail::announce(event.ctx.attacker_slot_id, types::enums::Ability::RAIN_DISH);
+        mon->heal(detail::fraction(*mon, 16));
+    }
+};
+
+// ----------------------------------------------------------------------------
+// SHED SKIN - 1/3 chance to cure the holder's status at the end of the turn
+// ----------------------------------------------------------------------------
+
+template <>
+struct AbilityHandler<types::enums::Ability::SHED_SKIN, OnTurnEnd> {
+    static constexpr bool handles = true;
+
+    static void execute(OnTurnEnd& event) {
+        logic::state::MonState* mon = event.ctx.attacker_mon();
+        if (!mon->has_status() ||
+            !event.ctx.rng->chance(1, 3, util::random::DrawSite::ABILITY))
+            return;
+        detail::announce(event.ctx.attacker_slot_id, types::enums::Ability::SHED_SKIN);
+        if (mon->is_paralyzed())
+            event.ctx.attacker_slot()->mark_speed_dirty();
+        mon->cure_status();
+        logic::state::events::emit(logic::state::EventType::STATUS, event.ctx.attacker_slot_id,
+                                   static_cast<uint16_t>(logic::state::Status::NONE));
+    }
+};
+
+}  // namespace dsl::ability
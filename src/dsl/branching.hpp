@@ -54,27 +54,27 @@ inline bool Always(const BattleContext&) {
 
 /// True if sun is active.
 inline bool InSun(const BattleContext& ctx) {
-    return ctx.field && ctx.field->weather == logic::state::Weather::SUN;
+    return ctx.field() && ctx.field()->weather == logic::state::Weather::SUN;
 }
 
 /// True if rain is active.
 inline bool InRain(const BattleContext& ctx) {
-    return ctx.field && ctx.field->weather == logic::state::Weather::RAIN;
+    return ctx.field() && ctx.field()->weather == logic::state::Weather::RAIN;
 }
 
 /// True if sandstorm is active.
 inline bool InSandstorm(const BattleContext& ctx) {
-    return ctx.field && ctx.field->weather == logic::state::Weather::SANDSTORM;
+    return ctx.field() && ctx.field()->weather == logic::state::Weather::SANDSTORM;
 }
 
 /// True if hail is active.
 inline bool InHail(const BattleContext& ctx) {
-    return ctx.field && ctx.field->weather == logic::state::Weather::HAIL;
+    return ctx.field() && ctx.field()->weather == logic::state::Weather::HAIL;
 }
 
 /// True if no weather is active.
 inline bool NoWeather(const BattleContext& ctx) {
-    return !ctx.field || ctx.field->weather == logic::state::Weather::NONE;
+    return !ctx.field() || ctx.field()->weather == logic::state::Weather::NONE;
 }
 
 /** @} */
@@ -103,12 +103,12 @@ inline bool MoveMissed(const BattleContext& ctx) {
 
 /// True if the target is alive.
 inline bool TargetAlive(const BattleContext& ctx) {
-    return ctx.defender_mon && ctx.defender_mon->is_alive();
+    return ctx.defender_mon() && ctx.defender_mon()->is_alive();
 }
 
 /// True if the target has fainted.
 inline bool TargetFainted(const BattleContext& ctx) {
-    return ctx.defender_mon && ctx.defender_mon->is_fainted();
+    return ctx.defender_mon() && ctx.defender_mon()->is_fainted();
 }
 
 /** @} */
@@ -120,12 +120,12 @@ inline bool TargetFainted(const BattleContext& ctx) {
 
 /// True if the attacker is charging a two-turn move.
 inline bool IsCharging(const BattleContext& ctx) {
-    return ctx.attacker_slot && ctx.attacker_slot->charging_move != 0;
+    return ctx.attacker_slot() && ctx.attacker_slot()->charging_move != 0;
 }
 
 /// True if the attacker is not charging.
 inline bool NotCharging(const BattleContext& ctx) {
-    return !ctx.attacker_slot || ctx.attacker_slot->charging_move == 0;
+    return !ctx.attacker_slot() || ctx.attacker_slot()->charging_move == 0;
 }
 
 /** @} */
@@ -273,11 +273,52 @@ struct Match {
  * @{
  */
 
+/**
+ * @brief Single-step replacement for the commands A, B, C run in a row.
+ *
+ * None by default; fused.hpp specializes it. A kernel must do exactly what
+ * the three commands and their stage transitions would, and provide
+ * `template <typename Stage> static void execute(BattleContext&)` for a
+ * pipeline entering A at `Stage`.
+ */
+template <typename A, typename B, typename C>
+struct FusedKernel {
+    static constexpr bool available = false;
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+/// True if a Seq at `Stage` may run FusedKernel<A, B, C> in place of A, B, C:
+/// a kernel exists, the commands' checks pass, and no tracer wants each span
+template <typename Stage, Domain Allowed, typename A, typename B, typename C>
+inline constexpr bool fusable = [] {
+    if constexpr (meta::Command<A> && meta::Command<B> && meta::Command<C>) {
+        return FusedKernel<A, B, C>::available && !trace::Tracer::enabled &&
+               meta::ValidAccess<Allowed, A::domains | B::domains | C::domains> &&
+               meta::StageReached<Stage, typename A::input_stage>;
+    } else {
+        return false;
+    }
+}();
+
+/// fusable<> for the first three of A, B, Rest... (false if there are two)
+template <typename Stage, Domain Allowed, typename A, typename B, typename... Rest>
+inline constexpr bool fusable_prefix = false;
+
+template <typename Stage, Domain Allowed, typename A, typename B, typename C, typename... Rest>
+inline constexpr bool fusable_prefix<Stage, Allowed, A, B, C, Rest...> =
+    fusable<Stage, Allowed, A, B, C>;
+
+}  // namespace detail
+/// @endcond
+
 /**
  * @brief Executes a sequence of commands in order.
  * @tparam Cmds Command types to execute sequentially.
  *
- * The output_stage is the last command's output stage.
+ * The output_stage is the last command's output stage. Three commands with
+ * a FusedKernel run as that kernel.
  *
  * @code
  * using HitSequence = Seq<CheckAccuracy, CalculateDamage, ApplyDamage>;
@@ -308,8 +349,25 @@ struct Seq {
 
     template <typename Stage, Domain Allowed, typename Cmd, typename Next, typename... Rest>
     static auto execute_impl(Pipeline<Stage, Allowed> pipe) {
-        auto next_pipe = pipe.template run<Cmd>();
-        return execute_impl<typename Cmd::output_stage, Allowed, Next, Rest...>(next_pipe);
+        if constexpr (detail::fusable_prefix<Stage, Allowed, Cmd, Next, Rest...>) {
+            return execute_fused<Stage, Allowed, Cmd, Next, Rest...>(pipe);
+        } else {
+            auto next_pipe = pipe.template run<Cmd>();
+            return execute_impl<typename Cmd::output_stage, Allowed, Next, Rest...>(next_pipe);
+        }
+    }
+
+    template <typename Stage, Domain Allowed, typename A, typename B, typename C,
+              typename... Rest>
+    static auto execute_fused(Pipeline<Stage, Allowed> pipe) {
+        FusedKernel<A, B, C>::template execute<Stage>(pipe.context());
+        // Where run<C>() leaves the pipeline (a stage can repeat an earlier one)
+        Pipeline<typename C::output_stage, Allowed> next_pipe{pipe.context()};
+        if constexpr (sizeof...(Rest) == 0) {
+            return next_pipe;
+        } else {
+            return execute_impl<typename C::output_stage, Allowed, Rest...>(next_pipe);
+        }
     }
 };
 
@@ -32,11 +32,14 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include "../logic/ops/all.hpp"
 #include "../logic/state/context.hpp"
 #include "branching.hpp"
 #include "domain.hpp"
+#include "effect_traits.hpp"
+#include "fused.hpp"
 #include "meta.hpp"
 #include "pipeline.hpp"
 #include "stages.hpp"
@@ -166,6 +169,168 @@ struct RepeatWhile {
 
 /** @} */  // end of repetition group
 
+// ============================================================================
+//                             EFFECT TRAITS
+// ============================================================================
+//
+// What an effect can do, read from its definition (see effect_traits.hpp).
+// Declarative actions fold the traits of their parts. An EFFECT() body is
+// instantiated a second time with CollectSteps, whose pipeline runs
+// nothing and only records each command or action it is handed; that
+// instantiation is never called, so it costs nothing at runtime.
+//
+// ============================================================================
+
+template <typename T>
+struct ActionTraits;
+
+/// Traits of a command or an action
+template <typename T>
+constexpr EffectTraits traits_of() {
+    if constexpr (meta::Command<T>) {
+        return command_traits<T>();
+    } else {
+        return ActionTraits<T>::value;
+    }
+}
+
+/// @cond INTERNAL
+template <typename... Cmds>
+struct ActionTraits<Seq<Cmds...>> {
+    static constexpr EffectTraits value = (traits_of<Cmds>() | ...);
+};
+
+template <typename Cmd>
+struct ActionTraits<Do<Cmd>> {
+    static constexpr EffectTraits value = traits_of<Cmd>();
+};
+
+template <Predicate When, typename Action>
+struct ActionTraits<Branch<When, Action>> {
+    static constexpr EffectTraits value = traits_of<Action>();
+};
+
+template <typename ConvergenceStage, typename... Branches>
+struct ActionTraits<Match<ConvergenceStage, Branches...>> {
+    static constexpr EffectTraits value = (traits_of<Branches>() | ...);
+};
+
+template <std::size_t N, typename Action>
+struct ActionTraits<Repeat<N, Action>> {
+    static constexpr EffectTraits value = traits_of<Action>();
+};
+
+template <std::size_t MaxIterations, Predicate Pred, typename Action, typename Convergence>
+struct ActionTraits<RepeatWhile<MaxIterations, Pred, Action, Convergence>> {
+    static constexpr EffectTraits value = traits_of<Action>();
+};
+
+template <Domain AllowedDomains, typename Action>
+struct ActionTraits<Effect<AllowedDomains, Action>> {
+    static constexpr EffectTraits value = traits_of<Action>();
+};
+/// @endcond
+
+/// A body step run with arguments (RUN_WITH): its traits count, but the
+/// step cannot be replayed from its type
+template <typename Cmd>
+struct WithArgs {};
+
+/// @cond INTERNAL
+template <typename Cmd>
+struct ActionTraits<WithArgs<Cmd>> {
+    static constexpr EffectTraits value = command_traits<Cmd>();
+};
+
+template <typename Step>
+inline constexpr bool is_with_args = false;
+
+template <typename Cmd>
+inline constexpr bool is_with_args<WithArgs<Cmd>> = true;
+/// @endcond
+
+/**
+ * @brief Pipeline stand-in that records the steps it is handed, in order.
+ * @tparam Allowed Domains the effect may access.
+ * @tparam Steps Commands and actions run so far (WithArgs<Cmd> for RUN_WITH).
+ */
+template <Domain Allowed, typename... Steps>
+struct StepPipeline {
+    /// Union of the steps' traits
+    static constexpr EffectTraits traits = (EffectTraits{} | ... | traits_of<Steps>());
+
+    /// True if Seq<Steps...> runs exactly what the body runs
+    static constexpr bool replayable = sizeof...(Steps) > 0 && (!is_with_args<Steps> && ...);
+
+    /// Record a command or action
+    template <typename Step>
+    constexpr auto run() const -> StepPipeline<Allowed, Steps..., Step> {
+        return {};
+    }
+
+    /// Record a command run with arguments (the arguments are not evaluated)
+    template <typename Step, typename... Args>
+        requires(sizeof...(Args) > 0)
+    constexpr auto run(Args&&...) const -> StepPipeline<Allowed, Steps..., WithArgs<Step>> {
+        return {};
+    }
+
+    /// The body as a declarative action (requires `replayable`)
+    template <template <typename...> typename As = Seq>
+    using action = As<Steps...>;
+};
+
+/// Effect body policy that records steps instead of running (see RunPipeline)
+struct CollectSteps {
+    template <Domain Allowed>
+    static constexpr StepPipeline<Allowed> begin(BattleContext&) {
+        return {};
+    }
+};
+
+/// Steps of an EFFECT() body, as a StepPipeline
+template <typename Routine>
+using effect_steps_t =
+    decltype(Routine::template body<CollectSteps>(std::declval<BattleContext&>()));
+
+/**
+ * @brief Run an EFFECT() body.
+ *
+ * A straight-line body (every step a RUN or RUN_ACTION) runs as the Seq<> of
+ * its steps, which executes the same commands in the same order and lets
+ * Seq fuse the common Hit prefix (see fused.hpp); the body as written is
+ * still instantiated for its type-state checks. Bodies with RUN_WITH steps
+ * run as written.
+ *
+ * @tparam Routine The EFFECT() struct
+ * @tparam Begin Pipeline policy (RunPipeline to execute)
+ */
+template <typename Routine, typename Begin>
+inline void run_effect(BattleContext& ctx) {
+    using Steps = effect_steps_t<Routine>;
+    if constexpr (std::is_same_v<Begin, RunPipeline> && Steps::replayable) {
+        using Checked = decltype(Routine::template body<RunPipeline>(ctx));
+        static_assert(std::is_same_v<typename Checked::stage_type,
+                                     typename Steps::template action<>::output_stage>);
+        (void)Steps::template action<>::execute(begin<Routine::domains>(ctx));
+    } else {
+        (void)Routine::template body<Begin>(ctx);
+    }
+}
+
+/**
+ * @brief Traits of an effect routine: an EFFECT() or a declarative Effect<>.
+ * @tparam Routine Routine type (e.g. logic::routines::Hit).
+ */
+template <typename Routine>
+inline constexpr EffectTraits effect_traits = [] {
+    if constexpr (meta::Action<Routine>) {
+        return traits_of<Routine>();
+    } else {
+        return effect_steps_t<Routine>::traits;
+    }
+}();
+
 }  // namespace dsl
 
 /**
@@ -186,6 +351,10 @@ struct RepeatWhile {
  * @param name Effect name (creates Effect_##name struct and name alias).
  * @param required_domains Domain constraints for the effect.
  *
+ * The block that follows is the body of `body<Begin>()`, a template over
+ * how the pipeline starts, so its steps can be read at compile time
+ * (dsl::effect_traits, dsl::run_effect()); `execute(ctx)` runs it.
+ *
  * @code
  * EFFECT(Tackle, Pure) {
  *     BEGIN(ctx);
@@ -196,13 +365,19 @@ struct RepeatWhile {
  * }
  * @endcode
  */
-#define EFFECT(name, required_domains)                             \
-    struct Effect_##name {                                         \
-        static constexpr ::dsl::Domain domains = required_domains; \
-        static void execute(::dsl::BattleContext& ctx);            \
-    };                                                             \
-    using name = Effect_##name;                                    \
-    inline void Effect_##name::execute(::dsl::BattleContext& ctx)
+#define EFFECT(name, required_domains)                                                      \
+    struct Effect_##name {                                                                  \
+        static constexpr ::dsl::Domain domains = required_domains;                          \
+        template <typename Begin = ::dsl::RunPipeline>                                      \
+        static void execute(::dsl::BattleContext& ctx) {                                    \
+            ::dsl::run_effect<Effect_##name, Begin>(ctx);                                   \
+        }                                                                                   \
+        template <typename Begin>                                                           \
+        static auto body(::dsl::BattleContext& ctx);                                        \
+    };                                                                                      \
+    using name = Effect_##name;                                                             \
+    template <typename Begin>                                                               \
+    inline auto Effect_##name::body(::dsl::BattleContext& ctx)
 
 /**
  * @def BEGIN(ctx)
@@ -210,7 +385,7 @@ struct RepeatWhile {
  * @param ctx BattleContext reference.
  */
 #define BEGIN(ctx) auto _dsl_pipe = [&]() {                                                   \
-        if (auto _dsl_prev = ::dsl::begin<domains>(ctx); true)
+        if (auto _dsl_prev = Begin::template begin<domains>(ctx); true)
 /**
  * @def RUN(cmd)
  * @brief Executes a command (auto-prefixed with logic::ops::).
@@ -247,7 +422,7 @@ struct RepeatWhile {
     return _dsl_prev; \
     }                 \
     ();               \
-    (void)_dsl_pipe
+    return _dsl_pipe
 
 /** @} */  // end of imperative_macros group
 
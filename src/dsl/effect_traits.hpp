@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @file effect_traits.hpp
+ * @brief Compile-time properties of commands and the effects built from them.
+ *
+ * Each command contributes traits: the ones its stages and domains imply,
+ * plus any it declares as `static constexpr EffectTraits traits`. An
+ * effect's traits are the union over every command it can run (see
+ * dsl::effect_traits in effect.hpp), so they cover every path through its
+ * branches, not the one a given turn takes.
+ */
+
+#include <type_traits>
+
+#include "domain.hpp"
+#include "stages.hpp"
+
+namespace dsl {
+
+/// What running an effect can do
+struct EffectTraits {
+    bool deals_damage{false};   ///< Applies move damage to the defender.
+    bool draws_rng{false};      ///< May draw from the battle RNG (incl. its item / ability hooks).
+    bool touches_field{false};  ///< Writes Field state (weather, ...).
+    bool touches_side{false};   ///< Writes Side state (screens, hazards).
+    bool can_switch{false};     ///< May ask the engine to switch a battler out (Baton Pass, Roar).
+    bool multi_turn{false};     ///< May leave its user committed to a later turn (charging).
+
+    friend constexpr EffectTraits operator|(EffectTraits a, EffectTraits b) {
+        return {a.deals_damage || b.deals_damage, a.draws_rng || b.draws_rng,
+                a.touches_field || b.touches_field, a.touches_side || b.touches_side,
+                a.can_switch || b.can_switch,       a.multi_turn || b.multi_turn};
+    }
+
+    friend constexpr bool operator==(const EffectTraits&, const EffectTraits&) = default;
+};
+
+/**
+ * @brief Traits of one command.
+ *
+ * Implied: reaching DamageApplied deals damage, Field / Side domains touch
+ * the field / a side. Declared: everything else (RNG draws, switching,
+ * charging), through an optional `Cmd::traits`.
+ */
+template <typename Cmd>
+constexpr EffectTraits command_traits() {
+    EffectTraits traits{};
+    if constexpr (requires { Cmd::traits; }) {
+        traits = Cmd::traits;
+    }
+    traits.deals_damage |= std::is_same_v<typename Cmd::output_stage, DamageApplied>;
+    traits.touches_field |= Cmd::domains & Domain::Field;
+    traits.touches_side |= Cmd::domains & Domain::Side;
+    return traits;
+}
+
+}  // namespace dsl
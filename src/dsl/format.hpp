@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * @file format.hpp
+ * @brief Compile-time battle format: slot topology and turn order.
+ */
+
+#include <cstdint>
+
+#include "../logic/state/context.hpp"
+
+namespace dsl {
+
+// ============================================================================
+//                             BATTLE FORMAT
+// ============================================================================
+//
+// Everything that depends on how many battlers are in play, as a policy
+// type instead of a runtime slot count. Singles resolves every move to the
+// one foe and orders a turn with one key comparison, so the engine stays
+// straight-line.
+//
+// Slot 0 fights for player 1 and slot 1 for player 2. Doubles is out of
+// scope: BattleState, the field's per-battler arrays and the packed and
+// hashed layouts all hold exactly these two slots.
+//
+// ============================================================================
+
+struct Singles {
+    static constexpr uint8_t SLOTS = 2;
+
+    /// The foe facing `slot` (a move's target)
+    static constexpr uint8_t foe_of(uint8_t slot) { return slot ^ 1; }
+
+    /**
+     * @brief Turn order of the two battlers.
+     *
+     * @param keys logic::calc::turn_order_key() per slot
+     * @param[out] order Slots, first to act first
+     * @param first Speed-tie break: first(a, b) is true if slot `a` acts before `b`
+     */
+    template <typename TieBreak>
+    static constexpr void order(const uint32_t (&keys)[SLOTS], uint8_t (&order)[SLOTS],
+                                TieBreak&& first) {
+        const bool slot0_first = keys[0] != keys[1] ? keys[0] > keys[1] : first(0, 1);
+        order[0] = slot0_first ? 0 : 1;
+        order[1] = slot0_first ? 1 : 0;
+    }
+};
+
+// The engine, BattleState and the packed/hashed layouts are singles
+static_assert(Singles::SLOTS == MAX_BATTLE_SLOTS);
+
+}  // namespace dsl
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file fused.hpp
+ * @brief Fused kernels for common command runs (see dsl::FusedKernel).
+ */
+
+#include "../logic/ops/accuracy.hpp"
+#include "../logic/ops/damage.hpp"
+#include "branching.hpp"
+#include "transition.hpp"
+
+namespace dsl {
+
+// ============================================================================
+//                              HIT KERNEL
+// ============================================================================
+//
+// CheckAccuracy, CalculateDamage, ApplyDamage: the prefix of nearly every
+// damaging routine. Run as three pipeline steps, each of them and the
+// transitions between them re-test result.missed, and the damage payload is
+// built and passed through even after a miss. Nothing between accuracy and
+// damage can make a move miss (the pre-damage hooks only change the
+// payload), so the kernel tests the miss once and goes straight to the end
+// state the three steps leave: no damage.
+//
+// Stage transitions still run in the same order (they are where items and
+// abilities hook in), so the kernel is interchangeable with the steps.
+//
+// ============================================================================
+
+template <>
+struct FusedKernel<logic::ops::CheckAccuracy, logic::ops::CalculateDamage,
+                   logic::ops::ApplyDamage> {
+    static constexpr bool available = true;
+
+    template <typename Stage>
+    static void execute(BattleContext& ctx) {
+        using logic::ops::ApplyDamage;
+        using logic::ops::CalculateDamage;
+        using logic::ops::CheckAccuracy;
+
+        run_transition<Stage, AccuracyResolved>(ctx);
+        CheckAccuracy::execute(ctx);
+        if (ctx.result.missed) {
+            // CalculateDamage's miss path; ApplyDamage does nothing after it
+            ctx.result.damage = 0;
+            return;
+        }
+
+        auto params = CalculateDamage::build_params(ctx);
+        run_transition<AccuracyResolved, DamageCalculated>(ctx, params);
+        CalculateDamage::roll(ctx, params);
+
+        run_transition<DamageCalculated, DamageApplied>(ctx);
+        if (ctx.result.damage != 0)
+            ApplyDamage::apply(ctx);
+    }
+};
+
+}  // namespace dsl
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <type_traits>
+
 #include "../../logic/state/context.hpp"
+#include "event_mask.hpp"
 #include "handler.hpp"
+#include "util/profile.hpp"
 
 namespace dsl::item {
 
@@ -13,62 +17,90 @@ namespace dsl::item {
 // Uses `if constexpr` to eliminate non-handling branches at compile time.
 //
 // The switch covers all items that have ANY handler specialization.
-// Items without handlers for a given event compile to no-ops.
+// Items without handlers for a given event compile to no-ops. Type boost
+// items are resolved from their table (handler.hpp) before the switch.
+// Items data::item_in_build() leaves out compile to no-ops too: their cases
+// are empty, and their event masks (event_mask.hpp) never reach the switch.
 //
 // ============================================================================
 
+/// Profiler section an event's dispatch is accounted to
+template <typename Event>
+inline constexpr auto EVENT_SECTION = util::profile::Section::COUNT;
+
+template <>
+inline constexpr auto EVENT_SECTION<OnPreDamageCalc> = util::profile::Section::ITEM_PRE_DAMAGE_CALC;
+template <>
+inline constexpr auto EVENT_SECTION<OnPreDamageApply> =
+    util::profile::Section::ITEM_PRE_DAMAGE_APPLY;
+template <>
+inline constexpr auto EVENT_SECTION<OnPostDamageApply> =
+    util::profile::Section::ITEM_POST_DAMAGE_APPLY;
+template <>
+inline constexpr auto EVENT_SECTION<OnTurnStart> = util::profile::Section::ITEM_TURN_START;
+template <>
+inline constexpr auto EVENT_SECTION<OnTurnEnd> = util::profile::Section::ITEM_TURN_END;
+template <>
+inline constexpr auto EVENT_SECTION<OnItemCheck> = util::profile::Section::ITEM_CHECK;
+
+/// Run `ItemId`'s handler for `Event`, if it has one in this build
+template <types::enums::Item ItemId, typename Event>
+inline void run(Event& event) {
+    if constexpr (data::item_in_build(ItemId) && ItemHandler<ItemId, Event>::handles)
+        ItemHandler<ItemId, Event>::execute(event);
+}
+
 /// Dispatch an event to the appropriate item handler
 template <typename Event>
 void dispatch(types::enums::Item item, Event& event) {
     using enum types::enums::Item;
 
+    static_assert(EVENT_SECTION<Event> != util::profile::Section::COUNT,
+                  "new item events need a profiler section");
+    BATTLEMON_PROFILE_SCOPE(EVENT_SECTION<Event>);
+
+    // ==== Type boost items: one table lookup for all seventeen ====
+    if constexpr (std::is_same_v<Event, OnPreDamageCalc>) {
+        const TypeBoost boost = type_boost(item);
+        if (boost.type != types::enums::Type::NONE) {
+            apply_type_boost(boost, event);
+            return;
+        }
+    }
+
     // clang-format off
     switch (item) {
         // ==== Utility items with battle effects ====
-        case SCOPE_LENS:
-            if constexpr (ItemHandler<SCOPE_LENS, Event>::handles)
-                ItemHandler<SCOPE_LENS, Event>::execute(event);
-            break;
-
-        case CHOICE_BAND:
-            if constexpr (ItemHandler<CHOICE_BAND, Event>::handles)
-                ItemHandler<CHOICE_BAND, Event>::execute(event);
-            break;
-
-        case FOCUS_BAND:
-            if constexpr (ItemHandler<FOCUS_BAND, Event>::handles)
-                ItemHandler<FOCUS_BAND, Event>::execute(event);
-            break;
-
-        case KINGS_ROCK:
-            if constexpr (ItemHandler<KINGS_ROCK, Event>::handles)
-                ItemHandler<KINGS_ROCK, Event>::execute(event);
-            break;
-
-        case SHELL_BELL:
-            if constexpr (ItemHandler<SHELL_BELL, Event>::handles)
-                ItemHandler<SHELL_BELL, Event>::execute(event);
-            break;
-
-        case LEFTOVERS:
-            if constexpr (ItemHandler<LEFTOVERS, Event>::handles)
-                ItemHandler<LEFTOVERS, Event>::execute(event);
-            break;
-
-        case QUICK_CLAW:
-            if constexpr (ItemHandler<QUICK_CLAW, Event>::handles)
-                ItemHandler<QUICK_CLAW, Event>::execute(event);
-            break;
+        case SCOPE_LENS:  run<SCOPE_LENS>(event);  break;
+        case CHOICE_BAND: run<CHOICE_BAND>(event); break;
+        case FOCUS_BAND:  run<FOCUS_BAND>(event);  break;
+        case KINGS_ROCK:  run<KINGS_ROCK>(event);  break;
+        case SHELL_BELL:  run<SHELL_BELL>(event);  break;
+        case LEFTOVERS:   run<LEFTOVERS>(event);   break;
+        case QUICK_CLAW:  run<QUICK_CLAW>(event);  break;
 
         // ==== Signature items (species-specific) ====
         // TODO: Light Ball (Pikachu), Metal Powder (Ditto), etc.
         // These need species checks in the stage transition before dispatch
 
-        // ==== Type boost items ====
-        // TODO: These modify power for matching types
-
-        // ==== Berries ====
-        // TODO: Consumable effects
+        // ==== Berries (OnItemCheck only) ====
+        case ORAN_B:      run<ORAN_B>(event);      break;
+        case SITRUS_B:    run<SITRUS_B>(event);    break;
+        case CHERI_B:     run<CHERI_B>(event);     break;
+        case CHESTO_B:    run<CHESTO_B>(event);    break;
+        case PECHA_B:     run<PECHA_B>(event);     break;
+        case RAWST_B:     run<RAWST_B>(event);     break;
+        case ASPEAR_B:    run<ASPEAR_B>(event);    break;
+        case PERSIM_B:    run<PERSIM_B>(event);    break;
+        case LUM_B:       run<LUM_B>(event);       break;
+        case LEPPA_B:     run<LEPPA_B>(event);     break;
+        case LIECHI_B:    run<LIECHI_B>(event);    break;
+        case GANLON_B:    run<GANLON_B>(event);    break;
+        case SALAC_B:     run<SALAC_B>(event);     break;
+        case PETAYA_B:    run<PETAYA_B>(event);    break;
+        case APICOT_B:    run<APICOT_B>(event);    break;
+        case LANSAT_B:    run<LANSAT_B>(event);    break;
+        case STARF_B:     run<STARF_B>(event);     break;
 
         // ==== Non-battle items or no handlers ====
         default:
@@ -82,40 +114,32 @@ void dispatch(types::enums::Item item, Event& event) {
 // ============================================================================
 //
 // These functions construct events and dispatch them to the appropriate items.
-// Called from stage transitions to fire item hooks.
+// Called from stage transitions to fire item hooks. Each first tests the
+// holder's cached event mask (event_mask.hpp), which is 0 for no item, a
+// consumed item or an item without a handler for the event.
 //
 // ============================================================================
 
 /// Fire OnPreDamageCalc for attacker's item
 inline void fire_pre_damage_calc(BattleContext& ctx, uint16_t& attack, uint16_t& defense,
                                  uint8_t& crit_stage, uint16_t& power) {
-    if (!ctx.attacker_slot)
-        return;
-
-    types::enums::Item item = ctx.attacker_slot->held_item;
-    if (item == types::enums::Item::NONE)
-        return;
-    if (ctx.attacker_slot->item_consumed)
+    const logic::state::SlotState* holder = ctx.attacker_slot();
+    if (!holder || !(holder->item_events & EVENT_BIT<OnPreDamageCalc>))
         return;
 
     OnPreDamageCalc event{attack, defense, crit_stage, power, ctx};
-    dispatch(item, event);
+    dispatch(holder->held_item, event);
 }
 
 /// Fire OnPreDamageApply for defender's item
 inline void fire_pre_damage_apply(BattleContext& ctx, uint16_t& damage, uint16_t defender_hp,
                                   bool& survived_fatal) {
-    if (!ctx.defender_slot)
-        return;
-
-    types::enums::Item item = ctx.defender_slot->held_item;
-    if (item == types::enums::Item::NONE)
-        return;
-    if (ctx.defender_slot->item_consumed)
+    const logic::state::SlotState* holder = ctx.defender_slot();
+    if (!holder || !(holder->item_events & EVENT_BIT<OnPreDamageApply>))
         return;
 
     OnPreDamageApply event{damage, defender_hp, survived_fatal, ctx};
-    dispatch(item, event);
+    dispatch(holder->held_item, event);
 }
 
 /// Fire OnPostDamageApply for attacker's and defender's items
@@ -127,11 +151,9 @@ inline void fire_post_damage_apply(BattleContext& ctx, uint16_t damage_dealt, bo
         cause_flinch, ctx};
 
     // Attacker's item (Shell Bell, King's Rock)
-    if (ctx.attacker_slot && !ctx.attacker_slot->item_consumed) {
-        types::enums::Item item = ctx.attacker_slot->held_item;
-        if (item != types::enums::Item::NONE) {
-            dispatch(item, event);
-        }
+    const logic::state::SlotState* attacker = ctx.attacker_slot();
+    if (attacker && (attacker->item_events & EVENT_BIT<OnPostDamageApply>)) {
+        dispatch(attacker->held_item, event);
     }
 
     // Defender's item could have post-hit triggers too
@@ -140,32 +162,32 @@ inline void fire_post_damage_apply(BattleContext& ctx, uint16_t damage_dealt, bo
 
 /// Fire OnTurnStart for a slot's item
 inline void fire_turn_start(BattleContext& ctx, bool& priority_boost) {
-    if (!ctx.attacker_slot)
-        return;
-
-    types::enums::Item item = ctx.attacker_slot->held_item;
-    if (item == types::enums::Item::NONE)
-        return;
-    if (ctx.attacker_slot->item_consumed)
+    const logic::state::SlotState* holder = ctx.attacker_slot();
+    if (!holder || !(holder->item_events & EVENT_BIT<OnTurnStart>))
         return;
 
     OnTurnStart event{priority_boost, ctx};
-    dispatch(item, event);
+    dispatch(holder->held_item, event);
 }
 
 /// Fire OnTurnEnd for a slot's item
 inline void fire_turn_end(BattleContext& ctx, uint16_t& heal_amount, uint16_t& damage_amount) {
-    if (!ctx.attacker_slot)
+    const logic::state::SlotState* holder = ctx.attacker_slot();
+    if (!holder || !(holder->item_events & EVENT_BIT<OnTurnEnd>))
         return;
 
-    types::enums::Item item = ctx.attacker_slot->held_item;
-    if (item == types::enums::Item::NONE)
-        return;
-    if (ctx.attacker_slot->item_consumed)
+    OnTurnEnd event{heal_amount, damage_amount, ctx};
+    dispatch(holder->held_item, event);
+}
+
+/// Fire OnItemCheck for a slot's item (berries)
+inline void fire_item_check(BattleContext& ctx) {
+    const logic::state::SlotState* holder = ctx.attacker_slot();
+    if (!holder || !(holder->item_events & EVENT_BIT<OnItemCheck>))
         return;
 
-    OnTurnEnd event{heal_amount, damage_amount, ctx};
-    dispatch(item, event);
+    OnItemCheck event{ctx};
+    dispatch(holder->held_item, event);
 }
 
 }  // namespace dsl::item
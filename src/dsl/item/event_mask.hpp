@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "../../types/enums/item.hpp"
+#include "data/pool.hpp"
+#include "events.hpp"
+#include "handler.hpp"
+
+namespace dsl::item {
+
+// ============================================================================
+//                           ITEM EVENT MASKS
+// ============================================================================
+//
+// One bit per event, set for each item that has an ItemHandler specialization
+// for it (and OnPreDamageCalc for the type boost items). The table is
+// built from the `handles` constants, so a new handler is picked up without
+// touching this file. Items data::item_in_build() leaves out (a build
+// without BATTLEMON_FEATURE_OFF_POOL) get 0, so no fire site dispatches them.
+//
+// A slot caches its item's mask (SlotState::item_events) on switch-in and
+// drops it to 0 when the item is consumed. Fire functions test their bit
+// before anything else: a slot holding nothing, a spent berry or an item
+// without a handler for the event is one AND per fire site instead of a
+// load, two compares and a switch.
+//
+// ============================================================================
+
+/// Bit of an event in an item event mask
+template <typename Event>
+inline constexpr uint8_t EVENT_BIT = 0;
+
+template <>
+inline constexpr uint8_t EVENT_BIT<OnPreDamageCalc> = 1 << 0;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnPreDamageApply> = 1 << 1;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnPostDamageApply> = 1 << 2;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnTurnStart> = 1 << 3;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnTurnEnd> = 1 << 4;
+template <>
+inline constexpr uint8_t EVENT_BIT<OnItemCheck> = 1 << 5;
+
+namespace event_mask_detail {
+
+template <types::enums::Item ItemId, typename Event>
+inline constexpr uint8_t handled_bit = ItemHandler<ItemId, Event>::handles ? EVENT_BIT<Event> : 0;
+
+template <size_t I>
+inline constexpr uint8_t item_mask = [] {
+    constexpr auto item = static_cast<types::enums::Item>(I);
+    if (!data::item_in_build(item))
+        return uint8_t{0};
+    return static_cast<uint8_t>(
+        handled_bit<item, OnPreDamageCalc> | handled_bit<item, OnPreDamageApply> |
+        handled_bit<item, OnPostDamageApply> | handled_bit<item, OnTurnStart> |
+        handled_bit<item, OnTurnEnd> | handled_bit<item, OnItemCheck> |
+        (type_boost(item).type != types::enums::Type::NONE ? EVENT_BIT<OnPreDamageCalc> : 0));
+}();
+
+template <typename Indices>
+struct MaskTable;
+
+template <size_t... Is>
+struct MaskTable<std::index_sequence<Is...>> {
+    static constexpr uint8_t entries[] = {item_mask<Is>...};
+};
+
+}  // namespace event_mask_detail
+
+/// Event mask of every item, indexed by Item
+inline constexpr const uint8_t (&g_ITEM_EVENT_MASKS)[ITEM_COUNT] =
+    event_mask_detail::MaskTable<std::make_index_sequence<ITEM_COUNT>>::entries;
+
+/// Events `item` responds to (0 for items without handlers)
+constexpr uint8_t item_event_mask(types::enums::Item item) {
+    const auto index = static_cast<size_t>(item);
+    return index < ITEM_COUNT ? g_ITEM_EVENT_MASKS[index] : 0;
+}
+
+static_assert(item_event_mask(types::enums::Item::NONE) == 0);
+static_assert(item_event_mask(types::enums::Item::SITRUS_B) == EVENT_BIT<OnItemCheck>);
+static_assert(item_event_mask(types::enums::Item::CHARCOAL) == EVENT_BIT<OnPreDamageCalc>);
+static_assert(item_event_mask(types::enums::Item::LAX_INCENSE) == 0);
+static_assert(item_event_mask(types::enums::Item::LEFTOVERS) == EVENT_BIT<OnTurnEnd>);
+static_assert(item_event_mask(types::enums::Item::SCOPE_LENS) == EVENT_BIT<OnPreDamageCalc>);
+
+}  // namespace dsl::item
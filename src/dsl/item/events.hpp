@@ -91,4 +91,12 @@ struct OnTurnEnd {
     const BattleContext& ctx;
 };
 
+/// Fires: after each move (for both battlers) and at TurnEnd, after OnTurnEnd
+/// Modifies: The holder's HP, status, stages or PP directly, consuming the item
+/// Use: Berries (Sitrus at 1/2 HP, Lum on status, Liechi at 1/4 HP)
+/// The holder is ctx's attacker slot.
+struct OnItemCheck {
+    const BattleContext& ctx;
+};
+
 }  // namespace dsl::item
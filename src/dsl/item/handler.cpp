@@ -0,0 +1,80 @@
+/**
+ * @file handler.cpp
+ * @brief Out-of-line item handlers that need full BattleContext access
+ */
+
+#include "handler.hpp"
+
+#include <cstddef>
+#include <iterator>
+
+#include "data/move.hpp"
+
+namespace dsl::item {
+
+// ----------------------------------------------------------------------------
+// LEFTOVERS - Heal 1/16 max HP at turn end
+// ----------------------------------------------------------------------------
+
+void ItemHandler<types::enums::Item::LEFTOVERS, OnTurnEnd>::execute(OnTurnEnd& event) {
+    // fire_turn_end() points attacker_mon at the battler holding the item
+    const auto* mon = event.ctx.attacker_mon();
+    if (!mon || mon->current_hp >= mon->max_hp)
+        return;
+
+    event.heal_amount = heal_amount(mon->max_hp);
+}
+
+// ----------------------------------------------------------------------------
+// STARF BERRY - +2 to a random stat at 1/4 HP
+// ----------------------------------------------------------------------------
+
+void ItemHandler<types::enums::Item::STARF_B, OnItemCheck>::execute(OnItemCheck& event) {
+    auto* mon = event.ctx.attacker_mon();
+    auto* slot = event.ctx.attacker_slot();
+    if (mon->is_fainted() || mon->current_hp > mon->max_hp / 4)
+        return;
+
+    int8_t* stages[] = {&slot->atk_stage, &slot->def_stage, &slot->spd_stage, &slot->sp_atk_stage,
+                        &slot->sp_def_stage};
+    int8_t* raisable[std::size(stages)];
+    uint8_t count = 0;
+    for (int8_t* stage : stages) {
+        if (*stage < 6)
+            raisable[count++] = stage;
+    }
+    if (count == 0)
+        return;
+
+    // pokeemerald rerolls until it lands on a raisable stat; one draw over
+    // the raisable ones picks with the same distribution
+    int8_t* stage = raisable[event.ctx.rng->random(count, util::random::DrawSite::ITEM)];
+    logic::state::assign(*stage, static_cast<int8_t>(*stage >= 5 ? 6 : *stage + 2));
+    if (stage == &slot->spd_stage)
+        slot->mark_speed_dirty();
+    slot->consume_item();
+}
+
+// ----------------------------------------------------------------------------
+// LEPPA BERRY - Restore 10 PP to a move that has run out
+// ----------------------------------------------------------------------------
+
+void ItemHandler<types::enums::Item::LEPPA_B, OnItemCheck>::execute(OnItemCheck& event) {
+    auto* mon = event.ctx.attacker_mon();
+    if (mon->is_fainted())
+        return;
+
+    const types::Rental& rental = event.ctx.state->rental(event.ctx.attacker_slot_id);
+    for (size_t i = 0; i < 4; ++i) {
+        const types::enums::Move move = rental.moves[i];
+        if (move == types::enums::Move::NONE || mon->pp[i] != 0)
+            continue;
+
+        const uint8_t max_pp = data::g_MOVE_COLD[static_cast<size_t>(move)].pp;
+        logic::state::assign(mon->pp[i], max_pp < RESTORE_PP ? max_pp : RESTORE_PP);
+        event.ctx.attacker_slot()->consume_item();
+        return;
+    }
+}
+
+}  // namespace dsl::item
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "../../logic/calc/damage.hpp"
+#include "../../logic/state/context.hpp"
 #include "../../types/enums/item.hpp"
-#include "../../util/random.hpp"
+#include "../../types/enums/type.hpp"
 #include "events.hpp"
 
 namespace dsl::item {
@@ -65,8 +67,9 @@ struct ItemHandler<types::enums::Item::CHOICE_BAND, OnPreDamageCalc> {
 
     static void execute(OnPreDamageCalc& event) {
         // Choice Band only boosts Attack, which means physical moves only.
-        // The caller (stage transition) should only fire this for physical moves,
-        // but we apply unconditionally here - the event.attack IS the attack stat.
+        // event.attack holds Sp. Atk for a special move, so check the type.
+        if (!logic::calc::is_physical_type(event.ctx.move->type))
+            return;
         event.attack = static_cast<uint16_t>(static_cast<uint32_t>(event.attack) * 3 / 2);
     }
 };
@@ -80,11 +83,14 @@ template <>
 struct ItemHandler<types::enums::Item::FOCUS_BAND, OnPreDamageApply> {
     static constexpr bool handles = true;
 
+    /// Chance (out of 100) to endure a fatal hit
+    static constexpr uint8_t ENDURE_PERCENT = 12;
+
     static void execute(OnPreDamageApply& event) {
         // Only triggers if this would be fatal
         if (event.damage >= event.defender_hp) {
             // 12% = 12/100 chance
-            if (util::random::Random(100) < 12) {
+            if (event.ctx.rng->chance(ENDURE_PERCENT, 100, util::random::DrawSite::ITEM)) {
                 event.damage = event.defender_hp - 1;  // Leave at 1 HP
                 event.survived_fatal = true;
             }
@@ -105,7 +111,7 @@ struct ItemHandler<types::enums::Item::KINGS_ROCK, OnPostDamageApply> {
         // Only if we dealt damage and target didn't faint
         if (event.damage_dealt > 0 && !event.target_fainted) {
             // 10% = 1/10 chance
-            if (util::random::Random(10) == 0) {
+            if (event.ctx.rng->chance(1, 10, util::random::DrawSite::ITEM)) {
                 event.cause_flinch = true;
             }
         }
@@ -141,6 +147,12 @@ template <>
 struct ItemHandler<types::enums::Item::LEFTOVERS, OnTurnEnd> {
     static constexpr bool handles = true;
 
+    /// HP restored per turn: 1/16 max HP, minimum 1
+    static constexpr uint16_t heal_amount(uint16_t max_hp) {
+        uint16_t heal = max_hp / 16;
+        return heal == 0 ? 1 : heal;
+    }
+
     static void execute(OnTurnEnd& event);  // Defined in .cpp - needs context access
 };
 
@@ -155,10 +167,276 @@ struct ItemHandler<types::enums::Item::QUICK_CLAW, OnTurnStart> {
 
     static void execute(OnTurnStart& event) {
         // 20% = 1/5 chance
-        if (util::random::Random(5) == 0) {
+        if (event.ctx.rng->chance(1, 5, util::random::DrawSite::QUICK_CLAW)) {
             event.priority_boost = true;
         }
     }
 };
 
+// ============================================================================
+//                           TYPE BOOST ITEMS
+// ============================================================================
+//
+// The seventeen type boosters differ only in the type they boost, so they
+// are one table rather than seventeen ItemHandler specializations:
+// dispatch() reads type_boost(item) for OnPreDamageCalc before its
+// switch, and the switch stays as long as the number of distinct effects.
+//
+// Gen III applies the boost to the attacking stat (pokeemerald
+// CalculateBaseDamage, gHoldEffectToType): event.attack already holds
+// Attack or Sp. Atk for the move's category.
+//
+// ============================================================================
+
+struct TypeBoost {
+    types::enums::Type type{types::enums::Type::NONE};  // NONE: not a type booster
+    uint8_t percent{0};                                 // Attacking stat bonus
+};
+
+/// Number of Item enumerators (WHITE_HERB is the last)
+inline constexpr size_t ITEM_COUNT = static_cast<size_t>(types::enums::Item::WHITE_HERB) + 1;
+
+namespace type_boost_detail {
+
+struct Entry {
+    types::enums::Item item;
+    types::enums::Type type;
+};
+
+/// Every Gen III type booster is +10%
+inline constexpr uint8_t BOOST_PERCENT = 10;
+
+// clang-format off
+inline constexpr Entry ENTRIES[] = {
+    {types::enums::Item::SILK_SCARF,     types::enums::Type::NORMAL},
+    {types::enums::Item::BLACK_BELT,     types::enums::Type::FIGHTING},
+    {types::enums::Item::SHARP_BEAK,     types::enums::Type::FLYING},
+    {types::enums::Item::POISON_BARB,    types::enums::Type::POISON},
+    {types::enums::Item::SOFT_SAND,      types::enums::Type::GROUND},
+    {types::enums::Item::HARD_STONE,     types::enums::Type::ROCK},
+    {types::enums::Item::SILVER_POWDER,  types::enums::Type::BUG},
+    {types::enums::Item::SPELL_TAG,      types::enums::Type::GHOST},
+    {types::enums::Item::METAL_COAT,     types::enums::Type::STEEL},
+    {types::enums::Item::CHARCOAL,       types::enums::Type::FIRE},
+    {types::enums::Item::MYSTIC_WATER,   types::enums::Type::WATER},
+    {types::enums::Item::MIRACLE_SEED,   types::enums::Type::GRASS},
+    {types::enums::Item::MAGNET,         types::enums::Type::ELECTRIC},
+    {types::enums::Item::TWISTED_SPOON,  types::enums::Type::PSYCHIC},
+    {types::enums::Item::NEVER_MELT_ICE, types::enums::Type::ICE},
+    {types::enums::Item::DRAGON_FANG,    types::enums::Type::DRAGON},
+    {types::enums::Item::BLACK_GLASSES,  types::enums::Type::DARK},
+};
+// clang-format on
+
+struct Table {
+    TypeBoost by_item[ITEM_COUNT];
+};
+
+constexpr Table build() {
+    Table table{};
+    for (const Entry& entry : ENTRIES) {
+        table.by_item[static_cast<size_t>(entry.item)] = {entry.type, BOOST_PERCENT};
+    }
+    return table;
+}
+
+inline constexpr Table TABLE = build();
+
+}  // namespace type_boost_detail
+
+/// Type boost of `item` (type NONE for everything but the seventeen boosters)
+constexpr TypeBoost type_boost(types::enums::Item item) {
+    const auto index = static_cast<size_t>(item);
+    return index < ITEM_COUNT ? type_boost_detail::TABLE.by_item[index] : TypeBoost{};
+}
+
+/// Apply a type boost to the attacking stat if the move is of the boosted type
+inline void apply_type_boost(TypeBoost boost, OnPreDamageCalc& event) {
+    if (event.ctx.move->type != boost.type)
+        return;
+    event.attack = static_cast<uint16_t>(static_cast<uint32_t>(event.attack) *
+                                         (100 + boost.percent) / 100);
+}
+
+static_assert(type_boost(types::enums::Item::MYSTIC_WATER).type == types::enums::Type::WATER);
+static_assert(type_boost(types::enums::Item::LEFTOVERS).type == types::enums::Type::NONE);
+
+// ============================================================================
+//                                BERRIES
+// ============================================================================
+//
+// Berries respond to OnItemCheck, which fires after every move for both
+// battlers and again at the end of the turn (pokeemerald ItemBattleEffects,
+// ITEMEFFECT_NORMAL). A berry whose condition holds takes effect and is
+// consumed; otherwise it stays held. Berries that share an effect share a
+// template below, so each specialization names only its parameters.
+//
+// ============================================================================
+
+namespace berry {
+
+/// Cure bits: 1 << Status for primary statuses, plus confusion
+inline constexpr uint8_t cure_bit(logic::state::Status status) {
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(status));
+}
+inline constexpr uint8_t CURES_CONFUSION = 1u << 7;
+inline constexpr uint8_t CURES_ANY_STATUS =
+    cure_bit(logic::state::Status::SLEEP) | cure_bit(logic::state::Status::POISON) |
+    cure_bit(logic::state::Status::BURN) | cure_bit(logic::state::Status::FREEZE) |
+    cure_bit(logic::state::Status::PARALYSIS) | cure_bit(logic::state::Status::TOXIC);
+
+/// Oran, Sitrus: restore a fixed amount at or below half HP
+template <uint16_t Amount>
+struct RestoreHp {
+    static constexpr bool handles = true;
+
+    static void execute(OnItemCheck& event) {
+        auto* mon = event.ctx.attacker_mon();
+        if (mon->is_fainted() || mon->current_hp > mon->max_hp / 2)
+            return;
+        event.ctx.attacker_slot()->consume_item();
+        mon->heal(Amount);
+    }
+};
+
+/// Cheri, Chesto, Pecha, Rawst, Aspear, Persim, Lum: cure a status
+template <uint8_t Cures>
+struct CureStatus {
+    static constexpr bool handles = true;
+
+    static void execute(OnItemCheck& event) {
+        auto* mon = event.ctx.attacker_mon();
+        auto* slot = event.ctx.attacker_slot();
+        const bool cure_status = mon->has_status() && (Cures & cure_bit(mon->status));
+        const bool cure_confusion =
+            (Cures & CURES_CONFUSION) && slot->has(logic::state::volatile_flags::CONFUSED);
+        if (mon->is_fainted() || (!cure_status && !cure_confusion))
+            return;
+
+        slot->consume_item();
+        if (cure_status) {
+            if (mon->is_paralyzed())
+                slot->mark_speed_dirty();
+            logic::state::assign(mon->status, logic::state::Status::NONE);
+            logic::state::assign(mon->sleep_turns, uint8_t{0});
+            logic::state::assign(mon->toxic_counter, uint8_t{1});
+            logic::state::events::emit(logic::state::EventType::STATUS, event.ctx.attacker_slot_id,
+                                       static_cast<uint16_t>(logic::state::Status::NONE));
+        }
+        if (cure_confusion) {
+            slot->clear(logic::state::volatile_flags::CONFUSED);
+            logic::state::assign(slot->confusion_turns, uint8_t{0});
+        }
+    }
+};
+
+/// Liechi, Ganlon, Salac, Petaya, Apicot: +1 to a stat at or below 1/4 HP
+template <int8_t logic::state::SlotState::*Stage>
+struct PinchStat {
+    static constexpr bool handles = true;
+
+    static void execute(OnItemCheck& event) {
+        auto* mon = event.ctx.attacker_mon();
+        auto* slot = event.ctx.attacker_slot();
+        if (mon->is_fainted() || mon->current_hp > mon->max_hp / 4 || slot->*Stage >= 6)
+            return;
+        logic::state::assign(slot->*Stage, static_cast<int8_t>(slot->*Stage + 1));
+        if constexpr (Stage == &logic::state::SlotState::spd_stage) {
+            slot->mark_speed_dirty();
+        }
+        slot->consume_item();
+    }
+};
+
+}  // namespace berry
+
+template <>
+struct ItemHandler<types::enums::Item::ORAN_B, OnItemCheck> : berry::RestoreHp<10> {};
+template <>
+struct ItemHandler<types::enums::Item::SITRUS_B, OnItemCheck> : berry::RestoreHp<30> {};
+
+template <>
+struct ItemHandler<types::enums::Item::CHERI_B, OnItemCheck>
+    : berry::CureStatus<berry::cure_bit(logic::state::Status::PARALYSIS)> {};
+template <>
+struct ItemHandler<types::enums::Item::CHESTO_B, OnItemCheck>
+    : berry::CureStatus<berry::cure_bit(logic::state::Status::SLEEP)> {};
+template <>
+struct ItemHandler<types::enums::Item::PECHA_B, OnItemCheck>
+    : berry::CureStatus<berry::cure_bit(logic::state::Status::POISON) |
+                        berry::cure_bit(logic::state::Status::TOXIC)> {};
+template <>
+struct ItemHandler<types::enums::Item::RAWST_B, OnItemCheck>
+    : berry::CureStatus<berry::cure_bit(logic::state::Status::BURN)> {};
+template <>
+struct ItemHandler<types::enums::Item::ASPEAR_B, OnItemCheck>
+    : berry::CureStatus<berry::cure_bit(logic::state::Status::FREEZE)> {};
+template <>
+struct ItemHandler<types::enums::Item::PERSIM_B, OnItemCheck>
+    : berry::CureStatus<berry::CURES_CONFUSION> {};
+template <>
+struct ItemHandler<types::enums::Item::LUM_B, OnItemCheck>
+    : berry::CureStatus<berry::CURES_ANY_STATUS | berry::CURES_CONFUSION> {};
+
+template <>
+struct ItemHandler<types::enums::Item::LIECHI_B, OnItemCheck>
+    : berry::PinchStat<&logic::state::SlotState::atk_stage> {};
+template <>
+struct ItemHandler<types::enums::Item::GANLON_B, OnItemCheck>
+    : berry::PinchStat<&logic::state::SlotState::def_stage> {};
+template <>
+struct ItemHandler<types::enums::Item::SALAC_B, OnItemCheck>
+    : berry::PinchStat<&logic::state::SlotState::spd_stage> {};
+template <>
+struct ItemHandler<types::enums::Item::PETAYA_B, OnItemCheck>
+    : berry::PinchStat<&logic::state::SlotState::sp_atk_stage> {};
+template <>
+struct ItemHandler<types::enums::Item::APICOT_B, OnItemCheck>
+    : berry::PinchStat<&logic::state::SlotState::sp_def_stage> {};
+
+// ----------------------------------------------------------------------------
+// LANSAT BERRY - Focus Energy at 1/4 HP
+// ----------------------------------------------------------------------------
+
+template <>
+struct ItemHandler<types::enums::Item::LANSAT_B, OnItemCheck> {
+    static constexpr bool handles = true;
+
+    static void execute(OnItemCheck& event) {
+        auto* mon = event.ctx.attacker_mon();
+        auto* slot = event.ctx.attacker_slot();
+        if (mon->is_fainted() || mon->current_hp > mon->max_hp / 4 ||
+            slot->has(logic::state::volatile_flags::FOCUS_ENERGY))
+            return;
+        slot->set(logic::state::volatile_flags::FOCUS_ENERGY);
+        slot->consume_item();
+    }
+};
+
+// ----------------------------------------------------------------------------
+// STARF BERRY - +2 to a random stat at 1/4 HP
+// Gen III: one of Attack, Defense, Speed, Sp. Atk, Sp. Def not already at +6
+// ----------------------------------------------------------------------------
+
+template <>
+struct ItemHandler<types::enums::Item::STARF_B, OnItemCheck> {
+    static constexpr bool handles = true;
+
+    static void execute(OnItemCheck& event);  // Defined in .cpp - picks among stages
+};
+
+// ----------------------------------------------------------------------------
+// LEPPA BERRY - Restore 10 PP to a move that has run out
+// ----------------------------------------------------------------------------
+
+template <>
+struct ItemHandler<types::enums::Item::LEPPA_B, OnItemCheck> {
+    static constexpr bool handles = true;
+
+    /// PP restored
+    static constexpr uint8_t RESTORE_PP = 10;
+
+    static void execute(OnItemCheck& event);  // Defined in .cpp - needs move data
+};
+
 }  // namespace dsl::item
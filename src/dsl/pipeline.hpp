@@ -12,6 +12,7 @@
 #include "domain.hpp"
 #include "meta.hpp"
 #include "stages.hpp"
+#include "trace.hpp"
 #include "transition.hpp"
 
 namespace dsl {
@@ -66,9 +67,11 @@ class Pipeline {
         requires meta::ValidAccess<Allowed, Cmd::domains> &&
                  meta::StageReached<Stage, typename Cmd::input_stage>
     [[nodiscard]] constexpr auto run() -> Pipeline<typename Cmd::output_stage, Allowed> {
+        const trace::Span<Cmd> span(*ctx_, StageRank{stage_rank<Stage>::value},
+                                    StageRank{stage_rank<typename Cmd::output_stage>::value});
         if constexpr (meta::TransientCommand<Cmd>) {
             auto payload = Cmd::build_transient(*ctx_);
-            StageTransition<Stage, typename Cmd::output_stage>::execute(*ctx_, payload);
+            run_transition<Stage, typename Cmd::output_stage>(*ctx_, payload);
             Cmd::execute(*ctx_, payload);
             return Pipeline<typename Cmd::output_stage, Allowed>{*ctx_};
         } else {
@@ -76,7 +79,7 @@ class Pipeline {
                           "Command declares Domain::Transient but is missing transient "
                           "payload support");
 
-            StageTransition<Stage, typename Cmd::output_stage>::execute(*ctx_);
+            run_transition<Stage, typename Cmd::output_stage>(*ctx_);
             Cmd::execute(*ctx_);
             return Pipeline<typename Cmd::output_stage, Allowed>{*ctx_};
         }
@@ -94,9 +97,11 @@ class Pipeline {
                  meta::StageReached<Stage, typename Cmd::input_stage>
     [[nodiscard]] constexpr auto run(Args&&... args)
         -> Pipeline<typename Cmd::output_stage, Allowed> {
+        const trace::Span<Cmd> span(*ctx_, StageRank{stage_rank<Stage>::value},
+                                    StageRank{stage_rank<typename Cmd::output_stage>::value});
         if constexpr (meta::TransientCommand<Cmd>) {
             auto payload = Cmd::build_transient(*ctx_);
-            StageTransition<Stage, typename Cmd::output_stage>::execute(*ctx_, payload);
+            run_transition<Stage, typename Cmd::output_stage>(*ctx_, payload);
             Cmd::execute(*ctx_, payload, static_cast<Args&&>(args)...);
             return Pipeline<typename Cmd::output_stage, Allowed>{*ctx_};
         } else {
@@ -104,7 +109,7 @@ class Pipeline {
                           "Command declares Domain::Transient but is missing transient "
                           "payload support");
 
-            StageTransition<Stage, typename Cmd::output_stage>::execute(*ctx_);
+            run_transition<Stage, typename Cmd::output_stage>(*ctx_);
             Cmd::execute(*ctx_, static_cast<Args&&>(args)...);
             return Pipeline<typename Cmd::output_stage, Allowed>{*ctx_};
         }
@@ -170,4 +175,18 @@ template <Domain Allowed>
     return Pipeline<Genesis, Allowed>{ctx};
 }
 
+/**
+ * @brief Effect body policy that executes the pipeline.
+ *
+ * EFFECT() bodies start their pipeline through a policy: this one at
+ * runtime, dsl::CollectSteps (effect.hpp) to read the body's commands at
+ * compile time.
+ */
+struct RunPipeline {
+    template <Domain Allowed>
+    [[nodiscard]] static constexpr Pipeline<Genesis, Allowed> begin(BattleContext& ctx) {
+        return dsl::begin<Allowed>(ctx);
+    }
+};
+
 }  // namespace dsl
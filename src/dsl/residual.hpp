@@ -0,0 +1,449 @@
+#pragma once
+
+/**
+ * @file residual.hpp
+ * @brief End-of-turn residual effects in Gen III order.
+ *
+ * One pass per turn, run by the engine at ActionsResolved -> TurnEnd
+ * (pokeemerald DoFieldEndTurnEffects, DoBattlerEndTurnEffects and
+ * HandleWishPerishSongOnTurnEnd):
+ *
+ *   field     screens expire, Wish, weather ends or Sandstorm / Hail damage
+ *   per slot  Ingrain, abilities (Speed Boost, Rain Dish, Shed Skin),
+ *             items (Leftovers, berries), Leech Seed, poison,
+ *             burn, Nightmare, Curse, Wrap, Disable / Encore / Taunt /
+ *             Yawn run out, berries again
+ *   field     Future Sight
+ *   per slot  Perish Song
+ *
+ * Slots are visited in the turn's action order, and a slot that faints
+ * stops taking effects. Future Sight, Wish, Nightmare, Curse and Wrap have
+ * no move setting them yet; their residuals run as soon as one does.
+ *
+ * Most turns have nothing pending, so the pass starts from bitmasks of
+ * what could act (pending_field_residuals, pending_slot_residuals), built
+ * from the volatiles, the mon's status, the held item's and the ability's
+ * event masks and the weather. If all are 0 the turn end costs that one compare; otherwise only
+ * the flagged steps run.
+ *
+ * Timed effects store the turn they expire on (logic/state/field.hpp), so
+ * a running screen, weather or Perish count costs nothing on the turns in
+ * between: the expiry steps are flagged only on the turn the field's
+ * next_expiry names, and that turn also finds the next one. The pass ends
+ * by moving the turn clock on.
+ */
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "../logic/ops/status.hpp"
+#include "../logic/state/context.hpp"
+#include "ability/dispatch.hpp"
+#include "item/dispatch.hpp"
+#include "item/event_mask.hpp"
+#include "turn_pipeline.hpp"
+#include "util/random.hpp"
+
+namespace dsl::turn {
+
+// ============================================================================
+//                          PENDING RESIDUALS
+// ============================================================================
+
+namespace residual {
+
+// Field residuals
+inline constexpr uint8_t EXPIRY = 1 << 0;   // A timer runs out this turn
+inline constexpr uint8_t WEATHER = 1 << 1;  // Sandstorm or Hail damage
+
+// Slot residuals
+inline constexpr uint16_t INGRAIN = 1 << 0;
+inline constexpr uint16_t ITEMS = 1 << 1;  // Held item handles OnTurnEnd or OnItemCheck
+inline constexpr uint16_t LEECH_SEED = 1 << 2;
+inline constexpr uint16_t POISON = 1 << 3;  // Poison or Toxic
+inline constexpr uint16_t BURN = 1 << 4;
+inline constexpr uint16_t NIGHTMARE = 1 << 5;
+inline constexpr uint16_t CURSE = 1 << 6;
+inline constexpr uint16_t WRAP = 1 << 7;
+inline constexpr uint16_t TIMERS = 1 << 8;  // Disable, Encore, Taunt or Yawn (expiry turns only)
+inline constexpr uint16_t PERISH_SONG = 1 << 9;  // Expiry turns only
+inline constexpr uint16_t ABILITY = 1 << 10;     // Ability handles OnTurnEnd
+
+/// Volatiles with an end-of-turn effect every turn
+inline constexpr uint32_t VOLATILES =
+    logic::state::volatile_flags::INGRAINED | logic::state::volatile_flags::LEECH_SEED |
+    logic::state::volatile_flags::NIGHTMARE | logic::state::volatile_flags::CURSED |
+    logic::state::volatile_flags::WRAPPED;
+
+/// Volatiles whose timer can run out at the end of a turn
+inline constexpr uint32_t TIMED_VOLATILES =
+    logic::state::volatile_flags::DISABLED | logic::state::volatile_flags::ENCORED |
+    logic::state::volatile_flags::TAUNTED | logic::state::volatile_flags::YAWN |
+    logic::state::volatile_flags::PERISH_SONG;
+
+/// Item events the residual pass fires
+inline constexpr uint8_t ITEM_EVENTS = item::EVENT_BIT<item::OnTurnEnd> |
+                                       item::EVENT_BIT<item::OnItemCheck>;
+
+}  // namespace residual
+
+/// Field residuals that could act this turn
+constexpr uint8_t pending_field_residuals(const BattleState& state) {
+    const logic::state::FieldState& field = state.field;
+    uint8_t pending = 0;
+    if (field.next_expiry == field.turn)
+        pending |= residual::EXPIRY;
+    if (field.weather == logic::state::Weather::SANDSTORM ||
+        field.weather == logic::state::Weather::HAIL)
+        pending |= residual::WEATHER;
+    return pending;
+}
+
+/**
+ * @brief Residuals of one slot that could act this turn.
+ *
+ * A fainted mon gets only residual::TIMERS, and only while it still holds
+ * a timed volatile, so that run_slot clears them.
+ *
+ * @param ability_events The slot's ability event mask (BattleState::ability_events())
+ * @param expiring A timer runs out this turn (residual::EXPIRY)
+ */
+constexpr uint16_t pending_slot_residuals(const logic::state::SlotState& slot,
+                                          const logic::state::MonState& mon,
+                                          uint8_t ability_events, bool expiring) {
+    using namespace logic::state::volatile_flags;
+
+    if (mon.is_fainted())
+        return (slot.volatiles & (residual::TIMED_VOLATILES | WRAPPED)) ? residual::TIMERS : 0;
+
+    uint16_t pending = 0;
+    if (ability_events & ability::EVENT_BIT<ability::OnTurnEnd>)
+        pending |= residual::ABILITY;
+    if (slot.item_events & residual::ITEM_EVENTS)
+        pending |= residual::ITEMS;
+    if (mon.is_poisoned())
+        pending |= residual::POISON;
+    if (mon.is_burned())
+        pending |= residual::BURN;
+
+    const uint32_t volatiles =
+        slot.volatiles & (expiring ? residual::VOLATILES | residual::TIMED_VOLATILES
+                                   : residual::VOLATILES);
+    if (volatiles == 0)
+        return pending;
+    if (volatiles & INGRAINED)
+        pending |= residual::INGRAIN;
+    if (volatiles & LEECH_SEED)
+        pending |= residual::LEECH_SEED;
+    if (volatiles & NIGHTMARE)
+        pending |= residual::NIGHTMARE;
+    if (volatiles & CURSED)
+        pending |= residual::CURSE;
+    if (volatiles & WRAPPED)
+        pending |= residual::WRAP;
+    if (volatiles & (DISABLED | ENCORED | TAUNTED | YAWN))
+        pending |= residual::TIMERS;
+    if (volatiles & PERISH_SONG)
+        pending |= residual::PERISH_SONG;
+    return pending;
+}
+
+// ============================================================================
+//                           RESIDUAL STEPS
+// ============================================================================
+
+namespace residual_detail {
+
+/// max_hp / divisor, at least 1 (every Gen III residual fraction)
+constexpr uint16_t fraction(const logic::state::MonState& mon, uint16_t divisor) {
+    const uint16_t amount = mon.max_hp / divisor;
+    return amount == 0 ? 1 : amount;
+}
+
+/// End `timer` if it runs out this turn; true when it did
+inline bool expire(const logic::state::FieldState& field, uint8_t& timer) {
+    if (!field.expires_now(timer))
+        return false;
+    logic::state::assign(timer, uint8_t{0});
+    return true;
+}
+
+/// End a volatile whose timer runs out this turn; true when it did (flag cleared)
+inline bool expire_volatile(const logic::state::FieldState& field, logic::state::SlotState& slot,
+                            uint32_t flag, uint8_t& timer) {
+    if (!slot.has(flag) || !expire(field, timer))
+        return false;
+    slot.clear(flag);
+    return true;
+}
+
+/// Drop every timed volatile of a fainted mon's slot, whatever its turn
+inline void clear_timers(logic::state::SlotState& slot) {
+    slot.clear(residual::TIMED_VOLATILES | logic::state::volatile_flags::WRAPPED);
+    for (uint8_t* timer : {&slot.wrap_expiry, &slot.taunt_expiry, &slot.encore_expiry,
+                           &slot.disable_expiry, &slot.perish_expiry, &slot.yawn_expiry}) {
+        if (*timer != 0)
+            logic::state::assign(*timer, uint8_t{0});
+    }
+    logic::state::assign(slot.disabled_move, uint8_t{0});
+    logic::state::assign(slot.encored_move, uint8_t{0});
+}
+
+inline void expire_screens(BattleState& state) {
+    const logic::state::FieldState& field = state.field;
+    for (logic::state::SideState& side : state.sides) {
+        expire(field, side.reflect_expiry);
+        expire(field, side.light_screen_expiry);
+        expire(field, side.safeguard_expiry);
+        expire(field, side.mist_expiry);
+    }
+}
+
+inline void run_wish([[maybe_unused]] BattleState& state) {
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    logic::state::Wish& wish = state.field.wish;
+    for (uint8_t i = 0; i < MAX_BATTLE_SLOTS; ++i) {
+        if (expire(state.field, wish.expiry[i]) && state.mon(i).is_alive())
+            state.mon(i).heal(wish.hp_to_restore[i]);
+    }
+#endif
+}
+
+/// Weather running out, otherwise Sandstorm / Hail damage in action order
+inline void run_weather(BattleState& state, const uint8_t (&order)[MAX_BATTLE_SLOTS],
+                        uint8_t pending) {
+    logic::state::FieldState& field = state.field;
+
+    // The last turn of a weather deals no damage
+    if ((pending & residual::EXPIRY) && expire(field, field.weather_expiry)) {
+        logic::state::assign(field.weather, logic::state::Weather::NONE);
+        return;
+    }
+    if (!(pending & residual::WEATHER))
+        return;
+
+    const logic::calc::TraitMask immunity = field.weather == logic::state::Weather::SANDSTORM
+                                                ? logic::calc::traits::IMMUNE_SANDSTORM
+                                                : logic::calc::traits::IMMUNE_HAIL;
+    for (const uint8_t slot : order) {
+        logic::state::MonState& mon = state.mon(slot);
+        const ActiveMon& active = state.active(slot);
+        if (mon.is_fainted())
+            continue;
+        // Dig / Dive users would be exempt, but SEMI_INVUL runs Hit (dispatch.hpp
+        // asserts it): no one is underground or underwater at turn end
+        if (!active.has_trait(immunity))
+            mon.apply_damage(fraction(mon, 16));
+    }
+}
+
+inline void run_future_sight([[maybe_unused]] BattleState& state) {
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    logic::state::FutureSight& future_sight = state.field.future_sight;
+    for (uint8_t i = 0; i < MAX_BATTLE_SLOTS; ++i) {
+        if (expire(state.field, future_sight.expiry[i]) && state.mon(i).is_alive())
+            state.mon(i).apply_damage(future_sight.damage[i]);
+    }
+#endif
+}
+
+/// Ingrain through the second item check for one slot
+inline void run_slot(BattleContext& ctx, uint8_t slot_id, uint16_t pending) {
+    using namespace logic::state::volatile_flags;
+    BattleState& state = *ctx.state;
+    logic::state::SlotState& slot = state.slots[slot_id];
+    logic::state::MonState& mon = state.mon(slot_id);
+
+    if (mon.is_fainted()) {
+        clear_timers(slot);
+        return;
+    }
+    util::random::set_draw_actor(slot_id);
+
+    if (pending & residual::INGRAIN)
+        mon.heal(fraction(mon, 16));
+
+    if (pending & residual::ABILITY) {
+        const uint8_t prev_slot = ctx.attacker_slot_id;
+        ctx.attacker_slot_id = slot_id;
+        ability::fire_turn_end(ctx);
+        ctx.attacker_slot_id = prev_slot;
+    }
+
+    if (pending & residual::ITEMS) {
+        fire_turn_end_for_slot(ctx, slot_id);
+        fire_item_check_for_slot(ctx, slot_id);
+    }
+
+    if ((pending & residual::LEECH_SEED) && mon.is_alive()) {
+        // leech_seed_target is the slot that receives the HP
+        const uint8_t seeder = slot.leech_seed_target;
+        if (seeder < MAX_BATTLE_SLOTS && state.mon(seeder).is_alive()) {
+            const uint16_t drained = fraction(mon, 8);
+            mon.apply_damage(drained);
+            state.mon(seeder).heal(drained);
+        }
+    }
+
+    if ((pending & residual::POISON) && mon.is_alive()) {
+        if (mon.status == logic::state::Status::TOXIC) {
+            mon.apply_damage(static_cast<uint16_t>(fraction(mon, 16) * mon.toxic_counter));
+            if (mon.toxic_counter < 15) {
+                logic::state::assign(mon.toxic_counter,
+                                     static_cast<uint8_t>(mon.toxic_counter + 1));
+            }
+        } else {
+            mon.apply_damage(fraction(mon, 8));
+        }
+    }
+
+    if ((pending & residual::BURN) && mon.is_alive())
+        mon.apply_damage(fraction(mon, 8));
+
+    if ((pending & residual::NIGHTMARE) && mon.is_alive()) {
+        if (mon.is_asleep())
+            mon.apply_damage(fraction(mon, 4));
+        else
+            slot.clear(NIGHTMARE);
+    }
+
+    if ((pending & residual::CURSE) && mon.is_alive())
+        mon.apply_damage(fraction(mon, 4));
+
+    // Wrap's last turn frees the target without damage
+    if ((pending & residual::WRAP) && mon.is_alive()) {
+        if (!expire_volatile(state.field, slot, WRAPPED, slot.wrap_expiry))
+            mon.apply_damage(fraction(mon, 16));
+    }
+
+    if ((pending & residual::TIMERS) && mon.is_alive()) {
+        const logic::state::FieldState& field = state.field;
+        if (expire_volatile(field, slot, DISABLED, slot.disable_expiry))
+            logic::state::assign(slot.disabled_move, uint8_t{0});
+        if (expire_volatile(field, slot, ENCORED, slot.encore_expiry))
+            logic::state::assign(slot.encored_move, uint8_t{0});
+        expire_volatile(field, slot, TAUNTED, slot.taunt_expiry);
+        if (expire_volatile(field, slot, YAWN, slot.yawn_expiry) && !mon.has_status() &&
+            !ability::status_blocked(ctx, slot_id, logic::state::Status::SLEEP)) {
+            logic::state::assign(mon.status, logic::state::Status::SLEEP);
+            logic::state::assign(mon.sleep_turns, logic::ops::draw_sleep_turns(*ctx.rng));
+            logic::state::events::emit(logic::state::EventType::STATUS, slot_id,
+                                       static_cast<uint16_t>(logic::state::Status::SLEEP));
+        }
+    }
+
+    // Second item check: a berry whose condition a residual just met
+    if ((pending & residual::ITEMS) && mon.is_alive())
+        fire_item_check_for_slot(ctx, slot_id);
+
+    // A residual that fainted the mon left its timers behind
+    if (mon.is_fainted())
+        clear_timers(slot);
+}
+
+/// Perish Song: faint on the turn the count reaches 0
+inline void run_perish_song(BattleState& state, uint8_t slot_id) {
+    logic::state::SlotState& slot = state.slots[slot_id];
+    logic::state::MonState& mon = state.mon(slot_id);
+    if (!mon.is_alive() || !expire(state.field, slot.perish_expiry))
+        return;
+    mon.apply_damage(mon.current_hp);
+    clear_timers(slot);
+}
+
+/// Soonest running timer after this turn, 0 if none is
+inline uint8_t next_expiry(const BattleState& state) {
+    const logic::state::FieldState& field = state.field;
+    uint8_t soonest = 0;
+    uint8_t soonest_in = 0;
+    const auto consider = [&](uint8_t timer) {
+        const uint8_t in = logic::state::turns_until(field.turn, timer);
+        // 0 is this turn's expiries, already fired
+        if (timer != 0 && in != 0 && (soonest == 0 || in < soonest_in)) {
+            soonest = timer;
+            soonest_in = in;
+        }
+    };
+
+    consider(field.weather_expiry);
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    for (uint8_t i = 0; i < MAX_BATTLE_SLOTS; ++i) {
+        consider(field.future_sight.expiry[i]);
+        consider(field.wish.expiry[i]);
+    }
+#endif
+    for (const logic::state::SideState& side : state.sides) {
+        consider(side.reflect_expiry);
+        consider(side.light_screen_expiry);
+        consider(side.safeguard_expiry);
+        consider(side.mist_expiry);
+    }
+    for (const logic::state::SlotState& slot : state.slots) {
+        consider(slot.wrap_expiry);
+        consider(slot.taunt_expiry);
+        consider(slot.encore_expiry);
+        consider(slot.disable_expiry);
+        consider(slot.perish_expiry);
+        consider(slot.yawn_expiry);
+    }
+    return soonest;
+}
+
+/// Close the turn: find the next expiry if this turn had one, then tick the clock
+inline void advance_turn(BattleState& state, uint8_t pending) {
+    logic::state::FieldState& field = state.field;
+    if (pending & residual::EXPIRY)
+        logic::state::assign(field.next_expiry, next_expiry(state));
+    logic::state::assign(field.turn, logic::state::turn_after(field.turn, 1));
+}
+
+}  // namespace residual_detail
+
+// ============================================================================
+//                            RESIDUAL PASS
+// ============================================================================
+
+/**
+ * @brief Run the turn's end-of-turn residuals and move the turn clock on.
+ *
+ * @param ctx Battle context (attacker ids are restored on return)
+ * @param order Slots in this turn's action order
+ */
+inline void run_residuals(BattleContext& ctx, const uint8_t (&order)[MAX_BATTLE_SLOTS]) {
+    BattleState& state = *ctx.state;
+    const uint8_t field = pending_field_residuals(state);
+    const bool expiring = field & residual::EXPIRY;
+    const uint16_t first = pending_slot_residuals(state.slots[order[0]], state.mon(order[0]),
+                                                  state.ability_events(order[0]), expiring);
+    const uint16_t second = pending_slot_residuals(state.slots[order[1]], state.mon(order[1]),
+                                                   state.ability_events(order[1]), expiring);
+    if ((field | first | second) == 0) {
+        residual_detail::advance_turn(state, field);
+        return;
+    }
+
+    if (expiring) {
+        residual_detail::expire_screens(state);
+        residual_detail::run_wish(state);
+    }
+    if (field)
+        residual_detail::run_weather(state, order, field);
+
+    // Weather can only have taken HP, so the masks still cover the slots
+    if (first)
+        residual_detail::run_slot(ctx, order[0], first);
+    if (second)
+        residual_detail::run_slot(ctx, order[1], second);
+
+    if (expiring)
+        residual_detail::run_future_sight(state);
+
+    if (first & residual::PERISH_SONG)
+        residual_detail::run_perish_song(state, order[0]);
+    if (second & residual::PERISH_SONG)
+        residual_detail::run_perish_song(state, order[1]);
+
+    residual_detail::advance_turn(state, field);
+}
+
+}  // namespace dsl::turn
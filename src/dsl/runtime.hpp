@@ -19,6 +19,7 @@
 #include "domain.hpp"
 #include "meta.hpp"
 #include "stages.hpp"
+#include "trace.hpp"
 
 namespace dsl::rt {
 
@@ -133,6 +134,8 @@ class Pipeline {
         constexpr StageId required = stage_id<typename Cmd::input_stage>::value;
         constexpr StageId output = stage_id<typename Cmd::output_stage>::value;
         assert(stage_leq(required, stage_) && "Stage precondition violated (runtime)");
+        const trace::Span<Cmd> span(*ctx_, static_cast<StageRank>(stage_),
+                                    static_cast<StageRank>(output));
         Cmd::execute(*ctx_);
         stage_ = output;
         return *this;
@@ -151,6 +154,8 @@ class Pipeline {
         constexpr StageId required = stage_id<typename Cmd::input_stage>::value;
         constexpr StageId output = stage_id<typename Cmd::output_stage>::value;
         assert(stage_leq(required, stage_) && "Stage precondition violated (runtime)");
+        const trace::Span<Cmd> span(*ctx_, static_cast<StageRank>(stage_),
+                                    static_cast<StageRank>(output));
         Cmd::execute(*ctx_, static_cast<Args&&>(args)...);
         stage_ = output;
         return *this;
@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file switching.hpp
+ * @brief Bringing a party member into a battle slot.
+ *
+ * The engine decides when a switch happens (a SWITCH action, Baton Pass, a
+ * faint replacement); this performs it.
+ */
+
+#include "../logic/state/context.hpp"
+#include "../logic/state/event_queue.hpp"
+#include "ability/dispatch.hpp"
+#include "format.hpp"
+#include "item/event_mask.hpp"
+
+namespace dsl::turn {
+
+// ============================================================================
+//                               SWITCHING
+// ============================================================================
+//
+// A slot keeps its SlotState and changes only the party member it names
+// (SlotState::party_index). What the outgoing member takes out of battle
+// already lives in its MonState (HP, status, PP); the exceptions are written
+// back here: whether its item was used up, and the toxic counter, which
+// restarts. The slot is then cleared - entirely, or all but what Baton Pass
+// hands over - and loaded with the incoming member's item.
+//
+// ============================================================================
+
+/**
+ * @brief Replace the battler in `slot_id` with party member `member`.
+ *
+ * Foes lose the infatuation and binding the outgoing battler caused, then
+ * the incoming battler's entry ability fires.
+ *
+ * @param ctx Battle context (its battlers are restored afterwards)
+ * @param slot_id Slot switching
+ * @param member Index into the slot's party of a member not in play
+ * @param baton_pass Keep the stages and volatiles Baton Pass transfers
+ */
+inline void switch_in(BattleContext& ctx, uint8_t slot_id, uint8_t member,
+                      bool baton_pass = false) {
+    using namespace logic::state::volatile_flags;
+
+    BattleState& state = *ctx.state;
+    logic::state::SlotState& slot = state.slots[slot_id];
+    logic::state::MonState& outgoing = state.mon(slot_id);
+    logic::state::assign(outgoing.item_consumed, slot.item_consumed);
+    outgoing.reset_toxic_counter();
+
+    if (baton_pass) {
+        slot.clear_for_baton_pass();
+    } else {
+        slot.clear_on_switch();
+    }
+
+    const Party& party = state.party_of(slot_id);
+    const bool consumed = party.mons[member].item_consumed;
+    const types::enums::Item item = party.rentals[member].held_item;
+    logic::state::assign(slot.party_index, member);
+    logic::state::assign(slot.held_item, item);
+    logic::state::assign(slot.item_consumed, consumed);
+    logic::state::assign(slot.item_events,
+                         consumed ? uint8_t{0} : item::item_event_mask(item));
+    slot.mark_speed_dirty();
+
+    for (uint8_t other = 0; other < Singles::SLOTS; ++other) {
+        logic::state::SlotState& foe = state.slots[other];
+        if (other == slot_id)
+            continue;
+        if (foe.has(INFATUATED) && foe.infatuated_with == slot_id)
+            foe.clear(INFATUATED);
+        if (foe.has(WRAPPED | TRAPPED) && foe.trapped_by == slot_id)
+            foe.clear(WRAPPED | TRAPPED);
+    }
+
+    logic::state::events::emit(logic::state::EventType::SWITCH, slot_id, member);
+
+    const uint8_t prev_attacker = ctx.attacker_slot_id;
+    const uint8_t prev_defender = ctx.defender_slot_id;
+    ctx.set_battlers(slot_id, Singles::foe_of(slot_id));
+    ability::fire_switch_in(ctx);
+    ctx.set_battlers(prev_attacker, prev_defender);
+}
+
+}  // namespace dsl::turn
@@ -0,0 +1,202 @@
+#pragma once
+
+/**
+ * @file trace.hpp
+ * @brief Compile-time selected tracer for every Pipeline::run<Cmd>().
+ *
+ * Both pipelines (dsl::Pipeline and dsl::rt::Pipeline) open a trace::Span
+ * around each command. The span forwards to the active Tracer:
+ *
+ *   Tracer::enter(event, ctx)  - before Cmd::execute
+ *   Tracer::exit(event, ctx)   - after Cmd::execute (timestamp - start = duration)
+ *
+ * The active tracer is chosen at compile time with BATTLEMON_TRACER (a type
+ * name), optionally from a header named by BATTLEMON_TRACER_HEADER. The default
+ * NullTracer has `enabled = false`, so the span compiles to nothing and the
+ * pipelines stay zero-cost.
+ *
+ * @code
+ * // -DBATTLEMON_TRACER=::dsl::trace::CountingTracer
+ * for (const auto& entry : dsl::trace::CountingTracer::entries()) { ... }
+ * @endcode
+ */
+
+#include <cstdint>
+#include <string_view>
+
+#include "logic/state/context.hpp"
+#include "stages.hpp"
+#include "util/platform.hpp"
+
+namespace dsl::trace {
+
+// ============================================================================
+//                              TRACE EVENTS
+// ============================================================================
+
+/// Per-command identity; &COMMAND_INFO<Cmd> is the command's type id
+struct CommandInfo {
+    std::string_view name;
+};
+
+/**
+ * @brief Unqualified-as-written type name of T, from the compiler's signature.
+ */
+template <typename T>
+consteval std::string_view type_name() {
+    std::string_view sig = __PRETTY_FUNCTION__;
+    const size_t start = sig.find("T = ") + 4;
+    const size_t end = sig.find_first_of(";]", start);
+    return sig.substr(start, end - start);
+}
+
+template <typename Cmd>
+inline constexpr CommandInfo COMMAND_INFO{type_name<Cmd>()};
+
+struct TraceEvent {
+    const CommandInfo* command;
+    StageRank from;
+    StageRank to;
+    uint32_t start;      // util::platform::cycle_count() on entry
+    uint32_t timestamp;  // Time of this callback (== start in enter())
+};
+
+// ============================================================================
+//                                TRACERS
+// ============================================================================
+
+/// Default tracer: compiled out entirely
+struct NullTracer {
+    static constexpr bool enabled = false;
+
+    static void enter(const TraceEvent&, const BattleContext&) {}
+    static void exit(const TraceEvent&, const BattleContext&) {}
+};
+
+/**
+ * @brief Per-command counters and duration histogram.
+ *
+ * Counts runs per command, runs entered with result.missed already set (work
+ * done after a miss), and a log2 histogram of durations in counter ticks.
+ * Single-threaded by design; the table is thread-local on host.
+ */
+struct CountingTracer {
+    static constexpr bool enabled = true;
+
+    static constexpr uint8_t MAX_COMMANDS = 64;
+    static constexpr uint8_t HISTOGRAM_BINS = 24;  // bin i: [2^i, 2^(i+1)) ticks
+
+    struct Entry {
+        const CommandInfo* command{nullptr};
+        uint32_t runs{0};
+        uint32_t after_miss{0};
+        uint64_t total_ticks{0};
+        uint32_t histogram[HISTOGRAM_BINS]{};
+    };
+
+    static void enter(const TraceEvent& event, const BattleContext& ctx) {
+        Entry* entry = find(event.command);
+        if (!entry)
+            return;
+        ++entry->runs;
+        if (ctx.result.missed)
+            ++entry->after_miss;
+    }
+
+    static void exit(const TraceEvent& event, const BattleContext&) {
+        Entry* entry = find(event.command);
+        if (!entry)
+            return;
+        const uint32_t ticks = event.timestamp - event.start;
+        entry->total_ticks += ticks;
+
+        uint8_t bin = 0;
+        for (uint32_t t = ticks; t > 1 && bin + 1 < HISTOGRAM_BINS; t >>= 1) {
+            ++bin;
+        }
+        ++entry->histogram[bin];
+    }
+
+    /// Recorded commands (first `count()` entries are valid)
+    static const Entry* entries() { return state().entries; }
+    static uint8_t count() { return state().count; }
+
+    static void reset() { state() = State{}; }
+
+   private:
+    struct State {
+        Entry entries[MAX_COMMANDS]{};
+        uint8_t count{0};
+    };
+
+    static State& state() {
+        static BATTLEMON_THREAD_LOCAL State s{};
+        return s;
+    }
+
+    static Entry* find(const CommandInfo* command) {
+        State& s = state();
+        for (uint8_t i = 0; i < s.count; ++i) {
+            if (s.entries[i].command == command)
+                return &s.entries[i];
+        }
+        if (s.count == MAX_COMMANDS)
+            return nullptr;
+        s.entries[s.count].command = command;
+        return &s.entries[s.count++];
+    }
+};
+
+}  // namespace dsl::trace
+
+#ifdef BATTLEMON_TRACER_HEADER
+#include BATTLEMON_TRACER_HEADER
+#endif
+
+#ifndef BATTLEMON_TRACER
+#define BATTLEMON_TRACER ::dsl::trace::NullTracer
+#endif
+
+namespace dsl::trace {
+
+/// The tracer every pipeline reports to
+using Tracer = BATTLEMON_TRACER;
+
+/**
+ * @brief RAII enter/exit around one command run.
+ *
+ * Empty when Tracer::enabled is false; skipped during constant evaluation.
+ */
+template <typename Cmd>
+class Span {
+   public:
+    constexpr Span(const BattleContext& ctx, StageRank from, StageRank to)
+        : ctx_(&ctx), from_(from), to_(to), start_(0) {
+        if constexpr (Tracer::enabled) {
+            if !consteval {
+                start_ = util::platform::cycle_count();
+                Tracer::enter(TraceEvent{&COMMAND_INFO<Cmd>, from_, to_, start_, start_}, *ctx_);
+            }
+        }
+    }
+
+    constexpr ~Span() {
+        if constexpr (Tracer::enabled) {
+            if !consteval {
+                const uint32_t now = util::platform::cycle_count();
+                Tracer::exit(TraceEvent{&COMMAND_INFO<Cmd>, from_, to_, start_, now}, *ctx_);
+            }
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+   private:
+    const BattleContext* ctx_;
+    StageRank from_;
+    StageRank to_;
+    uint32_t start_;
+};
+
+}  // namespace dsl::trace
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "../logic/state/context.hpp"
+#include "ability/dispatch.hpp"
 #include "item/dispatch.hpp"
 #include "stages.hpp"
+#include "util/profile.hpp"
 
 namespace dsl {
 
@@ -10,7 +12,7 @@ namespace dsl {
 //                         STAGE TRANSITIONS
 // ============================================================================
 //
-// Stage transitions fire item events at stage boundaries.
+// Stage transitions fire item and ability events at stage boundaries.
 //
 // The key insight: a stage isn't just a type tag - it's a bundle of:
 //   1. Invariants that now hold (correctness)
@@ -56,6 +58,8 @@ struct StageTransition<Genesis, AccuracyResolved> {
 // ----------------------------------------------------------------------------
 // AccuracyResolved -> DamageCalculated
 // Item hooks: OnPreDamageCalc (Scope Lens, Choice Band, etc.)
+// Ability hooks: OnPreDamageCalc (Huge Power, Blaze), then OnPreDamageTaken
+// (Thick Fat, Levitate, Wonder Guard)
 // ----------------------------------------------------------------------------
 
 template <>
@@ -68,6 +72,7 @@ struct StageTransition<AccuracyResolved, DamageCalculated> {
 
         item::fire_pre_damage_calc(ctx, payload.attack, payload.defense, payload.crit_stage,
                                    payload.power);
+        ability::fire_pre_damage_calc(ctx, payload);
     }
 
     static void execute(BattleContext&) {
@@ -92,6 +97,7 @@ struct StageTransition<DamageCalculated, DamageApplied> {
 // ----------------------------------------------------------------------------
 // DamageApplied -> EffectApplied
 // Item hooks: OnPostDamageApply (Shell Bell, King's Rock)
+// Ability hooks: OnContact (Static, Rough Skin), after the items
 // ----------------------------------------------------------------------------
 
 template <>
@@ -106,24 +112,34 @@ struct StageTransition<DamageApplied, EffectApplied> {
         uint16_t attacker_recoil = 0;
         bool cause_flinch = false;
 
-        bool target_fainted = ctx.defender_mon && ctx.defender_mon->is_fainted();
+        bool target_fainted = ctx.defender_mon() && ctx.defender_mon()->is_fainted();
 
         item::fire_post_damage_apply(ctx, ctx.result.damage, ctx.result.critical, target_fainted,
                                      attacker_heal, attacker_recoil, cause_flinch);
 
         // Apply healing (Shell Bell)
-        if (attacker_heal > 0 && ctx.attacker_mon) {
-            ctx.attacker_mon->heal(attacker_heal);
+        if (attacker_heal > 0 && ctx.attacker_mon()) {
+            logic::state::events::emit(logic::state::EventType::ITEM, ctx.attacker_slot_id,
+                                       static_cast<uint16_t>(ctx.attacker_slot()->held_item));
+            ctx.attacker_mon()->heal(attacker_heal);
         }
 
         // Apply recoil (Life Orb - not in Gen III base but architecture supports)
-        if (attacker_recoil > 0 && ctx.attacker_mon) {
-            ctx.attacker_mon->apply_damage(attacker_recoil);
+        if (attacker_recoil > 0 && ctx.attacker_mon()) {
+            ctx.attacker_mon()->apply_damage(attacker_recoil);
         }
 
         // Set flinch flag (King's Rock)
-        if (cause_flinch && ctx.defender_slot && !target_fainted) {
-            ctx.defender_slot->set(logic::state::volatile_flags::FLINCHED);
+        if (cause_flinch && ctx.defender_slot() && !target_fainted) {
+            logic::state::events::emit(logic::state::EventType::ITEM, ctx.attacker_slot_id,
+                                       static_cast<uint16_t>(ctx.attacker_slot()->held_item));
+            ctx.defender_slot()->set(logic::state::volatile_flags::FLINCHED);
+        }
+
+        // Contact abilities react to hits on the mon, not on its substitute
+        // (approximation: a hit that breaks the substitute still counts)
+        if (ctx.move->flags.makes_contact() && !ctx.defender_has_substitute()) {
+            ability::fire_contact(ctx);
         }
     }
 };
@@ -163,4 +179,50 @@ struct StageTransition<DamageApplied, FaintChecked> {
     static void execute(BattleContext&) {}
 };
 
+// ============================================================================
+//                         PROFILED TRANSITION ENTRY
+// ============================================================================
+
+/// Profiler section a transition is accounted to
+template <typename FromStage, typename ToStage>
+inline constexpr auto TRANSITION_SECTION = util::profile::Section::TRANSITION_OTHER;
+
+template <>
+inline constexpr auto TRANSITION_SECTION<Genesis, AccuracyResolved> =
+    util::profile::Section::TRANSITION_ACCURACY;
+template <>
+inline constexpr auto TRANSITION_SECTION<AccuracyResolved, DamageCalculated> =
+    util::profile::Section::TRANSITION_DAMAGE_CALC;
+template <>
+inline constexpr auto TRANSITION_SECTION<DamageCalculated, DamageApplied> =
+    util::profile::Section::TRANSITION_DAMAGE_APPLY;
+template <>
+inline constexpr auto TRANSITION_SECTION<DamageApplied, EffectApplied> =
+    util::profile::Section::TRANSITION_EFFECT;
+template <>
+inline constexpr auto TRANSITION_SECTION<Genesis, EffectApplied> =
+    util::profile::Section::TRANSITION_EFFECT;
+template <>
+inline constexpr auto TRANSITION_SECTION<EffectApplied, FaintChecked> =
+    util::profile::Section::TRANSITION_FAINT;
+template <>
+inline constexpr auto TRANSITION_SECTION<Genesis, FaintChecked> =
+    util::profile::Section::TRANSITION_FAINT;
+template <>
+inline constexpr auto TRANSITION_SECTION<DamageApplied, FaintChecked> =
+    util::profile::Section::TRANSITION_FAINT;
+template <>
+inline constexpr auto TRANSITION_SECTION<FaintChecked, Terminus> =
+    util::profile::Section::TRANSITION_TERMINUS;
+template <>
+inline constexpr auto TRANSITION_SECTION<Genesis, Terminus> =
+    util::profile::Section::TRANSITION_TERMINUS;
+
+/// Run StageTransition<FromStage, ToStage>::execute (timed in profiling builds)
+template <typename FromStage, typename ToStage, typename... Payload>
+inline void run_transition(BattleContext& ctx, Payload&... payload) {
+    BATTLEMON_PROFILE_SCOPE((TRANSITION_SECTION<FromStage, ToStage>));
+    StageTransition<FromStage, ToStage>::execute(ctx, payload...);
+}
+
 }  // namespace dsl
@@ -65,21 +65,17 @@ inline void fire_end_of_turn_events(BattleContext& ctx, uint16_t& heal_amount,
  * Convenience wrapper that sets up context and fires events.
  *
  * @param ctx Battle context
- * @param slot_state Slot to check item for
+ * @param slot_id Slot to check item for
  * @param[out] priority_boost Set true if item grants priority
  */
-inline void fire_turn_start_for_slot(BattleContext& ctx, logic::state::SlotState* slot_state,
-                                     bool& priority_boost) {
-    if (!slot_state)
-        return;
-
-    // Temporarily set attacker_slot for the check
-    auto* prev_slot = ctx.attacker_slot;
-    ctx.attacker_slot = slot_state;
+inline void fire_turn_start_for_slot(BattleContext& ctx, uint8_t slot_id, bool& priority_boost) {
+    // Temporarily make the slot the attacker for the check
+    const uint8_t prev_slot = ctx.attacker_slot_id;
+    ctx.attacker_slot_id = slot_id;
 
     fire_priority_events(ctx, priority_boost);
 
-    ctx.attacker_slot = prev_slot;
+    ctx.attacker_slot_id = prev_slot;
 }
 
 /**
@@ -88,21 +84,16 @@ inline void fire_turn_start_for_slot(BattleContext& ctx, logic::state::SlotState
  * Convenience wrapper that sets up context and fires events.
  *
  * @param ctx Battle context
- * @param slot_state Slot to check item for
- * @param mon_state Mon state for HP operations
+ * @param slot_id Slot to check item for (its mon takes the HP changes)
  */
-inline void fire_turn_end_for_slot(BattleContext& ctx, logic::state::SlotState* slot_state,
-                                   logic::state::MonState* mon_state) {
-    if (!slot_state || !mon_state)
-        return;
+inline void fire_turn_end_for_slot(BattleContext& ctx, uint8_t slot_id) {
+    logic::state::MonState* mon_state = ctx.mon(slot_id);
     if (mon_state->is_fainted())
         return;
 
-    // Temporarily set context for the check
-    auto* prev_slot = ctx.attacker_slot;
-    auto* prev_mon = ctx.attacker_mon;
-    ctx.attacker_slot = slot_state;
-    ctx.attacker_mon = mon_state;
+    // Temporarily make the slot the attacker for the check
+    const uint8_t prev_slot = ctx.attacker_slot_id;
+    ctx.attacker_slot_id = slot_id;
 
     uint16_t heal = 0;
     uint16_t damage = 0;
@@ -112,18 +103,37 @@ inline void fire_turn_end_for_slot(BattleContext& ctx, logic::state::SlotState*
     // Apply effects
     if (heal > 0) {
         // Calculate heal based on max_hp for Leftovers (1/16)
-        uint16_t actual_heal = mon_state->max_hp / 16;
-        if (actual_heal == 0)
-            actual_heal = 1;
-        mon_state->heal(actual_heal);
+        using Leftovers = item::ItemHandler<types::enums::Item::LEFTOVERS, item::OnTurnEnd>;
+        logic::state::events::emit(logic::state::EventType::ITEM, slot_id,
+                                   static_cast<uint16_t>(ctx.slot(slot_id)->held_item));
+        mon_state->heal(Leftovers::heal_amount(mon_state->max_hp));
     }
 
     if (damage > 0) {
         mon_state->apply_damage(damage);
     }
 
-    ctx.attacker_slot = prev_slot;
-    ctx.attacker_mon = prev_mon;
+    ctx.attacker_slot_id = prev_slot;
+}
+
+/**
+ * @brief Fire item checks (berries) for a specific slot.
+ *
+ * Called after each move for both battlers and at the end of the turn.
+ *
+ * @param ctx Battle context
+ * @param slot_id Slot to check item for
+ */
+inline void fire_item_check_for_slot(BattleContext& ctx, uint8_t slot_id) {
+    if (ctx.mon(slot_id)->is_fainted())
+        return;
+
+    const uint8_t prev_slot = ctx.attacker_slot_id;
+    ctx.attacker_slot_id = slot_id;
+
+    item::fire_item_check(ctx);
+
+    ctx.attacker_slot_id = prev_slot;
 }
 
 }  // namespace dsl::turn
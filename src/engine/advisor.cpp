@@ -0,0 +1,141 @@
+#include "advisor.hpp"
+
+#include <cstring>
+
+#include "util/platform.hpp"
+
+namespace engine::factory {
+
+bool Advisor::load(const char* prefix) {
+    part_count_ = 0;
+    rental_count_ = 0;
+    ratings_ = nullptr;
+
+    char name[9];
+    size_t prefix_length = std::strlen(prefix);
+    if (prefix_length > 7)
+        prefix_length = 7;
+    std::memcpy(name, prefix, prefix_length);
+    name[prefix_length + 1] = '\0';
+
+    uint8_t expected_parts = 1;
+    uint16_t next_row = 0;
+    for (uint8_t p = 0; p < expected_parts; ++p) {
+        name[prefix_length] = static_cast<char>('0' + p);
+        size_t size = 0;
+        const auto* bytes = static_cast<const uint8_t*>(util::platform::map_appvar(name, size));
+        if (!bytes || size < sizeof(AdvisorPartHeader))
+            return false;
+
+        AdvisorPartHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, ADVISOR_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != ADVISOR_VERSION || header.part != p || header.first_row != next_row)
+            return false;
+        if (p == 0) {
+            expected_parts = header.part_count;
+            rental_count_ = header.rental_count;
+            if (expected_parts == 0 || expected_parts > ADVISOR_MAX_PARTS)
+                return false;
+        } else if (header.part_count != expected_parts || header.rental_count != rental_count_) {
+            return false;
+        }
+
+        const uint8_t* rows = bytes + sizeof(header);
+        uint32_t payload = 0;
+        if (p == 0) {
+            ratings_ = rows;
+            rows += rental_count_;
+            payload = rental_count_;
+        }
+        const uint16_t end_row = static_cast<uint16_t>(header.first_row + header.row_count);
+        payload += advisor_row_offset(end_row, rental_count_) -
+                   advisor_row_offset(header.first_row, rental_count_);
+        if (end_row > rental_count_ || size < sizeof(header) + payload)
+            return false;
+
+        parts_[p] = Part{rows, header.first_row, end_row};
+        next_row = end_row;
+    }
+
+    if (next_row != rental_count_) {
+        rental_count_ = 0;
+        return false;
+    }
+    part_count_ = expected_parts;
+    return true;
+}
+
+uint8_t Advisor::matchup(uint16_t mine, uint16_t theirs) const {
+    if (mine == theirs)
+        return ADVISOR_EVEN;
+    const bool flipped = mine > theirs;
+    const uint16_t row = flipped ? theirs : mine;
+    const uint16_t column = flipped ? mine : theirs;
+
+    for (uint8_t p = 0; p < part_count_; ++p) {
+        const Part& part = parts_[p];
+        if (row < part.end_row) {
+            const uint32_t offset = advisor_row_offset(row, rental_count_) -
+                                    advisor_row_offset(part.first_row, rental_count_) +
+                                    (column - row - 1);
+            const uint8_t q = part.rows[offset];
+            return flipped ? static_cast<uint8_t>(255 - q) : q;
+        }
+    }
+    return ADVISOR_EVEN;
+}
+
+uint16_t Advisor::team_score(const Team& team, const uint16_t* revealed,
+                             uint8_t revealed_count) const {
+    uint16_t score = 0;
+    for (const uint16_t member : team) {
+        if (revealed_count == 0) {
+            score = static_cast<uint16_t>(score + ratings_[member]);
+            continue;
+        }
+        for (uint8_t r = 0; r < revealed_count; ++r) {
+            score = static_cast<uint16_t>(score + matchup(member, revealed[r]));
+        }
+    }
+    return score;
+}
+
+Team Advisor::best_draft(const Pool& pool, const uint16_t* revealed,
+                         uint8_t revealed_count) const {
+    Team best{pool[0], pool[1], pool[2]};
+    uint16_t best_score = 0;
+    for (uint8_t a = 0; a < POOL_SIZE; ++a) {
+        for (uint8_t b = a + 1; b < POOL_SIZE; ++b) {
+            for (uint8_t c = b + 1; c < POOL_SIZE; ++c) {
+                const Team team{pool[a], pool[b], pool[c]};
+                const uint16_t score = team_score(team, revealed, revealed_count);
+                if (score > best_score) {
+                    best = team;
+                    best_score = score;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+SwapChoice Advisor::best_swap(const Team& team, const Team& opponent, const uint16_t* revealed,
+                              uint8_t revealed_count) const {
+    SwapChoice best{};
+    uint16_t best_score = team_score(team, revealed, revealed_count);
+    for (int8_t own = 0; own < TEAM_SIZE; ++own) {
+        for (int8_t theirs = 0; theirs < TEAM_SIZE; ++theirs) {
+            Team swapped = team;
+            swapped[own] = opponent[theirs];
+            const uint16_t score = team_score(swapped, revealed, revealed_count);
+            if (score > best_score) {
+                best = SwapChoice{own, theirs};
+                best_score = score;
+            }
+        }
+    }
+    return best;
+}
+
+}  // namespace engine::factory
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::factory {
+
+// ============================================================================
+//                            FACTORY ADVISOR
+// ============================================================================
+//
+// Draft and swap recommendations from a precomputed matchup table, cheap
+// enough for the calculator's draft and swap screens: scoring a team is a
+// handful of byte loads, never a simulation.
+//
+// The table is the side-averaged rental x rental win probability of a
+// matchup matrix (host/engine/matchup_matrix.hpp), quantized to 8 bits:
+//
+//   q(i, j) = round(255 * (win(i as p1, j) + 1 - win(j as p1, i)) / 2)
+//
+// so q(j, i) = 255 - q(i, j) and only the upper triangle (i < j) is stored,
+// row by row: 388,521 bytes for 882 rentals. An AppVar holds at most ~64 KB,
+// so the rows are split across AppVars "<prefix>0", "<prefix>1", ... in
+// whole rows. Part 0 also stores each rental's rating (its mean q against
+// every rental) for when no opponent has been revealed yet. The parts are
+// read in place from the archive (util::platform::map_appvar()); nothing is
+// copied to RAM.
+//
+// All multi-byte fields are little-endian.
+//
+// ============================================================================
+
+inline constexpr uint8_t POOL_SIZE = 6;
+inline constexpr uint8_t TEAM_SIZE = 3;
+inline constexpr uint8_t BATTLES_PER_ROUND = 7;
+
+/// Rental indices into data::g_RENTAL_SETS
+using Team = std::array<uint16_t, TEAM_SIZE>;
+using Pool = std::array<uint16_t, POOL_SIZE>;
+
+/// One team member for one of the beaten trainer's rentals (or no swap)
+struct SwapChoice {
+    int8_t own{-1};     // Team slot to give up, -1 = keep the team
+    int8_t theirs{-1};  // Opponent slot to take
+
+    [[nodiscard]] bool none() const { return own < 0 || theirs < 0; }
+};
+
+inline constexpr char ADVISOR_MAGIC[4] = {'B', 'M', 'A', 'V'};
+inline constexpr uint8_t ADVISOR_VERSION = 1;
+inline constexpr const char* ADVISOR_APPVAR_PREFIX = "BMAV";
+inline constexpr uint8_t ADVISOR_MAX_PARTS = 10;  // Single-digit suffixes
+
+/// Data bytes per AppVar (the OS limit is 65,505)
+inline constexpr uint32_t ADVISOR_PART_BYTES = 65000;
+
+/// Quantized even matchup (q(i, i))
+inline constexpr uint8_t ADVISOR_EVEN = 128;
+
+struct AdvisorPartHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t part;
+    uint8_t part_count;
+    uint8_t reserved0;
+    uint16_t rental_count;
+    uint16_t first_row;  // Rows [first_row, first_row + row_count) of the triangle
+    uint16_t row_count;
+    uint16_t reserved1;
+};
+
+static_assert(sizeof(AdvisorPartHeader) == 16, "advisor header is part of the AppVar format");
+
+/// Offset of row i's first entry (j = i + 1) in the packed upper triangle
+constexpr uint32_t advisor_row_offset(uint32_t row, uint32_t rental_count) {
+    return row * (2 * rental_count - row - 1) / 2;
+}
+
+class Advisor {
+   public:
+    /**
+     * @brief Find and validate the table's AppVars.
+     *
+     * @param prefix AppVar name prefix (at most 7 characters)
+     *
+     * @return false if a part is missing, malformed, or parts disagree
+     */
+    bool load(const char* prefix = ADVISOR_APPVAR_PREFIX);
+
+    [[nodiscard]] bool loaded() const { return part_count_ != 0; }
+    [[nodiscard]] uint16_t rental_count() const { return rental_count_; }
+
+    /// Quantized probability that `mine` beats `theirs` (0-255, 128 = even)
+    [[nodiscard]] uint8_t matchup(uint16_t mine, uint16_t theirs) const;
+
+    /// Mean matchup of `rental` against every rental (0-255)
+    [[nodiscard]] uint8_t rating(uint16_t rental) const { return ratings_[rental]; }
+
+    /**
+     * @brief Score of a team against the opponent's revealed rentals.
+     *
+     * Sum of every (member, revealed) matchup; with nothing revealed, the
+     * sum of the members' ratings. Higher is better; scores are comparable
+     * between teams for the same revealed set.
+     */
+    [[nodiscard]] uint16_t team_score(const Team& team, const uint16_t* revealed,
+                                      uint8_t revealed_count) const;
+
+    /// Best of the 20 teams that can be drafted from `pool`
+    [[nodiscard]] Team best_draft(const Pool& pool, const uint16_t* revealed = nullptr,
+                                  uint8_t revealed_count = 0) const;
+
+    /**
+     * @brief Best swap (or none) after beating `opponent`.
+     *
+     * Compares keeping the team with each of the 9 single swaps.
+     */
+    [[nodiscard]] SwapChoice best_swap(const Team& team, const Team& opponent,
+                                       const uint16_t* revealed = nullptr,
+                                       uint8_t revealed_count = 0) const;
+
+   private:
+    struct Part {
+        const uint8_t* rows;  // Triangle bytes from row first_row on
+        uint16_t first_row;
+        uint16_t end_row;
+    };
+
+    Part parts_[ADVISOR_MAX_PARTS]{};
+    const uint8_t* ratings_{nullptr};
+    uint16_t rental_count_{0};
+    uint8_t part_count_{0};
+};
+
+}  // namespace engine::factory
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <cstdint>
+
+#include "battle.hpp"
+#include "battle_log.hpp"
+#include "eval.hpp"
+#include "opening_book.hpp"
+#include "outcomes.hpp"
+#include "policy.hpp"
+#include "transposition.hpp"
+#include "util/platform.hpp"
+#include "util/random.hpp"
+
+namespace engine::ai {
+
+// ============================================================================
+//                              SEARCH AI
+// ============================================================================
+//
+// Depth-limited expectiminimax over whole turns. Both sides choose at once,
+// so a decision node is scored pessimistically: the searching side picks
+// the action whose worst opponent reply is best (max over own actions of
+// min over replies), with replies pruned once they cannot change the max.
+// Actions are every legal move and switch (candidate_actions()), so in a
+// party battle the search weighs switching out as well as attacking; each
+// benched member widens both sides' branching by one.
+//
+// Each (own action, reply) pair is a chance node over the battle RNG's
+// draws (accuracy, crits, the damage roll, Quick Claw, the speed tie).
+// By default the node executes the turn on `chance_samples` RNG streams and
+// averages the results. The streams are seeded from the state hash, which
+// makes a node's value a function of the state alone: sibling actions face
+// the same rolls (less noise when comparing them) and the transposition
+// table can return a stored value for any path that reaches the state.
+// With `exact_chance` the node instead walks every outcome of the turn
+// (outcomes.hpp) and weights each by its probability: no sampling noise,
+// but a turn has tens to hundreds of outcomes, so it suits 1-2 turn searches.
+//
+// Memory is fixed: one engine copy, one snapshot per ply and the caller's
+// table, about 6 KB with CalcTranspositionTable. Search runs by iterative
+// deepening, so the time and node budgets cut it off cleanly and the result
+// is the best action of the deepest completed iteration.
+//
+// ============================================================================
+
+inline constexpr uint8_t MAX_SEARCH_DEPTH = 4;
+
+/// Score of a won battle (plus remaining depth: sooner wins score higher)
+inline constexpr int16_t WIN_SCORE = 30000;
+
+static_assert(EVAL_MAX_SCORE < WIN_SCORE, "a static score must never look like a win");
+
+/// Keeps side 0 and side 1 searches of one state apart in a shared table
+inline constexpr uint64_t SIDE_KEY = 0x9e3779b97f4a7c15ULL;
+
+struct SearchLimits {
+    uint8_t max_depth{2};                    // Turns to look ahead (1..MAX_SEARCH_DEPTH)
+    uint8_t chance_samples{3};               // RNG streams per (action, reply) pair
+    uint32_t time_budget_ms{0};              // 0 = unlimited (needs the cycle counter running)
+    uint32_t node_budget{0};                 // Turns executed, 0 = unlimited
+    bool exact_chance{false};                // Enumerate chance outcomes instead of sampling
+    const EvalWeights* weights{nullptr};     // Leaf weights (nullptr = DEFAULT_EVAL_WEIGHTS)
+    const book::OpeningBook* book{nullptr};  // Turn-1 lookups (nullptr = always search)
+};
+
+struct SearchResult {
+    BattleAction action{};
+    int16_t value{0};   // Score of action from the searching side's view
+    uint8_t depth{0};   // Deepest completed iteration (0 = none: fallback action)
+    uint32_t nodes{0};  // Turns executed
+};
+
+// ============================================================================
+//                               SEARCHER
+// ============================================================================
+
+/// A side's moves plus a switch to each other party member
+inline constexpr uint8_t MAX_CANDIDATE_ACTIONS = 4 + dsl::MAX_PARTY_SIZE - 1;
+
+/// Up to MAX_CANDIDATE_ACTIONS candidate actions of one side
+struct ActionList {
+    BattleAction actions[MAX_CANDIDATE_ACTIONS];
+    uint8_t count{0};
+};
+
+/// Legal actions of `side`, moves first, then switches; never empty (falls
+/// back to slot 0 like the policies)
+inline ActionList candidate_actions(const BattleEngine& battle, uint8_t side) {
+    ActionList list;
+    for_each_action(battle.legal_actions(side),
+                    [&](const BattleAction& action) { list.actions[list.count++] = action; });
+    if (list.count == 0) {
+        list.actions[0] = BattleAction::move(0);
+        list.count = 1;
+    }
+    return list;
+}
+
+/// Search `action` first (a transposition table hint); no-op if it is not in the list
+inline void move_to_front(ActionList& list, const BattleAction& action) {
+    for (uint8_t i = 1; i < list.count; ++i) {
+        if (list.actions[i].type == action.type && list.actions[i].index == action.index) {
+            const BattleAction first = list.actions[0];
+            list.actions[0] = list.actions[i];
+            list.actions[i] = first;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Expectiminimax search over a transposition table.
+ *
+ * @tparam Table TranspositionTable<N> or the host SharedTranspositionTable
+ */
+template <typename Table>
+class Searcher {
+   public:
+    Searcher(Table& table, const SearchLimits& limits) : table_(table), limits_(limits) {
+        if (limits_.max_depth > MAX_SEARCH_DEPTH)
+            limits_.max_depth = MAX_SEARCH_DEPTH;
+        if (limits_.chance_samples == 0)
+            limits_.chance_samples = 1;
+        if (limits_.weights == nullptr)
+            limits_.weights = &DEFAULT_EVAL_WEIGHTS;
+    }
+
+    /**
+     * @brief Choose `side`'s action for the coming turn.
+     *
+     * @param battle Battle to decide in (not modified)
+     * @param side 0 = player 1, 1 = player 2
+     */
+    SearchResult search(const BattleEngine& battle, uint8_t side) {
+        book::BookMove booked;
+        if (limits_.book && limits_.book->probe(battle, side, booked))
+            return SearchResult{booked.action, booked.value, booked.depth, 0};
+
+        table_.new_search();
+        begin(battle, side);
+
+        SearchResult result{candidate_actions(battle, side).actions[0], 0, 0, 0};
+        for (uint8_t depth = 1; depth <= limits_.max_depth; ++depth) {
+            int16_t value;
+            BattleAction best;
+            if (!node_value(depth, value, &best))
+                break;
+            result.action = best;
+            result.value = value;
+            result.depth = depth;
+        }
+        result.nodes = nodes_;
+        return result;
+    }
+
+    // ========================================================================
+    //                  STEPWISE INTERFACE (parallel drivers)
+    // ========================================================================
+
+    /// Take a private copy of `battle` and restart the budgets
+    void begin(const BattleEngine& battle, uint8_t side) {
+        battle_ = battle;
+        side_ = side;
+        nodes_ = 0;
+        aborted_ = false;
+        eval_cache_.clear();
+        elapsed_ = 0;
+        last_tick_ = util::platform::cycle_count();
+        deadline_ = static_cast<uint64_t>(limits_.time_budget_ms) *
+                    (util::platform::cycle_counter_hz() / 1000);
+    }
+
+    /**
+     * @brief Score one (own action, reply) pair of the root searching `depth` turns.
+     *
+     * @return false if a budget ran out (value not set)
+     */
+    bool pair_value(const BattleAction& mine, const BattleAction& theirs, uint8_t depth,
+                    int16_t& value) {
+        const uint64_t node_hash = battle_.hash();
+        snapshots_[depth] = battle_.save();
+        return chance_value(mine, theirs, depth, node_hash, value);
+    }
+
+    [[nodiscard]] uint32_t nodes() const { return nodes_; }
+    [[nodiscard]] const SearchLimits& limits() const { return limits_; }
+
+   private:
+    /**
+     * @brief Value of the current state searched `depth` turns deep.
+     *
+     * @param[out] best Best own action (only at decision nodes)
+     */
+    bool node_value(uint8_t depth, int16_t& value, BattleAction* best = nullptr) {
+        const BattleResult result = battle_.result();
+        if (result != BattleResult::ONGOING) {
+            const bool won = static_cast<uint8_t>(result) == side_;
+            value = static_cast<int16_t>(won ? WIN_SCORE + depth : -(WIN_SCORE + depth));
+            return true;
+        }
+        replace_fainted(battle_);  // Undone when the parent restores its snapshot
+        if (depth == 0) {
+            value = evaluate(battle_.state(), side_, *limits_.weights, &eval_cache_);
+            return true;
+        }
+
+        const uint64_t node_hash = battle_.hash();
+        const uint64_t key = side_ ? node_hash ^ SIDE_KEY : node_hash;
+
+        ActionList mine = candidate_actions(battle_, side_);
+        TTData cached;
+        if (table_.probe(key, cached)) {
+            BattleAction hint;
+            const bool has_hint = cached.best_action(hint);
+            if (cached.depth >= depth && cached.bound == TTBound::EXACT && has_hint) {
+                value = cached.value;
+                if (best)
+                    *best = hint;
+                return true;
+            }
+            if (has_hint)
+                move_to_front(mine, hint);
+        }
+        const ActionList theirs = candidate_actions(battle_, static_cast<uint8_t>(side_ ^ 1));
+
+        snapshots_[depth] = battle_.save();
+        int16_t best_value = INT16_MIN;
+        BattleAction best_action = mine.actions[0];
+        for (uint8_t i = 0; i < mine.count; ++i) {
+            int16_t worst = INT16_MAX;
+            for (uint8_t j = 0; j < theirs.count && worst > best_value; ++j) {
+                int16_t reply;
+                if (!chance_value(mine.actions[i], theirs.actions[j], depth, node_hash, reply))
+                    return false;
+                if (reply < worst)
+                    worst = reply;
+            }
+            if (worst > best_value) {
+                best_value = worst;
+                best_action = mine.actions[i];
+            }
+        }
+
+        table_.store(key, TTData{best_value, depth, TTBound::EXACT, encode_action(best_action)});
+        value = best_value;
+        if (best)
+            *best = best_action;
+        return true;
+    }
+
+    /// Expected value of executing (mine, theirs): sampled or enumerated
+    bool chance_value(const BattleAction& mine, const BattleAction& theirs, uint8_t depth,
+                      uint64_t node_hash, int16_t& value) {
+        const BattleSnapshot& node = snapshots_[depth];
+        const BattleAction& p1_action = side_ == 0 ? mine : theirs;
+        const BattleAction& p2_action = side_ == 0 ? theirs : mine;
+        const auto child_depth = static_cast<uint8_t>(depth - 1);
+
+        if (limits_.exact_chance) {
+            int64_t weighted = 0;
+            int64_t total = 0;
+            const bool ok = for_each_outcome(
+                battle_, node, p1_action, p2_action, [&](BattleEngine&, Probability probability) {
+                    ++nodes_;
+                    int16_t child;
+                    if (out_of_budget() || !node_value(child_depth, child))
+                        return false;
+                    weighted += static_cast<int64_t>(probability) * child;
+                    total += probability;
+                    return true;
+                });
+            if (!ok)
+                return false;
+            value = static_cast<int16_t>(total ? weighted / total : 0);
+            return true;
+        }
+
+        int32_t sum = 0;
+        for (uint8_t k = 0; k < limits_.chance_samples; ++k) {
+            battle_.rng().seed(node_hash, k);
+            battle_.execute_turn(p1_action, p2_action);
+            ++nodes_;
+
+            int16_t child;
+            const bool ok = !out_of_budget() && node_value(child_depth, child);
+            battle_.restore(node);
+            if (!ok)
+                return false;
+            sum += child;
+        }
+        value = static_cast<int16_t>(sum / limits_.chance_samples);
+        return true;
+    }
+
+    bool out_of_budget() {
+        if (aborted_)
+            return true;
+        if (limits_.node_budget && nodes_ >= limits_.node_budget) {
+            aborted_ = true;
+        } else if (deadline_ && (nodes_ & 15) == 0) {
+            // Accumulate deltas: the 32-bit counter wraps every few seconds on host
+            const uint32_t now = util::platform::cycle_count();
+            elapsed_ += now - last_tick_;
+            last_tick_ = now;
+            aborted_ = elapsed_ >= deadline_;
+        }
+        return aborted_;
+    }
+
+    Table& table_;
+    SearchLimits limits_;
+
+    BattleEngine battle_{};
+    BattleSnapshot snapshots_[MAX_SEARCH_DEPTH + 1]{};
+    EvalCache eval_cache_{};
+    uint8_t side_{0};
+
+    uint32_t nodes_{0};
+    bool aborted_{false};
+    uint32_t last_tick_{0};
+    uint64_t elapsed_{0};
+    uint64_t deadline_{0};  // Ticks, 0 = no time budget
+};
+
+// ============================================================================
+//                              SEARCH POLICY
+// ============================================================================
+
+/**
+ * @brief Policy adaptor: search with default limits on a per-thread 4 KB table.
+ *
+ * Deterministic in the battle state alone; the policy RNG is not used.
+ */
+inline BattleAction search_policy(const BattleEngine& battle, uint8_t side, util::random::Rng&) {
+    static BATTLEMON_THREAD_LOCAL CalcTranspositionTable table{};
+    static BATTLEMON_THREAD_LOCAL Searcher<CalcTranspositionTable> searcher(table, SearchLimits{});
+    return searcher.search(battle, side).action;
+}
+
+}  // namespace engine::ai
@@ -1,37 +1,325 @@
 #include "battle.hpp"
 
+#include <cstring>
+
+#include "battle_log.hpp"
 #include "data/move.hpp"
+#include "data/rental_packed.hpp"
 #include "dispatch.hpp"
+#include "dsl/ability/dispatch.hpp"
+#include "dsl/format.hpp"
+#include "dsl/residual.hpp"
+#include "dsl/switching.hpp"
 #include "dsl/turn_pipeline.hpp"
 #include "logic/calc/speed.hpp"
-#include "util/random.hpp"
+#include "logic/state/hash_layout.hpp"
+#include "util/profile.hpp"
 
 namespace engine {
 
+// ============================================================================
+//                          LEGAL ACTIONS
+// ============================================================================
+
+namespace {
+
+/// Switches go before any move (Gen III move priorities are -6 to +5)
+constexpr int8_t SWITCH_PRIORITY = 6;
+
+/// Switch bits of every living member of `party` other than `active`
+ActionMask switch_mask(const dsl::Party& party, uint8_t active) {
+    ActionMask mask = 0;
+    if (party.size == 1)
+        return mask;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        if (i != active && party.mons[i].is_alive())
+            mask = static_cast<ActionMask>(mask | (1u << (ACTION_SWITCH_BIT + i)));
+    }
+    return mask;
+}
+
+}  // namespace
+
+ActionMask legal_action_mask(const dsl::BattleState& state, uint8_t slot) {
+    using namespace logic::state::volatile_flags;
+    const types::Rental& rental = state.rental(slot);
+    const logic::state::SlotState& battler = state.slots[slot];
+    const logic::state::MonState& mon = state.mon(slot);
+    const ActionMask switches = switch_mask(state.party_of(slot), battler.party_index);
+    if (mon.is_fainted())
+        return switches;
+
+    // A lock allows one move (stored like last_move_used; 0 = no lock)
+    uint8_t locked = 0;
+    if (battler.has(CHARGING)) {
+        locked = battler.last_move_used;
+    } else if (battler.has(ENCORED)) {
+        locked = battler.encored_move;
+    } else if (battler.held_item == types::enums::Item::CHOICE_BAND && !battler.item_consumed) {
+        locked = battler.last_move_used;
+    }
+
+    ActionMask mask = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+        const types::enums::Move move = rental.moves[i];
+        if (move == types::enums::Move::NONE || (mon.pp[i] == 0 && !battler.has(CHARGING)))
+            continue;
+        const auto id = static_cast<uint8_t>(move);
+        if (locked != 0 && id != locked)
+            continue;
+        if (battler.has(DISABLED) && id == battler.disabled_move)
+            continue;
+        if (battler.has(TAUNTED) && data::g_MOVE_HOT[static_cast<size_t>(move)].power == 0)
+            continue;
+        mask = static_cast<ActionMask>(mask | (1u << i));
+    }
+    if (!battler.has(WRAPPED | TRAPPED | INGRAINED))
+        mask = static_cast<ActionMask>(mask | switches);
+    return mask;
+}
+
 // ============================================================================
 //                         INITIALIZATION
 // ============================================================================
 
+void BattleEngine::init(uint16_t p1_rental, uint16_t p2_rental, uint8_t level,
+                        const util::random::Rng& rng) {
+    reset(level, rng);
+    add_member(0, data::rental(p1_rental), logic::setup::setup_rental(p1_rental, level),
+               p1_rental);
+    add_member(1, data::rental(p2_rental), logic::setup::setup_rental(p2_rental, level),
+               p2_rental);
+    begin();
+    if (log_) {
+        attach_log(log_);
+    }
+}
+
+void BattleEngine::init(uint16_t p1_rental, uint16_t p2_rental, uint8_t level, uint32_t seed) {
+    util::random::Rng rng{};
+    rng.seed(seed);
+    init(p1_rental, p2_rental, level, rng);
+}
+
+void BattleEngine::init(const types::Rental& p1_rental, const types::Rental& p2_rental,
+                        uint8_t level, uint32_t seed) {
+    util::random::Rng rng{};
+    rng.seed(seed);
+    init(p1_rental, p2_rental, level, rng);
+}
+
 void BattleEngine::init(const types::Rental& p1_rental, const types::Rental& p2_rental,
-                        uint8_t level) {
-    level_ = level;
-    p1_rental_ = &p1_rental;
-    p2_rental_ = &p2_rental;
+                        uint8_t level, const util::random::Rng& rng) {
+    reset(level, rng);
+    add_member(0, p1_rental, logic::setup::setup_rental(p1_rental, level), CUSTOM_RENTAL);
+    add_member(1, p2_rental, logic::setup::setup_rental(p2_rental, level), CUSTOM_RENTAL);
+    begin();
+    if (log_) {
+        attach_log(log_);
+    }
+}
 
-    p1_setup_ = logic::setup::setup_rental(p1_rental, level);
-    p2_setup_ = logic::setup::setup_rental(p2_rental, level);
+void BattleEngine::init(const PartyRentals& p1_party, const PartyRentals& p2_party,
+                        uint8_t level, const util::random::Rng& rng) {
+    reset(level, rng);
+    const PartyRentals* parties[] = {&p1_party, &p2_party};
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        for (uint8_t i = 0; i < parties[side]->size; ++i) {
+            const uint16_t index = parties[side]->rentals[i];
+            add_member(side, data::rental(index), logic::setup::setup_rental(index, level),
+                       index);
+        }
+    }
+    begin();
+    if (log_) {
+        attach_log(log_);
+    }
+}
 
-    ctx_.field = &field_;
-    ctx_.attacker_side = &p1_side_;
-    ctx_.defender_side = &p2_side_;
+void BattleEngine::init(const PartyRentals& p1_party, const PartyRentals& p2_party,
+                        uint8_t level, uint32_t seed) {
+    util::random::Rng rng{};
+    rng.seed(seed);
+    init(p1_party, p2_party, level, rng);
+}
 
-    ctx_.slots[0] = &p1_setup_.slot;
-    ctx_.slots[1] = &p2_setup_.slot;
-    ctx_.mons[0] = &p1_setup_.mon;
-    ctx_.mons[1] = &p2_setup_.mon;
-    ctx_.active_slot_count = 2;
+void BattleEngine::reset(uint8_t level, const util::random::Rng& rng) {
+    // A copy of a constant-initialized state: a fresh BattleState{} would
+    // build every party member's defaults (defense rows included) at runtime
+    static constexpr dsl::BattleState FRESH_STATE{};
+    state_ = FRESH_STATE;
+    state_.rng = rng;
+    state_.level = level;
+}
 
-    set_attacker(0);
+void BattleEngine::add_member(uint8_t side, const types::Rental& rental,
+                              const logic::setup::RentalSetup& setup, uint16_t rental_index) {
+    dsl::Party& party = state_.parties[side];
+    const uint8_t member = party.size++;
+    party.mons[member] = setup.mon;
+    party.active[member] = setup.active;
+    party.rentals[member] = rental;
+    party.rental_indices[member] = rental_index;
+    party.abilities[member] = setup.ability;
+    party.ability_events[member] = dsl::ability::ability_event_mask(setup.ability);
+    if (member == 0) {
+        state_.slots[side] = setup.slot;
+    }
+}
+
+void BattleEngine::begin() {
+    if (journal_) {
+        journal_->clear();
+    }
+    wire_context();
+    fire_entry_abilities();
+}
+
+BattleEngine::BattleEngine(const BattleEngine& other)
+    : state_(other.state_), common_random_numbers_(other.common_random_numbers_) {
+    wire_context();
+}
+
+BattleEngine& BattleEngine::operator=(const BattleEngine& other) {
+    if (this != &other) {
+        common_random_numbers_ = other.common_random_numbers_;
+        restore(other.save());
+    }
+    return *this;
+}
+
+// ============================================================================
+//                        SNAPSHOT / RESTORE
+// ============================================================================
+
+BattleEngine::Snapshot BattleEngine::save() const {
+    return state_;
+}
+
+void BattleEngine::restore(const Snapshot& snapshot) {
+    state_ = snapshot;
+
+    if (journal_) {
+        journal_->clear();
+    }
+    log_ = nullptr;
+    wire_context();
+}
+
+// ============================================================================
+//                           UNDO JOURNAL
+// ============================================================================
+
+void BattleEngine::attach_journal(logic::state::UndoJournal* journal) {
+    journal_ = journal;
+    if (journal_) {
+        journal_->clear();
+    }
+}
+
+bool BattleEngine::undo_turn() {
+    logic::state::hashing::Scope hash_scope(hashing_ ? &hasher_ : nullptr);
+    if (!journal_ || !journal_->undo_turn(state_.rng)) {
+        return false;
+    }
+    legal_valid_ = false;
+    ctx_.result = dsl::EffectResult{};
+    ctx_.override = dsl::DamageOverride{};
+    return true;
+}
+
+// ============================================================================
+//                          STATE HASH
+// ============================================================================
+
+uint64_t BattleEngine::hash() const {
+#if BATTLEMON_STATE_HASH
+    hashing_ = true;
+    return hasher_.valid() ? hasher_.value() : hasher_.recompute();
+#else
+    return hasher_.recompute();  // No write hooks: nothing keeps it current
+#endif
+}
+
+// ============================================================================
+//                          BATTLE LOG
+// ============================================================================
+
+bool BattleEngine::attach_log(BattleLogWriter* log) {
+    log_ = nullptr;
+    if (!log) {
+        return true;
+    }
+    if (common_random_numbers_) {
+        return false;
+    }
+
+    // The log header names one rental per side
+    if (state_.parties[0].size != 1 || state_.parties[1].size != 1) {
+        return false;
+    }
+    if (state_.rental_index(0) == CUSTOM_RENTAL || state_.rental_index(1) == CUSTOM_RENTAL) {
+        return false;
+    }
+
+    const BattleLogHeader header{RULES_VERSION, state_.level, state_.rental_index(0),
+                                 state_.rental_index(1), state_.rng};
+    if (!log->begin(header)) {
+        return false;
+    }
+    log_ = log;
+    return true;
+}
+
+ReplayStatus BattleEngine::init_from_log(const BattleLog& log) {
+    BattleLogHeader header;
+    if (!read_log_header(log, header)) {
+        return ReplayStatus::BAD_HEADER;
+    }
+    if (header.rules != RULES_VERSION) {
+        return ReplayStatus::OLD_RULES;
+    }
+    if (header.p1_rental >= logic::setup::RENTAL_COUNT ||
+        header.p2_rental >= logic::setup::RENTAL_COUNT) {
+        return ReplayStatus::BAD_RENTAL;
+    }
+
+    log_ = nullptr;
+    init(header.p1_rental, header.p2_rental, header.level, header.rng);
+    return ReplayStatus::OK;
+}
+
+ReplayStatus BattleEngine::replay_turns(BattleLogReader& reader, uint32_t until_turn) {
+    while (reader.turn() < until_turn) {
+        switch (reader.next()) {
+            case BattleLogReader::Item::TURN:
+                execute_turn(reader.p1_action(), reader.p2_action());
+                break;
+            case BattleLogReader::Item::CHECKPOINT:
+                if (reader.fingerprint() != checkpoint_fingerprint(*this)) {
+                    return ReplayStatus::DIVERGED;
+                }
+                break;
+            case BattleLogReader::Item::FINISHED:
+                return ReplayStatus::OK;
+            case BattleLogReader::Item::CORRUPT:
+                return ReplayStatus::CORRUPT;
+            case BattleLogReader::Item::TRUNCATED:
+                return ReplayStatus::TRUNCATED;
+        }
+    }
+    return ReplayStatus::OK;
+}
+
+ReplayStatus BattleEngine::replay(const BattleLog& log) {
+    const ReplayStatus status = init_from_log(log);
+    if (status != ReplayStatus::OK) {
+        return status;
+    }
+
+    // The closing checkpoint follows the last turn, so read through the end marker
+    BattleLogReader reader(log);
+    return replay_turns(reader);
 }
 
 // ============================================================================
@@ -39,11 +327,47 @@ void BattleEngine::init(const types::Rental& p1_rental, const types::Rental& p2_
 // ============================================================================
 
 void BattleEngine::execute_turn(const BattleAction& p1_action, const BattleAction& p2_action) {
+    BATTLEMON_PROFILE_SCOPE(util::profile::Section::EXECUTE_TURN);
+    // Legality is settled as the turn starts: a Taunt or Disable landing
+    // first makes the chosen move fail, not turn into Struggle
+    struggling_ = 0;
+    for (uint8_t side = 0; side < 2; ++side) {
+        if (!(legal_actions(side) & ACTION_MOVES))
+            struggling_ = static_cast<uint8_t>(struggling_ | (1u << side));
+    }
+    legal_valid_ = false;
+
+    // Journal this turn's writes when make/unmake search is attached
+    if (journal_) {
+        journal_->begin_turn(state_.rng);
+    }
+    logic::state::journal::Scope journal_scope(journal_);
+    logic::state::hashing::Scope hash_scope(hashing_ ? &hasher_ : nullptr);
+    const logic::state::MonState* parties[] = {state_.parties[0].mons, state_.parties[1].mons};
+    logic::state::events::Scope event_scope(events_, parties, state_.slots,
+                                            dsl::MAX_BATTLE_SLOTS);
+
+    if (log_) {
+        log_->record_turn(p1_action, p2_action);
+    }
+
+    util::random::DrawLogScope draw_scope(draw_log_);
+    if (draw_log_) {
+        draw_log_->begin_turn();
+    }
+
+    // Common random numbers: one key per turn from the battle stream
+    util::random::SiteStreams streams{};
+    util::random::StreamScope stream_scope(common_random_numbers_ ? &streams : nullptr);
+    if (common_random_numbers_) {
+        streams.key = static_cast<uint64_t>(state_.rng.next()) << 32 | state_.rng.next();
+    }
+
     // ========================================================================
     // TurnGenesis -> Clear per-turn state
     // ========================================================================
-    p1_setup_.slot.clear_turn_flags();
-    p2_setup_.slot.clear_turn_flags();
+    state_.slots[0].clear_turn_flags();
+    state_.slots[1].clear_turn_flags();
 
     // ========================================================================
     // TurnGenesis -> PriorityDetermined
@@ -51,8 +375,18 @@ void BattleEngine::execute_turn(const BattleAction& p1_action, const BattleActio
     // ========================================================================
     bool p1_quick_claw = false;
     bool p2_quick_claw = false;
-    dsl::turn::fire_turn_start_for_slot(ctx_, &p1_setup_.slot, p1_quick_claw);
-    dsl::turn::fire_turn_start_for_slot(ctx_, &p2_setup_.slot, p2_quick_claw);
+    util::random::set_draw_actor(0);
+    dsl::turn::fire_turn_start_for_slot(ctx_, 0, p1_quick_claw);
+    util::random::set_draw_actor(1);
+    dsl::turn::fire_turn_start_for_slot(ctx_, 1, p2_quick_claw);
+    if (p1_quick_claw) {
+        logic::state::events::emit(logic::state::EventType::ITEM, 0,
+                                   static_cast<uint16_t>(state_.slots[0].held_item));
+    }
+    if (p2_quick_claw) {
+        logic::state::events::emit(logic::state::EventType::ITEM, 1,
+                                   static_cast<uint16_t>(state_.slots[1].held_item));
+    }
 
     uint8_t first_slot, second_slot;
     const BattleAction* first_action;
@@ -62,26 +396,44 @@ void BattleEngine::execute_turn(const BattleAction& p1_action, const BattleActio
 
     // ========================================================================
     // PriorityDetermined -> ActionsResolving
-    // Execute moves in determined order
+    // Execute actions in determined order. Pursuit against a foe switching
+    // out hits before the switch at double power, and is its user's action.
     // ========================================================================
-    execute_action(first_slot, *first_action);
+    bool second_acted = false;
+    if (first_action->type == BattleAction::Type::SWITCH &&
+        second_action->type == BattleAction::Type::MOVE) {
+        const auto& pursuit = lookup_move(chosen_move(second_slot, second_action->index));
+        if (pursuit.effect == types::enums::Effect::PURSUIT) {
+            util::random::set_draw_actor(second_slot);
+            execute_move(second_slot, second_action->index,
+                         static_cast<uint16_t>(pursuit.power * 2));
+            fire_item_checks();
+            second_acted = true;
+        }
+    }
 
-    if (!get_mon(second_slot).is_fainted()) {
+    if (!get_mon(first_slot).is_fainted()) {
+        execute_action(first_slot, *first_action);
+        fire_item_checks();
+    }
+
+    if (!second_acted && !get_mon(second_slot).is_fainted()) {
         execute_action(second_slot, *second_action);
+        fire_item_checks();
     }
 
     // ========================================================================
     // ActionsResolved -> TurnEnd
-    // Fire end-of-turn item events (Leftovers, etc.)
+    // Residuals in Gen III order: screens and weather, then per slot
+    // Leftovers and berries, Leech Seed, poison, burn, ... (dsl/residual.hpp)
     // ========================================================================
-    if (!p1_setup_.mon.is_fainted()) {
-        dsl::turn::fire_turn_end_for_slot(ctx_, &p1_setup_.slot, &p1_setup_.mon);
-    }
-    if (!p2_setup_.mon.is_fainted()) {
-        dsl::turn::fire_turn_end_for_slot(ctx_, &p2_setup_.slot, &p2_setup_.mon);
-    }
+    const uint8_t order[] = {first_slot, second_slot};
+    dsl::turn::run_residuals(ctx_, order);
+    logic::state::events::emit(logic::state::EventType::TURN_END, logic::state::NO_EVENT_SLOT);
 
-    // TODO: Weather damage, poison/burn damage, etc.
+    if (log_) {
+        log_->end_turn(checkpoint_fingerprint(*this));
+    }
 }
 
 // ============================================================================
@@ -97,53 +449,36 @@ void BattleEngine::determine_order(const BattleAction& p1_action, const BattleAc
     int8_t p2_priority = get_action_priority(p2_action, 1);
 
     auto p1_speed =
-        logic::calc::calc_effective_speed(p1_setup_.active, p1_setup_.slot, p1_setup_.mon);
+        logic::calc::cached_effective_speed(state_.active(0), state_.slots[0], state_.mon(0));
     auto p2_speed =
-        logic::calc::calc_effective_speed(p2_setup_.active, p2_setup_.slot, p2_setup_.mon);
-
-    // Quick Claw: if one battler has Quick Claw active and the other doesn't,
-    // the Quick Claw user moves first (within same priority bracket)
-    logic::calc::TurnOrder order;
-
-    if (p1_priority != p2_priority) {
-        // Different priority - Quick Claw doesn't matter
-        order = logic::calc::determine_turn_order(p1_priority, p2_priority, p1_speed, p2_speed);
-    } else if (p1_quick_claw && !p2_quick_claw) {
-        // P1 Quick Claw triggered, P2 didn't -> P1 first
-        order = logic::calc::TurnOrder::BATTLER1_FIRST;
-    } else if (p2_quick_claw && !p1_quick_claw) {
-        // P2 Quick Claw triggered, P1 didn't -> P2 first
-        order = logic::calc::TurnOrder::BATTLER2_FIRST;
-    } else {
-        // Both or neither have Quick Claw -> normal speed comparison
-        order = logic::calc::determine_turn_order(p1_priority, p2_priority, p1_speed, p2_speed);
-    }
-
-    if (order == logic::calc::TurnOrder::SPEED_TIE) {
-        order = (util::random::Random(2) == 0) ? logic::calc::TurnOrder::BATTLER1_FIRST
-                                               : logic::calc::TurnOrder::BATTLER2_FIRST;
-    }
-
-    if (order == logic::calc::TurnOrder::BATTLER1_FIRST) {
-        first_slot = 0;
-        second_slot = 1;
-        first_action = &p1_action;
-        second_action = &p2_action;
-    } else {
-        first_slot = 1;
-        second_slot = 0;
-        first_action = &p2_action;
-        second_action = &p1_action;
-    }
+        logic::calc::cached_effective_speed(state_.active(1), state_.slots[1], state_.mon(1));
+    // Swift Swim / Chlorophyll: order only, the slot's speed cache stays raw
+    p1_speed = dsl::ability::fire_speed_calc(ctx_, 0, p1_speed);
+    p2_speed = dsl::ability::fire_speed_calc(ctx_, 1, p2_speed);
+
+    // Quick Claw: within a priority bracket, a battler whose Quick Claw
+    // activated moves first (both or neither: normal speed comparison)
+    const uint32_t keys[] = {logic::calc::turn_order_key(p1_priority, p1_speed, p1_quick_claw),
+                             logic::calc::turn_order_key(p2_priority, p2_speed, p2_quick_claw)};
+    uint8_t order[dsl::Singles::SLOTS];
+    dsl::Singles::order(keys, order, [this](uint8_t, uint8_t) {
+        util::random::set_draw_actor(0);
+        return state_.rng.chance(1, 2, util::random::DrawSite::SPEED_TIE);
+    });
+
+    first_slot = order[0];
+    second_slot = order[1];
+    first_action = first_slot == 0 ? &p1_action : &p2_action;
+    second_action = first_slot == 0 ? &p2_action : &p1_action;
 }
 
 int8_t BattleEngine::get_action_priority(const BattleAction& action, uint8_t slot) const {
     if (action.type == BattleAction::Type::MOVE) {
-        const auto& rental = get_rental(slot);
-        const auto move_id = rental.moves[action.index];
-        return lookup_move(move_id).priority;
+        return lookup_move(chosen_move(slot, action.index)).priority;
+    }
+    if (action.type == BattleAction::Type::SWITCH) {
+        return SWITCH_PRIORITY;
     }
-    // Switches have priority 0 in Gen III (simplified for now)
     return 0;
 }
 
@@ -152,62 +487,250 @@ int8_t BattleEngine::get_action_priority(const BattleAction& action, uint8_t slo
 // ============================================================================
 
 void BattleEngine::execute_action(uint8_t actor_slot, const BattleAction& action) {
+    util::random::set_draw_actor(actor_slot);
     if (action.type == BattleAction::Type::MOVE) {
         execute_move(actor_slot, action.index);
+        if (ctx_.result.switch_out) {
+            resolve_switch_out(actor_slot);
+        }
+        if (ctx_.result.force_switch) {
+            dsl::turn::switch_in(ctx_, dsl::Singles::foe_of(actor_slot),
+                                 ctx_.result.forced_member);
+        }
+    } else if (action.type == BattleAction::Type::SWITCH) {
+        // Wrap, Mean Look and Ingrain hold the battler in as they do the mask
+        if (legal_action_mask(state_, actor_slot) & action_bit(action)) {
+            dsl::turn::switch_in(ctx_, actor_slot, action.index);
+        }
+    }
+    // TODO: Handle RUN
+}
+
+void BattleEngine::resolve_switch_out(uint8_t actor_slot) {
+    const dsl::Party& party = state_.party_of(actor_slot);
+    const uint8_t active = state_.slots[actor_slot].party_index;
+    for (uint8_t member = 0; member < party.size; ++member) {
+        if (member != active && party.mons[member].is_alive()) {
+            dsl::turn::switch_in(ctx_, actor_slot, member, ctx_.result.baton_pass);
+            return;
+        }
+    }
+    // No one to switch to: Baton Pass fails
+}
+
+bool BattleEngine::replace(uint8_t side, uint8_t member) {
+    if (!get_mon(side).is_fainted() ||
+        !(legal_actions(side) & action_bit(BattleAction::switch_to(member)))) {
+        return false;
+    }
+    legal_valid_ = false;
+
+    if (journal_) {
+        journal_->begin_turn(state_.rng);
+    }
+    logic::state::journal::Scope journal_scope(journal_);
+    logic::state::hashing::Scope hash_scope(hashing_ ? &hasher_ : nullptr);
+    const logic::state::MonState* parties[] = {state_.parties[0].mons, state_.parties[1].mons};
+    logic::state::events::Scope event_scope(events_, parties, state_.slots,
+                                            dsl::MAX_BATTLE_SLOTS);
+    util::random::DrawLogScope draw_scope(draw_log_);
+    if (draw_log_) {
+        draw_log_->begin_turn();
     }
-    // TODO: Handle SWITCH and RUN
+
+    util::random::set_draw_actor(side);
+    dsl::turn::switch_in(ctx_, side, member);
+    return true;
+}
+
+void BattleEngine::fire_item_checks() {
+    util::random::set_draw_actor(0);
+    dsl::turn::fire_item_check_for_slot(ctx_, 0);
+    util::random::set_draw_actor(1);
+    dsl::turn::fire_item_check_for_slot(ctx_, 1);
 }
 
-void BattleEngine::execute_move(uint8_t actor_slot, uint8_t move_index) {
+void BattleEngine::execute_move(uint8_t actor_slot, uint8_t move_index, uint16_t power) {
     set_attacker(actor_slot);
 
-    const auto& rental = get_rental(actor_slot);
-    const auto move_id = rental.moves[move_index];
+    const auto move_id = chosen_move(actor_slot, move_index);
     const auto& move = lookup_move(move_id);
     ctx_.move = &move;
+    logic::state::events::emit(logic::state::EventType::MOVE_USED, actor_slot,
+                               static_cast<uint16_t>(move_id));
+
+    // Struggle has no PP, and a charged move was paid for when it began charging
+    if (move_id != types::enums::Move::STRUGGLE &&
+        !get_slot(actor_slot).has(logic::state::volatile_flags::CHARGING)) {
+        deduct_pp(actor_slot, move_index);
+    }
 
     ctx_.result = dsl::EffectResult{};
     ctx_.override = dsl::DamageOverride{};
+    ctx_.override.power = power;
 
     dispatch_move_effect(move.effect, ctx_);
 
     auto& slot = get_slot(actor_slot);
-    slot.moved_this_turn = true;
-    slot.last_move_used = static_cast<uint8_t>(move_id);
+    logic::state::assign(slot.moved_this_turn, true);
+    logic::state::assign(slot.last_move_used, static_cast<uint8_t>(move_id));
+}
+
+types::enums::Move BattleEngine::chosen_move(uint8_t slot, uint8_t move_index) const {
+    if (struggling_ & (1u << slot))
+        return types::enums::Move::STRUGGLE;
+    return get_rental(slot).moves[move_index];
+}
+
+void BattleEngine::deduct_pp(uint8_t actor_slot, uint8_t move_index) {
+    const uint8_t foe = dsl::Singles::foe_of(actor_slot);
+    const auto move_id = get_rental(actor_slot).moves[move_index];
+    uint8_t cost = 1;
+    if (state_.ability(foe) == types::enums::Ability::PRESSURE && !get_mon(foe).is_fainted() &&
+        data::g_MOVE_COLD[static_cast<size_t>(move_id)].target != types::MoveTarget::USER) {
+        cost = 2;
+    }
+    logic::state::MonState& mon = get_mon(actor_slot);
+    const uint8_t pp = mon.pp[move_index];
+    logic::state::assign(mon.pp[move_index], static_cast<uint8_t>(pp > cost ? pp - cost : 0));
+}
+
+// ============================================================================
+//                          ACTION PREVIEW
+// ============================================================================
+
+namespace {
+
+BattlerDelta battler_delta(const dsl::BattleState& before, const dsl::BattleState& after,
+                           uint8_t slot_id) {
+    using logic::state::SlotState;
+    static constexpr int8_t SlotState::* STAGES[] = {
+        &SlotState::atk_stage,    &SlotState::def_stage,    &SlotState::spd_stage,
+        &SlotState::sp_atk_stage, &SlotState::sp_def_stage, &SlotState::accuracy_stage,
+        &SlotState::evasion_stage};
+    static_assert(std::size(STAGES) == std::size(BattlerDelta{}.stages));
+
+    // The member in the slot before the action (a switch-in replaces it)
+    const uint8_t member = before.slots[slot_id].party_index;
+    const logic::state::MonState& mon_before = before.party_of(slot_id).mons[member];
+    const logic::state::MonState& mon_after = after.party_of(slot_id).mons[member];
+    const SlotState& slot_before = before.slots[slot_id];
+    const SlotState& slot_after = after.slots[slot_id];
+
+    BattlerDelta delta{};
+    delta.hp = static_cast<int16_t>(mon_after.current_hp - mon_before.current_hp);
+    for (size_t i = 0; i < std::size(STAGES); ++i) {
+        delta.stages[i] = static_cast<int8_t>(slot_after.*STAGES[i] - slot_before.*STAGES[i]);
+    }
+    delta.status = mon_after.status;
+    delta.status_changed = mon_after.status != mon_before.status;
+    delta.volatiles_set = slot_after.volatiles & ~slot_before.volatiles;
+    delta.volatiles_cleared = slot_before.volatiles & ~slot_after.volatiles;
+    delta.item_consumed = slot_after.item_consumed && !slot_before.item_consumed;
+    return delta;
+}
+
+template <typename T>
+bool changed(const T& before, const T& after) {
+    return std::memcmp(&before, &after, sizeof(T)) != 0;
+}
+
+}  // namespace
+
+ActionPreview BattleEngine::preview(uint8_t side, const BattleAction& action) const {
+    util::random::DrawTape tape{util::random::DrawTape::Mode::MEDIAN};
+    return preview_leaf(side, action, &tape);
+}
+
+ActionPreview BattleEngine::preview_leaf(uint8_t side, const BattleAction& action,
+                                         util::random::DrawTape* tape) const {
+    // Writes to the scratch state (and its draws) must not reach anything
+    // this battle, or one whose turn is running, records into
+    logic::state::journal::Scope journal_scope(nullptr);
+    logic::state::hashing::Scope hash_scope(nullptr);
+    logic::state::events::Scope event_scope(nullptr, nullptr, nullptr, 0);
+    util::random::StreamScope stream_scope(nullptr);
+    util::random::DrawLogScope draw_scope(nullptr);
+    util::random::TapeScope tape_scope(tape);
+
+    dsl::BattleState scratch;
+    std::memcpy(static_cast<void*>(&scratch), &state_, sizeof(scratch));
+    dsl::BattleContext ctx{};
+    ctx.state = &scratch;
+    ctx.rng = &scratch.rng;
+    ctx.set_battlers(side, dsl::Singles::foe_of(side));
+
+    if (action.type == BattleAction::Type::MOVE) {
+        const auto& move = lookup_move(scratch.rental(side).moves[action.index]);
+        ctx.move = &move;
+        dispatch_move_effect(move.effect, ctx);
+    } else if (action.type == BattleAction::Type::SWITCH) {
+        dsl::turn::switch_in(ctx, side, action.index);
+    }
+
+    ActionPreview preview{};
+    preview.result = ctx.result;
+    preview.probability = tape ? tape->probability() : util::random::PROBABILITY_ONE;
+    for (uint8_t slot = 0; slot < dsl::MAX_BATTLE_SLOTS; ++slot)
+        preview.battlers[slot] = battler_delta(state_, scratch, slot);
+    preview.field_changed = changed(state_.field, scratch.field);
+    for (uint8_t i = 0; i < dsl::BATTLE_SIDE_COUNT; ++i)
+        preview.side_changed[i] = changed(state_.sides[i], scratch.sides[i]);
+    return preview;
 }
 
 // ============================================================================
 //                           HELPERS
 // ============================================================================
 
-void BattleEngine::set_attacker(uint8_t slot) {
-    const bool first = (slot == 0);
+void BattleEngine::wire_context() {
+    legal_valid_ = false;
+    ctx_ = dsl::BattleContext{};
+    ctx_.rng = &state_.rng;
+    ctx_.state = &state_;
+
+    // Region order is part of every hash key: keep it fixed
+    hasher_.clear();
+    hasher_.add_region(&state_.field, logic::state::FIELD_HASH_LAYOUT);
+    hasher_.add_region(&state_.sides[0], logic::state::SIDE_HASH_LAYOUT);
+    hasher_.add_region(&state_.sides[1], logic::state::SIDE_HASH_LAYOUT);
+    hasher_.add_region(&state_.parties[0].mons, logic::state::PARTY_HASH_LAYOUT);
+    hasher_.add_region(&state_.parties[1].mons, logic::state::PARTY_HASH_LAYOUT);
+    hasher_.add_region(&state_.slots[0], logic::state::SLOT_HASH_LAYOUT);
+    hasher_.add_region(&state_.slots[1], logic::state::SLOT_HASH_LAYOUT);
 
-    auto& atk_setup = first ? p1_setup_ : p2_setup_;
-    auto& def_setup = first ? p2_setup_ : p1_setup_;
-    auto& atk_side = first ? p1_side_ : p2_side_;
-    auto& def_side = first ? p2_side_ : p1_side_;
+    set_attacker(0);
+}
 
-    const uint8_t atk_id = first ? 0 : 1;
-    const uint8_t def_id = first ? 1 : 0;
+void BattleEngine::fire_entry_abilities() {
+    // Both battlers enter together: the faster one's ability first, slot 0
+    // on a speed tie (no draw before the first turn)
+    const logic::state::MonState* parties[] = {state_.parties[0].mons, state_.parties[1].mons};
+    logic::state::events::Scope event_scope(events_, parties, state_.slots,
+                                            dsl::MAX_BATTLE_SLOTS);
+    const auto p1_speed =
+        logic::calc::cached_effective_speed(state_.active(0), state_.slots[0], state_.mon(0));
+    const auto p2_speed =
+        logic::calc::cached_effective_speed(state_.active(1), state_.slots[1], state_.mon(1));
+    const uint8_t first = p2_speed > p1_speed ? 1 : 0;
+
+    set_attacker(first);
+    dsl::ability::fire_switch_in(ctx_);
+    set_attacker(first ^ 1);
+    dsl::ability::fire_switch_in(ctx_);
+    set_attacker(0);
+}
 
-    ctx_.attacker_slot = &atk_setup.slot;
-    ctx_.attacker_mon = &atk_setup.mon;
-    ctx_.attacker_active = &atk_setup.active;
-    ctx_.attacker_side = &atk_side;
-    ctx_.attacker_slot_id = atk_id;
-    ctx_.attacker_side_id = atk_id;
+void BattleEngine::set_attacker(uint8_t slot) {
+    ctx_.set_battlers(slot, dsl::Singles::foe_of(slot));
+}
 
-    ctx_.defender_slot = &def_setup.slot;
-    ctx_.defender_mon = &def_setup.mon;
-    ctx_.defender_active = &def_setup.active;
-    ctx_.defender_side = &def_side;
-    ctx_.defender_slot_id = def_id;
-    ctx_.defender_side_id = def_id;
+const types::MoveHot& BattleEngine::lookup_move(types::enums::Move move_id) {
+    return data::g_MOVE_HOT[static_cast<size_t>(move_id)];
 }
 
-const types::Move& BattleEngine::lookup_move(types::enums::Move move_id) {
-    return data::g_MOVE_TABLE[static_cast<size_t>(move_id)];
+const dsl::EffectTraits& BattleEngine::move_traits(uint8_t side, uint8_t move_index) const {
+    return effect_traits(lookup_move(get_rental(side).moves[move_index]).effect);
 }
 
 }  // namespace engine
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
+#include "dsl/effect_traits.hpp"
 #include "logic/setup/rental.hpp"
 #include "logic/state/context.hpp"
+#include "logic/state/event_queue.hpp"
 #include "logic/state/field.hpp"
+#include "logic/state/hash.hpp"
+#include "logic/state/journal.hpp"
 #include "logic/state/side.hpp"
 #include "types/models/rental.hpp"
+#include "util/random.hpp"
 
 namespace engine {
 
@@ -41,6 +47,137 @@ struct BattleAction {
     }
 };
 
+// ============================================================================
+//                          LEGAL ACTION MASKS
+// ============================================================================
+//
+// The actions a side may choose this turn, one bit each: bits 0-3 are MOVE
+// 0-3 and bits 4-9 SWITCH to party member 0-5 (set for living benched
+// members). Move generation walks the set bits with for_each_action() instead
+// of re-deriving legality per candidate.
+// ============================================================================
+
+using ActionMask = uint16_t;
+
+inline constexpr uint8_t ACTION_SWITCH_BIT = 4;
+inline constexpr ActionMask ACTION_MOVES = 0x000F;
+inline constexpr ActionMask ACTION_SWITCHES = 0x03F0;
+
+/// Mask bit of `action` (0 for actions without one, e.g. RUN)
+constexpr ActionMask action_bit(const BattleAction& action) {
+    switch (action.type) {
+        case BattleAction::Type::MOVE:
+            return action.index < 4 ? static_cast<ActionMask>(1u << action.index) : 0;
+        case BattleAction::Type::SWITCH:
+            return action.index < 6
+                       ? static_cast<ActionMask>(1u << (ACTION_SWITCH_BIT + action.index))
+                       : 0;
+        default:
+            return 0;
+    }
+}
+
+/// Action of mask bit `bit`
+constexpr BattleAction action_at(uint8_t bit) {
+    return bit < ACTION_SWITCH_BIT
+               ? BattleAction::move(bit)
+               : BattleAction::switch_to(static_cast<uint8_t>(bit - ACTION_SWITCH_BIT));
+}
+
+/// Call visit(action) for every action in `mask`, moves first
+template <typename Visit>
+constexpr void for_each_action(ActionMask mask, Visit&& visit) {
+    for (uint8_t bit = 0; mask != 0; ++bit, mask = static_cast<ActionMask>(mask >> 1)) {
+        if (mask & 1u)
+            visit(action_at(bit));
+    }
+}
+
+/**
+ * @brief Legal actions of the battler in `slot` of `state`.
+ *
+ * A move slot is legal if it holds a move with PP left that is not
+ * Disabled, not a status move under Taunt, and not ruled out by a lock: a
+ * charging two-turn move, Encore, or an unconsumed Choice Band after the
+ * first move since switch-in allow only that move (the charged move fires
+ * even on its last PP, paid when charging began). No move bit means the
+ * battler has to Struggle.
+ *
+ * A switch to a living benched member is legal unless the battler is bound,
+ * trapped or Ingrained. A fainted battler's mask holds only its
+ * replacements (BattleEngine::replace()).
+ */
+ActionMask legal_action_mask(const dsl::BattleState& state, uint8_t slot);
+
+// ============================================================================
+//                            BATTLE SNAPSHOT
+// ============================================================================
+//
+// The engine's whole battle state is one dsl::BattleState, so a snapshot is
+// that block: saving or restoring is a plain struct copy, and a search node
+// costs about a kilobyte instead of an init() plus a replay. Rentals and
+// RNG are part of it, so a snapshot restores into any engine.
+// ============================================================================
+
+using BattleSnapshot = dsl::BattleState;
+
+// ============================================================================
+//                             ACTION PREVIEW
+// ============================================================================
+//
+// What an action would do, for the AI and the damage-preview UI, from
+// BattleEngine::preview(). Each delta compares one battler before and after
+// the action: its slot, and the party member that was in it.
+// ============================================================================
+
+/// One battler's change over a previewed action
+struct BattlerDelta {
+    int16_t hp{0};       // Negative: damage taken
+    int8_t stages[7]{};  // Stat stages, in SlotState order (atk_stage first)
+
+    logic::state::Status status{logic::state::Status::NONE};  // After the action
+    bool status_changed{false};
+
+    uint32_t volatiles_set{0};      // volatile_flags gained
+    uint32_t volatiles_cleared{0};  // volatile_flags lost
+    bool item_consumed{false};      // Held item used up
+};
+
+/// One outcome of a previewed action
+struct ActionPreview {
+    dsl::EffectResult result{};
+    util::random::Probability probability{util::random::PROBABILITY_ONE};
+    BattlerDelta battlers[dsl::MAX_BATTLE_SLOTS]{};  // By slot
+    bool field_changed{false};                       // Weather, field timers
+    bool side_changed[dsl::BATTLE_SIDE_COUNT]{};     // Screens, hazards
+};
+
+// ============================================================================
+//                             PARTY RENTALS
+// ============================================================================
+
+/// A side's team as g_RENTAL_SETS indices, lead first
+struct PartyRentals {
+    uint16_t rentals[dsl::MAX_PARTY_SIZE]{};
+    uint8_t size{0};  // 1-MAX_PARTY_SIZE
+};
+
+// Battle logs (battle_log.hpp)
+struct BattleLog;
+class BattleLogReader;
+class BattleLogWriter;
+
+/// Outcome of BattleEngine::replay()
+enum class ReplayStatus : uint8_t {
+    OK,          // Every turn re-executed and every checkpoint matched
+    BAD_HEADER,  // Not a log, or an unsupported version
+    BAD_RENTAL,  // Rental index outside data::g_RENTAL_SETS
+    CORRUPT,     // Undecodable turn byte
+    DIVERGED,    // A checkpoint did not match: the engine no longer replays this log
+    TRUNCATED,   // Ran out of bytes before the end marker
+    OLD_RULES,   // Played under another RULES_VERSION (rules.hpp): not replayable
+};
+
 // ============================================================================
 //                            BATTLE ENGINE
 // ============================================================================
@@ -48,10 +185,12 @@ struct BattleAction {
 // Core battle engine for executing turns in a singles battle.
 //
 // Responsibilities:
-//   - Determine turn order (priority, speed, random tiebreak)
-//   - Execute actions in order
+//   - Determine turn order (switches first, then priority, speed, random
+//     tiebreak)
+//   - Execute actions in order, switches included (Pursuit, Baton Pass,
+//     Roar / Whirlwind)
 //   - Dispatch moves to effect routines
-//   - Handle end-of-turn effects (TODO: Milestone 2)
+//   - Run end-of-turn residuals (dsl/residual.hpp, run_residuals())
 //
 // ============================================================================
 
@@ -63,14 +202,72 @@ class BattleEngine {
 
     BattleEngine() = default;
 
+    // ctx_ points into this object's own members: copies re-wire it
+    BattleEngine(const BattleEngine& other);
+    BattleEngine& operator=(const BattleEngine& other);
+
     /**
-     * @brief Initialize a battle between two rental Pokemon.
+     * @brief Initialize a battle between two g_RENTAL_SETS entries.
+     *
+     * @param p1_rental Player 1's rental (index into data::g_RENTAL_SETS)
+     * @param p2_rental Player 2's rental
+     * @param level Battle level
+     * @param rng Initial RNG state for this battle (batch simulation passes
+     *            master.split(index), so any battle replays from the index)
+     *
+     * @pre Both indices < logic::setup::RENTAL_COUNT
+     */
+    void init(uint16_t p1_rental, uint16_t p2_rental, uint8_t level,
+              const util::random::Rng& rng);
+
+    /// Same, seeded (0 = platform entropy)
+    void init(uint16_t p1_rental, uint16_t p2_rental, uint8_t level = 50, uint32_t seed = 0);
+
+    /**
+     * @brief Initialize a battle between two custom rentals.
+     *
+     * The rentals are copied and their stats calculated. Battles between
+     * table rentals use the index overloads (precomputed stats, loggable).
      *
      * @param p1_rental Player 1's rental data
      * @param p2_rental Player 2's rental data
      * @param level Battle level (default 50)
+     * @param seed Seed for this battle's RNG (0 = platform entropy)
      */
-    void init(const types::Rental& p1_rental, const types::Rental& p2_rental, uint8_t level = 50);
+    void init(const types::Rental& p1_rental, const types::Rental& p2_rental, uint8_t level = 50,
+              uint32_t seed = 0);
+
+    /**
+     * @brief Initialize a battle between two custom rentals on an explicit
+     *        RNG stream.
+     *
+     * @param p1_rental Player 1's rental data
+     * @param p2_rental Player 2's rental data
+     * @param level Battle level
+     * @param rng Initial RNG state for this battle
+     */
+    void init(const types::Rental& p1_rental, const types::Rental& p2_rental, uint8_t level,
+              const util::random::Rng& rng);
+
+    /**
+     * @brief Initialize a battle between two parties of g_RENTAL_SETS entries.
+     *
+     * Each side leads with its first member. Battle logs record single
+     * rentals, so a battle with a party of more than one cannot be logged.
+     *
+     * @param p1_party Player 1's party
+     * @param p2_party Player 2's party
+     * @param level Battle level
+     * @param rng Initial RNG state for this battle
+     *
+     * @pre Both sizes in 1..dsl::MAX_PARTY_SIZE, every index < logic::setup::RENTAL_COUNT
+     */
+    void init(const PartyRentals& p1_party, const PartyRentals& p2_party, uint8_t level,
+              const util::random::Rng& rng);
+
+    /// Same, seeded (0 = platform entropy)
+    void init(const PartyRentals& p1_party, const PartyRentals& p2_party, uint8_t level = 50,
+              uint32_t seed = 0);
 
     // ========================================================================
     //                         TURN EXECUTION
@@ -79,35 +276,312 @@ class BattleEngine {
     /**
      * @brief Execute a full turn with both players' actions.
      *
-     * Determines turn order and executes actions sequentially.
+     * Determines turn order and executes actions sequentially. Both active
+     * battlers must be standing: replace() a fainted one first. A move costs
+     * its PP when used; a battler with no legal move Struggles, whichever
+     * move slot it was given.
      *
      * @param p1_action Player 1's action
      * @param p2_action Player 2's action
      */
     void execute_turn(const BattleAction& p1_action, const BattleAction& p2_action);
 
+    /// `side`'s active battler has fainted and the side has a member to send in
+    [[nodiscard]] bool needs_replacement(uint8_t side) const {
+        return state_.mon(side).is_fainted() &&
+               state_.parties[side].has_reserve(state_.slots[side].party_index);
+    }
+
+    /**
+     * @brief Send in `member` for `side`'s fainted battler, between turns.
+     *
+     * Journaled and hashed like a turn (undo_turn() takes it back) and
+     * recorded into the attached event queue.
+     *
+     * @return false (nothing done) unless `member` is a legal switch of the
+     *         side (legal_actions())
+     */
+    bool replace(uint8_t side, uint8_t member);
+
+    // ========================================================================
+    //                        SNAPSHOT / RESTORE
+    // ========================================================================
+
+    using Snapshot = BattleSnapshot;
+
+    /**
+     * @brief Capture the full mutable battle state (including RNG).
+     */
+    [[nodiscard]] Snapshot save() const;
+
+    /**
+     * @brief Return to a previously saved state.
+     *
+     * @param snapshot State from save()
+     */
+    void restore(const Snapshot& snapshot);
+
+    // ========================================================================
+    //                          ACTION PREVIEW
+    // ========================================================================
+
+    /**
+     * @brief What `action` would do if `side` took it now, without taking it.
+     *
+     * Runs the action alone - a move's effect routine with its item and
+     * ability hooks (Choice Band, Scope Lens, ...), or a switch-in with its
+     * entry ability - on a scratch copy of the state with no journal,
+     * hash, events or streams attached: the battle, its RNG and its caches
+     * are untouched. Every draw takes its median outcome
+     * (util::random::DrawTape::Mode::MEDIAN): the move hits if it is at
+     * least as likely to as not, never crits, and rolls the middle damage
+     * roll. The foe's action, turn order and residuals do not run.
+     *
+     * @pre `action` is in legal_actions(side)
+     */
+    [[nodiscard]] ActionPreview preview(uint8_t side, const BattleAction& action) const;
+
+    /**
+     * @brief Every outcome of preview(side, action), with its probability.
+     *
+     * A move whose effect never draws (move_traits()) is one leaf, run
+     * without walking a tape.
+     *
+     * @param visit Callable (const ActionPreview&) -> bool (false = stop)
+     *
+     * @return false if the visitor stopped the walk
+     */
+    template <typename Visit>
+    bool preview(uint8_t side, const BattleAction& action, Visit&& visit) const {
+        if (action.type == BattleAction::Type::MOVE && !move_traits(side, action.index).draws_rng)
+            return visit(preview_leaf(side, action, nullptr));
+        util::random::DrawTape tape;
+        do {
+            if (!visit(preview_leaf(side, action, &tape)))
+                return false;
+        } while (tape.advance());
+        return true;
+    }
+
+    // ========================================================================
+    //                           UNDO JOURNAL
+    // ========================================================================
+
+    /**
+     * @brief Record every state write of subsequent turns into `journal`.
+     *
+     * Opt-in make/unmake for memory-constrained search: the journal is owned
+     * by the caller, and nullptr detaches it. init() and restore() clear it,
+     * since recorded turns no longer apply after either.
+     *
+     * @param journal Journal to record into (nullptr = stop recording)
+     */
+    void attach_journal(logic::state::UndoJournal* journal);
+
+    /**
+     * @brief Roll back the most recent execute_turn() or replace() (including
+     *        the RNG).
+     *
+     * @return false if no journal is attached, no turn was recorded, or the
+     *         turn's entries have been overwritten in the ring buffer
+     */
+    bool undo_turn();
+
+    // ========================================================================
+    //                          BATTLE EVENTS
+    // ========================================================================
+
+    /**
+     * @brief Record what each subsequent turn does into `queue` for the UI.
+     *
+     * execute_turn() appends the turn's events (move used, miss, critical
+     * hit, damage, heal, status, item, ability, faint, then TURN_END) and the
+     * UI pops
+     * them one at a time (logic/state/event_queue.hpp). The queue is owned by
+     * the caller; copies of the engine (search) do not inherit it. In builds
+     * with BATTLEMON_BATTLE_EVENTS=0 nothing is recorded.
+     *
+     * @param queue Queue to append to (nullptr = stop recording)
+     */
+    void attach_events(logic::state::EventQueue* queue) { events_ = queue; }
+
+    // ========================================================================
+    //                          DRAW TELEMETRY
+    // ========================================================================
+
+    /**
+     * @brief Report the draws of each subsequent turn to `log`.
+     *
+     * execute_turn() and replace() each begin a turn of the log, so its
+     * records are the latest turn's draws and its counts cover every turn
+     * since it was attached (see util::random::DrawLog). Owned by the
+     * caller and not inherited by copies, like the event queue. In builds
+     * with BATTLEMON_DRAW_TELEMETRY=0 nothing is reported.
+     *
+     * @param log Log to report to (nullptr = stop reporting)
+     */
+    void attach_draw_log(util::random::DrawLog* log) { draw_log_ = log; }
+
+    // ========================================================================
+    //                      COMMON RANDOM NUMBERS
+    // ========================================================================
+
+    /**
+     * @brief Draw each turn's rolls from per-(side, site) streams.
+     *
+     * For A/B comparisons: with the mode on, two battles from the same seed
+     * share the rolls of every decision they share, and a different
+     * decision only changes the rolls of its own turn (the battle stream
+     * advances by one key per turn, however many draws the turn makes).
+     * See util::random::SiteStreams. Battle logs do not record the mode, so
+     * attach_log() refuses while it is on.
+     */
+    void set_common_random_numbers(bool enabled) { common_random_numbers_ = enabled; }
+    [[nodiscard]] bool common_random_numbers() const { return common_random_numbers_; }
+
+    // ========================================================================
+    //                          STATE HASH
+    // ========================================================================
+
+    /**
+     * @brief 64-bit Zobrist hash of the battle state (logic/state/hash.hpp).
+     *
+     * Covers HP, status, PP, stat stages, volatiles and counters, screens,
+     * weather and the other field timers; not the RNG, so states reached
+     * along different chance paths still match. The first call computes it
+     * in full and turns on incremental upkeep: later turns (and undo_turn())
+     * update it in place. After restore() or a bulk reset the next call
+     * recomputes it.
+     */
+    [[nodiscard]] uint64_t hash() const;
+
+    // ========================================================================
+    //                          LEGAL ACTIONS
+    // ========================================================================
+
+    /**
+     * @brief Actions `side` may choose this turn (see legal_action_mask()).
+     *
+     * Kept per engine: anything that can change the fields legality depends
+     * on (execute_turn(), undo_turn(), restore(), init(), the mutable state
+     * accessors) marks it stale, and the next call recomputes both sides.
+     * Repeated queries of one state, as a search node makes, cost a load.
+     * Re-fetch a mutable accessor after a call: writes through a reference
+     * taken before it are not seen.
+     */
+    [[nodiscard]] ActionMask legal_actions(uint8_t side) const {
+        if (!legal_valid_) {
+            legal_[0] = legal_action_mask(state_, 0);
+            legal_[1] = legal_action_mask(state_, 1);
+            legal_valid_ = true;
+        }
+        return legal_[side];
+    }
+
+    // ========================================================================
+    //                          BATTLE LOG
+    // ========================================================================
+
+    /**
+     * @brief Record subsequent turns into `log` (see battle_log.hpp).
+     *
+     * Starts the log from the current state, so attach right after init();
+     * init() restarts an attached log and restore() detaches it. The caller
+     * owns the writer and calls finish() when the battle is over. Turns
+     * taken back with undo_turn() stay in the log.
+     *
+     * @param log Writer to record into (nullptr = stop recording)
+     *
+     * @return false if the battle was set up from custom rentals or parties,
+     *         or common random numbers are on (not attached)
+     */
+    bool attach_log(BattleLogWriter* log);
+
+    /**
+     * @brief Re-initialize from a log and re-execute every logged turn.
+     *
+     * Bit-identical to the recorded battle: afterwards the engine is in the
+     * state the original battle ended in. Detaches any attached log.
+     *
+     * @param log Complete log (header through end marker)
+     *
+     * @return ReplayStatus::OK, or where replay stopped
+     */
+    ReplayStatus replay(const BattleLog& log);
+
+    /**
+     * @brief Initialize from a log's header (turn 0 of replay()).
+     *
+     * Detaches any attached log.
+     *
+     * @return ReplayStatus::OK, BAD_HEADER, OLD_RULES or BAD_RENTAL
+     */
+    ReplayStatus init_from_log(const BattleLog& log);
+
+    /**
+     * @brief Execute logged turns until `until_turn` turns have been read.
+     *
+     * Checks every checkpoint on the way. Stops early (with OK) at the end
+     * marker, so seeking past the end leaves the battle at its final state.
+     *
+     * @param reader Reader positioned in a log of this battle
+     * @param until_turn Stop once reader.turn() reaches this
+     */
+    ReplayStatus replay_turns(BattleLogReader& reader, uint32_t until_turn = UINT32_MAX);
+
     // ========================================================================
     //                         STATE ACCESSORS
     // ========================================================================
 
-    [[nodiscard]] const logic::state::MonState& p1_mon() const { return p1_setup_.mon; }
-    [[nodiscard]] const logic::state::MonState& p2_mon() const { return p2_setup_.mon; }
-    [[nodiscard]] logic::state::MonState& p1_mon() { return p1_setup_.mon; }
-    [[nodiscard]] logic::state::MonState& p2_mon() { return p2_setup_.mon; }
+    [[nodiscard]] const logic::state::MonState& p1_mon() const { return state_.mon(0); }
+    [[nodiscard]] const logic::state::MonState& p2_mon() const { return state_.mon(1); }
+    [[nodiscard]] logic::state::MonState& p1_mon() {
+        legal_valid_ = false;
+        return state_.mon(0);
+    }
+    [[nodiscard]] logic::state::MonState& p2_mon() {
+        legal_valid_ = false;
+        return state_.mon(1);
+    }
+
+    [[nodiscard]] const logic::state::SlotState& p1_slot() const { return state_.slots[0]; }
+    [[nodiscard]] const logic::state::SlotState& p2_slot() const { return state_.slots[1]; }
 
-    [[nodiscard]] const logic::state::SlotState& p1_slot() const { return p1_setup_.slot; }
-    [[nodiscard]] const logic::state::SlotState& p2_slot() const { return p2_setup_.slot; }
+    [[nodiscard]] const dsl::ActiveMon& p1_active() const { return state_.active(0); }
+    [[nodiscard]] const dsl::ActiveMon& p2_active() const { return state_.active(1); }
 
-    [[nodiscard]] const dsl::ActiveMon& p1_active() const { return p1_setup_.active; }
-    [[nodiscard]] const dsl::ActiveMon& p2_active() const { return p2_setup_.active; }
+    [[nodiscard]] const types::Rental& rental(uint8_t side) const { return get_rental(side); }
+
+    /// What `side`'s move `move_index` can do: its effect's g_EFFECT_TRAITS (dispatch.hpp)
+    [[nodiscard]] const dsl::EffectTraits& move_traits(uint8_t side, uint8_t move_index) const;
+
+    /// rental_index() of a battle set up from custom rentals
+    static constexpr uint16_t CUSTOM_RENTAL = dsl::CUSTOM_RENTAL_INDEX;
+
+    /// Index of `side`'s active rental in data::g_RENTAL_SETS, or CUSTOM_RENTAL
+    [[nodiscard]] uint16_t rental_index(uint8_t side) const { return state_.rental_index(side); }
+
+    /// `side`'s team (the active member is p1_slot().party_index / p2's)
+    [[nodiscard]] const dsl::Party& party(uint8_t side) const { return state_.parties[side]; }
+    [[nodiscard]] uint8_t level() const { return state_.level; }
+
+    /// The whole battle state (what save() copies)
+    [[nodiscard]] const dsl::BattleState& state() const { return state_; }
 
     [[nodiscard]] const dsl::BattleContext& context() const { return ctx_; }
-    [[nodiscard]] dsl::BattleContext& context() { return ctx_; }
+    [[nodiscard]] dsl::BattleContext& context() {
+        legal_valid_ = false;
+        return ctx_;
+    }
+
+    [[nodiscard]] const util::random::Rng& rng() const { return state_.rng; }
+    [[nodiscard]] util::random::Rng& rng() { return state_.rng; }
 
+    /// A side loses when none of its party can battle
     [[nodiscard]] BattleResult result() const {
-        if (p1_setup_.mon.is_fainted())
+        if (state_.mon(0).is_fainted() && state_.parties[0].defeated())
             return BattleResult::P2_WINS;
-        if (p2_setup_.mon.is_fainted())
+        if (state_.mon(1).is_fainted() && state_.parties[1].defeated())
             return BattleResult::P1_WINS;
         return BattleResult::ONGOING;
     }
@@ -129,44 +603,75 @@ class BattleEngine {
     // ========================================================================
 
     void execute_action(uint8_t actor_slot, const BattleAction& action);
-    void execute_move(uint8_t actor_slot, uint8_t move_index);
+    /// `power` overrides the move's base power when non-zero (Pursuit on a switch)
+    void execute_move(uint8_t actor_slot, uint8_t move_index, uint16_t power = 0);
+    /// The move slot `move_index` stands for this turn (Struggle with no legal move)
+    [[nodiscard]] types::enums::Move chosen_move(uint8_t slot, uint8_t move_index) const;
+    /// Take the PP of a move used from `move_index` (Pressure on the foe costs one more)
+    void deduct_pp(uint8_t actor_slot, uint8_t move_index);
+    /// Baton Pass: send in the first living benched member in party order
+    void resolve_switch_out(uint8_t actor_slot);
+
+    /// OnItemCheck for both battlers (berries), after each move and at turn end
+    void fire_item_checks();
+
+    /// One leaf of preview(): run `action` on a scratch state, drawing from `tape`
+    /// (nullptr: an action that never draws, whose one leaf has probability one)
+    [[nodiscard]] ActionPreview preview_leaf(uint8_t side, const BattleAction& action,
+                                             util::random::DrawTape* tape) const;
 
     // ========================================================================
     //                           HELPERS
     // ========================================================================
 
+    /// First step of init(): fresh state, level and RNG
+    void reset(uint8_t level, const util::random::Rng& rng);
+    /// Append a member to `side`'s party (the first becomes the lead)
+    void add_member(uint8_t side, const types::Rental& rental,
+                    const logic::setup::RentalSetup& setup, uint16_t rental_index);
+    /// Last step of init(): journal restart, wiring, entry abilities
+    void begin();
+    void wire_context();
+    /// Entry abilities (Intimidate, weather), faster battler first
+    void fire_entry_abilities();
     void set_attacker(uint8_t slot);
 
-    [[nodiscard]] logic::state::MonState& get_mon(uint8_t slot) {
-        return (slot == 0) ? p1_setup_.mon : p2_setup_.mon;
-    }
+    [[nodiscard]] logic::state::MonState& get_mon(uint8_t slot) { return state_.mon(slot); }
 
     [[nodiscard]] logic::state::SlotState& get_slot(uint8_t slot) {
-        return (slot == 0) ? p1_setup_.slot : p2_setup_.slot;
+        return state_.slots[slot];
     }
 
     [[nodiscard]] const types::Rental& get_rental(uint8_t slot) const {
-        return (slot == 0) ? *p1_rental_ : *p2_rental_;
+        return state_.rental(slot);
     }
 
-    [[nodiscard]] static const types::Move& lookup_move(types::enums::Move move_id);
+    [[nodiscard]] static const types::MoveHot& lookup_move(types::enums::Move move_id);
 
     // ========================================================================
     //                             STATE
     // ========================================================================
 
+    dsl::BattleState state_{};
     dsl::BattleContext ctx_{};
-    logic::state::FieldState field_{};
-    logic::state::SideState p1_side_{};
-    logic::state::SideState p2_side_{};
 
-    logic::setup::RentalSetup p1_setup_{};
-    logic::setup::RentalSetup p2_setup_{};
+    bool common_random_numbers_{false};
+
+    logic::state::UndoJournal* journal_{nullptr};
+    BattleLogWriter* log_{nullptr};
+    logic::state::EventQueue* events_{nullptr};
+    util::random::DrawLog* draw_log_{nullptr};
+
+    // Hash upkeep starts with the first hash() call
+    mutable logic::state::StateHasher hasher_{};
+    mutable bool hashing_{false};
 
-    const types::Rental* p1_rental_{nullptr};
-    const types::Rental* p2_rental_{nullptr};
+    // legal_actions() cache
+    mutable ActionMask legal_[2]{};
+    mutable bool legal_valid_{false};
 
-    uint8_t level_{50};
+    // Bit per side with no legal move at the start of the running turn
+    uint8_t struggling_{0};
 };
 
 }  // namespace engine
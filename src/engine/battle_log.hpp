@@ -0,0 +1,374 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "battle.hpp"
+#include "rules.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                              BATTLE LOG
+// ============================================================================
+//
+// Append-only record of a battle: everything needed to re-execute it
+// bit-identically is the initial RNG, the two rentals, the level and the
+// action pair of every turn. A log is ~1 byte per turn instead of a full
+// state dump, so whole sweeps can be kept and the interesting battles
+// replayed later with BattleEngine::replay().
+//
+// Byte layout (little-endian, identical on eZ80 and host):
+//
+//   header   'B' 'L' version rules level  p1:u16  p2:u16  rng.state:u64  rng.inc:u64
+//   turn     (p1_code << 4) | p2_code                        one byte per turn
+//   check    0xFF  fingerprint:u32   checkpoint_fingerprint() after the turn
+//   end      0xFE
+//
+// Checkpoints are written every N turns (N = 0: none) and always after the
+// last turn.
+//
+// Action codes: MOVE i -> i (0-3), SWITCH i -> 4 + i (4-9), RUN -> 10. Both
+// codes are below 0xF, so turn bytes never collide with the markers.
+// Checkpoints let replay() detect divergence (e.g. an engine change) at the
+// first turn that went wrong instead of at the end. `rules` is the
+// RULES_VERSION (rules.hpp) the battle was played under: a log of other
+// rules is refused up front (ReplayStatus::OLD_RULES).
+//
+// ============================================================================
+
+inline constexpr uint8_t LOG_MAGIC_0 = 'B';
+inline constexpr uint8_t LOG_MAGIC_1 = 'L';
+inline constexpr uint8_t LOG_VERSION = 2;
+inline constexpr size_t LOG_HEADER_SIZE = 25;
+
+inline constexpr uint8_t LOG_CHECKPOINT = 0xFF;
+inline constexpr size_t LOG_CHECKPOINT_SIZE = 5;
+inline constexpr uint8_t LOG_END = 0xFE;
+
+/// Bytes a log of `turns` turns needs, with a checkpoint every `interval`
+constexpr size_t log_capacity(uint32_t turns, uint16_t interval = 0) {
+    const size_t checkpoints = (interval ? turns / interval : 0) + 1;  // + closing checkpoint
+    return LOG_HEADER_SIZE + turns + checkpoints * LOG_CHECKPOINT_SIZE + 1;
+}
+
+/**
+ * @brief 32-bit digest of a battle stored in checkpoints.
+ *
+ * The RNG alone only tracks the number of draws, so the digest also folds
+ * in both battlers' HP and status: a different move that happens to make
+ * the same draws still shows up at the next checkpoint.
+ */
+inline uint32_t checkpoint_fingerprint(const BattleEngine& battle) {
+    const util::random::Rng& rng = battle.rng();
+    const auto& p1 = battle.p1_mon();
+    const auto& p2 = battle.p2_mon();
+
+    uint32_t digest = static_cast<uint32_t>(rng.state ^ (rng.state >> 32));
+    digest ^= p1.current_hp | (static_cast<uint32_t>(p2.current_hp) << 16);
+    digest ^= (static_cast<uint32_t>(p1.status) << 8 | static_cast<uint32_t>(p2.status)) *
+              0x9E3779B1u;
+    return digest;
+}
+
+/// 4-bit log code of an action (0xF for actions the format cannot hold)
+constexpr uint8_t encode_action(const BattleAction& action) {
+    switch (action.type) {
+        case BattleAction::Type::MOVE:
+            return action.index < 4 ? action.index : 0xF;
+        case BattleAction::Type::SWITCH:
+            return action.index < 6 ? static_cast<uint8_t>(4 + action.index) : 0xF;
+        case BattleAction::Type::RUN:
+            return 10;
+    }
+    return 0xF;
+}
+
+/// Inverse of encode_action(); false for codes outside 0-10
+constexpr bool decode_action(uint8_t code, BattleAction& action) {
+    if (code < 4) {
+        action = BattleAction::move(code);
+    } else if (code < 10) {
+        action = BattleAction::switch_to(static_cast<uint8_t>(code - 4));
+    } else if (code == 10) {
+        action = BattleAction{BattleAction::Type::RUN, 0};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/// Read-only view of one encoded log
+struct BattleLog {
+    const uint8_t* data{nullptr};
+    size_t size{0};
+};
+
+/// Decoded log header
+struct BattleLogHeader {
+    uint8_t rules{RULES_VERSION};  // Rules the battle was played under
+    uint8_t level{50};
+    uint16_t p1_rental{0};  // Index into data::g_RENTAL_SETS
+    uint16_t p2_rental{0};
+    util::random::Rng rng{};
+};
+
+// ============================================================================
+//                              ENCODING
+// ============================================================================
+
+namespace log_detail {
+
+inline void put_u16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void put_u32(uint8_t* out, uint32_t value) {
+    for (uint8_t i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+inline void put_u64(uint8_t* out, uint64_t value) {
+    put_u32(out, static_cast<uint32_t>(value));
+    put_u32(out + 4, static_cast<uint32_t>(value >> 32));
+}
+
+inline uint16_t get_u16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t get_u32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+inline uint64_t get_u64(const uint8_t* in) {
+    return get_u32(in) | (static_cast<uint64_t>(get_u32(in + 4)) << 32);
+}
+
+}  // namespace log_detail
+
+/**
+ * @brief Parse the header of a log.
+ *
+ * @return false if the log is too short, has the wrong magic or version
+ */
+inline bool read_log_header(const BattleLog& log, BattleLogHeader& header) {
+    if (!log.data || log.size < LOG_HEADER_SIZE || log.data[0] != LOG_MAGIC_0 ||
+        log.data[1] != LOG_MAGIC_1 || log.data[2] != LOG_VERSION) {
+        return false;
+    }
+    header.rules = log.data[3];
+    header.level = log.data[4];
+    header.p1_rental = log_detail::get_u16(log.data + 5);
+    header.p2_rental = log_detail::get_u16(log.data + 7);
+    header.rng.state = log_detail::get_u64(log.data + 9);
+    header.rng.inc = log_detail::get_u64(log.data + 17);
+    return true;
+}
+
+/**
+ * @brief Size of the log starting at `data` (through its end marker).
+ *
+ * Splits a stream of concatenated logs.
+ *
+ * @return Byte count, or 0 if no complete log starts at `data`
+ */
+inline size_t log_extent(const uint8_t* data, size_t size) {
+    BattleLogHeader header;
+    if (!read_log_header(BattleLog{data, size}, header)) {
+        return 0;
+    }
+    for (size_t i = LOG_HEADER_SIZE; i < size;) {
+        if (data[i] == LOG_END) {
+            return i + 1;
+        }
+        i += data[i] == LOG_CHECKPOINT ? LOG_CHECKPOINT_SIZE : 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Steps through the body of a log one item at a time.
+ *
+ * Starts after the header by default; keyframe seeking starts it at a
+ * recorded (offset, turn) pair instead.
+ */
+class BattleLogReader {
+   public:
+    enum class Item : uint8_t {
+        TURN,        // p1_action() / p2_action() hold the turn's actions
+        CHECKPOINT,  // fingerprint() holds the recorded digest
+        FINISHED,  // End marker read (not END: the effect DSL defines that macro)
+        CORRUPT,
+        TRUNCATED,
+    };
+
+    explicit BattleLogReader(const BattleLog& log, size_t offset = LOG_HEADER_SIZE,
+                             uint32_t turn = 0)
+        : log_(log), offset_(offset), turn_(turn) {}
+
+    Item next() {
+        if (done_)
+            return Item::FINISHED;
+        if (offset_ >= log_.size)
+            return stop(Item::TRUNCATED);
+
+        const uint8_t byte = log_.data[offset_];
+        if (byte == LOG_END) {
+            ++offset_;
+            return stop(Item::FINISHED);
+        }
+        if (byte == LOG_CHECKPOINT) {
+            if (offset_ + LOG_CHECKPOINT_SIZE > log_.size)
+                return stop(Item::TRUNCATED);
+            fingerprint_ = log_detail::get_u32(log_.data + offset_ + 1);
+            offset_ += LOG_CHECKPOINT_SIZE;
+            return Item::CHECKPOINT;
+        }
+        if (!decode_action(byte >> 4, p1_action_) || !decode_action(byte & 0xF, p2_action_))
+            return stop(Item::CORRUPT);
+        ++offset_;
+        ++turn_;
+        return Item::TURN;
+    }
+
+    [[nodiscard]] const BattleAction& p1_action() const { return p1_action_; }
+    [[nodiscard]] const BattleAction& p2_action() const { return p2_action_; }
+    [[nodiscard]] uint32_t fingerprint() const { return fingerprint_; }
+
+    /// Turns read so far (including the starting turn)
+    [[nodiscard]] uint32_t turn() const { return turn_; }
+    /// Byte offset of the next item
+    [[nodiscard]] size_t offset() const { return offset_; }
+    /// True once the end marker (or an error) has been read
+    [[nodiscard]] bool done() const { return done_; }
+
+   private:
+    Item stop(Item item) {
+        done_ = true;
+        return item;
+    }
+
+    BattleLog log_;
+    size_t offset_;
+    uint32_t turn_;
+    uint32_t fingerprint_{0};
+    BattleAction p1_action_{};
+    BattleAction p2_action_{};
+    bool done_{false};
+};
+
+/**
+ * @brief Appends a battle log into a caller-owned buffer.
+ *
+ * No allocation: the buffer is sized by the caller (see log_capacity()).
+ * Every append reports failure once the buffer is full, and the writer
+ * stays failed, so a truncated log is never mistaken for a complete one.
+ */
+class BattleLogWriter {
+   public:
+    BattleLogWriter(uint8_t* buffer, size_t capacity, uint16_t checkpoint_interval = 0)
+        : buffer_(buffer), capacity_(capacity), interval_(checkpoint_interval) {}
+
+    /**
+     * @brief Start a new log (discards anything written before).
+     *
+     * @return false if the buffer cannot hold a header
+     */
+    bool begin(const BattleLogHeader& header) {
+        size_ = 0;
+        turns_ = 0;
+        ok_ = capacity_ >= LOG_HEADER_SIZE;
+        if (!ok_)
+            return false;
+
+        buffer_[0] = LOG_MAGIC_0;
+        buffer_[1] = LOG_MAGIC_1;
+        buffer_[2] = LOG_VERSION;
+        buffer_[3] = header.rules;
+        buffer_[4] = header.level;
+        log_detail::put_u16(buffer_ + 5, header.p1_rental);
+        log_detail::put_u16(buffer_ + 7, header.p2_rental);
+        log_detail::put_u64(buffer_ + 9, header.rng.state);
+        log_detail::put_u64(buffer_ + 17, header.rng.inc);
+        size_ = LOG_HEADER_SIZE;
+        return true;
+    }
+
+    /// Append one turn's actions
+    bool record_turn(const BattleAction& p1_action, const BattleAction& p2_action) {
+        const uint8_t p1 = encode_action(p1_action);
+        const uint8_t p2 = encode_action(p2_action);
+        if (p1 == 0xF || p2 == 0xF) {
+            ok_ = false;
+        }
+        if (!reserve(1))
+            return false;
+        buffer_[size_++] = static_cast<uint8_t>((p1 << 4) | p2);
+        ++turns_;
+        return true;
+    }
+
+    /// Append a checkpoint if one is due after this turn
+    bool end_turn(uint32_t fingerprint) {
+        if (interval_ == 0 || turns_ % interval_ != 0)
+            return ok_;
+        return checkpoint(fingerprint);
+    }
+
+    /// Append a checkpoint now
+    bool checkpoint(uint32_t fingerprint) {
+        if (!reserve(LOG_CHECKPOINT_SIZE))
+            return false;
+        buffer_[size_] = LOG_CHECKPOINT;
+        log_detail::put_u32(buffer_ + size_ + 1, fingerprint);
+        size_ += LOG_CHECKPOINT_SIZE;
+        return true;
+    }
+
+    /**
+     * @brief Terminate the log; it is complete only if this returns true.
+     *
+     * Closes with a checkpoint of the final state (unless the last turn
+     * just wrote one), so replay() verifies every battle end to end.
+     *
+     * @param fingerprint checkpoint_fingerprint() after the last turn
+     */
+    bool finish(uint32_t fingerprint) {
+        if ((interval_ == 0 || turns_ % interval_ != 0) && !checkpoint(fingerprint))
+            return false;
+        if (!reserve(1))
+            return false;
+        buffer_[size_++] = LOG_END;
+        return true;
+    }
+
+    [[nodiscard]] bool ok() const { return ok_; }
+    [[nodiscard]] uint32_t turns() const { return turns_; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] BattleLog log() const { return BattleLog{buffer_, size_}; }
+
+   private:
+    bool reserve(size_t bytes) {
+        if (ok_ && size_ + bytes > capacity_) {
+            ok_ = false;
+        }
+        return ok_;
+    }
+
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t size_{0};
+    uint32_t turns_{0};
+    uint16_t interval_;
+    bool ok_{false};
+};
+
+}  // namespace engine
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "logic/state/context.hpp"
+#include "logic/state/packed.hpp"
+#include "util/arena.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                          DELTA-ENCODED NODE STATES
+// ============================================================================
+//
+// Search-tree node storage. A child differs from its parent in a handful of
+// bytes of the packed state (logic/state/packed.hpp): the two HP values, the
+// RNG, the turn clock, the last move used, now and then a stage, a status or
+// a timer. A node therefore stores only (byte offset, new value) pairs
+// against its parent's packed state, and is materialized on demand by
+// walking up to the nearest keyframe (a full PackedBattleState) and applying
+// the deltas on the way back down.
+//
+//   BattleState (working copy)   1152 bytes
+//   PackedBattleState (keyframe) 212 bytes
+//   delta node                   12 bytes + 2 per changed byte (~37 on average)
+//
+// A node becomes a keyframe instead when it is a root, when its delta would
+// be larger than MAX_DELTA_PAIRS, or when its parent chain is already
+// MAX_DELTA_CHAIN deltas long, which bounds materialization at
+// MAX_DELTA_CHAIN small copies.
+//
+// Storage is caller-owned, like KeyframeIndex: a node array, a pair pool
+// and a keyframe array, all fixed for the store's lifetime (make_delta_store
+// takes them from an arena). add_*() return
+// NO_NODE once any of them is full (or the state is not packable), and the
+// caller stops expanding. Nodes are append-only; clear() drops the tree.
+//
+// ============================================================================
+
+/// One changed byte of a packed state
+struct DeltaPair {
+    uint8_t offset;
+    uint8_t value;
+};
+
+struct DeltaNode {
+    uint32_t first;   // First pair in the pool, or keyframe index
+    uint32_t parent;  // NO_NODE for keyframes
+    uint8_t count;    // Pairs (0 for keyframes and unchanged children)
+    uint8_t chain;    // Deltas between this node and its keyframe (0 = keyframe)
+};
+
+/// Longest delta chain before a keyframe is forced
+inline constexpr uint8_t MAX_DELTA_CHAIN = 12;
+
+/// Largest delta worth storing (beyond it a keyframe is about as small)
+inline constexpr uint8_t MAX_DELTA_PAIRS = sizeof(logic::state::PackedBattleState) / 4;
+
+class DeltaStore {
+   public:
+    using PackedBattleState = logic::state::PackedBattleState;
+
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    /**
+     * @param nodes Node array, `node_capacity` entries
+     * @param pairs Pair pool, `pair_capacity` entries
+     * @param keyframes Keyframe array, `keyframe_capacity` entries
+     */
+    DeltaStore(DeltaNode* nodes, uint32_t node_capacity, DeltaPair* pairs, uint32_t pair_capacity,
+               PackedBattleState* keyframes, uint32_t keyframe_capacity)
+        : nodes_(nodes),
+          pairs_(pairs),
+          keyframes_(keyframes),
+          node_capacity_(node_capacity),
+          pair_capacity_(pair_capacity),
+          keyframe_capacity_(keyframe_capacity) {}
+
+    void clear() {
+        node_count_ = 0;
+        pair_count_ = 0;
+        keyframe_count_ = 0;
+    }
+
+    /// Store `state` as a tree root (a keyframe)
+    uint32_t add_root(const dsl::BattleState& state) {
+        if (!logic::state::packable(state))
+            return NO_NODE;
+        return add_keyframe(logic::state::pack(state));
+    }
+
+    /**
+     * @brief Store `state` as a child of `parent`.
+     *
+     * @param parent_packed materialize(parent), if the caller has it at hand
+     */
+    uint32_t add_child(uint32_t parent, const PackedBattleState& parent_packed,
+                       const dsl::BattleState& state) {
+        if (!logic::state::packable(state) || node_count_ == node_capacity_)
+            return NO_NODE;
+        const PackedBattleState packed = logic::state::pack(state);
+        if (nodes_[parent].chain >= MAX_DELTA_CHAIN)
+            return add_keyframe(packed);
+
+        // Diff into the pool tail; only committed if it stays small
+        const uint32_t first = pair_count_;
+        uint32_t count = 0;
+        for (uint8_t i = 0; i < sizeof(packed.bytes); ++i) {
+            if (packed.bytes[i] == parent_packed.bytes[i])
+                continue;
+            if (count == MAX_DELTA_PAIRS || first + count == pair_capacity_)
+                return add_keyframe(packed);
+            pairs_[first + count++] = DeltaPair{i, packed.bytes[i]};
+        }
+
+        pair_count_ += count;
+        nodes_[node_count_] = DeltaNode{first, parent, static_cast<uint8_t>(count),
+                                        static_cast<uint8_t>(nodes_[parent].chain + 1)};
+        return node_count_++;
+    }
+
+    uint32_t add_child(uint32_t parent, const dsl::BattleState& state) {
+        PackedBattleState parent_packed;
+        materialize(parent, parent_packed);
+        return add_child(parent, parent_packed, state);
+    }
+
+    /// Packed state of `node`
+    void materialize(uint32_t node, PackedBattleState& out) const {
+        uint32_t path[MAX_DELTA_CHAIN];
+        uint8_t depth = 0;
+        while (nodes_[node].chain != 0) {
+            path[depth++] = node;
+            node = nodes_[node].parent;
+        }
+        out = keyframes_[nodes_[node].first];
+        while (depth > 0) {
+            const DeltaNode& delta = nodes_[path[--depth]];
+            for (uint32_t p = delta.first; p < delta.first + delta.count; ++p) {
+                out.bytes[pairs_[p].offset] = pairs_[p].value;
+            }
+        }
+    }
+
+    /**
+     * @brief Write `node`'s state into `state`.
+     *
+     * @param state A state of the same battle (rentals and stats are kept),
+     *              e.g. BattleEngine::save() of the root
+     */
+    void restore(uint32_t node, dsl::BattleState& state) const {
+        PackedBattleState packed;
+        materialize(node, packed);
+        logic::state::unpack(packed, state);
+    }
+
+    [[nodiscard]] const DeltaNode& node(uint32_t id) const { return nodes_[id]; }
+    [[nodiscard]] uint32_t node_count() const { return node_count_; }
+    [[nodiscard]] uint32_t pair_count() const { return pair_count_; }
+    [[nodiscard]] uint32_t keyframe_count() const { return keyframe_count_; }
+
+    /// Bytes the stored tree occupies
+    [[nodiscard]] size_t bytes_used() const {
+        return node_count_ * sizeof(DeltaNode) + pair_count_ * sizeof(DeltaPair) +
+               keyframe_count_ * sizeof(PackedBattleState);
+    }
+
+   private:
+    uint32_t add_keyframe(const PackedBattleState& packed) {
+        if (node_count_ == node_capacity_ || keyframe_count_ == keyframe_capacity_)
+            return NO_NODE;
+        keyframes_[keyframe_count_] = packed;
+        nodes_[node_count_] = DeltaNode{keyframe_count_++, NO_NODE, 0, 0};
+        return node_count_++;
+    }
+
+    DeltaNode* nodes_;
+    DeltaPair* pairs_;
+    PackedBattleState* keyframes_;
+    uint32_t node_capacity_;
+    uint32_t pair_capacity_;
+    uint32_t keyframe_capacity_;
+    uint32_t node_count_{0};
+    uint32_t pair_count_{0};
+    uint32_t keyframe_count_{0};
+};
+
+/**
+ * @brief A DeltaStore whose arrays come from `arena`.
+ *
+ * If the arena cannot fit all three, nothing is allocated and the store has
+ * no capacity (every add returns NO_NODE).
+ */
+inline DeltaStore make_delta_store(util::arena::Arena& arena, uint32_t node_capacity,
+                                   uint32_t pair_capacity, uint32_t keyframe_capacity) {
+    const util::arena::Arena::Marker marker = arena.mark();
+    auto* nodes = arena.allocate<DeltaNode>(node_capacity);
+    auto* pairs = arena.allocate<DeltaPair>(pair_capacity);
+    auto* keyframes = arena.allocate<logic::state::PackedBattleState>(keyframe_capacity);
+    if (!nodes || !pairs || !keyframes) {
+        arena.reset(marker);
+        return DeltaStore(nullptr, 0, nullptr, 0, nullptr, 0);
+    }
+    return DeltaStore(nodes, node_capacity, pairs, pair_capacity, keyframes, keyframe_capacity);
+}
+
+}  // namespace engine
@@ -1,8 +1,21 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "data/move.hpp"
+#include "data/pool.hpp"
+#include "data/rental.hpp"
+#include "dsl/effect.hpp"
 #include "logic/routines/all.hpp"
 #include "logic/state/context.hpp"
 #include "types/enums/effect.hpp"
+#include "util/profile.hpp"
+
+#ifndef BATTLEMON_USAGE_ORDERED_DISPATCH
+#define BATTLEMON_USAGE_ORDERED_DISPATCH 1
+#endif
 
 namespace engine {
 
@@ -12,276 +25,524 @@ namespace engine {
 //
 // Dispatches move effects to their corresponding routine implementations.
 //
-// Development approach: All effects start as stubs pointing to Hit::execute.
+// Development approach: All effects start as stubs pointing to Hit.
 // As routines are implemented, the stubs are replaced with the actual routine.
 // This allows incremental development while keeping the game functional.
 //
+// The effect -> routine mapping is written once, in visit_effect_routine();
+// g_EFFECT_DISPATCH (what dispatch_move_effect() runs) and g_EFFECT_TRAITS
+// are built from it at compile time. An effect data::effect_in_build()
+// leaves out (a build without BATTLEMON_FEATURE_OFF_POOL) is visited like
+// Effect::NONE, so both tables drop its routine.
+//
 // NOTE: No default case - the compiler will warn about missing enum values.
 // ============================================================================
 
+/// Number of Effect values (one past the last)
+inline constexpr size_t EFFECT_COUNT = static_cast<size_t>(types::enums::Effect::UPROAR) + 1;
+
+/// Names a routine type for a visit_effect_routine() visitor
+template <typename Routine>
+struct RoutineTag {
+    using type = Routine;
+};
+
+template <typename Routine>
+inline constexpr RoutineTag<Routine> routine{};
+
 /**
- * @brief Execute the effect routine for a given move effect.
+ * @brief Call visit(RoutineTag<R>) with the routine R that runs `effect`.
  *
  * @param effect The effect enum value from the move data
- * @param ctx The battle context with all state pointers set up
+ * @param visit Callable taking any RoutineTag
+ *
+ * @return false for Effect::NONE and effects left out of the build, which run no routine
  */
-inline void dispatch_move_effect(types::enums::Effect effect, dsl::BattleContext& ctx) {
+template <typename Visit>
+constexpr bool visit_effect_routine(types::enums::Effect effect, Visit&& visit) {
     using enum types::enums::Effect;
     using namespace logic::routines;
 
+    if (!data::effect_in_build(effect))
+        return false;
+
     // clang-format off
     switch (effect) {
         // ====================================================================
         //                         HIT EFFECTS (71)
         // ====================================================================
 
-        case HIT:               Hit::execute(ctx); break;
-        case ABSORB:            Absorb::execute(ctx); break;
-        case RECOIL:            TakeDown::execute(ctx); break;
-        case DRAGON_RAGE:       DragonRage::execute(ctx); break;
-        case POISON_HIT:        PoisonHit::execute(ctx); break;
+        case HIT:               visit(routine<Hit>); break;
+        case ABSORB:            visit(routine<Absorb>); break;
+        case RECOIL:            visit(routine<TakeDown>); break;
+        case DRAGON_RAGE:       visit(routine<DragonRage>); break;
+        case POISON_HIT:        visit(routine<PoisonHit>); break;
+        case MULTI_HIT:         visit(routine<MultiHit>); break;
+        case DOUBLE_HIT:        visit(routine<DoubleHit>); break;
+        case TRIPLE_KICK:       visit(routine<TripleKick>); break;
 
         // Stubs - TODO: implement routines
-        case ACC_DOWN_HIT:      Hit::execute(ctx); break;
-        case ALL_STATS_UP_HIT:  Hit::execute(ctx); break;
-        case ATK_DOWN_HIT:      Hit::execute(ctx); break;
-        case ATK_UP_HIT:        Hit::execute(ctx); break;
-        case BEAT_UP:           Hit::execute(ctx); break;
-        case BLAZE_KICK:        Hit::execute(ctx); break;
-        case BRICK_BREAK:       Hit::execute(ctx); break;
-        case BURN_HIT:          Hit::execute(ctx); break;
-        case CONFUSE_HIT:       Hit::execute(ctx); break;
-        case COUNTER:           Hit::execute(ctx); break;
-        case DEF_DOWN_HIT:      Hit::execute(ctx); break;
-        case DEF_UP_HIT:        Hit::execute(ctx); break;
-        case DOUBLE_EDGE:       Hit::execute(ctx); break;
-        case DOUBLE_HIT:        Hit::execute(ctx); break;
-        case DREAM_EATER:       Hit::execute(ctx); break;
-        case EARTHQUAKE:        Hit::execute(ctx); break;
-        case ENDEAVOR:          Hit::execute(ctx); break;
-        case ERUPTION:          Hit::execute(ctx); break;
-        case EVA_DOWN_HIT:      Hit::execute(ctx); break;
-        case EXPLOSION:         Hit::execute(ctx); break;
-        case FACADE:            Hit::execute(ctx); break;
-        case FAKE_OUT:          Hit::execute(ctx); break;
-        case FALSE_SWIPE:       Hit::execute(ctx); break;
-        case FLAIL:             Hit::execute(ctx); break;
-        case FLINCH_HIT:        Hit::execute(ctx); break;
-        case FLINCH_MINIM_HIT:  Hit::execute(ctx); break;
-        case FREEZE_HIT:        Hit::execute(ctx); break;
-        case FRUSTRATION:       Hit::execute(ctx); break;
-        case FURY_CUTTER:       Hit::execute(ctx); break;
-        case GUST:              Hit::execute(ctx); break;
-        case HIDDEN_POWER:      Hit::execute(ctx); break;
-        case HIGH_CRITICAL:     Hit::execute(ctx); break;
-        case LEVEL_DAMAGE:      Hit::execute(ctx); break;
-        case LOW_KICK:          Hit::execute(ctx); break;
-        case MAGNITUDE:         Hit::execute(ctx); break;
-        case MIRROR_COAT:       Hit::execute(ctx); break;
-        case MULTI_HIT:         Hit::execute(ctx); break;
-        case OHKO:              Hit::execute(ctx); break;
-        case PARALYZE_HIT:      Hit::execute(ctx); break;
-        case POISON_FANG:       Hit::execute(ctx); break;
-        case POISON_TAIL:       Hit::execute(ctx); break;
-        case PRESENT:           Hit::execute(ctx); break;
-        case PSYWAVE:           Hit::execute(ctx); break;
-        case PURSUIT:           Pursuit::execute(ctx); break;
-        case QUICK_ATTACK:      Hit::execute(ctx); break;
-        case RECOIL_IF_MISS:    Hit::execute(ctx); break;
-        case RETURN:            Hit::execute(ctx); break;
-        case REVENGE:           Hit::execute(ctx); break;
-        case ROLLOUT:           Hit::execute(ctx); break;
-        case SECRET_POWER:      Hit::execute(ctx); break;
-        case SKY_UPPERCUT:      Hit::execute(ctx); break;
-        case SMELLINGSALT:      Hit::execute(ctx); break;
-        case SONICBOOM:         Hit::execute(ctx); break;
-        case SP_ATK_DOWN_HIT:   Hit::execute(ctx); break;
-        case SP_DEF_DOWN_HIT:   Hit::execute(ctx); break;
-        case SPD_DOWN_HIT:      Hit::execute(ctx); break;
-        case SUPER_FANG:        Hit::execute(ctx); break;
-        case THAW_HIT:          Hit::execute(ctx); break;
-        case THUNDER:           Hit::execute(ctx); break;
-        case TRAP:              Hit::execute(ctx); break;
-        case TRI_ATTACK:        Hit::execute(ctx); break;
-        case TRIPLE_KICK:       Hit::execute(ctx); break;
-        case TWINEEDLE:         Hit::execute(ctx); break;
-        case TWISTER:           Hit::execute(ctx); break;
-        case VITAL_THROW:       Hit::execute(ctx); break;
-        case WEATHER_BALL:      Hit::execute(ctx); break;
+        case ACC_DOWN_HIT:      visit(routine<Hit>); break;
+        case ALL_STATS_UP_HIT:  visit(routine<Hit>); break;
+        case ATK_DOWN_HIT:      visit(routine<Hit>); break;
+        case ATK_UP_HIT:        visit(routine<Hit>); break;
+        case BEAT_UP:           visit(routine<Hit>); break;
+        case BLAZE_KICK:        visit(routine<Hit>); break;
+        case BRICK_BREAK:       visit(routine<Hit>); break;
+        case BURN_HIT:          visit(routine<Hit>); break;
+        case CONFUSE_HIT:       visit(routine<Hit>); break;
+        case COUNTER:           visit(routine<Hit>); break;
+        case DEF_DOWN_HIT:      visit(routine<Hit>); break;
+        case DEF_UP_HIT:        visit(routine<Hit>); break;
+        case DOUBLE_EDGE:       visit(routine<Hit>); break;
+        case DREAM_EATER:       visit(routine<Hit>); break;
+        case EARTHQUAKE:        visit(routine<Hit>); break;
+        case ENDEAVOR:          visit(routine<Hit>); break;
+        case ERUPTION:          visit(routine<Hit>); break;
+        case EVA_DOWN_HIT:      visit(routine<Hit>); break;
+        case EXPLOSION:         visit(routine<Hit>); break;
+        case FACADE:            visit(routine<Hit>); break;
+        case FAKE_OUT:          visit(routine<Hit>); break;
+        case FALSE_SWIPE:       visit(routine<Hit>); break;
+        case FLAIL:             visit(routine<Hit>); break;
+        case FLINCH_HIT:        visit(routine<Hit>); break;
+        case FLINCH_MINIM_HIT:  visit(routine<Hit>); break;
+        case FREEZE_HIT:        visit(routine<Hit>); break;
+        case FRUSTRATION:       visit(routine<Hit>); break;
+        case FURY_CUTTER:       visit(routine<Hit>); break;
+        case GUST:              visit(routine<Hit>); break;
+        case HIDDEN_POWER:      visit(routine<Hit>); break;
+        case HIGH_CRITICAL:     visit(routine<Hit>); break;
+        case LEVEL_DAMAGE:      visit(routine<Hit>); break;
+        case LOW_KICK:          visit(routine<Hit>); break;
+        case MAGNITUDE:         visit(routine<Hit>); break;
+        case MIRROR_COAT:       visit(routine<Hit>); break;
+        case OHKO:              visit(routine<Hit>); break;
+        case PARALYZE_HIT:      visit(routine<Hit>); break;
+        case POISON_FANG:       visit(routine<Hit>); break;
+        case POISON_TAIL:       visit(routine<Hit>); break;
+        case PRESENT:           visit(routine<Hit>); break;
+        case PSYWAVE:           visit(routine<Hit>); break;
+        case PURSUIT:           visit(routine<Pursuit>); break;
+        case QUICK_ATTACK:      visit(routine<Hit>); break;
+        case RECOIL_IF_MISS:    visit(routine<Hit>); break;
+        case RETURN:            visit(routine<Hit>); break;
+        case REVENGE:           visit(routine<Hit>); break;
+        case ROLLOUT:           visit(routine<Hit>); break;
+        case SECRET_POWER:      visit(routine<Hit>); break;
+        case SKY_UPPERCUT:      visit(routine<Hit>); break;
+        case SMELLINGSALT:      visit(routine<Hit>); break;
+        case SONICBOOM:         visit(routine<Hit>); break;
+        case SP_ATK_DOWN_HIT:   visit(routine<Hit>); break;
+        case SP_DEF_DOWN_HIT:   visit(routine<Hit>); break;
+        case SPD_DOWN_HIT:      visit(routine<Hit>); break;
+        case SUPER_FANG:        visit(routine<Hit>); break;
+        case THAW_HIT:          visit(routine<Hit>); break;
+        case THUNDER:           visit(routine<Hit>); break;
+        case TRAP:              visit(routine<Hit>); break;
+        case TRI_ATTACK:        visit(routine<Hit>); break;
+        case TWINEEDLE:         visit(routine<Hit>); break;
+        case TWISTER:           visit(routine<Hit>); break;
+        case VITAL_THROW:       visit(routine<Hit>); break;
+        case WEATHER_BALL:      visit(routine<Hit>); break;
 
         // ====================================================================
         //                        STAT EFFECTS (41)
         // ====================================================================
 
-        case ATK_UP_2:          AttackUp2::execute(ctx); break;
-        case ATK_DOWN:          AttackDown1::execute(ctx); break;
-        case HAZE:              Haze::execute(ctx); break;
+        case ATK_UP_2:          visit(routine<AttackUp2>); break;
+        case ATK_DOWN:          visit(routine<AttackDown1>); break;
+        case HAZE:              visit(routine<Haze>); break;
 
         // Stubs
-        case ACC_DOWN:          Hit::execute(ctx); break;
-        case ACC_DOWN_2:        Hit::execute(ctx); break;
-        case ACC_UP:            Hit::execute(ctx); break;
-        case ACC_UP_2:          Hit::execute(ctx); break;
-        case ATK_DOWN_2:        Hit::execute(ctx); break;
-        case ATK_UP:            Hit::execute(ctx); break;
-        case BELLY_DRUM:        Hit::execute(ctx); break;
-        case BULK_UP:           Hit::execute(ctx); break;
-        case CALM_MIND:         Hit::execute(ctx); break;
-        case COSMIC_POWER:      Hit::execute(ctx); break;
-        case DEF_CURL:          Hit::execute(ctx); break;
-        case DEF_DOWN:          Hit::execute(ctx); break;
-        case DEF_DOWN_2:        Hit::execute(ctx); break;
-        case DEF_UP:            Hit::execute(ctx); break;
-        case DEF_UP_2:          Hit::execute(ctx); break;
-        case DRAGON_DANCE:      Hit::execute(ctx); break;
-        case EVA_DOWN:          Hit::execute(ctx); break;
-        case EVA_DOWN_2:        Hit::execute(ctx); break;
-        case EVA_UP:            Hit::execute(ctx); break;
-        case EVA_UP_2:          Hit::execute(ctx); break;
-        case FLATTER:           Hit::execute(ctx); break;
-        case FOCUS_ENERGY:      Hit::execute(ctx); break;
-        case MINIMIZE:          Hit::execute(ctx); break;
-        case PSYCH_UP:          Hit::execute(ctx); break;
-        case SP_ATK_DOWN:       Hit::execute(ctx); break;
-        case SP_ATK_DOWN_2:     Hit::execute(ctx); break;
-        case SP_ATK_UP:         Hit::execute(ctx); break;
-        case SP_ATK_UP_2:       Hit::execute(ctx); break;
-        case SP_DEF_DOWN:       Hit::execute(ctx); break;
-        case SP_DEF_DOWN_2:     Hit::execute(ctx); break;
-        case SP_DEF_UP:         Hit::execute(ctx); break;
-        case SP_DEF_UP_2:       Hit::execute(ctx); break;
-        case SPD_DOWN:          Hit::execute(ctx); break;
-        case SPD_DOWN_2:        Hit::execute(ctx); break;
-        case SPD_UP:            Hit::execute(ctx); break;
-        case SPD_UP_2:          Hit::execute(ctx); break;
-        case SWAGGER:           Hit::execute(ctx); break;
-        case TICKLE:            Hit::execute(ctx); break;
+        case ACC_DOWN:          visit(routine<Hit>); break;
+        case ACC_DOWN_2:        visit(routine<Hit>); break;
+        case ACC_UP:            visit(routine<Hit>); break;
+        case ACC_UP_2:          visit(routine<Hit>); break;
+        case ATK_DOWN_2:        visit(routine<Hit>); break;
+        case ATK_UP:            visit(routine<Hit>); break;
+        case BELLY_DRUM:        visit(routine<Hit>); break;
+        case BULK_UP:           visit(routine<Hit>); break;
+        case CALM_MIND:         visit(routine<Hit>); break;
+        case COSMIC_POWER:      visit(routine<Hit>); break;
+        case DEF_CURL:          visit(routine<Hit>); break;
+        case DEF_DOWN:          visit(routine<Hit>); break;
+        case DEF_DOWN_2:        visit(routine<Hit>); break;
+        case DEF_UP:            visit(routine<Hit>); break;
+        case DEF_UP_2:          visit(routine<Hit>); break;
+        case DRAGON_DANCE:      visit(routine<Hit>); break;
+        case EVA_DOWN:          visit(routine<Hit>); break;
+        case EVA_DOWN_2:        visit(routine<Hit>); break;
+        case EVA_UP:            visit(routine<Hit>); break;
+        case EVA_UP_2:          visit(routine<Hit>); break;
+        case FLATTER:           visit(routine<Hit>); break;
+        case FOCUS_ENERGY:      visit(routine<Hit>); break;
+        case MINIMIZE:          visit(routine<Hit>); break;
+        case PSYCH_UP:          visit(routine<Hit>); break;
+        case SP_ATK_DOWN:       visit(routine<Hit>); break;
+        case SP_ATK_DOWN_2:     visit(routine<Hit>); break;
+        case SP_ATK_UP:         visit(routine<Hit>); break;
+        case SP_ATK_UP_2:       visit(routine<Hit>); break;
+        case SP_DEF_DOWN:       visit(routine<Hit>); break;
+        case SP_DEF_DOWN_2:     visit(routine<Hit>); break;
+        case SP_DEF_UP:         visit(routine<Hit>); break;
+        case SP_DEF_UP_2:       visit(routine<Hit>); break;
+        case SPD_DOWN:          visit(routine<Hit>); break;
+        case SPD_DOWN_2:        visit(routine<Hit>); break;
+        case SPD_UP:            visit(routine<Hit>); break;
+        case SPD_UP_2:          visit(routine<Hit>); break;
+        case SWAGGER:           visit(routine<Hit>); break;
+        case TICKLE:            visit(routine<Hit>); break;
 
         // ====================================================================
         //                       STATUS EFFECTS (25)
         // ====================================================================
 
-        case POISON:            Poison::execute(ctx); break;
-        case RESTORE_HP:        Recover::execute(ctx); break;
+        case POISON:            visit(routine<Poison>); break;
+        case RESTORE_HP:        visit(routine<Recover>); break;
 
         // Stubs
-        case ATTRACT:           Hit::execute(ctx); break;
-        case CONFUSE:           Hit::execute(ctx); break;
-        case CURSE:             Hit::execute(ctx); break;
-        case DISABLE:           Hit::execute(ctx); break;
-        case ENCORE:            Hit::execute(ctx); break;
-        case HEAL_BELL:         Hit::execute(ctx); break;
-        case LEECH_SEED:        Hit::execute(ctx); break;
-        case MOONLIGHT:         Hit::execute(ctx); break;
-        case MORNING_SUN:       Hit::execute(ctx); break;
-        case NIGHTMARE:         Hit::execute(ctx); break;
-        case PAIN_SPLIT:        Hit::execute(ctx); break;
-        case PARALYZE:          Hit::execute(ctx); break;
-        case REFRESH:           Hit::execute(ctx); break;
-        case REST:              Hit::execute(ctx); break;
-        case SLEEP:             Hit::execute(ctx); break;
-        case SOFTBOILED:        Hit::execute(ctx); break;
-        case SPITE:             Hit::execute(ctx); break;
-        case SYNTHESIS:         Hit::execute(ctx); break;
-        case TAUNT:             Hit::execute(ctx); break;
-        case TORMENT:           Hit::execute(ctx); break;
-        case TOXIC:             Hit::execute(ctx); break;
-        case WILL_O_WISP:       Hit::execute(ctx); break;
-        case YAWN:              Hit::execute(ctx); break;
+        case ATTRACT:           visit(routine<Hit>); break;
+        case CONFUSE:           visit(routine<Hit>); break;
+        case CURSE:             visit(routine<Hit>); break;
+        case DISABLE:           visit(routine<Hit>); break;
+        case ENCORE:            visit(routine<Hit>); break;
+        case HEAL_BELL:         visit(routine<Hit>); break;
+        case LEECH_SEED:        visit(routine<Hit>); break;
+        case MOONLIGHT:         visit(routine<Hit>); break;
+        case MORNING_SUN:       visit(routine<Hit>); break;
+        case NIGHTMARE:         visit(routine<Hit>); break;
+        case PAIN_SPLIT:        visit(routine<Hit>); break;
+        case PARALYZE:          visit(routine<Hit>); break;
+        case REFRESH:           visit(routine<Hit>); break;
+        case REST:              visit(routine<Hit>); break;
+        case SLEEP:             visit(routine<Hit>); break;
+        case SOFTBOILED:        visit(routine<Hit>); break;
+        case SPITE:             visit(routine<Hit>); break;
+        case SYNTHESIS:         visit(routine<Hit>); break;
+        case TAUNT:             visit(routine<Hit>); break;
+        case TORMENT:           visit(routine<Hit>); break;
+        case TOXIC:             visit(routine<Hit>); break;
+        case WILL_O_WISP:       visit(routine<Hit>); break;
+        case YAWN:              visit(routine<Hit>); break;
 
         // ====================================================================
         //                        FIELD EFFECTS (24)
         // ====================================================================
 
-        case LIGHT_SCREEN:      LightScreen::execute(ctx); break;
-        case REFLECT:           Reflect::execute(ctx); break;
-        case SANDSTORM:         Sandstorm::execute(ctx); break;
-        case SUNNY_DAY:         SunnyDay::execute(ctx); break;
-        case RAIN_DANCE:        RainDance::execute(ctx); break;
-        case HAIL:              HailEffect::execute(ctx); break;
+        case LIGHT_SCREEN:      visit(routine<LightScreen>); break;
+        case REFLECT:           visit(routine<Reflect>); break;
+        case SANDSTORM:         visit(routine<Sandstorm>); break;
+        case SUNNY_DAY:         visit(routine<SunnyDay>); break;
+        case RAIN_DANCE:        visit(routine<RainDance>); break;
+        case HAIL:              visit(routine<HailEffect>); break;
 
         // Stubs
-        case ENDURE:            Hit::execute(ctx); break;
-        case FOLLOW_ME:         Hit::execute(ctx); break;
-        case FUTURE_SIGHT:      Hit::execute(ctx); break;
-        case INGRAIN:           Hit::execute(ctx); break;
-        case KNOCK_OFF:         Hit::execute(ctx); break;
-        case MAGIC_COAT:        MagicCoat::execute(ctx); break;
-        case MIST:              Hit::execute(ctx); break;
-        case MUD_SPORT:         Hit::execute(ctx); break;
-        case PROTECT:           Hit::execute(ctx); break;
-        case RAPID_SPIN:        Hit::execute(ctx); break;
-        case RECYCLE:           Hit::execute(ctx); break;
-        case SAFEGUARD:         Hit::execute(ctx); break;
-        case SNATCH:            Hit::execute(ctx); break;
-        case SPIKES:            Hit::execute(ctx); break;
-        case SUBSTITUTE:        Hit::execute(ctx); break;
-        case TRICK:             Hit::execute(ctx); break;
-        case WATER_SPORT:       Hit::execute(ctx); break;
-        case WISH:              Hit::execute(ctx); break;
+        case ENDURE:            visit(routine<Hit>); break;
+        case FOLLOW_ME:         visit(routine<Hit>); break;
+        case FUTURE_SIGHT:      visit(routine<Hit>); break;
+        case INGRAIN:           visit(routine<Hit>); break;
+        case KNOCK_OFF:         visit(routine<Hit>); break;
+        case MAGIC_COAT:        visit(routine<MagicCoat>); break;
+        case MIST:              visit(routine<Hit>); break;
+        case MUD_SPORT:         visit(routine<Hit>); break;
+        case PROTECT:           visit(routine<Hit>); break;
+        case RAPID_SPIN:        visit(routine<Hit>); break;
+        case RECYCLE:           visit(routine<Hit>); break;
+        case SAFEGUARD:         visit(routine<Hit>); break;
+        case SNATCH:            visit(routine<Hit>); break;
+        case SPIKES:            visit(routine<Hit>); break;
+        case SUBSTITUTE:        visit(routine<Hit>); break;
+        case TRICK:             visit(routine<Hit>); break;
+        case WATER_SPORT:       visit(routine<Hit>); break;
+        case WISH:              visit(routine<Hit>); break;
 
         // ====================================================================
         //                      COMPOSITE EFFECTS (48)
         // ====================================================================
 
-        case SKY_ATTACK:        SkyAttack::execute(ctx); break;
-        case BATON_PASS:        BatonPass::execute(ctx); break;
-        case PERISH_SONG:       PerishSong::execute(ctx); break;
+        case SKY_ATTACK:        visit(routine<SkyAttack>); break;
+        case BATON_PASS:        visit(routine<BatonPass>); break;
+        case PERISH_SONG:       visit(routine<PerishSong>); break;
+        case ROAR:              visit(routine<Roar>); break;
 
         // Stubs
-        case ALWAYS_HIT:        Hit::execute(ctx); break;
-        case ASSIST:            Hit::execute(ctx); break;
-        case BIDE:              Hit::execute(ctx); break;
-        case CAMOUFLAGE:        Hit::execute(ctx); break;
-        case CHARGE:            Hit::execute(ctx); break;
-        case CONVERSION:        Hit::execute(ctx); break;
-        case CONVERSION_2:      Hit::execute(ctx); break;
-        case DESTINY_BOND:      Hit::execute(ctx); break;
-        case FOCUS_PUNCH:       Hit::execute(ctx); break;
-        case FORESIGHT:         Hit::execute(ctx); break;
-        case GRUDGE:            Hit::execute(ctx); break;
-        case HELPING_HAND:      Hit::execute(ctx); break;
-        case IMPRISON:          Hit::execute(ctx); break;
-        case LOCK_ON:           Hit::execute(ctx); break;
-        case MEAN_LOOK:         Hit::execute(ctx); break;
-        case MEMENTO:           Hit::execute(ctx); break;
-        case METRONOME:         Hit::execute(ctx); break;
-        case MIMIC:             Hit::execute(ctx); break;
-        case MIRROR_MOVE:       Hit::execute(ctx); break;
-        case NATURE_POWER:      Hit::execute(ctx); break;
-        case OVERHEAT:          Hit::execute(ctx); break;
-        case PAY_DAY:           Hit::execute(ctx); break;
-        case RAGE:              Hit::execute(ctx); break;
-        case RAMPAGE:           Hit::execute(ctx); break;
-        case RAZOR_WIND:        Hit::execute(ctx); break;
-        case RECHARGE:          Hit::execute(ctx); break;
-        case ROAR:              Hit::execute(ctx); break;
-        case ROLE_PLAY:         Hit::execute(ctx); break;
-        case SEMI_INVUL:        Hit::execute(ctx); break;
-        case SKETCH:            Hit::execute(ctx); break;
-        case SKILL_SWAP:        Hit::execute(ctx); break;
-        case SKULL_BASH:        Hit::execute(ctx); break;
-        case SLEEP_TALK:        Hit::execute(ctx); break;
-        case SNORE:             Hit::execute(ctx); break;
-        case SOLAR_BEAM:        Hit::execute(ctx); break;
-        case SPIT_UP:           Hit::execute(ctx); break;
-        case SPLASH:            Hit::execute(ctx); break;
-        case STOCKPILE:         Hit::execute(ctx); break;
-        case SUPERPOWER:        Hit::execute(ctx); break;
-        case SWALLOW:           Hit::execute(ctx); break;
-        case TEETER_DANCE:      Hit::execute(ctx); break;
-        case TELEPORT:          Hit::execute(ctx); break;
-        case THIEF:             Hit::execute(ctx); break;
-        case TRANSFORM:         Hit::execute(ctx); break;
-        case UPROAR:            Hit::execute(ctx); break;
+        case ALWAYS_HIT:        visit(routine<Hit>); break;
+        case ASSIST:            visit(routine<Hit>); break;
+        case BIDE:              visit(routine<Hit>); break;
+        case CAMOUFLAGE:        visit(routine<Hit>); break;
+        case CHARGE:            visit(routine<Hit>); break;
+        case CONVERSION:        visit(routine<Hit>); break;
+        case CONVERSION_2:      visit(routine<Hit>); break;
+        case DESTINY_BOND:      visit(routine<Hit>); break;
+        case FOCUS_PUNCH:       visit(routine<Hit>); break;
+        case FORESIGHT:         visit(routine<Hit>); break;
+        case GRUDGE:            visit(routine<Hit>); break;
+        case HELPING_HAND:      visit(routine<Hit>); break;
+        case IMPRISON:          visit(routine<Hit>); break;
+        case LOCK_ON:           visit(routine<Hit>); break;
+        case MEAN_LOOK:         visit(routine<Hit>); break;
+        case MEMENTO:           visit(routine<Hit>); break;
+        case METRONOME:         visit(routine<Hit>); break;
+        case MIMIC:             visit(routine<Hit>); break;
+        case MIRROR_MOVE:       visit(routine<Hit>); break;
+        case NATURE_POWER:      visit(routine<Hit>); break;
+        case OVERHEAT:          visit(routine<Hit>); break;
+        case PAY_DAY:           visit(routine<Hit>); break;
+        case RAGE:              visit(routine<Hit>); break;
+        case RAMPAGE:           visit(routine<Hit>); break;
+        case RAZOR_WIND:        visit(routine<Hit>); break;
+        case RECHARGE:          visit(routine<Hit>); break;
+        case ROLE_PLAY:         visit(routine<Hit>); break;
+        case SEMI_INVUL:        visit(routine<Hit>); break;
+        case SKETCH:            visit(routine<Hit>); break;
+        case SKILL_SWAP:        visit(routine<Hit>); break;
+        case SKULL_BASH:        visit(routine<Hit>); break;
+        case SLEEP_TALK:        visit(routine<Hit>); break;
+        case SNORE:             visit(routine<Hit>); break;
+        case SOLAR_BEAM:        visit(routine<Hit>); break;
+        case SPIT_UP:           visit(routine<Hit>); break;
+        case SPLASH:            visit(routine<Hit>); break;
+        case STOCKPILE:         visit(routine<Hit>); break;
+        case SUPERPOWER:        visit(routine<Hit>); break;
+        case SWALLOW:           visit(routine<Hit>); break;
+        case TEETER_DANCE:      visit(routine<Hit>); break;
+        case TELEPORT:          visit(routine<Hit>); break;
+        case THIEF:             visit(routine<Hit>); break;
+        case TRANSFORM:         visit(routine<Hit>); break;
+        case UPROAR:            visit(routine<Hit>); break;
 
         // ====================================================================
         //                              NONE
         // ====================================================================
 
-        case NONE: break;    
+        case NONE: return false;
     }
     // clang-format on
+    return true;
+}
+
+// ============================================================================
+//                            EFFECT TRAITS
+// ============================================================================
+//
+// dsl::effect_traits of the routine each effect dispatches to: what running
+// the effect can do (deal damage, draw from the RNG, write Field / Side
+// state, switch a battler out, start charging). Stubs carry Hit's traits
+// until they get their own routine.
+//
+// ============================================================================
+
+namespace effect_traits_detail {
+
+template <size_t I>
+inline constexpr dsl::EffectTraits traits_at = [] {
+    dsl::EffectTraits traits{};
+    visit_effect_routine(static_cast<types::enums::Effect>(I),
+                         [&traits]<typename Routine>(RoutineTag<Routine>) {
+                             traits = dsl::effect_traits<Routine>;
+                         });
+    return traits;
+}();
+
+template <typename Indices>
+struct TraitsTable;
+
+template <size_t... Is>
+struct TraitsTable<std::index_sequence<Is...>> {
+    static constexpr dsl::EffectTraits entries[] = {traits_at<Is>...};
+};
+
+}  // namespace effect_traits_detail
+
+/// Traits of every effect, indexed by Effect
+inline constexpr const dsl::EffectTraits (&g_EFFECT_TRAITS)[EFFECT_COUNT] =
+    effect_traits_detail::TraitsTable<std::make_index_sequence<EFFECT_COUNT>>::entries;
+
+/// What running `effect` can do
+constexpr const dsl::EffectTraits& effect_traits(types::enums::Effect effect) {
+    return g_EFFECT_TRAITS[static_cast<size_t>(effect)];
+}
+
+static_assert(effect_traits(types::enums::Effect::NONE) == dsl::EffectTraits{});
+static_assert(effect_traits(types::enums::Effect::HIT) ==
+              dsl::EffectTraits{.deals_damage = true, .draws_rng = true});
+static_assert(effect_traits(types::enums::Effect::MULTI_HIT) ==
+              dsl::EffectTraits{.deals_damage = true, .draws_rng = true});
+static_assert(effect_traits(types::enums::Effect::RESTORE_HP) == dsl::EffectTraits{});
+static_assert(effect_traits(types::enums::Effect::REFLECT) ==
+              dsl::EffectTraits{.touches_side = true});
+static_assert(effect_traits(types::enums::Effect::SANDSTORM) ==
+              dsl::EffectTraits{.touches_field = true});
+static_assert(effect_traits(types::enums::Effect::BATON_PASS) ==
+              dsl::EffectTraits{.can_switch = true});
+static_assert(effect_traits(types::enums::Effect::ROAR) ==
+              dsl::EffectTraits{.draws_rng = true, .can_switch = true});
+static_assert(effect_traits(types::enums::Effect::SKY_ATTACK) ==
+              dsl::EffectTraits{.deals_damage = true, .draws_rng = true, .multi_turn = true});
+// Sandstorm / Hail damage exempts no one (dsl/residual.hpp run_weather()): revisit
+// when Dig / Dive get a charging routine
+static_assert(!effect_traits(types::enums::Effect::SEMI_INVUL).multi_turn);
+
+// ============================================================================
+//                            DISPATCH TABLE
+// ============================================================================
+//
+// dispatch_move_effect() is two loads and an indirect call. Run as a switch,
+// the 210 cases compile to a jump table on host but to a linear compare
+// chain under -Oz on the eZ80, paid on every move. Effects that run the same
+// routine (every stub runs Hit) share one entry: the table is a byte per
+// effect plus a pointer per distinct routine.
+//
+// With BATTLEMON_USAGE_ORDERED_DISPATCH (the default) the routines are laid
+// out heaviest first by rental usage - the move slots, over every rental
+// set, whose move runs them - so the few a Factory battle mostly dispatches
+// to share the front of the table. Without it they keep first-use order in
+// enums::Effect. Either layout runs the same routine for every effect.
+//
+// ============================================================================
+
+/// A routine's entry point
+using EffectRoutine = void (*)(dsl::BattleContext&);
+
+namespace effect_dispatch_detail {
+
+/// Effect::NONE's entry
+inline void no_effect(dsl::BattleContext&) {}
+
+template <size_t I>
+inline constexpr EffectRoutine routine_at = [] {
+    EffectRoutine entry = &no_effect;
+    visit_effect_routine(static_cast<types::enums::Effect>(I),
+                         [&entry]<typename Routine>(RoutineTag<Routine>) {
+                             entry = &Routine::template execute<>;
+                         });
+    return entry;
+}();
+
+template <typename Indices>
+struct RoutineList;
+
+template <size_t... Is>
+struct RoutineList<std::index_sequence<Is...>> {
+    static constexpr EffectRoutine entries[] = {routine_at<Is>...};
+};
+
+inline constexpr const EffectRoutine (&ROUTINE_OF)[EFFECT_COUNT] =
+    RoutineList<std::make_index_sequence<EFFECT_COUNT>>::entries;
+
+/// Rental move slots carrying each effect
+struct EffectUsage {
+    uint16_t slots[EFFECT_COUNT]{};
+};
+
+consteval EffectUsage count_effect_usage() {
+    EffectUsage usage{};
+    for (const types::Rental& rental : data::g_RENTAL_SETS) {
+        for (const types::enums::Move move : rental.moves) {
+            const auto effect = data::g_MOVE_TABLE[static_cast<size_t>(move)].effect;
+            ++usage.slots[static_cast<size_t>(effect)];
+        }
+    }
+    return usage;
 }
 
+inline constexpr EffectUsage EFFECT_USAGE = count_effect_usage();
+
+/// Distinct routines in layout order, before the table is cut to size
+struct Layout {
+    EffectRoutine routines[EFFECT_COUNT]{};
+    uint16_t usage[EFFECT_COUNT]{};  ///< Rental move slots running each routine
+    uint8_t slot_of[EFFECT_COUNT]{};
+    size_t count{0};
+};
+
+consteval Layout make_layout(bool by_usage) {
+    Layout layout{};
+    for (size_t effect = 0; effect < EFFECT_COUNT; ++effect) {
+        size_t slot = 0;
+        while (slot < layout.count && layout.routines[slot] != ROUTINE_OF[effect])
+            ++slot;
+        if (slot == layout.count)
+            layout.routines[layout.count++] = ROUTINE_OF[effect];
+        layout.usage[slot] += EFFECT_USAGE.slots[effect];
+    }
+
+    // Stable insertion sort, heaviest first: ties keep first-use order
+    if (by_usage) {
+        for (size_t i = 1; i < layout.count; ++i) {
+            for (size_t j = i; j > 0 && layout.usage[j] > layout.usage[j - 1]; --j) {
+                std::swap(layout.routines[j], layout.routines[j - 1]);
+                std::swap(layout.usage[j], layout.usage[j - 1]);
+            }
+        }
+    }
+
+    for (size_t effect = 0; effect < EFFECT_COUNT; ++effect) {
+        uint8_t slot = 0;
+        while (layout.routines[slot] != ROUTINE_OF[effect])
+            ++slot;
+        layout.slot_of[effect] = slot;
+    }
+    return layout;
+}
+
+inline constexpr Layout LAYOUT = make_layout(BATTLEMON_USAGE_ORDERED_DISPATCH);
+
+static_assert(LAYOUT.count <= UINT8_MAX, "routine slots are stored in a byte");
+
+}  // namespace effect_dispatch_detail
+
+/// Effect -> routine table, cut to the distinct routines
+template <size_t Routines>
+struct EffectDispatchTable {
+    EffectRoutine routines[Routines]{};
+    uint8_t slot_of[EFFECT_COUNT]{};  ///< Index into routines, by Effect
+
+    static constexpr EffectDispatchTable from(const effect_dispatch_detail::Layout& layout) {
+        EffectDispatchTable table{};
+        for (size_t slot = 0; slot < Routines; ++slot)
+            table.routines[slot] = layout.routines[slot];
+        for (size_t effect = 0; effect < EFFECT_COUNT; ++effect)
+            table.slot_of[effect] = layout.slot_of[effect];
+        return table;
+    }
+
+    /// Entry point of the routine that runs `effect`
+    constexpr EffectRoutine operator[](types::enums::Effect effect) const {
+        return routines[slot_of[static_cast<size_t>(effect)]];
+    }
+};
+
+inline constexpr auto g_EFFECT_DISPATCH =
+    EffectDispatchTable<effect_dispatch_detail::LAYOUT.count>::from(effect_dispatch_detail::LAYOUT);
+
+/**
+ * @brief Execute the effect routine for a given move effect.
+ *
+ * @param effect The effect enum value from the move data
+ * @param ctx The battle context with all state pointers set up
+ */
+inline void dispatch_move_effect(types::enums::Effect effect, dsl::BattleContext& ctx) {
+    BATTLEMON_PROFILE_SCOPE(util::profile::Section::DISPATCH_MOVE_EFFECT);
+
+    g_EFFECT_DISPATCH[effect](ctx);
+}
+
+// Every effect runs the routine visit_effect_routine() names, stubs share Hit's entry
+static_assert(g_EFFECT_DISPATCH[types::enums::Effect::BURN_HIT] ==
+              &logic::routines::Hit::execute<>);
+static_assert(g_EFFECT_DISPATCH[types::enums::Effect::POISON_HIT] ==
+              &logic::routines::PoisonHit::execute<>);
+static_assert(g_EFFECT_DISPATCH[types::enums::Effect::NONE] == &effect_dispatch_detail::no_effect);
+#if BATTLEMON_USAGE_ORDERED_DISPATCH
+static_assert(g_EFFECT_DISPATCH.routines[0] == &logic::routines::Hit::execute<>,
+              "the stubs make Hit the most used routine");
+#endif
+
+// Straight-line routines run as a Seq<> and get the fused Hit kernel (dsl/fused.hpp);
+// RUN_WITH steps keep a routine on its written path
+static_assert(dsl::effect_steps_t<logic::routines::Hit>::replayable);
+static_assert(!dsl::effect_steps_t<logic::routines::PoisonHit>::replayable);
+
 }  // namespace engine
@@ -0,0 +1,57 @@
+#include "eval.hpp"
+
+#include <cstring>
+
+#include "util/platform.hpp"
+
+namespace engine::ai {
+
+namespace {
+
+bool in_range(const EvalWeights& weights) {
+    for (const int16_t weight : weights.weight) {
+        if (weight > EVAL_MAX_WEIGHT || weight < -EVAL_MAX_WEIGHT)
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool load_eval_weights(EvalWeights& weights, const char* name) {
+    size_t size = 0;
+    const auto* bytes = static_cast<const uint8_t*>(util::platform::map_appvar(name, size));
+    if (!bytes || size != sizeof(EvalWeightsHeader) + sizeof(EvalWeights))
+        return false;
+
+    EvalWeightsHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, EVAL_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != EVAL_VERSION || header.feature_count != EVAL_FEATURE_COUNT ||
+        header.weight_shift != EVAL_WEIGHT_SHIFT)
+        return false;
+
+    EvalWeights loaded;
+    std::memcpy(&loaded, bytes + sizeof(header), sizeof(loaded));
+    if (!in_range(loaded))
+        return false;
+    weights = loaded;
+    return true;
+}
+
+bool write_eval_weights(const EvalWeights& weights, const char* name) {
+    if (!in_range(weights))
+        return false;
+
+    uint8_t bytes[sizeof(EvalWeightsHeader) + sizeof(EvalWeights)];
+    EvalWeightsHeader header{};
+    std::memcpy(header.magic, EVAL_MAGIC, sizeof(header.magic));
+    header.version = EVAL_VERSION;
+    header.feature_count = EVAL_FEATURE_COUNT;
+    header.weight_shift = EVAL_WEIGHT_SHIFT;
+    std::memcpy(bytes, &header, sizeof(header));
+    std::memcpy(bytes + sizeof(header), &weights, sizeof(weights));
+    return util::platform::write_appvar(name, bytes, sizeof(bytes));
+}
+
+}  // namespace engine::ai
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "data/move.hpp"
+#include "logic/calc/move_scores.hpp"
+#include "logic/calc/speed.hpp"
+#include "logic/state/context.hpp"
+#include "logic/state/field.hpp"
+
+namespace engine::ai {
+
+// ============================================================================
+//                          STATIC EVALUATION
+// ============================================================================
+//
+// The search's leaf score: a weighted sum of a handful of features of one
+// side's view of a state, every one in fixed point. A leaf costs a few dozen
+// integer operations plus one 4-cell move score grid per side, and the grids
+// are memoized across a search's leaves (EvalCache).
+//
+// Features (mine minus theirs, each within +-EVAL_FEATURE_ONE):
+//
+//   HP          HP fraction difference
+//   RACE        hits the foe needs to KO me minus hits I need to KO it, as
+//               a fraction of EVAL_MAX_RACE_HITS. A hit is the best of the
+//               score_moves() grid times accuracy, over moves with PP left
+//   RACE_WIN    +1 if I win the race (fewer hits, or as many and faster),
+//               -1 if I lose it, 0 if neither side does damage
+//   SPEED       +1 if I move first this turn, -1 if second, 0 on a tie
+//   MAJOR       Sleep or Freeze (foe's flag minus mine)
+//   MINOR       Poison, Toxic, Burn or Paralysis (foe's flag minus mine)
+//   SCREENS     Reflect and Light Screen turns left (mine minus the foe's)
+//
+// score = sum(feature * weight) >> EVAL_WEIGHT_SHIFT. The weight bound keeps
+// every product and the sum inside the eZ80's 24-bit int, and every feature
+// is computed in 16/24-bit integers: there is no 32-bit arithmetic on a leaf.
+//
+// Weights come from an AppVar (EVAL_APPVAR), fitted on the host against
+// simulated games (battlemon_tune), with DEFAULT_EVAL_WEIGHTS built in. The
+// score is antisymmetric: evaluate(state, 0) == -evaluate(state, 1).
+//
+// ============================================================================
+
+enum EvalFeature : uint8_t {
+    EVAL_HP = 0,
+    EVAL_RACE,
+    EVAL_RACE_WIN,
+    EVAL_SPEED,
+    EVAL_MAJOR_STATUS,
+    EVAL_MINOR_STATUS,
+    EVAL_SCREENS,
+    EVAL_FEATURE_COUNT
+};
+
+/// Feature value of 1.0
+inline constexpr int16_t EVAL_FEATURE_ONE = 256;
+
+/// Weights are in 1/16 score points per feature unit
+inline constexpr uint8_t EVAL_WEIGHT_SHIFT = 4;
+
+/// Largest weight magnitude (keeps the sum within 24 bits)
+inline constexpr int16_t EVAL_MAX_WEIGHT = 4095;
+
+/// Hits-to-KO ceiling (also the count of a side that does no damage)
+inline constexpr uint8_t EVAL_MAX_RACE_HITS = 8;
+
+/// Screen turns worth EVAL_FEATURE_ONE / 16 each
+inline constexpr int16_t EVAL_SCREEN_TURN = EVAL_FEATURE_ONE / 16;
+
+/// Bound on non-terminal scores (search wins score WIN_SCORE and up)
+inline constexpr int16_t EVAL_MAX_SCORE = 29000;
+
+// Accumulator: int is 24 bits on the eZ80 and every sum fits it
+using EvalSum = int;
+
+static_assert(static_cast<long>(EVAL_FEATURE_COUNT) * EVAL_FEATURE_ONE * EVAL_MAX_WEIGHT <
+                  (1l << 23),
+              "evaluation sum no longer fits the eZ80's 24-bit int");
+
+struct EvalFeatures {
+    int16_t value[EVAL_FEATURE_COUNT]{};
+};
+
+struct EvalWeights {
+    int16_t weight[EVAL_FEATURE_COUNT]{};
+};
+
+/// Built-in weights (fitted by battlemon_tune; used when no AppVar is loaded)
+inline constexpr EvalWeights DEFAULT_EVAL_WEIGHTS = {{420, 295, 86, 12, 9, 51, -36}};
+
+// ============================================================================
+//                               APPVAR
+// ============================================================================
+//
+// Layout (little-endian): EvalWeightsHeader, then EVAL_FEATURE_COUNT int16
+// weights in EvalFeature order.
+//
+// ============================================================================
+
+inline constexpr char EVAL_MAGIC[4] = {'B', 'M', 'E', 'V'};
+inline constexpr uint8_t EVAL_VERSION = 1;
+inline constexpr const char* EVAL_APPVAR = "BMEVAL";
+
+struct EvalWeightsHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t feature_count;
+    uint8_t weight_shift;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(EvalWeightsHeader) == 8, "eval header is part of the AppVar format");
+
+/**
+ * @brief Read weights from an AppVar written by write_eval_weights().
+ *
+ * @param[out] weights Loaded weights (unchanged on failure)
+ * @param name AppVar name
+ *
+ * @return false if the AppVar is missing, malformed or out of range
+ */
+bool load_eval_weights(EvalWeights& weights, const char* name = EVAL_APPVAR);
+
+/**
+ * @brief Write weights as an AppVar (a `<name>.bin` file on host).
+ *
+ * @return false if a weight is out of range or the write failed
+ */
+bool write_eval_weights(const EvalWeights& weights, const char* name = EVAL_APPVAR);
+
+// ============================================================================
+//                              FEATURES
+// ============================================================================
+
+namespace eval_detail {
+
+/// HP left as a fraction of EVAL_FEATURE_ONE (HP < 2^15, so the shift fits 24 bits)
+constexpr int16_t hp_fraction(const logic::state::MonState& mon) {
+    if (mon.max_hp == 0)
+        return 0;
+    return static_cast<int16_t>((static_cast<unsigned>(mon.current_hp) << 8) / mon.max_hp);
+}
+
+/// Best hit of `side` on the foe: max over moves with PP of expected damage x accuracy
+constexpr unsigned hit_strength(const dsl::BattleState& state, uint8_t side) {
+    const uint8_t foe = static_cast<uint8_t>(side ^ 1);
+    const types::Rental& rental = state.rental(side);
+    const types::MoveHot* moves[logic::calc::SCORE_MOVES];
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        moves[m] = state.mon(side).pp[m] == 0
+                       ? nullptr
+                       : &data::g_MOVE_HOT[static_cast<size_t>(rental.moves[m])];
+    }
+    const logic::calc::ScoreTarget target{&state.active(foe), &state.slots[foe]};
+    const auto grid =
+        logic::calc::score_moves(state.active(side), state.slots[side], moves, &target, 1);
+
+    // Percent-HP units (no /100); 0xFFFF x 100 < 2^23
+    unsigned best = 0;
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        if (moves[m] == nullptr)
+            continue;
+        const unsigned accuracy = moves[m]->accuracy == 0 ? 100u : moves[m]->accuracy;
+        const unsigned strength = grid.expected[m][0] * accuracy;
+        if (strength > best)
+            best = strength;
+    }
+    return best;
+}
+
+/// What hit_strength() reads that can change mid-battle: the members in play,
+/// stages, PP left and types
+constexpr uint64_t strength_key(const dsl::BattleState& state, uint8_t side) {
+    const uint8_t foe = static_cast<uint8_t>(side ^ 1);
+    const auto& mine = state.slots[side];
+    const auto& theirs = state.slots[foe];
+    // Same-typed party members differ only in the member index
+    uint64_t key = static_cast<uint64_t>(mine.party_index) << 3 | theirs.party_index;
+    for (const int8_t stage :
+         {mine.atk_stage, mine.sp_atk_stage, theirs.def_stage, theirs.sp_def_stage}) {
+        key = key << 8 | static_cast<uint8_t>(stage);
+    }
+    for (const types::enums::Type type : {state.active(side).type1, state.active(side).type2,
+                                          state.active(foe).type1, state.active(foe).type2}) {
+        key = key << 5 | (static_cast<uint8_t>(type) & 0x1F);
+    }
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        key = key << 1 | (state.mon(side).pp[m] != 0);
+    }
+    return key;  // 62 bits
+}
+
+/// Hits needed to KO `hp` at `strength` per hit, capped at EVAL_MAX_RACE_HITS
+constexpr uint8_t hits_to_ko(uint16_t hp, unsigned strength) {
+    if (strength == 0)
+        return EVAL_MAX_RACE_HITS;
+    const unsigned scaled = static_cast<unsigned>(hp) * 100u;
+    const unsigned hits = (scaled + strength - 1) / strength;
+    return static_cast<uint8_t>(hits > EVAL_MAX_RACE_HITS ? EVAL_MAX_RACE_HITS : hits);
+}
+
+constexpr bool has_major_status(const logic::state::MonState& mon) {
+    return mon.status == logic::state::Status::SLEEP || mon.status == logic::state::Status::FREEZE;
+}
+
+constexpr bool has_minor_status(const logic::state::MonState& mon) {
+    return mon.has_status() && !has_major_status(mon);
+}
+
+/// Turn ends left on a timer from the 1..255 clock (0 = not running)
+constexpr int turns_left(const logic::state::FieldState& field, uint8_t expiry) {
+    return expiry == 0 ? 0 : logic::state::turns_until(field.turn, expiry) + 1;
+}
+
+/// Reflect plus Light Screen turns left on `side`
+constexpr int screen_turns(const dsl::BattleState& state, uint8_t side) {
+    const auto& screens = state.sides[side];
+    return turns_left(state.field, screens.reflect_expiry) +
+           turns_left(state.field, screens.light_screen_expiry);
+}
+
+/// +1 / 0 / -1 as a feature
+constexpr int16_t sign_feature(int residual) {
+    return static_cast<int16_t>(residual > 0 ? EVAL_FEATURE_ONE
+                                             : residual < 0 ? -EVAL_FEATURE_ONE : 0);
+}
+
+}  // namespace eval_detail
+
+/**
+ * @brief Memo of each side's hit strength across the leaves of one search.
+ *
+ * Leaves of a search share their mons, and mostly their stages, so the two
+ * score grids of a leaf are usually the previous leaf's. An entry is keyed
+ * by everything the grid reads that a turn can change, the party members in
+ * play included; the members' stats and moves are not in the key, so clear()
+ * the cache before evaluating states of another battle (Searcher::begin()
+ * does).
+ */
+struct EvalCache {
+    static constexpr uint64_t EMPTY = ~0ull;
+
+    uint64_t key[2]{EMPTY, EMPTY};
+    unsigned strength[2]{};
+
+    constexpr void clear() { key[0] = key[1] = EMPTY; }
+
+    /// hit_strength(state, side), computed on a key miss
+    constexpr unsigned lookup(const dsl::BattleState& state, uint8_t side) {
+        const uint64_t k = eval_detail::strength_key(state, side);
+        if (key[side] != k) {
+            key[side] = k;
+            strength[side] = eval_detail::hit_strength(state, side);
+        }
+        return strength[side];
+    }
+};
+
+/**
+ * @brief Feature vector of a non-terminal state from `side`'s view.
+ *
+ * @param state Battle state
+ * @param side 0 = player 1, 1 = player 2
+ * @param cache Hit strength memo of the state's battle, or nullptr
+ */
+constexpr EvalFeatures eval_features(const dsl::BattleState& state, uint8_t side,
+                                     EvalCache* cache = nullptr) {
+    using namespace eval_detail;
+    const uint8_t foe = static_cast<uint8_t>(side ^ 1);
+    const auto& mine = state.mon(side);
+    const auto& theirs = state.mon(foe);
+
+    EvalFeatures f;
+    f.value[EVAL_HP] = static_cast<int16_t>(hp_fraction(mine) - hp_fraction(theirs));
+
+    const unsigned my_strength = cache ? cache->lookup(state, side) : hit_strength(state, side);
+    const unsigned their_strength = cache ? cache->lookup(state, foe) : hit_strength(state, foe);
+    const int my_hits = hits_to_ko(theirs.current_hp, my_strength);
+    const int their_hits = hits_to_ko(mine.current_hp, their_strength);
+    f.value[EVAL_RACE] = static_cast<int16_t>((their_hits - my_hits) * EVAL_FEATURE_ONE /
+                                              EVAL_MAX_RACE_HITS);
+
+    const int speed = static_cast<int>(logic::calc::calc_effective_speed(
+                          state.active(side), state.slots[side], mine)) -
+                      static_cast<int>(logic::calc::calc_effective_speed(
+                          state.active(foe), state.slots[foe], theirs));
+    f.value[EVAL_SPEED] = sign_feature(speed);
+
+    const bool no_damage = my_hits == EVAL_MAX_RACE_HITS && their_hits == EVAL_MAX_RACE_HITS;
+    f.value[EVAL_RACE_WIN] =
+        no_damage ? 0 : sign_feature(their_hits != my_hits ? their_hits - my_hits : speed);
+
+    f.value[EVAL_MAJOR_STATUS] =
+        static_cast<int16_t>((has_major_status(theirs) - has_major_status(mine)) * EVAL_FEATURE_ONE);
+    f.value[EVAL_MINOR_STATUS] =
+        static_cast<int16_t>((has_minor_status(theirs) - has_minor_status(mine)) * EVAL_FEATURE_ONE);
+
+    int screens = (screen_turns(state, side) - screen_turns(state, foe)) * EVAL_SCREEN_TURN;
+    if (screens > EVAL_FEATURE_ONE)
+        screens = EVAL_FEATURE_ONE;
+    if (screens < -EVAL_FEATURE_ONE)
+        screens = -EVAL_FEATURE_ONE;
+    f.value[EVAL_SCREENS] = static_cast<int16_t>(screens);
+    return f;
+}
+
+/// Weighted score of a feature vector, clamped to +-EVAL_MAX_SCORE
+constexpr int16_t score_features(const EvalFeatures& features, const EvalWeights& weights) {
+    EvalSum sum = 0;
+    for (uint8_t i = 0; i < EVAL_FEATURE_COUNT; ++i) {
+        sum += static_cast<EvalSum>(features.value[i]) * weights.weight[i];
+    }
+    // Round toward zero so the score stays antisymmetric
+    sum = sum >= 0 ? sum >> EVAL_WEIGHT_SHIFT : -((-sum) >> EVAL_WEIGHT_SHIFT);
+    if (sum > EVAL_MAX_SCORE)
+        return EVAL_MAX_SCORE;
+    if (sum < -EVAL_MAX_SCORE)
+        return -EVAL_MAX_SCORE;
+    return static_cast<int16_t>(sum);
+}
+
+/**
+ * @brief Static score of a non-terminal state from `side`'s view.
+ *
+ * @param state Battle state
+ * @param side 0 = player 1, 1 = player 2
+ * @param weights Feature weights
+ * @param cache Hit strength memo of the state's battle, or nullptr
+ */
+constexpr int16_t evaluate(const dsl::BattleState& state, uint8_t side,
+                           const EvalWeights& weights = DEFAULT_EVAL_WEIGHTS,
+                           EvalCache* cache = nullptr) {
+    return score_features(eval_features(state, side, cache), weights);
+}
+
+}  // namespace engine::ai
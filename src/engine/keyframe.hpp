@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "battle.hpp"
+#include "battle_log.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                            KEYFRAME INDEX
+// ============================================================================
+//
+// Seeking into a battle log. Replaying to turn T costs T turns; with a
+// BattleSnapshot ("keyframe") stored every K turns, seek() restores the
+// nearest keyframe at or before T and replays at most K - 1 turns.
+//
+// Each keyframe also records where its turn ends in the log (byte offset),
+// so the replay resumes mid-log without decoding the turns before it.
+// Snapshots are pointer-free, so an index can be written to disk as-is and
+// reloaded next to its log by the same build.
+//
+// Storage is caller-owned. When a long battle outgrows it, build() doubles
+// K and keeps every other keyframe, so any log fits in any capacity at the
+// cost of longer seeks.
+//
+// ============================================================================
+
+struct Keyframe {
+    uint32_t turn;    // Turns executed before the snapshot
+    uint32_t offset;  // Log byte offset of the next item after that turn
+    BattleSnapshot snapshot;
+};
+
+class KeyframeIndex {
+   public:
+    /**
+     * @param storage Keyframe array to fill
+     * @param capacity Length of storage (at least 2)
+     * @param interval Initial turns between keyframes (K)
+     */
+    KeyframeIndex(Keyframe* storage, uint16_t capacity, uint16_t interval)
+        : keyframes_(storage), capacity_(capacity), interval_(interval ? interval : 1) {}
+
+    /**
+     * @brief Replay `log` once, recording a keyframe every interval() turns.
+     *
+     * Keyframe 0 is the initial state. `battle` ends in the final state.
+     *
+     * @return Status of the full replay (keyframes before a failure are kept)
+     */
+    ReplayStatus build(BattleEngine& battle, const BattleLog& log) {
+        count_ = 0;
+        ReplayStatus status = battle.init_from_log(log);
+        if (status != ReplayStatus::OK)
+            return status;
+
+        BattleLogReader reader(log);
+        for (;;) {
+            add(reader, battle);
+            const uint32_t next = (reader.turn() / interval_ + 1) * interval_;
+            status = battle.replay_turns(reader, next);
+            if (status != ReplayStatus::OK || reader.done())
+                return status;
+        }
+    }
+
+    /**
+     * @brief Put `battle` in the state after `turn` turns of `log`.
+     *
+     * @pre build() succeeded for this log
+     *
+     * @return ReplayStatus::OK (turns past the end stop at the final state)
+     */
+    ReplayStatus seek(BattleEngine& battle, const BattleLog& log, uint32_t turn) const {
+        const ReplayStatus status = battle.init_from_log(log);
+        if (status != ReplayStatus::OK || count_ == 0)
+            return count_ == 0 ? ReplayStatus::TRUNCATED : status;
+
+        uint32_t index = turn / interval_;
+        if (index >= count_) {
+            index = count_ - 1;
+        }
+        const Keyframe& keyframe = keyframes_[index];
+        battle.restore(keyframe.snapshot);
+
+        BattleLogReader reader(log, keyframe.offset, keyframe.turn);
+        return battle.replay_turns(reader, turn);
+    }
+
+    [[nodiscard]] const Keyframe* keyframes() const { return keyframes_; }
+    [[nodiscard]] uint16_t count() const { return count_; }
+    [[nodiscard]] uint16_t interval() const { return interval_; }
+
+   private:
+    void add(const BattleLogReader& reader, const BattleEngine& battle) {
+        if (count_ == capacity_) {
+            // Thin out: keep keyframes at multiples of the doubled interval
+            for (uint16_t i = 0; 2 * i < count_; ++i) {
+                keyframes_[i] = keyframes_[2 * i];
+            }
+            count_ = static_cast<uint16_t>((count_ + 1) / 2);
+            interval_ = static_cast<uint16_t>(interval_ * 2);
+            if (reader.turn() % interval_ != 0)
+                return;
+        }
+        keyframes_[count_++] =
+            Keyframe{reader.turn(), static_cast<uint32_t>(reader.offset()), battle.save()};
+    }
+
+    Keyframe* keyframes_;
+    uint16_t capacity_;
+    uint16_t count_{0};
+    uint16_t interval_;
+};
+
+}  // namespace engine
@@ -0,0 +1,237 @@
+#include "link.hpp"
+
+#include "battle_log.hpp"
+#include "data/fingerprint.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/platform.hpp"
+#include "util/random.hpp"
+
+namespace engine::link {
+
+namespace {
+
+using log_detail::get_u16;
+using log_detail::get_u32;
+using log_detail::put_u16;
+using log_detail::put_u32;
+
+bool valid_party(const PartyRentals& party) {
+    if (party.size == 0 || party.size > dsl::MAX_PARTY_SIZE)
+        return false;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        if (party.rentals[i] >= logic::setup::RENTAL_COUNT)
+            return false;
+    }
+    return true;
+}
+
+bool valid_setup(const LinkSetup& setup) {
+    return setup.level >= 1 && setup.level <= 100 && valid_party(setup.p1) &&
+           valid_party(setup.p2);
+}
+
+void put_party(uint8_t* out, const PartyRentals& party) {
+    for (uint8_t i = 0; i < dsl::MAX_PARTY_SIZE; ++i)
+        put_u16(out + 2 * i, i < party.size ? party.rentals[i] : 0);
+}
+
+void get_party(const uint8_t* in, uint8_t size, PartyRentals& party) {
+    party = PartyRentals{};
+    party.size = size;
+    for (uint8_t i = 0; i < dsl::MAX_PARTY_SIZE; ++i)
+        party.rentals[i] = get_u16(in + 2 * i);
+}
+
+bool same_setup(const LinkSetup& a, const LinkSetup& b) {
+    const auto same_party = [](const PartyRentals& x, const PartyRentals& y) {
+        if (x.size != y.size)
+            return false;
+        for (uint8_t i = 0; i < x.size; ++i) {
+            if (x.rentals[i] != y.rentals[i])
+                return false;
+        }
+        return true;
+    };
+    return a.level == b.level && a.seed == b.seed && same_party(a.p1, b.p1) &&
+           same_party(a.p2, b.p2);
+}
+
+}  // namespace
+
+uint32_t link_checksum(const BattleEngine& battle) {
+    const uint64_t digest = battle.hash() ^ util::random::mix64(battle.rng().state);
+    return static_cast<uint32_t>(digest ^ (digest >> 32));
+}
+
+// ============================================================================
+//                              HANDSHAKE
+// ============================================================================
+
+size_t LockstepSession::host(BattleEngine& battle, const LinkSetup& setup,
+                             uint8_t (&out)[LINK_MAX_FRAME]) {
+    battle_ = &battle;
+    role_ = LinkRole::HOST;
+    status_ = LinkStatus::HANDSHAKE;
+    if (!valid_setup(setup))
+        return 0;
+
+    setup_ = setup;
+    if (setup_.seed == 0)
+        setup_.seed = util::platform::entropy_seed();
+    return write_hello(out);
+}
+
+void LockstepSession::join(BattleEngine& battle) {
+    battle_ = &battle;
+    role_ = LinkRole::GUEST;
+    status_ = LinkStatus::HANDSHAKE;
+}
+
+size_t LockstepSession::write_hello(uint8_t (&out)[LINK_MAX_FRAME]) const {
+    out[0] = LINK_HELLO;
+    out[1] = LINK_VERSION;
+    out[2] = setup_.level;
+    put_u32(out + 3, setup_.seed);
+    put_u32(out + 7, data::DATA_FINGERPRINT);
+    out[11] = setup_.p1.size;
+    out[12] = setup_.p2.size;
+    put_party(out + 13, setup_.p1);
+    put_party(out + 13 + 2 * dsl::MAX_PARTY_SIZE, setup_.p2);
+    return LINK_HELLO_SIZE;
+}
+
+void LockstepSession::start() {
+    battle_->init(setup_.p1, setup_.p2, setup_.level, setup_.seed);
+    status_ = LinkStatus::PLAYING;
+    step_ = 0;
+    begin_step();
+}
+
+// ============================================================================
+//                               FRAMES
+// ============================================================================
+
+LinkStatus LockstepSession::receive(const uint8_t* frame, size_t size,
+                                    uint8_t (&out)[LINK_MAX_FRAME], size_t& out_size) {
+    out_size = 0;
+    if (status_ != LinkStatus::HANDSHAKE && status_ != LinkStatus::PLAYING)
+        return status_;
+    if (!battle_ || size == 0) {
+        status_ = LinkStatus::PROTOCOL_ERROR;
+        return status_;
+    }
+
+    if (frame[0] == LINK_HELLO && size == LINK_HELLO_SIZE && status_ == LinkStatus::HANDSHAKE) {
+        if (frame[1] != LINK_VERSION || get_u32(frame + 7) != data::DATA_FINGERPRINT) {
+            status_ = LinkStatus::DATA_MISMATCH;
+            return status_;
+        }
+        LinkSetup peer{};
+        peer.level = frame[2];
+        peer.seed = get_u32(frame + 3);
+        get_party(frame + 13, frame[11], peer.p1);
+        get_party(frame + 13 + 2 * dsl::MAX_PARTY_SIZE, frame[12], peer.p2);
+        if (!valid_setup(peer) || peer.seed == 0 ||
+            (role_ == LinkRole::HOST && !same_setup(peer, setup_))) {
+            status_ = LinkStatus::PROTOCOL_ERROR;
+            return status_;
+        }
+        if (role_ == LinkRole::GUEST) {
+            setup_ = peer;
+            out_size = write_hello(out);
+        }
+        start();
+        return status_;
+    }
+
+    if (frame[0] != LINK_ACTION || size != LINK_ACTION_SIZE || status_ != LinkStatus::PLAYING ||
+        peer_code_ != NO_CODE || frame[1] != static_cast<uint8_t>(step_)) {
+        status_ = LinkStatus::PROTOCOL_ERROR;
+        return status_;
+    }
+    if (get_u32(frame + 3) != checksum_) {
+        status_ = LinkStatus::DESYNC;
+        return status_;
+    }
+
+    // The peer's action has to be one this engine accepts for its side
+    const uint8_t peer_side = side() ^ 1;
+    const uint8_t code = frame[2];
+    BattleAction action{};
+    const bool legal = replacement_step() && !battle_->needs_replacement(peer_side)
+                           ? code == LINK_PASS
+                           : decode_action(code, action) && accepts(peer_side, action);
+    if (!legal) {
+        status_ = LinkStatus::PROTOCOL_ERROR;
+        return status_;
+    }
+
+    peer_code_ = code;
+    if (local_code_ != NO_CODE)
+        run_step();
+    return status_;
+}
+
+size_t LockstepSession::submit(const BattleAction& action, uint8_t (&out)[LINK_MAX_FRAME]) {
+    if (!needs_action())
+        return 0;
+
+    uint8_t code = LINK_PASS;
+    if (!replacement_step() || battle_->needs_replacement(side())) {
+        if (!accepts(side(), action))
+            return 0;
+        code = encode_action(action);
+    }
+
+    out[0] = LINK_ACTION;
+    out[1] = static_cast<uint8_t>(step_);
+    out[2] = code;
+    put_u32(out + 3, checksum_);
+
+    local_code_ = code;
+    if (peer_code_ != NO_CODE)
+        run_step();
+    return LINK_ACTION_SIZE;
+}
+
+// ============================================================================
+//                                STEPS
+// ============================================================================
+
+bool LockstepSession::accepts(uint8_t side, const BattleAction& action) const {
+    const ActionMask legal = battle_->legal_actions(side);
+    if (replacement_step())
+        return action.type == BattleAction::Type::SWITCH && (legal & action_bit(action));
+    // No legal move: any move slot stands for Struggle
+    if (action.type == BattleAction::Type::MOVE && !(legal & ACTION_MOVES))
+        return action.index < 4;
+    return (legal & action_bit(action)) != 0;
+}
+
+void LockstepSession::begin_step() {
+    local_code_ = NO_CODE;
+    peer_code_ = NO_CODE;
+    checksum_ = link_checksum(*battle_);
+    if (battle_->result() != BattleResult::ONGOING)
+        status_ = LinkStatus::FINISHED;
+}
+
+void LockstepSession::run_step() {
+    const uint8_t codes[2] = {role_ == LinkRole::HOST ? local_code_ : peer_code_,
+                              role_ == LinkRole::HOST ? peer_code_ : local_code_};
+    BattleAction actions[2]{};
+    if (replacement_step()) {
+        for (uint8_t s = 0; s < dsl::BATTLE_SIDE_COUNT; ++s) {
+            if (codes[s] != LINK_PASS && decode_action(codes[s], actions[s]))
+                battle_->replace(s, actions[s].index);
+        }
+    } else {
+        decode_action(codes[0], actions[0]);
+        decode_action(codes[1], actions[1]);
+        battle_->execute_turn(actions[0], actions[1]);
+    }
+    ++step_;
+    begin_step();
+}
+
+}  // namespace engine::link
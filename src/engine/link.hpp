@@ -0,0 +1,184 @@
+#pragma once
+
+/**
+ * @file link.hpp
+ * @brief Lockstep link play: two engines kept in step by exchanging actions.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "battle.hpp"
+
+namespace engine::link {
+
+// ============================================================================
+//                             LOCKSTEP LINK
+// ============================================================================
+//
+// Two peers (calc-calc over the link port, or calc-host) each run the whole
+// battle and exchange only what the engine cannot compute: the setup once,
+// then one action per side per step. The engine is deterministic given its
+// RNG, so both copies walk the same states.
+//
+// A step is a turn (both sides choose an action) or, after a faint, a
+// replacement (the side that lost its battler picks a member and the other
+// side passes). Both peers know which step comes next from their own
+// states, so every step costs each side one ACTION frame. The frame carries
+// the sender's checksum of the state the step starts from. The receiver
+// compares it with its own, which catches a desync (different data, an
+// engine change, an eZ80/host arithmetic difference) at the first step
+// that diverged rather than at the end of the battle.
+//
+// Frames (little-endian; the transport delivers whole frames in order):
+//
+//   HELLO   'H' version level seed:u32 data_fingerprint:u32
+//           p1_size p2_size p1_rentals:u16[6] p2_rentals:u16[6]     37 bytes
+//   ACTION  'A' step:u8 code checksum:u32                           7 bytes
+//
+// The host (player 1) picks the setup and sends HELLO; the guest answers
+// with a HELLO carrying the same setup and its own data fingerprint. An
+// ACTION code is encode_action()'s (battle_log.hpp) or LINK_PASS, and the
+// step byte is the step count mod 256, so a dropped or repeated frame is a
+// protocol error instead of a silent desync.
+//
+// ============================================================================
+
+inline constexpr uint8_t LINK_VERSION = 1;
+
+inline constexpr uint8_t LINK_HELLO = 'H';
+inline constexpr uint8_t LINK_ACTION = 'A';
+
+inline constexpr size_t LINK_HELLO_SIZE = 13 + 4 * dsl::MAX_PARTY_SIZE;
+inline constexpr size_t LINK_ACTION_SIZE = 7;
+inline constexpr size_t LINK_MAX_FRAME = LINK_HELLO_SIZE;
+
+/// ACTION code of a side with nothing to do this step
+inline constexpr uint8_t LINK_PASS = 0xE;
+
+/// Who picks the setup; the host plays side 0 (player 1)
+enum class LinkRole : uint8_t { HOST, GUEST };
+
+enum class LinkStatus : uint8_t {
+    HANDSHAKE,       // Waiting for the peer's HELLO
+    PLAYING,         // Battle running (see needs_action())
+    FINISHED,        // Battle over (BattleEngine::result())
+    DESYNC,          // Peer's checksum differs: desync_step() is where
+    DATA_MISMATCH,   // Peer runs another link version or other data
+    PROTOCOL_ERROR,  // Malformed, out-of-order or illegal frame
+};
+
+/// Battle both peers set up
+struct LinkSetup {
+    PartyRentals p1;
+    PartyRentals p2;
+    uint8_t level{50};
+    uint32_t seed{0};  // 0 = host picks one from platform entropy
+};
+
+/**
+ * @brief 32-bit digest of the state a step starts from.
+ *
+ * BattleEngine::hash() (which leaves the RNG out) folded with the RNG
+ * state: two battles that made different draws are out of step even while
+ * their states still agree.
+ */
+uint32_t link_checksum(const BattleEngine& battle);
+
+/**
+ * @brief One peer of a lockstep battle, independent of the transport.
+ *
+ * The caller moves frames: whatever a call writes to `out` goes to the
+ * peer, and every frame from the peer goes to receive(). The session runs
+ * the engine's turns and replacements when both sides' actions are in.
+ */
+class LockstepSession {
+   public:
+    /**
+     * @brief Start as host: set up `battle` and write the HELLO.
+     *
+     * @param battle Engine both peers play on (owned by the caller)
+     * @param setup The battle (indices into data::g_RENTAL_SETS)
+     * @param[out] out HELLO frame to send
+     *
+     * @return Frame size, or 0 if the setup is invalid (bad sizes/indices)
+     */
+    size_t host(BattleEngine& battle, const LinkSetup& setup, uint8_t (&out)[LINK_MAX_FRAME]);
+
+    /// Start as guest: wait for the host's HELLO (receive())
+    void join(BattleEngine& battle);
+
+    /**
+     * @brief Handle one frame from the peer.
+     *
+     * @param[out] out Reply to send (the guest's HELLO), if any
+     * @param[out] out_size Reply size (0 = none)
+     *
+     * @return Status after the frame
+     */
+    LinkStatus receive(const uint8_t* frame, size_t size, uint8_t (&out)[LINK_MAX_FRAME],
+                       size_t& out_size);
+
+    /**
+     * @brief Choose this side's action for the current step.
+     *
+     * In a turn, `action` must be legal (BattleEngine::legal_actions(); any
+     * MOVE when the side has to Struggle). In a replacement step it must be
+     * a SWITCH to a legal member if this side has to replace, and is
+     * ignored (LINK_PASS is sent) if it does not.
+     *
+     * @param[out] out ACTION frame to send
+     *
+     * @return Frame size, or 0 (nothing sent) if not PLAYING, already
+     *         submitted this step, or the action is illegal
+     */
+    size_t submit(const BattleAction& action, uint8_t (&out)[LINK_MAX_FRAME]);
+
+    [[nodiscard]] LinkStatus status() const { return status_; }
+    [[nodiscard]] LinkRole role() const { return role_; }
+
+    /// Side this peer plays (0 for the host)
+    [[nodiscard]] uint8_t side() const { return role_ == LinkRole::HOST ? 0 : 1; }
+
+    /// PLAYING and this side's action for the step is still to be submitted
+    [[nodiscard]] bool needs_action() const {
+        return status_ == LinkStatus::PLAYING && local_code_ == NO_CODE;
+    }
+
+    /// This step is a replacement (a fainted battler is sent out)
+    [[nodiscard]] bool replacement_step() const {
+        return battle_->needs_replacement(0) || battle_->needs_replacement(1);
+    }
+
+    /// Steps completed (turns plus replacement steps)
+    [[nodiscard]] uint32_t step() const { return step_; }
+
+    /// The step whose starting states differed (valid when DESYNC)
+    [[nodiscard]] uint32_t desync_step() const { return step_; }
+
+    [[nodiscard]] const LinkSetup& setup() const { return setup_; }
+
+   private:
+    static constexpr uint8_t NO_CODE = 0xFF;
+
+    /// Set up the battle from setup_ and enter the first step
+    void start();
+    /// `action` is legal for `side` in this step
+    [[nodiscard]] bool accepts(uint8_t side, const BattleAction& action) const;
+    /// Run the step once both codes are in, then enter the next one
+    void run_step();
+    void begin_step();
+
+    size_t write_hello(uint8_t (&out)[LINK_MAX_FRAME]) const;
+
+    BattleEngine* battle_{nullptr};
+    LinkSetup setup_{};
+    LinkRole role_{LinkRole::HOST};
+    LinkStatus status_{LinkStatus::HANDSHAKE};
+    uint32_t step_{0};
+    uint32_t checksum_{0};  // link_checksum() at the start of the step
+    uint8_t local_code_{NO_CODE};
+    uint8_t peer_code_{NO_CODE};
+};
+
+}  // namespace engine::link
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "battle.hpp"
+#include "data/move.hpp"
+#include "logic/calc/type_effectiveness.hpp"
+#include "logic/state/field.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                          OBSERVATION ENCODER
+// ============================================================================
+//
+// A fixed-width feature vector of one side's view of the battle, for policy
+// networks trained on self-play. The vector is written straight into the
+// caller's buffer, and one row per battle in the batched form, so a
+// training loop hands a contiguous array to its framework with no
+// serialization step.
+//
+// Every feature is in [-1, 1]: HP, timers, stats and PP as fractions of their
+// range, stat stages over 6, flags and one-hot groups as 0/1. The float
+// encoding stores the value, the int8 encoding the value times 127
+// (rounded), computed in integers on either target.
+//
+// Layout (OBS_* offsets; the encoding side's block first, then the foe's):
+//
+//   side block (OBS_SIDE_SIZE):
+//     hp, status one-hot (6), sleep turns, toxic counter
+//     7 stat stages, 31 volatile flags
+//     7 timers (confusion, Wrap, Taunt, Encore, Disable, Perish Song, Yawn)
+//     substitute HP, types (17, multi-hot), 5 stats (Atk Def Spe SpA SpD)
+//     Reflect, Light Screen, Safeguard, Mist, Spikes, Future Sight, Wish
+//     4 moves x (id, type one-hot (17), power, accuracy, PP, legal)
+//   field block: weather one-hot (4), weather turns
+//   zero padding to OBSERVATION_SIZE
+//
+// The observation is the full state: hidden information (the foe's moves,
+// PP and sleep counter) is included, matching what the engine's own search
+// sees. Move ids are scaled by the move count; a model that embeds ids reads
+// them from BattleEngine::rental() instead.
+//
+// ============================================================================
+
+inline constexpr uint8_t OBS_STATUS_COUNT = 6;    // Status values after NONE
+inline constexpr uint8_t OBS_VOLATILE_COUNT = 31;  // volatile_flags bits in use
+inline constexpr uint8_t OBS_TIMER_COUNT = 7;
+inline constexpr uint8_t OBS_TYPE_COUNT = logic::calc::TYPE_COUNT - 1;  // Types after NONE
+inline constexpr uint8_t OBS_WEATHER_COUNT = 4;  // Weather values after NONE
+
+inline constexpr size_t OBS_MOVE_SIZE = 1 + OBS_TYPE_COUNT + 4;
+inline constexpr size_t OBS_SIDE_SIZE = 9 + 7 + OBS_VOLATILE_COUNT + OBS_TIMER_COUNT + 1 +
+                                        OBS_TYPE_COUNT + 5 + 7 + 4 * OBS_MOVE_SIZE;
+inline constexpr size_t OBS_FIELD_OFFSET = 2 * OBS_SIDE_SIZE;
+inline constexpr size_t OBS_FEATURES = OBS_FIELD_OFFSET + OBS_WEATHER_COUNT + 1;
+
+/// Features per observation (OBS_FEATURES rounded up to a 64-byte int8 row)
+inline constexpr size_t OBSERVATION_SIZE = (OBS_FEATURES + 63) / 64 * 64;
+
+// Scale of the 1.0 feature value in each encoding
+inline constexpr int32_t OBS_INT8_ONE = 127;
+
+// Ranges the count features are scaled by
+inline constexpr uint8_t OBS_MAX_STAGE = 6;
+inline constexpr uint8_t OBS_MAX_SLEEP = 7;
+inline constexpr uint8_t OBS_MAX_TOXIC = 15;
+inline constexpr uint8_t OBS_MAX_TIMER = 8;
+inline constexpr uint16_t OBS_MAX_STAT = 512;
+
+static_assert(OBS_SIDE_SIZE == 172 && OBSERVATION_SIZE == 384,
+              "observation layout changed: update the consumers' input width");
+
+namespace observation_detail {
+
+/// Sequential feature writer for a float or int8 row
+template <typename T>
+struct Writer {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, int8_t>,
+                  "observations are float or int8");
+
+    T* out;
+    size_t size{0};
+
+    /// num / den, clamped to [-1, 1] (den > 0)
+    constexpr void ratio(int32_t num, int32_t den) {
+        if (num > den)
+            num = den;
+        if (num < -den)
+            num = -den;
+        if constexpr (std::is_same_v<T, float>) {
+            out[size++] = static_cast<float>(num) / static_cast<float>(den);
+        } else {
+            const int32_t scaled = num * OBS_INT8_ONE;
+            const int32_t half = num < 0 ? -den / 2 : den / 2;
+            out[size++] = static_cast<int8_t>((scaled + half) / den);
+        }
+    }
+
+    constexpr void flag(bool set) { ratio(set ? 1 : 0, 1); }
+
+    /// One-hot group of `count` features, bit `index - 1` set (index 0 = none)
+    constexpr void one_hot(uint8_t index, uint8_t count) {
+        for (uint8_t i = 1; i <= count; ++i) {
+            flag(index == i);
+        }
+    }
+
+    constexpr void zeros(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[size++] = 0;
+        }
+    }
+};
+
+/// Turn ends left on a timer from the 1..255 clock (0 = not running)
+constexpr uint8_t turns_left(const logic::state::FieldState& field, uint8_t expiry) {
+    return expiry == 0 ? 0 : static_cast<uint8_t>(logic::state::turns_until(field.turn, expiry) + 1);
+}
+
+template <typename T>
+void encode_side(Writer<T>& w, const BattleEngine& battle, uint8_t side) {
+    const auto& state = battle.state();
+    const auto& field = state.field;
+    const auto& mon = state.mon(side);
+    const auto& slot = state.slots[side];
+    const auto& active = state.active(side);
+    const auto& side_state = state.sides[side];
+
+    w.ratio(mon.current_hp, mon.max_hp == 0 ? 1 : mon.max_hp);
+    w.one_hot(static_cast<uint8_t>(mon.status), OBS_STATUS_COUNT);
+    w.ratio(mon.sleep_turns, OBS_MAX_SLEEP);
+    w.ratio(mon.status == logic::state::Status::TOXIC ? mon.toxic_counter : 0, OBS_MAX_TOXIC);
+
+    const int8_t stages[] = {slot.atk_stage,    slot.def_stage,      slot.spd_stage,
+                             slot.sp_atk_stage, slot.sp_def_stage,   slot.accuracy_stage,
+                             slot.evasion_stage};
+    for (const int8_t stage : stages) {
+        w.ratio(stage, OBS_MAX_STAGE);
+    }
+    for (uint8_t bit = 0; bit < OBS_VOLATILE_COUNT; ++bit) {
+        w.flag(slot.volatiles & (1ul << bit));
+    }
+
+    w.ratio(slot.confusion_turns, OBS_MAX_TIMER);
+    const uint8_t timers[] = {slot.wrap_expiry,    slot.taunt_expiry,  slot.encore_expiry,
+                              slot.disable_expiry, slot.perish_expiry, slot.yawn_expiry};
+    for (const uint8_t expiry : timers) {
+        w.ratio(turns_left(field, expiry), OBS_MAX_TIMER);
+    }
+    w.ratio(slot.substitute_hp, mon.max_hp == 0 ? 1 : mon.max_hp);
+
+    for (uint8_t type = 1; type <= OBS_TYPE_COUNT; ++type) {
+        w.flag(static_cast<uint8_t>(active.type1) == type ||
+               static_cast<uint8_t>(active.type2) == type);
+    }
+    const uint16_t stats[] = {active.attack, active.defense, active.speed, active.sp_attack,
+                              active.sp_defense};
+    for (const uint16_t stat : stats) {
+        w.ratio(stat, OBS_MAX_STAT);
+    }
+
+    w.ratio(turns_left(field, side_state.reflect_expiry), OBS_MAX_TIMER);
+    w.ratio(turns_left(field, side_state.light_screen_expiry), OBS_MAX_TIMER);
+    w.ratio(turns_left(field, side_state.safeguard_expiry), OBS_MAX_TIMER);
+    w.ratio(turns_left(field, side_state.mist_expiry), OBS_MAX_TIMER);
+    w.ratio(side_state.spikes_layers, 3);
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    w.ratio(turns_left(field, field.future_sight.expiry[side]), OBS_MAX_TIMER);
+    w.ratio(turns_left(field, field.wish.expiry[side]), OBS_MAX_TIMER);
+#else
+    w.ratio(0, OBS_MAX_TIMER);  // Same layout in every build
+    w.ratio(0, OBS_MAX_TIMER);
+#endif
+
+    const ActionMask legal = battle.legal_actions(side);
+    const types::Rental& rental = battle.rental(side);
+    for (uint8_t m = 0; m < 4; ++m) {
+        const auto id = static_cast<size_t>(rental.moves[m]);
+        const types::MoveHot& hot = data::g_MOVE_HOT[id];
+        const types::MoveCold& cold = data::g_MOVE_COLD[id];
+        w.ratio(static_cast<int32_t>(id), static_cast<int32_t>(data::MOVE_COUNT - 1));
+        w.one_hot(static_cast<uint8_t>(hot.type), OBS_TYPE_COUNT);
+        w.ratio(hot.power, 255);
+        w.ratio(hot.accuracy, 100);
+        w.ratio(mon.pp[m], cold.pp == 0 ? 1 : cold.pp);
+        w.flag(legal & (1u << m));
+    }
+}
+
+}  // namespace observation_detail
+
+/**
+ * @brief Write `side`'s observation of `battle` (OBSERVATION_SIZE features).
+ *
+ * @tparam T float (values in [-1, 1]) or int8_t (values x 127)
+ * @param battle Battle to observe
+ * @param side 0 = player 1, 1 = player 2; its block comes first
+ * @param out OBSERVATION_SIZE features
+ */
+template <typename T>
+void encode_observation(const BattleEngine& battle, uint8_t side, T* out) {
+    observation_detail::Writer<T> w{out};
+    observation_detail::encode_side(w, battle, side);
+    observation_detail::encode_side(w, battle, static_cast<uint8_t>(side ^ 1));
+
+    const auto& field = battle.state().field;
+    w.one_hot(static_cast<uint8_t>(field.weather), OBS_WEATHER_COUNT);
+    const bool timed = field.weather != logic::state::Weather::NONE && field.weather_expiry != 0;
+    w.ratio(timed ? observation_detail::turns_left(field, field.weather_expiry) : 0,
+            OBS_MAX_TIMER);
+
+    CONSTEXPR_ASSERT(w.size == OBS_FEATURES);
+    w.zeros(OBSERVATION_SIZE - OBS_FEATURES);
+}
+
+/**
+ * @brief Observations of `count` battles as contiguous rows.
+ *
+ * Row i (OBSERVATION_SIZE features at out + i * OBSERVATION_SIZE) is
+ * encode_observation(*battles[i], sides ? sides[i] : side).
+ *
+ * @param battles Battles to observe
+ * @param count Number of battles
+ * @param side Side every row is encoded for (when `sides` is nullptr)
+ * @param out count * OBSERVATION_SIZE features
+ * @param sides Per-battle sides, or nullptr
+ */
+template <typename T>
+void encode_observations(const BattleEngine* const* battles, size_t count, uint8_t side, T* out,
+                         const uint8_t* sides = nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+        encode_observation(*battles[i], sides ? sides[i] : side, out + i * OBSERVATION_SIZE);
+    }
+}
+
+}  // namespace engine
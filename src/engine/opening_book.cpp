@@ -0,0 +1,46 @@
+#include "opening_book.hpp"
+
+#include "battle_log.hpp"
+
+namespace engine::book {
+
+bool at_opening(const BattleEngine& battle) {
+    const dsl::BattleState& state = battle.state();
+    if (state.field.turn != 1)
+        return false;
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        const logic::state::MonState& mon = state.mon(side);
+        if (mon.current_hp != mon.max_hp || mon.has_status())
+            return false;
+    }
+    return true;
+}
+
+bool OpeningBook::open(uint8_t level, const char* name) {
+    close();
+    uint32_t size = 0;
+    const uint8_t* payload = util::cache::map_cache(name, book_fingerprint(level), size);
+    if (!payload || size == 0 || size % sizeof(BookEntry) != 0)
+        return false;
+
+    entries_ = reinterpret_cast<const BookEntry*>(payload);
+    count_ = size / sizeof(BookEntry);
+    level_ = level;
+    return true;
+}
+
+bool OpeningBook::probe(const BattleEngine& battle, uint8_t side, BookMove& move) const {
+    if (!valid() || battle.level() != level_ || !at_opening(battle))
+        return false;
+
+    const BookEntry* entry = find(battle.rental_index(side), battle.rental_index(side ^ 1));
+    BattleAction action{};
+    if (!entry || !decode_action(entry->action, action) ||
+        !(battle.legal_actions(side) & action_bit(action)))
+        return false;
+
+    move = BookMove{action, entry->value, entry->depth};
+    return true;
+}
+
+}  // namespace engine::book
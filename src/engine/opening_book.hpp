@@ -0,0 +1,155 @@
+#pragma once
+
+/**
+ * @file opening_book.hpp
+ * @brief Turn-1 actions of common matchups, searched offline (BMBOOK AppVar)
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "battle.hpp"
+#include "data/fingerprint.hpp"
+#include "util/table_cache.hpp"
+
+namespace engine::book {
+
+// ============================================================================
+//                             OPENING BOOK
+// ============================================================================
+//
+// Turn 1 is the device search's longest think: nothing is in the
+// transposition table yet, and both sides have every move. Leads come from
+// the finite rental pool, though, so the host (battlemon_book) searches the
+// opening of each common (own rental, opponent rental) matchup deeply,
+// once, and ships the results as a sorted table. The device's Searcher
+// looks the matchup up with a binary search (SearchLimits::book) and
+// searches only when it is not in the book.
+//
+// The AppVar is a cache AppVar (util/table_cache.hpp) whose payload is the
+// BookEntry array, sorted by (own, opponent). Its fingerprint folds in the
+// data fingerprint, the book format and the level, so a book built for
+// other data or another level is never used. An entry is searched with own
+// as player 1. The position is symmetric, so the entry applies to either
+// side.
+//
+// ============================================================================
+
+inline constexpr const char* BOOK_APPVAR = "BMBOOK";
+inline constexpr uint32_t BOOK_FORMAT = 1;
+
+struct BookEntry {
+    uint16_t own;       // data::g_RENTAL_SETS index of the side to move
+    uint16_t opponent;  // ... and of its opponent
+    int16_t value;      // SearchResult::value from own's view
+    uint8_t action;     // encode_action() of the best first action
+    uint8_t depth;      // Search depth it was found at
+};
+
+static_assert(sizeof(BookEntry) == 8, "book entries are part of the AppVar format");
+
+/// Entries one AppVar holds
+inline constexpr size_t BOOK_MAX_ENTRIES = util::cache::CACHE_MAX_PAYLOAD / sizeof(BookEntry);
+
+/// Fingerprint of a book for battles at `level`
+constexpr uint32_t book_fingerprint(uint8_t level) {
+    using util::cache::fingerprint_mix;
+    return fingerprint_mix(fingerprint_mix(data::DATA_FINGERPRINT, BOOK_FORMAT), level);
+}
+
+/// Sort order of the table
+constexpr bool entry_before(const BookEntry& entry, uint16_t own, uint16_t opponent) {
+    return entry.own < own || (entry.own == own && entry.opponent < opponent);
+}
+
+/**
+ * @brief Binary search of a sorted table.
+ *
+ * @return The (own, opponent) entry, or nullptr if it is not in the table
+ */
+constexpr const BookEntry* find_entry(const BookEntry* entries, size_t count, uint16_t own,
+                                      uint16_t opponent) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (entry_before(entries[mid], own, opponent)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < count && entries[low].own == own && entries[low].opponent == opponent)
+        return &entries[low];
+    return nullptr;
+}
+
+namespace book_detail {
+inline constexpr BookEntry SAMPLE[] = {{1, 2, 10, 0, 3}, {1, 5, -4, 1, 3}, {4, 0, 7, 6, 3}};
+}  // namespace book_detail
+
+static_assert(find_entry(book_detail::SAMPLE, 3, 1, 5) == &book_detail::SAMPLE[1] &&
+              find_entry(book_detail::SAMPLE, 3, 4, 0) == &book_detail::SAMPLE[2] &&
+              find_entry(book_detail::SAMPLE, 3, 1, 3) == nullptr &&
+              find_entry(book_detail::SAMPLE, 0, 1, 2) == nullptr);
+
+/**
+ * @brief The battle is at its opening: turn 1, both battlers at full HP and
+ * without status.
+ *
+ * Entry abilities (Intimidate) have already fired after init(). The turn
+ * clock only comes back to 1 after 255 turns, and this check makes that
+ * case miss as well.
+ */
+bool at_opening(const BattleEngine& battle);
+
+/// What a book hit tells the searcher
+struct BookMove {
+    BattleAction action{};
+    int16_t value{0};
+    uint8_t depth{0};
+};
+
+/**
+ * @brief The archived opening book, read in place.
+ */
+class OpeningBook {
+   public:
+    /**
+     * @brief Map the book for battles at `level`.
+     *
+     * An archive write can move the AppVar: open() again after one.
+     *
+     * @return false if there is no valid book for this data and level
+     */
+    bool open(uint8_t level, const char* name = BOOK_APPVAR);
+
+    /// Forget the mapping
+    void close() {
+        entries_ = nullptr;
+        count_ = 0;
+    }
+
+    [[nodiscard]] bool valid() const { return entries_ != nullptr; }
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] uint8_t level() const { return level_; }
+
+    [[nodiscard]] const BookEntry* find(uint16_t own, uint16_t opponent) const {
+        return find_entry(entries_, count_, own, opponent);
+    }
+
+    /**
+     * @brief `side`'s book action, if the battle is at a booked opening.
+     *
+     * Misses for custom rentals, other levels, later turns, and actions
+     * the battle does not allow.
+     */
+    bool probe(const BattleEngine& battle, uint8_t side, BookMove& move) const;
+
+   private:
+    const BookEntry* entries_{nullptr};
+    size_t count_{0};
+    uint8_t level_{0};
+};
+
+}  // namespace engine::book
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+
+#include "battle.hpp"
+#include "logic/setup/rental_index.hpp"
+#include "util/draw_tape.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                        OPPONENT SET INFERENCE
+// ============================================================================
+//
+// In the Factory the player sees the opponent's species when it is sent
+// out, and its moves and item only as they show up in battle. OpponentModel
+// keeps the set of g_RENTAL_SETS entries consistent with everything seen so
+// far as a RentalSet bitmap. Each observation is one posting list folded
+// into the bitmap (logic/setup/rental_index.hpp): a few hundred bit sets and
+// a 28-word AND, cheap enough to run every turn on the calculator.
+//
+// Evidence comes in two kinds:
+//   - positive: observe_species(), observe_move(), observe_item() keep the
+//     rentals that have the trait (e.g. Leftovers healed at turn end)
+//   - negative: rule_out_item() drops the rentals that have it (e.g. the mon
+//     ended a turn hurt and did not heal, so it is not holding Leftovers)
+//
+// The Factory draws rentals uniformly, so the candidate distribution is
+// uniform over the set. An observation that would leave no candidate (a
+// move no rental carries, e.g. Struggle) is ignored rather than emptying
+// the model.
+//
+// ============================================================================
+
+class OpponentModel {
+   public:
+    using Probability = util::random::Probability;
+
+    /// Nothing observed: every rental is a candidate
+    OpponentModel() { reset(); }
+
+    void reset() {
+        candidates_ = logic::setup::RentalSet::all();
+        count_ = static_cast<uint16_t>(logic::setup::RENTAL_COUNT);
+    }
+
+    // ========================================================================
+    //                            OBSERVATIONS
+    // ========================================================================
+
+    /// The opponent was sent out as `species`
+    bool observe_species(types::enums::Species species) {
+        return narrow(logic::setup::rentals_of_species(species));
+    }
+
+    /// The opponent used `move`
+    bool observe_move(types::enums::Move move) {
+        return narrow(logic::setup::rentals_with_move(move));
+    }
+
+    /// The opponent's item revealed itself (activation message)
+    bool observe_item(types::enums::Item item) {
+        return narrow(logic::setup::rentals_with_item(item));
+    }
+
+    /// The opponent would have shown `item` by now, so it does not hold it
+    bool rule_out_item(types::enums::Item item) {
+        logic::setup::RentalSet narrowed = candidates_;
+        narrowed.subtract(logic::setup::rentals_with_item(item));
+        return commit(narrowed);
+    }
+
+    /**
+     * @brief Observe `side`'s action of the turn just played in `battle`.
+     *
+     * For simulations, where the observed move comes from the engine: a
+     * MOVE action reveals the move in that slot of the side's rental.
+     */
+    bool observe_action(const BattleEngine& battle, uint8_t side, const BattleAction& action) {
+        if (action.type != BattleAction::Type::MOVE || action.index >= 4)
+            return false;
+        const types::enums::Move move = battle.rental(side).moves[action.index];
+        if (move == types::enums::Move::NONE)
+            return false;
+        return observe_move(move);
+    }
+
+    // ========================================================================
+    //                        CANDIDATE DISTRIBUTION
+    // ========================================================================
+
+    [[nodiscard]] const logic::setup::RentalSet& candidates() const { return candidates_; }
+    [[nodiscard]] uint16_t count() const { return count_; }
+
+    [[nodiscard]] bool is_candidate(uint16_t rental) const {
+        return candidates_.contains(rental);
+    }
+
+    /// Probability that the opponent is `rental`
+    [[nodiscard]] Probability probability(uint16_t rental) const {
+        return is_candidate(rental) ? util::random::ratio(1, count_) : 0;
+    }
+
+    /// Probability that the opponent carries `move` (fraction of candidates)
+    [[nodiscard]] Probability move_probability(types::enums::Move move) const {
+        return share(logic::setup::rentals_with_move(move));
+    }
+
+    /// Probability that the opponent holds `item`
+    [[nodiscard]] Probability item_probability(types::enums::Item item) const {
+        return share(logic::setup::rentals_with_item(item));
+    }
+
+    /// Uniform draw from the candidates (for determinized search)
+    [[nodiscard]] uint16_t sample(util::random::Rng& rng) const {
+        uint16_t skip = rng.random(count_);
+        for (uint16_t r = candidates_.next(); r < logic::setup::RENTAL_COUNT;
+             r = candidates_.next(static_cast<uint16_t>(r + 1))) {
+            if (skip-- == 0)
+                return r;
+        }
+        return candidates_.next();
+    }
+
+    /// Call visit(rental) for every candidate in index order
+    template <typename Visit>
+    void for_each_candidate(Visit&& visit) const {
+        for (uint16_t r = candidates_.next(); r < logic::setup::RENTAL_COUNT;
+             r = candidates_.next(static_cast<uint16_t>(r + 1))) {
+            visit(r);
+        }
+    }
+
+   private:
+    bool narrow(logic::setup::PostingList list) {
+        logic::setup::RentalSet narrowed = candidates_;
+        narrowed.intersect(list);
+        return commit(narrowed);
+    }
+
+    /// Adopt `narrowed` unless it contradicts everything
+    bool commit(const logic::setup::RentalSet& narrowed) {
+        const uint16_t count = narrowed.count();
+        if (count == 0)
+            return false;
+        candidates_ = narrowed;
+        count_ = count;
+        return true;
+    }
+
+    [[nodiscard]] Probability share(logic::setup::PostingList list) const {
+        uint16_t matches = 0;
+        for (const uint16_t rental : list) {
+            matches = static_cast<uint16_t>(matches + candidates_.contains(rental));
+        }
+        return util::random::ratio(matches, count_);
+    }
+
+    logic::setup::RentalSet candidates_;
+    uint16_t count_{0};
+};
+
+}  // namespace engine
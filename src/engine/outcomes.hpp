@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "battle.hpp"
+#include "util/draw_tape.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                          TURN OUTCOME ENUMERATION
+// ============================================================================
+//
+// Every state a turn can end in, with its exact probability, by running
+// execute_turn() under a util::random::DrawTape once per leaf of the turn's
+// draw tree (see draw_tape.hpp).
+//
+// Draw sites branch as narrowly as they can: accuracy, crits, Quick Claw,
+// Focus Band, King's Rock and the speed tie are two-way chance() draws,
+// damage rolls that deal equal damage are one branch, and a multi-hit move
+// is one branch per total damage (logic/ops/multi_hit.hpp), not one per
+// count, crit and roll. Leaves that still end in the same state (e.g.
+// every roll that KOs) are merged by state hash in enumerate_turn().
+//
+// ============================================================================
+
+using util::random::Probability;
+using util::random::PROBABILITY_ONE;
+
+/// One distinct end-of-turn state
+struct TurnOutcome {
+    BattleSnapshot state;
+    uint64_t hash;  // BattleEngine::hash() of state
+    Probability probability;
+};
+
+/// Summary of an enumerate_turn() call
+struct TurnEnumeration {
+    uint16_t count{0};     // Distinct outcomes written
+    uint32_t leaves{0};    // Turn executions
+    bool complete{true};   // false: outcomes were dropped for lack of capacity
+};
+
+/**
+ * @brief Visit every leaf of the turn (p1_action, p2_action) from `root`.
+ *
+ * For each leaf, `battle` is restored to `root`, the turn is executed, and
+ * visit(battle, probability) is called with the battle in the leaf's end
+ * state. The visitor may search on from there (its own turns draw normally
+ * or from their own tape). `battle` ends restored to `root`.
+ *
+ * @param visit Callable (BattleEngine&, Probability) -> bool (false = stop)
+ *
+ * @return false if the visitor stopped the walk
+ */
+template <typename Visit>
+bool for_each_outcome(BattleEngine& battle, const BattleSnapshot& root,
+                      const BattleAction& p1_action, const BattleAction& p2_action,
+                      Visit&& visit) {
+    util::random::DrawTape tape;
+    do {
+        battle.restore(root);
+        {
+            util::random::TapeScope scope(&tape);
+            battle.execute_turn(p1_action, p2_action);
+        }
+        assert(!tape.overflowed() && "turn drew more than DrawTape::MAX_BRANCHES branches");
+        if (!visit(battle, tape.probability())) {
+            battle.restore(root);
+            return false;
+        }
+    } while (tape.advance());
+
+    battle.restore(root);
+    return true;
+}
+
+/**
+ * @brief Distinct end states of the turn (p1_action, p2_action), merged by hash.
+ *
+ * `battle` is left in its current (pre-turn) state; like restore(), this
+ * detaches an attached battle log.
+ *
+ * @param out Outcome array to fill
+ * @param capacity Length of out
+ */
+inline TurnEnumeration enumerate_turn(BattleEngine& battle, const BattleAction& p1_action,
+                                      const BattleAction& p2_action, TurnOutcome* out,
+                                      uint16_t capacity) {
+    TurnEnumeration result{};
+    const BattleSnapshot root = battle.save();
+
+    for_each_outcome(battle, root, p1_action, p2_action,
+                     [&](BattleEngine& leaf, Probability probability) {
+                         ++result.leaves;
+                         const uint64_t hash = leaf.hash();
+                         for (uint16_t i = 0; i < result.count; ++i) {
+                             if (out[i].hash == hash) {
+                                 out[i].probability += probability;
+                                 return true;
+                             }
+                         }
+                         if (result.count < capacity) {
+                             out[result.count++] = TurnOutcome{leaf.save(), hash, probability};
+                         } else {
+                             result.complete = false;
+                         }
+                         return true;
+                     });
+    return result;
+}
+
+}  // namespace engine
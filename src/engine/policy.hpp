@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+
+#include "battle.hpp"
+#include "data/move.hpp"
+#include "logic/calc/move_scores.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                              ACTION POLICY
+// ============================================================================
+//
+// A policy picks one side's action for the coming turn. Policies are plain
+// function pointers so batch jobs stay trivially copyable.
+//
+// Policies draw from their own Rng, never from the battle's: choosing actions
+// must not perturb the battle's random sequence.
+//
+// ============================================================================
+
+using Policy = BattleAction (*)(const BattleEngine& battle, uint8_t side, util::random::Rng& rng);
+
+/**
+ * @brief The side's legal moves (BattleEngine::legal_actions()) as MOVE actions.
+ *
+ * @param battle Battle to decide in
+ * @param side 0 = player 1, 1 = player 2
+ * @param[out] out Legal actions in slot order
+ *
+ * @return Number of actions written (0-4; 0 = the side has to Struggle)
+ */
+inline uint8_t legal_moves(const BattleEngine& battle, uint8_t side, BattleAction (&out)[4]) {
+    uint8_t count = 0;
+    for_each_action(battle.legal_actions(side) & ACTION_MOVES,
+                    [&](const BattleAction& action) { out[count++] = action; });
+    return count;
+}
+
+/**
+ * @brief Send in the lowest-indexed legal member for every fainted battler.
+ *
+ * A party battle stalls once an active battler faints: its only legal
+ * actions are switches, and execute_turn() needs both battlers standing.
+ * Every driver that plays turns under move policies (run_battle(), the
+ * searches' child nodes, the server) calls this between turns. A no-op in
+ * 1v1 battles, which end at the first faint.
+ */
+inline void replace_fainted(BattleEngine& battle) {
+    for (uint8_t side = 0; side < 2; ++side) {
+        if (!battle.needs_replacement(side))
+            continue;
+        const ActionMask switches = battle.legal_actions(side) & ACTION_SWITCHES;
+        for_each_action(switches, [&](const BattleAction& action) {
+            if (battle.needs_replacement(side))
+                battle.replace(side, action.index);
+        });
+    }
+}
+
+/**
+ * @brief Uniform random choice among the side's legal moves.
+ */
+inline BattleAction random_move_policy(const BattleEngine& battle, uint8_t side,
+                                       util::random::Rng& rng) {
+    BattleAction legal[4];
+    const uint8_t count = legal_moves(battle, side, legal);
+    if (count == 0) {
+        return BattleAction::move(0);
+    }
+    return legal[rng.random(count)];
+}
+
+/**
+ * @brief Expected damage of each of `side`'s moves against the opposing active mon.
+ *
+ * One logic::calc::score_moves() grid (target 0 is the opponent), built from
+ * the battle's active stats, stat stages and rental moves.
+ */
+inline logic::calc::MoveScoreGrid score_side_moves(const BattleEngine& battle, uint8_t side) {
+    const auto& attacker = side == 0 ? battle.p1_active() : battle.p2_active();
+    const auto& attacker_slot = side == 0 ? battle.p1_slot() : battle.p2_slot();
+    const logic::calc::ScoreTarget target{side == 0 ? &battle.p2_active() : &battle.p1_active(),
+                                          side == 0 ? &battle.p2_slot() : &battle.p1_slot()};
+
+    const types::Rental& rental = battle.rental(side);
+    const types::MoveHot* moves[logic::calc::SCORE_MOVES];
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        moves[m] = &data::g_MOVE_HOT[static_cast<size_t>(rental.moves[m])];
+    }
+    return logic::calc::score_moves(attacker, attacker_slot, moves, &target, 1);
+}
+
+/// Expected damage times accuracy of a move against the foe (never-miss moves count as 100%)
+inline uint32_t hit_score(const logic::calc::MoveScoreGrid& grid, types::enums::Move move,
+                          uint8_t slot) {
+    const uint8_t accuracy = data::g_MOVE_HOT[static_cast<size_t>(move)].accuracy;
+    return static_cast<uint32_t>(grid.expected[slot][0]) * (accuracy == 0 ? 100u : accuracy);
+}
+
+/**
+ * @brief Best hit_score() of benched party member `member` against the opposing active mon.
+ *
+ * Scored as the member would enter: its own stats and PP, no stat stages.
+ */
+inline uint32_t benched_hit_score(const BattleEngine& battle, uint8_t side, uint8_t member) {
+    const dsl::BattleState& state = battle.state();
+    const auto foe = static_cast<uint8_t>(side ^ 1);
+    const dsl::Party& party = state.parties[side];
+    const types::Rental& rental = party.rentals[member];
+    const types::MoveHot* moves[logic::calc::SCORE_MOVES];
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        moves[m] = party.mons[member].pp[m] == 0
+                       ? nullptr
+                       : &data::g_MOVE_HOT[static_cast<size_t>(rental.moves[m])];
+    }
+    const logic::calc::ScoreTarget target{&state.active(foe), &state.slots[foe]};
+    const logic::state::SlotState entering{};
+    const auto grid =
+        logic::calc::score_moves(party.active[member], entering, moves, &target, 1);
+
+    uint32_t best = 0;
+    for (uint8_t m = 0; m < logic::calc::SCORE_MOVES; ++m) {
+        if (moves[m] == nullptr)
+            continue;
+        const uint32_t score = hit_score(grid, rental.moves[m], m);
+        if (score > best)
+            best = score;
+    }
+    return best;
+}
+
+/**
+ * @brief The legal move with the highest expected damage times accuracy.
+ *
+ * Never-miss moves (accuracy 0) count as 100%. When none of the active
+ * mon's moves does damage (Normal moves into a Ghost), switches to the legal
+ * benched member with the best hit instead; failing that, picks a uniform
+ * random legal move.
+ */
+inline BattleAction greedy_damage_policy(const BattleEngine& battle, uint8_t side,
+                                         util::random::Rng& rng) {
+    BattleAction legal[4];
+    const uint8_t count = legal_moves(battle, side, legal);
+    if (count == 0) {
+        return BattleAction::move(0);
+    }
+
+    const auto grid = score_side_moves(battle, side);
+    const types::Rental& rental = battle.rental(side);
+    uint8_t best = 0;
+    uint32_t best_score = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        const uint8_t slot = legal[i].index;
+        const uint32_t score = hit_score(grid, rental.moves[slot], slot);
+        if (score > best_score) {
+            best = i;
+            best_score = score;
+        }
+    }
+    if (best_score != 0) {
+        return legal[best];
+    }
+
+    BattleAction swap{};
+    uint32_t swap_score = 0;
+    for_each_action(battle.legal_actions(side) & ACTION_SWITCHES,
+                    [&](const BattleAction& action) {
+                        const uint32_t score = benched_hit_score(battle, side, action.index);
+                        if (score > swap_score) {
+                            swap = action;
+                            swap_score = score;
+                        }
+                    });
+    return swap_score != 0 ? swap : legal[rng.random(count)];
+}
+
+}  // namespace engine
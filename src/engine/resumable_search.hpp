@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ai.hpp"
+#include "util/platform.hpp"
+
+namespace engine::ai {
+
+// ============================================================================
+//                          RESUMABLE SEARCH
+// ============================================================================
+//
+// The Searcher's expectiminimax as a state machine the UI loop drives one
+// slice at a time, so a think never freezes the screen on the calculator's
+// single core:
+//
+//   searcher.start(battle, side);
+//   while (!searcher.step(budget_cycles)) {
+//       draw_frame(searcher.best_action());
+//   }
+//
+// The recursion is unrolled into one frame per ply (the decision node's
+// action lists and loop counters, and the chance node's sample index and
+// running sum) plus the per-ply snapshots the Searcher already keeps. Every
+// byte is a member: step() allocates nothing and may stop after any
+// executed turn, with the engine copy left on the child state the next
+// step() opens first.
+//
+// Run to completion it visits the nodes in the Searcher's order and returns
+// its action, value, depth and node count. Chance nodes are always sampled
+// (limits.exact_chance is ignored: the enumeration is callback-driven and
+// cannot be suspended). The node and time budgets end the search as they
+// do in Searcher::search(); the time budget counts cycles spent in step().
+//
+// ============================================================================
+
+/**
+ * @brief Iterative-deepening search, resumable after any node.
+ *
+ * @tparam Table TranspositionTable<N> or the host SharedTranspositionTable
+ */
+template <typename Table>
+class ResumableSearcher {
+   public:
+    ResumableSearcher(Table& table, const SearchLimits& limits) : table_(table), limits_(limits) {
+        if (limits_.max_depth > MAX_SEARCH_DEPTH)
+            limits_.max_depth = MAX_SEARCH_DEPTH;
+        if (limits_.max_depth == 0)
+            limits_.max_depth = 1;
+        if (limits_.chance_samples == 0)
+            limits_.chance_samples = 1;
+        if (limits_.weights == nullptr)
+            limits_.weights = &DEFAULT_EVAL_WEIGHTS;
+    }
+
+    /**
+     * @brief Begin choosing `side`'s action (takes a private copy of `battle`).
+     *
+     * @param battle Battle to decide in (not modified)
+     * @param side 0 = player 1, 1 = player 2
+     */
+    void start(const BattleEngine& battle, uint8_t side) {
+        // A booked opening is done before the first step()
+        book::BookMove booked;
+        if (limits_.book && limits_.book->probe(battle, side, booked)) {
+            result_ = SearchResult{booked.action, booked.value, booked.depth, 0};
+            nodes_ = 0;
+            root_open_ = false;
+            phase_ = Phase::DONE;
+            return;
+        }
+
+        table_.new_search();
+        battle_ = battle;
+        side_ = side;
+        eval_cache_.clear();
+        result_ = SearchResult{candidate_actions(battle, side).actions[0], 0, 0, 0};
+        nodes_ = 0;
+        elapsed_ = 0;
+        deadline_ = static_cast<uint64_t>(limits_.time_budget_ms) *
+                    (util::platform::cycle_counter_hz() / 1000);
+        iteration_ = 1;
+        phase_ = Phase::OPEN;
+        open_depth_ = iteration_;
+    }
+
+    /**
+     * @brief Search for about `budget_cycles` cycle_count() ticks.
+     *
+     * Checks the clock after every executed turn, so a slice overruns its
+     * budget by at most one turn and one leaf evaluation.
+     *
+     * @return true once the search has finished (result() is final)
+     */
+    bool step(uint32_t budget_cycles) {
+        const uint32_t begin = util::platform::cycle_count();
+        while (phase_ != Phase::DONE) {
+            if (phase_ == Phase::OPEN) {
+                int16_t value;
+                if (open_node(open_depth_, value)) {
+                    deliver(open_depth_, value);
+                } else {
+                    current_ = open_depth_;
+                    phase_ = Phase::NEXT;
+                }
+                continue;
+            }
+
+            // Phase::NEXT: run the current frame's next chance sample, or close it
+            Frame& frame = frames_[current_];
+            if (!next_pair(frame)) {
+                table_.store(frame.key, TTData{frame.best_value, current_, TTBound::EXACT,
+                                               encode_action(frame.best_action)});
+                deliver(current_, frame.best_value);
+                continue;
+            }
+            const BattleAction& mine = frame.mine.actions[frame.i];
+            const BattleAction& theirs = frame.theirs.actions[frame.j];
+            battle_.rng().seed(frame.node_hash, frame.k);
+            battle_.execute_turn(side_ == 0 ? mine : theirs, side_ == 0 ? theirs : mine);
+            ++nodes_;
+            open_depth_ = static_cast<uint8_t>(current_ - 1);
+            phase_ = Phase::OPEN;
+
+            const uint32_t spent = util::platform::cycle_count() - begin;
+            if (out_of_budget(spent)) {
+                phase_ = Phase::DONE;
+                break;
+            }
+            if (spent >= budget_cycles) {
+                elapsed_ += spent;
+                return false;
+            }
+        }
+        root_open_ = false;
+        return true;
+    }
+
+    [[nodiscard]] bool done() const { return phase_ == Phase::DONE; }
+
+    /// Best action of the deepest completed iteration (a fallback move before the first)
+    [[nodiscard]] SearchResult result() const {
+        SearchResult result = result_;
+        result.nodes = nodes_;
+        return result;
+    }
+
+    /**
+     * @brief Best action so far: result(), or the running iteration's best once
+     * it has searched the previous best (its first root action) and found better.
+     */
+    [[nodiscard]] BattleAction best_action() const {
+        if (phase_ != Phase::DONE && iteration_ > result_.depth) {
+            const Frame& root = frames_[iteration_];
+            if (root_open_ && root.i > 0 && root.best_value > INT16_MIN)
+                return root.best_action;
+        }
+        return result_.action;
+    }
+
+    [[nodiscard]] uint32_t nodes() const { return nodes_; }
+    [[nodiscard]] const SearchLimits& limits() const { return limits_; }
+
+   private:
+    enum class Phase : uint8_t {
+        OPEN,  // battle_ holds a node at open_depth_ to score or expand
+        NEXT,  // frames_[current_] runs its next chance sample or closes
+        DONE,
+    };
+
+    /// A decision node and the chance node of its current (i, j) pair
+    struct Frame {
+        uint64_t node_hash{0};
+        uint64_t key{0};
+        ActionList mine{};
+        ActionList theirs{};
+        uint8_t i{0};  // Own action
+        uint8_t j{0};  // Reply
+        uint8_t k{0};  // Chance sample
+        int32_t sum{0};
+        int16_t worst{INT16_MAX};
+        int16_t best_value{INT16_MIN};
+        BattleAction best_action{};
+    };
+
+    /**
+     * @brief Score the node in battle_ at `depth`, or push its frame.
+     *
+     * @return true if the node resolved at once (terminal, leaf or table hit)
+     */
+    bool open_node(uint8_t depth, int16_t& value) {
+        const BattleResult result = battle_.result();
+        if (result != BattleResult::ONGOING) {
+            const bool won = static_cast<uint8_t>(result) == side_;
+            value = static_cast<int16_t>(won ? WIN_SCORE + depth : -(WIN_SCORE + depth));
+            if (depth == iteration_)
+                frames_[depth].best_action = result_.action;
+            return true;
+        }
+        replace_fainted(battle_);  // Undone when the parent restores its snapshot
+        if (depth == 0) {
+            value = evaluate(battle_.state(), side_, *limits_.weights, &eval_cache_);
+            return true;
+        }
+
+        Frame& frame = frames_[depth];
+        frame.node_hash = battle_.hash();
+        frame.key = side_ ? frame.node_hash ^ SIDE_KEY : frame.node_hash;
+        frame.mine = candidate_actions(battle_, side_);
+
+        TTData cached;
+        if (table_.probe(frame.key, cached)) {
+            BattleAction hint;
+            const bool has_hint = cached.best_action(hint);
+            if (cached.depth >= depth && cached.bound == TTBound::EXACT && has_hint) {
+                value = cached.value;
+                frame.best_action = hint;
+                return true;
+            }
+            if (has_hint)
+                move_to_front(frame.mine, hint);
+        }
+        frame.theirs = candidate_actions(battle_, static_cast<uint8_t>(side_ ^ 1));
+        frame.i = frame.j = frame.k = 0;
+        frame.sum = 0;
+        frame.worst = INT16_MAX;
+        frame.best_value = INT16_MIN;
+        frame.best_action = frame.mine.actions[0];
+        snapshots_[depth] = battle_.save();
+        if (depth == iteration_)
+            root_open_ = true;
+        return false;
+    }
+
+    /// Advance past finished own actions; false once every action has been searched
+    static bool next_pair(Frame& frame) {
+        while (frame.i < frame.mine.count) {
+            if (frame.j < frame.theirs.count && frame.worst > frame.best_value)
+                return true;
+            if (frame.worst > frame.best_value) {
+                frame.best_value = frame.worst;
+                frame.best_action = frame.mine.actions[frame.i];
+            }
+            ++frame.i;
+            frame.j = 0;
+            frame.worst = INT16_MAX;
+        }
+        return false;
+    }
+
+    /// Hand the value of the node at `depth` to its parent chance node (or the iteration)
+    void deliver(uint8_t depth, int16_t value) {
+        if (depth == iteration_) {
+            result_.action = frames_[depth].best_action;
+            result_.value = value;
+            result_.depth = depth;
+            root_open_ = false;
+            if (++iteration_ > limits_.max_depth) {
+                phase_ = Phase::DONE;
+                return;
+            }
+            open_depth_ = iteration_;
+            phase_ = Phase::OPEN;
+            return;
+        }
+
+        const auto parent_depth = static_cast<uint8_t>(depth + 1);
+        Frame& parent = frames_[parent_depth];
+        battle_.restore(snapshots_[parent_depth]);
+        parent.sum += value;
+        if (++parent.k == limits_.chance_samples) {
+            const auto reply = static_cast<int16_t>(parent.sum / limits_.chance_samples);
+            if (reply < parent.worst)
+                parent.worst = reply;
+            parent.k = 0;
+            parent.sum = 0;
+            ++parent.j;
+        }
+        current_ = parent_depth;
+        phase_ = Phase::NEXT;
+    }
+
+    /// Node and total time budgets (the step's own spend not yet in elapsed_)
+    [[nodiscard]] bool out_of_budget(uint32_t spent) const {
+        if (limits_.node_budget && nodes_ >= limits_.node_budget)
+            return true;
+        return deadline_ && elapsed_ + spent >= deadline_;
+    }
+
+    Table& table_;
+    SearchLimits limits_;
+
+    BattleEngine battle_{};
+    BattleSnapshot snapshots_[MAX_SEARCH_DEPTH + 1]{};
+    Frame frames_[MAX_SEARCH_DEPTH + 1]{};
+    EvalCache eval_cache_{};
+    SearchResult result_{};
+    uint8_t side_{0};
+
+    Phase phase_{Phase::DONE};
+    uint8_t iteration_{1};   // Depth of the running iteration
+    uint8_t open_depth_{1};  // Node to open next (Phase::OPEN)
+    uint8_t current_{1};     // Innermost frame (Phase::NEXT)
+    bool root_open_{false};  // frames_[iteration_] holds the running root
+
+    uint32_t nodes_{0};
+    uint64_t elapsed_{0};   // Ticks spent in earlier steps
+    uint64_t deadline_{0};  // Ticks, 0 = no time budget
+};
+
+}  // namespace engine::ai
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+
+// ============================================================================
+//                              RULES VERSION
+// ============================================================================
+//
+// Battle logs and matchup matrices record results of the engine's rules.
+// Bump RULES_VERSION with any change to battle mechanics that moves results
+// in a way rental fingerprints cannot see: a log from other rules then fails
+// to replay with ReplayStatus::OLD_RULES instead of DIVERGED, and
+// battlemon_matrix stops reusing cells from other rules.
+//
+// ============================================================================
+
+inline constexpr uint8_t RULES_VERSION = 10;
+
+}  // namespace engine
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include "battle.hpp"
+#include "policy.hpp"
+#include "util/random.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                            BATTLE SIMULATION
+// ============================================================================
+//
+// Plays a battle to completion under two policies. Shared by the host batch
+// runner and the simulation tools.
+//
+// ============================================================================
+
+/// Default turn cap (stalemates: e.g. Normal-only vs. Ghost)
+inline constexpr uint16_t DEFAULT_MAX_TURNS = 500;
+
+/// Compact result of one simulated battle
+struct BattleOutcome {
+    BattleResult result{BattleResult::ONGOING};  // ONGOING = hit the turn cap
+    uint16_t turns{0};
+};
+
+/**
+ * @brief Run an initialized battle until one side faints or max_turns.
+ *
+ * @param battle Battle after init()
+ * @param p1_policy Player 1's policy
+ * @param p2_policy Player 2's policy
+ * @param policy_rng RNG for both policies (separate from the battle's)
+ * @param max_turns Turn cap
+ *
+ * @return Winner (or ONGOING at the cap) and number of turns played
+ */
+inline BattleOutcome run_battle(BattleEngine& battle, Policy p1_policy, Policy p2_policy,
+                                util::random::Rng& policy_rng,
+                                uint16_t max_turns = DEFAULT_MAX_TURNS) {
+    BattleOutcome outcome{};
+
+    while (battle.result() == BattleResult::ONGOING && outcome.turns < max_turns) {
+        replace_fainted(battle);
+        const BattleAction p1_action = p1_policy(battle, 0, policy_rng);
+        const BattleAction p2_action = p2_policy(battle, 1, policy_rng);
+        battle.execute_turn(p1_action, p2_action);
+        ++outcome.turns;
+    }
+
+    outcome.result = battle.result();
+    return outcome;
+}
+
+}  // namespace engine
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "battle.hpp"
+#include "battle_log.hpp"
+
+namespace engine {
+
+// ============================================================================
+//                          TRANSPOSITION TABLE
+// ============================================================================
+//
+// Caches search results by BattleEngine::hash(), so positions that Haze,
+// Recover and stat-boost loops revisit are evaluated once per search.
+//
+// The table is bucketed: a hash selects one bucket of TT_BUCKET_SIZE entries
+// and any entry of it may hold the position. Replacement keeps the deepest
+// results of the current search; entries left over from earlier searches
+// (older generation) are replaced first.
+//
+// An entry packs into 8 bytes:
+//
+//   check:u32   upper half of the hash (the bucket index uses the lower)
+//   value:i16   search score
+//   depth:u8    remaining search depth of the result
+//   meta:u8     best action (4-bit log code) | bound (2) | generation (2)
+//
+// TranspositionTable<N> is the single-threaded, statically sized table
+// (N buckets: TranspositionTable<128> is 4 KB for the calculator). The host
+// lock-free table (host/engine/shared_transposition.hpp) stores the same
+// packed data.
+//
+// ============================================================================
+
+inline constexpr uint8_t TT_BUCKET_SIZE = 4;
+inline constexpr uint8_t TT_NO_ACTION = 0xF;
+
+/// How the stored value relates to the true score (alpha-beta style)
+enum class TTBound : uint8_t {
+    NONE = 0,
+    EXACT = 1,
+    LOWER = 2,  // True score >= value (search failed high)
+    UPPER = 3,  // True score <= value (search failed low)
+};
+
+/// A cached search result
+struct TTData {
+    int16_t value{0};
+    uint8_t depth{0};
+    TTBound bound{TTBound::NONE};
+    uint8_t action{TT_NO_ACTION};  // encode_action() code of the best action
+
+    /// Best action, if the search recorded one
+    bool best_action(BattleAction& out) const { return decode_action(action, out); }
+};
+
+/// Packed 32-bit form (value, depth, meta) shared by both tables
+constexpr uint32_t pack_tt_data(const TTData& data, uint8_t generation) {
+    const uint8_t meta = static_cast<uint8_t>((data.action & 0xF) << 4 |
+                                              (static_cast<uint8_t>(data.bound) & 0x3) << 2 |
+                                              (generation & 0x3));
+    return static_cast<uint16_t>(data.value) | static_cast<uint32_t>(data.depth) << 16 |
+           static_cast<uint32_t>(meta) << 24;
+}
+
+constexpr TTData unpack_tt_data(uint32_t packed) {
+    const uint8_t meta = static_cast<uint8_t>(packed >> 24);
+    return TTData{static_cast<int16_t>(packed & 0xFFFF), static_cast<uint8_t>(packed >> 16),
+                  static_cast<TTBound>((meta >> 2) & 0x3), static_cast<uint8_t>(meta >> 4)};
+}
+
+constexpr uint8_t tt_generation(uint32_t packed) {
+    return static_cast<uint8_t>((packed >> 24) & 0x3);
+}
+
+constexpr TTBound tt_bound(uint32_t packed) {
+    return static_cast<TTBound>((packed >> 26) & 0x3);
+}
+
+/**
+ * @brief Replacement priority of an occupied entry (lowest is evicted).
+ *
+ * Results of the running search outrank any older ones; among equals the
+ * shallower result goes first.
+ */
+constexpr uint16_t tt_keep_priority(uint32_t packed, uint8_t generation) {
+    const uint16_t current = tt_generation(packed) == generation ? 0x100 : 0;
+    return static_cast<uint16_t>(current | ((packed >> 16) & 0xFF));
+}
+
+/**
+ * @brief Single-threaded transposition table with static storage.
+ *
+ * @tparam BucketCount Number of buckets (power of two)
+ */
+template <uint16_t BucketCount>
+class TranspositionTable {
+    static_assert(BucketCount > 0 && (BucketCount & (BucketCount - 1)) == 0,
+                  "bucket count must be a power of two");
+
+   public:
+    struct Entry {
+        uint32_t check;
+        uint32_t data;  // pack_tt_data(); bound NONE = empty
+    };
+
+    static constexpr size_t ENTRY_COUNT = static_cast<size_t>(BucketCount) * TT_BUCKET_SIZE;
+    static constexpr size_t BYTES = ENTRY_COUNT * sizeof(Entry);
+
+    /// Empty every entry
+    void clear() {
+        for (Entry& entry : entries_) {
+            entry = Entry{0, 0};
+        }
+        generation_ = 0;
+    }
+
+    /// Start a new search: older results become the first to be replaced
+    void new_search() { generation_ = static_cast<uint8_t>((generation_ + 1) & 0x3); }
+
+    /**
+     * @brief Look up a position.
+     *
+     * @return true and the stored result if the position is cached
+     */
+    bool probe(uint64_t hash, TTData& out) const {
+        const Entry* bucket = bucket_for(hash);
+        const uint32_t check = static_cast<uint32_t>(hash >> 32);
+        for (uint8_t i = 0; i < TT_BUCKET_SIZE; ++i) {
+            if (bucket[i].check == check && tt_bound(bucket[i].data) != TTBound::NONE) {
+                out = unpack_tt_data(bucket[i].data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Store a search result.
+     *
+     * Overwrites the position's own entry (unless that holds a deeper result
+     * of this search), otherwise the bucket's lowest-priority entry.
+     */
+    void store(uint64_t hash, const TTData& data) {
+        Entry* bucket = bucket_for(hash);
+        const uint32_t check = static_cast<uint32_t>(hash >> 32);
+        const uint32_t packed = pack_tt_data(data, generation_);
+
+        Entry* victim = &bucket[0];
+        for (uint8_t i = 0; i < TT_BUCKET_SIZE; ++i) {
+            Entry& entry = bucket[i];
+            if (tt_bound(entry.data) == TTBound::NONE) {
+                victim = &entry;
+                break;
+            }
+            if (entry.check == check) {
+                const bool deeper_now = tt_generation(entry.data) == generation_ &&
+                                        unpack_tt_data(entry.data).depth > data.depth;
+                if (deeper_now)
+                    return;
+                victim = &entry;
+                break;
+            }
+            if (tt_keep_priority(entry.data, generation_) <
+                tt_keep_priority(victim->data, generation_)) {
+                victim = &entry;
+            }
+        }
+        *victim = Entry{check, packed};
+    }
+
+   private:
+    const Entry* bucket_for(uint64_t hash) const {
+        return &entries_[(static_cast<uint32_t>(hash) & (BucketCount - 1)) * TT_BUCKET_SIZE];
+    }
+    Entry* bucket_for(uint64_t hash) {
+        return &entries_[(static_cast<uint32_t>(hash) & (BucketCount - 1)) * TT_BUCKET_SIZE];
+    }
+
+    Entry entries_[ENTRY_COUNT]{};
+    uint8_t generation_{0};
+};
+
+/// Calculator configuration: 128 buckets x 4 entries x 8 bytes = 4 KB
+using CalcTranspositionTable = TranspositionTable<128>;
+
+static_assert(CalcTranspositionTable::BYTES == 4096, "calculator table must stay at 4 KB");
+
+}  // namespace engine
@@ -2,7 +2,9 @@
 
 #include <cstdint>
 
+#include "data/move.hpp"
 #include "types/calc.hpp"
+#include "util/fastdiv.hpp"
 #include "util/random.hpp"
 
 namespace logic::calc {
@@ -41,6 +43,26 @@ namespace logic::calc {
 constexpr uint8_t ACC_STAGE_NUMERATORS[13] = {3, 3, 3, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9};
 constexpr uint8_t ACC_STAGE_DENOMINATORS[13] = {9, 8, 7, 6, 5, 4, 3, 3, 3, 3, 3, 3, 3};
 
+// Accuracy (num/den) and evasion (den/num) stage ratios as multiply-shifts
+struct AccStageScales {
+    util::fastdiv::Ratio accuracy[13];
+    util::fastdiv::Ratio evasion[13];
+};
+
+consteval AccStageScales make_acc_stage_scales() {
+    AccStageScales scales{};
+    for (size_t i = 0; i < 13; ++i) {
+        scales.accuracy[i] =
+            util::fastdiv::make_ratio(ACC_STAGE_NUMERATORS[i], ACC_STAGE_DENOMINATORS[i]);
+        scales.evasion[i] =
+            util::fastdiv::make_ratio(ACC_STAGE_DENOMINATORS[i], ACC_STAGE_NUMERATORS[i]);
+    }
+    return scales;
+}
+
+// Accuracy never exceeds 255 * 3, well inside every fast range
+constexpr AccStageScales ACC_STAGE_SCALES = make_acc_stage_scales();
+
 /**
  * @brief Convert signed stage (-6 to +6) to array index (0 to 12).
  */
@@ -54,27 +76,24 @@ constexpr size_t acc_stage_to_index(int8_t stage) {
 }
 
 /**
- * @brief Calculate effective accuracy considering stat stages.
+ * @brief Apply the accuracy stage, then the evasion stage, to a base accuracy.
  *
- * @param base_accuracy Move's base accuracy (1-100, or 0 for never-miss)
+ * The reference computation; calc_effective_accuracy() reads the result
+ * from ACCURACY_TABLE for every base accuracy a move has.
+ *
+ * @param base_accuracy Move's base accuracy (1-255)
  * @param acc_stage Attacker's accuracy stage (-6 to +6)
  * @param eva_stage Defender's evasion stage (-6 to +6)
  *
  * @return Effective accuracy percentage (capped at 100)
  */
-constexpr uint8_t calc_effective_accuracy(uint8_t base_accuracy, int8_t acc_stage,
-                                          int8_t eva_stage) {
-    if (base_accuracy == 0) {
-        // Accuracy 0 means "never miss" (Swift, Aerial Ace, etc.)
-        return 100;
-    }
-
+constexpr uint8_t staged_accuracy(uint8_t base_accuracy, int8_t acc_stage, int8_t eva_stage) {
     uint32_t accuracy = base_accuracy;
 
     // Apply accuracy stage modifier (attacker's buff/debuff)
     if (acc_stage != 0) {
         size_t idx = acc_stage_to_index(acc_stage);
-        accuracy = accuracy * ACC_STAGE_NUMERATORS[idx] / ACC_STAGE_DENOMINATORS[idx];
+        accuracy = util::fastdiv::apply(ACC_STAGE_SCALES.accuracy[idx], accuracy);
     }
 
     // Apply evasion stage modifier (defender's buff/debuff)
@@ -82,30 +101,152 @@ constexpr uint8_t calc_effective_accuracy(uint8_t base_accuracy, int8_t acc_stag
     if (eva_stage != 0) {
         size_t idx = acc_stage_to_index(eva_stage);
         // Inverse: divide by numerator, multiply by denominator
-        accuracy = accuracy * ACC_STAGE_DENOMINATORS[idx] / ACC_STAGE_NUMERATORS[idx];
+        accuracy = util::fastdiv::apply(ACC_STAGE_SCALES.evasion[idx], accuracy);
     }
 
     // Cap at 100%
     return static_cast<uint8_t>(accuracy > 100 ? 100 : accuracy);
 }
 
+// ============================================================================
+//                         COMBINED ACCURACY TABLE
+// ============================================================================
+//
+// Only a handful of distinct base accuracies occur in g_MOVE_TABLE (100, 95,
+// 90, 85, ...). For each of them, every (accuracy stage, evasion stage) pair
+// is resolved at compile time to the final hit threshold, so an accuracy
+// check is a class lookup and one table load instead of two multiply-shifts
+// and a cap. The rounding is the two-step rounding of staged_accuracy():
+// the table is built by calling it.
+//
+// ============================================================================
+
+/// ACCURACY_CLASS entry of a base accuracy no move has
+inline constexpr uint8_t NO_ACCURACY_CLASS = 0xFF;
+
+namespace accuracy_detail {
+
+/// Distinct nonzero base accuracies in g_MOVE_TABLE, in first-seen order
+struct AccuracyClasses {
+    uint8_t accuracy[256]{};
+    uint8_t count{0};
+};
+
+consteval AccuracyClasses collect_accuracy_classes() {
+    AccuracyClasses classes{};
+    bool seen[256]{};
+    for (const types::Move& move : data::g_MOVE_TABLE) {
+        if (move.accuracy == 0 || seen[move.accuracy])
+            continue;
+        seen[move.accuracy] = true;
+        classes.accuracy[classes.count++] = move.accuracy;
+    }
+    return classes;
+}
+
+inline constexpr AccuracyClasses ACCURACY_CLASSES = collect_accuracy_classes();
+
+}  // namespace accuracy_detail
+
+/// Number of distinct nonzero base accuracies among the moves
+inline constexpr size_t ACCURACY_CLASS_COUNT = accuracy_detail::ACCURACY_CLASSES.count;
+
+static_assert(ACCURACY_CLASS_COUNT <= 16, "the accuracy table is sized for a few base accuracies");
+
+struct AccuracyTable {
+    // Base accuracy -> row of `threshold` (NO_ACCURACY_CLASS: not a move's)
+    uint8_t class_of[256];
+
+    // Effective accuracy, indexed by [class][acc stage + 6][eva stage + 6]
+    uint8_t threshold[ACCURACY_CLASS_COUNT][13][13];
+};
+
+consteval AccuracyTable make_accuracy_table() {
+    AccuracyTable table{};
+    for (uint8_t& entry : table.class_of) {
+        entry = NO_ACCURACY_CLASS;
+    }
+    for (size_t c = 0; c < ACCURACY_CLASS_COUNT; ++c) {
+        const uint8_t base = accuracy_detail::ACCURACY_CLASSES.accuracy[c];
+        table.class_of[base] = static_cast<uint8_t>(c);
+        for (int8_t acc = -6; acc <= 6; ++acc) {
+            for (int8_t eva = -6; eva <= 6; ++eva) {
+                table.threshold[c][acc + 6][eva + 6] = staged_accuracy(base, acc, eva);
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr AccuracyTable ACCURACY_TABLE = make_accuracy_table();
+
+/**
+ * @brief Calculate effective accuracy considering stat stages.
+ *
+ * @param base_accuracy Move's base accuracy (1-100, or 0 for never-miss)
+ * @param acc_stage Attacker's accuracy stage (-6 to +6)
+ * @param eva_stage Defender's evasion stage (-6 to +6)
+ *
+ * @return Effective accuracy percentage (capped at 100)
+ */
+constexpr uint8_t calc_effective_accuracy(uint8_t base_accuracy, int8_t acc_stage,
+                                          int8_t eva_stage) {
+    if (base_accuracy == 0) {
+        // Accuracy 0 means "never miss" (Swift, Aerial Ace, etc.)
+        return 100;
+    }
+
+    const uint8_t accuracy_class = ACCURACY_TABLE.class_of[base_accuracy];
+    if (accuracy_class == NO_ACCURACY_CLASS) [[unlikely]]
+        return staged_accuracy(base_accuracy, acc_stage, eva_stage);
+    return ACCURACY_TABLE
+        .threshold[accuracy_class][acc_stage_to_index(acc_stage)][acc_stage_to_index(eva_stage)];
+}
+
+/**
+ * @brief Exact probability that check_accuracy() hits, without drawing.
+ *
+ * The same fixed-point value util::random::DrawTape records for the
+ * accuracy draw, so KO and outcome calculations can weight a hit by it.
+ *
+ * @param base_accuracy Move's base accuracy (0 = never miss)
+ * @param acc_stage Attacker's accuracy stage (-6 to +6)
+ * @param eva_stage Defender's evasion stage (-6 to +6)
+ */
+constexpr util::random::Probability hit_probability(uint8_t base_accuracy, int8_t acc_stage = 0,
+                                                    int8_t eva_stage = 0) {
+    const uint8_t effective = calc_effective_accuracy(base_accuracy, acc_stage, eva_stage);
+    return effective >= 100 ? util::random::PROBABILITY_ONE
+                            : util::random::ratio(effective, 100);
+}
+
+// Spot checks against hand-computed Gen III values
+static_assert(calc_effective_accuracy(100, 0, 0) == 100);
+static_assert(calc_effective_accuracy(100, 0, 1) == 75);   // 100 x 3/4
+static_assert(calc_effective_accuracy(70, -6, 0) == 23);   // 70 x 3/9
+static_assert(calc_effective_accuracy(70, -1, 1) == 39);   // 70 x 3/4 = 52, x 3/4
+static_assert(calc_effective_accuracy(50, 6, 0) == 100);   // capped
+static_assert(calc_effective_accuracy(99, 0, 1) == staged_accuracy(99, 0, 1));
+static_assert(hit_probability(0, 0, 6) == util::random::PROBABILITY_ONE);
+static_assert(hit_probability(100, 0, -1) == util::random::PROBABILITY_ONE);
+
 /**
  * @brief Roll for move accuracy.
  *
+ * @param rng Battle RNG
  * @param effective_accuracy Calculated effective accuracy (1-100)
  *
  * @return true if the move hits, false if it misses
  */
-inline bool roll_accuracy(uint8_t effective_accuracy) {
+inline bool roll_accuracy(util::random::Rng& rng, uint8_t effective_accuracy) {
     if (effective_accuracy >= 100) {
         // Still consume the RNG call for parity with Showdown
-        util::random::Random(100);
+        rng.discard(util::random::DrawSite::ACCURACY);
         return true;
     }
 
     // Hit if random(100) < effective_accuracy
-    uint16_t roll = util::random::Random(100);
-    return roll < effective_accuracy;
+    return rng.chance(effective_accuracy, 100, util::random::DrawSite::ACCURACY);
 }
 
 /**
@@ -113,13 +254,15 @@ inline bool roll_accuracy(uint8_t effective_accuracy) {
  *
  * Combines accuracy calculation and roll into a single function.
  *
+ * @param rng Battle RNG
  * @param base_accuracy Move's base accuracy (0 = never miss, 1-100 = percentage)
  * @param acc_stage Attacker's accuracy stage (-6 to +6)
  * @param eva_stage Defender's evasion stage (-6 to +6)
  *
  * @return true if the move hits
  */
-inline bool check_accuracy(uint8_t base_accuracy, int8_t acc_stage = 0, int8_t eva_stage = 0) {
+inline bool check_accuracy(util::random::Rng& rng, uint8_t base_accuracy, int8_t acc_stage = 0,
+                           int8_t eva_stage = 0) {
     // Never-miss moves (accuracy == 0) always hit but still consume RNG
     if (base_accuracy == 0) {
         // Don't consume RNG for never-miss moves (Showdown doesn't either)
@@ -127,7 +270,7 @@ inline bool check_accuracy(uint8_t base_accuracy, int8_t acc_stage = 0, int8_t e
     }
 
     uint8_t effective = calc_effective_accuracy(base_accuracy, acc_stage, eva_stage);
-    return roll_accuracy(effective);
+    return roll_accuracy(rng, effective);
 }
 
 }  // namespace logic::calc
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file battler_traits.hpp
+ * @brief Immunities a battler's types give it, as one bitmask.
+ */
+
+#include <cstdint>
+
+#include "../../types/enums/type.hpp"
+#include "type_effectiveness.hpp"
+
+namespace logic::calc {
+
+// ============================================================================
+//                             TYPE TRAITS
+// ============================================================================
+//
+// Status application and the residual weather step ask "is this battler
+// immune?" on every call. Answering from type1/type2 means comparing both
+// types against each immune type; the answers only change with the types,
+// so ActiveMon::set_types() folds them into ActiveMon::traits once and the
+// checks become single-bit tests.
+//
+// The table is per type rather than per species: types change mid-battle
+// (set_types() is also the Transform / Conversion entry point), and 18
+// entries are what the CE keeps resident instead of one per species.
+//
+// ============================================================================
+
+using TraitMask = uint8_t;
+
+namespace traits {
+
+inline constexpr TraitMask IMMUNE_BURN = 1 << 0;       // Fire
+inline constexpr TraitMask IMMUNE_FREEZE = 1 << 1;     // Ice
+inline constexpr TraitMask IMMUNE_POISON = 1 << 2;     // Poison, Steel (poison and toxic)
+inline constexpr TraitMask IMMUNE_SANDSTORM = 1 << 3;  // Rock, Ground, Steel
+inline constexpr TraitMask IMMUNE_HAIL = 1 << 4;       // Ice
+
+}  // namespace traits
+
+/// Traits one type gives
+constexpr TraitMask single_type_traits(types::enums::Type type) {
+    using types::enums::Type;
+    switch (type) {
+        case Type::FIRE:
+            return traits::IMMUNE_BURN;
+        case Type::ICE:
+            return traits::IMMUNE_FREEZE | traits::IMMUNE_HAIL;
+        case Type::POISON:
+            return traits::IMMUNE_POISON;
+        case Type::STEEL:
+            return traits::IMMUNE_POISON | traits::IMMUNE_SANDSTORM;
+        case Type::ROCK:
+        case Type::GROUND:
+            return traits::IMMUNE_SANDSTORM;
+        default:
+            return 0;
+    }
+}
+
+namespace battler_traits_detail {
+
+struct TypeTraitTable {
+    TraitMask traits[TYPE_COUNT];
+};
+
+constexpr TypeTraitTable make_type_traits() {
+    TypeTraitTable table{};
+    for (uint8_t type = 0; type < TYPE_COUNT; ++type)
+        table.traits[type] = single_type_traits(static_cast<types::enums::Type>(type));
+    return table;
+}
+
+inline constexpr TypeTraitTable TYPE_TRAITS = make_type_traits();
+
+}  // namespace battler_traits_detail
+
+/// Traits of a battler of `type1` / `type2` (Type::NONE gives none)
+constexpr TraitMask type_traits(types::enums::Type type1, types::enums::Type type2) {
+    const auto& table = battler_traits_detail::TYPE_TRAITS.traits;
+    return table[static_cast<uint8_t>(type1)] | table[static_cast<uint8_t>(type2)];
+}
+
+static_assert(type_traits(types::enums::Type::STEEL, types::enums::Type::NONE) ==
+              (traits::IMMUNE_POISON | traits::IMMUNE_SANDSTORM));
+static_assert(type_traits(types::enums::Type::WATER, types::enums::Type::ICE) ==
+              (traits::IMMUNE_FREEZE | traits::IMMUNE_HAIL));
+static_assert(type_traits(types::enums::Type::NORMAL, types::enums::Type::FLYING) == 0);
+
+}  // namespace logic::calc
@@ -70,15 +70,16 @@ constexpr CritStage calc_crit_stage(bool focus_energy, bool high_crit_move, bool
  *
  * @pre crit_stage must be in range [0, 4]
  *
+ * @param rng Battle RNG
  * @param crit_stage The calculated critical hit stage
  *
  * @return true if the hit is critical
  */
-inline bool roll_critical(CritStage crit_stage) {
+inline bool roll_critical(util::random::Rng& rng, CritStage crit_stage) {
     assert(crit_stage <= MAX_CRIT_STAGE && "crit_stage out of range");
 
     uint16_t threshold = CRIT_CHANCE[crit_stage];
-    return util::random::Random(threshold) == 0;
+    return rng.chance(1, threshold, util::random::DrawSite::CRITICAL);
 }
 
 }  // namespace logic::calc
@@ -5,6 +5,7 @@
 #include "type_effectiveness.hpp"
 #include "types/calc.hpp"
 #include "types/enums/type.hpp"
+#include "util/fastdiv.hpp"
 #include "util/random.hpp"
 
 namespace logic::calc {
@@ -42,6 +43,45 @@ struct DamageResult {
     bool critical{false};
 };
 
+// Number of distinct damage rolls (random factor 85..100%)
+inline constexpr uint8_t DAMAGE_ROLL_COUNT = 16;
+inline constexpr uint8_t MIN_DAMAGE_ROLL = 85;
+
+// factor/100 for each roll as a multiply-shift (index = factor - MIN_DAMAGE_ROLL)
+struct DamageRollScales {
+    util::fastdiv::Ratio factor[DAMAGE_ROLL_COUNT];
+};
+
+consteval DamageRollScales make_damage_roll_scales() {
+    DamageRollScales scales{};
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        scales.factor[i] = util::fastdiv::make_ratio(MIN_DAMAGE_ROLL + i, 100);
+    }
+    return scales;
+}
+
+inline constexpr DamageRollScales DAMAGE_ROLL_SCALES = make_damage_roll_scales();
+
+// Every possible damage outcome of one hit (no RNG involved)
+struct DamageDistribution {
+    // rolls[i] is the damage at random factor (85 + i)%, each with chance 1/16
+    Damage normal[DAMAGE_ROLL_COUNT]{};
+    Damage critical[DAMAGE_ROLL_COUNT]{};
+
+    Damage min{0};  // Lowest non-crit roll (or crit roll if crits are guaranteed)
+    Damage max{0};  // Highest reachable roll (crit branch if crits are possible)
+    Effectiveness effectiveness{effectiveness::DUAL_NEUTRAL};
+
+    // Crit chance is 1 / crit_denominator: 1 = always crits, 0 = never crits
+    uint16_t crit_denominator{0};
+
+    constexpr bool can_crit() const { return crit_denominator != 0; }
+    constexpr bool always_crits() const { return crit_denominator == 1; }
+};
+
+// DamageParams::effectiveness sentinel (real values are 0-400)
+inline constexpr Effectiveness EFFECTIVENESS_FROM_TYPES = 0xFFFF;
+
 // Input parameters for damage calculation
 struct DamageParams {
     // Attacker info
@@ -65,12 +105,56 @@ struct DamageParams {
     CritStage crit_stage{0};
     bool is_critical{false};  // Pre-rolled, or set to force crit
     bool skip_random{false};  // For deterministic testing
+
+    // Pre-looked-up type effectiveness (ActiveMon::effectiveness_against);
+    // EFFECTIVENESS_FROM_TYPES = derive it from the defender types above
+    Effectiveness effectiveness{EFFECTIVENESS_FROM_TYPES};
+
+    // Pre-applied stages (calc::cached_staged_stat): apply_stat_stage() of
+    // attack / defense at their stages; 0 = apply the stage here
+    StatValue staged_attack{0};
+    StatValue staged_defense{0};
 };
 
+/**
+ * @brief Type effectiveness of a hit: the cached value when the caller
+ * provided one, otherwise a chart lookup on the defender's types.
+ */
+constexpr Effectiveness resolve_effectiveness(const DamageParams& params) {
+    if (params.effectiveness != EFFECTIVENESS_FROM_TYPES) {
+        return params.effectiveness;
+    }
+    return get_type_effectiveness(params.move_type, params.defender_type1, params.defender_type2);
+}
+
 // ============================================================================
 //                         DAMAGE PIPELINE HELPERS
 // ============================================================================
 
+/**
+ * @brief Gen III physical/special split is based on type, not move.
+ *
+ * Physical: Normal, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel
+ * Special: Fire, Water, Grass, Electric, Psychic, Ice, Dragon, Dark
+ */
+constexpr bool is_physical_type(types::enums::Type type) {
+    using enum types::enums::Type;
+    switch (type) {
+        case NORMAL:
+        case FIGHTING:
+        case FLYING:
+        case POISON:
+        case GROUND:
+        case ROCK:
+        case BUG:
+        case GHOST:
+        case STEEL:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /**
  * @brief Check if attacker gets STAB (Same Type Attack Bonus).
  */
@@ -82,12 +166,12 @@ constexpr bool has_stab(types::enums::Type move_type, types::enums::Type attacke
 /**
  * @brief Resolve whether this hit is critical.
  */
-inline bool resolve_critical_hit(const DamageParams& params) {
+inline bool resolve_critical_hit(util::random::Rng& rng, const DamageParams& params) {
     if (params.is_critical) {
         return true;
     }
     if (params.crit_stage <= MAX_CRIT_STAGE) {
-        return roll_critical(params.crit_stage);
+        return roll_critical(rng, params.crit_stage);
     }
     return false;
 }
@@ -107,21 +191,25 @@ struct EffectiveStats {
  */
 constexpr EffectiveStats apply_crit_aware_stat_stages(const DamageParams& params,
                                                       bool is_critical) {
+    // The pre-applied stage when the caller provided one
+    const auto staged = [](StatValue pre_applied, StatValue stat, StatStage stage) {
+        return pre_applied != 0 ? pre_applied : apply_stat_stage(stat, stage);
+    };
     StatValue effective_attack = params.attack;
     StatValue effective_defense = params.defense;
 
     if (is_critical) {
         // Crit: only apply attack stage if positive
         if (params.attack_stage > DEFAULT_STAT_STAGE) {
-            effective_attack = apply_stat_stage(params.attack, params.attack_stage);
+            effective_attack = staged(params.staged_attack, params.attack, params.attack_stage);
         }
         // Crit: only apply defense stage if negative
         if (params.defense_stage < DEFAULT_STAT_STAGE) {
-            effective_defense = apply_stat_stage(params.defense, params.defense_stage);
+            effective_defense = staged(params.staged_defense, params.defense, params.defense_stage);
         }
     } else {
-        effective_attack = apply_stat_stage(params.attack, params.attack_stage);
-        effective_defense = apply_stat_stage(params.defense, params.defense_stage);
+        effective_attack = staged(params.staged_attack, params.attack, params.attack_stage);
+        effective_defense = staged(params.staged_defense, params.defense, params.defense_stage);
     }
 
     // Prevent division by zero
@@ -136,12 +224,13 @@ constexpr EffectiveStats apply_crit_aware_stat_stages(const DamageParams& params
  *
  * Formula: ((2 * Level / 5 + 2) * Power * Attack / Defense) / 50 + 2
  */
+template <bool DivisionFree = util::fastdiv::ENABLED>
 constexpr DamageCalc calc_base_damage(Level level, MovePower power, StatValue attack,
                                       StatValue defense) {
-    DamageCalc damage = 2u * level / 5u + 2u;
+    DamageCalc damage = util::fastdiv::scale<2, 5, DivisionFree>(level) + 2u;
     damage = damage * power * attack;
-    damage = damage / defense;
-    damage = damage / 50u + 2u;
+    damage = damage / defense;  // Runtime divisor: stays a real division
+    damage = util::fastdiv::scale<1, 50, DivisionFree>(damage) + 2u;
     return damage;
 }
 
@@ -152,15 +241,32 @@ constexpr DamageCalc apply_critical_multiplier(DamageCalc damage, bool is_critic
     return is_critical ? damage * CRIT_MULTIPLIER : damage;
 }
 
+/**
+ * @brief Apply one specific damage roll (random factor 85-100%).
+ */
+template <bool DivisionFree = util::fastdiv::ENABLED>
+constexpr DamageCalc apply_damage_roll(DamageCalc damage, uint16_t random_factor) {
+    if (random_factor >= MIN_DAMAGE_ROLL && random_factor <= 100u) {
+        return util::fastdiv::apply<DivisionFree>(
+            DAMAGE_ROLL_SCALES.factor[random_factor - MIN_DAMAGE_ROLL], damage);
+    }
+    return damage * random_factor / 100u;
+}
+
 /**
  * @brief Roll and apply random variance (85-100%).
  */
-inline DamageCalc apply_random_variance(DamageCalc damage, bool skip_random) {
+inline DamageCalc apply_random_variance(util::random::Rng& rng, DamageCalc damage,
+                                        bool skip_random) {
     if (skip_random) {
         return damage;
     }
-    uint16_t random_factor = 100u - util::random::Random(16);  // 85-100
-    return damage * random_factor / 100u;
+    // Rolls that deal the same damage are one outcome when enumerating
+    const uint16_t roll = rng.random_grouped(
+        DAMAGE_ROLL_COUNT,
+        [damage](uint16_t r) { return apply_damage_roll(damage, static_cast<uint16_t>(100u - r)); },
+        util::random::DrawSite::DAMAGE_ROLL);
+    return apply_damage_roll(damage, static_cast<uint16_t>(100u - roll));  // 85-100
 }
 
 /**
@@ -178,7 +284,28 @@ constexpr DamageCalc apply_stab(DamageCalc damage, types::enums::Type move_type,
 /**
  * @brief Apply type effectiveness multiplier.
  */
+template <bool DivisionFree = util::fastdiv::ENABLED>
 constexpr DamageCalc apply_type_effectiveness(DamageCalc damage, Effectiveness eff) {
+    // Every dual-type product is a power of two times 25, so /100 is a shift
+    // (the bound keeps the original product from wrapping)
+    if (DivisionFree && damage <= UINT32_MAX / (effectiveness::DUAL_NEUTRAL * 4)) {
+        switch (eff) {
+            case 0:
+                return 0;
+            case effectiveness::DUAL_NEUTRAL / 4:
+                return damage >> 2;
+            case effectiveness::DUAL_NEUTRAL / 2:
+                return damage >> 1;
+            case effectiveness::DUAL_NEUTRAL:
+                return damage;
+            case effectiveness::DUAL_NEUTRAL * 2:
+                return damage << 1;
+            case effectiveness::DUAL_NEUTRAL * 4:
+                return damage << 2;
+            default:
+                break;
+        }
+    }
     return damage * eff / effectiveness::DUAL_NEUTRAL;
 }
 
@@ -199,6 +326,22 @@ constexpr Damage clamp_damage(DamageCalc damage) {
     return static_cast<Damage>(damage > 0xFFFF ? 0xFFFF : damage);
 }
 
+/**
+ * @brief Damage for a resolved crit outcome, before the random roll.
+ *
+ * Steps 2-6 of the pipeline below: stat stages, base damage, crit
+ * multiplier, STAB and type effectiveness.
+ */
+constexpr DamageCalc calc_unrolled_damage(const DamageParams& params, bool is_critical,
+                                          Effectiveness eff) {
+    auto [atk, def] = apply_crit_aware_stat_stages(params, is_critical);
+
+    DamageCalc damage = calc_base_damage(params.level, params.power, atk, def);
+    damage = apply_critical_multiplier(damage, is_critical);
+    damage = apply_stab(damage, params.move_type, params.attacker_type1, params.attacker_type2);
+    return apply_type_effectiveness(damage, eff);
+}
+
 /**
  * @brief Calculate damage using Gen III formula.
  *
@@ -215,30 +358,71 @@ constexpr Damage clamp_damage(DamageCalc damage) {
  * Reference: pokeemerald/data/battle_scripts_1.s order:
  *   critcalc -> damagecalc -> typecalc (STAB + type eff) -> adjustnormaldamage (random)
  *
+ * @param rng Battle RNG (crit roll and random variance)
  * @param params All parameters needed for damage calculation
  *
  * @return DamageResult containing final damage, effectiveness, and crit status
  */
-inline DamageResult calculate_damage(const DamageParams& params) {
+inline DamageResult calculate_damage(util::random::Rng& rng, const DamageParams& params) {
     DamageResult result{};
 
-    result.critical = resolve_critical_hit(params);
+    result.critical = resolve_critical_hit(rng, params);
+    result.effectiveness = resolve_effectiveness(params);
 
-    auto [atk, def] = apply_crit_aware_stat_stages(params, result.critical);
-
-    DamageCalc damage = calc_base_damage(params.level, params.power, atk, def);
-    damage = apply_critical_multiplier(damage, result.critical);
-    damage = apply_stab(damage, params.move_type, params.attacker_type1, params.attacker_type2);
-
-    result.effectiveness =
-        get_type_effectiveness(params.move_type, params.defender_type1, params.defender_type2);
-
-    damage = apply_type_effectiveness(damage, result.effectiveness);
-    damage = apply_random_variance(damage, params.skip_random);
+    DamageCalc damage = calc_unrolled_damage(params, result.critical, result.effectiveness);
+    damage = apply_random_variance(rng, damage, params.skip_random);
     damage = enforce_minimum_damage(damage, result.effectiveness);
 
     result.damage = clamp_damage(damage);
     return result;
 }
 
+// ============================================================================
+//                        DAMAGE ROLL DISTRIBUTION
+// ============================================================================
+
+/**
+ * @brief Every damage outcome of a hit, without touching the RNG.
+ *
+ * Evaluates each crit branch once (calc_unrolled_damage), then applies all
+ * 16 random factors to it. normal[] and critical[] are bit-identical to what
+ * calculate_damage() returns for the matching crit/roll draw.
+ *
+ * Crit probability follows resolve_critical_hit(): forced crits always crit,
+ * stages 0-4 crit with 1 / CRIT_CHANCE[stage], out-of-range stages never do.
+ *
+ * @param params All parameters needed for damage calculation
+ *
+ * @return Both 16-roll branches, their bounds and the crit chance
+ */
+constexpr DamageDistribution calculate_damage_distribution(const DamageParams& params) {
+    DamageDistribution dist{};
+
+    dist.effectiveness = resolve_effectiveness(params);
+
+    if (params.is_critical) {
+        dist.crit_denominator = 1;
+    } else if (params.crit_stage <= MAX_CRIT_STAGE) {
+        dist.crit_denominator = CRIT_CHANCE[params.crit_stage];
+    }
+
+    const DamageCalc normal = calc_unrolled_damage(params, false, dist.effectiveness);
+    const DamageCalc critical = calc_unrolled_damage(params, true, dist.effectiveness);
+
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        const uint16_t factor = MIN_DAMAGE_ROLL + i;
+        const DamageCalc normal_roll = params.skip_random ? normal : apply_damage_roll(normal, factor);
+        const DamageCalc crit_roll =
+            params.skip_random ? critical : apply_damage_roll(critical, factor);
+
+        dist.normal[i] = clamp_damage(enforce_minimum_damage(normal_roll, dist.effectiveness));
+        dist.critical[i] = clamp_damage(enforce_minimum_damage(crit_roll, dist.effectiveness));
+    }
+
+    constexpr uint8_t LAST = DAMAGE_ROLL_COUNT - 1;
+    dist.min = dist.always_crits() ? dist.critical[0] : dist.normal[0];
+    dist.max = dist.can_crit() ? dist.critical[LAST] : dist.normal[LAST];
+    return dist;
+}
+
 }  // namespace logic::calc
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstdint>
+
+#include "damage.hpp"
+#include "dsl/item/handler.hpp"
+#include "logic/state/context.hpp"
+#include "types/enums/item.hpp"
+#include "types/models/move.hpp"
+#include "util/platform.hpp"
+
+namespace logic::calc {
+
+// ============================================================================
+//                        N-HIT KO PROBABILITY
+// ============================================================================
+//
+// Exact probability that a move KOs within 1..N hits, from the 16-roll and
+// crit distributions of calculate_damage_distribution().
+//
+// Model (one hit per turn):
+//   1. Hit: every (crit, roll) outcome with its probability, times the
+//      hit chance (a miss leaves the HP as it was)
+//      - Non-crit roll: (1 - 1/crit_denominator) / 16
+//      - Crit roll:     (1/crit_denominator) / 16
+//   2. Fatal hit + Focus Band: survive at 1 HP with ENDURE_PERCENT/100
+//   3. Turn end + Leftovers: survivors heal 1/16 max HP (capped at max HP)
+//
+// The defender's HP is tracked as a dense probability mass over 1..max_hp,
+// so the cost is O(hits x max_hp x distinct damage values) with no RNG and
+// no turn re-simulation.
+//
+// ============================================================================
+
+/// Most hits a single query evaluates
+inline constexpr uint8_t MAX_NHKO_HITS = 8;
+
+/// Highest HP any rental can have (Blissey, level 100)
+inline constexpr uint16_t NHKO_MAX_HP = 714;
+
+/// Defender-side modifiers between hits
+struct KoModifiers {
+    uint16_t max_hp{0};      // Defender's max HP for Leftovers (0 = the starting hp)
+    bool leftovers{false};   // ItemHandler<LEFTOVERS, OnTurnEnd>
+    bool focus_band{false};  // ItemHandler<FOCUS_BAND, OnPreDamageApply>
+    uint8_t hits{4};         // Number of hits to evaluate (1..MAX_NHKO_HITS)
+    uint8_t accuracy{100};   // Hit chance in percent (calc_effective_accuracy())
+
+    /// Modifiers implied by the defender's held item
+    static constexpr KoModifiers for_item(types::enums::Item item, uint16_t max_hp,
+                                          uint8_t hits = 4) {
+        KoModifiers mods{};
+        mods.max_hp = max_hp;
+        mods.leftovers = (item == types::enums::Item::LEFTOVERS);
+        mods.focus_band = (item == types::enums::Item::FOCUS_BAND);
+        mods.hits = hits;
+        return mods;
+    }
+};
+
+struct NhkoResult {
+    // ko_chance[i] = probability the defender has fainted within (i + 1) hits
+    double ko_chance[MAX_NHKO_HITS]{};
+    uint8_t hits{0};
+
+    /// Fewest hits that KO with certainty (0 = not within `hits`)
+    constexpr uint8_t guaranteed_hits() const {
+        for (uint8_t i = 0; i < hits; ++i) {
+            if (ko_chance[i] >= 1.0 - 1e-9)
+                return static_cast<uint8_t>(i + 1);
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief N-hit KO probabilities for a known damage distribution.
+ *
+ * @param dist Distribution from calculate_damage_distribution()
+ * @param hp Defender's current HP (1..NHKO_MAX_HP)
+ * @param mods Leftovers / Focus Band / max HP / number of hits
+ *
+ * @return Cumulative KO probability after each hit
+ */
+inline NhkoResult calc_nhko(const DamageDistribution& dist, uint16_t hp, const KoModifiers& mods) {
+    using FocusBand = dsl::item::ItemHandler<types::enums::Item::FOCUS_BAND,
+                                             dsl::item::OnPreDamageApply>;
+    using Leftovers = dsl::item::ItemHandler<types::enums::Item::LEFTOVERS, dsl::item::OnTurnEnd>;
+
+    NhkoResult result{};
+    result.hits = mods.hits > MAX_NHKO_HITS ? MAX_NHKO_HITS : mods.hits;
+
+    const uint16_t max_hp = mods.max_hp > hp ? mods.max_hp : hp;
+    if (hp == 0 || max_hp > NHKO_MAX_HP) {
+        return result;
+    }
+
+    const double hit_chance = mods.accuracy >= 100 ? 1.0 : mods.accuracy / 100.0;
+
+    // Collapse the 32 (crit, roll) outcomes into distinct damage values
+    const double crit = dist.can_crit() ? 1.0 / dist.crit_denominator : 0.0;
+    uint16_t damage[2 * DAMAGE_ROLL_COUNT];
+    double chance[2 * DAMAGE_ROLL_COUNT];
+    uint8_t outcomes = 0;
+
+    auto add_outcome = [&](uint16_t value, double p) {
+        if (p <= 0.0)
+            return;
+        for (uint8_t i = 0; i < outcomes; ++i) {
+            if (damage[i] == value) {
+                chance[i] += p;
+                return;
+            }
+        }
+        damage[outcomes] = value;
+        chance[outcomes] = p;
+        ++outcomes;
+    };
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        add_outcome(dist.normal[i], hit_chance * (1.0 - crit) / DAMAGE_ROLL_COUNT);
+        add_outcome(dist.critical[i], hit_chance * crit / DAMAGE_ROLL_COUNT);
+    }
+
+    const double endure = mods.focus_band ? FocusBand::ENDURE_PERCENT / 100.0 : 0.0;
+    const uint16_t heal = mods.leftovers ? Leftovers::heal_amount(max_hp) : 0;
+
+    // Probability mass over remaining HP (index = HP); scratch is per thread
+    static BATTLEMON_THREAD_LOCAL double mass[NHKO_MAX_HP + 1];
+    static BATTLEMON_THREAD_LOCAL double next[NHKO_MAX_HP + 1];
+    for (uint16_t h = 0; h <= max_hp; ++h) {
+        mass[h] = 0.0;
+    }
+    mass[hp] = 1.0;
+
+    double fainted = 0.0;
+    for (uint8_t hit = 0; hit < result.hits; ++hit) {
+        for (uint16_t h = 0; h <= max_hp; ++h) {
+            next[h] = 0.0;
+        }
+
+        // 1-2. Apply the hit (Focus Band leaves the holder at 1 HP)
+        for (uint16_t h = 1; h <= max_hp; ++h) {
+            const double p = mass[h];
+            if (p == 0.0)
+                continue;
+
+            next[h] += p * (1.0 - hit_chance);
+
+            for (uint8_t i = 0; i < outcomes; ++i) {
+                const double q = p * chance[i];
+                if (damage[i] >= h) {
+                    fainted += q * (1.0 - endure);
+                    next[1] += q * endure;
+                } else {
+                    next[h - damage[i]] += q;
+                }
+            }
+        }
+
+        // 3. End of turn: Leftovers
+        for (uint16_t h = 0; h <= max_hp; ++h) {
+            mass[h] = 0.0;
+        }
+        for (uint16_t h = 1; h <= max_hp; ++h) {
+            if (next[h] == 0.0)
+                continue;
+            const uint16_t healed = (h + heal > max_hp) ? max_hp : static_cast<uint16_t>(h + heal);
+            mass[healed] += next[h];
+        }
+
+        result.ko_chance[hit] = fainted;
+    }
+
+    return result;
+}
+
+/**
+ * @brief N-hit KO probabilities for fully specified damage inputs.
+ *
+ * Use this form when stat stages, crit stage or item-modified stats matter.
+ */
+inline NhkoResult calc_nhko(const DamageParams& params, uint16_t hp, const KoModifiers& mods) {
+    return calc_nhko(calculate_damage_distribution(params), hp, mods);
+}
+
+/**
+ * @brief N-hit KO probabilities of `move` from attacker against defender.
+ *
+ * Neutral stat stages and base crit rate; the physical/special split follows
+ * the move's type as in CalculateDamage.
+ *
+ * @param attacker Attacker's computed stats and types
+ * @param defender Defender's computed stats and types
+ * @param move Move being used
+ * @param hp Defender's current HP
+ * @param mods Defender's Leftovers / Focus Band / max HP, number of hits
+ *
+ * @return Cumulative KO probability after each hit
+ */
+inline NhkoResult calc_nhko(const dsl::ActiveMon& attacker, const dsl::ActiveMon& defender,
+                            const types::MoveHot& move, uint16_t hp, const KoModifiers& mods = {}) {
+    const bool is_physical = is_physical_type(move.type);
+
+    DamageParams params{};
+    params.level = attacker.level;
+    params.attack = is_physical ? attacker.attack : attacker.sp_attack;
+    params.attacker_type1 = attacker.type1;
+    params.attacker_type2 = attacker.type2;
+    params.defense = is_physical ? defender.defense : defender.sp_defense;
+    params.defender_type1 = defender.type1;
+    params.defender_type2 = defender.type2;
+    params.effectiveness = defender.effectiveness_against(move.type);
+    params.power = move.power;
+    params.move_type = move.type;
+
+    return calc_nhko(params, hp, mods);
+}
+
+}  // namespace logic::calc
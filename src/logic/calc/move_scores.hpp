@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstdint>
+
+#include "damage.hpp"
+#include "logic/state/context.hpp"
+#include "logic/state/slot.hpp"
+#include "types/models/move.hpp"
+
+namespace logic::calc {
+
+// ============================================================================
+//                           MOVE SCORE GRID
+// ============================================================================
+//
+// Expected damage of each of an attacker's 4 moves against each of up to 6
+// candidate targets (the active defender and the bench), in one pass instead
+// of one calculate_damage_distribution() per (move, target) pair.
+//
+// Work is shared along both axes. Stat stages are applied once per move
+// (its attack stat, plain and crit-aware) and once per target (its Def and
+// SpDef, plain and crit-aware). Effectiveness is the target's cached
+// DefenseRow. A cell is then the base damage formula twice (plain and
+// crit) and two table-driven roll sums: one division by the target's
+// defense each, no per-roll work and no RNG.
+//
+// The 16 damage rolls are never applied one by one. For unrolled damage
+// x = 100q + r, roll f deals floor(x * f / 100) = q * f + floor(r * f / 100),
+// so the sum over f = 85..100 is 1480 q + ROLL_SUMS[r]: one table load
+// replaces 16 multiply-shifts. The crit branch is weighted in with the
+// crit chance of the crit stage, again from a table.
+//
+// A score is the mean damage of a hit, rounded down: bit-exact with the
+// mean of calculate_damage_distribution() on the params CalculateDamage
+// builds before held items modify them. Unrolled damage above 0xFFFF (far
+// past any HP) is scored as 0xFFFF unrolled. Moves without base power
+// score 0; effects that bypass the formula (fixed damage, OHKO, multi-hit)
+// are scored as one formula hit of their base power.
+//
+// ============================================================================
+
+inline constexpr uint8_t SCORE_MOVES = 4;
+inline constexpr uint8_t MAX_SCORE_TARGETS = 6;
+
+/// Sum of the damage roll factors 85..100
+inline constexpr uint32_t ROLL_FACTOR_SUM = [] {
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        sum += MIN_DAMAGE_ROLL + i;
+    }
+    return sum;
+}();
+
+/// ROLL_SUMS.of[r]: sum of floor(r * f / 100) over the roll factors f
+struct RollSums {
+    uint16_t of[100];
+};
+
+consteval RollSums make_roll_sums() {
+    RollSums sums{};
+    for (uint8_t r = 0; r < 100; ++r) {
+        uint16_t sum = 0;
+        for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+            sum = static_cast<uint16_t>(sum + r * (MIN_DAMAGE_ROLL + i) / 100);
+        }
+        sums.of[r] = sum;
+    }
+    return sums;
+}
+
+inline constexpr RollSums ROLL_SUMS = make_roll_sums();
+
+/// Weights of the plain and crit roll sums for one crit rule, and 1 / their total
+struct CritWeights {
+    uint8_t normal;
+    uint8_t critical;
+    util::fastdiv::Ratio mean;  // 1 / (16 * (normal + critical))
+};
+
+/// CritWeights by crit stage; the last entry is a stage past MAX_CRIT_STAGE (never crits)
+struct CritWeightTable {
+    CritWeights stage[MAX_CRIT_STAGE + 2];
+};
+
+consteval CritWeights make_crit_weight(uint8_t normal, uint8_t critical) {
+    return {normal, critical, util::fastdiv::make_ratio(1, DAMAGE_ROLL_COUNT * (normal + critical))};
+}
+
+consteval CritWeightTable make_crit_weights() {
+    CritWeightTable table{};
+    for (uint8_t stage = 0; stage <= MAX_CRIT_STAGE; ++stage) {
+        table.stage[stage] = make_crit_weight(static_cast<uint8_t>(CRIT_CHANCE[stage] - 1), 1);
+    }
+    table.stage[MAX_CRIT_STAGE + 1] = make_crit_weight(1, 0);
+    return table;
+}
+
+inline constexpr CritWeightTable CRIT_WEIGHTS = make_crit_weights();
+
+/**
+ * @brief Sum of the 16 final rolls of a hit (minimum 1, clamp) from its unrolled damage.
+ *
+ * @param unrolled calc_unrolled_damage() of the hit
+ * @param eff The hit's type effectiveness
+ */
+constexpr uint32_t roll_sum(DamageCalc unrolled, Effectiveness eff) {
+    const uint32_t x = unrolled > 0xFFFF ? 0xFFFF : unrolled;
+    const uint32_t q = util::fastdiv::scale<1, 100>(x);
+    const uint32_t sum = ROLL_FACTOR_SUM * q + ROLL_SUMS.of[x - q * 100];
+    // Below 2 some rolls are 0 and rise to the minimum 1 (immune hits stay 0)
+    if (x < 2)
+        return is_immune(eff) ? 0 : DAMAGE_ROLL_COUNT;
+    return sum;
+}
+
+/// One candidate target: its stats and types, and its stages when it is active
+struct ScoreTarget {
+    const dsl::ActiveMon* mon{nullptr};
+    const state::SlotState* slot{nullptr};  // nullptr = on the bench (neutral stages)
+};
+
+struct MoveScoreGrid {
+    // expected[move][target]: mean damage of one hit, 0 for an empty slot
+    Damage expected[SCORE_MOVES][MAX_SCORE_TARGETS]{};
+    uint8_t target_count{0};
+
+    /// Best-scoring move slot against `target` (0 when nothing scores)
+    [[nodiscard]] constexpr uint8_t best_move(uint8_t target) const {
+        uint8_t best = 0;
+        for (uint8_t m = 1; m < SCORE_MOVES; ++m) {
+            if (expected[m][target] > expected[best][target])
+                best = m;
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief Expected damage of each of the attacker's moves against each target.
+ *
+ * @param attacker Attacker's computed stats and types
+ * @param attacker_slot Attacker's stat stages
+ * @param moves The attacker's move slots (nullptr = empty slot)
+ * @param targets Candidate targets, the active defender first
+ * @param target_count Number of targets (at most MAX_SCORE_TARGETS)
+ * @param crit_stage Crit stage of the hits (CalculateDamage's base stage is 0)
+ */
+constexpr MoveScoreGrid score_moves(const dsl::ActiveMon& attacker,
+                                    const state::SlotState& attacker_slot,
+                                    const types::MoveHot* const (&moves)[SCORE_MOVES],
+                                    const ScoreTarget* targets, uint8_t target_count,
+                                    CritStage crit_stage = 0) {
+    CONSTEXPR_ASSERT(target_count <= MAX_SCORE_TARGETS);
+
+    MoveScoreGrid grid{};
+    grid.target_count = target_count;
+
+    // Per move: power, type, STAB and the attack stat it uses (plain and under crit rules)
+    uint16_t power[SCORE_MOVES]{};
+    uint8_t move_type[SCORE_MOVES]{};
+    bool physical[SCORE_MOVES]{};
+    bool stab[SCORE_MOVES]{};
+    StatValue attack[2][SCORE_MOVES]{};  // [crit][move]
+    const CritWeights& weights =
+        CRIT_WEIGHTS.stage[crit_stage <= MAX_CRIT_STAGE ? crit_stage : MAX_CRIT_STAGE + 1];
+
+    // Atk and SpAtk at their stages, once each rather than once per move ([special])
+    const StatValue raw_attack[2] = {attacker.attack, attacker.sp_attack};
+    const StatStage attack_stage[2] = {attacker_slot.atk_stage, attacker_slot.sp_atk_stage};
+    const StatValue staged_attack[2] = {apply_stat_stage(raw_attack[0], attack_stage[0]),
+                                        apply_stat_stage(raw_attack[1], attack_stage[1])};
+
+    for (uint8_t m = 0; m < SCORE_MOVES; ++m) {
+        if (moves[m] == nullptr)
+            continue;
+        const auto& move = *moves[m];
+        physical[m] = is_physical_type(move.type);
+        power[m] = move.power;
+        move_type[m] = static_cast<uint8_t>(move.type);
+        stab[m] = has_stab(move.type, attacker.type1, attacker.type2);
+
+        const uint8_t special = physical[m] ? 0 : 1;
+        attack[0][m] = staged_attack[special];
+        attack[1][m] = attack_stage[special] > DEFAULT_STAT_STAGE ? attack[0][m]
+                                                                  : raw_attack[special];
+    }
+
+    // Per target: Def and SpDef, plain and under crit rules ([crit][special])
+    StatValue defense[MAX_SCORE_TARGETS][2][2]{};
+    for (uint8_t t = 0; t < target_count; ++t) {
+        const auto& mon = *targets[t].mon;
+        const state::SlotState* slot = targets[t].slot;
+        const StatValue raw[2] = {mon.defense, mon.sp_defense};
+        const StatStage stages[2] = {slot ? slot->def_stage : DEFAULT_STAT_STAGE,
+                                     slot ? slot->sp_def_stage : DEFAULT_STAT_STAGE};
+        for (uint8_t special = 0; special < 2; ++special) {
+            const StatValue staged = apply_stat_stage(raw[special], stages[special]);
+            const StatValue crit = stages[special] < DEFAULT_STAT_STAGE ? staged : raw[special];
+            defense[t][0][special] = staged == 0 ? 1 : staged;
+            defense[t][1][special] = crit == 0 ? 1 : crit;
+        }
+    }
+
+    // Cells: both crit branches' unrolled damage, then the weighted roll sums
+    const DamageCalc level_term = util::fastdiv::scale<2, 5>(attacker.level) + 2u;
+    for (uint8_t m = 0; m < SCORE_MOVES; ++m) {
+        if (power[m] == 0)
+            continue;
+        const auto type = static_cast<types::enums::Type>(move_type[m]);
+        const uint8_t special = physical[m] ? 0 : 1;
+        for (uint8_t t = 0; t < target_count; ++t) {
+            const Effectiveness eff = targets[t].mon->effectiveness_against(type);
+            uint32_t sums[2];
+            for (uint8_t crit = 0; crit < 2; ++crit) {
+                DamageCalc damage = level_term * power[m] * attack[crit][m];
+                damage = damage / defense[t][crit][special];
+                damage = util::fastdiv::scale<1, 50>(damage) + 2u;
+                damage = apply_critical_multiplier(damage, crit != 0);
+                if (stab[m])
+                    damage = damage * 3u / 2u;
+                sums[crit] = roll_sum(apply_type_effectiveness(damage, eff), eff);
+            }
+            const uint32_t total = weights.normal * sums[0] + weights.critical * sums[1];
+            grid.expected[m][t] = static_cast<Damage>(util::fastdiv::apply(weights.mean, total));
+        }
+    }
+    return grid;
+}
+
+}  // namespace logic::calc
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstdint>
+
+#include "damage.hpp"
+#include "util/draw_tape.hpp"
+
+namespace logic::calc {
+
+using util::random::Probability;
+using util::random::PROBABILITY_ONE;
+
+// ============================================================================
+//                          MULTI-HIT DISTRIBUTIONS
+// ============================================================================
+//
+// Gen III multi-hit moves check accuracy once, draw how many times they hit
+// (2-5 for Bullet Seed and the like, fixed 2 for Double Kick), then roll
+// crit and damage for each hit and stop early when the target faints.
+// Triple Kick hits up to three times at 10 / 20 / 30 power, checking
+// accuracy before every hit after the first and stopping at a miss.
+//
+// Simulated hit by hit, one such move is a count draw plus a crit and a
+// roll per hit: up to 11 draws, and an outcome enumerator branching on
+// each of them. Only the HP the target loses matters to the state after
+// the move, though, so the enumerator draws that once from its exact
+// distribution instead: the hit-count distribution convolved with the
+// per-hit (crit, roll) outcomes, capped at the target's HP.
+//
+// Reference: pokeemerald/data/battle_scripts_1.s BattleScript_EffectMultiHit,
+//            BattleScript_EffectTripleKick
+//
+// ============================================================================
+
+/// Most hits any move makes
+inline constexpr uint8_t MAX_MULTI_HITS = 5;
+
+/// A 2-5 hit move's count draw: random(8) through MULTI_HIT_COUNTS
+inline constexpr uint8_t HIT_COUNT_ROLLS = 8;
+
+// pokeemerald draws Random() & 3, and rerolls (Random() & 3) + 2 for a 2 or
+// 3: 2 and 3 hits 3/8 each, 4 and 5 hits 1/8 each. One draw of 8 has the
+// same odds.
+inline constexpr uint8_t MULTI_HIT_COUNTS[HIT_COUNT_ROLLS] = {2, 2, 2, 3, 3, 3, 4, 5};
+
+/// Hits for count draw `roll` (< HIT_COUNT_ROLLS)
+constexpr uint8_t multi_hit_count(uint16_t roll) {
+    return MULTI_HIT_COUNTS[roll & (HIT_COUNT_ROLLS - 1)];
+}
+
+/// Chance a 2-5 hit move makes hit `hit` (0-based)
+constexpr Probability multi_hit_reach(uint8_t hit) {
+    uint32_t rolls = 0;
+    for (uint8_t count : MULTI_HIT_COUNTS) {
+        rolls += count > hit;
+    }
+    return util::random::ratio(rolls, HIT_COUNT_ROLLS);
+}
+
+static_assert(multi_hit_reach(1) == PROBABILITY_ONE);
+static_assert(PROBABILITY_ONE - multi_hit_reach(2) == util::random::ratio(3, 8));  // 2 hits
+static_assert(multi_hit_reach(4) == util::random::ratio(1, 8));                   // 5 hits
+static_assert(multi_hit_reach(MAX_MULTI_HITS) == 0);
+
+/// The distinct damage values of one hit, with their chances
+struct HitOutcomes {
+    Damage damage[2 * DAMAGE_ROLL_COUNT]{};
+    Probability chance[2 * DAMAGE_ROLL_COUNT]{};
+    uint8_t count{0};
+};
+
+/**
+ * @brief The 32 (crit, roll) outcomes of a hit, equal damage merged.
+ *
+ * @param dist Distribution from calculate_damage_distribution()
+ */
+constexpr HitOutcomes hit_outcomes(const DamageDistribution& dist) {
+    HitOutcomes outcomes{};
+    // One crit in crit_denominator, then one roll in 16
+    const uint32_t crits = dist.can_crit() ? 1u : 0u;
+    const uint32_t denominator = dist.can_crit() ? dist.crit_denominator : 1u;
+    const Probability normal =
+        util::random::ratio(denominator - crits, DAMAGE_ROLL_COUNT * denominator);
+    const Probability critical = util::random::ratio(crits, DAMAGE_ROLL_COUNT * denominator);
+
+    auto add = [&outcomes](Damage damage, Probability chance) {
+        if (chance == 0)
+            return;
+        for (uint8_t i = 0; i < outcomes.count; ++i) {
+            if (outcomes.damage[i] == damage) {
+                outcomes.chance[i] += chance;
+                return;
+            }
+        }
+        outcomes.damage[outcomes.count] = damage;
+        outcomes.chance[outcomes.count++] = chance;
+    };
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        add(dist.normal[i], normal);
+        add(dist.critical[i], critical);
+    }
+    return outcomes;
+}
+
+/// Per-hit outcomes a model holds (Triple Kick's three powers)
+inline constexpr uint8_t MAX_DISTINCT_HITS = 3;
+
+/// A multi-hit move against one target, after the first accuracy check hit
+struct MultiHitModel {
+    // Hit i rolls hits[i], or hits[distinct - 1] past the last distinct one
+    HitOutcomes hits[MAX_DISTINCT_HITS]{};
+    uint8_t distinct{1};
+
+    // reach[i]: chance hit i is made (reach[0] is one: the move hit)
+    Probability reach[MAX_MULTI_HITS]{};
+    uint8_t max_hits{0};
+
+    [[nodiscard]] constexpr const HitOutcomes& hit(uint8_t i) const {
+        return hits[i < distinct ? i : distinct - 1];
+    }
+};
+
+/**
+ * @brief Exact distribution of the HP a multi-hit move takes.
+ *
+ * mass[d] is the chance the target loses d HP in total, for d in [0, hp];
+ * mass[hp] is the chance it faints (hits after a KO are not made, which
+ * changes nothing the cap does not). The masses are fixed point like the
+ * DrawTape's, so the draw can branch on them directly.
+ *
+ * Cost is O(max_hits x hp x distinct damage values) on the span of totals a
+ * hit count can reach, with no RNG.
+ *
+ * @param hp Target's current HP (> 0)
+ * @param mass Output, hp + 1 entries
+ * @param made, next Scratch, hp + 1 entries each
+ */
+constexpr void total_damage_mass(const MultiHitModel& model, uint16_t hp, Probability* mass,
+                                 Probability* made, Probability* next) {
+    for (uint16_t d = 0; d <= hp; ++d) {
+        mass[d] = 0;
+        made[d] = 0;
+    }
+    made[0] = PROBABILITY_ONE;  // made[d]: chance of d HP lost over the hits so far
+
+    uint16_t high = 0;  // made[] is zero past it
+    for (uint8_t hit = 0; hit < model.max_hits; ++hit) {
+        const HitOutcomes& outcomes = model.hit(hit);
+        uint16_t next_high = 0;
+        for (uint16_t d = 0; d <= hp; ++d) {
+            next[d] = 0;
+        }
+        for (uint16_t d = 0; d <= high; ++d) {
+            if (made[d] == 0)
+                continue;
+            for (uint8_t i = 0; i < outcomes.count; ++i) {
+                const uint32_t total = static_cast<uint32_t>(d) + outcomes.damage[i];
+                const uint16_t capped = total < hp ? static_cast<uint16_t>(total) : hp;
+                next[capped] += util::random::multiply(made[d], outcomes.chance[i]);
+                if (capped > next_high)
+                    next_high = capped;
+            }
+        }
+        high = next_high;
+        for (uint16_t d = 0; d <= high; ++d) {
+            made[d] = next[d];
+        }
+
+        // Moves that stop after this hit: reach[hit] - reach[hit + 1] of them
+        const Probability reached = model.reach[hit];
+        const Probability continues = hit + 1 < model.max_hits ? model.reach[hit + 1] : 0;
+        const Probability stops = reached - continues;
+        if (stops == 0)
+            continue;
+        for (uint16_t d = 0; d <= high; ++d) {
+            if (made[d] != 0)
+                mass[d] += util::random::multiply(made[d], stops);
+        }
+    }
+}
+
+namespace multi_hit_detail {
+
+/// A hit that always deals `damage`
+constexpr HitOutcomes fixed_hit(Damage damage) {
+    HitOutcomes outcomes{};
+    outcomes.damage[0] = damage;
+    outcomes.chance[0] = PROBABILITY_ONE;
+    outcomes.count = 1;
+    return outcomes;
+}
+
+/// total_damage_mass()[d] of a 2-5 hit move dealing 10 per hit
+constexpr Probability bullet_seed_mass(uint16_t hp, uint16_t d) {
+    MultiHitModel model{};
+    model.hits[0] = fixed_hit(10);
+    model.max_hits = MAX_MULTI_HITS;
+    for (uint8_t i = 0; i < MAX_MULTI_HITS; ++i) {
+        model.reach[i] = multi_hit_reach(i);
+    }
+    Probability mass[64]{};
+    Probability made[64]{};
+    Probability next[64]{};
+    total_damage_mass(model, hp, mass, made, next);
+    return mass[d];
+}
+
+}  // namespace multi_hit_detail
+
+static_assert(multi_hit_detail::bullet_seed_mass(60, 20) == util::random::ratio(3, 8));
+static_assert(multi_hit_detail::bullet_seed_mass(60, 40) == util::random::ratio(1, 8));
+static_assert(multi_hit_detail::bullet_seed_mass(60, 50) == util::random::ratio(1, 8));
+static_assert(multi_hit_detail::bullet_seed_mass(25, 25) == util::random::ratio(5, 8));  // KO
+static_assert(multi_hit_detail::bullet_seed_mass(25, 20) == util::random::ratio(3, 8));
+
+}  // namespace logic::calc
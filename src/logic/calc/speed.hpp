@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
 #include "logic/state/context.hpp"
 #include "logic/state/mon.hpp"
 #include "logic/state/slot.hpp"
@@ -20,8 +24,10 @@ using types::calc::StatValue;
 //   effective_speed = base_speed * stage_modifier
 //   If paralyzed: effective_speed /= 4
 //
-// Note: Weather abilities (Swift Swim, Chlorophyll) and items (Quick Claw,
-// Macho Brace) are NOT implemented for Battle Factory Milestone 1.
+// Note: Weather abilities (Swift Swim, Chlorophyll) apply in the engine's
+// turn order on top of this value (dsl::ability::fire_speed_calc), so the
+// slot's cached speed stays weather-independent; Quick Claw is a turn-start
+// item event.
 //
 // Reference: pokeemerald/src/battle_main.c GetWhoStrikesFirst()
 // ============================================================================
@@ -63,10 +69,32 @@ constexpr StatValue calc_effective_speed(const dsl::ActiveMon& active,
     return calc_effective_speed(active.speed, static_cast<StatStage>(slot.spd_stage), mon.status);
 }
 
+/**
+ * @brief Effective speed through the slot's turn-order cache.
+ *
+ * Recomputes only when slot.speed_dirty is set (stage change, paralysis,
+ * switch-in). The cache writes go through assign(), so undo and snapshots
+ * keep it consistent with the state it was computed from.
+ */
+inline StatValue cached_effective_speed(const dsl::ActiveMon& active,
+                                        logic::state::SlotState& slot,
+                                        const logic::state::MonState& mon) {
+    if (slot.speed_dirty) {
+        logic::state::assign(slot.effective_speed, calc_effective_speed(active, slot, mon));
+        logic::state::assign(slot.speed_dirty, false);
+    }
+    assert(slot.effective_speed == calc_effective_speed(active, slot, mon) &&
+           "stale speed cache: a speed input changed without mark_speed_dirty()");
+    return slot.effective_speed;
+}
+
 // ============================================================================
 //                            TURN ORDER
 // ============================================================================
 //
+// The order of a set of actions is a sort on turn_order_key() (descending),
+// with equal keys being speed ties (see determine_turn_order()).
+//
 // Turn order rules (Gen III):
 //   1. Higher priority bracket goes first
 //   2. Within same priority, higher effective speed goes first
@@ -84,6 +112,17 @@ enum class TurnOrder : uint8_t {
     SPEED_TIE = 2,
 };
 
+/**
+ * @brief Single sort key for (priority, Quick Claw, effective speed).
+ *
+ * Priority dominates; within a bracket a battler whose Quick Claw activated
+ * goes first, then the faster battler has the larger key.
+ */
+constexpr uint32_t turn_order_key(int8_t priority, StatValue speed, bool quick_claw = false) {
+    return (static_cast<uint32_t>(static_cast<uint8_t>(priority + 128)) << 17) |
+           (static_cast<uint32_t>(quick_claw) << 16) | speed;
+}
+
 /**
  * @brief Determine turn order between two battlers.
  *
@@ -96,16 +135,13 @@ enum class TurnOrder : uint8_t {
  */
 constexpr TurnOrder determine_turn_order(int8_t priority1, int8_t priority2, StatValue speed1,
                                          StatValue speed2) {
-    // Different priorities - higher priority goes first
-    if (priority1 != priority2) {
-        return (priority1 > priority2) ? TurnOrder::BATTLER1_FIRST : TurnOrder::BATTLER2_FIRST;
-    }
-
-    // Same priority - compare effective speeds
-    if (speed1 > speed2) {
+    // Higher priority first, then higher effective speed
+    const uint32_t key1 = turn_order_key(priority1, speed1);
+    const uint32_t key2 = turn_order_key(priority2, speed2);
+    if (key1 > key2) {
         return TurnOrder::BATTLER1_FIRST;
     }
-    if (speed2 > speed1) {
+    if (key2 > key1) {
         return TurnOrder::BATTLER2_FIRST;
     }
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "logic/state/context.hpp"
+#include "logic/state/slot.hpp"
+#include "stat_stages.hpp"
+#include "types/calc.hpp"
+
+namespace logic::calc {
+
+// ============================================================================
+//                           STAGE-APPLIED STATS
+// ============================================================================
+//
+// Every damage roll applies the attacker's and the defender's stat stage to
+// a raw stat, a multiply and a variable shift that are both software
+// routines on the eZ80. Stages change a few times a battle and are read on
+// every hit, so each slot keeps its four staged stats
+// (SlotState::staged_stats), each tagged with the stage it was computed at.
+// A lookup is a compare and a load while the tag matches the current stage
+// and recomputes otherwise. Raw stats never change while a battler holds its
+// slot (a switch clears the slot, and with it the cache).
+//
+// Speed is not here: turn order already caches the effective speed, with
+// paralysis applied (cached_effective_speed(), speed.hpp).
+//
+// ============================================================================
+
+/// SlotState::staged_stats entries
+enum class StagedStat : uint8_t { ATTACK, DEFENSE, SP_ATTACK, SP_DEFENSE };
+
+static_assert(static_cast<uint8_t>(StagedStat::SP_DEFENSE) + 1 == state::STAGED_STAT_COUNT);
+
+/// The raw stat `stat` names (before stages)
+constexpr StatValue raw_stat(const dsl::ActiveMon& active, StagedStat stat) {
+    switch (stat) {
+        case StagedStat::ATTACK:
+            return active.attack;
+        case StagedStat::DEFENSE:
+            return active.defense;
+        case StagedStat::SP_ATTACK:
+            return active.sp_attack;
+        case StagedStat::SP_DEFENSE:
+            return active.sp_defense;
+    }
+    return 0;
+}
+
+/// The slot's stage of `stat`
+constexpr StatStage stat_stage(const state::SlotState& slot, StagedStat stat) {
+    switch (stat) {
+        case StagedStat::ATTACK:
+            return slot.atk_stage;
+        case StagedStat::DEFENSE:
+            return slot.def_stage;
+        case StagedStat::SP_ATTACK:
+            return slot.sp_atk_stage;
+        case StagedStat::SP_DEFENSE:
+            return slot.sp_def_stage;
+    }
+    return DEFAULT_STAT_STAGE;
+}
+
+/// The attacking (defending) stat a move of the physical or special category uses
+constexpr StagedStat attacking_stat(bool physical) {
+    return physical ? StagedStat::ATTACK : StagedStat::SP_ATTACK;
+}
+constexpr StagedStat defending_stat(bool physical) {
+    return physical ? StagedStat::DEFENSE : StagedStat::SP_DEFENSE;
+}
+
+/**
+ * @brief apply_stat_stage() of `stat` through the slot's cache.
+ *
+ * The cache writes go through assign(), like the speed cache's.
+ *
+ * @param active The battler in `slot` (source of the raw stat)
+ */
+inline StatValue cached_staged_stat(const dsl::ActiveMon& active, state::SlotState& slot,
+                                    StagedStat stat) {
+    // Masked so the compiler can see the index is in range (the count is 4)
+    const auto entry =
+        static_cast<uint8_t>(static_cast<uint8_t>(stat) & (state::STAGED_STAT_COUNT - 1));
+    const StatStage stage = stat_stage(slot, stat);
+    if (slot.staged_at[entry] != stage) {
+        state::assign(slot.staged_stats[entry], apply_stat_stage(raw_stat(active, stat), stage));
+        state::assign(slot.staged_at[entry], stage);
+    }
+    assert(slot.staged_stats[entry] == apply_stat_stage(raw_stat(active, stat), stage) &&
+           "stale staged stat: the slot's raw stats changed without a slot clear");
+    return slot.staged_stats[entry];
+}
+
+}  // namespace logic::calc
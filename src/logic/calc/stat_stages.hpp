@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
+
 #include "types/calc.hpp"
 #include "util/assert.hpp"
+#include "util/fastdiv.hpp"
 
 namespace logic::calc {
 
@@ -52,6 +55,32 @@ constexpr uint8_t STAT_STAGE_RATIOS[13][2] = {
 };
 // clang-format on
 
+/**
+ * @brief STAT_STAGE_RATIOS as multiply-shifts.
+ *
+ * Exact for every stat below 32768, far above any reachable stat; larger
+ * inputs take the division path.
+ */
+constexpr util::fastdiv::Ratio STAT_STAGE_SCALES[13] = {
+    util::fastdiv::make_ratio(10, 40), util::fastdiv::make_ratio(10, 35),
+    util::fastdiv::make_ratio(10, 30), util::fastdiv::make_ratio(10, 25),
+    util::fastdiv::make_ratio(10, 20), util::fastdiv::make_ratio(10, 15),
+    util::fastdiv::make_ratio(10, 10), util::fastdiv::make_ratio(15, 10),
+    util::fastdiv::make_ratio(20, 10), util::fastdiv::make_ratio(25, 10),
+    util::fastdiv::make_ratio(30, 10), util::fastdiv::make_ratio(35, 10),
+    util::fastdiv::make_ratio(40, 10),
+};
+
+static_assert([] {
+    for (size_t i = 0; i < 13; ++i) {
+        if (STAT_STAGE_SCALES[i].numerator != STAT_STAGE_RATIOS[i][0] ||
+            STAT_STAGE_SCALES[i].denominator != STAT_STAGE_RATIOS[i][1] ||
+            STAT_STAGE_SCALES[i].limit < INT16_MAX)
+            return false;
+    }
+    return true;
+}(), "STAT_STAGE_SCALES must mirror STAT_STAGE_RATIOS");
+
 /**
  * @brief Apply stat stage modifier to a base stat value.
  *
@@ -62,15 +91,14 @@ constexpr uint8_t STAT_STAGE_RATIOS[13][2] = {
  *
  * @return The modified stat value after applying stage multiplier
  */
+template <bool DivisionFree = util::fastdiv::ENABLED>
 constexpr StatValue apply_stat_stage(StatValue base_stat, int8_t stage) {
     CONSTEXPR_ASSERT(stage >= MIN_STAT_STAGE && stage <= MAX_STAT_STAGE);
 
+    // base_stat * numerator / denominator (see STAT_STAGE_SCALES)
     size_t idx = stage_to_index(stage);
-    uint32_t result = base_stat;
-    result *= STAT_STAGE_RATIOS[idx][0];
-    result /= STAT_STAGE_RATIOS[idx][1];
-
-    return static_cast<StatValue>(result);
+    return static_cast<StatValue>(
+        util::fastdiv::apply<DivisionFree>(STAT_STAGE_SCALES[idx], base_stat));
 }
 
 /**
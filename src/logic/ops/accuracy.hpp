@@ -16,21 +16,26 @@ namespace logic::ops {
 // ============================================================================
 
 struct CheckAccuracy : CommandMeta<Domain::Slot, Genesis, AccuracyResolved> {
+    static constexpr EffectTraits traits{.draws_rng = true};
+
     static void execute(dsl::BattleContext& ctx) {
         // Get stat stages (default to 0 if no slot context)
         int8_t acc_stage = 0;
         int8_t eva_stage = 0;
 
-        if (ctx.attacker_slot) {
-            acc_stage = ctx.attacker_slot->accuracy_stage;
+        if (ctx.attacker_slot()) {
+            acc_stage = ctx.attacker_slot()->accuracy_stage;
         }
-        if (ctx.defender_slot) {
-            eva_stage = ctx.defender_slot->evasion_stage;
+        if (ctx.defender_slot()) {
+            eva_stage = ctx.defender_slot()->evasion_stage;
         }
 
         // Check accuracy using calc module
-        bool hits = calc::check_accuracy(ctx.move->accuracy, acc_stage, eva_stage);
+        bool hits = calc::check_accuracy(*ctx.rng, ctx.move->accuracy, acc_stage, eva_stage);
         ctx.result.missed = !hits;
+        if (!hits) {
+            logic::state::events::emit(logic::state::EventType::MISS, ctx.attacker_slot_id);
+        }
     }
 };
 
@@ -12,6 +12,7 @@
 #include "damage.hpp"
 #include "faint.hpp"
 #include "field.hpp"
+#include "multi_hit.hpp"
 #include "stats.hpp"
 #include "status.hpp"
 #include "switch.hpp"
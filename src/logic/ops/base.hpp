@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../dsl/domain.hpp"
+#include "../../dsl/effect_traits.hpp"
 #include "../../dsl/stages.hpp"
 #include "../state/context.hpp"
 
@@ -15,6 +16,8 @@ namespace logic::ops {
 //   1. domains  - Which state domains it requires access to
 //   2. input    - The pipeline stage it runs at
 //   3. output   - The pipeline stage after execution
+//   4. traits   - Optionally, what it can do beyond its stages and domains
+//                 (dsl::EffectTraits: RNG draws, switching, charging)
 //
 // The DSL validates these at compile time: an effect cannot use a command
 // unless it has declared access to all required domains.
@@ -2,6 +2,7 @@
 
 #include "../../dsl/item/dispatch.hpp"
 #include "../calc/damage.hpp"
+#include "../calc/staged_stats.hpp"
 #include "base.hpp"
 
 namespace logic::ops {
@@ -17,49 +18,39 @@ namespace logic::ops {
 // Stage:  AccuracyResolved -> DamageCalculated
 // ============================================================================
 
-namespace detail {
-
-// Gen III physical/special split is based on type, not move
-// Physical: Normal, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel
-// Special: Fire, Water, Grass, Electric, Psychic, Ice, Dragon, Dark
-constexpr bool is_physical_type(types::enums::Type type) {
-    using enum types::enums::Type;
-    switch (type) {
-        case NORMAL:
-        case FIGHTING:
-        case FLYING:
-        case POISON:
-        case GROUND:
-        case ROCK:
-        case BUG:
-        case GHOST:
-        case STEEL:
-            return true;
-        default:
-            return false;
-    }
-}
-
-}  // namespace detail
-
 struct CalculateDamage : CommandMeta<Domain::Slot | Domain::Mon | Domain::Transient,
                                      AccuracyResolved, DamageCalculated> {
+    static constexpr EffectTraits traits{.draws_rng = true};  // Crit and damage roll
+
     using transient_type = calc::DamageParams;
 
     static transient_type build_transient(dsl::BattleContext& ctx) {
-        transient_type params{};
-
         // If the move already missed, params stay zeroed.
         if (ctx.result.missed) {
-            return params;
+            return transient_type{};
+        }
+        return build_params(ctx);
+    }
+
+    static void execute(dsl::BattleContext& ctx, transient_type& params) {
+        // Skip if move missed
+        if (ctx.result.missed) {
+            ctx.result.damage = 0;
+            return;
         }
+        roll(ctx, params);
+    }
+
+    /// Damage inputs of a move that hit (build_transient() past the miss check)
+    static transient_type build_params(dsl::BattleContext& ctx) {
+        transient_type params{};
 
         const auto& attacker = ctx.attacker();
         const auto& defender = ctx.defender();
         const auto& move = *ctx.move;
 
         // Determine physical vs special based on move type (Gen III)
-        bool is_physical = detail::is_physical_type(move.type);
+        bool is_physical = calc::is_physical_type(move.type);
 
         // Build initial stats (before item modifiers)
         const uint16_t override_attack = ctx.override.attack;
@@ -79,14 +70,14 @@ struct CalculateDamage : CommandMeta<Domain::Slot | Domain::Mon | Domain::Transi
         // Stat stages
         if (is_physical) {
             params.attack_stage =
-                ctx.attacker_slot ? ctx.attacker_slot->atk_stage : calc::DEFAULT_STAT_STAGE;
+                ctx.attacker_slot() ? ctx.attacker_slot()->atk_stage : calc::DEFAULT_STAT_STAGE;
             params.defense_stage =
-                ctx.defender_slot ? ctx.defender_slot->def_stage : calc::DEFAULT_STAT_STAGE;
+                ctx.defender_slot() ? ctx.defender_slot()->def_stage : calc::DEFAULT_STAT_STAGE;
         } else {
             params.attack_stage =
-                ctx.attacker_slot ? ctx.attacker_slot->sp_atk_stage : calc::DEFAULT_STAT_STAGE;
+                ctx.attacker_slot() ? ctx.attacker_slot()->sp_atk_stage : calc::DEFAULT_STAT_STAGE;
             params.defense_stage =
-                ctx.defender_slot ? ctx.defender_slot->sp_def_stage : calc::DEFAULT_STAT_STAGE;
+                ctx.defender_slot() ? ctx.defender_slot()->sp_def_stage : calc::DEFAULT_STAT_STAGE;
         }
 
         // Types for STAB and effectiveness
@@ -94,23 +85,48 @@ struct CalculateDamage : CommandMeta<Domain::Slot | Domain::Mon | Domain::Transi
         params.attacker_type2 = attacker.type2;
         params.defender_type1 = defender.type1;
         params.defender_type2 = defender.type2;
+        params.effectiveness = defender.effectiveness_against(move.type);
 
         return params;
     }
 
-    static void execute(dsl::BattleContext& ctx, transient_type& params) {
-        // Skip if move missed
-        if (ctx.result.missed) {
-            ctx.result.damage = 0;
-            return;
-        }
+    /**
+     * @brief Roll the damage of a move that hit (execute() past the miss check).
+     *
+     * The stages are taken from the slots' staged-stat caches when the
+     * pre-damage hooks left a stat and its stage as build_params() read them
+     * (a boosted, overridden or halved stat has its stage applied here).
+     */
+    static void roll(dsl::BattleContext& ctx, transient_type& params) {
+        stage_stats(ctx, params);
 
-        // Calculate damage
-        auto result = calc::calculate_damage(params);
+        auto result = calc::calculate_damage(*ctx.rng, params);
 
         ctx.result.damage = result.damage;
         ctx.result.effectiveness = result.effectiveness;
         ctx.result.critical = result.critical;
+        if (result.critical && result.damage > 0) {
+            logic::state::events::emit(logic::state::EventType::CRITICAL, ctx.attacker_slot_id);
+        }
+    }
+
+    /// Take params' staged Atk / Def from the slot caches where they apply (see roll())
+    static void stage_stats(dsl::BattleContext& ctx, transient_type& params) {
+        const bool is_physical = calc::is_physical_type(ctx.move->type);
+        if (auto* slot = ctx.attacker_slot()) {
+            const auto stat = calc::attacking_stat(is_physical);
+            const auto& attacker = ctx.attacker();
+            if (params.attack == calc::raw_stat(attacker, stat) &&
+                params.attack_stage == calc::stat_stage(*slot, stat))
+                params.staged_attack = calc::cached_staged_stat(attacker, *slot, stat);
+        }
+        if (auto* slot = ctx.defender_slot()) {
+            const auto stat = calc::defending_stat(is_physical);
+            const auto& defender = ctx.defender();
+            if (params.defense == calc::raw_stat(defender, stat) &&
+                params.defense_stage == calc::stat_stage(*slot, stat))
+                params.staged_defense = calc::cached_staged_stat(defender, *slot, stat);
+        }
     }
 };
 
@@ -125,43 +141,52 @@ struct CalculateDamage : CommandMeta<Domain::Slot | Domain::Mon | Domain::Transi
 // ============================================================================
 
 struct ApplyDamage : CommandMeta<Domain::Slot | Domain::Mon, DamageCalculated, DamageApplied> {
+    // Focus Band here; King's Rock and contact abilities in the transition after
+    static constexpr EffectTraits traits{.draws_rng = true};
+
     static void execute(dsl::BattleContext& ctx) {
         if (ctx.result.missed || ctx.result.damage == 0) {
             return;
         }
+        apply(ctx);
+    }
 
+    /// Apply nonzero damage from a move that hit (execute() past its checks)
+    static void apply(dsl::BattleContext& ctx) {
         uint16_t damage = ctx.result.damage;
 
         // Check for substitute
         if (ctx.defender_has_substitute()) {
-            auto& sub_hp = ctx.defender_slot->substitute_hp;
+            auto& sub_hp = ctx.defender_slot()->substitute_hp;
             if (damage >= sub_hp) {
                 // Substitute breaks
                 damage -= sub_hp;
-                sub_hp = 0;
-                ctx.defender_slot->clear(logic::state::volatile_flags::SUBSTITUTE);
+                logic::state::assign(sub_hp, 0);
+                ctx.defender_slot()->clear(logic::state::volatile_flags::SUBSTITUTE);
                 // Remaining damage does NOT carry through in Gen III
                 return;
             } else {
-                sub_hp -= damage;
+                logic::state::assign(sub_hp, sub_hp - damage);
                 return;
             }
         }
 
         // Fire item hooks for damage application (Focus Band, etc.)
         bool survived_fatal = false;
-        uint16_t defender_hp = ctx.defender_mon ? ctx.defender_mon->current_hp : 0;
+        uint16_t defender_hp = ctx.defender_mon() ? ctx.defender_mon()->current_hp : 0;
         dsl::item::fire_pre_damage_apply(ctx, damage, defender_hp, survived_fatal);
 
         // Update result with potentially modified damage
         ctx.result.damage = damage;
 
         // Apply to actual HP
-        ctx.defender_mon->apply_damage(damage);
+        ctx.defender_mon()->apply_damage(damage);
 
-        // Track if Focus Band saved the defender (for messaging/animation)
-        // Could add a field to EffectResult if needed
-        (void)survived_fatal;
+        // Focus Band saved the defender: shown after the hit
+        if (survived_fatal) {
+            logic::state::events::emit(logic::state::EventType::ITEM, ctx.defender_slot_id,
+                                       static_cast<uint16_t>(ctx.defender_slot()->held_item));
+        }
     }
 };
 
@@ -185,8 +210,8 @@ struct DrainHP : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
         }
 
         // If a substitute is still up, no HP is restored (Gen III behavior)
-        if (ctx.defender_has_substitute() && ctx.defender_slot &&
-            ctx.defender_slot->substitute_hp > 0) {
+        if (ctx.defender_has_substitute() && ctx.defender_slot() &&
+            ctx.defender_slot()->substitute_hp > 0) {
             return;
         }
 
@@ -194,7 +219,7 @@ struct DrainHP : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
         if (heal == 0 && ctx.result.damage > 0) {
             heal = 1;  // minimum 1 HP if damage > 0
         }
-        ctx.attacker_mon->heal(static_cast<uint16_t>(heal));
+        ctx.attacker_mon()->heal(static_cast<uint16_t>(heal));
     }
 };
 
@@ -219,7 +244,7 @@ struct Recoil : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
         if (recoil == 0 && ctx.result.damage > 0) {
             recoil = 1;  // minimum 1 if damage occurred
         }
-        ctx.attacker_mon->apply_damage(static_cast<uint16_t>(recoil));
+        ctx.attacker_mon()->apply_damage(static_cast<uint16_t>(recoil));
     }
 };
 
@@ -259,12 +284,12 @@ struct SetFixedDamage
 template <uint8_t Percent>
 struct HealUser : CommandMeta<Domain::Mon, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (!ctx.attacker_mon)
+        if (!ctx.attacker_mon())
             return;
-        uint32_t heal = static_cast<uint32_t>(ctx.attacker_mon->max_hp) * Percent / 100u;
+        uint32_t heal = static_cast<uint32_t>(ctx.attacker_mon()->max_hp) * Percent / 100u;
         if (heal == 0 && Percent > 0)
             heal = 1;
-        ctx.attacker_mon->heal(static_cast<uint16_t>(heal));
+        ctx.attacker_mon()->heal(static_cast<uint16_t>(heal));
     }
 };
 
@@ -19,7 +19,7 @@ namespace logic::ops {
 struct CheckFaint : CommandMeta<Domain::Mon, DamageApplied, FaintChecked> {
     static void execute(dsl::BattleContext& ctx) {
         // Check if defender fainted
-        if (ctx.defender_mon->is_fainted()) {
+        if (ctx.defender_mon()->is_fainted()) {
             // TODO: Queue switch request, handle Destiny Bond, etc.
             // For now, just note that they fainted
         }
@@ -18,13 +18,13 @@ template <logic::state::Weather W>
 struct SetWeather : CommandMeta<Domain::Field, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
         // Check if weather is already active
-        if (ctx.field->weather == W) {
+        if (ctx.field()->weather == W) {
             ctx.result.failed = true;
             return;
         }
 
-        ctx.field->weather = W;
-        ctx.field->weather_turns = 5;  // Standard duration
+        logic::state::assign(ctx.field()->weather, W);
+        ctx.field()->schedule(ctx.field()->weather_expiry, 5);  // Standard duration
     }
 };
 
@@ -45,41 +45,41 @@ using SetHail = SetWeather<logic::state::Weather::HAIL>;
 
 struct SetReflect : CommandMeta<Domain::Side, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.attacker_side->has_reflect()) {
+        if (ctx.attacker_side()->has_reflect()) {
             ctx.result.failed = true;
             return;
         }
-        ctx.attacker_side->reflect_turns = 5;
+        ctx.field()->schedule(ctx.attacker_side()->reflect_expiry, 5);
     }
 };
 
 struct SetLightScreen : CommandMeta<Domain::Side, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.attacker_side->has_light_screen()) {
+        if (ctx.attacker_side()->has_light_screen()) {
             ctx.result.failed = true;
             return;
         }
-        ctx.attacker_side->light_screen_turns = 5;
+        ctx.field()->schedule(ctx.attacker_side()->light_screen_expiry, 5);
     }
 };
 
 struct SetSafeguard : CommandMeta<Domain::Side, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.attacker_side->has_safeguard()) {
+        if (ctx.attacker_side()->has_safeguard()) {
             ctx.result.failed = true;
             return;
         }
-        ctx.attacker_side->safeguard_turns = 5;
+        ctx.field()->schedule(ctx.attacker_side()->safeguard_expiry, 5);
     }
 };
 
 struct SetMist : CommandMeta<Domain::Side, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.attacker_side->has_mist()) {
+        if (ctx.attacker_side()->has_mist()) {
             ctx.result.failed = true;
             return;
         }
-        ctx.attacker_side->mist_turns = 5;
+        ctx.field()->schedule(ctx.attacker_side()->mist_expiry, 5);
     }
 };
 
@@ -89,11 +89,12 @@ struct SetMist : CommandMeta<Domain::Side, Genesis, EffectApplied> {
 
 struct AddSpikes : CommandMeta<Domain::Side, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.defender_side->spikes_layers >= 3) {
+        auto& layers = ctx.defender_side()->spikes_layers;
+        if (layers >= 3) {
             ctx.result.failed = true;
             return;
         }
-        ctx.defender_side->spikes_layers++;
+        logic::state::assign(layers, layers + 1);
     }
 };
 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "../../dsl/item/event_mask.hpp"
+#include "../../dsl/transition.hpp"
+#include "../calc/accuracy.hpp"
+#include "../calc/ko.hpp"
+#include "../calc/multi_hit.hpp"
+#include "accuracy.hpp"
+#include "damage.hpp"
+
+namespace logic::ops {
+
+// ============================================================================
+//                            MULTI-HIT DAMAGE
+// ============================================================================
+//
+// The hits of a multi-hit move that passed its accuracy check, in one
+// command: each hit builds its damage inputs, fires the pre-damage-calc
+// hooks, rolls and applies, like CheckAccuracy's successors in the Hit
+// kernel (dsl/fused.hpp). The loop ends at the hit count (drawn once, before
+// the first hit), at a KO, or at Triple Kick's first miss.
+//
+// Under a DrawTape the command draws the total HP lost instead, once, from
+// calc::total_damage_mass(): one branch per distinct total rather than one
+// per count, crit and roll. That is exact while the hits do not interact:
+// not through a substitute (hits go to it until it breaks) and not through
+// a Focus Band (a per-hit survival roll). Those turns run the loop. The
+// shortcut steps the generator once, where the loop would have drawn per
+// hit; the battle RNG is not part of the state hash.
+//
+// ctx.result.damage is the damage of every hit together, and
+// ctx.result.hits the hits made (0 when the total was drawn at once).
+// ctx.loop_iteration is the hit being made.
+//
+// Domain: Slot | Mon (stages and substitute, HP)
+// Stage:  AccuracyResolved -> DamageApplied
+// ============================================================================
+
+/// How many times a multi-hit move hits
+enum class HitCount : uint8_t {
+    TWO,          // Double Kick, Bonemerang
+    TWO_TO_FIVE,  // Bullet Seed, Arm Thrust, Bone Rush, ...
+    TRIPLE_KICK,  // Up to 3, accuracy before each, power 1x / 2x / 3x
+};
+
+template <HitCount Count>
+struct RepeatedHits : CommandMeta<Domain::Slot | Domain::Mon, AccuracyResolved, DamageApplied> {
+    static constexpr EffectTraits traits{.draws_rng = true};  // Count, crits and rolls
+
+    static void execute(dsl::BattleContext& ctx) {
+        ctx.result.hits = 0;
+        if (ctx.result.missed) {
+            ctx.result.damage = 0;
+            return;
+        }
+        if (util::random::g_draw_tape && draw_total(ctx)) {
+            return;
+        }
+
+        const uint16_t base_power = ctx.override.power;
+        uint32_t total = 0;
+        const uint8_t hits = hit_count(ctx);
+        for (uint8_t hit = 0; hit < hits && !ctx.defender_mon()->is_fainted(); ++hit) {
+            ctx.loop_iteration = hit;
+            if (Count == HitCount::TRIPLE_KICK && hit > 0) {
+                CheckAccuracy::execute(ctx);
+                if (ctx.result.missed) {
+                    ctx.result.missed = false;  // The move still hit
+                    break;
+                }
+            }
+            auto params = hit_params(ctx, hit, base_power);
+            CalculateDamage::roll(ctx, params);
+            if (ctx.result.damage != 0) {
+                ApplyDamage::apply(ctx);
+            }
+            total += ctx.result.damage;
+            ++ctx.result.hits;
+        }
+        ctx.override.power = base_power;
+        ctx.result.damage = static_cast<uint16_t>(total < UINT16_MAX ? total : UINT16_MAX);
+    }
+
+   private:
+    static uint8_t hit_count(dsl::BattleContext& ctx) {
+        if constexpr (Count == HitCount::TWO_TO_FIVE) {
+            // The tape branches on the count, not on the roll
+            return calc::multi_hit_count(ctx.rng->random_grouped(
+                calc::HIT_COUNT_ROLLS, [](uint16_t roll) { return calc::multi_hit_count(roll); },
+                util::random::DrawSite::HIT_COUNT));
+        } else if constexpr (Count == HitCount::TWO) {
+            return 2;
+        } else {
+            return 3;
+        }
+    }
+
+    /// Damage inputs of hit `hit`, after the pre-damage-calc hooks
+    static calc::DamageParams hit_params(dsl::BattleContext& ctx, uint8_t hit,
+                                         uint16_t base_power) {
+        if constexpr (Count == HitCount::TRIPLE_KICK) {
+            const uint16_t power = base_power > 0 ? base_power : ctx.move->power;
+            ctx.override.power = static_cast<uint16_t>(power * (hit + 1u));
+        }
+        auto params = CalculateDamage::build_params(ctx);
+        dsl::run_transition<AccuracyResolved, DamageCalculated>(ctx, params);
+        return params;
+    }
+
+    /**
+     * @brief Draw the move's total damage at once (tape installed).
+     *
+     * @return false if the hits interact, and the loop must run
+     */
+    static bool draw_total(dsl::BattleContext& ctx) {
+        using util::random::Probability;
+
+        logic::state::MonState& defender = *ctx.defender_mon();
+        const uint16_t hp = defender.current_hp;
+        if (hp == 0 || hp > calc::NHKO_MAX_HP || ctx.defender_has_substitute() ||
+            (ctx.defender_slot()->item_events &
+             dsl::item::EVENT_BIT<dsl::item::OnPreDamageApply>)) {
+            return false;
+        }
+
+        calc::MultiHitModel model{};
+        const uint16_t base_power = ctx.override.power;
+        if constexpr (Count == HitCount::TRIPLE_KICK) {
+            model.distinct = calc::MAX_DISTINCT_HITS;
+            model.max_hits = 3;
+        } else {
+            model.max_hits = Count == HitCount::TWO ? 2 : calc::MAX_MULTI_HITS;
+        }
+        for (uint8_t hit = 0; hit < model.distinct; ++hit) {
+            ctx.loop_iteration = hit;
+            auto params = hit_params(ctx, hit, base_power);
+            CalculateDamage::stage_stats(ctx, params);
+            const auto dist = calc::calculate_damage_distribution(params);
+            model.hits[hit] = calc::hit_outcomes(dist);
+            ctx.result.effectiveness = dist.effectiveness;
+        }
+        ctx.override.power = base_power;
+
+        // Triple Kick makes hit i after i more accuracy checks
+        const Probability accuracy =
+            Count == HitCount::TRIPLE_KICK
+                ? calc::hit_probability(ctx.move->accuracy, ctx.attacker_slot()->accuracy_stage,
+                                        ctx.defender_slot()->evasion_stage)
+                : util::random::PROBABILITY_ONE;
+        for (uint8_t hit = 0; hit < model.max_hits; ++hit) {
+            if constexpr (Count == HitCount::TWO_TO_FIVE) {
+                model.reach[hit] = calc::multi_hit_reach(hit);
+            } else {
+                model.reach[hit] = hit == 0 ? util::random::PROBABILITY_ONE
+                                            : util::random::multiply(model.reach[hit - 1],
+                                                                     accuracy);
+            }
+        }
+
+        // Per-thread scratch, as calc_nhko()'s
+        static BATTLEMON_THREAD_LOCAL Probability mass[calc::NHKO_MAX_HP + 1];
+        static BATTLEMON_THREAD_LOCAL Probability made[calc::NHKO_MAX_HP + 1];
+        static BATTLEMON_THREAD_LOCAL Probability next[calc::NHKO_MAX_HP + 1];
+        calc::total_damage_mass(model, hp, mass, made, next);
+
+        const uint16_t total = ctx.rng->random_weighted(static_cast<uint16_t>(hp + 1), mass,
+                                                        util::random::DrawSite::DAMAGE_ROLL);
+        ctx.result.damage = total;
+        ctx.result.critical = false;
+        if (total != 0) {
+            defender.apply_damage(total);
+        }
+        return true;
+    }
+};
+
+using DoubleHitDamage = RepeatedHits<HitCount::TWO>;
+using MultiHitDamage = RepeatedHits<HitCount::TWO_TO_FIVE>;
+using TripleKickDamage = RepeatedHits<HitCount::TRIPLE_KICK>;
+
+}  // namespace logic::ops
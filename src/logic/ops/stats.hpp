@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../dsl/ability/dispatch.hpp"
 #include "base.hpp"
 #include "types/enums/stats.hpp"
 
@@ -50,6 +51,22 @@ inline int8_t& get_stage(logic::state::SlotState& slot, Stat stat) {
     return slot.atk_stage;  // Unreachable
 }
 
+// Write a stage, invalidating the cached turn-order speed for SPD
+template <Stat S>
+inline void set_stage(logic::state::SlotState& slot, int8_t& stage, int8_t value) {
+    logic::state::assign(stage, value);
+    if constexpr (S == Stat::SPD) {
+        slot.mark_speed_dirty();
+    }
+}
+
+// True if the defender's ability stops the foe lowering S (Clear Body, Keen Eye)
+template <Stat S>
+inline bool drop_blocked(const dsl::BattleContext& ctx) {
+    return dsl::ability::stat_drop_blocked(ctx, ctx.defender_slot_id, S == Stat::ATK,
+                                           S == Stat::ACCURACY);
+}
+
 }  // namespace detail
 
 // ============================================================================
@@ -59,7 +76,8 @@ inline int8_t& get_stage(logic::state::SlotState& slot, Stat stat) {
 template <Stat S, int8_t Stages>
 struct ModifyUserStat : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        int8_t& stage = detail::get_stage(*ctx.attacker_slot, S);
+        auto& slot = *ctx.attacker_slot();
+        int8_t& stage = detail::get_stage(slot, S);
 
         // Apply modification with bounds (-6 to +6)
         int8_t new_stage = stage + Stages;
@@ -74,7 +92,7 @@ struct ModifyUserStat : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
             return;
         }
 
-        stage = new_stage;
+        detail::set_stage<S>(slot, stage, new_stage);
     }
 };
 
@@ -86,9 +104,16 @@ template <Stat S, int8_t Stages>
 struct ModifyDefenderStat : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
         // TODO: Check for Mist protection
-        // TODO: Check for abilities (Clear Body, White Smoke, etc.)
 
-        int8_t& stage = detail::get_stage(*ctx.defender_slot, S);
+        if constexpr (Stages < 0) {
+            if (detail::drop_blocked<S>(ctx)) {
+                ctx.result.failed = true;
+                return;
+            }
+        }
+
+        auto& slot = *ctx.defender_slot();
+        int8_t& stage = detail::get_stage(slot, S);
 
         int8_t new_stage = stage + Stages;
         if (new_stage < -6)
@@ -101,7 +126,7 @@ struct ModifyDefenderStat : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
             return;
         }
 
-        stage = new_stage;
+        detail::set_stage<S>(slot, stage, new_stage);
     }
 };
 
@@ -121,7 +146,13 @@ struct TryModifyDefenderStat : CommandMeta<Domain::Slot, DamageApplied, EffectAp
         if (chance == 0)
             return;
 
-        int8_t& stage = detail::get_stage(*ctx.defender_slot, S);
+        if constexpr (Stages < 0) {
+            if (detail::drop_blocked<S>(ctx))
+                return;
+        }
+
+        auto& slot = *ctx.defender_slot();
+        int8_t& stage = detail::get_stage(slot, S);
 
         int8_t new_stage = stage + Stages;
         if (new_stage < -6)
@@ -129,7 +160,7 @@ struct TryModifyDefenderStat : CommandMeta<Domain::Slot, DamageApplied, EffectAp
         if (new_stage > 6)
             new_stage = 6;
 
-        stage = new_stage;
+        detail::set_stage<S>(slot, stage, new_stage);
     }
 };
 
@@ -183,23 +214,24 @@ using TryLowerDefenderSpd1 = TryModifyDefenderStat<Stat::SPD, -1>;
 struct ResetAllStats : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
         // Reset attacker's stats
-        reset_slot(*ctx.attacker_slot);
+        reset_slot(*ctx.attacker_slot());
 
         // Reset defender's stats
-        reset_slot(*ctx.defender_slot);
+        reset_slot(*ctx.defender_slot());
 
         // TODO: In doubles, iterate over all 4 slots
     }
 
    private:
     static void reset_slot(logic::state::SlotState& slot) {
-        slot.atk_stage = 0;
-        slot.def_stage = 0;
-        slot.spd_stage = 0;
-        slot.sp_atk_stage = 0;
-        slot.sp_def_stage = 0;
-        slot.accuracy_stage = 0;
-        slot.evasion_stage = 0;
+        logic::state::assign(slot.atk_stage, 0);
+        logic::state::assign(slot.def_stage, 0);
+        logic::state::assign(slot.spd_stage, 0);
+        logic::state::assign(slot.sp_atk_stage, 0);
+        logic::state::assign(slot.sp_def_stage, 0);
+        logic::state::assign(slot.accuracy_stage, 0);
+        logic::state::assign(slot.evasion_stage, 0);
+        slot.mark_speed_dirty();
     }
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../dsl/ability/dispatch.hpp"
 #include "base.hpp"
 
 namespace logic::ops {
@@ -11,14 +12,71 @@ namespace logic::ops {
 // ops for applying primary status conditions (burn, freeze, etc.)
 // These check for immunity and existing status before applying.
 //
-// Domain: Mon (writes status)
+// Domain: Mon (writes status); paralysis also Slot (invalidates the cached speed)
 // Stage:  DamageApplied -> EffectApplied (for secondary effects)
 //         Genesis -> EffectApplied (for pure status moves)
 // ============================================================================
 
 // Try to apply a status with a percentage chance
+// Paralysis also writes the Slot domain (the defender's cached speed)
 template <logic::state::Status S>
-struct TryApplyStatus : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
+inline constexpr Domain STATUS_DOMAINS =
+    S == logic::state::Status::PARALYSIS ? Domain::Mon | Domain::Slot : Domain::Mon;
+
+// Type immunity to S (Gen III: Fire / burn, Ice / freeze, Poison and Steel /
+// poison and toxic; Electric types can still be paralyzed)
+template <logic::state::Status S>
+inline constexpr logic::calc::TraitMask STATUS_IMMUNITY =
+    S == logic::state::Status::BURN     ? logic::calc::traits::IMMUNE_BURN
+    : S == logic::state::Status::FREEZE ? logic::calc::traits::IMMUNE_FREEZE
+    : S == logic::state::Status::POISON || S == logic::state::Status::TOXIC
+        ? logic::calc::traits::IMMUNE_POISON
+        : logic::calc::TraitMask{0};
+
+/// STATUS_IMMUNITY of a status known only at run time (ability-inflicted status)
+constexpr logic::calc::TraitMask status_immunity(logic::state::Status status) {
+    using logic::state::Status;
+    switch (status) {
+        case Status::BURN:
+            return STATUS_IMMUNITY<Status::BURN>;
+        case Status::FREEZE:
+            return STATUS_IMMUNITY<Status::FREEZE>;
+        case Status::POISON:
+            return STATUS_IMMUNITY<Status::POISON>;
+        case Status::TOXIC:
+            return STATUS_IMMUNITY<Status::TOXIC>;
+        default:
+            return logic::calc::TraitMask{0};
+    }
+}
+
+/// Sleep counter for a new sleep: 2-5 in Gen III
+inline uint8_t draw_sleep_turns(util::random::Rng& rng) {
+    return static_cast<uint8_t>(2 + rng.random(4, util::random::DrawSite::SLEEP));
+}
+
+/// The defender's types make it immune to S
+template <logic::state::Status S>
+inline bool type_immune(const dsl::BattleContext& ctx) {
+    if constexpr (STATUS_IMMUNITY<S> == 0) {
+        return false;
+    } else {
+        return ctx.defender_active()->has_trait(STATUS_IMMUNITY<S>);
+    }
+}
+
+// Paralysis quarters speed: drop the defender's cached turn-order speed
+template <logic::state::Status S>
+inline void mark_speed_if_paralyzed(dsl::BattleContext& ctx) {
+    if constexpr (S == logic::state::Status::PARALYSIS) {
+        if (ctx.defender_slot()) {
+            ctx.defender_slot()->mark_speed_dirty();
+        }
+    }
+}
+
+template <logic::state::Status S>
+struct TryApplyStatus : CommandMeta<STATUS_DOMAINS<S>, DamageApplied, EffectApplied> {
     static void execute(dsl::BattleContext& ctx, uint8_t chance) {
         // Skip if missed
         if (ctx.result.missed) {
@@ -26,29 +84,34 @@ struct TryApplyStatus : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
         }
 
         // Can't status if already statused
-        if (ctx.defender_mon->has_status()) {
+        if (ctx.defender_mon()->has_status()) {
             return;
         }
 
-        // TODO: Type immunities
-        // - Fire immune to burn
-        // - Ice immune to freeze
-        // - Poison/Steel immune to poison
-        // - Electric immune to paralysis (in some gens)
+        if (type_immune<S>(ctx)) {
+            return;
+        }
 
-        // TODO: Ability immunities (Limber, Water Veil, etc.)
+        // Ability immunities (Limber, Water Veil, etc.)
+        if (dsl::ability::status_blocked(ctx, ctx.defender_slot_id, S)) {
+            return;
+        }
 
         // TODO: Safeguard check
 
         // Roll for chance
         // For smoke testing, always apply if chance > 0
         if (chance > 0) {
-            ctx.defender_mon->status = S;
+            logic::state::assign(ctx.defender_mon()->status, S);
             ctx.result.status_applied = true;
+            logic::state::events::emit(logic::state::EventType::STATUS, ctx.defender_slot_id,
+                                       static_cast<uint16_t>(S));
+            mark_speed_if_paralyzed<S>(ctx);
 
             // Set sleep turns for sleep
             if constexpr (S == logic::state::Status::SLEEP) {
-                ctx.defender_mon->sleep_turns = 3;  // TODO: Random 1-3 in Gen III
+                // TODO: Random 1-3 in Gen III
+                logic::state::assign(ctx.defender_mon()->sleep_turns, 3);
             }
         }
     }
@@ -71,21 +134,32 @@ using TryApplySleep = TryApplyStatus<logic::state::Status::SLEEP>;
 // ============================================================================
 
 template <logic::state::Status S>
-struct ApplyStatusMove : CommandMeta<Domain::Mon, Genesis, EffectApplied> {
+struct ApplyStatusMove : CommandMeta<STATUS_DOMAINS<S>, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
         // Can't status if already statused
-        if (ctx.defender_mon->has_status()) {
+        if (ctx.defender_mon()->has_status()) {
+            ctx.result.failed = true;
+            return;
+        }
+
+        if (type_immune<S>(ctx)) {
             ctx.result.failed = true;
             return;
         }
 
-        // TODO: Type and ability immunities
+        if (dsl::ability::status_blocked(ctx, ctx.defender_slot_id, S)) {
+            ctx.result.failed = true;
+            return;
+        }
 
-        ctx.defender_mon->status = S;
+        logic::state::assign(ctx.defender_mon()->status, S);
         ctx.result.status_applied = true;
+        logic::state::events::emit(logic::state::EventType::STATUS, ctx.defender_slot_id,
+                                   static_cast<uint16_t>(S));
+        mark_speed_if_paralyzed<S>(ctx);
 
         if constexpr (S == logic::state::Status::SLEEP) {
-            ctx.defender_mon->sleep_turns = 3;
+            logic::state::assign(ctx.defender_mon()->sleep_turns, 3);
         }
     }
 };
@@ -105,7 +179,7 @@ using ApplyBurnMove = ApplyStatusMove<logic::state::Status::BURN>;
 // ============================================================================
 
 template <logic::state::Status S, uint8_t Chance>
-struct TryApplyStatusChance : CommandMeta<Domain::Mon, DamageApplied, EffectApplied> {
+struct TryApplyStatusChance : CommandMeta<STATUS_DOMAINS<S>, DamageApplied, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) { TryApplyStatus<S>::execute(ctx, Chance); }
 };
 
@@ -128,13 +202,13 @@ struct TryApplyFlinch : CommandMeta<Domain::Slot, DamageApplied, EffectApplied>
         }
 
         // Can only flinch if target hasn't moved yet this turn
-        if (ctx.defender_slot->moved_this_turn) {
+        if (ctx.defender_slot()->moved_this_turn) {
             return;
         }
 
         // TODO: Roll for chance (Sky Attack = 30%)
         // For smoke testing, always apply
-        ctx.defender_slot->set(logic::state::volatile_flags::FLINCHED);
+        ctx.defender_slot()->set(logic::state::volatile_flags::FLINCHED);
     }
 };
 
@@ -152,11 +226,13 @@ struct TryApplyFlinch : CommandMeta<Domain::Slot, DamageApplied, EffectApplied>
 // ============================================================================
 
 struct BeginCharge : CommandMeta<Domain::Slot, Genesis, FaintChecked> {
+    static constexpr EffectTraits traits{.multi_turn = true};
+
     static void execute(dsl::BattleContext& ctx) {
         // Store the move being charged
         // In a real impl, this would be the move ID from ctx.move
-        ctx.attacker_slot->charging_move = 1;  // Placeholder non-zero value
-        ctx.attacker_slot->set(logic::state::volatile_flags::CHARGING);
+        logic::state::assign(ctx.attacker_slot()->charging_move, 1);  // Placeholder non-zero value
+        ctx.attacker_slot()->set(logic::state::volatile_flags::CHARGING);
 
         // For semi-invulnerable moves (Fly, Dig, Dive), also set SEMI_INVULN
         // Sky Attack doesn't grant semi-invulnerability in Gen III
@@ -165,8 +241,8 @@ struct BeginCharge : CommandMeta<Domain::Slot, Genesis, FaintChecked> {
 
 struct ClearCharge : CommandMeta<Domain::Slot, Genesis, AccuracyResolved> {
     static void execute(dsl::BattleContext& ctx) {
-        ctx.attacker_slot->charging_move = 0;
-        ctx.attacker_slot->clear(logic::state::volatile_flags::CHARGING);
+        logic::state::assign(ctx.attacker_slot()->charging_move, 0);
+        ctx.attacker_slot()->clear(logic::state::volatile_flags::CHARGING);
     }
 };
 
@@ -185,8 +261,8 @@ struct ClearCharge : CommandMeta<Domain::Slot, Genesis, AccuracyResolved> {
 
 struct SetMagicCoat : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
-        if (ctx.attacker_slot) {
-            ctx.attacker_slot->bounce_move = true;
+        if (ctx.attacker_slot()) {
+            logic::state::assign(ctx.attacker_slot()->bounce_move, true);
         }
     }
 };
@@ -211,9 +287,9 @@ struct ApplyPerishSong : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
     static void execute(dsl::BattleContext& ctx) {
         bool any_affected = false;
 
-        for (uint8_t i = 0; i < ctx.active_slot_count; ++i) {
-            auto* slot = ctx.slots[i];
-            auto* mon = ctx.mons[i];
+        for (uint8_t i = 0; i < dsl::MAX_BATTLE_SLOTS; ++i) {
+            auto* slot = ctx.slot(i);
+            auto* mon = ctx.mon(i);
 
             if (!slot || !mon)
                 continue;
@@ -230,7 +306,8 @@ struct ApplyPerishSong : CommandMeta<Domain::Slot, Genesis, EffectApplied> {
 
             // Apply Perish Song
             slot->set(logic::state::volatile_flags::PERISH_SONG);
-            slot->perish_count = 3;
+            // Count 3 shown now, fainting at the end of the fourth turn
+            ctx.field()->schedule(slot->perish_expiry, 4);
             any_affected = true;
         }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../dsl/ability/dispatch.hpp"
 #include "base.hpp"
 
 namespace logic::ops {
@@ -17,12 +18,63 @@ namespace logic::ops {
 // ============================================================================
 
 struct RequestBatonPass : CommandMeta<Domain::Slot, Genesis, Terminus> {
+    static constexpr EffectTraits traits{.can_switch = true};
+
     static void execute(dsl::BattleContext& ctx) {
         ctx.result.baton_pass = true;
         ctx.result.switch_out = true;
     }
 };
 
+// Roar / Whirlwind: drag a random living benched member of the defender's
+// party into battle. Fails against an Ingrained or Suction Cups defender and
+// when the defender has no one to switch to (always, in 1v1). Suction Cups
+// is checked by name: the ability event mask has no bit left for a
+// forced-switch event.
+struct RequestForceSwitch : CommandMeta<Domain::Slot | Domain::Mon, AccuracyResolved, Terminus> {
+    static constexpr EffectTraits traits{.draws_rng = true, .can_switch = true};
+
+    static void execute(dsl::BattleContext& ctx) {
+        if (ctx.result.missed) {
+            return;
+        }
+
+        const uint8_t target = ctx.defender_slot_id;
+        if (ctx.defender_slot()->has(logic::state::volatile_flags::INGRAINED)) {
+            ctx.result.failed = true;
+            return;
+        }
+        if (ctx.state->ability(target) == types::enums::Ability::SUCTION_CUPS) {
+            dsl::ability::detail::announce(target, ctx.state->ability(target));
+            ctx.result.failed = true;
+            return;
+        }
+
+        const dsl::Party& party = ctx.state->party_of(target);
+        const uint8_t active = ctx.state->slots[target].party_index;
+        uint8_t benched = 0;
+        for (uint8_t member = 0; member < party.size; ++member) {
+            benched += member != active && party.mons[member].is_alive();
+        }
+        if (benched == 0) {
+            ctx.result.failed = true;
+            return;
+        }
+
+        auto pick = static_cast<uint8_t>(
+            ctx.rng->random(benched, util::random::DrawSite::FORCE_SWITCH));
+        for (uint8_t member = 0; member < party.size; ++member) {
+            if (member == active || !party.mons[member].is_alive())
+                continue;
+            if (pick-- == 0) {
+                ctx.result.force_switch = true;
+                ctx.result.forced_member = member;
+                return;
+            }
+        }
+    }
+};
+
 // ============================================================================
 //                       PURSUIT INTERCEPT REGISTRATION
 // ============================================================================
@@ -68,6 +68,19 @@ EFFECT(BatonPass, StatChange) {
     END;
 }
 
+// ----------------------------------------------------------------------------
+// ROAR - Force the target out (Roar, Whirlwind)
+// ----------------------------------------------------------------------------
+// Priority -6, so it lands after the target's action. The command picks the
+// member to drag in; the engine performs the switch (no Baton Pass carry).
+
+EFFECT(Roar, Pure) {
+    BEGIN(ctx)
+    RUN(CheckAccuracy)
+    RUN(RequestForceSwitch)
+    END;
+}
+
 // ----------------------------------------------------------------------------
 // PURSUIT - Damaging move with switch interception hook
 // ----------------------------------------------------------------------------
@@ -89,8 +102,8 @@ EFFECT(Pursuit, Pure | Scratch) {
 // PERISH_SONG - Affects all battlers with 3-turn KO countdown
 // ----------------------------------------------------------------------------
 // All Pokemon on the field (including the user) receive Perish Song status.
-// At the end of each turn, perish_count decrements. When it reaches 0,
-// the Pokemon faints.
+// The count drops at the end of each turn and the Pokemon faints at the
+// end of the turn it reaches 0 (perish_expiry).
 //
 // This effect validates the all-battler iteration pattern using the
 // slots[] array in BattleContext.
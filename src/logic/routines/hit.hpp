@@ -30,6 +30,46 @@ EFFECT(Hit, Pure | Scratch) {
     END;
 }
 
+// ----------------------------------------------------------------------------
+// MULTI_HIT - 2 to 5 hits after one accuracy check
+// ----------------------------------------------------------------------------
+// 2 or 3 hits with 3/8 each, 4 or 5 with 1/8 each (Bullet Seed, Arm Thrust,
+// Bone Rush, Fury Attack, ...); the count is drawn once and the move stops
+// at a KO (see logic/ops/multi_hit.hpp).
+
+EFFECT(MultiHit, Pure) {
+    BEGIN(ctx)
+    RUN(CheckAccuracy)
+    RUN(MultiHitDamage)
+    RUN(CheckFaint)
+    END;
+}
+
+// ----------------------------------------------------------------------------
+// DOUBLE_HIT - Two hits after one accuracy check (Double Kick, Bonemerang)
+// ----------------------------------------------------------------------------
+
+EFFECT(DoubleHit, Pure) {
+    BEGIN(ctx)
+    RUN(CheckAccuracy)
+    RUN(DoubleHitDamage)
+    RUN(CheckFaint)
+    END;
+}
+
+// ----------------------------------------------------------------------------
+// TRIPLE_KICK - Up to three hits at 1x, 2x and 3x power
+// ----------------------------------------------------------------------------
+// Hits after the first check accuracy again; the first miss ends the move.
+
+EFFECT(TripleKick, Pure) {
+    BEGIN(ctx)
+    RUN(CheckAccuracy)
+    RUN(TripleKickDamage)
+    RUN(CheckFaint)
+    END;
+}
+
 // ----------------------------------------------------------------------------
 // ABSORB - Damaging move that heals the attacker by 50% of damage dealt
 // ----------------------------------------------------------------------------
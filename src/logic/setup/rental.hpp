@@ -1,13 +1,20 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
 
 #include "../calc/stats.hpp"
 #include "../state/context.hpp"
 #include "../state/mon.hpp"
 #include "../state/slot.hpp"
+#include "data/move.hpp"
 #include "data/rental.hpp"
+#include "data/rental_packed.hpp"
 #include "data/species.hpp"
+#include "dsl/ability/event_mask.hpp"
+#include "dsl/item/event_mask.hpp"
 #include "types/models/rental.hpp"
 #include "types/models/species.hpp"
 
@@ -107,7 +114,7 @@ constexpr calc::EVSpread unpack_ev_spread(types::EvSpread spread) {
  *
  * @return Pointer to the species data
  */
-inline const types::Species* lookup_species(types::enums::Species species) {
+constexpr const types::Species* lookup_species(types::enums::Species species) {
     // The species table is indexed directly by species enum value
     auto index = static_cast<uint16_t>(species);
     assert(index < sizeof(data::g_SPECIES_TABLE) / sizeof(data::g_SPECIES_TABLE[0]) &&
@@ -115,6 +122,87 @@ inline const types::Species* lookup_species(types::enums::Species species) {
     return &data::g_SPECIES_TABLE[index];
 }
 
+/**
+ * @brief Calculate a rental's stat block from scratch.
+ *
+ * @param rental The rental Pokemon data
+ * @param level Battle level
+ *
+ * @return Stats with perfect IVs and the rental's nature and EV spread
+ */
+constexpr calc::StatBlock compute_rental_stats(const types::Rental& rental, uint8_t level) {
+    const types::Species* species = lookup_species(rental.species);
+
+    calc::BaseStats base{};
+    for (int i = 0; i < 6; ++i) {
+        base.stats[i] = species->stats[i];
+    }
+
+    // Shedinja always has 1 HP
+    const bool is_shedinja = (rental.species == types::enums::Species::SHEDINJA);
+
+    return calc::calc_stats(base, calc::IVSpread::perfect(), unpack_ev_spread(rental.ev_spread),
+                            level, rental.nature, is_shedinja);
+}
+
+// ============================================================================
+//                         PRECOMPUTED RENTAL STATS
+// ============================================================================
+//
+// Every input to compute_rental_stats() is fixed for the rentals in
+// g_RENTAL_SETS, so their stat blocks for both Factory levels are built at
+// compile time. Battle start becomes a table copy instead of twelve
+// calc_stat calls (each a chain of 32-bit multiplies/divides, which are
+// software routines on the eZ80).
+//
+// g_RENTAL_STATS[i] holds the stats for g_RENTAL_SETS[i]. Table rentals are
+// set up by index (setup_rental(size_t)); a Rental passed by value is
+// treated as custom and calculated.
+//
+// ============================================================================
+
+constexpr size_t RENTAL_COUNT = data::RENTAL_SET_COUNT;
+
+struct RentalStats {
+    calc::StatBlock level_50;
+    calc::StatBlock level_100;
+};
+
+// Each entry is its own constant evaluation so the table stays well within
+// the compiler's constexpr step limits
+template <size_t I>
+inline constexpr RentalStats RENTAL_STATS_ENTRY = {
+    compute_rental_stats(data::g_RENTAL_SETS[I], calc::FACTORY_LEVEL_50),
+    compute_rental_stats(data::g_RENTAL_SETS[I], calc::FACTORY_LEVEL_100),
+};
+
+template <typename Indices>
+struct RentalStatsTable;
+
+template <size_t... Is>
+struct RentalStatsTable<std::index_sequence<Is...>> {
+    static constexpr RentalStats entries[] = {RENTAL_STATS_ENTRY<Is>...};
+};
+
+inline constexpr const RentalStats (&g_RENTAL_STATS)[RENTAL_COUNT] =
+    RentalStatsTable<std::make_index_sequence<RENTAL_COUNT>>::entries;
+
+/**
+ * @brief Stats for the rental at `index` in g_RENTAL_SETS.
+ *
+ * Level 50 and 100 read g_RENTAL_STATS; other levels are calculated.
+ *
+ * @pre index < RENTAL_COUNT
+ */
+inline calc::StatBlock rental_stats(size_t index, uint8_t level) {
+    assert(index < RENTAL_COUNT && "rental index out of bounds");
+    if (level == calc::FACTORY_LEVEL_50)
+        return g_RENTAL_STATS[index].level_50;
+    if (level == calc::FACTORY_LEVEL_100)
+        return g_RENTAL_STATS[index].level_100;
+    return compute_rental_stats(data::rental(index), level);
+}
+
 /**
  * @brief Result of setting up a rental Pokemon for battle.
  */
@@ -131,45 +219,36 @@ struct RentalSetup {
  * @brief Set up a rental Pokemon for battle.
  *
  * Converts Rental data into battle-ready state structures with
- * calculated stats and initialized state.
+ * initialized state.
  *
  * @param rental The rental Pokemon data
+ * @param stats The rental's stats at `level`
  * @param level Battle level (50 for Level 50, 100 for Open Level)
  *
  * @return RentalSetup containing mon, slot, and active mon data
  */
-inline RentalSetup setup_rental(const types::Rental& rental, uint8_t level = 50) {
+inline RentalSetup setup_rental(const types::Rental& rental, const calc::StatBlock& stats,
+                                uint8_t level) {
     RentalSetup result{};
 
-    // Look up species for base stats and types
+    // Look up species for types and ability
     const types::Species* species = lookup_species(rental.species);
     assert(species && "species lookup failed");
 
-    // Build base stats struct from species data
-    calc::BaseStats base{};
-    for (int i = 0; i < 6; ++i) {
-        base.stats[i] = species->stats[i];
-    }
-
-    // Perfect IVs for Battle Factory
-    calc::IVSpread ivs = calc::IVSpread::perfect();
-
-    // Unpack EV spread
-    calc::EVSpread evs = unpack_ev_spread(rental.ev_spread);
-
-    // Check for Shedinja (always 1 HP)
-    bool is_shedinja = (rental.species == types::enums::Species::SHEDINJA);
-
-    // Calculate stats
-    calc::StatBlock stats = calc::calc_stats(base, ivs, evs, level, rental.nature, is_shedinja);
-
     // Initialize MonState
     result.mon.max_hp = stats.hp;
     result.mon.current_hp = stats.hp;
     result.mon.status = logic::state::Status::NONE;
+    for (size_t i = 0; i < 4; ++i) {
+        const types::enums::Move move = rental.moves[i];
+        result.mon.pp[i] =
+            move == types::enums::Move::NONE ? 0 : data::g_MOVE_COLD[static_cast<size_t>(move)].pp;
+    }
 
     // Initialize SlotState (all stages at neutral)
     result.slot = logic::state::SlotState{};  // Default constructor sets neutral stages
+    result.slot.held_item = rental.held_item;
+    result.slot.item_events = dsl::item::item_event_mask(rental.held_item);
 
     // Initialize ActiveMon for damage calculation
     result.active.level = level;
@@ -178,8 +257,7 @@ inline RentalSetup setup_rental(const types::Rental& rental, uint8_t level = 50)
     result.active.sp_attack = stats.sp_attack;
     result.active.sp_defense = stats.sp_defense;
     result.active.speed = stats.speed;
-    result.active.type1 = species->type1;
-    result.active.type2 = species->type2;
+    result.active.set_types(species->type1, species->type2);
 
     // Determine ability based on slot
     result.ability = (rental.ability_slot == 0) ? species->ability1 : species->ability2;
@@ -192,35 +270,54 @@ inline RentalSetup setup_rental(const types::Rental& rental, uint8_t level = 50)
 }
 
 /**
- * @brief Set up two rentals for a battle and populate a BattleContext.
+ * @brief Set up a custom rental (stats calculated).
+ */
+inline RentalSetup setup_rental(const types::Rental& rental, uint8_t level = 50) {
+    return setup_rental(rental, compute_rental_stats(rental, level), level);
+}
+
+/**
+ * @brief Set up the rental at `index` in g_RENTAL_SETS (stats precomputed).
+ *
+ * @pre index < RENTAL_COUNT
+ */
+inline RentalSetup setup_rental(size_t index, uint8_t level = 50) {
+    return setup_rental(data::rental(index), rental_stats(index, level), level);
+}
+
+/**
+ * @brief Set up two rentals for a battle and point a BattleContext at them.
+ *
+ * The attacker takes slot 0 and the defender slot 1 of `state`; field and
+ * side state are left as they are.
  *
  * @param ctx The battle context to populate
+ * @param state Battle state to set the two mons up in (caller manages lifetime)
  * @param attacker_rental Attacker's rental data
  * @param defender_rental Defender's rental data
- * @param attacker_setup Output: attacker's setup data (caller manages lifetime)
- * @param defender_setup Output: defender's setup data (caller manages lifetime)
  * @param level Battle level (default 50)
  */
-inline void setup_battle(dsl::BattleContext& ctx, const types::Rental& attacker_rental,
-                         const types::Rental& defender_rental, RentalSetup& attacker_setup,
-                         RentalSetup& defender_setup, uint8_t level = 50) {
-    attacker_setup = setup_rental(attacker_rental, level);
-    defender_setup = setup_rental(defender_rental, level);
-
-    // Wire up context pointers
-    ctx.attacker_mon = &attacker_setup.mon;
-    ctx.defender_mon = &defender_setup.mon;
-    ctx.attacker_slot = &attacker_setup.slot;
-    ctx.defender_slot = &defender_setup.slot;
-    ctx.attacker_active = &attacker_setup.active;
-    ctx.defender_active = &defender_setup.active;
-
-    // Set up slots array for iteration
-    ctx.slots[0] = &attacker_setup.slot;
-    ctx.slots[1] = &defender_setup.slot;
-    ctx.mons[0] = &attacker_setup.mon;
-    ctx.mons[1] = &defender_setup.mon;
-    ctx.active_slot_count = 2;
+inline void setup_battle(dsl::BattleContext& ctx, dsl::BattleState& state,
+                         const types::Rental& attacker_rental,
+                         const types::Rental& defender_rental, uint8_t level = 50) {
+    const RentalSetup attacker_setup = setup_rental(attacker_rental, level);
+    const RentalSetup defender_setup = setup_rental(defender_rental, level);
+
+    const RentalSetup* setups[] = {&attacker_setup, &defender_setup};
+    const types::Rental* rentals[] = {&attacker_rental, &defender_rental};
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        dsl::Party& party = state.parties[side];
+        party.mons[0] = setups[side]->mon;
+        party.active[0] = setups[side]->active;
+        party.rentals[0] = *rentals[side];
+        party.abilities[0] = setups[side]->ability;
+        party.ability_events[0] = dsl::ability::ability_event_mask(setups[side]->ability);
+        party.size = 1;
+        state.slots[side] = setups[side]->slot;
+    }
+
+    ctx.state = &state;
+    ctx.set_battlers(0, 1);
 }
 
 }  // namespace logic::setup
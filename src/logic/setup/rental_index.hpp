@@ -0,0 +1,347 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "data/move.hpp"
+#include "data/rental.hpp"
+#include "data/species.hpp"
+#include "rental.hpp"
+#include "types/enums/ability.hpp"
+#include "types/enums/item.hpp"
+#include "types/enums/move.hpp"
+#include "types/enums/species.hpp"
+#include "types/enums/type.hpp"
+
+namespace logic::setup {
+
+// ============================================================================
+//                         RENTAL INVERTED INDEXES
+// ============================================================================
+//
+// Which rentals carry a move, hold an item, have a type, ability or species,
+// answered without scanning g_RENTAL_SETS (or joining g_SPECIES_TABLE per
+// row). Each index is built at compile time as a posting list per key:
+// rental indices in ascending order, packed back to back (CSR layout), so a
+// lookup is two offset reads and a query like "Water/Ground" is a merge of
+// two sorted lists. Keys without rentals have empty lists.
+//
+//   index        key of a rental                  postings
+//   move         each distinct non-NONE move      ~4 per rental
+//   item         held item (NONE not indexed)     1
+//   type         species type1 and type2          1-2
+//   ability      species ability by ability_slot  1
+//   species      species                          1
+//
+// For repeated narrowing (opponent-set inference), RentalSet is the same
+// information as an 882-bit bitmap: build one from a posting list and AND
+// it with the next.
+//
+// ============================================================================
+
+inline constexpr size_t MOVE_KEY_COUNT = data::MOVE_COUNT;
+inline constexpr size_t ITEM_KEY_COUNT = static_cast<size_t>(types::enums::Item::WHITE_HERB) + 1;
+inline constexpr size_t TYPE_KEY_COUNT = static_cast<size_t>(types::enums::Type::DARK) + 1;
+inline constexpr size_t ABILITY_KEY_COUNT =
+    static_cast<size_t>(types::enums::Ability::SHADOW_TAG) + 1;
+inline constexpr size_t SPECIES_KEY_COUNT = std::size(data::g_SPECIES_TABLE);
+
+static_assert(RENTAL_COUNT <= UINT16_MAX, "posting lists hold 16-bit rental indices");
+
+/// Sorted rental indices of one key
+struct PostingList {
+    const uint16_t* first{nullptr};
+    uint16_t count{0};
+
+    [[nodiscard]] constexpr const uint16_t* begin() const { return first; }
+    [[nodiscard]] constexpr const uint16_t* end() const { return first + count; }
+    [[nodiscard]] constexpr uint16_t size() const { return count; }
+    [[nodiscard]] constexpr bool empty() const { return count == 0; }
+    [[nodiscard]] constexpr uint16_t operator[](uint16_t i) const { return first[i]; }
+
+    /// Binary search for `rental`
+    [[nodiscard]] constexpr bool contains(uint16_t rental) const {
+        uint16_t lo = 0;
+        uint16_t hi = count;
+        while (lo < hi) {
+            const auto mid = static_cast<uint16_t>((lo + hi) / 2);
+            if (first[mid] < rental) {
+                lo = static_cast<uint16_t>(mid + 1);
+            } else {
+                hi = mid;
+            }
+        }
+        return lo < count && first[lo] == rental;
+    }
+};
+
+/// Posting lists of `Keys` keys with `Total` postings overall
+template <size_t Keys, size_t Total>
+struct PostingIndex {
+    uint16_t offsets[Keys + 1]{};
+    uint16_t postings[Total > 0 ? Total : 1]{};
+
+    [[nodiscard]] constexpr PostingList operator[](size_t key) const {
+        if (key >= Keys)
+            return {};
+        return {postings + offsets[key], static_cast<uint16_t>(offsets[key + 1] - offsets[key])};
+    }
+};
+
+// ============================================================================
+//                           INDEX CONSTRUCTION
+// ============================================================================
+
+/// Keys of one rental (at most 4, distinct)
+struct RentalKeys {
+    uint16_t keys[4]{};
+    uint8_t count{0};
+
+    constexpr void add(uint16_t key) {
+        for (uint8_t i = 0; i < count; ++i) {
+            if (keys[i] == key)
+                return;
+        }
+        keys[count++] = key;
+    }
+};
+
+constexpr RentalKeys move_keys(const types::Rental& rental) {
+    RentalKeys out;
+    for (const types::enums::Move move : rental.moves) {
+        if (move != types::enums::Move::NONE)
+            out.add(static_cast<uint16_t>(move));
+    }
+    return out;
+}
+
+constexpr RentalKeys item_keys(const types::Rental& rental) {
+    RentalKeys out;
+    if (rental.held_item != types::enums::Item::NONE)
+        out.add(static_cast<uint16_t>(rental.held_item));
+    return out;
+}
+
+constexpr RentalKeys type_keys(const types::Rental& rental) {
+    const types::Species* species = lookup_species(rental.species);
+    RentalKeys out;
+    if (species->type1 != types::enums::Type::NONE)
+        out.add(static_cast<uint16_t>(species->type1));
+    if (species->type2 != types::enums::Type::NONE)
+        out.add(static_cast<uint16_t>(species->type2));
+    return out;
+}
+
+constexpr RentalKeys ability_keys(const types::Rental& rental) {
+    const types::Species* species = lookup_species(rental.species);
+    RentalKeys out;
+    out.add(static_cast<uint16_t>(rental.ability_slot == 0 ? species->ability1
+                                                           : species->ability2));
+    return out;
+}
+
+constexpr RentalKeys species_keys(const types::Rental& rental) {
+    RentalKeys out;
+    out.add(static_cast<uint16_t>(rental.species));
+    return out;
+}
+
+/// Number of postings an index over `keys_of` holds
+constexpr size_t posting_total(RentalKeys (*keys_of)(const types::Rental&)) {
+    size_t total = 0;
+    for (const types::Rental& rental : data::g_RENTAL_SETS) {
+        total += keys_of(rental).count;
+    }
+    return total;
+}
+
+/**
+ * @brief Counting sort of (key, rental) pairs into per-key posting lists.
+ *
+ * Rentals are visited in index order, so every list comes out sorted.
+ */
+template <size_t Keys, size_t Total>
+constexpr PostingIndex<Keys, Total> build_postings(RentalKeys (*keys_of)(const types::Rental&)) {
+    PostingIndex<Keys, Total> index{};
+    for (const types::Rental& rental : data::g_RENTAL_SETS) {
+        const RentalKeys keys = keys_of(rental);
+        for (uint8_t k = 0; k < keys.count; ++k) {
+            ++index.offsets[keys.keys[k] + 1];
+        }
+    }
+    for (size_t key = 0; key < Keys; ++key) {
+        index.offsets[key + 1] = static_cast<uint16_t>(index.offsets[key + 1] + index.offsets[key]);
+    }
+
+    uint16_t cursor[Keys]{};
+    for (size_t key = 0; key < Keys; ++key) {
+        cursor[key] = index.offsets[key];
+    }
+    for (size_t r = 0; r < RENTAL_COUNT; ++r) {
+        const RentalKeys keys = keys_of(data::g_RENTAL_SETS[r]);
+        for (uint8_t k = 0; k < keys.count; ++k) {
+            index.postings[cursor[keys.keys[k]]++] = static_cast<uint16_t>(r);
+        }
+    }
+    return index;
+}
+
+inline constexpr auto g_MOVE_POSTINGS =
+    build_postings<MOVE_KEY_COUNT, posting_total(move_keys)>(move_keys);
+inline constexpr auto g_ITEM_POSTINGS =
+    build_postings<ITEM_KEY_COUNT, posting_total(item_keys)>(item_keys);
+inline constexpr auto g_TYPE_POSTINGS =
+    build_postings<TYPE_KEY_COUNT, posting_total(type_keys)>(type_keys);
+inline constexpr auto g_ABILITY_POSTINGS =
+    build_postings<ABILITY_KEY_COUNT, posting_total(ability_keys)>(ability_keys);
+inline constexpr auto g_SPECIES_POSTINGS =
+    build_postings<SPECIES_KEY_COUNT, posting_total(species_keys)>(species_keys);
+
+// ============================================================================
+//                              QUERIES
+// ============================================================================
+
+constexpr PostingList rentals_with_move(types::enums::Move move) {
+    return g_MOVE_POSTINGS[static_cast<size_t>(move)];
+}
+
+constexpr PostingList rentals_with_item(types::enums::Item item) {
+    return g_ITEM_POSTINGS[static_cast<size_t>(item)];
+}
+
+constexpr PostingList rentals_with_type(types::enums::Type type) {
+    return g_TYPE_POSTINGS[static_cast<size_t>(type)];
+}
+
+constexpr PostingList rentals_with_ability(types::enums::Ability ability) {
+    return g_ABILITY_POSTINGS[static_cast<size_t>(ability)];
+}
+
+constexpr PostingList rentals_of_species(types::enums::Species species) {
+    return g_SPECIES_POSTINGS[static_cast<size_t>(species)];
+}
+
+/**
+ * @brief Rentals in both lists (linear merge).
+ *
+ * @param out At least min(a.size(), b.size()) entries
+ *
+ * @return Number of rentals written, in ascending order
+ */
+constexpr uint16_t intersect(PostingList a, PostingList b, uint16_t* out) {
+    uint16_t i = 0;
+    uint16_t j = 0;
+    uint16_t count = 0;
+    while (i < a.count && j < b.count) {
+        if (a.first[i] < b.first[j]) {
+            ++i;
+        } else if (b.first[j] < a.first[i]) {
+            ++j;
+        } else {
+            out[count++] = a.first[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+//                              RENTAL SET
+// ============================================================================
+
+/// Bitmap over g_RENTAL_SETS (bit r = rental r)
+class RentalSet {
+   public:
+    static constexpr size_t WORD_COUNT = (RENTAL_COUNT + 31) / 32;
+
+    /// Every rental
+    static constexpr RentalSet all() {
+        RentalSet set;
+        for (size_t w = 0; w < WORD_COUNT; ++w) {
+            set.words_[w] = UINT32_MAX;
+        }
+        if (RENTAL_COUNT % 32 != 0)
+            set.words_[WORD_COUNT - 1] = (uint32_t{1} << (RENTAL_COUNT % 32)) - 1;
+        return set;
+    }
+
+    static constexpr RentalSet of(PostingList list) {
+        RentalSet set;
+        for (const uint16_t rental : list) {
+            set.insert(rental);
+        }
+        return set;
+    }
+
+    constexpr void insert(uint16_t rental) { words_[rental / 32] |= uint32_t{1} << (rental % 32); }
+    constexpr void erase(uint16_t rental) {
+        words_[rental / 32] &= ~(uint32_t{1} << (rental % 32));
+    }
+
+    [[nodiscard]] constexpr bool contains(uint16_t rental) const {
+        return (words_[rental / 32] >> (rental % 32)) & 1u;
+    }
+
+    constexpr RentalSet& operator&=(const RentalSet& other) {
+        for (size_t w = 0; w < WORD_COUNT; ++w) {
+            words_[w] &= other.words_[w];
+        }
+        return *this;
+    }
+
+    constexpr RentalSet& operator|=(const RentalSet& other) {
+        for (size_t w = 0; w < WORD_COUNT; ++w) {
+            words_[w] |= other.words_[w];
+        }
+        return *this;
+    }
+
+    /// Keep only rentals in `list`
+    constexpr RentalSet& intersect(PostingList list) { return *this &= of(list); }
+
+    /// Drop every rental in `list`
+    constexpr RentalSet& subtract(PostingList list) {
+        for (const uint16_t rental : list) {
+            erase(rental);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr uint16_t count() const {
+        uint16_t total = 0;
+        for (size_t w = 0; w < WORD_COUNT; ++w) {
+            for (uint32_t bits = words_[w]; bits; bits &= bits - 1) {
+                ++total;
+            }
+        }
+        return total;
+    }
+
+    [[nodiscard]] constexpr bool empty() const {
+        for (size_t w = 0; w < WORD_COUNT; ++w) {
+            if (words_[w])
+                return false;
+        }
+        return true;
+    }
+
+    /// Smallest member >= `from`, or RENTAL_COUNT if none
+    [[nodiscard]] constexpr uint16_t next(uint16_t from = 0) const {
+        for (size_t r = from; r < RENTAL_COUNT; ++r) {
+            if ((r % 32) == 0 && words_[r / 32] == 0) {
+                r += 31;
+                continue;
+            }
+            if (contains(static_cast<uint16_t>(r)))
+                return static_cast<uint16_t>(r);
+        }
+        return static_cast<uint16_t>(RENTAL_COUNT);
+    }
+
+   private:
+    uint32_t words_[WORD_COUNT]{};
+};
+
+}  // namespace logic::setup
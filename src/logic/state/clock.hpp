@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+namespace logic::state {
+
+// ============================================================================
+//                              TURN CLOCK
+// ============================================================================
+//
+// Turns are numbered 1..255 and wrap (0 is a timer that is not running).
+// Battle timers store the turn they expire on (see field.hpp); these are
+// the clock's arithmetic, shared by the state structs and the hash, which
+// keys a timer by the turns it has left rather than by its expiry.
+//
+// ============================================================================
+
+/// Turn `turns` turns after `turn`, on the 1..255 turn clock
+constexpr uint8_t turn_after(uint8_t turn, uint8_t turns) {
+    return static_cast<uint8_t>((turn - 1u + turns) % 255u + 1u);
+}
+
+/// Turn ends before `expiry` as seen from `turn` (0 = it expires this turn)
+constexpr uint8_t turns_until(uint8_t turn, uint8_t expiry) {
+    return static_cast<uint8_t>((expiry + 255u - turn) % 255u);
+}
+
+/// Turn ends a timer has left including this one (0 = not running)
+constexpr uint8_t turns_left(uint8_t turn, uint8_t expiry) {
+    return expiry == 0 ? 0 : static_cast<uint8_t>(turns_until(turn, expiry) + 1);
+}
+
+static_assert(turn_after(255, 1) == 1 && turn_after(254, 3) == 2);
+static_assert(turns_until(254, turn_after(254, 3)) == 3 && turns_until(9, 9) == 0);
+static_assert(turns_left(9, 0) == 0 && turns_left(9, 9) == 1);
+
+}  // namespace logic::state
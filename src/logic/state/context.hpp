@@ -1,10 +1,18 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
+#include "../../types/enums/ability.hpp"
 #include "../../types/enums/type.hpp"
 #include "../../types/models/move.hpp"
+#include "../../types/models/rental.hpp"
+#include "../../util/platform.hpp"
+#include "../../util/random.hpp"
+#include "../calc/battler_traits.hpp"
+#include "../calc/type_effectiveness.hpp"
 #include "field.hpp"
 #include "mon.hpp"
 #include "side.hpp"
@@ -34,6 +42,10 @@ struct EffectResult {
     uint16_t effectiveness{0x100};  // 0x100 = neutral, 0x200 = 2x, etc.
     bool critical{false};
 
+    // Hits a multi-hit move made (0 for other moves, and when the outcome
+    // enumerator drew the move's total damage at once)
+    uint8_t hits{0};
+
     // Status
     bool status_applied{false};
 
@@ -43,6 +55,8 @@ struct EffectResult {
     // Switch-related requests (handled by battle engine)
     bool switch_out{false};
     bool baton_pass{false};
+    bool force_switch{false};  // Roar / Whirlwind: send in the defender's `forced_member`
+    uint8_t forced_member{0};
     bool pursuit_intercept{false};
     uint8_t pursuit_user_slot{0xFF};
 };
@@ -60,9 +74,34 @@ struct ActiveMon {
     uint16_t sp_defense{100};
     uint16_t speed{100};
 
-    // Types for STAB and effectiveness calculations
+    // Types for STAB and effectiveness calculations (change them with set_types())
     types::enums::Type type1{types::enums::Type::NONE};
     types::enums::Type type2{types::enums::Type::NONE};
+
+    // Effectiveness of each attacking type against type1/type2
+    logic::calc::DefenseRow defense_row{
+        logic::calc::make_defense_row(types::enums::Type::NONE, types::enums::Type::NONE)};
+
+    // Immunities type1/type2 give (logic::calc::traits)
+    logic::calc::TraitMask traits{0};
+
+    /// Set both types and rebuild defense_row and traits (switch-in, Transform, Conversion)
+    constexpr void set_types(types::enums::Type primary, types::enums::Type secondary) {
+        type1 = primary;
+        type2 = secondary;
+        defense_row = logic::calc::make_defense_row(primary, secondary);
+        traits = logic::calc::type_traits(primary, secondary);
+    }
+
+    /// Any of the traits in `mask`
+    [[nodiscard]] constexpr bool has_trait(logic::calc::TraitMask mask) const {
+        return (traits & mask) != 0;
+    }
+
+    /// Effectiveness of a move of `move_type` against this mon
+    constexpr types::calc::Effectiveness effectiveness_against(types::enums::Type move_type) const {
+        return defense_row[move_type];
+    }
 };
 
 // Damage calculation overrides (for moves that ignore normal stats)
@@ -72,57 +111,179 @@ struct DamageOverride {
     uint16_t defense{0};  // 0 = use active mon's defense stat
 };
 
-// Maximum slots in battle (2 for singles, 4 for doubles)
+// Slots in a BattleState: the engine plays singles (dsl::Singles::SLOTS)
 inline constexpr uint8_t MAX_BATTLE_SLOTS = 2;
 
-struct BattleContext {
-    // ========================================================================
-    //                              STATE DOMAINS
-    // ========================================================================
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+static_assert(logic::state::FIELD_BATTLERS == MAX_BATTLE_SLOTS);
+#endif
+
+// Sides in battle (player, opponent)
+inline constexpr uint8_t BATTLE_SIDE_COUNT = 2;
+
+// rental_indices[] entry of a rental that is not in data::g_RENTAL_SETS
+inline constexpr uint16_t CUSTOM_RENTAL_INDEX = UINT16_MAX;
+
+// Members per party (a Battle Factory team is 3)
+inline constexpr uint8_t MAX_PARTY_SIZE = logic::state::MAX_PARTY_SIZE;
 
+// ============================================================================
+//                                 PARTY
+// ============================================================================
+//
+// One side's team, indexed by party member. `mons` is the part that changes
+// during a battle (HP, status, PP); the rest is resolved when the party is
+// set up and never written again. The mon in play is the one its slot's
+// SlotState::party_index names, so a switch is an index change plus the
+// slot clear, never a copy of a member.
+//
+// ============================================================================
+
+struct Party {
+    // Domain 4: Mons (per-pokemon, persists through switches)
+    logic::state::MonState mons[MAX_PARTY_SIZE]{};
+
+    // Computed stats for damage calculation (set up with the mon)
+    ActiveMon active[MAX_PARTY_SIZE]{};
+
+    // Decoded rentals, their g_RENTAL_SETS indices (CUSTOM_RENTAL_INDEX for
+    // custom rentals) and resolved abilities
+    types::Rental rentals[MAX_PARTY_SIZE]{};
+    uint16_t rental_indices[MAX_PARTY_SIZE]{CUSTOM_RENTAL_INDEX, CUSTOM_RENTAL_INDEX,
+                                            CUSTOM_RENTAL_INDEX, CUSTOM_RENTAL_INDEX,
+                                            CUSTOM_RENTAL_INDEX, CUSTOM_RENTAL_INDEX};
+    types::enums::Ability abilities[MAX_PARTY_SIZE]{};
+
+    // Events each ability responds to (dsl::ability::ability_event_mask),
+    // resolved with the abilities: abilities never change mid-battle
+    uint8_t ability_events[MAX_PARTY_SIZE]{};
+
+    // Members set up (1-MAX_PARTY_SIZE); `mons` past it are unused
+    uint8_t size{0};
+
+    /// Some member other than `except` can still battle
+    [[nodiscard]] constexpr bool has_reserve(uint8_t except) const {
+        for (uint8_t i = 0; i < size; ++i) {
+            if (i != except && mons[i].is_alive())
+                return true;
+        }
+        return false;
+    }
+
+    /// No member can battle
+    [[nodiscard]] constexpr bool defeated() const { return !has_reserve(MAX_PARTY_SIZE); }
+};
+
+// ============================================================================
+//                             BATTLE STATE
+// ============================================================================
+//
+// Everything a battle session owns, in one flat block: the state domains
+// moves touch, the battle RNG, and the parties. Sides and parties are
+// indexed by side id, slots by slot id; the per-slot accessors below
+// resolve the slot's party member. BattleContext refers to it by a single
+// pointer plus attacker/defender ids.
+//
+// It holds no pointers, so a copy is a complete, relocatable save: search
+// snapshots, replay keyframes and batch lanes are plain struct copies, and
+// sizeof(BattleState) is the battle's whole RAM footprint. Cache-line
+// aligned on the host (BATTLEMON_CACHE_LINE) so copies never straddle an
+// extra line.
+//
+// ============================================================================
+
+struct alignas(BATTLEMON_CACHE_LINE) BattleState {
     // Domain 1: Field (global)
-    logic::state::FieldState* field{nullptr};
+    logic::state::FieldState field{};
 
     // Domain 2: Sides (per-team)
-    logic::state::SideState* attacker_side{nullptr};
-    logic::state::SideState* defender_side{nullptr};
+    logic::state::SideState sides[BATTLE_SIDE_COUNT]{};
 
     // Domain 3: Slots (per-position)
-    // Individual slot pointers (for current attacker/defender)
-    logic::state::SlotState* attacker_slot{nullptr};
-    logic::state::SlotState* defender_slot{nullptr};
+    logic::state::SlotState slots[MAX_BATTLE_SLOTS]{};
+
+    // Domain 4 and the rentals, per side
+    Party parties[BATTLE_SIDE_COUNT]{};
 
-    // All slots array (for iteration - PerishSong, Haze in doubles, etc.)
-    logic::state::SlotState* slots[MAX_BATTLE_SLOTS]{nullptr, nullptr};
-    logic::state::MonState* mons[MAX_BATTLE_SLOTS]{nullptr, nullptr};
-    uint8_t active_slot_count{MAX_BATTLE_SLOTS};
+    // Per-battle RNG stream (accuracy, crits, damage rolls, items)
+    util::random::Rng rng{};
 
-    // Domain 4: Mons (per-pokemon)
-    logic::state::MonState* attacker_mon{nullptr};
-    logic::state::MonState* defender_mon{nullptr};
+    uint8_t level{50};
 
     // ========================================================================
-    //                         ACTIVE MON INFO
+    //                        ACTIVE MON OF A SLOT
     // ========================================================================
 
-    // Computed stats for damage calculation (set by BattleEngine)
-    ActiveMon* attacker_active{nullptr};
-    ActiveMon* defender_active{nullptr};
+    /// Side a slot fights for (singles: slot i is side i)
+    static constexpr uint8_t side_of(uint8_t slot_id) { return slot_id; }
+
+    [[nodiscard]] constexpr Party& party_of(uint8_t slot_id) {
+        return parties[side_of(slot_id)];
+    }
+    [[nodiscard]] constexpr const Party& party_of(uint8_t slot_id) const {
+        return parties[side_of(slot_id)];
+    }
 
+    [[nodiscard]] constexpr logic::state::MonState& mon(uint8_t slot_id) {
+        return party_of(slot_id).mons[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr const logic::state::MonState& mon(uint8_t slot_id) const {
+        return party_of(slot_id).mons[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr const ActiveMon& active(uint8_t slot_id) const {
+        return party_of(slot_id).active[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr const types::Rental& rental(uint8_t slot_id) const {
+        return party_of(slot_id).rentals[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr uint16_t rental_index(uint8_t slot_id) const {
+        return party_of(slot_id).rental_indices[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr types::enums::Ability ability(uint8_t slot_id) const {
+        return party_of(slot_id).abilities[slots[slot_id].party_index];
+    }
+    [[nodiscard]] constexpr uint8_t ability_events(uint8_t slot_id) const {
+        return party_of(slot_id).ability_events[slots[slot_id].party_index];
+    }
+};
+
+// RAM ceiling of one battle (1152 bytes on the host with two 6-mon parties,
+// most of it the parties' fixed data): anything that grows the state past it
+// should be a conscious decision
+inline constexpr size_t BATTLE_STATE_BUDGET = 1280;
+
+static_assert(std::is_trivially_copyable_v<BattleState>, "battle state must be memcpy-able");
+static_assert(sizeof(BattleState) <= BATTLE_STATE_BUDGET, "battle state outgrew its RAM budget");
+
+struct BattleContext {
     // ========================================================================
-    //                             MOVE CONTEXT
+    //                              STATE DOMAINS
     // ========================================================================
 
-    const types::Move* move{nullptr};
+    // The battle's state; the accessors below resolve into it
+    BattleState* state{nullptr};
 
     // ========================================================================
     //                           BATTLER IDENTITY
     // ========================================================================
 
     uint8_t attacker_slot_id{0};
-    uint8_t defender_slot_id{0};
+    uint8_t defender_slot_id{1};
     uint8_t attacker_side_id{0};
-    uint8_t defender_side_id{0};
+    uint8_t defender_side_id{1};
+
+    // ========================================================================
+    //                             MOVE CONTEXT
+    // ========================================================================
+
+    const types::MoveHot* move{nullptr};
+
+    // ========================================================================
+    //                              RANDOMNESS
+    // ========================================================================
+
+    // Per-battle RNG (owned by BattleEngine; accuracy, crits, damage rolls, items)
+    util::random::Rng* rng{nullptr};
 
     // ========================================================================
     //                           EFFECT EXECUTION
@@ -134,13 +295,69 @@ struct BattleContext {
     // Loop iteration counter (for Triple Kick, etc.)
     uint8_t loop_iteration{0};
 
+    // ========================================================================
+    //                            STATE ACCESS
+    // ========================================================================
+    //
+    // Resolve a domain through `state` (which must be set). Pointers, so a
+    // slot or mon can be passed on to the ops that take them.
+
+    [[nodiscard]] logic::state::FieldState* field() const { return &state->field; }
+
+    [[nodiscard]] logic::state::SideState* attacker_side() const {
+        return &state->sides[attacker_side_id];
+    }
+    [[nodiscard]] logic::state::SideState* defender_side() const {
+        return &state->sides[defender_side_id];
+    }
+
+    [[nodiscard]] logic::state::SlotState* attacker_slot() const {
+        return &state->slots[attacker_slot_id];
+    }
+    [[nodiscard]] logic::state::SlotState* defender_slot() const {
+        return &state->slots[defender_slot_id];
+    }
+
+    [[nodiscard]] logic::state::MonState* attacker_mon() const {
+        return &state->mon(attacker_slot_id);
+    }
+    [[nodiscard]] logic::state::MonState* defender_mon() const {
+        return &state->mon(defender_slot_id);
+    }
+
+    [[nodiscard]] const ActiveMon* attacker_active() const {
+        return &state->active(attacker_slot_id);
+    }
+    [[nodiscard]] const ActiveMon* defender_active() const {
+        return &state->active(defender_slot_id);
+    }
+
+    [[nodiscard]] logic::state::SlotState* slot(uint8_t slot_id) const {
+        return &state->slots[slot_id];
+    }
+    [[nodiscard]] logic::state::MonState* mon(uint8_t slot_id) const {
+        return &state->mon(slot_id);
+    }
+
+    /**
+     * @brief Point the context at a new attacker and defender.
+     *
+     * Singles: each side has one slot, so side id == slot id.
+     */
+    constexpr void set_battlers(uint8_t attacker, uint8_t defender) {
+        attacker_slot_id = attacker;
+        defender_slot_id = defender;
+        attacker_side_id = attacker;
+        defender_side_id = defender;
+    }
+
     // ========================================================================
     //                              HELPERS
     // ========================================================================
 
     // Check if defender has a substitute up
-    [[nodiscard]] constexpr bool defender_has_substitute() const {
-        return defender_slot && defender_slot->substitute_hp > 0;
+    [[nodiscard]] bool defender_has_substitute() const {
+        return defender_slot()->substitute_hp > 0;
     }
 
     // Check if attacker is on player's side (side 0)
@@ -151,16 +368,16 @@ struct BattleContext {
         return override.power > 0 ? override.power : move->power;
     }
 
-    // Get attacker's active mon info (asserts non-null)
+    // Get attacker's active mon info (asserts the state is wired)
     [[nodiscard]] const ActiveMon& attacker() const {
-        assert(attacker_active && "attacker_active must be set for damage calc");
-        return *attacker_active;
+        assert(state && "state must be set for damage calc");
+        return state->active(attacker_slot_id);
     }
 
-    // Get defender's active mon info (asserts non-null)
+    // Get defender's active mon info (asserts the state is wired)
     [[nodiscard]] const ActiveMon& defender() const {
-        assert(defender_active && "defender_active must be set for damage calc");
-        return *defender_active;
+        assert(state && "state must be set for damage calc");
+        return state->active(defender_slot_id);
     }
 };
 
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../../util/platform.hpp"
+
+// Compile event emission out entirely (headless simulation) with
+// -DBATTLEMON_BATTLE_EVENTS=0
+#ifndef BATTLEMON_BATTLE_EVENTS
+#define BATTLEMON_BATTLE_EVENTS 1
+#endif
+
+namespace logic::state {
+
+struct MonState;
+struct SlotState;
+
+// ============================================================================
+//                             BATTLE EVENTS
+// ============================================================================
+//
+// What happened during a turn, in order, for the UI to animate:
+//
+//   battle.attach_events(&queue);
+//   battle.execute_turn(p1, p2);
+//   BattleEvent event;
+//   while (queue.pop(event)) {
+//       play(event);  // "Bulbasaur used Razor Leaf", "A critical hit!", ...
+//   }
+//
+// A turn still executes atomically; it leaves its events in the queue and
+// the UI steps through them one per animation. Events are 4 bytes and the
+// queue is a fixed ring, so recording allocates nothing. If the UI falls
+// more than a ring behind, the oldest events are dropped (and counted).
+//
+// Emit sites test a thread-local pointer that only execute_turn() of an
+// engine with a queue attached sets, so search copies of the engine and
+// batch simulation emit nothing. Headless builds compile the sites out.
+//
+// ============================================================================
+
+#ifndef BATTLEMON_EVENT_CAPACITY
+#define BATTLEMON_EVENT_CAPACITY 64
+#endif
+
+inline constexpr uint16_t EVENT_CAPACITY = BATTLEMON_EVENT_CAPACITY;
+static_assert((EVENT_CAPACITY & (EVENT_CAPACITY - 1)) == 0, "event capacity must be a power of 2");
+
+/// Slot of an event that concerns no battler
+inline constexpr uint8_t NO_EVENT_SLOT = 0xFF;
+
+enum class EventType : uint8_t {
+    MOVE_USED,  // value: types::enums::Move
+    MISS,       // slot: attacker
+    CRITICAL,   // slot: attacker
+    DAMAGE,     // value: HP lost
+    HEAL,       // value: HP restored
+    STATUS,     // value: Status inflicted (Status::NONE = cured)
+    ITEM,       // value: types::enums::Item that activated
+    ABILITY,    // value: types::enums::Ability that activated
+    SWITCH,     // value: party index of the member switched in
+    FAINT,
+    TURN_END,
+};
+
+struct BattleEvent {
+    EventType type;
+    uint8_t slot;    // Battler the event happened to (or NO_EVENT_SLOT)
+    uint16_t value;  // Per type, see EventType
+};
+static_assert(sizeof(BattleEvent) == 4);
+
+class EventQueue {
+   public:
+    static constexpr uint16_t CAPACITY = EVENT_CAPACITY;
+
+    /// Append an event; when full, the oldest event is dropped to make room
+    void push(const BattleEvent& event) {
+        if (size() == CAPACITY) {
+            ++head_;
+            ++dropped_;
+        }
+        events_[tail_++ & MASK] = event;
+    }
+
+    /**
+     * @brief Take the oldest event (the stepping API).
+     *
+     * @return false if the queue is empty
+     */
+    bool pop(BattleEvent& event) {
+        if (empty())
+            return false;
+        event = events_[head_++ & MASK];
+        return true;
+    }
+
+    /// Oldest event without taking it (@pre !empty())
+    [[nodiscard]] const BattleEvent& peek() const { return events_[head_ & MASK]; }
+
+    [[nodiscard]] uint16_t size() const { return static_cast<uint16_t>(tail_ - head_); }
+    [[nodiscard]] bool empty() const { return head_ == tail_; }
+
+    /// Events overwritten before they were popped
+    [[nodiscard]] uint32_t dropped() const { return dropped_; }
+
+    void clear() {
+        head_ = tail_ = 0;
+        dropped_ = 0;
+    }
+
+   private:
+    static constexpr uint16_t MASK = CAPACITY - 1;
+
+    BattleEvent events_[CAPACITY]{};
+    uint16_t head_{0};  // Free-running; indexed modulo CAPACITY
+    uint16_t tail_{0};
+    uint32_t dropped_{0};
+};
+
+// ============================================================================
+//                            ACTIVE EVENT HOOK
+// ============================================================================
+
+namespace events {
+
+/// Queue receiving events on this thread, and where the battle's state
+/// objects live (so a MonState write knows its slot)
+struct Sink {
+    EventQueue* queue;
+    const MonState* const* parties;  // Per slot: the mons of the slot's party
+    const SlotState* slots;
+    uint8_t count;
+};
+
+inline BATTLEMON_THREAD_LOCAL const Sink* g_active = nullptr;
+
+/// RAII: emit into `queue` for the lifetime of the scope (nullptr = don't)
+class Scope {
+   public:
+    Scope(EventQueue* queue, const MonState* const* parties, const SlotState* slots,
+          uint8_t count)
+        : sink_{queue, parties, slots, count}, previous_(g_active) {
+        g_active = queue ? &sink_ : nullptr;
+    }
+    ~Scope() { g_active = previous_; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Sink sink_;
+    const Sink* previous_;
+};
+
+// `object` is the mon in play in `slot` (SlotState::party_index), or the
+// slot itself. Templates, so the state types need only be complete where an
+// event is emitted.
+template <typename Mon = MonState, typename Slot = SlotState>
+inline bool in_slot(const Sink& sink, uint8_t slot, const MonState& object) {
+    const Slot* slots = sink.slots;
+    return &object == static_cast<const Mon*>(sink.parties[slot]) + slots[slot].party_index;
+}
+template <typename Slot = SlotState>
+inline bool in_slot(const Sink& sink, uint8_t slot, const SlotState& object) {
+    return &object == static_cast<const Slot*>(sink.slots) + slot;
+}
+
+/// Record an event for battler `slot`
+inline void emit([[maybe_unused]] EventType type, [[maybe_unused]] uint8_t slot,
+                 [[maybe_unused]] uint16_t value = 0) {
+#if BATTLEMON_BATTLE_EVENTS
+    if (const Sink* sink = g_active) {
+        sink->queue->push(BattleEvent{type, slot, value});
+    }
+#endif
+}
+
+/**
+ * @brief Record an event for the battler owning `object` (its MonState or
+ *        SlotState), for state methods that don't know their slot.
+ *
+ * Objects outside the active battle (a search's scratch state) emit nothing.
+ */
+template <typename Object>
+inline void emit_for([[maybe_unused]] EventType type, [[maybe_unused]] const Object& object,
+                     [[maybe_unused]] uint16_t value = 0) {
+#if BATTLEMON_BATTLE_EVENTS
+    if (const Sink* sink = g_active) {
+        for (uint8_t slot = 0; slot < sink->count; ++slot) {
+            if (in_slot(*sink, slot, object)) {
+                sink->queue->push(BattleEvent{type, slot, value});
+                return;
+            }
+        }
+    }
+#endif
+}
+
+}  // namespace events
+
+}  // namespace logic::state
@@ -2,6 +2,10 @@
 
 #include <cstdint>
 
+#include "../../util/features.hpp"
+#include "clock.hpp"
+#include "journal.hpp"
+
 namespace logic::state {
 
 // ============================================================================
@@ -16,6 +20,30 @@ namespace logic::state {
 //   - Weather (type and duration)
 //   - Future Sight / Doom Desire tracking
 //   - Wish tracking
+//   - Turn clock and the soonest timer expiry
+//
+// The delayed effects are BATTLEMON_FEATURE_DELAYED_EFFECTS and compile out
+// with it (util/features.hpp).
+// ============================================================================
+
+// ============================================================================
+//                              BATTLE TIMERS
+// ============================================================================
+//
+// Screens, weather, Future Sight, Wish and the slot timers (Wrap, Taunt,
+// Encore, Disable, Yawn, Perish Song) store the turn they expire on rather
+// than a countdown: nothing is written while they run, and the end of a
+// turn only has to ask whether this turn is one that something expires on.
+//
+// Turns are numbered 1..255 and wrap (0 is a timer that is not running;
+// clock.hpp has the arithmetic).
+// Every Gen III duration is a handful of turns, so a wrapped expiry is
+// never ambiguous. FieldState::next_expiry is the soonest running expiry;
+// on that turn the residual pass (dsl/residual.hpp) fires what expired and
+// rescans for the next one. A timer cleared early (a switch-out) can leave
+// next_expiry pointing at a turn where nothing expires, which costs one
+// rescan and nothing else.
+//
 // ============================================================================
 
 enum class Weather : uint8_t {
@@ -26,32 +54,66 @@ enum class Weather : uint8_t {
     HAIL,
 };
 
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+
+/// Battlers a per-battler field array covers, one per battle slot
+/// (checked against dsl::MAX_BATTLE_SLOTS in context.hpp)
+inline constexpr uint8_t FIELD_BATTLERS = 2;
+
 struct FutureSight {
-    uint8_t counter[4];   // Turns until attack lands (0 = inactive)
-    uint8_t attacker[4];  // Slot that used it
-    uint16_t damage[4];   // Pre-calculated damage
-    uint8_t move[4];      // Move ID (FUTURE_SIGHT or DOOM_DESIRE)
+    uint8_t expiry[FIELD_BATTLERS];    // Turn the attack lands on (0 = inactive)
+    uint8_t attacker[FIELD_BATTLERS];  // Slot that used it
+    uint16_t damage[FIELD_BATTLERS];   // Pre-calculated damage
+    uint8_t move[FIELD_BATTLERS];      // Move ID (FUTURE_SIGHT or DOOM_DESIRE)
 };
 
 struct Wish {
-    uint8_t counter[4];        // Turns until heal (0 = inactive)
-    uint8_t hp_to_restore[4];  // HP amount to restore
+    uint8_t expiry[FIELD_BATTLERS];         // Turn the heal lands on (0 = inactive)
+    uint8_t hp_to_restore[FIELD_BATTLERS];  // HP amount to restore
 };
 
+#endif
+
 struct FieldState {
     Weather weather{Weather::NONE};
-    uint8_t weather_turns{0};  // 0 = permanent (ability-induced)
+    uint8_t weather_expiry{0};  // 0 = permanent (ability-induced)
 
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
     FutureSight future_sight{};
     Wish wish{};
+#endif
+
+    // Timer clock
+    uint8_t turn{1};         // Current turn on the 1..255 clock
+    uint8_t next_expiry{0};  // Soonest timer expiry (0 = none running)
 
     // Reset to battle start state
     constexpr void reset() {
+        touch(*this);
         weather = Weather::NONE;
-        weather_turns = 0;
+        weather_expiry = 0;
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
         future_sight = {};
         wish = {};
+#endif
+        turn = 1;
+        next_expiry = 0;
+    }
+
+    /**
+     * @brief Start a timer that runs for `turn_ends` turn ends, this one included.
+     *
+     * @param timer Expiry field of the effect (this struct's, a side's or a slot's)
+     */
+    constexpr void schedule(uint8_t& timer, uint8_t turn_ends) {
+        const uint8_t expiry = turn_after(turn, static_cast<uint8_t>(turn_ends - 1));
+        assign(timer, expiry);
+        if (next_expiry == 0 || turns_until(turn, expiry) < turns_until(turn, next_expiry))
+            assign(next_expiry, expiry);
     }
+
+    /// `timer` runs out at the end of this turn
+    constexpr bool expires_now(uint8_t timer) const { return timer == turn; }
 };
 
 }  // namespace logic::state
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../../util/platform.hpp"
+#include "../../util/random.hpp"
+#include "clock.hpp"
+
+// Compile the hash hooks out entirely with -DBATTLEMON_STATE_HASH=0
+#ifndef BATTLEMON_STATE_HASH
+#define BATTLEMON_STATE_HASH 1
+#endif
+
+namespace logic::state {
+
+// ============================================================================
+//                            ZOBRIST STATE HASH
+// ============================================================================
+//
+// 64-bit hash of the battle state for transposition detection in search.
+//
+// The hash is the XOR of one key per hashed field, key(region, offset,
+// value), so a write only has to XOR out the old key and XOR in the new
+// one. That update happens in assign() (the same choke point the undo
+// journal uses), so every mutating op keeps the hash current for free.
+//
+// Keys are computed with util::random::mix64 rather than read from a random
+// table: a table over (field, value) pairs would not fit the CE, and the
+// XOR structure is what makes the hash incremental either way.
+//
+// Which bytes count is described per struct by a HashLayout (see
+// hash_layout.hpp): caches and per-turn scratch are left out, so states
+// that only differ in them hash equal. Writes that do not line up with a
+// hashed field (touch() bulk resets, undo of touched ranges) invalidate
+// the hash and the owner recomputes it on demand.
+//
+// Timers store absolute expiry turns but are keyed by the turns they have
+// left (turns_left() against the turn clock), and the clock itself is not
+// hashed: states that differ only in how many turns have gone by hash
+// equal, so the search's transpositions meet across turns. A layout marks
+// its timer fields and, for the field region, the clock byte; advancing
+// the clock re-keys every running timer.
+//
+// ============================================================================
+
+/// One hashed field (or `count` consecutive elements of `size` bytes)
+struct HashedField {
+    uint8_t offset;
+    uint8_t size;
+    uint8_t count{1};
+    bool timer{false};  // 1-byte expiry turn, keyed by turns_left()
+};
+
+// Layout byte codes: 0 = not hashed, 1-4 = a field of that size starts here
+inline constexpr uint8_t HASH_BYTE_SKIP = 0;
+inline constexpr uint8_t HASH_BYTE_INSIDE = 0x80;  // Interior byte of a hashed field
+inline constexpr uint8_t HASH_BYTE_TIMER = 0x40;   // Or'd into a timer field's start code
+inline constexpr uint8_t HASH_BYTE_CLOCK = 0x20;   // The turn clock (not hashed itself)
+
+/// HashLayout::clock of a struct without the turn clock
+inline constexpr uint8_t HASH_NO_CLOCK = 0xFF;
+
+/// Per-byte description of one state struct
+struct HashLayout {
+    const uint8_t* bytes;  // sizeof(struct) codes
+    const HashedField* fields;
+    uint8_t size;
+    uint8_t field_count;
+    uint8_t clock{HASH_NO_CLOCK};  // Offset of the turn clock byte
+};
+
+/// Key of one field value
+constexpr uint64_t hash_key(uint8_t region, uint8_t offset, uint32_t value) {
+    return util::random::mix64((static_cast<uint64_t>(region) << 40) |
+                               (static_cast<uint64_t>(offset) << 32) | value);
+}
+
+/**
+ * @brief Incrementally maintained hash over a set of registered regions.
+ *
+ * A region is one state object (the field, a side, a mon, a slot) with its
+ * layout. The owner registers its regions, recompute()s once, then keeps a
+ * hashing::Scope open while mutating state.
+ */
+class StateHasher {
+   public:
+    static constexpr uint8_t MAX_REGIONS = 8;
+
+    /// Forget all regions
+    void clear() {
+        region_count_ = 0;
+        clock_ = nullptr;
+        valid_ = false;
+    }
+
+    /// Register a region; its id (registration order) is part of every key
+    void add_region(const void* base, const HashLayout& layout) {
+        if (region_count_ < MAX_REGIONS) {
+            regions_[region_count_++] = Region{static_cast<const uint8_t*>(base), &layout};
+            if (layout.clock != HASH_NO_CLOCK)
+                clock_ = static_cast<const uint8_t*>(base) + layout.clock;
+        }
+        valid_ = false;
+    }
+
+    /// Full recomputation from the registered regions
+    uint64_t recompute() {
+        uint64_t hash = 0;
+        for (uint8_t r = 0; r < region_count_; ++r) {
+            const Region& region = regions_[r];
+            for (uint8_t f = 0; f < region.layout->field_count; ++f) {
+                const HashedField& field = region.layout->fields[f];
+                for (uint8_t i = 0; i < field.count; ++i) {
+                    const uint8_t offset = static_cast<uint8_t>(field.offset + i * field.size);
+                    const uint32_t value = load(region.base + offset, field.size);
+                    hash ^= hash_key(r, offset, field.timer ? timer_value(value, turn()) : value);
+                }
+            }
+        }
+        value_ = hash;
+        valid_ = true;
+        return hash;
+    }
+
+    /**
+     * @brief Account for a write of `size` bytes at `address` (before it happens).
+     *
+     * @param address Field about to be written (still holds the old value)
+     * @param value New value
+     * @param size Bytes written
+     */
+    void update(const void* address, const void* value, size_t size) {
+        if (!valid_)
+            return;
+
+        const auto* target = static_cast<const uint8_t*>(address);
+        for (uint8_t r = 0; r < region_count_; ++r) {
+            const Region& region = regions_[r];
+            if (target < region.base || target >= region.base + region.layout->size)
+                continue;
+
+            const auto offset = static_cast<uint8_t>(target - region.base);
+            const uint8_t code = region.layout->bytes[offset];
+            if (code == HASH_BYTE_CLOCK && size == 1) {
+                rekey_timers(*target, *static_cast<const uint8_t*>(value));
+                return;
+            }
+            if (code == (HASH_BYTE_TIMER | 1) && size == 1) {
+                const uint8_t old_value = *target;
+                const uint8_t new_value = *static_cast<const uint8_t*>(value);
+                value_ ^= hash_key(r, offset, timer_value(old_value, turn())) ^
+                          hash_key(r, offset, timer_value(new_value, turn()));
+                return;
+            }
+            if (code == size) {
+                const uint32_t old_value = load(target, size);
+                const uint32_t new_value = load(static_cast<const uint8_t*>(value), size);
+                value_ ^= hash_key(r, offset, old_value) ^ hash_key(r, offset, new_value);
+                return;
+            }
+            // Misaligned or partial write into hashed bytes: give up on the delta
+            for (size_t i = 0; i < size && offset + i < region.layout->size; ++i) {
+                if (region.layout->bytes[offset + i] != HASH_BYTE_SKIP) {
+                    valid_ = false;
+                    return;
+                }
+            }
+            return;
+        }
+    }
+
+    /// A region is about to be overwritten in bulk
+    void invalidate() { valid_ = false; }
+
+    /// Restore a hash saved together with the state it describes
+    void set_value(uint64_t value) {
+        value_ = value;
+        valid_ = true;
+    }
+
+    [[nodiscard]] bool valid() const { return valid_; }
+    [[nodiscard]] uint64_t value() const { return value_; }
+
+   private:
+    struct Region {
+        const uint8_t* base;
+        const HashLayout* layout;
+    };
+
+    static uint32_t load(const uint8_t* bytes, size_t size) {
+        uint32_t value = 0;
+        std::memcpy(&value, bytes, size);
+        return value;
+    }
+
+    /// Key value of a timer holding `expiry` at clock `turn`
+    static uint32_t timer_value(uint32_t expiry, uint8_t turn) {
+        return turns_left(turn, static_cast<uint8_t>(expiry));
+    }
+
+    [[nodiscard]] uint8_t turn() const { return clock_ ? *clock_ : 1; }
+
+    /// The clock goes from `from` to `to`: move every running timer's key
+    void rekey_timers(uint8_t from, uint8_t to) {
+        for (uint8_t r = 0; r < region_count_; ++r) {
+            const Region& region = regions_[r];
+            for (uint8_t f = 0; f < region.layout->field_count; ++f) {
+                const HashedField& field = region.layout->fields[f];
+                if (!field.timer)
+                    continue;
+                for (uint8_t i = 0; i < field.count; ++i) {
+                    const auto offset = static_cast<uint8_t>(field.offset + i);
+                    const uint8_t expiry = region.base[offset];
+                    if (expiry != 0)
+                        value_ ^= hash_key(r, offset, timer_value(expiry, from)) ^
+                                  hash_key(r, offset, timer_value(expiry, to));
+                }
+            }
+        }
+    }
+
+    Region regions_[MAX_REGIONS]{};
+    const uint8_t* clock_{nullptr};
+    uint64_t value_{0};
+    uint8_t region_count_{0};
+    bool valid_{false};
+};
+
+// ============================================================================
+//                            ACTIVE HASHER HOOK
+// ============================================================================
+
+namespace hashing {
+
+/// Hasher receiving writes on this thread (nullptr = not hashing)
+inline BATTLEMON_THREAD_LOCAL StateHasher* g_active = nullptr;
+
+/// RAII: keep `hasher` current for the lifetime of the scope
+class Scope {
+   public:
+    explicit Scope(StateHasher* hasher) : previous_(g_active) { g_active = hasher; }
+    ~Scope() { g_active = previous_; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    StateHasher* previous_;
+};
+
+inline void update(const void* address, const void* value, size_t size) {
+    if (StateHasher* active = g_active) {
+        active->update(address, value, size);
+    }
+}
+
+inline void invalidate() {
+    if (StateHasher* active = g_active) {
+        active->invalidate();
+    }
+}
+
+}  // namespace hashing
+
+}  // namespace logic::state
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "field.hpp"
+#include "hash.hpp"
+#include "mon.hpp"
+#include "side.hpp"
+#include "slot.hpp"
+
+namespace logic::state {
+
+// ============================================================================
+//                              HASH LAYOUTS
+// ============================================================================
+//
+// Hashed fields of each state struct. Everything that decides how the
+// battle continues is in; caches (effective_speed, speed_dirty,
+// staged_stats, staged_at, next_expiry) and scratch that is cleared at the
+// start of every turn (damage taken, moved_this_turn, bounce_move) are out.
+// Timers hash as the turns they have left and the turn clock is out (see
+// hash.hpp), so a state hashes the same whichever turn it is reached on.
+//
+// ============================================================================
+
+namespace hash_detail {
+
+#define BATTLEMON_HASH_FIELD(Type, member) \
+    HashedField{static_cast<uint8_t>(offsetof(Type, member)), sizeof(Type::member), 1}
+#define BATTLEMON_HASH_ARRAY(Type, member)                                                  \
+    HashedField{static_cast<uint8_t>(offsetof(Type, member)), sizeof(Type::member[0]),    \
+                static_cast<uint8_t>(sizeof(Type::member) / sizeof(Type::member[0]))}
+#define BATTLEMON_HASH_TIMER(Type, member) \
+    HashedField{static_cast<uint8_t>(offsetof(Type, member)), 1, 1, true}
+#define BATTLEMON_HASH_TIMER_ARRAY(Type, member)                                   \
+    HashedField{static_cast<uint8_t>(offsetof(Type, member)), 1,                   \
+                static_cast<uint8_t>(sizeof(Type::member) / sizeof(Type::member[0])), true}
+
+template <typename T, size_t N>
+consteval std::array<uint8_t, sizeof(T)> make_hash_bytes(const std::array<HashedField, N>& fields,
+                                                         uint8_t clock = HASH_NO_CLOCK) {
+    static_assert(sizeof(T) <= 0xFF, "hash layouts address at most 255 bytes");
+    std::array<uint8_t, sizeof(T)> bytes{};
+    if (clock != HASH_NO_CLOCK)
+        bytes[clock] = HASH_BYTE_CLOCK;
+    for (const HashedField& field : fields) {
+        for (uint8_t i = 0; i < field.count; ++i) {
+            const size_t start = field.offset + i * field.size;
+            bytes[start] = field.timer ? static_cast<uint8_t>(HASH_BYTE_TIMER | field.size)
+                                       : field.size;
+            for (uint8_t b = 1; b < field.size; ++b) {
+                bytes[start + b] = HASH_BYTE_INSIDE;
+            }
+        }
+    }
+    return bytes;
+}
+
+inline constexpr std::array FIELD_FIELDS{
+    BATTLEMON_HASH_FIELD(FieldState, weather),
+    BATTLEMON_HASH_TIMER(FieldState, weather_expiry),
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    BATTLEMON_HASH_TIMER_ARRAY(FieldState, future_sight.expiry),
+    BATTLEMON_HASH_ARRAY(FieldState, future_sight.attacker),
+    BATTLEMON_HASH_ARRAY(FieldState, future_sight.damage),
+    BATTLEMON_HASH_ARRAY(FieldState, future_sight.move),
+    BATTLEMON_HASH_TIMER_ARRAY(FieldState, wish.expiry),
+    BATTLEMON_HASH_ARRAY(FieldState, wish.hp_to_restore),
+#endif
+};
+
+inline constexpr uint8_t FIELD_CLOCK = offsetof(FieldState, turn);
+
+inline constexpr std::array SIDE_FIELDS{
+    BATTLEMON_HASH_TIMER(SideState, reflect_expiry),
+    BATTLEMON_HASH_TIMER(SideState, light_screen_expiry),
+    BATTLEMON_HASH_TIMER(SideState, safeguard_expiry),
+    BATTLEMON_HASH_TIMER(SideState, mist_expiry),
+    BATTLEMON_HASH_FIELD(SideState, spikes_layers),
+    BATTLEMON_HASH_FIELD(SideState, follow_me_target),
+};
+
+inline constexpr std::array MON_FIELDS{
+    BATTLEMON_HASH_FIELD(MonState, current_hp),   BATTLEMON_HASH_FIELD(MonState, max_hp),
+    BATTLEMON_HASH_FIELD(MonState, status),       BATTLEMON_HASH_FIELD(MonState, sleep_turns),
+    BATTLEMON_HASH_FIELD(MonState, toxic_counter), BATTLEMON_HASH_ARRAY(MonState, pp),
+    BATTLEMON_HASH_FIELD(MonState, item_consumed),
+};
+
+inline constexpr std::array SLOT_FIELDS{
+    BATTLEMON_HASH_FIELD(SlotState, atk_stage),
+    BATTLEMON_HASH_FIELD(SlotState, def_stage),
+    BATTLEMON_HASH_FIELD(SlotState, spd_stage),
+    BATTLEMON_HASH_FIELD(SlotState, sp_atk_stage),
+    BATTLEMON_HASH_FIELD(SlotState, sp_def_stage),
+    BATTLEMON_HASH_FIELD(SlotState, accuracy_stage),
+    BATTLEMON_HASH_FIELD(SlotState, evasion_stage),
+    BATTLEMON_HASH_FIELD(SlotState, volatiles),
+    BATTLEMON_HASH_FIELD(SlotState, confusion_turns),
+    BATTLEMON_HASH_TIMER(SlotState, wrap_expiry),
+    BATTLEMON_HASH_TIMER(SlotState, taunt_expiry),
+    BATTLEMON_HASH_TIMER(SlotState, encore_expiry),
+    BATTLEMON_HASH_TIMER(SlotState, disable_expiry),
+    BATTLEMON_HASH_TIMER(SlotState, perish_expiry),
+    BATTLEMON_HASH_FIELD(SlotState, stockpile_count),
+    BATTLEMON_HASH_FIELD(SlotState, fury_cutter_power),
+    BATTLEMON_HASH_FIELD(SlotState, rollout_hits),
+    BATTLEMON_HASH_TIMER(SlotState, yawn_expiry),
+    BATTLEMON_HASH_FIELD(SlotState, substitute_hp),
+    BATTLEMON_HASH_FIELD(SlotState, disabled_move),
+    BATTLEMON_HASH_FIELD(SlotState, encored_move),
+    BATTLEMON_HASH_FIELD(SlotState, last_move_used),
+    BATTLEMON_HASH_FIELD(SlotState, charging_move),
+    BATTLEMON_HASH_FIELD(SlotState, infatuated_with),
+    BATTLEMON_HASH_FIELD(SlotState, leech_seed_target),
+    BATTLEMON_HASH_FIELD(SlotState, trapped_by),
+    BATTLEMON_HASH_FIELD(SlotState, is_first_turn),
+    BATTLEMON_HASH_FIELD(SlotState, party_index),
+    BATTLEMON_HASH_FIELD(SlotState, held_item),
+    BATTLEMON_HASH_FIELD(SlotState, item_consumed),
+};
+
+#undef BATTLEMON_HASH_FIELD
+#undef BATTLEMON_HASH_ARRAY
+#undef BATTLEMON_HASH_TIMER
+#undef BATTLEMON_HASH_TIMER_ARRAY
+
+inline constexpr auto FIELD_BYTES = make_hash_bytes<FieldState>(FIELD_FIELDS, FIELD_CLOCK);
+inline constexpr auto SIDE_BYTES = make_hash_bytes<SideState>(SIDE_FIELDS);
+inline constexpr auto SLOT_BYTES = make_hash_bytes<SlotState>(SLOT_FIELDS);
+
+/// `fields` of one struct, repeated for each of `Count` consecutive copies
+template <size_t Count, typename T, size_t N>
+consteval std::array<HashedField, N * Count> repeat_fields(
+    const std::array<HashedField, N>& fields) {
+    std::array<HashedField, N * Count> repeated{};
+    for (size_t copy = 0; copy < Count; ++copy) {
+        for (size_t f = 0; f < N; ++f) {
+            HashedField field = fields[f];
+            field.offset = static_cast<uint8_t>(field.offset + copy * sizeof(T));
+            repeated[copy * N + f] = field;
+        }
+    }
+    return repeated;
+}
+
+// A party's mons (dsl::Party::mons), one region per side
+using PartyMons = MonState[MAX_PARTY_SIZE];
+inline constexpr auto PARTY_FIELDS = repeat_fields<MAX_PARTY_SIZE, MonState>(MON_FIELDS);
+inline constexpr auto PARTY_BYTES = make_hash_bytes<PartyMons>(PARTY_FIELDS);
+
+}  // namespace hash_detail
+
+inline constexpr HashLayout FIELD_HASH_LAYOUT{
+    hash_detail::FIELD_BYTES.data(), hash_detail::FIELD_FIELDS.data(), sizeof(FieldState),
+    static_cast<uint8_t>(hash_detail::FIELD_FIELDS.size()), hash_detail::FIELD_CLOCK};
+inline constexpr HashLayout SIDE_HASH_LAYOUT{
+    hash_detail::SIDE_BYTES.data(), hash_detail::SIDE_FIELDS.data(), sizeof(SideState),
+    static_cast<uint8_t>(hash_detail::SIDE_FIELDS.size())};
+inline constexpr HashLayout PARTY_HASH_LAYOUT{
+    hash_detail::PARTY_BYTES.data(), hash_detail::PARTY_FIELDS.data(),
+    sizeof(hash_detail::PartyMons), static_cast<uint8_t>(hash_detail::PARTY_FIELDS.size())};
+inline constexpr HashLayout SLOT_HASH_LAYOUT{
+    hash_detail::SLOT_BYTES.data(), hash_detail::SLOT_FIELDS.data(), sizeof(SlotState),
+    static_cast<uint8_t>(hash_detail::SLOT_FIELDS.size())};
+
+}  // namespace logic::state
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../../util/platform.hpp"
+#include "../../util/random.hpp"
+#include "hash.hpp"
+
+// Compile the write hooks out entirely with -DBATTLEMON_UNDO_JOURNAL=0
+#ifndef BATTLEMON_UNDO_JOURNAL
+#define BATTLEMON_UNDO_JOURNAL 1
+#endif
+
+namespace logic::state {
+
+// ============================================================================
+//                              UNDO JOURNAL
+// ============================================================================
+//
+// Make/unmake alternative to snapshots for memory-constrained search.
+//
+// Every state mutation goes through assign() (or a state method built on it),
+// which records (address, old value) into the active journal before writing.
+// Rolling back a turn replays the entries in reverse, so search memory is
+// O(depth x mutations) rather than O(depth x state).
+//
+// Lifecycle:
+//   - The engine marks each turn with begin_turn() (also saving the RNG)
+//   - While a JournalScope is active, assign() records into that journal
+//   - undo_turn() restores everything written since the last mark
+//
+// The buffer is a fixed ring: when a turn's entries have been overwritten,
+// that turn can no longer be undone and undo_turn() reports failure.
+//
+// ============================================================================
+
+#ifndef BATTLEMON_JOURNAL_CAPACITY
+#define BATTLEMON_JOURNAL_CAPACITY 512
+#endif
+
+inline constexpr uint16_t JOURNAL_CAPACITY = BATTLEMON_JOURNAL_CAPACITY;
+inline constexpr uint8_t JOURNAL_MAX_TURNS = 8;
+
+/// One recorded write: up to 4 bytes of the previous value
+struct JournalEntry {
+    void* address;
+    uint32_t value;
+    uint8_t size;
+};
+
+/// Turn boundary: journal position and RNG state when the turn began
+struct JournalMark {
+    uint32_t position;
+    util::random::Rng rng;
+};
+
+class UndoJournal {
+   public:
+    /// Forget all entries and turn marks
+    void clear() {
+        written_ = 0;
+        mark_count_ = 0;
+    }
+
+    /**
+     * @brief Start a new undoable turn.
+     * @param rng Battle RNG as it is before the turn (restored by undo_turn)
+     */
+    void begin_turn(const util::random::Rng& rng) {
+        if (mark_count_ == JOURNAL_MAX_TURNS) {
+            // Drop the oldest mark; only the most recent turns stay undoable
+            for (uint8_t i = 1; i < JOURNAL_MAX_TURNS; ++i) {
+                marks_[i - 1] = marks_[i];
+            }
+            --mark_count_;
+        }
+        marks_[mark_count_++] = JournalMark{written_, rng};
+    }
+
+    /// True if the most recent turn is still fully recorded
+    [[nodiscard]] bool can_undo() const {
+        return mark_count_ > 0 && written_ - marks_[mark_count_ - 1].position <= JOURNAL_CAPACITY;
+    }
+
+    /**
+     * @brief Roll back every write since the most recent turn mark.
+     * @param[out] rng Restored to its state at begin_turn()
+     * @return false if there is no turn to undo or its entries were overwritten
+     */
+    bool undo_turn(util::random::Rng& rng) {
+        if (!can_undo()) {
+            return false;
+        }
+
+        const JournalMark& mark = marks_[--mark_count_];
+        while (written_ > mark.position) {
+            --written_;
+            const JournalEntry& entry = entries_[written_ % JOURNAL_CAPACITY];
+#if BATTLEMON_STATE_HASH
+            hashing::update(entry.address, &entry.value, entry.size);
+#endif
+            std::memcpy(entry.address, &entry.value, entry.size);
+        }
+        rng = mark.rng;
+        return true;
+    }
+
+    /// Record the current value at address (size <= 4) before it is overwritten
+    void record(void* address, uint8_t size) {
+        JournalEntry& entry = entries_[written_ % JOURNAL_CAPACITY];
+        entry.address = address;
+        entry.size = size;
+        std::memcpy(&entry.value, address, size);
+        ++written_;
+    }
+
+    /// Record an arbitrary region as 4-byte chunks (whole-struct resets)
+    void record_range(void* address, size_t size) {
+        auto* bytes = static_cast<uint8_t*>(address);
+        while (size > 0) {
+            const uint8_t chunk = static_cast<uint8_t>(size < 4 ? size : 4);
+            record(bytes, chunk);
+            bytes += chunk;
+            size -= chunk;
+        }
+    }
+
+    /// Entries recorded since clear() (including any overwritten ones)
+    [[nodiscard]] uint32_t written() const { return written_; }
+
+   private:
+    JournalEntry entries_[JOURNAL_CAPACITY];
+    JournalMark marks_[JOURNAL_MAX_TURNS];
+    uint32_t written_{0};
+    uint8_t mark_count_{0};
+};
+
+// ============================================================================
+//                           ACTIVE JOURNAL HOOK
+// ============================================================================
+
+namespace journal {
+
+/// Journal receiving writes on this thread (nullptr = not recording)
+inline BATTLEMON_THREAD_LOCAL UndoJournal* g_active = nullptr;
+
+/// RAII: record into `journal` for the lifetime of the scope
+class Scope {
+   public:
+    explicit Scope(UndoJournal* journal) : previous_(g_active) { g_active = journal; }
+    ~Scope() { g_active = previous_; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    UndoJournal* previous_;
+};
+
+inline void record(void* address, uint8_t size) {
+    if (UndoJournal* active = g_active) {
+        active->record(address, size);
+    }
+}
+
+inline void record_range(void* address, size_t size) {
+    if (UndoJournal* active = g_active) {
+        active->record_range(address, size);
+    }
+}
+
+}  // namespace journal
+
+// ============================================================================
+//                             TRACKED WRITES
+// ============================================================================
+
+/**
+ * @brief Write a state field, journaling the old value first.
+ *
+ * Also keeps the active StateHasher current. Compile-time evaluation
+ * (constexpr state setup) never journals or hashes.
+ */
+template <typename T>
+constexpr void assign(T& field, std::type_identity_t<T> value) {
+    static_assert(sizeof(T) <= 4, "journal entries hold at most 4 bytes; use touch()");
+#if BATTLEMON_UNDO_JOURNAL
+    if !consteval {
+        journal::record(&field, sizeof(T));
+    }
+#endif
+#if BATTLEMON_STATE_HASH
+    if !consteval {
+        hashing::update(&field, &value, sizeof(T));
+    }
+#endif
+    field = value;
+}
+
+/**
+ * @brief Journal a whole object that is about to be overwritten in bulk.
+ */
+template <typename T>
+constexpr void touch(T& object) {
+    static_assert(std::is_trivially_copyable_v<T>, "journaled state must be trivially copyable");
+#if BATTLEMON_STATE_HASH
+    if !consteval {
+        hashing::invalidate();
+    }
+#endif
+#if BATTLEMON_UNDO_JOURNAL
+    if !consteval {
+        journal::record_range(&object, sizeof(T));
+    }
+#else
+    (void)object;
+#endif
+}
+
+}  // namespace logic::state
@@ -2,6 +2,9 @@
 
 #include <cstdint>
 
+#include "event_queue.hpp"
+#include "journal.hpp"
+
 namespace logic::state {
 
 // ============================================================================
@@ -16,9 +19,13 @@ namespace logic::state {
 //   - Current HP
 //   - Primary status condition
 //   - Move PP
-//   - Toxic counter (resets to 1 on switch-in, not cleared)
+//   - Toxic counter (resets to 1 on switch-out, not cleared)
+//   - Whether the held item is used up (kept for the slot while it is in play)
 // ============================================================================
 
+// Members per party: a Battle Factory team is 3, the engine holds up to 6
+inline constexpr uint8_t MAX_PARTY_SIZE = 6;
+
 enum class Status : uint8_t {
     NONE = 0,
     SLEEP,
@@ -39,6 +46,10 @@ struct MonState {
 
     uint8_t pp[4]{0, 0, 0, 0};
 
+    // SlotState::item_consumed of the mon's last stint in play (written on
+    // switch-out, read back on switch-in)
+    bool item_consumed{false};
+
     // Helpers
     constexpr bool is_fainted() const { return current_hp == 0; }
     constexpr bool is_alive() const { return current_hp > 0; }
@@ -53,35 +64,41 @@ struct MonState {
 
     // Apply damage (returns actual damage dealt)
     constexpr uint16_t apply_damage(uint16_t damage) {
-        if (damage >= current_hp) {
-            uint16_t dealt = current_hp;
-            current_hp = 0;
-            return dealt;
+        const uint16_t dealt = damage < current_hp ? damage : current_hp;
+        assign(current_hp, current_hp - dealt);
+        if !consteval {
+            if (dealt > 0)
+                events::emit_for(EventType::DAMAGE, *this, dealt);
+            if (dealt > 0 && current_hp == 0)
+                events::emit_for(EventType::FAINT, *this);
         }
-        current_hp -= damage;
-        return damage;
+        return dealt;
     }
 
     // Heal HP (returns actual HP healed)
     constexpr uint16_t heal(uint16_t amount) {
         uint16_t missing = max_hp - current_hp;
         uint16_t healed = (amount < missing) ? amount : missing;
-        current_hp += healed;
+        assign(current_hp, current_hp + healed);
+        if !consteval {
+            if (healed > 0)
+                events::emit_for(EventType::HEAL, *this, healed);
+        }
         return healed;
     }
 
     // Reset toxic counter (called on switch-in)
     constexpr void reset_toxic_counter() {
         if (status == Status::TOXIC) {
-            toxic_counter = 1;
+            assign(toxic_counter, 1);
         }
     }
 
-    // Cure status
+    // Cure status (curing paralysis: also mark the slot's speed dirty)
     constexpr void cure_status() {
-        status = Status::NONE;
-        sleep_turns = 0;
-        toxic_counter = 1;
+        assign(status, Status::NONE);
+        assign(sleep_turns, 0);
+        assign(toxic_counter, 1);
     }
 };
 
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "context.hpp"
+#include "field.hpp"
+#include "mon.hpp"
+#include "side.hpp"
+#include "slot.hpp"
+#include "dsl/item/event_mask.hpp"
+#include "types/enums/item.hpp"
+#include "util/bitpack.hpp"
+
+namespace logic::state {
+
+// ============================================================================
+//                       PACKED SLOT AND MON STATE
+// ============================================================================
+//
+// Storage form of SlotState and MonState for search-tree nodes and replay
+// keyframes, where many states are held at once and few are worked on. The
+// working structs spend a byte (or two) per field; here every field gets the
+// bits its Gen III range needs:
+//
+//   SlotState (64 bytes host, 56 eZ80) -> PackedSlotState  28 bytes
+//     volatiles 31, 7 stat stages x 4 (stage + 6), counters 2-3 each
+//     (fury_cutter_power 8), timer expiries 8 (an absolute turn, see
+//     field.hpp), slot references 3 each (0 = none, else id + 1),
+//     substitute_hp 8 (at most max_hp / 4), move bytes 8, damage taken 10,
+//     held_item 7, effective_speed 11, party_index 3, flags 1 (item_events
+//     is derived from held_item and item_consumed, so it is rebuilt rather
+//     than stored)
+//
+//   MonState (12 bytes host, 11 eZ80) -> PackedMonState  8 bytes
+//     current_hp 10, max_hp 10, status 3, sleep_turns 3, toxic_counter 4,
+//     pp 4 x 7, item_consumed 1
+//
+// unpack(pack(x)) == x field for field, the per-turn trackers and the speed
+// cache included, so a restored node behaves exactly like the original. The
+// staged-stat cache (staged_stats / staged_at) is the exception: it is keyed
+// by the stages themselves, so it unpacks empty and refills on first use.
+// pack() requires packable(): a value outside its width (an HP above 1023,
+// a counter a future move runs past 7) is reported there rather than
+// truncated, and the caller keeps that state unpacked.
+//
+// Fields are read with 16-bit loads (util/bitpack.hpp), so unpacking is
+// cheap enough to run per node visit on the calculator.
+//
+// PackedBattleState is the turn-to-turn part of a dsl::BattleState in the
+// same form: field and sides as raw bytes (already byte-sized), packed slots
+// and party mons, and the RNG. Rentals, computed stats, abilities, party
+// sizes and the level never change during a battle, so a search tree stores
+// them once (in the root's BattleState) rather than per node. Members past a
+// party's size are neither packed nor unpacked.
+//
+// ============================================================================
+
+/// Packed slot reference: no slot (0xFF) is 0, slot i is i + 1
+inline constexpr uint8_t NO_SLOT = 0xFF;
+
+namespace slot_fields {
+using util::bitpack::after;
+using util::bitpack::Field;
+
+inline constexpr Field VOLATILES_LO{0, 16};
+inline constexpr Field VOLATILES_HI = after(VOLATILES_LO, 15);
+inline constexpr Field IS_FIRST_TURN = after(VOLATILES_HI, 1);
+inline constexpr Field ATK_STAGE = after(IS_FIRST_TURN, 4);
+inline constexpr Field DEF_STAGE = after(ATK_STAGE, 4);
+inline constexpr Field SPD_STAGE = after(DEF_STAGE, 4);
+inline constexpr Field SP_ATK_STAGE = after(SPD_STAGE, 4);
+inline constexpr Field SP_DEF_STAGE = after(SP_ATK_STAGE, 4);
+inline constexpr Field ACCURACY_STAGE = after(SP_DEF_STAGE, 4);
+inline constexpr Field EVASION_STAGE = after(ACCURACY_STAGE, 4);
+inline constexpr Field SPEED_DIRTY = after(EVASION_STAGE, 1);
+inline constexpr Field MOVED_THIS_TURN = after(SPEED_DIRTY, 1);
+inline constexpr Field BOUNCE_MOVE = after(MOVED_THIS_TURN, 1);
+inline constexpr Field ITEM_CONSUMED = after(BOUNCE_MOVE, 1);
+inline constexpr Field CONFUSION_TURNS = after(ITEM_CONSUMED, 3);
+inline constexpr Field WRAP_EXPIRY = after(CONFUSION_TURNS, 8);
+inline constexpr Field TAUNT_EXPIRY = after(WRAP_EXPIRY, 8);
+inline constexpr Field ENCORE_EXPIRY = after(TAUNT_EXPIRY, 8);
+inline constexpr Field DISABLE_EXPIRY = after(ENCORE_EXPIRY, 8);
+inline constexpr Field PERISH_EXPIRY = after(DISABLE_EXPIRY, 8);
+inline constexpr Field STOCKPILE_COUNT = after(PERISH_EXPIRY, 2);
+inline constexpr Field ROLLOUT_HITS = after(STOCKPILE_COUNT, 3);
+inline constexpr Field YAWN_EXPIRY = after(ROLLOUT_HITS, 8);
+inline constexpr Field FURY_CUTTER_POWER = after(YAWN_EXPIRY, 8);
+inline constexpr Field HELD_ITEM = after(FURY_CUTTER_POWER, 7);
+inline constexpr Field INFATUATED_WITH = after(HELD_ITEM, 3);
+inline constexpr Field LEECH_SEED_TARGET = after(INFATUATED_WITH, 3);
+inline constexpr Field TRAPPED_BY = after(LEECH_SEED_TARGET, 3);
+inline constexpr Field PHYSICAL_ATTACKER = after(TRAPPED_BY, 3);
+inline constexpr Field SPECIAL_ATTACKER = after(PHYSICAL_ATTACKER, 3);
+inline constexpr Field SUBSTITUTE_HP = after(SPECIAL_ATTACKER, 8);
+inline constexpr Field DISABLED_MOVE = after(SUBSTITUTE_HP, 8);
+inline constexpr Field ENCORED_MOVE = after(DISABLED_MOVE, 8);
+inline constexpr Field LAST_MOVE_USED = after(ENCORED_MOVE, 8);
+inline constexpr Field CHARGING_MOVE = after(LAST_MOVE_USED, 8);
+inline constexpr Field PHYSICAL_DAMAGE_TAKEN = after(CHARGING_MOVE, 10);
+inline constexpr Field SPECIAL_DAMAGE_TAKEN = after(PHYSICAL_DAMAGE_TAKEN, 10);
+inline constexpr Field EFFECTIVE_SPEED = after(SPECIAL_DAMAGE_TAKEN, 11);
+inline constexpr Field PARTY_INDEX = after(EFFECTIVE_SPEED, 3);
+inline constexpr unsigned BITS = util::bitpack::end(PARTY_INDEX);
+}  // namespace slot_fields
+
+namespace mon_fields {
+using util::bitpack::after;
+using util::bitpack::Field;
+
+inline constexpr Field CURRENT_HP{0, 10};
+inline constexpr Field MAX_HP = after(CURRENT_HP, 10);
+inline constexpr Field STATUS = after(MAX_HP, 3);
+inline constexpr Field SLEEP_TURNS = after(STATUS, 3);
+inline constexpr Field TOXIC_COUNTER = after(SLEEP_TURNS, 4);
+inline constexpr Field PP[4]{after(TOXIC_COUNTER, 7), after(PP[0], 7), after(PP[1], 7),
+                             after(PP[2], 7)};
+inline constexpr Field ITEM_CONSUMED = after(PP[3], 1);
+inline constexpr unsigned BITS = util::bitpack::end(ITEM_CONSUMED);
+}  // namespace mon_fields
+
+struct PackedSlotState {
+    uint8_t bytes[(slot_fields::BITS + 7) / 8];
+};
+
+struct PackedMonState {
+    uint8_t bytes[(mon_fields::BITS + 7) / 8];
+};
+
+static_assert(sizeof(PackedSlotState) == 28 && sizeof(PackedMonState) == 8,
+              "packed layouts changed size (see slot_fields / mon_fields)");
+
+// ============================================================================
+//                             FIELD CODECS
+// ============================================================================
+
+namespace packed_detail {
+
+constexpr unsigned encode_stage(int8_t stage) { return static_cast<unsigned>(stage + 6); }
+constexpr int8_t decode_stage(unsigned bits) { return static_cast<int8_t>(bits - 6u); }
+
+constexpr unsigned encode_slot_ref(uint8_t slot) {
+    return slot == NO_SLOT ? 0u : static_cast<unsigned>(slot) + 1u;
+}
+constexpr uint8_t decode_slot_ref(unsigned bits) {
+    return bits == 0 ? NO_SLOT : static_cast<uint8_t>(bits - 1);
+}
+
+constexpr bool stage_fits(int8_t stage, util::bitpack::Field field) {
+    return stage >= -6 && util::bitpack::fits(encode_stage(stage), field);
+}
+
+constexpr bool slot_ref_fits(uint8_t slot, util::bitpack::Field field) {
+    return util::bitpack::fits(encode_slot_ref(slot), field);
+}
+
+}  // namespace packed_detail
+
+// ============================================================================
+//                              SLOT STATE
+// ============================================================================
+
+/// Every field of `slot` is representable in its packed width
+constexpr bool packable(const SlotState& slot) {
+    using namespace slot_fields;
+    using packed_detail::slot_ref_fits;
+    using packed_detail::stage_fits;
+    using util::bitpack::fits;
+    return stage_fits(slot.atk_stage, ATK_STAGE) && stage_fits(slot.def_stage, DEF_STAGE) &&
+           stage_fits(slot.spd_stage, SPD_STAGE) && stage_fits(slot.sp_atk_stage, SP_ATK_STAGE) &&
+           stage_fits(slot.sp_def_stage, SP_DEF_STAGE) &&
+           stage_fits(slot.accuracy_stage, ACCURACY_STAGE) &&
+           stage_fits(slot.evasion_stage, EVASION_STAGE) &&
+           (slot.volatiles >> (VOLATILES_LO.width + VOLATILES_HI.width)) == 0 &&
+           fits(slot.confusion_turns, CONFUSION_TURNS) && fits(slot.wrap_expiry, WRAP_EXPIRY) &&
+           fits(slot.taunt_expiry, TAUNT_EXPIRY) && fits(slot.encore_expiry, ENCORE_EXPIRY) &&
+           fits(slot.disable_expiry, DISABLE_EXPIRY) && fits(slot.perish_expiry, PERISH_EXPIRY) &&
+           fits(slot.stockpile_count, STOCKPILE_COUNT) && fits(slot.rollout_hits, ROLLOUT_HITS) &&
+           fits(slot.yawn_expiry, YAWN_EXPIRY) && fits(slot.substitute_hp, SUBSTITUTE_HP) &&
+           fits(slot.physical_damage_taken, PHYSICAL_DAMAGE_TAKEN) &&
+           fits(slot.special_damage_taken, SPECIAL_DAMAGE_TAKEN) &&
+           slot_ref_fits(slot.physical_attacker, PHYSICAL_ATTACKER) &&
+           slot_ref_fits(slot.special_attacker, SPECIAL_ATTACKER) &&
+           slot_ref_fits(slot.infatuated_with, INFATUATED_WITH) &&
+           slot_ref_fits(slot.leech_seed_target, LEECH_SEED_TARGET) &&
+           slot_ref_fits(slot.trapped_by, TRAPPED_BY) &&
+           fits(static_cast<unsigned>(slot.held_item), HELD_ITEM) &&
+           fits(slot.effective_speed, EFFECTIVE_SPEED) && fits(slot.party_index, PARTY_INDEX);
+}
+
+/**
+ * @brief Pack `slot` into its storage form.
+ *
+ * @pre packable(slot)
+ */
+constexpr PackedSlotState pack(const SlotState& slot) {
+    using namespace slot_fields;
+    using packed_detail::encode_slot_ref;
+    using packed_detail::encode_stage;
+    using util::bitpack::write;
+
+    PackedSlotState packed{};
+    uint8_t(&b)[sizeof(packed.bytes)] = packed.bytes;
+    write<VOLATILES_LO>(b, static_cast<unsigned>(slot.volatiles & 0xFFFF));
+    write<VOLATILES_HI>(b, static_cast<unsigned>(slot.volatiles >> 16));
+    write<IS_FIRST_TURN>(b, slot.is_first_turn);
+    write<ATK_STAGE>(b, encode_stage(slot.atk_stage));
+    write<DEF_STAGE>(b, encode_stage(slot.def_stage));
+    write<SPD_STAGE>(b, encode_stage(slot.spd_stage));
+    write<SP_ATK_STAGE>(b, encode_stage(slot.sp_atk_stage));
+    write<SP_DEF_STAGE>(b, encode_stage(slot.sp_def_stage));
+    write<ACCURACY_STAGE>(b, encode_stage(slot.accuracy_stage));
+    write<EVASION_STAGE>(b, encode_stage(slot.evasion_stage));
+    write<SPEED_DIRTY>(b, slot.speed_dirty);
+    write<MOVED_THIS_TURN>(b, slot.moved_this_turn);
+    write<BOUNCE_MOVE>(b, slot.bounce_move);
+    write<ITEM_CONSUMED>(b, slot.item_consumed);
+    write<CONFUSION_TURNS>(b, slot.confusion_turns);
+    write<WRAP_EXPIRY>(b, slot.wrap_expiry);
+    write<TAUNT_EXPIRY>(b, slot.taunt_expiry);
+    write<ENCORE_EXPIRY>(b, slot.encore_expiry);
+    write<DISABLE_EXPIRY>(b, slot.disable_expiry);
+    write<PERISH_EXPIRY>(b, slot.perish_expiry);
+    write<STOCKPILE_COUNT>(b, slot.stockpile_count);
+    write<ROLLOUT_HITS>(b, slot.rollout_hits);
+    write<YAWN_EXPIRY>(b, slot.yawn_expiry);
+    write<FURY_CUTTER_POWER>(b, slot.fury_cutter_power);
+    write<HELD_ITEM>(b, static_cast<unsigned>(slot.held_item));
+    write<INFATUATED_WITH>(b, encode_slot_ref(slot.infatuated_with));
+    write<LEECH_SEED_TARGET>(b, encode_slot_ref(slot.leech_seed_target));
+    write<TRAPPED_BY>(b, encode_slot_ref(slot.trapped_by));
+    write<PHYSICAL_ATTACKER>(b, encode_slot_ref(slot.physical_attacker));
+    write<SPECIAL_ATTACKER>(b, encode_slot_ref(slot.special_attacker));
+    write<SUBSTITUTE_HP>(b, slot.substitute_hp);
+    write<DISABLED_MOVE>(b, slot.disabled_move);
+    write<ENCORED_MOVE>(b, slot.encored_move);
+    write<LAST_MOVE_USED>(b, slot.last_move_used);
+    write<CHARGING_MOVE>(b, slot.charging_move);
+    write<PHYSICAL_DAMAGE_TAKEN>(b, slot.physical_damage_taken);
+    write<SPECIAL_DAMAGE_TAKEN>(b, slot.special_damage_taken);
+    write<EFFECTIVE_SPEED>(b, slot.effective_speed);
+    write<PARTY_INDEX>(b, slot.party_index);
+    return packed;
+}
+
+constexpr SlotState unpack(const PackedSlotState& packed) {
+    using namespace slot_fields;
+    using packed_detail::decode_slot_ref;
+    using packed_detail::decode_stage;
+    using util::bitpack::read;
+
+    const uint8_t(&b)[sizeof(packed.bytes)] = packed.bytes;
+    SlotState slot{};
+    slot.volatiles = read<VOLATILES_LO>(b) | static_cast<uint32_t>(read<VOLATILES_HI>(b)) << 16;
+    slot.is_first_turn = read<IS_FIRST_TURN>(b);
+    slot.atk_stage = decode_stage(read<ATK_STAGE>(b));
+    slot.def_stage = decode_stage(read<DEF_STAGE>(b));
+    slot.spd_stage = decode_stage(read<SPD_STAGE>(b));
+    slot.sp_atk_stage = decode_stage(read<SP_ATK_STAGE>(b));
+    slot.sp_def_stage = decode_stage(read<SP_DEF_STAGE>(b));
+    slot.accuracy_stage = decode_stage(read<ACCURACY_STAGE>(b));
+    slot.evasion_stage = decode_stage(read<EVASION_STAGE>(b));
+    slot.speed_dirty = read<SPEED_DIRTY>(b);
+    slot.moved_this_turn = read<MOVED_THIS_TURN>(b);
+    slot.bounce_move = read<BOUNCE_MOVE>(b);
+    slot.item_consumed = read<ITEM_CONSUMED>(b);
+    slot.confusion_turns = static_cast<uint8_t>(read<CONFUSION_TURNS>(b));
+    slot.wrap_expiry = static_cast<uint8_t>(read<WRAP_EXPIRY>(b));
+    slot.taunt_expiry = static_cast<uint8_t>(read<TAUNT_EXPIRY>(b));
+    slot.encore_expiry = static_cast<uint8_t>(read<ENCORE_EXPIRY>(b));
+    slot.disable_expiry = static_cast<uint8_t>(read<DISABLE_EXPIRY>(b));
+    slot.perish_expiry = static_cast<uint8_t>(read<PERISH_EXPIRY>(b));
+    slot.stockpile_count = static_cast<uint8_t>(read<STOCKPILE_COUNT>(b));
+    slot.rollout_hits = static_cast<uint8_t>(read<ROLLOUT_HITS>(b));
+    slot.yawn_expiry = static_cast<uint8_t>(read<YAWN_EXPIRY>(b));
+    slot.fury_cutter_power = static_cast<uint8_t>(read<FURY_CUTTER_POWER>(b));
+    slot.held_item = static_cast<types::enums::Item>(read<HELD_ITEM>(b));
+    slot.item_events = slot.item_consumed ? 0 : dsl::item::item_event_mask(slot.held_item);
+    slot.infatuated_with = decode_slot_ref(read<INFATUATED_WITH>(b));
+    slot.leech_seed_target = decode_slot_ref(read<LEECH_SEED_TARGET>(b));
+    slot.trapped_by = decode_slot_ref(read<TRAPPED_BY>(b));
+    slot.physical_attacker = decode_slot_ref(read<PHYSICAL_ATTACKER>(b));
+    slot.special_attacker = decode_slot_ref(read<SPECIAL_ATTACKER>(b));
+    slot.substitute_hp = static_cast<uint16_t>(read<SUBSTITUTE_HP>(b));
+    slot.disabled_move = static_cast<uint8_t>(read<DISABLED_MOVE>(b));
+    slot.encored_move = static_cast<uint8_t>(read<ENCORED_MOVE>(b));
+    slot.last_move_used = static_cast<uint8_t>(read<LAST_MOVE_USED>(b));
+    slot.charging_move = static_cast<uint8_t>(read<CHARGING_MOVE>(b));
+    slot.physical_damage_taken = static_cast<uint16_t>(read<PHYSICAL_DAMAGE_TAKEN>(b));
+    slot.special_damage_taken = static_cast<uint16_t>(read<SPECIAL_DAMAGE_TAKEN>(b));
+    slot.effective_speed = static_cast<uint16_t>(read<EFFECTIVE_SPEED>(b));
+    slot.party_index = static_cast<uint8_t>(read<PARTY_INDEX>(b));
+    return slot;
+}
+
+// ============================================================================
+//                               MON STATE
+// ============================================================================
+
+/// Every field of `mon` is representable in its packed width
+constexpr bool packable(const MonState& mon) {
+    using namespace mon_fields;
+    using util::bitpack::fits;
+    for (const uint8_t pp : mon.pp) {
+        if (!fits(pp, PP[0]))
+            return false;
+    }
+    return fits(mon.current_hp, CURRENT_HP) && fits(mon.max_hp, MAX_HP) &&
+           fits(static_cast<unsigned>(mon.status), STATUS) &&
+           fits(mon.sleep_turns, SLEEP_TURNS) && fits(mon.toxic_counter, TOXIC_COUNTER);
+}
+
+/**
+ * @brief Pack `mon` into its storage form.
+ *
+ * @pre packable(mon)
+ */
+constexpr PackedMonState pack(const MonState& mon) {
+    using namespace mon_fields;
+    using util::bitpack::write;
+
+    PackedMonState packed{};
+    uint8_t(&b)[sizeof(packed.bytes)] = packed.bytes;
+    write<CURRENT_HP>(b, mon.current_hp);
+    write<MAX_HP>(b, mon.max_hp);
+    write<STATUS>(b, static_cast<unsigned>(mon.status));
+    write<SLEEP_TURNS>(b, mon.sleep_turns);
+    write<TOXIC_COUNTER>(b, mon.toxic_counter);
+    write<PP[0]>(b, mon.pp[0]);
+    write<PP[1]>(b, mon.pp[1]);
+    write<PP[2]>(b, mon.pp[2]);
+    write<PP[3]>(b, mon.pp[3]);
+    write<ITEM_CONSUMED>(b, mon.item_consumed);
+    return packed;
+}
+
+constexpr MonState unpack(const PackedMonState& packed) {
+    using namespace mon_fields;
+    using util::bitpack::read;
+
+    const uint8_t(&b)[sizeof(packed.bytes)] = packed.bytes;
+    MonState mon{};
+    mon.current_hp = static_cast<uint16_t>(read<CURRENT_HP>(b));
+    mon.max_hp = static_cast<uint16_t>(read<MAX_HP>(b));
+    mon.status = static_cast<Status>(read<STATUS>(b));
+    mon.sleep_turns = static_cast<uint8_t>(read<SLEEP_TURNS>(b));
+    mon.toxic_counter = static_cast<uint8_t>(read<TOXIC_COUNTER>(b));
+    mon.pp[0] = static_cast<uint8_t>(read<PP[0]>(b));
+    mon.pp[1] = static_cast<uint8_t>(read<PP[1]>(b));
+    mon.pp[2] = static_cast<uint8_t>(read<PP[2]>(b));
+    mon.pp[3] = static_cast<uint8_t>(read<PP[3]>(b));
+    mon.item_consumed = read<ITEM_CONSUMED>(b);
+    return mon;
+}
+
+// ============================================================================
+//                             BATTLE STATE
+// ============================================================================
+
+namespace battle_bytes {
+inline constexpr size_t FIELD = 0;
+inline constexpr size_t SIDES = FIELD + sizeof(FieldState);
+inline constexpr size_t SLOTS = SIDES + sizeof(SideState) * dsl::BATTLE_SIDE_COUNT;
+inline constexpr size_t MONS = SLOTS + sizeof(PackedSlotState) * dsl::MAX_BATTLE_SLOTS;
+inline constexpr size_t RNG =
+    MONS + sizeof(PackedMonState) * dsl::MAX_PARTY_SIZE * dsl::BATTLE_SIDE_COUNT;
+inline constexpr size_t TOTAL = RNG + sizeof(util::random::Rng);
+}  // namespace battle_bytes
+
+/// Turn-to-turn state of a battle (212 bytes on the host)
+struct PackedBattleState {
+    uint8_t bytes[battle_bytes::TOTAL];
+};
+
+static_assert(sizeof(PackedBattleState) <= 0xFF, "byte offsets into a packed state are 8-bit");
+
+/// Byte offset of party member `member` of `side` in a PackedBattleState
+constexpr size_t packed_mon_offset(uint8_t side, uint8_t member) {
+    return battle_bytes::MONS + (side * dsl::MAX_PARTY_SIZE + member) * sizeof(PackedMonState);
+}
+
+/// Every slot and party mon of `state` is packable
+inline bool packable(const dsl::BattleState& state) {
+    for (uint8_t i = 0; i < dsl::MAX_BATTLE_SLOTS; ++i) {
+        if (!packable(state.slots[i]))
+            return false;
+    }
+    for (const dsl::Party& party : state.parties) {
+        for (uint8_t m = 0; m < party.size; ++m) {
+            if (!packable(party.mons[m]))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Pack the turn-to-turn part of `state`.
+ *
+ * @pre packable(state)
+ */
+inline PackedBattleState pack(const dsl::BattleState& state) {
+    PackedBattleState packed{};
+    std::memcpy(packed.bytes + battle_bytes::FIELD, &state.field, sizeof(state.field));
+    std::memcpy(packed.bytes + battle_bytes::SIDES, state.sides, sizeof(state.sides));
+    for (uint8_t i = 0; i < dsl::MAX_BATTLE_SLOTS; ++i) {
+        const PackedSlotState slot = pack(state.slots[i]);
+        std::memcpy(packed.bytes + battle_bytes::SLOTS + i * sizeof(slot), &slot, sizeof(slot));
+    }
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        const dsl::Party& party = state.parties[side];
+        for (uint8_t m = 0; m < party.size; ++m) {
+            const PackedMonState mon = pack(party.mons[m]);
+            std::memcpy(packed.bytes + packed_mon_offset(side, m), &mon, sizeof(mon));
+        }
+    }
+    std::memcpy(packed.bytes + battle_bytes::RNG, &state.rng, sizeof(state.rng));
+    return packed;
+}
+
+/**
+ * @brief Overwrite the turn-to-turn part of `state` with `packed`.
+ *
+ * Rentals, active stats, abilities, party sizes and level of `state` are
+ * kept: pass a state of the same battle (e.g. the search root's).
+ */
+inline void unpack(const PackedBattleState& packed, dsl::BattleState& state) {
+    std::memcpy(&state.field, packed.bytes + battle_bytes::FIELD, sizeof(state.field));
+    std::memcpy(state.sides, packed.bytes + battle_bytes::SIDES, sizeof(state.sides));
+    for (uint8_t i = 0; i < dsl::MAX_BATTLE_SLOTS; ++i) {
+        PackedSlotState slot;
+        std::memcpy(&slot, packed.bytes + battle_bytes::SLOTS + i * sizeof(slot), sizeof(slot));
+        state.slots[i] = unpack(slot);
+    }
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        dsl::Party& party = state.parties[side];
+        for (uint8_t m = 0; m < party.size; ++m) {
+            PackedMonState mon;
+            std::memcpy(&mon, packed.bytes + packed_mon_offset(side, m), sizeof(mon));
+            party.mons[m] = unpack(mon);
+        }
+    }
+    std::memcpy(&state.rng, packed.bytes + battle_bytes::RNG, sizeof(state.rng));
+}
+
+// ============================================================================
+//                              VALIDATION
+// ============================================================================
+
+constexpr bool same_slot(const SlotState& a, const SlotState& b) {
+    return a.atk_stage == b.atk_stage && a.def_stage == b.def_stage &&
+           a.spd_stage == b.spd_stage && a.sp_atk_stage == b.sp_atk_stage &&
+           a.sp_def_stage == b.sp_def_stage && a.accuracy_stage == b.accuracy_stage &&
+           a.evasion_stage == b.evasion_stage && a.volatiles == b.volatiles &&
+           a.confusion_turns == b.confusion_turns && a.wrap_expiry == b.wrap_expiry &&
+           a.taunt_expiry == b.taunt_expiry && a.encore_expiry == b.encore_expiry &&
+           a.disable_expiry == b.disable_expiry && a.perish_expiry == b.perish_expiry &&
+           a.stockpile_count == b.stockpile_count && a.fury_cutter_power == b.fury_cutter_power &&
+           a.rollout_hits == b.rollout_hits && a.yawn_expiry == b.yawn_expiry &&
+           a.substitute_hp == b.substitute_hp && a.disabled_move == b.disabled_move &&
+           a.encored_move == b.encored_move && a.last_move_used == b.last_move_used &&
+           a.charging_move == b.charging_move &&
+           a.physical_damage_taken == b.physical_damage_taken &&
+           a.special_damage_taken == b.special_damage_taken &&
+           a.physical_attacker == b.physical_attacker &&
+           a.special_attacker == b.special_attacker && a.infatuated_with == b.infatuated_with &&
+           a.leech_seed_target == b.leech_seed_target && a.trapped_by == b.trapped_by &&
+           a.is_first_turn == b.is_first_turn && a.moved_this_turn == b.moved_this_turn &&
+           a.bounce_move == b.bounce_move && a.held_item == b.held_item &&
+           a.item_consumed == b.item_consumed && a.item_events == b.item_events &&
+           a.effective_speed == b.effective_speed && a.party_index == b.party_index &&
+           a.speed_dirty == b.speed_dirty;
+}
+
+constexpr bool same_mon(const MonState& a, const MonState& b) {
+    for (size_t i = 0; i < 4; ++i) {
+        if (a.pp[i] != b.pp[i])
+            return false;
+    }
+    return a.current_hp == b.current_hp && a.max_hp == b.max_hp && a.status == b.status &&
+           a.sleep_turns == b.sleep_turns && a.toxic_counter == b.toxic_counter &&
+           a.item_consumed == b.item_consumed;
+}
+
+/// A fresh slot and one with every field at its packed maximum round-trip
+constexpr bool packed_slot_round_trips() {
+    SlotState extreme{};
+    extreme.atk_stage = 6;
+    extreme.def_stage = -6;
+    extreme.spd_stage = 6;
+    extreme.sp_atk_stage = -6;
+    extreme.sp_def_stage = 6;
+    extreme.accuracy_stage = -6;
+    extreme.evasion_stage = 6;
+    extreme.volatiles = 0x7FFFFFFF;
+    extreme.confusion_turns = 7;
+    extreme.wrap_expiry = 255;
+    extreme.taunt_expiry = 255;
+    extreme.encore_expiry = 255;
+    extreme.disable_expiry = 255;
+    extreme.perish_expiry = 255;
+    extreme.stockpile_count = 3;
+    extreme.fury_cutter_power = 0xFF;
+    extreme.rollout_hits = 7;
+    extreme.yawn_expiry = 255;
+    extreme.substitute_hp = 0xFF;
+    extreme.disabled_move = 0xFF;
+    extreme.encored_move = 0xFF;
+    extreme.last_move_used = 0xFF;
+    extreme.charging_move = 0xFF;
+    extreme.physical_damage_taken = 1023;
+    extreme.special_damage_taken = 1023;
+    extreme.physical_attacker = 6;
+    extreme.special_attacker = 0;
+    extreme.infatuated_with = 6;
+    extreme.leech_seed_target = 1;
+    extreme.trapped_by = 6;
+    extreme.is_first_turn = false;
+    extreme.moved_this_turn = true;
+    extreme.bounce_move = true;
+    extreme.held_item = types::enums::Item::WHITE_HERB;
+    extreme.item_consumed = true;
+    extreme.effective_speed = 2047;
+    extreme.party_index = dsl::MAX_PARTY_SIZE - 1;
+    extreme.speed_dirty = false;
+
+    SlotState holding{};
+    holding.held_item = types::enums::Item::LEFTOVERS;
+    holding.item_events = dsl::item::item_event_mask(holding.held_item);
+
+    const SlotState fresh{};
+    return packable(fresh) && same_slot(unpack(pack(fresh)), fresh) && packable(extreme) &&
+           same_slot(unpack(pack(extreme)), extreme) && same_slot(unpack(pack(holding)), holding);
+}
+
+constexpr bool packed_mon_round_trips() {
+    const MonState fresh{};
+    MonState extreme{};
+    extreme.current_hp = 1023;
+    extreme.max_hp = 1023;
+    extreme.status = Status::TOXIC;
+    extreme.sleep_turns = 7;
+    extreme.toxic_counter = 15;
+    extreme.pp[0] = 127;
+    extreme.pp[1] = 64;
+    extreme.pp[2] = 0;
+    extreme.pp[3] = 1;
+    return packable(fresh) && same_mon(unpack(pack(fresh)), fresh) && packable(extreme) &&
+           same_mon(unpack(pack(extreme)), extreme);
+}
+
+static_assert(packed_slot_round_trips(), "a SlotState field does not survive packing");
+static_assert(packed_mon_round_trips(), "a MonState field does not survive packing");
+
+}  // namespace logic::state
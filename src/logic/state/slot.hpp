@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "event_queue.hpp"
+#include "journal.hpp"
 #include "types/enums/item.hpp"
 
 namespace logic::state {
@@ -11,7 +13,8 @@ namespace logic::state {
 // ============================================================================
 //
 // Domain 3: Per-battle-position state.
-// Count: 4 (slots 0,2 for singles; 0,1,2,3 for doubles)
+// Count: one per battler in play (dsl::Singles: slots 0-1, even slots are
+// player 1's)
 // Lifecycle: CLEARED WHEN POKEMON SWITCHES OUT
 //
 // This is the critical distinction from MonState. Stat stages, confusion,
@@ -61,6 +64,10 @@ constexpr uint32_t BATON_PASS_MASK = CONFUSED | FOCUS_ENERGY | SUBSTITUTE | LEEC
                                      TRAPPED | INGRAINED | PERISH_SONG | LOCK_ON;
 }  // namespace volatile_flags
 
+// SlotState::staged_stats entries (Atk, Def, SpAtk, SpDef) and the key of an empty one
+inline constexpr uint8_t STAGED_STAT_COUNT = 4;
+inline constexpr int8_t STAGE_UNCACHED = INT8_MIN;
+
 struct SlotState {
     // Stat stages (-6 to +6, with 0 = neutral)
     int8_t atk_stage{0};
@@ -74,17 +81,18 @@ struct SlotState {
     // Volatile status bitfield
     uint32_t volatiles{0};
 
-    // Volatile counters
+    // Volatile counters (the *_expiry timers hold the turn they run out on,
+    // see field.hpp; confusion counts down as the mon tries to move)
     uint8_t confusion_turns{0};
-    uint8_t wrap_turns{0};
-    uint8_t taunt_turns{0};
-    uint8_t encore_turns{0};
-    uint8_t disable_turns{0};
-    uint8_t perish_count{0};
+    uint8_t wrap_expiry{0};
+    uint8_t taunt_expiry{0};
+    uint8_t encore_expiry{0};
+    uint8_t disable_expiry{0};
+    uint8_t perish_expiry{0};
     uint8_t stockpile_count{0};
     uint8_t fury_cutter_power{0};
     uint8_t rollout_hits{0};
-    uint8_t yawn_turns{0};
+    uint8_t yawn_expiry{0};
 
     // Substitute
     uint16_t substitute_hp{0};
@@ -111,17 +119,55 @@ struct SlotState {
     bool moved_this_turn{false};
     bool bounce_move{false};  // Magic Coat: reflect eligible status moves
 
-    // Held item (copied from rental on switch-in, cleared on consumption)
+    // Held item (copied from rental on switch-in, cleared on consumption).
+    // item_events caches dsl::item::item_event_mask(held_item) and is 0 once
+    // the item is consumed; fire sites test it instead of the item itself.
     types::enums::Item held_item{types::enums::Item::NONE};
     bool item_consumed{false};
+    uint8_t item_events{0};
+
+    // Turn-order cache (calc::cached_effective_speed): effective_speed is
+    // valid while speed_dirty is false. Anything that changes spd_stage, the
+    // mon's paralysis or a speed-affecting item must call mark_speed_dirty().
+    // A fresh / switched-in slot starts dirty.
+    uint16_t effective_speed{0};
+    bool speed_dirty{true};
+
+    // Party member in this position (index into its side's dsl::Party);
+    // set by the switch-in after the clear
+    uint8_t party_index{0};
+
+    // Stage-applied stat cache (calc::cached_staged_stat): staged_stats[s] is
+    // the active mon's raw Atk / Def / SpAtk / SpDef (calc::StagedStat order)
+    // at stage staged_at[s]. An entry is current while staged_at[s] is the
+    // stat's stage, so the stage writers (stat ops, Haze, Baton Pass, stat
+    // berries, Intimidate) need no invalidation call. A fresh / switched-in
+    // slot starts with none (STAGE_UNCACHED). Kept last so the hashed
+    // fields' offsets (and with them their hash keys) do not move.
+    uint16_t staged_stats[STAGED_STAT_COUNT]{};
+    int8_t staged_at[STAGED_STAT_COUNT]{STAGE_UNCACHED, STAGE_UNCACHED, STAGE_UNCACHED,
+                                        STAGE_UNCACHED};
 
     // Helpers
     constexpr bool has(uint32_t flag) const { return volatiles & flag; }
-    constexpr void set(uint32_t flag) { volatiles |= flag; }
-    constexpr void clear(uint32_t flag) { volatiles &= ~flag; }
+    constexpr void set(uint32_t flag) { assign(volatiles, volatiles | flag); }
+    constexpr void clear(uint32_t flag) { assign(volatiles, volatiles & ~flag); }
+    constexpr void mark_speed_dirty() { assign(speed_dirty, true); }
+
+    // Use up the held item: no item event fires for this slot again
+    constexpr void consume_item() {
+        if !consteval {
+            events::emit_for(EventType::ITEM, *this, static_cast<uint16_t>(held_item));
+        }
+        assign(item_consumed, true);
+        assign(item_events, uint8_t{0});
+    }
 
     // Clear for switch-out (normal)
-    constexpr void clear_on_switch() { *this = SlotState{}; }
+    constexpr void clear_on_switch() {
+        touch(*this);
+        *this = SlotState{};
+    }
 
     // Clear for switch-out (Baton Pass - preserve transferable state)
     constexpr void clear_for_baton_pass() {
@@ -129,9 +175,10 @@ struct SlotState {
         int8_t preserved_stages[] = {atk_stage,    def_stage,      spd_stage,    sp_atk_stage,
                                      sp_def_stage, accuracy_stage, evasion_stage};
         uint16_t preserved_sub_hp = substitute_hp;
-        uint8_t preserved_perish = perish_count;
+        uint8_t preserved_perish = perish_expiry;
         uint8_t preserved_leech = leech_seed_target;
 
+        touch(*this);
         *this = SlotState{};
 
         volatiles = preserved_volatiles;
@@ -143,7 +190,7 @@ struct SlotState {
         accuracy_stage = preserved_stages[5];
         evasion_stage = preserved_stages[6];
         substitute_hp = preserved_sub_hp;
-        perish_count = preserved_perish;
+        perish_expiry = preserved_perish;
         leech_seed_target = preserved_leech;
     }
 
@@ -152,12 +199,12 @@ struct SlotState {
         clear(volatile_flags::PROTECTED);
         clear(volatile_flags::ENDURED);
         clear(volatile_flags::FLINCHED);
-        physical_damage_taken = 0;
-        special_damage_taken = 0;
-        physical_attacker = 0xFF;
-        special_attacker = 0xFF;
-        moved_this_turn = false;
-        bounce_move = false;
+        assign(physical_damage_taken, 0);
+        assign(special_damage_taken, 0);
+        assign(physical_attacker, 0xFF);
+        assign(special_attacker, 0xFF);
+        assign(moved_this_turn, false);
+        assign(bounce_move, false);
     }
 };
 
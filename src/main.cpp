@@ -30,25 +30,46 @@
 
 \*                                                                                      */
 
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "engine/delta_store.hpp"
+#include "engine/opponent_model.hpp"
+#include "engine/outcomes.hpp"
+#include "engine/policy.hpp"
+#include "engine/resumable_search.hpp"
+#include "engine/simulate.hpp"
 #include "logic/routines/all.hpp"
 #include "logic/setup/rental.hpp"
+#include "logic/setup/rental_index.hpp"
 #include "types/models/move.hpp"
+#include "util/arena.hpp"
+#include "util/profile.hpp"
 
 // Smoke test: instantiate and execute effects to verify wiring/compilation.
 namespace {
 
+// Session memory: the search, its table, outcome buffers and search nodes
+// all come out of this block, so the session's RAM ceiling is fixed at link
+// time and nothing calls malloc
+constexpr size_t SESSION_ARENA_BYTES = 16 * 1024;
+util::arena::StaticArena<SESSION_ARENA_BYTES> g_session_arena;
+
 template <typename Effect>
 void run_effect() {
     using namespace logic;
     using types::enums::Type;
 
     dsl::BattleContext ctx{};
-    state::FieldState field{};
-    state::SideState side1{}, side2{};
-    state::SlotState slot1{}, slot2{};
-    state::MonState mon1{}, mon2{};
-    dsl::ActiveMon active1{}, active2{};
-    types::Move move{};
+    dsl::BattleState battle{};
+    state::MonState& mon1 = battle.parties[0].mons[0];
+    state::MonState& mon2 = battle.parties[1].mons[0];
+    dsl::ActiveMon& active1 = battle.parties[0].active[0];
+    dsl::ActiveMon& active2 = battle.parties[1].active[0];
+    types::MoveHot move{};
+    util::random::Rng rng{};
+
+    rng.seed(0x12345678);
+    ctx.rng = &rng;
 
     move.power = 40;
     move.accuracy = 100;
@@ -63,8 +84,7 @@ void run_effect() {
     active1.sp_attack = 100;
     active1.sp_defense = 100;
     active1.speed = 100;
-    active1.type1 = Type::NORMAL;
-    active1.type2 = Type::NONE;
+    active1.set_types(Type::NORMAL, Type::NONE);
 
     active2.level = 50;
     active2.attack = 100;
@@ -72,25 +92,10 @@ void run_effect() {
     active2.sp_attack = 100;
     active2.sp_defense = 100;
     active2.speed = 100;
-    active2.type1 = Type::NORMAL;
-    active2.type2 = Type::NONE;
-
-    ctx.field = &field;
-    ctx.attacker_side = &side1;
-    ctx.defender_side = &side2;
-    ctx.attacker_slot = &slot1;
-    ctx.defender_slot = &slot2;
-    ctx.attacker_mon = &mon1;
-    ctx.defender_mon = &mon2;
-    ctx.attacker_active = &active1;
-    ctx.defender_active = &active2;
-
-    // Set up slots array for all-battler iteration
-    ctx.slots[0] = &slot1;
-    ctx.slots[1] = &slot2;
-    ctx.mons[0] = &mon1;
-    ctx.mons[1] = &mon2;
-    ctx.active_slot_count = 2;
+    active2.set_types(Type::NORMAL, Type::NONE);
+
+    ctx.state = &battle;
+    ctx.set_battlers(0, 1);
 
     // Capture deltas for contract-style smoke; prevent unused warnings
     uint16_t atk_hp_before = mon1.current_hp;
@@ -139,8 +144,7 @@ inline void rental_smoke_test() {
     using namespace logic::setup;
 
     // Test with first rental (Abra)
-    const types::Rental& rental = data::g_RENTAL_SETS[0];
-    RentalSetup setup = setup_rental(rental, 50);
+    RentalSetup setup = setup_rental(size_t{0}, 50);
 
     // Verify setup produced valid values
     volatile uint16_t hp = setup.mon.max_hp;
@@ -152,27 +156,137 @@ inline void rental_smoke_test() {
 
     // Test full battle setup
     dsl::BattleContext ctx{};
-    logic::state::FieldState field{};
-    logic::state::SideState side1{}, side2{};
-
-    ctx.field = &field;
-    ctx.attacker_side = &side1;
-    ctx.defender_side = &side2;
-
-    RentalSetup attacker_setup{}, defender_setup{};
-    setup_battle(ctx, data::g_RENTAL_SETS[0], data::g_RENTAL_SETS[1], attacker_setup,
-                 defender_setup, 50);
+    dsl::BattleState state{};
+    setup_battle(ctx, state, data::rental(0), data::rental(1), 50);
 
     // Verify context was wired up
-    volatile bool valid = (ctx.attacker_mon != nullptr) && (ctx.defender_mon != nullptr) &&
-                          (ctx.attacker_active != nullptr);
+    volatile bool valid = (ctx.state == &state) && (ctx.defender_mon()->max_hp > 0) &&
+                          (ctx.attacker().attack > 0);
     (void)valid;
+
+    // Inverted indexes: Earthquake users holding Leftovers
+    RentalSet candidates = RentalSet::of(rentals_with_move(types::enums::Move::EARTHQUAKE));
+    candidates.intersect(rentals_with_item(types::enums::Item::LEFTOVERS));
+    volatile uint16_t matches = candidates.count();
+    (void)matches;
+
+    // Opponent inference: species on send-out, then a move
+    engine::OpponentModel opponent;
+    const types::Rental seen = data::rental(1);
+    opponent.observe_species(seen.species);
+    opponent.observe_move(seen.moves[0]);
+    volatile uint16_t consistent = opponent.count();
+    (void)consistent;
+}
+
+inline void search_smoke_test() {
+    using Searcher = engine::ai::Searcher<engine::CalcTranspositionTable>;
+    util::arena::Arena& arena = g_session_arena;
+
+    // Tuned leaf weights when the BMEVAL AppVar is on the calculator
+    static engine::ai::EvalWeights weights = engine::ai::DEFAULT_EVAL_WEIGHTS;
+    engine::ai::load_eval_weights(weights);
+    engine::ai::SearchLimits limits{1, 1};
+    limits.weights = &weights;
+
+    // Turn-1 book (BMBOOK): a booked opening is a binary search, not a search
+    static engine::book::OpeningBook book;
+    if (book.open(50))
+        limits.book = &book;
+
+    // One shallow decision on the calculator-sized table
+    auto* table = arena.create<engine::CalcTranspositionTable>();
+    auto* searcher = table ? arena.create<Searcher>(*table, limits) : nullptr;
+    if (!searcher)
+        return;
+
+    engine::BattleEngine battle{};
+    battle.init(uint16_t{0}, uint16_t{1}, 50, 0x12345678u);
+
+    volatile uint8_t depth = searcher->search(battle, 0).depth;
+    (void)depth;
+
+    // Per-turn scratch (outcomes, search nodes), dropped together
+    const util::arena::Arena::Marker turn = arena.mark();
+    constexpr uint16_t outcome_capacity = 8;
+    auto* outcomes = arena.allocate<engine::TurnOutcome>(outcome_capacity);
+    engine::DeltaStore nodes = engine::make_delta_store(arena, 32, 256, 4);
+    if (outcomes) {
+        const engine::TurnEnumeration turn_outcomes =
+            engine::enumerate_turn(battle, engine::BattleAction::move(0),
+                                   engine::BattleAction::move(0), outcomes, outcome_capacity);
+        const uint32_t root = nodes.add_root(battle.save());
+        for (uint16_t i = 0; i < turn_outcomes.count && root != engine::DeltaStore::NO_NODE; ++i) {
+            nodes.add_child(root, outcomes[i].state);
+        }
+    }
+    volatile uint32_t stored = nodes.node_count();
+    (void)stored;
+    arena.reset(turn);
+
+    // The UI's think: the same decision in one-frame slices (30 FPS), the
+    // screen redrawn from best_action() between them
+    using Stepper = engine::ai::ResumableSearcher<engine::CalcTranspositionTable>;
+    util::platform::start_cycle_counter();
+    const uint32_t frame_cycles = util::platform::cycle_counter_hz() / 30;
+    const util::arena::Arena::Marker think = arena.mark();
+    if (auto* stepper = arena.create<Stepper>(*table, limits)) {
+        stepper->start(battle, 0);
+        while (!stepper->step(frame_cycles)) {
+            volatile uint8_t shown = stepper->best_action().index;
+            (void)shown;
+        }
+        volatile uint8_t chosen = stepper->result().action.index;
+        (void)chosen;
+    }
+    arena.reset(think);
+
+    // The UI's turn: execute it, then play its events back one per animation
+    logic::state::EventQueue events;
+    battle.attach_events(&events);
+    battle.execute_turn(engine::BattleAction::move(0), engine::BattleAction::move(0));
+    logic::state::BattleEvent event;
+    while (events.pop(event)) {
+        volatile uint16_t shown = event.value;
+        (void)shown;
+    }
+    battle.attach_events(nullptr);
+}
+
+#if BATTLEMON_PROFILE
+// Profiling build: play a fixed set of battles and dump section timings to
+// the BMPROF AppVar (print it on host with battlemon_profile)
+constexpr uint16_t PROFILE_BATTLES = 64;
+constexpr uint64_t PROFILE_SEED = 0x50524F46;
+
+inline void profile_battles() {
+    constexpr auto rental_count = static_cast<uint16_t>(logic::setup::RENTAL_COUNT);
+
+    util::profile::start();
+
+    util::random::Rng rng{};
+    rng.seed(PROFILE_SEED, 1);
+
+    engine::BattleEngine battle{};
+    for (uint16_t i = 0; i < PROFILE_BATTLES; ++i) {
+        const uint16_t p1 = rng.random(rental_count);
+        const uint16_t p2 = rng.random(rental_count);
+        battle.init(p1, p2, 50, rng.split(i));
+        engine::run_battle(battle, engine::random_move_policy, engine::random_move_policy, rng);
+    }
+
+    util::profile::dump();
 }
+#endif
 
 }  // namespace
 
 int main() {
     smoke_test();
     rental_smoke_test();
+    search_smoke_test();
+#if BATTLEMON_PROFILE
+    profile_battles();
+#endif
     return 0;
 }
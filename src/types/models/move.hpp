@@ -73,4 +73,40 @@ struct Move {
 using MoveFlags = Move::Flags;
 using MoveTarget = Move::Target;
 
+// ============================================================
+//                     Hot / Cold Move Rows
+// ============================================================
+//
+// Move is the authoring row of data::g_MOVE_TABLE. The battle engine reads
+// moves through two tables derived from it at compile time:
+//   - MoveHot:  every field turn order, accuracy, damage and dispatch read
+//   - MoveCold: the rest (display, PP, secondary-effect chance, targeting)
+// Both are indexed by enums::Move.
+
+struct MoveHot {
+    enums::Type type;
+    uint8_t power;
+    uint8_t accuracy;
+    int8_t priority;
+    enums::Effect effect;
+    Move::Flags flags;
+};
+
+static_assert(sizeof(MoveHot) == 6, "hot move rows are 6 bytes");
+
+struct MoveCold {
+    enums::Move id;
+    uint8_t pp;
+    uint8_t effect_chance;
+    Move::Target target;
+};
+
+constexpr MoveHot hot_row(const Move& move) {
+    return {move.type, move.power, move.accuracy, move.priority, move.effect, move.flags};
+}
+
+constexpr MoveCold cold_row(const Move& move) {
+    return {move.id, move.pp, move.effect_chance, move.target};
+}
+
 }  // namespace types
\ No newline at end of file
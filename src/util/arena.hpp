@@ -0,0 +1,187 @@
+/**
+ * @file arena.hpp
+ * @brief Fixed-capacity bump arena and typed node pools
+ *
+ * Nothing in the engine touches the heap: the CE toolchain's malloc is slow
+ * and fragments, and a battle session should have a memory ceiling known up
+ * front. Components that need scratch or node storage take caller-owned
+ * arrays (BattleLogWriter, KeyframeIndex, DeltaStore, enumerate_turn), and
+ * these are the two ways to carve those arrays out of one static block:
+ *
+ *   Arena         bump allocator over a buffer. mark() / reset(mark) free
+ *                 everything allocated since the mark in O(1), so per-turn
+ *                 or per-search scratch is allocated after a mark and
+ *                 dropped in one step. StaticArena<Bytes> owns its buffer.
+ *   Pool<T, N>    N objects of one type with a free list, for nodes that
+ *                 are released individually. Sized at compile time.
+ *
+ * Both hand out trivially destructible objects only (reset runs no
+ * destructors) and report exhaustion with nullptr rather than growing.
+ * high_water() records the most ever in use, so a session can be sized
+ * from a host run of the same workload.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace util::arena {
+
+class Arena {
+   public:
+    /// Position to return to with reset()
+    using Marker = size_t;
+
+    /**
+     * @param buffer Backing storage (aligned for anything allocated from it)
+     * @param capacity Length of buffer in bytes
+     */
+    Arena(void* buffer, size_t capacity)
+        : base_(static_cast<unsigned char*>(buffer)), capacity_(capacity) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Value-initialized array of `count` T.
+     *
+     * @return nullptr if the arena cannot fit it (nothing is allocated)
+     */
+    template <typename T>
+    T* allocate(size_t count = 1) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        if (count > capacity_ / sizeof(T))
+            return nullptr;
+        T* first = static_cast<T*>(reserve(count * sizeof(T), alignof(T)));
+        if (!first)
+            return nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            ::new (static_cast<void*>(first + i)) T{};
+        }
+        return first;
+    }
+
+    /**
+     * @brief One T constructed from `args` (for objects without a default state).
+     *
+     * @return nullptr if the arena cannot fit it
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        void* slot = reserve(sizeof(T), alignof(T));
+        return slot ? ::new (slot) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    [[nodiscard]] Marker mark() const { return used_; }
+
+    /// Free everything allocated after `marker`
+    void reset(Marker marker) { used_ = marker < used_ ? marker : used_; }
+
+    /// Free everything
+    void reset() { used_ = 0; }
+
+    [[nodiscard]] size_t used() const { return used_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    [[nodiscard]] size_t remaining() const { return capacity_ - used_; }
+    [[nodiscard]] size_t high_water() const { return high_water_; }
+
+   private:
+    void* reserve(size_t bytes, size_t align) {
+        const auto address = reinterpret_cast<uintptr_t>(base_ + used_);
+        const size_t padding = (align - address % align) % align;
+        if (padding > capacity_ - used_ || bytes > capacity_ - used_ - padding)
+            return nullptr;
+
+        void* first = base_ + used_ + padding;
+        used_ += padding + bytes;
+        if (used_ > high_water_)
+            high_water_ = used_;
+        return first;
+    }
+
+    unsigned char* base_;
+    size_t capacity_;
+    size_t used_{0};
+    size_t high_water_{0};
+};
+
+/// Arena with its own `Bytes`-byte buffer (e.g. a static session block)
+template <size_t Bytes>
+class StaticArena : public Arena {
+   public:
+    StaticArena() : Arena(storage_, Bytes) {}
+
+   private:
+    alignas(std::max_align_t) unsigned char storage_[Bytes];
+};
+
+/**
+ * @brief `N` objects of type T, acquired and released individually.
+ *
+ * Free slots are chained by index, so acquire() and release() are O(1)
+ * and a pool is a plain array plus one index per slot.
+ */
+template <typename T, size_t N>
+class Pool {
+    static_assert(std::is_trivially_destructible_v<T>, "pool objects are never destroyed");
+    static_assert(N > 0 && N < UINT16_MAX, "pool slots are indexed by uint16_t");
+
+   public:
+    static constexpr size_t CAPACITY = N;
+    static constexpr uint16_t NONE = UINT16_MAX;
+
+    Pool() { reset(); }
+
+    /// Release every object
+    void reset() {
+        for (size_t i = 0; i < N; ++i) {
+            next_[i] = static_cast<uint16_t>(i + 1 < N ? i + 1 : NONE);
+        }
+        free_ = 0;
+        in_use_ = 0;
+    }
+
+    /// A value-initialized object, or nullptr if all N are in use
+    T* acquire() {
+        if (free_ == NONE)
+            return nullptr;
+        const uint16_t index = free_;
+        free_ = next_[index];
+        next_[index] = NONE;
+        if (++in_use_ > high_water_)
+            high_water_ = in_use_;
+        items_[index] = T{};
+        return &items_[index];
+    }
+
+    /// @pre `item` came from acquire() and was not released since
+    void release(T* item) {
+        const uint16_t index = index_of(item);
+        next_[index] = free_;
+        free_ = index;
+        --in_use_;
+    }
+
+    [[nodiscard]] uint16_t index_of(const T* item) const {
+        return static_cast<uint16_t>(item - items_);
+    }
+    [[nodiscard]] T& operator[](uint16_t index) { return items_[index]; }
+    [[nodiscard]] const T& operator[](uint16_t index) const { return items_[index]; }
+
+    [[nodiscard]] uint16_t in_use() const { return in_use_; }
+    [[nodiscard]] uint16_t high_water() const { return high_water_; }
+
+   private:
+    T items_[N]{};
+    uint16_t next_[N];
+    uint16_t free_{NONE};
+    uint16_t in_use_{0};
+    uint16_t high_water_{0};
+};
+
+}  // namespace util::arena
@@ -0,0 +1,68 @@
+/**
+ * @file bitpack.hpp
+ * @brief Fixed-layout bit fields over little-endian byte arrays
+ *
+ * Packed records (rentals, search-node slot and mon state) describe each
+ * field as a bit offset and width into a byte array. Fields are laid out so
+ * that none spans more than two bytes: reading one is a 16-bit load, shift
+ * and mask, with no 32- or 64-bit shifts (library calls on the eZ80).
+ * read() and write() check that at compile time.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace util::bitpack {
+
+/// Bit offset and width of one packed field
+struct Field {
+    unsigned offset;
+    unsigned width;
+};
+
+/// `value` is representable in `field`
+constexpr bool fits(unsigned value, Field field) { return value < (1u << field.width); }
+
+/// First bit after `field`
+constexpr unsigned end(Field field) { return field.offset + field.width; }
+
+/// The `width`-bit field right after `previous` (for chaining layouts)
+constexpr Field after(Field previous, unsigned width) { return {end(previous), width}; }
+
+/// Read one field (at most 16 bits, within two bytes)
+template <Field F, size_t N>
+constexpr unsigned read(const uint8_t (&bytes)[N]) {
+    constexpr unsigned byte = F.offset / 8;
+    constexpr unsigned shift = F.offset % 8;
+    static_assert(shift + F.width <= 16, "field spans more than two bytes");
+    static_assert(byte + (shift + F.width > 8) < N, "field past the end of the record");
+
+    unsigned bits = bytes[byte];
+    if constexpr (shift + F.width > 8) {
+        bits |= static_cast<unsigned>(bytes[byte + 1]) << 8;
+    }
+    return (bits >> shift) & ((1u << F.width) - 1);
+}
+
+/**
+ * @brief Store `value` into one field of a zeroed record.
+ *
+ * @pre fits(value, F) and the field's bits are still 0
+ */
+template <Field F, size_t N>
+constexpr void write(uint8_t (&bytes)[N], unsigned value) {
+    constexpr unsigned byte = F.offset / 8;
+    constexpr unsigned shift = F.offset % 8;
+    static_assert(shift + F.width <= 16, "field spans more than two bytes");
+    static_assert(byte + (shift + F.width > 8) < N, "field past the end of the record");
+
+    const unsigned bits = value << shift;
+    bytes[byte] = static_cast<uint8_t>(bytes[byte] | bits);
+    if constexpr (shift + F.width > 8) {
+        bytes[byte + 1] = static_cast<uint8_t>(bytes[byte + 1] | (bits >> 8));
+    }
+}
+
+}  // namespace util::bitpack
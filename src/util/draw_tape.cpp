@@ -0,0 +1,132 @@
+#include "draw_tape.hpp"
+
+namespace util {
+namespace random {
+
+DrawTape::Branch* DrawTape::step(uint16_t outcomes, uint16_t median) {
+    if (cursor_ < depth_) {
+        return &path_[cursor_++];  // Replaying the prefix of the current leaf
+    }
+    if (depth_ == MAX_BRANCHES) {
+        overflowed_ = true;
+        return nullptr;
+    }
+    path_[depth_] = Branch{outcomes, mode_ == Mode::MEDIAN ? median : uint16_t{0}, 0};
+    ++depth_;
+    return &path_[cursor_++];
+}
+
+uint16_t DrawTape::uniform(uint16_t max) {
+    if (max <= 1)
+        return 0;
+    Branch* branch = step(max, static_cast<uint16_t>((max - 1) / 2));
+    if (!branch)
+        return 0;
+    branch->probability = ratio(1, max);
+    return branch->taken;
+}
+
+bool DrawTape::chance(uint16_t numerator, uint16_t denominator) {
+    if (numerator == 0)
+        return false;
+    if (numerator >= denominator)
+        return true;
+    // Outcome 0 is success: the median when it is at least as likely as failure
+    Branch* branch = step(2, 2u * numerator >= denominator ? 0 : 1);
+    if (!branch)
+        return true;
+    const bool success = branch->taken == 0;
+    branch->probability = ratio(success ? numerator : denominator - numerator, denominator);
+    return success;
+}
+
+uint16_t DrawTape::grouped(uint16_t max, const uint32_t* classes) {
+    // Classes in order of first appearance, and the middle value's class
+    const uint16_t middle = static_cast<uint16_t>((max - 1) / 2);
+    uint16_t firsts[MAX_GROUPED];
+    uint16_t counts[MAX_GROUPED];
+    uint16_t distinct = 0;
+    uint16_t median = 0;
+    for (uint16_t v = 0; v < max; ++v) {
+        uint16_t c = 0;
+        while (c < distinct && classes[firsts[c]] != classes[v]) {
+            ++c;
+        }
+        if (c == distinct) {
+            firsts[distinct] = v;
+            counts[distinct++] = 0;
+        }
+        ++counts[c];
+        if (v == middle)
+            median = c;
+    }
+    if (distinct <= 1)
+        return 0;
+
+    Branch* branch = step(distinct, median);
+    if (!branch)
+        return 0;
+    branch->probability = ratio(counts[branch->taken], max);
+    return firsts[branch->taken];
+}
+
+uint16_t DrawTape::weighted(uint16_t count, const Probability* weights) {
+    uint16_t outcomes = 0;
+    uint16_t first = 0;
+    uint64_t total = 0;
+    for (uint16_t v = 0; v < count; ++v) {
+        if (weights[v] == 0)
+            continue;
+        if (outcomes++ == 0)
+            first = v;
+        total += weights[v];
+    }
+    if (outcomes <= 1)
+        return first;
+
+    uint16_t median = 0;
+    uint64_t cumulative = 0;
+    for (uint16_t v = 0; v < count; ++v) {
+        if (weights[v] == 0)
+            continue;
+        cumulative += weights[v];
+        if (2 * cumulative >= total)
+            break;
+        ++median;
+    }
+
+    Branch* branch = step(outcomes, median);
+    if (!branch)
+        return first;
+    uint16_t v = first;
+    for (uint16_t k = 0;; ++v) {
+        if (weights[v] != 0 && k++ == branch->taken)
+            break;
+    }
+    branch->probability = weights[v];
+    return v;
+}
+
+bool DrawTape::advance() {
+    cursor_ = 0;
+    if (mode_ == Mode::MEDIAN)
+        return false;
+    while (depth_ > 0) {
+        Branch& last = path_[depth_ - 1];
+        if (++last.taken < last.outcomes)
+            return true;
+        --depth_;
+    }
+    return false;
+}
+
+Probability DrawTape::probability() const {
+    Probability p = PROBABILITY_ONE;
+    for (uint8_t i = 0; i < depth_; ++i) {
+        p = multiply(p, path_[i].probability);
+    }
+    return p;
+}
+
+}  // namespace random
+}  // namespace util
@@ -0,0 +1,147 @@
+/**
+ * @file draw_tape.hpp
+ * @brief Enumerated random draws (every outcome of a turn instead of one)
+ *
+ * While a DrawTape is installed (TapeScope), Rng::random(), Rng::chance() and
+ * Rng::random_grouped() stop returning PCG output and return the outcome the
+ * tape selects instead. The first execution of a turn takes outcome 0 of
+ * every draw and records each draw as a branch; advance() then steps the
+ * branches like an odometer, so re-executing the turn from the same state
+ * until advance() returns false visits every leaf of the turn's draw tree
+ * exactly once. probability() is the leaf's weight.
+ *
+ * The generator still steps once per draw, so draw counts (and RNG state
+ * after the turn) are the same as without a tape.
+ *
+ * Branches are as narrow as the call site allows: chance(n, d) is a
+ * two-way branch, random_grouped() merges values the caller declares
+ * interchangeable (e.g. damage rolls that deal equal damage), and
+ * random_weighted() branches once per outcome of a distribution the caller
+ * computed in closed form (a multi-hit move's total damage).
+ *
+ * A MEDIAN tape walks one leaf instead of them all: every draw takes its
+ * median outcome (a chance() of at least one half succeeds, a uniform draw
+ * returns its middle value, a damage roll the middle roll), and advance()
+ * returns false at once. That is the deterministic line a damage preview
+ * shows; probability() is still the weight of that leaf.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "platform.hpp"
+
+namespace util {
+namespace random {
+
+/// Probability in fixed point: PROBABILITY_ONE = 1.0
+using Probability = uint32_t;
+inline constexpr Probability PROBABILITY_ONE = 1u << 30;
+
+/// p * q in fixed point
+constexpr Probability multiply(Probability p, Probability q) {
+    return static_cast<Probability>((static_cast<uint64_t>(p) * q) >> 30);
+}
+
+/// numerator / denominator in fixed point
+constexpr Probability ratio(uint32_t numerator, uint32_t denominator) {
+    return static_cast<Probability>(static_cast<uint64_t>(PROBABILITY_ONE) * numerator /
+                                    denominator);
+}
+
+class DrawTape {
+   public:
+    static constexpr uint8_t MAX_BRANCHES = 32;  // Draws per turn that can branch
+    static constexpr uint8_t MAX_GROUPED = 16;   // Largest random_grouped() support
+
+    enum class Mode : uint8_t {
+        ENUMERATE,  // Every leaf, outcome 0 of each draw first
+        MEDIAN,     // One leaf: the median outcome of each draw
+    };
+
+    constexpr DrawTape() = default;
+    explicit constexpr DrawTape(Mode mode) : mode_(mode) {}
+
+    /// Uniform draw in [0, max)
+    uint16_t uniform(uint16_t max);
+
+    /// Bernoulli draw: true with probability numerator / denominator
+    bool chance(uint16_t numerator, uint16_t denominator);
+
+    /**
+     * @brief Uniform draw in [0, max) with interchangeable values merged.
+     *
+     * @param classes classes[v] for every v < max; equal classes are one outcome
+     *
+     * @return The smallest value of the selected class
+     */
+    uint16_t grouped(uint16_t max, const uint32_t* classes);
+
+    /**
+     * @brief Draw in [0, count) with the given weights (zero weights never drawn).
+     *
+     * One branch per value of nonzero weight, taken with that weight; the
+     * median is the value where the cumulative weight passes half.
+     *
+     * @param weights weights[v] for every v < count
+     *
+     * @return The selected value
+     */
+    uint16_t weighted(uint16_t count, const Probability* weights);
+
+    /**
+     * @brief Select the next leaf; re-execute the turn from the same state after.
+     *
+     * @return false once every leaf has been visited
+     */
+    bool advance();
+
+    /// Weight of the leaf just executed
+    [[nodiscard]] Probability probability() const;
+
+    /// Draws of the current leaf that branched
+    [[nodiscard]] uint8_t depth() const { return depth_; }
+
+    /// A leaf needed more than MAX_BRANCHES branches (the excess took outcome 0)
+    [[nodiscard]] bool overflowed() const { return overflowed_; }
+
+   private:
+    struct Branch {
+        uint16_t outcomes;
+        uint16_t taken;
+        Probability probability;  // Of the taken outcome
+    };
+
+    /**
+     * @brief Branch of the draw at the cursor (nullptr if out of branches).
+     *
+     * @param median Outcome a new branch takes on a MEDIAN tape
+     */
+    Branch* step(uint16_t outcomes, uint16_t median);
+
+    Branch path_[MAX_BRANCHES]{};
+    uint8_t depth_{0};
+    uint8_t cursor_{0};
+    bool overflowed_{false};
+    Mode mode_{Mode::ENUMERATE};
+};
+
+/// Tape receiving this thread's draws (nullptr = plain PCG)
+inline constinit BATTLEMON_THREAD_LOCAL DrawTape* g_draw_tape = nullptr;
+
+/// RAII: route draws to `tape` for the lifetime of the scope
+class TapeScope {
+   public:
+    explicit TapeScope(DrawTape* tape) : previous_(g_draw_tape) { g_draw_tape = tape; }
+    ~TapeScope() { g_draw_tape = previous_; }
+
+    TapeScope(const TapeScope&) = delete;
+    TapeScope& operator=(const TapeScope&) = delete;
+
+   private:
+    DrawTape* previous_;
+};
+
+}  // namespace random
+}  // namespace util
@@ -0,0 +1,137 @@
+/**
+ * @file fastdiv.hpp
+ * @brief Division-free scaling by constant ratios
+ *
+ * The eZ80 has no hardware divider: every 32-bit `/` in the damage pipeline
+ * is a call into the toolchain's shift-subtract routine. Most of those
+ * divisions are by small constants (stat stage ratios, accuracy ratios, the
+ * 85-100% roll, the /50 in the base damage formula), so they can be replaced
+ * with a multiply and a shift.
+ *
+ * For a ratio N/D, floor(x * N / D) == (x * M) >> S holds exactly for every
+ * x up to a bound L, where M = ceil(N * 2^S / D). make_ratio() searches S for
+ * the largest L that keeps x * M inside 32 bits, and apply() falls back to
+ * the plain formula above L, so the result is bit-exact for every input.
+ *
+ * Proof sketch (D odd, after pulling powers of two out of the divisor):
+ *   x*M / 2^S = x*N/D + x*E / (D * 2^S),  E = M*D - N*2^S  (0 <= E < D)
+ *   With x*N = q*D + r, the floor stays q while r/D + x*E/(D * 2^S) < 1,
+ *   which holds for every r <= D-1 when x*E < 2^S.
+ *
+ * BATTLEMON_DIVISION_FREE selects the path (default: on for the CE, off on
+ * hosts with a hardware divider). Both paths return identical results; the
+ * DivisionFree template argument lets the host tests run the CE's path.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef BATTLEMON_DIVISION_FREE
+#if defined(__TICE__)
+#define BATTLEMON_DIVISION_FREE 1
+#else
+#define BATTLEMON_DIVISION_FREE 0
+#endif
+#endif
+
+namespace util {
+namespace fastdiv {
+
+constexpr bool ENABLED = BATTLEMON_DIVISION_FREE;
+
+/**
+ * @brief floor(x * numerator / denominator) as a multiply-shift.
+ *
+ * Valid for 0 <= x <= limit; apply() handles larger x with real division.
+ */
+struct Ratio {
+    uint32_t numerator;
+    uint32_t denominator;
+    uint32_t multiplier;
+    uint8_t shift;
+    uint32_t limit;
+};
+
+/**
+ * @brief Build the multiply-shift for numerator / denominator.
+ *
+ * @pre denominator > 0, numerator > 0
+ *
+ * @return Ratio with the largest exact range that fits 32-bit products
+ */
+consteval Ratio make_ratio(uint32_t numerator, uint32_t denominator) {
+    constexpr uint64_t U32_MAX = 0xFFFFFFFFu;
+
+    Ratio ratio{numerator, denominator, 0, 0, 0};
+
+    // Reduce, then split the denominator into odd * 2^k
+    uint32_t a = numerator;
+    uint32_t b = denominator;
+    while (b != 0) {
+        const uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    const uint64_t n = numerator / a;
+    uint64_t odd = denominator / a;
+    uint8_t k = 0;
+    while ((odd & 1u) == 0) {
+        odd >>= 1;
+        ++k;
+    }
+
+    // The original x * numerator must not overflow either
+    const uint64_t no_overflow = U32_MAX / numerator;
+
+    if (odd == 1) {
+        ratio.multiplier = static_cast<uint32_t>(n);
+        ratio.shift = k;
+        ratio.limit = static_cast<uint32_t>(U32_MAX / n < no_overflow ? U32_MAX / n : no_overflow);
+        return ratio;
+    }
+
+    for (uint8_t s = 0; s + k < 32; ++s) {
+        const uint64_t scaled = n << s;
+        const uint64_t m = (scaled + odd - 1) / odd;
+        if (m > U32_MAX)
+            break;
+
+        const uint64_t error = m * odd - scaled;
+        uint64_t limit = error == 0 ? U32_MAX : ((uint64_t{1} << s) - 1) / error;
+        if (U32_MAX / m < limit)
+            limit = U32_MAX / m;
+        if (no_overflow < limit)
+            limit = no_overflow;
+
+        if (limit > ratio.limit) {
+            ratio.multiplier = static_cast<uint32_t>(m);
+            ratio.shift = static_cast<uint8_t>(s + k);
+            ratio.limit = static_cast<uint32_t>(limit);
+        }
+    }
+    return ratio;
+}
+
+/**
+ * @brief floor(x * ratio.numerator / ratio.denominator), bit-exact.
+ */
+template <bool DivisionFree = ENABLED>
+constexpr uint32_t apply(const Ratio& ratio, uint32_t x) {
+    if (DivisionFree && x <= ratio.limit) {
+        return (x * ratio.multiplier) >> ratio.shift;
+    }
+    return x * ratio.numerator / ratio.denominator;
+}
+
+/**
+ * @brief floor(x * N / D) for a compile-time ratio.
+ */
+template <uint32_t N, uint32_t D, bool DivisionFree = ENABLED>
+constexpr uint32_t scale(uint32_t x) {
+    constexpr Ratio RATIO = make_ratio(N, D);
+    return apply<DivisionFree>(RATIO, x);
+}
+
+}  // namespace fastdiv
+}  // namespace util
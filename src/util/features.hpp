@@ -0,0 +1,47 @@
+/**
+ * @file features.hpp
+ * @brief Build profiles: which battle subsystems this build compiles in
+ *
+ * A profile is one switch that sets the defaults of the BATTLEMON_FEATURE_*
+ * flags below. Each flag can still be set on its own (-DBATTLEMON_FEATURE_X=0)
+ * on top of a profile. Every header that owns a trimmed subsystem tests the
+ * flag itself, so state structs, hash layouts, dispatch switches and their
+ * compile-time tables shrink together.
+ *
+ *   profile                            what it drops
+ *   (none, the default)                nothing
+ *   BATTLEMON_PROFILE_SINGLES_MINIMAL  everything below
+ *
+ *   BATTLEMON_FEATURE_DELAYED_EFFECTS  FieldState::future_sight and ::wish,
+ *                                      their residuals and hashed bytes
+ *   BATTLEMON_FEATURE_OFF_POOL         item handlers and effect routines that
+ *                                      no rental set (data::g_RENTAL_SETS)
+ *                                      carries; see data/pool.hpp
+ *
+ * Without BATTLEMON_FEATURE_OFF_POOL a custom rental still sets up, but an
+ * item outside the pool is inert and a move whose effect is outside it does
+ * nothing past its PP. A Factory battle never sees either.
+ *
+ * Not to be confused with BATTLEMON_PROFILE (util/profile.hpp), which times
+ * sections of an otherwise unchanged build.
+ */
+
+#pragma once
+
+#ifndef BATTLEMON_PROFILE_SINGLES_MINIMAL
+#define BATTLEMON_PROFILE_SINGLES_MINIMAL 0
+#endif
+
+#if BATTLEMON_PROFILE_SINGLES_MINIMAL
+#define BATTLEMON_FEATURE_DEFAULT 0
+#else
+#define BATTLEMON_FEATURE_DEFAULT 1
+#endif
+
+#ifndef BATTLEMON_FEATURE_DELAYED_EFFECTS
+#define BATTLEMON_FEATURE_DELAYED_EFFECTS BATTLEMON_FEATURE_DEFAULT
+#endif
+
+#ifndef BATTLEMON_FEATURE_OFF_POOL
+#define BATTLEMON_FEATURE_OFF_POOL BATTLEMON_FEATURE_DEFAULT
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file platform.cpp
+ * @brief Platform shim implementation (CE hardware or host OS)
+ */
+
+#include "platform.hpp"
+
+#if defined(__TICE__)
+#include <fileioc.h>
+#include <sys/rtc.h>
+#include <sys/timers.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#endif
+
+namespace util {
+namespace platform {
+
+uint32_t entropy_seed() {
+#if defined(__TICE__)
+    uint32_t seed = rtc_Time();
+#else
+    std::random_device device;
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    uint32_t seed = device() ^ static_cast<uint32_t>(ticks) ^ static_cast<uint32_t>(ticks >> 32);
+#endif
+    // 0 means "pick a seed for me" to util::random::Rng::seed()
+    return seed != 0 ? seed : 1u;
+}
+
+// ============================================================================
+//                             CYCLE COUNTER
+// ============================================================================
+
+#if defined(__TICE__)
+
+// Timer 1 is left to the toolchain's clock()/sleep() helpers
+constexpr uint8_t CYCLE_TIMER = 2;
+
+void start_cycle_counter() {
+    timer_Disable(CYCLE_TIMER);
+    timer_Set(CYCLE_TIMER, 0);
+    timer_Enable(CYCLE_TIMER, TIMER_CPU, TIMER_NOINT, TIMER_UP);
+}
+
+uint32_t cycle_count() {
+    return timer_GetSafe(CYCLE_TIMER, TIMER_UP);
+}
+
+uint32_t cycle_counter_hz() {
+    return 48000000u;
+}
+
+#else
+
+void start_cycle_counter() {}
+
+uint32_t cycle_count() {
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(ticks).count();
+    return static_cast<uint32_t>(ns);
+}
+
+uint32_t cycle_counter_hz() {
+    return 1000000000u;
+}
+
+#endif
+
+// ============================================================================
+//                              PERSISTENCE
+// ============================================================================
+
+bool write_appvar(const char* name, const void* data, size_t size) {
+    return write_appvar(name, nullptr, 0, data, size);
+}
+
+bool write_appvar(const char* name, const void* header, size_t header_size, const void* data,
+                  size_t size) {
+#if defined(__TICE__)
+    uint8_t handle = ti_Open(name, "w");
+    if (handle == 0) {
+        return false;
+    }
+    bool ok = header_size == 0 || ti_Write(header, header_size, 1, handle) == 1;
+    ok = ok && ti_Write(data, size, 1, handle) == 1;
+    ok = ti_SetArchiveStatus(true, handle) && ok;
+    ti_Close(handle);
+    return ok;
+#else
+    char path[32];
+    std::snprintf(path, sizeof(path), "%.8s.bin", name);
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = header_size == 0 || std::fwrite(header, 1, header_size, file) == header_size;
+    ok = ok && std::fwrite(data, 1, size, file) == size;
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+#endif
+}
+
+const void* map_appvar(const char* name, size_t& size) {
+    size = 0;
+#if defined(__TICE__)
+    uint8_t handle = ti_Open(name, "r");
+    if (handle == 0) {
+        return nullptr;
+    }
+    const void* data = ti_GetDataPtr(handle);
+    size = ti_GetSize(handle);
+    ti_Close(handle);
+    return data;
+#else
+    char path[32];
+    std::snprintf(path, sizeof(path), "%.8s.bin", name);
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info{};
+    void* data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(info.st_size);
+    return data;
+#endif
+}
+
+}  // namespace platform
+}  // namespace util
@@ -0,0 +1,104 @@
+/**
+ * @file platform.hpp
+ * @brief Platform shim for the few services the battle core needs from the OS
+ *
+ * The battle core is portable C++; everything that touches hardware or the
+ * operating system goes through this header so the same sources build for the
+ * TI-84 CE (CE toolchain, `__TICE__`) and for host machines (x86-64/ARM).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Thread-local storage for per-thread engine hooks. The CE is single-threaded
+// and its toolchain has no TLS, so it degrades to a plain global there.
+#if defined(__TICE__)
+#define BATTLEMON_THREAD_LOCAL
+#else
+#define BATTLEMON_THREAD_LOCAL thread_local
+#endif
+
+// Alignment for state blocks copied as a unit (snapshots, batch lanes). The
+// CE has no data cache, so padding there would only cost RAM.
+#if defined(__TICE__)
+#define BATTLEMON_CACHE_LINE 1
+#else
+#define BATTLEMON_CACHE_LINE 64
+#endif
+
+namespace util {
+namespace platform {
+
+/**
+ * @brief Platform entropy for seeding the RNG
+ *
+ * - TI-84 CE: real-time clock (rtc_Time())
+ * - Host: std::random_device mixed with the steady clock
+ *
+ * @return Non-deterministic 32-bit seed (never 0)
+ */
+uint32_t entropy_seed();
+
+// ============================================================================
+//                             CYCLE COUNTER
+// ============================================================================
+
+/**
+ * @brief Start the free-running counter behind cycle_count()
+ *
+ * - TI-84 CE: hardware timer 2, counting up at the CPU clock
+ * - Host: nothing to do (steady clock)
+ */
+void start_cycle_counter();
+
+/// Current counter value (wraps; subtract two reads for an interval)
+uint32_t cycle_count();
+
+/// Counter ticks per second (48 MHz on the CE, 1 GHz on host)
+uint32_t cycle_counter_hz();
+
+// ============================================================================
+//                              PERSISTENCE
+// ============================================================================
+
+/**
+ * @brief Write a blob the user can pull off the device
+ *
+ * - TI-84 CE: AppVar `name` (replaced if present, then archived)
+ * - Host: file `<name>.bin` in the working directory
+ *
+ * @param name AppVar name (at most 8 characters)
+ * @param data Bytes to write
+ * @param size Number of bytes
+ *
+ * @return true on success
+ */
+bool write_appvar(const char* name, const void* data, size_t size);
+
+/**
+ * @brief write_appvar() of `header` followed by `data`, without joining them in RAM
+ *
+ * @param header Bytes written first (a format header)
+ * @param header_size Number of header bytes
+ */
+bool write_appvar(const char* name, const void* header, size_t header_size, const void* data,
+                  size_t size);
+
+/**
+ * @brief Read-only view of a blob written by write_appvar() (or shipped with it)
+ *
+ * - TI-84 CE: the AppVar's data in place (flash when archived, so no RAM
+ *   copy); valid until the next archive write, which may garbage-collect
+ * - Host: file `<name>.bin` mapped read-only for the rest of the process
+ *
+ * @param name AppVar name (at most 8 characters)
+ * @param[out] size Number of bytes
+ *
+ * @return Pointer to the data, or nullptr if there is no such AppVar
+ */
+const void* map_appvar(const char* name, size_t& size);
+
+}  // namespace platform
+}  // namespace util
@@ -0,0 +1,72 @@
+/**
+ * @file profile.cpp
+ * @brief Section profiler storage and AppVar dump
+ */
+
+#include "profile.hpp"
+
+#include <cstring>
+
+namespace util {
+namespace profile {
+
+namespace {
+
+struct Dump {
+    DumpHeader header;
+    SectionRecord records[SECTION_COUNT];
+};
+
+BATTLEMON_THREAD_LOCAL Dump g_dump{};
+
+}  // namespace
+
+void start() {
+    platform::start_cycle_counter();
+
+    g_dump.header = DumpHeader{DUMP_MAGIC, DUMP_VERSION, SECTION_COUNT, 0,
+                               platform::cycle_counter_hz(), 0};
+    for (uint8_t i = 0; i < SECTION_COUNT; ++i) {
+        SectionRecord& rec = g_dump.records[i];
+        rec = SectionRecord{};
+        std::strncpy(rec.name, SECTION_NAMES[i], sizeof(rec.name) - 1);
+        rec.min = UINT32_MAX;
+    }
+
+    // Cheapest back-to-back read pair = fixed cost inside every sample
+    uint32_t overhead = UINT32_MAX;
+    for (uint8_t i = 0; i < 16; ++i) {
+        const uint32_t begin = platform::cycle_count();
+        const uint32_t ticks = platform::cycle_count() - begin;
+        if (ticks < overhead)
+            overhead = ticks;
+    }
+    g_dump.header.overhead = overhead;
+}
+
+void record(Section section, uint32_t ticks) {
+    SectionRecord& rec = g_dump.records[static_cast<uint8_t>(section)];
+
+    ticks = ticks > g_dump.header.overhead ? ticks - g_dump.header.overhead : 0;
+
+    ++rec.count;
+    if (ticks < rec.min)
+        rec.min = ticks;
+    if (ticks > rec.max)
+        rec.max = ticks;
+
+    rec.total_lo += ticks;
+    if (rec.total_lo < ticks)
+        ++rec.total_hi;
+}
+
+bool dump(const char* name) {
+    return platform::write_appvar(name, &g_dump, sizeof(g_dump));
+}
+
+const SectionRecord* sections() {
+    return g_dump.records;
+}
+
+}  // namespace profile
+}  // namespace util
@@ -0,0 +1,148 @@
+/**
+ * @file profile.hpp
+ * @brief Section profiler for on-calculator cycle counts
+ *
+ * Host timings do not predict eZ80 cost (24-bit int, software 32-bit math,
+ * flash wait states), so costs have to be measured on the device. A profiling
+ * build (BATTLEMON_PROFILE=1, `make PROFILE=1` on the CE) wraps the battle hot
+ * spots in scopes that read the CE's hardware timer and accumulate
+ * count / min / max / total cycles per section. dump() writes the table to an
+ * AppVar (a `.bin` file on host) for `battlemon_profile` to print.
+ *
+ * Sections are inclusive: a section's time contains every section nested in
+ * it. The cost of an empty scope is measured by start() and subtracted.
+ *
+ * In normal builds BATTLEMON_PROFILE_SCOPE expands to nothing.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "platform.hpp"
+
+#ifndef BATTLEMON_PROFILE
+#define BATTLEMON_PROFILE 0
+#endif
+
+namespace util {
+namespace profile {
+
+enum class Section : uint8_t {
+    // Engine
+    EXECUTE_TURN,
+    DISPATCH_MOVE_EFFECT,
+
+    // dsl::StageTransition<From, To>::execute
+    TRANSITION_ACCURACY,      // Genesis -> AccuracyResolved
+    TRANSITION_DAMAGE_CALC,   // AccuracyResolved -> DamageCalculated
+    TRANSITION_DAMAGE_APPLY,  // DamageCalculated -> DamageApplied
+    TRANSITION_EFFECT,        // DamageApplied / Genesis -> EffectApplied
+    TRANSITION_FAINT,         // -> FaintChecked
+    TRANSITION_TERMINUS,      // -> Terminus
+    TRANSITION_OTHER,         // Default (no-op) transitions
+
+    // dsl::item::dispatch(), one section per event
+    ITEM_PRE_DAMAGE_CALC,
+    ITEM_PRE_DAMAGE_APPLY,
+    ITEM_POST_DAMAGE_APPLY,
+    ITEM_TURN_START,
+    ITEM_TURN_END,
+    ITEM_CHECK,
+
+    // dsl::ability::dispatch(), all events
+    ABILITY,
+
+    COUNT,
+};
+
+inline constexpr uint8_t SECTION_COUNT = static_cast<uint8_t>(Section::COUNT);
+
+// Printable section names (at most 15 characters, stored in the dump)
+inline constexpr const char* SECTION_NAMES[SECTION_COUNT] = {
+    "execute_turn",   "dispatch_move",  "t:accuracy",   "t:damage_calc", "t:damage_apply",
+    "t:effect",       "t:faint",        "t:terminus",   "t:other",       "i:pre_dmg_calc",
+    "i:pre_dmg_appl", "i:post_dmg_app", "i:turn_start", "i:turn_end",    "i:item_check",
+    "a:dispatch",
+};
+
+// ============================================================================
+//                              DUMP FORMAT
+// ============================================================================
+//
+// Little-endian, no padding, identical on eZ80 and host:
+//
+//   DumpHeader
+//   SectionRecord[section_count]
+//
+// ============================================================================
+
+inline constexpr uint32_t DUMP_MAGIC = 0x46504D42;  // "BMPF"
+inline constexpr uint16_t DUMP_VERSION = 1;
+inline constexpr const char* DUMP_NAME = "BMPROF";
+
+struct DumpHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t section_count;
+    uint8_t reserved;
+    uint32_t clock_hz;  // Counter ticks per second
+    uint32_t overhead;  // Ticks subtracted from every sample
+};
+
+struct SectionRecord {
+    char name[16];
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t total_lo;  // 64-bit total split for the eZ80 (no 64-bit adds)
+    uint32_t total_hi;
+};
+
+static_assert(sizeof(DumpHeader) == 16 && sizeof(SectionRecord) == 36,
+              "dump layout must match between eZ80 and host");
+
+// ============================================================================
+//                               RECORDING
+// ============================================================================
+
+/// Reset all sections, start the counter and measure scope overhead
+void start();
+
+/// Add one sample to a section
+void record(Section section, uint32_t ticks);
+
+/// Write the section table to AppVar `name`
+bool dump(const char* name = DUMP_NAME);
+
+/// Section table (names filled in by start())
+const SectionRecord* sections();
+
+/// RAII timer for one section
+class Scope {
+   public:
+    explicit Scope(Section section) : section_(section), start_(platform::cycle_count()) {}
+    ~Scope() { record(section_, platform::cycle_count() - start_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Section section_;
+    uint32_t start_;
+};
+
+}  // namespace profile
+}  // namespace util
+
+#define BATTLEMON_PROFILE_CONCAT_(a, b) a##b
+#define BATTLEMON_PROFILE_CONCAT(a, b) BATTLEMON_PROFILE_CONCAT_(a, b)
+
+#if BATTLEMON_PROFILE
+#define BATTLEMON_PROFILE_SCOPE(section)                                                      \
+    const ::util::profile::Scope BATTLEMON_PROFILE_CONCAT(profile_scope_, __LINE__) {          \
+        section                                                                               \
+    }
+#else
+#define BATTLEMON_PROFILE_SCOPE(section) ((void)0)
+#endif
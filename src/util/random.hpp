@@ -5,6 +5,23 @@
  * PCG32 random number generator for battle calculations.
  * High-quality PRNG suitable for game mechanics (accuracy, crits, damage variance).
  *
+ * Each battle owns its own Rng (reachable through dsl::BattleContext::rng), so
+ * independent battles can run on different threads or be interleaved on one
+ * thread without disturbing each other's sequences.
+ *
+ * Parallel simulation derives one stream per battle from a master seed with
+ * Rng::split(), and Rng::advance() jumps within a stream in O(log n), so any
+ * battle of a sharded job is reproducible from (seed, index) alone.
+ *
+ * Installing a DrawTape (draw_tape.hpp) turns the draws into enumerated
+ * branches, so a turn can be re-executed once per possible outcome.
+ *
+ * Draws name their DrawSite. With SiteStreams installed (common random
+ * numbers), each (side, site) pair draws from its own stream, so changing
+ * one decision does not shift the rolls of every later draw. Telemetry
+ * builds (BATTLEMON_DRAW_TELEMETRY) also report every draw, with its site,
+ * to an installed DrawLog.
+ *
  * Reference: https://www.pcg-random.org/
  * Algorithm: PCG XSH RR 64/32 (LCG)
  */
@@ -12,29 +29,457 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
+
+#include "draw_tape.hpp"
+#include "platform.hpp"
+
+// Report every draw to the installed DrawLog; 0 compiles the hooks out
+#ifndef BATTLEMON_DRAW_TELEMETRY
+#define BATTLEMON_DRAW_TELEMETRY 0
+#endif
 
 namespace util {
 namespace random {
 
+// PCG32 LCG multiplier (pcg-random.org reference)
+inline constexpr uint64_t PCG32_MULTIPLIER = 6364136223846793005ULL;
+
+/**
+ * @brief SplitMix64 finalizer (bijective 64-bit mixer)
+ *
+ * Used to decorrelate derived stream seeds; adjacent stream ids map to
+ * unrelated states and increments.
+ */
+constexpr uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// ============================================================================
+//                         DRAW SITES / SITE STREAMS
+// ============================================================================
+
+/// Logical source of a draw
+enum class DrawSite : uint8_t {
+    GENERIC = 0,
+    ACCURACY,
+    CRITICAL,
+    DAMAGE_ROLL,
+    SECONDARY,     // Secondary effect chance
+    ITEM,          // Item proc (Focus Band, King's Rock)
+    QUICK_CLAW,
+    SPEED_TIE,
+    ABILITY,       // Ability proc (Static, Effect Spore, Shed Skin)
+    HIT_COUNT,     // Multi-hit move's number of hits
+    SLEEP,         // Sleep duration
+    FORCE_SWITCH,  // Member Roar / Whirlwind drags in
+    COUNT,
+};
+
+inline constexpr uint8_t DRAW_SITE_COUNT = static_cast<uint8_t>(DrawSite::COUNT);
+
 /**
- * @brief Initialize RNG with seed
- * @param seed Random seed (0 = use rtc_Time() for hardware entropy)
+ * @brief Per-turn common-random-number streams (one per side and site).
  *
- * For deterministic testing: Initialize(0x12345678)
- * For normal gameplay: Initialize() uses RTC automatically
+ * Counter-based: the n-th draw of a site by a side in a turn is
+ * mix64(key, side, site, n), with `key` taken from the battle stream once
+ * per turn. Two battles from the same seed therefore see the same rolls
+ * for the same decisions, and a different decision only changes the rolls
+ * of its own turn.
  */
-void Initialize(uint32_t seed = 0);
+struct SiteStreams {
+    uint64_t key{0};
+    uint8_t actor{0};  // Side whose draws are being made
+    uint8_t draws[2][DRAW_SITE_COUNT]{};
+
+    constexpr uint32_t next(DrawSite site) {
+        const auto s = static_cast<uint8_t>(site);
+        const uint64_t counter = static_cast<uint64_t>(actor) << 16 |
+                                 static_cast<uint64_t>(s) << 8 | draws[actor & 1][s]++;
+        return static_cast<uint32_t>(mix64(key ^ mix64(counter)) >> 32);
+    }
+};
+
+/// Site streams receiving this thread's draws (nullptr = the battle stream)
+inline constinit BATTLEMON_THREAD_LOCAL SiteStreams* g_site_streams = nullptr;
+
+/// RAII: draw from `streams` for the lifetime of the scope
+class StreamScope {
+   public:
+    explicit StreamScope(SiteStreams* streams) : previous_(g_site_streams) {
+        g_site_streams = streams;
+    }
+    ~StreamScope() { g_site_streams = previous_; }
+
+    StreamScope(const StreamScope&) = delete;
+    StreamScope& operator=(const StreamScope&) = delete;
+
+   private:
+    SiteStreams* previous_;
+};
+
+// ============================================================================
+//                            DRAW TELEMETRY
+// ============================================================================
+//
+// Where a turn's randomness goes: every draw made while a DrawLog is
+// installed (DrawLogScope, or BattleEngine::attach_draw_log()) is recorded
+// with its site, the side drawing, its range and the value it returned -
+// under a DrawTape or site streams too, so the log shows what the
+// enumerator branched on and what each CRN stream served. A replayed turn
+// must report the same draws as the recorded one.
+//
+// Counts accumulate over the log's lifetime; records hold the current turn
+// only. Builds without BATTLEMON_DRAW_TELEMETRY report nothing and pay
+// nothing.
+//
+// ============================================================================
+
+/// One reported draw
+struct DrawRecord {
+    DrawSite site;
+    uint8_t actor;   // Side drawing (set_draw_actor())
+    uint16_t range;  // Outcomes: random(range), chance(_, range); 0 for discard()
+    uint16_t value;  // Value returned (chance(): 1 = success)
+};
+
+class DrawLog {
+   public:
+    static constexpr uint8_t MAX_RECORDS = 64;  // Draws per turn kept as records
+
+    /// Start a turn: clears the records and this turn's counts
+    void begin_turn() {
+        ++turns_;
+        record_count_ = 0;
+        turn_draws_ = 0;
+        for (uint16_t& count : turn_site_draws_)
+            count = 0;
+    }
+
+    void set_actor(uint8_t actor) { actor_ = actor; }
+
+    void record(DrawSite site, uint16_t range, uint16_t value) {
+        const auto s = static_cast<uint8_t>(site);
+        ++turn_draws_;
+        ++turn_site_draws_[s];
+        ++site_draws_[s];
+        if (turn_draws_ > max_turn_draws_)
+            max_turn_draws_ = turn_draws_;
+        if (record_count_ < MAX_RECORDS)
+            records_[record_count_++] = DrawRecord{site, actor_, range, value};
+    }
+
+    /// Draws of the current turn, of every site / of one
+    [[nodiscard]] uint16_t turn_draws() const { return turn_draws_; }
+    [[nodiscard]] uint16_t turn_draws(DrawSite site) const {
+        return turn_site_draws_[static_cast<uint8_t>(site)];
+    }
+
+    /// Draws of `site` over every turn
+    [[nodiscard]] uint64_t total_draws(DrawSite site) const {
+        return site_draws_[static_cast<uint8_t>(site)];
+    }
+
+    /// Turns begun, and the most draws any of them made
+    [[nodiscard]] uint32_t turns() const { return turns_; }
+    [[nodiscard]] uint16_t max_turn_draws() const { return max_turn_draws_; }
+
+    /// The current turn's draws in order (the first MAX_RECORDS of them)
+    [[nodiscard]] const DrawRecord* records() const { return records_; }
+    [[nodiscard]] uint8_t record_count() const { return record_count_; }
+    [[nodiscard]] bool overflowed() const { return turn_draws_ > MAX_RECORDS; }
+
+   private:
+    DrawRecord records_[MAX_RECORDS]{};
+    uint64_t site_draws_[DRAW_SITE_COUNT]{};
+    uint16_t turn_site_draws_[DRAW_SITE_COUNT]{};
+    uint32_t turns_{0};
+    uint16_t turn_draws_{0};
+    uint16_t max_turn_draws_{0};
+    uint8_t record_count_{0};
+    uint8_t actor_{0};
+};
+
+/// Log receiving this thread's draws (nullptr = not recording)
+inline constinit BATTLEMON_THREAD_LOCAL DrawLog* g_draw_log = nullptr;
+
+/// RAII: report draws to `log` for the lifetime of the scope
+class DrawLogScope {
+   public:
+    explicit DrawLogScope(DrawLog* log) : previous_(g_draw_log) { g_draw_log = log; }
+    ~DrawLogScope() { g_draw_log = previous_; }
+
+    DrawLogScope(const DrawLogScope&) = delete;
+    DrawLogScope& operator=(const DrawLogScope&) = delete;
+
+   private:
+    DrawLog* previous_;
+};
+
+/// `value`, reported to the installed DrawLog first (telemetry builds)
+template <typename T>
+constexpr T report_draw([[maybe_unused]] DrawSite site, [[maybe_unused]] uint16_t range,
+                        T value) {
+#if BATTLEMON_DRAW_TELEMETRY
+    if !consteval {
+        if (DrawLog* log = g_draw_log)
+            log->record(site, range, static_cast<uint16_t>(value));
+    }
+#endif
+    return value;
+}
+
+/// Attribute the following draws to `side` (streams and telemetry)
+inline void set_draw_actor(uint8_t side) {
+    if (SiteStreams* streams = g_site_streams) {
+        streams->actor = side;
+    }
+#if BATTLEMON_DRAW_TELEMETRY
+    if (DrawLog* log = g_draw_log) {
+        log->set_actor(side);
+    }
+#endif
+}
 
 /**
- * @brief Generate a random number in range [0, max)
- * @param max Upper bound (exclusive)
- * @return Random number from 0 to max-1
+ * @brief PCG32 generator state (64-bit state + 64-bit odd increment)
  *
- * Examples:
- * - Random(100) returns 0-99 (for percentage rolls)
- * - Random(16) returns 0-15 (for 1/16 chance)
+ * Plain data: copying an Rng forks the sequence, which is exactly what
+ * snapshots and tree search need.
  */
-uint16_t Random(uint16_t max);
+struct Rng {
+    // Reference defaults from PCG32_INITIALIZER
+    uint64_t state{0x853c49e6748fea9bULL};
+    uint64_t inc{0xda3e39cb94b95bdbULL};
+
+    /**
+     * @brief Seed the generator
+     * @param seed Random seed (0 = use platform entropy, see platform.hpp)
+     *
+     * For deterministic testing: rng.seed(0x12345678)
+     * For normal gameplay: rng.seed() uses the RTC (CE) or OS entropy (host)
+     */
+    void seed(uint32_t seed = 0);
+
+    /**
+     * @brief Seed with a full 64-bit state and stream selector (pcg32_srandom_r)
+     * @param initstate Starting state
+     * @param initseq Stream selector (only the low 63 bits matter)
+     */
+    constexpr void seed(uint64_t initstate, uint64_t initseq) {
+        // Uses two-step initialization for proper state mixing
+        state = 0U;
+        inc = (initseq << 1u) | 1u;  // Ensure increment is odd
+        next();                      // First iteration
+        state += initstate;          // Mix in seed
+        next();                      // Second iteration for avalanche
+    }
+
+    /**
+     * @brief PCG32 step
+     * @return Random uint32_t
+     *
+     * PCG XSH RR 64/32 variant:
+     * - 64-bit LCG state
+     * - XOR shift + rotate output transformation
+     * - Period: 2^64
+     */
+    constexpr uint32_t next() {
+        uint64_t oldstate = state;
+        // LCG step: state = state * multiplier + increment
+        state = oldstate * PCG32_MULTIPLIER + inc;
+
+        // Output permutation (XSH RR):
+        // - XOR high and low bits, shift right
+        // - Rotate by top bits for final mixing
+        uint32_t xorshifted = static_cast<uint32_t>(((oldstate >> 18u) ^ oldstate) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(oldstate >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+    }
+
+    /**
+     * @brief Generate a random number in range [0, max)
+     *
+     * @pre max > 0 (zero range is a programming error)
+     *
+     * @param max Upper bound (exclusive)
+     * @return Random number from 0 to max-1
+     *
+     * Examples:
+     * - random(100) returns 0-99 (for percentage rolls)
+     * - random(16) returns 0-15 (for 1/16 chance)
+     */
+    constexpr uint16_t random(uint16_t max, DrawSite site = DrawSite::GENERIC) {
+        if (!std::is_constant_evaluated()) {
+            if (DrawTape* tape = g_draw_tape) {
+                next();
+                return report_draw(site, max, tape->uniform(max));
+            }
+            if (SiteStreams* streams = g_site_streams) {
+                return report_draw(site, max, static_cast<uint16_t>(streams->next(site) % max));
+            }
+        }
+        // Simple modulo (could be replaced with bounded rand for perfect uniformity)
+        // Bias ≈ (2^32 mod bound) / 2^32   : random(100) = 96/4294967296 ≈ 0.0000022%
+        //                                  : random(2^N) = 0
+        // --> should be orders of magnitidue smaller than EZ80 hardware measurement error
+        return report_draw(site, max, static_cast<uint16_t>(next() % max));
+    }
+
+    /**
+     * @brief True with probability numerator / denominator
+     *
+     * Same draw as random(denominator) < numerator, but under a DrawTape it
+     * branches two ways instead of `denominator` ways.
+     *
+     * @pre denominator > 0
+     */
+    constexpr bool chance(uint16_t numerator, uint16_t denominator,
+                          DrawSite site = DrawSite::GENERIC) {
+        if (!std::is_constant_evaluated()) {
+            if (DrawTape* tape = g_draw_tape) {
+                next();
+                return report_draw(site, denominator, tape->chance(numerator, denominator));
+            }
+            if (SiteStreams* streams = g_site_streams) {
+                const uint16_t value = static_cast<uint16_t>(streams->next(site) % denominator);
+                return report_draw(site, denominator, value < numerator);
+            }
+        }
+        return report_draw(site, denominator,
+                           static_cast<uint16_t>(next() % denominator) < numerator);
+    }
+
+    /**
+     * @brief random(max) for a caller that treats some values alike
+     *
+     * Same draw as random(max). Under a DrawTape, values v with equal
+     * class_of(v) are enumerated once (as the smallest such v); class_of is
+     * never called otherwise.
+     *
+     * @param max Upper bound (exclusive, at most DrawTape::MAX_GROUPED)
+     * @param class_of Callable uint16_t -> uint32_t
+     */
+    template <typename ClassOf>
+    constexpr uint16_t random_grouped(uint16_t max, ClassOf&& class_of,
+                                      DrawSite site = DrawSite::GENERIC) {
+        if (!std::is_constant_evaluated()) {
+            if (DrawTape* tape = g_draw_tape) {
+                if (max > DrawTape::MAX_GROUPED)
+                    return random(max, site);
+                uint32_t classes[DrawTape::MAX_GROUPED];
+                for (uint16_t v = 0; v < max; ++v) {
+                    classes[v] = static_cast<uint32_t>(class_of(v));
+                }
+                next();
+                return report_draw(site, max, tape->grouped(max, classes));
+            }
+            if (SiteStreams* streams = g_site_streams) {
+                return report_draw(site, max, static_cast<uint16_t>(streams->next(site) % max));
+            }
+        }
+        return report_draw(site, max, static_cast<uint16_t>(next() % max));
+    }
+
+    /**
+     * @brief Draw in [0, count) with weights[v] / PROBABILITY_ONE for each v
+     *
+     * One draw: the top 30 bits of a 32-bit output pick the value whose
+     * cumulative weight passes them (values of zero weight are never drawn;
+     * weights summing short of one put the rest on the last drawable value).
+     * Under a DrawTape it branches once per drawable value, with its weight.
+     *
+     * @param weights weights[v] for every v < count, summing to at most one
+     */
+    uint16_t random_weighted(uint16_t count, const Probability* weights,
+                             DrawSite site = DrawSite::GENERIC) {
+        if (DrawTape* tape = g_draw_tape) {
+            next();
+            return report_draw(site, count, tape->weighted(count, weights));
+        }
+        const uint32_t bits =
+            (g_site_streams ? g_site_streams->next(site) : next()) >> (32 - 30);
+        uint16_t last = 0;
+        uint64_t cumulative = 0;
+        for (uint16_t v = 0; v < count; ++v) {
+            if (weights[v] == 0)
+                continue;
+            last = v;
+            cumulative += weights[v];
+            if (bits < cumulative)
+                break;
+        }
+        return report_draw(site, count, last);
+    }
+
+    /**
+     * @brief Consume one draw whose value is not needed (parity draws).
+     *
+     * Steps the same stream random(n, site) would, and never branches.
+     */
+    constexpr void discard(DrawSite site = DrawSite::GENERIC) {
+        if (!std::is_constant_evaluated()) {
+            report_draw(site, 0, uint16_t{0});
+            if (!g_draw_tape) {
+                if (SiteStreams* streams = g_site_streams) {
+                    streams->next(site);
+                    return;
+                }
+            }
+        }
+        next();
+    }
+
+    /**
+     * @brief Jump ahead (or back) by delta steps in O(log delta)
+     *
+     * Every draw (next()/random()) consumes exactly one step, so advance(n)
+     * is equivalent to discarding n draws. Going backwards is advance(-n),
+     * since the LCG period is 2^64.
+     *
+     * Reference: pcg32_advance_r() / Brown, "Random Number Generation with
+     * Arbitrary Stride" (1994)
+     *
+     * @param delta Number of steps to skip
+     */
+    constexpr void advance(uint64_t delta) {
+        uint64_t cur_mult = PCG32_MULTIPLIER;
+        uint64_t cur_plus = inc;
+        uint64_t acc_mult = 1u;
+        uint64_t acc_plus = 0u;
+
+        while (delta > 0) {
+            if (delta & 1u) {
+                acc_mult *= cur_mult;
+                acc_plus = acc_plus * cur_mult + cur_plus;
+            }
+            cur_plus = (cur_mult + 1u) * cur_plus;
+            cur_mult *= cur_mult;
+            delta >>= 1u;
+        }
+        state = acc_mult * state + acc_plus;
+    }
+
+    /**
+     * @brief Derive an independent child stream
+     *
+     * Pure function of (this generator's current state, stream_id): the
+     * parent is not advanced, so split(i) for i = 0..N-1 gives N reproducible
+     * battles from one master seed without serial reseeding. Children use
+     * distinct increments, i.e. distinct PCG streams.
+     *
+     * @param stream_id Child index (battle number, shard id, ...)
+     * @return Seeded child generator
+     */
+    [[nodiscard]] constexpr Rng split(uint64_t stream_id) const {
+        Rng child{};
+        child.seed(mix64(state ^ mix64(stream_id)), mix64(inc + stream_id));
+        return child;
+    }
+};
 
 }  // namespace random
-}  // namespace util
\ No newline at end of file
+}  // namespace util
@@ -0,0 +1,51 @@
+/**
+ * @file table_cache.cpp
+ * @brief Cache AppVar validation and writing
+ */
+
+#include "table_cache.hpp"
+
+#include <cstring>
+
+#include "platform.hpp"
+
+namespace util {
+namespace cache {
+
+const uint8_t* map_cache(const char* name, uint32_t fingerprint, uint32_t& size) {
+    size = 0;
+    size_t appvar_size = 0;
+    const auto* bytes = static_cast<const uint8_t*>(platform::map_appvar(name, appvar_size));
+    if (!bytes || appvar_size < sizeof(CacheHeader))
+        return nullptr;
+
+    CacheHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.format != CACHE_FORMAT_VERSION || header.fingerprint != fingerprint ||
+        header.size != appvar_size - sizeof(header))
+        return nullptr;
+
+    const uint8_t* payload = bytes + sizeof(header);
+    if (adler32(payload, header.size) != header.checksum)
+        return nullptr;
+
+    size = header.size;
+    return payload;
+}
+
+bool write_cache(const char* name, uint32_t fingerprint, const void* payload, uint32_t size) {
+    if (size > CACHE_MAX_PAYLOAD)
+        return false;
+
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.format = CACHE_FORMAT_VERSION;
+    header.fingerprint = fingerprint;
+    header.size = static_cast<uint16_t>(size);
+    header.checksum = adler32(static_cast<const uint8_t*>(payload), size);
+    return platform::write_appvar(name, &header, sizeof(header), payload, size);
+}
+
+}  // namespace cache
+}  // namespace util
@@ -0,0 +1,212 @@
+/**
+ * @file table_cache.hpp
+ * @brief Derived tables cached in archived AppVars (files on host)
+ *
+ * Some derived data is too big to keep as constexpr in the program and too
+ * slow to build at every launch on a 48 MHz CPU. Such a table is built once
+ * (on the device, or by a host tool), written as a cache AppVar, and on
+ * later launches read in place from flash (util::platform::map_appvar()):
+ * no RAM copy and no rebuild.
+ *
+ * A cache AppVar is a CacheHeader followed by the table's bytes. It is used
+ * only if its header matches (magic, format version, the table's
+ * fingerprint from its inputs, its size) and the payload's Adler-32 matches
+ * the header; otherwise the table is rebuilt. Fingerprints fold in
+ * data::DATA_FINGERPRINT (data/fingerprint.hpp), so editing the rental,
+ * move or species data turns every cache stale without a version bump.
+ *
+ * Validation costs one pass over the payload (two adds per byte) and runs
+ * on the table's first use, not at startup: launch time does not grow with
+ * the number of caches.
+ *
+ * All multi-byte header fields are little-endian, as written on both
+ * targets.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace util {
+namespace cache {
+
+inline constexpr char CACHE_MAGIC[4] = {'B', 'M', 'T', 'C'};
+inline constexpr uint8_t CACHE_FORMAT_VERSION = 1;
+
+/// Payload alignment: the header's size (host mappings are page-aligned)
+inline constexpr size_t CACHE_PAYLOAD_ALIGN = 16;
+
+/// Largest payload (an AppVar holds less than 64 KiB)
+inline constexpr uint32_t CACHE_MAX_PAYLOAD = UINT16_MAX;
+
+struct CacheHeader {
+    char magic[4];
+    uint8_t format;  // CACHE_FORMAT_VERSION
+    uint8_t reserved;
+    uint16_t size;         // Payload bytes after the header
+    uint32_t fingerprint;  // Inputs the table was derived from
+    uint32_t checksum;     // adler32() of the payload
+};
+
+static_assert(sizeof(CacheHeader) == 16 && sizeof(CacheHeader) % CACHE_PAYLOAD_ALIGN == 0,
+              "cache header is part of the AppVar format");
+
+// ============================================================================
+//                       CHECKSUM / FINGERPRINTS
+// ============================================================================
+
+/**
+ * @brief Adler-32 (RFC 1950) of `size` bytes.
+ *
+ * The modulo is taken once per 5552 bytes, the most that cannot overflow
+ * the 32-bit sums, so the inner loop is two adds per byte.
+ */
+constexpr uint32_t adler32(const uint8_t* bytes, size_t size) {
+    constexpr uint32_t MOD = 65521;
+    constexpr size_t BLOCK = 5552;
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0) {
+        const size_t block = size < BLOCK ? size : BLOCK;
+        for (size_t i = 0; i < block; ++i) {
+            a += bytes[i];
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+        bytes += block;
+        size -= block;
+    }
+    return b << 16 | a;
+}
+
+/// Fold `value` into a fingerprint (FNV-1a over 32-bit words)
+constexpr uint32_t fingerprint_mix(uint32_t fingerprint, uint32_t value) {
+    return (fingerprint ^ value) * 16777619u;
+}
+
+/// Fingerprint of nothing (FNV-1a offset basis)
+inline constexpr uint32_t FINGERPRINT_BASIS = 2166136261u;
+
+namespace cache_detail {
+inline constexpr uint8_t ADLER32_VECTOR[] = {'W', 'i', 'k', 'i', 'p', 'e', 'd', 'i', 'a'};
+}  // namespace cache_detail
+
+static_assert(adler32(cache_detail::ADLER32_VECTOR, sizeof(cache_detail::ADLER32_VECTOR)) ==
+              0x11E60398);
+
+// ============================================================================
+//                           CACHE APPVARS
+// ============================================================================
+
+/**
+ * @brief Payload of cache AppVar `name`, if it is a valid cache of `fingerprint`.
+ *
+ * @param[out] size Payload bytes (0 when nullptr is returned)
+ *
+ * @return The payload in place (see util::platform::map_appvar() for how
+ *         long it stays valid), or nullptr if the AppVar is missing, not a
+ *         cache, stale, truncated or corrupt
+ */
+const uint8_t* map_cache(const char* name, uint32_t fingerprint, uint32_t& size);
+
+/**
+ * @brief Write `payload` as cache AppVar `name` (replacing any old one).
+ *
+ * On the CE this is an archive write, which may garbage-collect and move
+ * other AppVars: pointers from map_cache() are invalid after it.
+ *
+ * @return true on success (false for a payload over CACHE_MAX_PAYLOAD)
+ */
+bool write_cache(const char* name, uint32_t fingerprint, const void* payload, uint32_t size);
+
+// ============================================================================
+//                             CACHED TABLE
+// ============================================================================
+
+enum class CacheSource : uint8_t {
+    NONE,    // Not requested yet, or could not be built
+    MAPPED,  // Read in place from its AppVar
+    BUILT,   // Recomputed this launch (no valid AppVar)
+};
+
+/**
+ * @brief One derived table, mapped from its cache AppVar or rebuilt on demand.
+ *
+ * @tparam Table Trivially copyable, fixed-size table type
+ */
+template <typename Table>
+class CachedTable {
+    static_assert(std::is_trivially_copyable_v<Table>, "a cached table is read as raw bytes");
+    static_assert(alignof(Table) <= CACHE_PAYLOAD_ALIGN, "payload is only 16-byte aligned");
+    static_assert(sizeof(Table) <= CACHE_MAX_PAYLOAD, "a cached table must fit one AppVar");
+
+   public:
+    /**
+     * @param name AppVar name (at most 8 characters)
+     * @param fingerprint The table's inputs: data::DATA_FINGERPRINT mixed
+     *        with the table's own layout version (its size is mixed in here)
+     */
+    constexpr CachedTable(const char* name, uint32_t fingerprint)
+        : name_(name), fingerprint_(fingerprint_mix(fingerprint, sizeof(Table))) {}
+
+    /**
+     * @brief The table: on first use, its AppVar if valid, else `build()`'s.
+     *
+     * @param build Callable () -> const Table* computing the table into
+     *        caller-owned storage (an arena, a static), or nullptr if it
+     *        cannot
+     *
+     * @return The table, or nullptr if there is no valid AppVar and the
+     *         build failed
+     */
+    template <typename Build>
+    const Table* get(Build&& build) {
+        if (table_)
+            return table_;
+
+        uint32_t size = 0;
+        if (const uint8_t* payload = map_cache(name_, fingerprint_, size);
+            payload && size == sizeof(Table)) {
+            table_ = reinterpret_cast<const Table*>(payload);
+            source_ = CacheSource::MAPPED;
+            return table_;
+        }
+
+        table_ = build();
+        source_ = table_ ? CacheSource::BUILT : CacheSource::NONE;
+        return table_;
+    }
+
+    [[nodiscard]] CacheSource source() const { return source_; }
+
+    /**
+     * @brief Write a table built this launch as its AppVar, for the next launch.
+     *
+     * An archive write can move other AppVars: call it when no mapped table
+     * is in use any more (on exit), then reset() the other caches.
+     *
+     * @return false if the table was not built this launch or the write failed
+     */
+    bool store() const {
+        return source_ == CacheSource::BUILT &&
+               write_cache(name_, fingerprint_, table_, sizeof(Table));
+    }
+
+    /// Forget the table (its mapping may be stale after an archive write)
+    void reset() {
+        table_ = nullptr;
+        source_ = CacheSource::NONE;
+    }
+
+   private:
+    const char* name_;
+    uint32_t fingerprint_;
+    const Table* table_{nullptr};
+    CacheSource source_{CacheSource::NONE};
+};
+
+}  // namespace cache
+}  // namespace util
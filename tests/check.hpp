@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @file check.hpp
+ * @brief Minimal assertions for the ctest programs in tests/
+ *
+ * Each test is a plain executable: CHECK() reports a failed condition with
+ * its location and counts it, and main() returns check::exit_code(). No
+ * framework, so the tests build wherever the tools do.
+ */
+
+#include <cstdio>
+
+namespace check {
+
+inline int g_failures = 0;
+
+inline void fail(const char* condition, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, condition);
+    ++g_failures;
+}
+
+/// 0 if every CHECK() passed
+inline int exit_code() {
+    if (g_failures > 0)
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
+
+}  // namespace check
+
+#define CHECK(condition)                                    \
+    do {                                                    \
+        if (!(condition))                                   \
+            ::check::fail(#condition, __FILE__, __LINE__);  \
+    } while (0)
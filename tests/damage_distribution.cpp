@@ -0,0 +1,101 @@
+/**
+ * @file damage_distribution.cpp
+ * @brief calculate_damage_distribution() agrees with calculate_damage()
+ *
+ * Random hits (levels, stats, stages, types, crit stages, forced crits,
+ * cached effectiveness) are rolled many times with calculate_damage(). Every
+ * rolled hit must be one of the distribution's entries on its crit branch,
+ * within [min, max], with the distribution's effectiveness, and crit only
+ * when the distribution says it can. The staged-stat cache must not change
+ * the distribution.
+ */
+
+#include <cstdint>
+
+#include "check.hpp"
+#include "logic/calc/damage.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using namespace logic::calc;
+using types::enums::Type;
+
+constexpr uint32_t HITS = 20000;
+constexpr uint32_t ROLLS = 64;
+constexpr uint8_t TYPE_COUNT = static_cast<uint8_t>(Type::DARK) + 1;
+
+Type random_type(util::random::Rng& rng) {
+    return static_cast<Type>(rng.random(TYPE_COUNT));
+}
+
+int8_t random_stage(util::random::Rng& rng) {
+    return static_cast<int8_t>(MIN_STAT_STAGE + rng.random(MAX_STAT_STAGE - MIN_STAT_STAGE + 1));
+}
+
+DamageParams random_params(util::random::Rng& rng) {
+    DamageParams params{};
+    params.level = static_cast<types::calc::Level>(1 + rng.random(100));
+    params.attack = static_cast<types::calc::StatValue>(5 + rng.random(600));
+    params.defense = static_cast<types::calc::StatValue>(5 + rng.random(600));
+    params.attack_stage = random_stage(rng);
+    params.defense_stage = random_stage(rng);
+    params.attacker_type1 = random_type(rng);
+    params.attacker_type2 = random_type(rng);
+    params.defender_type1 = random_type(rng);
+    params.defender_type2 = random_type(rng);
+    params.move_type = static_cast<Type>(1 + rng.random(TYPE_COUNT - 1));
+    params.power = static_cast<types::calc::MovePower>(10 + rng.random(241));
+    // Stages past MAX_CRIT_STAGE never crit
+    params.crit_stage = static_cast<types::calc::CritStage>(rng.random(MAX_CRIT_STAGE + 2));
+    params.is_critical = rng.random(8) == 0;
+    params.skip_random = rng.random(16) == 0;
+    if (rng.random(2) == 0) {
+        params.effectiveness = get_type_effectiveness(params.move_type, params.defender_type1,
+                                                      params.defender_type2);
+    }
+    return params;
+}
+
+bool same_distribution(const DamageDistribution& a, const DamageDistribution& b) {
+    for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+        if (a.normal[i] != b.normal[i] || a.critical[i] != b.critical[i])
+            return false;
+    }
+    return a.min == b.min && a.max == b.max && a.effectiveness == b.effectiveness &&
+           a.crit_denominator == b.crit_denominator;
+}
+
+void check_hit(const DamageParams& params, util::random::Rng& rng) {
+    const DamageDistribution dist = calculate_damage_distribution(params);
+
+    DamageParams cached = params;
+    cached.staged_attack = apply_stat_stage(params.attack, params.attack_stage);
+    cached.staged_defense = apply_stat_stage(params.defense, params.defense_stage);
+    CHECK(same_distribution(calculate_damage_distribution(cached), dist));
+
+    bool matched = true;
+    for (uint32_t r = 0; r < ROLLS; ++r) {
+        const DamageResult hit = calculate_damage(rng, params);
+        const Damage* branch = hit.critical ? dist.critical : dist.normal;
+        bool listed = false;
+        for (uint8_t i = 0; i < DAMAGE_ROLL_COUNT; ++i) {
+            listed |= branch[i] == hit.damage;
+        }
+        matched &= listed && hit.damage >= dist.min && hit.damage <= dist.max;
+        matched &= hit.effectiveness == dist.effectiveness;
+        matched &= hit.critical ? dist.can_crit() : !dist.always_crits();
+    }
+    CHECK(matched);
+}
+
+}  // namespace
+
+int main() {
+    util::random::Rng rng{};
+    rng.seed(0x44495354, 1);
+    for (uint32_t n = 0; n < HITS; ++n) {
+        check_hit(random_params(rng), rng);
+    }
+    return check::exit_code();
+}
@@ -0,0 +1,91 @@
+/**
+ * @file effect_traits.cpp
+ * @brief g_EFFECT_TRAITS against what the effects actually do
+ *
+ * preview() runs a move whose traits say it never draws as one leaf
+ * without a tape, so a routine that draws while its traits say it does
+ * not would preview wrong. Every rental move is run, as preview_leaf()
+ * runs it, from a spread of battles: one without draws_rng must leave the
+ * RNG untouched, and one without touches_field / touches_side must leave
+ * the field's effects / both sides as they were.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "check.hpp"
+#include "data/move.hpp"
+#include "engine/battle.hpp"
+#include "engine/dispatch.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+constexpr uint32_t DEFENDERS = 8;  // Per attacking rental
+
+template <typename T>
+bool same(const T& a, const T& b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+/// The field's effects; the timer clock (next_expiry) moves with any slot timer too
+bool same_field(const logic::state::FieldState& a, const logic::state::FieldState& b) {
+    bool equal = a.weather == b.weather && a.weather_expiry == b.weather_expiry;
+#if BATTLEMON_FEATURE_DELAYED_EFFECTS
+    equal = equal && same(a.future_sight, b.future_sight) && same(a.wish, b.wish);
+#endif
+    return equal;
+}
+
+/// Run side 0's move `index` on a copy of `battle`'s state and check its traits
+void check_move(const engine::BattleEngine& battle, uint8_t index) {
+    const auto& before = battle.state();
+    dsl::BattleState scratch;
+    std::memcpy(static_cast<void*>(&scratch), &before, sizeof(scratch));
+    dsl::BattleContext ctx{};
+    ctx.state = &scratch;
+    ctx.rng = &scratch.rng;
+    ctx.set_battlers(0, 1);
+
+    const auto& move = data::g_MOVE_HOT[static_cast<size_t>(scratch.rental(0).moves[index])];
+    ctx.move = &move;
+    engine::dispatch_move_effect(move.effect, ctx);
+
+    const dsl::EffectTraits& traits = battle.move_traits(0, index);
+    if (!traits.draws_rng) {
+        CHECK(scratch.rng.state == before.rng.state);
+    }
+    if (!traits.touches_field) {
+        CHECK(same_field(scratch.field, before.field));
+    }
+    if (!traits.touches_side) {
+        CHECK(same(scratch.sides[0], before.sides[0]));
+        CHECK(same(scratch.sides[1], before.sides[1]));
+    }
+}
+
+}  // namespace
+
+int main() {
+    util::random::Rng draft{};
+    draft.seed(0x54524149, 1);
+    uint32_t quiet = 0;
+    for (uint16_t attacker = 0; attacker < logic::setup::RENTAL_COUNT; ++attacker) {
+        for (uint32_t n = 0; n < DEFENDERS; ++n) {
+            const auto defender =
+                static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT));
+            engine::BattleEngine battle;
+            battle.init(attacker, defender, 50, draft.random(0xFFFF) + 1);
+            for (uint8_t index = 0; index < 4; ++index) {
+                if (battle.rental(0).moves[index] == types::enums::Move::NONE)
+                    continue;
+                quiet += !battle.move_traits(0, index).draws_rng;
+                check_move(battle, index);
+            }
+        }
+    }
+    std::printf("effect traits: %u move runs that never draw\n", quiet);
+    CHECK(quiet > 0);
+    return check::exit_code();
+}
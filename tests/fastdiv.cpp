@@ -0,0 +1,128 @@
+/**
+ * @file fastdiv.cpp
+ * @brief The CE's multiply-shift arithmetic against plain division
+ *
+ * Hosts build with BATTLEMON_DIVISION_FREE off, so every call site is run
+ * here with its DivisionFree argument forced on and compared with the
+ * formula it replaces. Inputs that fit the call site's type are swept in
+ * full; 32-bit inputs are swept in full up to SWEEP, past every ratio's
+ * exact range, and by stride above it where the fallback divides anyway.
+ */
+
+#include <cstdint>
+
+#include "check.hpp"
+#include "logic/calc/damage.hpp"
+#include "logic/calc/stat_stages.hpp"
+#include "util/fastdiv.hpp"
+
+namespace {
+
+using types::calc::DamageCalc;
+using types::calc::Effectiveness;
+using types::calc::StatValue;
+
+constexpr uint32_t SWEEP = 1u << 26;
+constexpr uint32_t STRIDE = 4099;
+
+static_assert(util::fastdiv::make_ratio(1, 50).limit < SWEEP);
+static_assert([] {
+    for (const auto& ratio : logic::calc::DAMAGE_ROLL_SCALES.factor) {
+        if (ratio.limit >= SWEEP)
+            return false;
+    }
+    return true;
+}());
+
+/// Every x the sweep covers: [0, SWEEP) then strides up to UINT32_MAX
+template <typename Fn>
+void for_each_input(Fn&& fn) {
+    for (uint32_t x = 0; x < SWEEP; ++x) {
+        fn(x);
+    }
+    for (uint64_t x = SWEEP; x <= UINT32_MAX; x += STRIDE) {
+        fn(static_cast<uint32_t>(x));
+    }
+    fn(UINT32_MAX);
+}
+
+void check_stat_stages() {
+    using namespace logic::calc;
+    for (int8_t stage = MIN_STAT_STAGE; stage <= MAX_STAT_STAGE; ++stage) {
+        const auto& ratio = STAT_STAGE_RATIOS[stage_to_index(stage)];
+        bool exact = true;
+        for (uint32_t stat = 0; stat <= UINT16_MAX; ++stat) {
+            const auto expected = static_cast<StatValue>(stat * ratio[0] / ratio[1]);
+            exact &= apply_stat_stage<true>(static_cast<StatValue>(stat), stage) == expected;
+        }
+        CHECK(exact);
+    }
+}
+
+void check_base_damage() {
+    using namespace logic::calc;
+
+    // The level term: every Level
+    bool exact = true;
+    for (uint32_t level = 0; level <= UINT8_MAX; ++level) {
+        exact &= util::fastdiv::scale<2, 5, true>(level) == level * 2 / 5;
+    }
+    CHECK(exact);
+
+    // The /50: any 32-bit quotient of the power * attack / defense product
+    exact = true;
+    for_each_input([&](uint32_t x) { exact &= util::fastdiv::scale<1, 50, true>(x) == x / 50; });
+    CHECK(exact);
+
+    // The whole formula over a grid of levels, powers and stats
+    exact = true;
+    for (uint32_t level = 1; level <= 100; level += 7) {
+        for (uint32_t power = 10; power <= 250; power += 20) {
+            for (uint32_t attack = 1; attack <= 1000; attack += 37) {
+                for (uint32_t defense = 1; defense <= 1000; defense += 41) {
+                    const DamageCalc expected =
+                        (level * 2 / 5 + 2) * power * attack / defense / 50 + 2;
+                    exact &= calc_base_damage<true>(static_cast<types::calc::Level>(level),
+                                                    static_cast<types::calc::MovePower>(power),
+                                                    static_cast<StatValue>(attack),
+                                                    static_cast<StatValue>(defense)) == expected;
+                }
+            }
+        }
+    }
+    CHECK(exact);
+}
+
+void check_damage_rolls() {
+    using namespace logic::calc;
+    for (uint16_t factor = MIN_DAMAGE_ROLL; factor <= 100; ++factor) {
+        bool exact = true;
+        for_each_input([&](uint32_t damage) {
+            exact &= apply_damage_roll<true>(damage, factor) == damage * factor / 100u;
+        });
+        CHECK(exact);
+    }
+}
+
+void check_type_effectiveness() {
+    using namespace logic::calc;
+    constexpr Effectiveness N = effectiveness::DUAL_NEUTRAL;
+    constexpr Effectiveness MULTIPLIERS[] = {0, N / 4, N / 2, N, N * 2, N * 4};
+    for (const Effectiveness eff : MULTIPLIERS) {
+        bool exact = true;
+        for_each_input([&](uint32_t damage) {
+            exact &= apply_type_effectiveness<true>(damage, eff) == damage * eff / N;
+        });
+        CHECK(exact);
+    }
+}
+
+}  // namespace
+
+int main() {
+    check_stat_stages();
+    check_base_damage();
+    check_damage_rolls();
+    check_type_effectiveness();
+    return check::exit_code();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file keyframe_seek.cpp
+ * @brief Seeking a battle log lands where straight-line play did
+ *
+ * Battles are played with random moves while a log is recorded and the
+ * state after every turn is kept. A KeyframeIndex built from the log, with
+ * a capacity small enough that long battles thin it out, must then seek to
+ * every turn (and past the end) and match the kept state byte for byte.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "check.hpp"
+#include "engine/battle.hpp"
+#include "engine/battle_log.hpp"
+#include "engine/keyframe.hpp"
+#include "engine/policy.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+constexpr uint32_t BATTLES = 50;
+constexpr uint32_t MAX_TURNS = 200;
+constexpr uint16_t CHECKPOINT_INTERVAL = 8;
+constexpr uint16_t KEYFRAME_CAPACITY = 4;
+constexpr uint16_t KEYFRAME_INTERVAL = 3;
+
+bool same_state(const engine::BattleSnapshot& a, const engine::BattleSnapshot& b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+void check_seek(uint32_t n) {
+    util::random::Rng root{};
+    root.seed(0x4B455946, n);
+    util::random::Rng draft = root.split(0);
+    util::random::Rng policy_rng = root.split(1);
+    const auto p1 = static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT));
+    const auto p2 = static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT));
+
+    std::vector<uint8_t> bytes(engine::log_capacity(MAX_TURNS, CHECKPOINT_INTERVAL));
+    engine::BattleLogWriter writer(bytes.data(), bytes.size(), CHECKPOINT_INTERVAL);
+    engine::BattleEngine battle;
+    battle.init(p1, p2, 50, root.split(2));
+    CHECK(battle.attach_log(&writer));
+
+    // states[t]: the battle after t turns
+    std::vector<engine::BattleSnapshot> states{battle.save()};
+    while (states.size() <= MAX_TURNS && battle.result() == engine::BattleResult::ONGOING) {
+        battle.execute_turn(engine::random_move_policy(battle, 0, policy_rng),
+                            engine::random_move_policy(battle, 1, policy_rng));
+        states.push_back(battle.save());
+    }
+    CHECK(writer.finish(engine::checkpoint_fingerprint(battle)));
+    const engine::BattleLog log = writer.log();
+    const auto turns = static_cast<uint32_t>(states.size() - 1);
+
+    engine::Keyframe keyframes[KEYFRAME_CAPACITY];
+    engine::KeyframeIndex index(keyframes, KEYFRAME_CAPACITY, KEYFRAME_INTERVAL);
+    engine::BattleEngine replayed;
+    CHECK(index.build(replayed, log) == engine::ReplayStatus::OK);
+    CHECK(same_state(replayed.save(), states.back()));
+    CHECK(index.count() <= KEYFRAME_CAPACITY);
+
+    for (uint16_t i = 0; i < index.count(); ++i) {
+        const engine::Keyframe& keyframe = index.keyframes()[i];
+        CHECK(keyframe.turn == i * index.interval());
+        CHECK(same_state(keyframe.snapshot, states[keyframe.turn]));
+    }
+
+    bool matched = true;
+    for (uint32_t turn = 0; turn <= turns; ++turn) {
+        engine::BattleEngine seeker;
+        CHECK(index.seek(seeker, log, turn) == engine::ReplayStatus::OK);
+        matched &= same_state(seeker.save(), states[turn]);
+    }
+    CHECK(matched);
+
+    engine::BattleEngine past_end;
+    CHECK(index.seek(past_end, log, turns + 10) == engine::ReplayStatus::OK);
+    CHECK(same_state(past_end.save(), states.back()));
+}
+
+}  // namespace
+
+int main() {
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        check_seek(n);
+    }
+    return check::exit_code();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file move_pp.cpp
+ * @brief Moves spend PP, Leppa Berry refills it, and no PP means Struggle
+ *
+ * Using a move takes one PP (two against Pressure). A Leppa Berry holder
+ * whose move hits 0 PP gets it back at the next item check, and a battler
+ * with no legal move Struggles without touching its PP. A move used until
+ * its PP is gone leaves the legal mask.
+ */
+
+#include <cstdint>
+
+#include "check.hpp"
+#include "data/move.hpp"
+#include "data/rental_packed.hpp"
+#include "engine/battle.hpp"
+#include "logic/setup/rental.hpp"
+
+namespace {
+
+using engine::ActionMask;
+using engine::BattleAction;
+using types::enums::Item;
+using types::enums::Move;
+
+uint8_t max_pp(Move move) {
+    return data::g_MOVE_COLD[static_cast<size_t>(move)].pp;
+}
+
+/// First rental holding `item`, and its first damaging move short of an OHKO
+bool find_holder(Item item, uint16_t& rental, uint8_t& slot) {
+    for (rental = 0; rental < logic::setup::RENTAL_COUNT; ++rental) {
+        if (data::rental(rental).held_item != item)
+            continue;
+        for (slot = 0; slot < 4; ++slot) {
+            const Move id = data::rental(rental).moves[slot];
+            const auto& move = data::g_MOVE_HOT[static_cast<size_t>(id)];
+            if (move.power > 0 && move.effect != types::enums::Effect::OHKO)
+                return true;
+        }
+    }
+    return false;
+}
+
+/// A used move loses one PP, two against Pressure
+void check_deduction() {
+    for (uint16_t rental = 0; rental < 8; ++rental) {
+        engine::BattleEngine battle;
+        battle.init(rental, static_cast<uint16_t>(rental + 1));
+        const uint8_t before = battle.p1_mon().pp[0];
+        const bool pressure = battle.state().ability(1) == types::enums::Ability::PRESSURE;
+        battle.execute_turn(BattleAction::move(0), BattleAction::move(0));
+        CHECK(battle.p1_mon().pp[0] == before - (pressure ? 2 : 1));
+    }
+}
+
+/// Using a move until its PP is gone clears its legal bit (both kept healed)
+void check_exhaustion() {
+    uint16_t rental = 0;
+    while (data::rental(rental).held_item == Item::LEPPA_B) {
+        ++rental;
+    }
+    engine::BattleEngine battle;
+    battle.init(rental, rental);
+    const ActionMask bit = engine::action_bit(BattleAction::move(0));
+
+    uint32_t uses = 0;
+    while (battle.p1_mon().pp[0] > 0 && uses <= max_pp(data::rental(rental).moves[0])) {
+        CHECK(battle.legal_actions(0) & bit);
+        engine::BattleSnapshot healed = battle.save();
+        for (auto& party : healed.parties) {
+            party.mons[0].current_hp = party.mons[0].max_hp;
+        }
+        battle.restore(healed);
+        battle.execute_turn(BattleAction::move(0), BattleAction::move(0));
+        ++uses;
+    }
+    CHECK(battle.p1_mon().pp[0] == 0);
+    CHECK(!(battle.legal_actions(0) & bit));
+}
+
+/// The holder's move runs dry and the berry restores it; the PP-less foe Struggles
+void check_leppa_and_struggle() {
+    uint16_t holder;
+    uint8_t slot;
+    if (!find_holder(Item::LEPPA_B, holder, slot)) {
+        CHECK(!"no Leppa Berry rental with a damaging move");
+        return;
+    }
+
+    engine::BattleEngine battle;
+    battle.init(holder, 0);
+    engine::BattleSnapshot dry = battle.save();
+    dry.parties[0].mons[0].pp[slot] = 1;
+    for (uint8_t& pp : dry.parties[1].mons[0].pp) {
+        pp = 0;
+    }
+    battle.restore(dry);
+    CHECK(!(battle.legal_actions(1) & engine::ACTION_MOVES));
+
+    battle.execute_turn(BattleAction::move(slot), BattleAction::move(0));
+    const Move move = data::rental(holder).moves[slot];
+    CHECK(battle.p1_mon().pp[slot] == (max_pp(move) < 10 ? max_pp(move) : 10));
+    CHECK(battle.p1_slot().item_consumed);
+
+    CHECK(battle.p2_slot().last_move_used == static_cast<uint8_t>(Move::STRUGGLE));
+    for (const uint8_t pp : battle.p2_mon().pp) {
+        CHECK(pp == 0);
+    }
+}
+
+}  // namespace
+
+int main() {
+    check_deduction();
+    check_exhaustion();
+    check_leppa_and_struggle();
+    return check::exit_code();
+}
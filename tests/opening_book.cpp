@@ -0,0 +1,125 @@
+/**
+ * @file opening_book.cpp
+ * @brief An opening book built, written and mapped back answers exactly its openings
+ *
+ * Books a few leads at a shallow depth (engine/book_builder.hpp), writes
+ * the BMBOOK-format AppVar under a test name and opens it again. Every
+ * booked pair must hit from either side with the action a fresh search of
+ * the same depth finds, and both searchers must return it without
+ * searching; later turns, other levels and a book for another level miss.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "check.hpp"
+#include "engine/ai.hpp"
+#include "engine/batch.hpp"
+#include "engine/battle_log.hpp"
+#include "engine/book_builder.hpp"
+#include "engine/opening_book.hpp"
+#include "engine/resumable_search.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::book::BookEntry;
+using engine::book::BookMove;
+
+constexpr const char* NAME = "BMTSTBK";
+constexpr const char* PATH = "BMTSTBK.bin";  // util::platform's host AppVar file
+constexpr uint8_t LEVEL = 50;
+constexpr size_t LEADS = 5;
+
+/// The opening of (p1, p2) as build_opening_book() sets it up
+engine::BattleEngine opening(uint16_t p1, uint16_t p2, uint8_t level = LEVEL) {
+    engine::BattleEngine battle;
+    util::random::Rng stream{};
+    stream.seed(p1, p2);
+    battle.init(p1, p2, level, stream);
+    return battle;
+}
+
+}  // namespace
+
+int main() {
+    util::random::Rng draft{};
+    draft.seed(0x424F4F4B, 1);
+    std::vector<uint16_t> leads;
+    for (size_t i = 0; i < LEADS; ++i) {
+        leads.push_back(static_cast<uint16_t>(draft.random(logic::setup::RENTAL_COUNT)));
+    }
+
+    engine::book::BookBuildOptions options{};
+    options.level = LEVEL;
+    options.max_depth = 2;
+    options.chance_samples = 2;
+    engine::BatchRunner runner(2);
+    const std::vector<BookEntry> entries =
+        engine::book::build_opening_book(runner, leads, options);
+    CHECK(entries.size() == LEADS * LEADS);
+    for (size_t i = 1; i < entries.size(); ++i) {
+        CHECK(engine::book::entry_before(entries[i - 1], entries[i].own, entries[i].opponent));
+    }
+
+    std::remove(PATH);
+    CHECK(engine::book::write_opening_book(entries, LEVEL, NAME));
+    engine::book::OpeningBook book;
+    CHECK(!book.open(100, NAME));
+    CHECK(book.open(LEVEL, NAME));
+    CHECK(book.size() == entries.size());
+
+    engine::ai::SearchLimits limits{};
+    limits.max_depth = options.max_depth;
+    limits.chance_samples = options.chance_samples;
+    auto table = std::make_unique<engine::book::BookTranspositionTable>();
+    engine::ai::SearchLimits booked_limits = limits;
+    booked_limits.book = &book;
+
+    for (const BookEntry& entry : entries) {
+        const BookEntry* found = book.find(entry.own, entry.opponent);
+        CHECK(found && found->value == entry.value && found->action == entry.action);
+
+        // A fresh search of the same depth agrees
+        engine::BattleEngine battle = opening(entry.own, entry.opponent);
+        table->clear();
+        engine::ai::Searcher<engine::book::BookTranspositionTable> fresh(*table, limits);
+        const engine::ai::SearchResult searched = fresh.search(battle, 0);
+        CHECK(engine::encode_action(searched.action) == entry.action);
+        CHECK(searched.value == entry.value && searched.depth == entry.depth);
+
+        // Hits as player 1, and as player 2 of the mirrored opening
+        BookMove move;
+        CHECK(book.probe(battle, 0, move) && engine::encode_action(move.action) == entry.action);
+        const engine::BattleEngine mirrored = opening(entry.opponent, entry.own);
+        CHECK(book.probe(mirrored, 1, move) && engine::encode_action(move.action) == entry.action);
+
+        // Both searchers answer from the book without executing a turn
+        engine::ai::Searcher<engine::book::BookTranspositionTable> searcher(*table,
+                                                                             booked_limits);
+        const engine::ai::SearchResult hit = searcher.search(battle, 0);
+        CHECK(hit.nodes == 0 && engine::encode_action(hit.action) == entry.action);
+        engine::ai::ResumableSearcher<engine::book::BookTranspositionTable> resumable(
+            *table, booked_limits);
+        resumable.start(battle, 0);
+        CHECK(resumable.step(0));
+        CHECK(resumable.result().nodes == 0 &&
+              engine::encode_action(resumable.result().action) == entry.action);
+
+        // Misses past turn 1 (even with both battlers untouched) and at another level
+        engine::BattleEngine later = opening(entry.own, entry.opponent);
+        later.context().state->field.turn = 2;
+        CHECK(!book.probe(later, 0, move));
+        battle.execute_turn(engine::BattleAction::move(0), engine::BattleAction::move(0));
+        CHECK(!book.probe(battle, 0, move));
+        CHECK(!book.probe(opening(entry.own, entry.opponent, 100), 0, move));
+    }
+
+    std::printf("opening book: %zu entries\n", entries.size());
+    book.close();
+    std::remove(PATH);
+    return check::exit_code();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file packed_state.cpp
+ * @brief Battle states survive pack() / unpack()
+ *
+ * 3v3 battles are played with random legal actions (switches included).
+ * After every turn the state must be packable, and unpacking it over the
+ * battle's opening state must give back every slot, party mon, the field,
+ * the sides and the RNG. A battle restored from the unpacked state must
+ * then play the next turn exactly like the original.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "check.hpp"
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "logic/setup/rental.hpp"
+#include "logic/state/packed.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+
+constexpr uint32_t BATTLES = 100;
+constexpr uint32_t MAX_TURNS = 60;
+
+engine::PartyRentals draw_party(util::random::Rng& rng) {
+    engine::PartyRentals party{};
+    party.size = 3;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        party.rentals[i] = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+    }
+    return party;
+}
+
+BattleAction random_action(const engine::BattleEngine& battle, uint8_t side,
+                           util::random::Rng& rng) {
+    const engine::ai::ActionList list = engine::ai::candidate_actions(battle, side);
+    return list.actions[rng.random(list.count)];
+}
+
+/// Every packed part of `a` equals `b`'s
+bool same_packed_parts(const dsl::BattleState& a, const dsl::BattleState& b) {
+    bool same = std::memcmp(&a.field, &b.field, sizeof(a.field)) == 0 &&
+                std::memcmp(a.sides, b.sides, sizeof(a.sides)) == 0 &&
+                std::memcmp(&a.rng, &b.rng, sizeof(a.rng)) == 0;
+    for (uint8_t i = 0; i < dsl::MAX_BATTLE_SLOTS; ++i) {
+        same &= logic::state::same_slot(a.slots[i], b.slots[i]);
+    }
+    for (uint8_t side = 0; side < dsl::BATTLE_SIDE_COUNT; ++side) {
+        for (uint8_t m = 0; m < a.parties[side].size; ++m) {
+            same &= logic::state::same_mon(a.parties[side].mons[m], b.parties[side].mons[m]);
+        }
+    }
+    return same;
+}
+
+void play(uint32_t n) {
+    util::random::Rng root{};
+    root.seed(0x5041434B, n);
+    util::random::Rng draft = root.split(0);
+    util::random::Rng choices = root.split(1);
+
+    engine::BattleEngine battle;
+    battle.init(draw_party(draft), draw_party(draft), 50, root.split(2));
+    const dsl::BattleState opening = battle.state();
+
+    for (uint32_t turn = 0; turn < MAX_TURNS && battle.result() == engine::BattleResult::ONGOING;
+         ++turn) {
+        for (uint8_t side = 0; side < 2; ++side) {
+            if (battle.needs_replacement(side))
+                battle.replace(side, random_action(battle, side, choices).index);
+        }
+        if (battle.result() != engine::BattleResult::ONGOING)
+            break;
+
+        CHECK(logic::state::packable(battle.state()));
+        dsl::BattleState unpacked = opening;
+        logic::state::unpack(logic::state::pack(battle.state()), unpacked);
+        CHECK(same_packed_parts(unpacked, battle.state()));
+
+        engine::BattleEngine restored;
+        restored.restore(unpacked);
+        CHECK(restored.hash() == battle.hash());
+
+        const BattleAction p1 = random_action(battle, 0, choices);
+        const BattleAction p2 = random_action(battle, 1, choices);
+        battle.execute_turn(p1, p2);
+        restored.execute_turn(p1, p2);
+        CHECK(same_packed_parts(restored.state(), battle.state()));
+    }
+}
+
+}  // namespace
+
+int main() {
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        play(n);
+    }
+    return check::exit_code();
+}
@@ -0,0 +1,194 @@
+/**
+ * @file party_battle.cpp
+ * @brief 3v3 party battles finish under the move policies
+ *
+ * run_battle() replaces fainted battlers between turns
+ * (engine::replace_fainted()), so a party battle ends with one side's whole
+ * party fainted instead of stalling at the turn cap. The search's
+ * EvalCache tells same-typed party members apart across a switch, and
+ * Roar drags the foe's benched member in (and fails with no one to drag).
+ * A trapped battler cannot switch out.
+ * The search's candidates include every legal switch.
+ */
+
+#include <cstdint>
+
+#include "check.hpp"
+#include "data/rental_packed.hpp"
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "engine/eval.hpp"
+#include "engine/policy.hpp"
+#include "engine/simulate.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+using engine::BattleResult;
+
+constexpr uint32_t BATTLES = 200;
+
+engine::PartyRentals draw_party(util::random::Rng& rng, uint8_t size) {
+    engine::PartyRentals party{};
+    party.size = size;
+    for (uint8_t i = 0; i < size; ++i) {
+        party.rentals[i] = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+    }
+    return party;
+}
+
+/// Living members of `side`'s party
+uint8_t standing(const engine::BattleEngine& battle, uint8_t side) {
+    const auto& party = battle.state().parties[side];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        count += party.mons[i].is_alive();
+    }
+    return count;
+}
+
+/// A switch between same-typed members misses the EvalCache entry of the first
+void check_eval_cache_switch() {
+    for (uint16_t a = 0; a < logic::setup::RENTAL_COUNT; ++a) {
+        for (uint16_t b = static_cast<uint16_t>(a + 1); b < logic::setup::RENTAL_COUNT; ++b) {
+            engine::PartyRentals p1{};
+            p1.size = 2;
+            p1.rentals[0] = a;
+            p1.rentals[1] = b;
+            engine::PartyRentals p2{};
+            p2.size = 1;
+            engine::BattleEngine battle;
+            battle.init(p1, p2);
+
+            dsl::BattleState state = battle.state();
+            const auto& first = state.parties[0].active[0];
+            const auto& second = state.parties[0].active[1];
+            if (first.type1 != second.type1 || first.type2 != second.type2)
+                continue;
+            const unsigned strength = engine::ai::eval_detail::hit_strength(state, 0);
+            state.slots[0].party_index = 1;
+            const unsigned switched = engine::ai::eval_detail::hit_strength(state, 0);
+            if (switched == strength)
+                continue;
+
+            state.slots[0].party_index = 0;
+            engine::ai::EvalCache cache;
+            CHECK(cache.lookup(state, 0) == strength);
+            state.slots[0].party_index = 1;
+            CHECK(cache.lookup(state, 0) == switched);
+            return;
+        }
+    }
+    CHECK(!"no same-typed rentals with different hit strengths");
+}
+
+/// First rental with Roar or Whirlwind and its move slot
+bool find_roar(uint16_t& rental, uint8_t& slot) {
+    for (rental = 0; rental < logic::setup::RENTAL_COUNT; ++rental) {
+        for (slot = 0; slot < 4; ++slot) {
+            const auto move = data::rental(rental).moves[slot];
+            if (data::g_MOVE_HOT[static_cast<size_t>(move)].effect == types::enums::Effect::ROAR)
+                return true;
+        }
+    }
+    return false;
+}
+
+/// The foe switches out and Roar, moving last, drags its lead back in
+void check_roar() {
+    uint16_t roarer;
+    uint8_t roar;
+    CHECK(find_roar(roarer, roar));
+
+    engine::BattleEngine single;
+    single.init(roarer, roarer);
+    const engine::ActionPreview alone = single.preview(0, engine::BattleAction::move(roar));
+    CHECK(alone.result.failed && !alone.result.force_switch);
+
+    engine::PartyRentals p1{};
+    p1.size = 1;
+    p1.rentals[0] = roarer;
+    engine::PartyRentals p2{};
+    p2.size = 2;
+    p2.rentals[0] = 0;
+    p2.rentals[1] = 1;
+    engine::BattleEngine battle;
+    battle.init(p1, p2);
+    CHECK(battle.state().ability(1) != types::enums::Ability::SUCTION_CUPS);
+    battle.execute_turn(engine::BattleAction::move(roar), engine::BattleAction::switch_to(1));
+    CHECK(battle.p2_slot().party_index == 0);
+}
+
+/// A trapped battler's switch does nothing, even when a caller asks for it
+void check_trapped_switch() {
+    engine::PartyRentals party{};
+    party.size = 2;
+    party.rentals[0] = 0;
+    party.rentals[1] = 1;
+    engine::BattleEngine battle;
+    battle.init(party, party);
+    engine::BattleSnapshot trapped = battle.save();
+    trapped.slots[0].volatiles |= logic::state::volatile_flags::TRAPPED;
+    battle.restore(trapped);
+
+    CHECK(!(battle.legal_actions(0) & engine::action_bit(BattleAction::switch_to(1))));
+    battle.execute_turn(BattleAction::switch_to(1), BattleAction::switch_to(1));
+    CHECK(battle.p1_slot().party_index == 0);
+    CHECK(battle.p2_slot().party_index == 1);
+}
+
+/// A fresh 3v3 battle's candidates are its legal moves, then both benched members
+void check_search_candidates() {
+    util::random::Rng draft{};
+    draft.seed(0x43414E44, 1);
+    engine::BattleEngine battle;
+    battle.init(draw_party(draft, 3), draw_party(draft, 3));
+    for (uint8_t side = 0; side < 2; ++side) {
+        BattleAction moves[4];
+        const uint8_t count = engine::legal_moves(battle, side, moves);
+        const engine::ai::ActionList list = engine::ai::candidate_actions(battle, side);
+        CHECK(list.count == count + 2);
+        CHECK(list.actions[count].type == BattleAction::Type::SWITCH &&
+              list.actions[count].index == 1);
+        CHECK(list.actions[count + 1].index == 2);
+    }
+}
+
+}  // namespace
+
+int main() {
+    check_search_candidates();
+    check_eval_cache_switch();
+    check_roar();
+    check_trapped_switch();
+
+    util::random::Rng draft{};
+    draft.seed(0x50415254, 1);
+    uint32_t capped = 0;
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        const engine::PartyRentals p1 = draw_party(draft, 3);
+        const engine::PartyRentals p2 = draw_party(draft, 3);
+        util::random::Rng root{};
+        root.seed(n, n);
+
+        engine::BattleEngine battle;
+        battle.init(p1, p2, 50, root.split(0));
+        util::random::Rng policy_rng = root.split(1);
+        const engine::BattleOutcome outcome = engine::run_battle(
+            battle, engine::random_move_policy, engine::random_move_policy, policy_rng);
+
+        if (outcome.result == BattleResult::ONGOING) {
+            ++capped;
+            continue;
+        }
+        // The winner may be down to nothing too (Explosion, recoil on the last KO)
+        const auto loser = static_cast<uint8_t>(outcome.result == BattleResult::P1_WINS);
+        CHECK(standing(battle, loser) == 0);
+    }
+    // Stalemates (e.g. Normal-only vs. Ghost) are the only battles left at the cap
+    std::printf("party battles: %u of %u at the turn cap\n", capped, BATTLES);
+    CHECK(capped * 20 < BATTLES);
+    return check::exit_code();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file preview.cpp
+ * @brief BattleEngine::preview() leaves the battle untouched and its leaves sum to one
+ *
+ * 3v3 battles are played a few random turns in; then every legal action of
+ * either side is previewed, once at the median and once leaf by leaf. The
+ * battle's state (RNG included), hash and legal actions must be exactly as
+ * before, and the leaf probabilities must sum to one up to fixed-point
+ * truncation.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "check.hpp"
+#include "engine/battle.hpp"
+#include "engine/policy.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+using util::random::Probability;
+using util::random::PROBABILITY_ONE;
+
+constexpr uint32_t BATTLES = 200;
+constexpr uint32_t MAX_OPENING_TURNS = 6;
+constexpr Probability TRUNCATION = 1u << 8;  // Per-leaf rounding of multiply(), summed
+
+engine::PartyRentals draw_party(util::random::Rng& rng) {
+    engine::PartyRentals party{};
+    party.size = 3;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        party.rentals[i] = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+    }
+    return party;
+}
+
+/// Preview `action` both ways and check it left `battle` as it was
+void check_preview(const engine::BattleEngine& battle, uint8_t side, const BattleAction& action) {
+    const engine::BattleSnapshot before = battle.save();
+    const uint64_t hash = battle.hash();
+    const engine::ActionMask legal[2] = {battle.legal_actions(0), battle.legal_actions(1)};
+
+    const engine::ActionPreview median = battle.preview(side, action);
+    CHECK(median.probability > 0);
+
+    uint64_t total = 0;
+    uint32_t leaves = 0;
+    battle.preview(side, action, [&](const engine::ActionPreview& leaf) {
+        total += leaf.probability;
+        ++leaves;
+        return true;
+    });
+    CHECK(total <= PROBABILITY_ONE);
+    CHECK(total + TRUNCATION * leaves >= PROBABILITY_ONE);
+
+    const engine::BattleSnapshot after = battle.save();
+    CHECK(std::memcmp(&before, &after, sizeof(before)) == 0);
+    CHECK(battle.hash() == hash);
+    CHECK(battle.legal_actions(0) == legal[0] && battle.legal_actions(1) == legal[1]);
+}
+
+}  // namespace
+
+int main() {
+    util::random::Rng draft{};
+    draft.seed(0x50524556, 1);
+    uint32_t previews = 0;
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        const engine::PartyRentals p1 = draw_party(draft);
+        const engine::PartyRentals p2 = draw_party(draft);
+        engine::BattleEngine battle;
+        battle.init(p1, p2, 50, draft.split(n));
+
+        util::random::Rng policy_rng = draft.split(n + BATTLES);
+        const uint32_t opening = draft.random(MAX_OPENING_TURNS + 1);
+        for (uint32_t turn = 0; turn < opening && battle.result() == engine::BattleResult::ONGOING;
+             ++turn) {
+            engine::replace_fainted(battle);
+            const BattleAction p1_action = engine::random_move_policy(battle, 0, policy_rng);
+            const BattleAction p2_action = engine::random_move_policy(battle, 1, policy_rng);
+            battle.execute_turn(p1_action, p2_action);
+        }
+        if (battle.result() != engine::BattleResult::ONGOING)
+            continue;
+        engine::replace_fainted(battle);
+
+        for (uint8_t side = 0; side < 2; ++side) {
+            engine::for_each_action(battle.legal_actions(side), [&](const BattleAction& action) {
+                check_preview(battle, side, action);
+                ++previews;
+            });
+        }
+    }
+    std::printf("preview: %u actions previewed\n", previews);
+    CHECK(previews > 0);
+    return check::exit_code();
+}
@@ -0,0 +1,73 @@
+"""Smoke test of the battlemon extension module (python/module.cpp).
+
+Run by ctest in a -DBATTLEMON_PYTHON=ON build, with the module's directory
+as the first argument. Checks the result views and the lifetime of the
+VecEnv <-> Array reference cycle: views keep their environment alive, and a
+dropped environment is freed by the cycle collector.
+"""
+
+import gc
+import sys
+
+sys.path.insert(0, sys.argv[1])
+
+import battlemon  # noqa: E402
+
+
+def check(condition, message):
+    if not condition:
+        raise SystemExit("FAIL: " + message)
+
+
+def vecenvs_alive():
+    return sum(1 for obj in gc.get_objects() if type(obj) is battlemon.VecEnv)
+
+
+def test_views():
+    env = battlemon.VecEnv(4, seed=7)
+    obs = memoryview(env.reset())
+    check(obs.shape == (4, battlemon.OBSERVATION_SIZE), "observation shape")
+    check(obs.format == "f", "observation format")
+    obs, rewards, dones = env.step(bytes(4))
+    check(memoryview(rewards).shape == (4,), "reward shape")
+    check(memoryview(dones).format == "B", "done format")
+    check(len(env.legal_actions) == 4, "legal action count")
+
+
+def test_view_outlives_env():
+    env = battlemon.VecEnv(2, seed=1)
+    rewards = env.rewards
+    del env
+    gc.collect()
+    check(memoryview(rewards).tolist() == [0.0, 0.0], "view of a dropped environment")
+
+
+def test_cycle_collected():
+    gc.collect()
+    before = vecenvs_alive()
+    for _ in range(50):
+        env = battlemon.VecEnv(1, seed=3)
+        env.step(bytes(1))
+        del env
+    gc.collect()
+    check(vecenvs_alive() == before, "dropped VecEnvs survive gc.collect()")
+
+    view = battlemon.VecEnv(1).observations
+    gc.collect()
+    check(vecenvs_alive() == before + 1, "a view keeps its environment")
+    del view
+    gc.collect()
+    check(vecenvs_alive() == before, "environment survives its last view")
+
+
+def test_battle():
+    battle = battlemon.Battle(0, 1, seed=5)
+    snapshot = battle.save()
+    first = battle.step(0, 0)
+    battle.restore(snapshot)
+    check(battle.step(0, 0) == first, "restore replays the same turn")
+
+
+for test in (test_views, test_view_outlives_env, test_cycle_collected, test_battle):
+    test()
+print("python smoke: ok")
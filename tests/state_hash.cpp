@@ -0,0 +1,177 @@
+/**
+ * @file state_hash.cpp
+ * @brief The incremental hash and the undo journal track every turn
+ *
+ * 3v3 battles are played with random legal actions (switches included)
+ * while the journal, the hasher and an event queue are attached. After
+ * each turn and each faint replacement, hash() must equal a hash computed
+ * from scratch over the state, and undo_turn() must put the state back
+ * byte for byte, hash included. A state reached on another turn, with its
+ * timers as far from running out, must hash the same, and a battler that
+ * faints must not leave running timers behind to key the hash.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "check.hpp"
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "logic/setup/rental.hpp"
+#include "logic/state/event_queue.hpp"
+#include "logic/state/hash_layout.hpp"
+#include "logic/state/journal.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+
+constexpr uint32_t BATTLES = 100;
+constexpr uint32_t MAX_TURNS = 60;
+
+engine::PartyRentals draw_party(util::random::Rng& rng) {
+    engine::PartyRentals party{};
+    party.size = 3;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        party.rentals[i] = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+    }
+    return party;
+}
+
+/// The hash of `state` from scratch, over the regions BattleEngine registers
+uint64_t full_hash(const dsl::BattleState& state) {
+    using namespace logic::state;
+    StateHasher hasher;
+    hasher.add_region(&state.field, FIELD_HASH_LAYOUT);
+    hasher.add_region(&state.sides[0], SIDE_HASH_LAYOUT);
+    hasher.add_region(&state.sides[1], SIDE_HASH_LAYOUT);
+    hasher.add_region(&state.parties[0].mons, PARTY_HASH_LAYOUT);
+    hasher.add_region(&state.parties[1].mons, PARTY_HASH_LAYOUT);
+    hasher.add_region(&state.slots[0], SLOT_HASH_LAYOUT);
+    hasher.add_region(&state.slots[1], SLOT_HASH_LAYOUT);
+    return hasher.recompute();
+}
+
+bool same_state(const dsl::BattleState& a, const dsl::BattleState& b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+BattleAction random_action(const engine::BattleEngine& battle, uint8_t side,
+                           util::random::Rng& rng) {
+    const engine::ai::ActionList list = engine::ai::candidate_actions(battle, side);
+    return list.actions[rng.random(list.count)];
+}
+
+/// Undo the step just taken, check it, and take it again with `redo`
+template <typename Redo>
+void check_undo(engine::BattleEngine& battle, const dsl::BattleState& before,
+                uint64_t before_hash, Redo&& redo) {
+    const dsl::BattleState after = battle.state();
+    const uint64_t after_hash = battle.hash();
+    CHECK(after_hash == full_hash(battle.state()));
+
+    CHECK(battle.undo_turn());
+    CHECK(same_state(battle.state(), before));
+    CHECK(battle.hash() == before_hash);
+    CHECK(battle.hash() == full_hash(battle.state()));
+
+    redo();
+    CHECK(same_state(battle.state(), after));
+    CHECK(battle.hash() == after_hash);
+}
+
+void play(uint32_t n) {
+    util::random::Rng root{};
+    root.seed(0x48415348, n);
+    util::random::Rng draft = root.split(0);
+    util::random::Rng choices = root.split(1);
+
+    logic::state::UndoJournal journal;
+    logic::state::EventQueue events;
+    engine::BattleEngine battle;
+    battle.init(draw_party(draft), draw_party(draft), 50, root.split(2));
+    battle.attach_journal(&journal);
+    battle.attach_events(&events);
+    CHECK(battle.hash() == full_hash(battle.state()));
+
+    for (uint32_t turn = 0; turn < MAX_TURNS && battle.result() == engine::BattleResult::ONGOING;
+         ++turn) {
+        for (uint8_t side = 0; side < 2; ++side) {
+            if (!battle.needs_replacement(side))
+                continue;
+            const BattleAction pick = random_action(battle, side, choices);
+            const dsl::BattleState before = battle.state();
+            const uint64_t before_hash = battle.hash();
+            CHECK(battle.replace(side, pick.index));
+            check_undo(battle, before, before_hash, [&] { battle.replace(side, pick.index); });
+        }
+        if (battle.result() != engine::BattleResult::ONGOING)
+            break;
+
+        const BattleAction p1 = random_action(battle, 0, choices);
+        const BattleAction p2 = random_action(battle, 1, choices);
+        const dsl::BattleState before = battle.state();
+        const uint64_t before_hash = battle.hash();
+        battle.execute_turn(p1, p2);
+        check_undo(battle, before, before_hash, [&] { battle.execute_turn(p1, p2); });
+    }
+}
+
+/// Moving the clock and every running timer by the same turns keeps the hash
+void check_turn_invariance() {
+    using logic::state::turn_after;
+    engine::BattleEngine battle;
+    battle.init(0, 1);
+    dsl::BattleState state = battle.state();
+    state.sides[0].reflect_expiry = turn_after(state.field.turn, 4);
+    state.slots[1].taunt_expiry = turn_after(state.field.turn, 2);
+    const uint64_t hash = full_hash(state);
+
+    for (const uint8_t turns : {1, 7, 254}) {
+        dsl::BattleState later = state;
+        later.field.turn = turn_after(state.field.turn, turns);
+        later.sides[0].reflect_expiry = turn_after(state.sides[0].reflect_expiry, turns);
+        later.slots[1].taunt_expiry = turn_after(state.slots[1].taunt_expiry, turns);
+        CHECK(full_hash(later) == hash);
+    }
+
+    dsl::BattleState shorter = state;
+    shorter.sides[0].reflect_expiry = turn_after(state.field.turn, 3);
+    CHECK(full_hash(shorter) != hash);
+}
+
+/// A battler that faints to a residual has its timers cleared with it
+void check_fainted_timers() {
+    using namespace logic::state::volatile_flags;
+    using logic::state::turn_after;
+    engine::BattleEngine battle;
+    battle.init(0, 1);
+    dsl::BattleState state = battle.state();
+    logic::state::SlotState& slot = state.slots[1];
+    state.parties[1].mons[0].current_hp = 1;
+    state.parties[1].mons[0].status = logic::state::Status::POISON;
+    slot.volatiles |= TAUNTED | PERISH_SONG;
+    slot.taunt_expiry = turn_after(state.field.turn, 2);
+    slot.perish_expiry = turn_after(state.field.turn, 3);
+    state.field.next_expiry = slot.taunt_expiry;
+    battle.restore(state);
+
+    battle.execute_turn(BattleAction::move(0), BattleAction::move(0));
+    const logic::state::SlotState& fainted = battle.p2_slot();
+    CHECK(battle.p2_mon().is_fainted());
+    CHECK(!fainted.has(TAUNTED | PERISH_SONG));
+    CHECK(fainted.taunt_expiry == 0 && fainted.perish_expiry == 0);
+    CHECK(battle.hash() == full_hash(battle.state()));
+}
+
+}  // namespace
+
+int main() {
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        play(n);
+    }
+    check_turn_invariance();
+    check_fainted_timers();
+    return check::exit_code();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file table_cache.cpp
+ * @brief Cache AppVars round-trip and reject anything stale or damaged
+ *
+ * Runs CachedTable over a host AppVar (a .bin file in the working
+ * directory): a missing cache is built and stored, the next launch maps
+ * it, and a wrong fingerprint, a flipped payload or header byte, a
+ * truncated file or a failed build all fall back as documented in
+ * util/table_cache.hpp.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "check.hpp"
+#include "util/table_cache.hpp"
+
+namespace {
+
+using util::cache::CacheSource;
+
+constexpr const char* NAME = "BMTSTCA";
+constexpr const char* PATH = "BMTSTCA.bin";  // util::platform's host AppVar file
+constexpr uint32_t FINGERPRINT = 0x7E57CAC3;
+
+struct Table {
+    uint32_t values[256];
+};
+
+Table g_built;
+
+const Table* build() {
+    for (uint32_t i = 0; i < 256; ++i) {
+        g_built.values[i] = i * 2654435761u;
+    }
+    return &g_built;
+}
+
+const Table* fail() {
+    return nullptr;
+}
+
+/// A new launch's view of the cache: how get() resolves it
+CacheSource launch(uint32_t fingerprint, const Table* (*builder)() = build) {
+    util::cache::CachedTable<Table> cache(NAME, fingerprint);
+    const Table* table = cache.get(builder);
+    if (cache.source() == CacheSource::MAPPED) {
+        CHECK(std::memcmp(table, build(), sizeof(Table)) == 0);
+    }
+    CHECK((table != nullptr) == (cache.source() != CacheSource::NONE));
+    return cache.source();
+}
+
+/// Build and store a fresh cache
+void store() {
+    util::cache::CachedTable<Table> cache(NAME, FINGERPRINT);
+    cache.get(build);
+    CHECK(cache.store());
+}
+
+std::vector<uint8_t> read_file() {
+    std::vector<uint8_t> bytes;
+    if (std::FILE* file = std::fopen(PATH, "rb")) {
+        for (int c; (c = std::fgetc(file)) != EOF;) {
+            bytes.push_back(static_cast<uint8_t>(c));
+        }
+        std::fclose(file);
+    }
+    return bytes;
+}
+
+void write_file(const std::vector<uint8_t>& bytes) {
+    if (std::FILE* file = std::fopen(PATH, "wb")) {
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::remove(PATH);
+
+    // Missing: built, and it stores; a failed build is NONE and stores nothing
+    CHECK(launch(FINGERPRINT, fail) == CacheSource::NONE);
+    {
+        util::cache::CachedTable<Table> cache(NAME, FINGERPRINT);
+        CHECK(cache.get(fail) == nullptr && !cache.store());
+    }
+    CHECK(launch(FINGERPRINT) == CacheSource::BUILT);
+    store();
+    const std::vector<uint8_t> good = read_file();
+    CHECK(good.size() == sizeof(util::cache::CacheHeader) + sizeof(Table));
+
+    // Stored: the next launch maps it; other inputs do not
+    CHECK(launch(FINGERPRINT) == CacheSource::MAPPED);
+    CHECK(launch(FINGERPRINT ^ 1) == CacheSource::BUILT);
+
+    // A mapped table is not stored again
+    {
+        util::cache::CachedTable<Table> cache(NAME, FINGERPRINT);
+        cache.get(build);
+        CHECK(cache.source() == CacheSource::MAPPED && !cache.store());
+    }
+
+    // Any flipped byte, header or payload, is rejected (the reserved byte is not read)
+    for (size_t at = 0; at < good.size(); ++at) {
+        if (at == offsetof(util::cache::CacheHeader, reserved))
+            continue;
+        std::vector<uint8_t> bad = good;
+        bad[at] ^= 0x10;
+        write_file(bad);
+        CHECK(launch(FINGERPRINT) == CacheSource::BUILT);
+    }
+
+    // Truncated, extended or empty
+    for (const size_t size : {good.size() - 1, good.size() + 1, size_t{8}, size_t{0}}) {
+        std::vector<uint8_t> bad = good;
+        bad.resize(size);
+        write_file(bad);
+        CHECK(launch(FINGERPRINT) == CacheSource::BUILT);
+    }
+
+    // A payload over one AppVar is refused
+    static uint8_t too_big[util::cache::CACHE_MAX_PAYLOAD + 1];
+    CHECK(!util::cache::write_cache(NAME, FINGERPRINT, too_big, sizeof(too_big)));
+
+    write_file(good);
+    CHECK(launch(FINGERPRINT) == CacheSource::MAPPED);
+    std::remove(PATH);
+    return check::exit_code();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file turn_outcomes.cpp
+ * @brief Every turn's enumerated outcomes add up to probability one
+ *
+ * 3v3 battles are played with random legal actions (switches included).
+ * Before each turn, enumerate_turn() lists the turn's distinct end states:
+ * their probabilities must sum to PROBABILITY_ONE (less the rounding of
+ * the fixed-point products), and the state the turn really ends in must be
+ * one of them.
+ */
+
+#include <cstdint>
+
+#include "check.hpp"
+#include "engine/ai.hpp"
+#include "engine/battle.hpp"
+#include "engine/outcomes.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+
+constexpr uint32_t BATTLES = 60;
+constexpr uint32_t MAX_TURNS = 40;
+constexpr uint16_t CAPACITY = 2048;
+
+engine::PartyRentals draw_party(util::random::Rng& rng) {
+    engine::PartyRentals party{};
+    party.size = 3;
+    for (uint8_t i = 0; i < party.size; ++i) {
+        party.rentals[i] = static_cast<uint16_t>(rng.random(logic::setup::RENTAL_COUNT));
+    }
+    return party;
+}
+
+BattleAction random_action(const engine::BattleEngine& battle, uint8_t side,
+                           util::random::Rng& rng) {
+    const engine::ai::ActionList list = engine::ai::candidate_actions(battle, side);
+    return list.actions[rng.random(list.count)];
+}
+
+engine::TurnOutcome g_outcomes[CAPACITY];
+
+/// Enumerate the turn, then play it and find the state it ended in
+void check_turn(engine::BattleEngine& battle, const BattleAction& p1, const BattleAction& p2) {
+    const engine::TurnEnumeration turn = engine::enumerate_turn(battle, p1, p2, g_outcomes,
+                                                                CAPACITY);
+    CHECK(turn.complete);
+    CHECK(turn.count > 0 && turn.count <= turn.leaves);
+
+    uint64_t total = 0;
+    for (uint16_t i = 0; i < turn.count; ++i) {
+        total += g_outcomes[i].probability;
+    }
+    // Each leaf's product of branch probabilities rounds down by under one
+    // unit per branch (deep leaves can round to zero)
+    const uint64_t slack = uint64_t{turn.leaves} * util::random::DrawTape::MAX_BRANCHES;
+    CHECK(total <= engine::PROBABILITY_ONE);
+    CHECK(total + slack >= engine::PROBABILITY_ONE);
+
+    battle.execute_turn(p1, p2);
+    bool found = false;
+    for (uint16_t i = 0; i < turn.count && !found; ++i) {
+        found = g_outcomes[i].hash == battle.hash();
+    }
+    CHECK(found);
+}
+
+void play(uint32_t n) {
+    util::random::Rng root{};
+    root.seed(0x4F555443, n);
+    util::random::Rng draft = root.split(0);
+    util::random::Rng choices = root.split(1);
+
+    engine::BattleEngine battle;
+    battle.init(draw_party(draft), draw_party(draft), 50, root.split(2));
+    for (uint32_t turn = 0; turn < MAX_TURNS && battle.result() == engine::BattleResult::ONGOING;
+         ++turn) {
+        for (uint8_t side = 0; side < 2; ++side) {
+            if (battle.needs_replacement(side))
+                battle.replace(side, random_action(battle, side, choices).index);
+        }
+        if (battle.result() != engine::BattleResult::ONGOING)
+            break;
+        const BattleAction p1 = random_action(battle, 0, choices);
+        const BattleAction p2 = random_action(battle, 1, choices);
+        check_turn(battle, p1, p2);
+    }
+}
+
+}  // namespace
+
+int main() {
+    for (uint32_t n = 0; n < BATTLES; ++n) {
+        play(n);
+    }
+    return check::exit_code();
+}
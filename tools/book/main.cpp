@@ -0,0 +1,143 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_book - searches the opening book for the calculator's AI
+ *
+ * Searches the opening position of every ordered pair of lead rentals on
+ * all cores (engine/book_builder.hpp) and writes the sorted table as the
+ * BMBOOK cache AppVar (engine/opening_book.hpp), BMBOOK.bin in the working
+ * directory.
+ *
+ * Usage:
+ *   battlemon_book [--rentals R | --leads FILE] [--level L] [--depth D] [--samples C]
+ *                  [--exact] [--threads J]
+ *
+ * --rentals R books the first R rentals of g_RENTAL_SETS; --leads FILE
+ * books the rental indices listed in FILE (whitespace-separated). A book
+ * holds BOOK_MAX_ENTRIES pairs, so at most 90 leads.
+ *
+ * The AppVar is sent to the calculator after conversion, e.g.
+ * `convbin -j bin -k 8xv -r -n BMBOOK -i BMBOOK.bin -o BMBOOK.8xv` (-r: archived).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "engine/book_builder.hpp"
+#include "logic/setup/rental.hpp"
+
+namespace {
+
+struct Options {
+    engine::book::BookBuildOptions build{};
+    uint16_t rentals = 32;
+    const char* leads_path = nullptr;
+    unsigned threads = 0;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--rentals R | --leads FILE] [--level 50|100] [--depth D] "
+                 "[--samples C]\n"
+                 "          [--exact] [--threads J]\n",
+                 argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--exact") == 0) {
+            options.build.exact_chance = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--leads") == 0) {
+            options.leads_path = argv[++i];
+            continue;
+        }
+        unsigned long long value = std::strtoull(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--rentals") == 0) {
+            options.rentals = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--level") == 0) {
+            options.build.level = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--depth") == 0) {
+            options.build.max_depth = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--samples") == 0) {
+            options.build.chance_samples = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else {
+            return false;
+        }
+    }
+    return options.rentals <= logic::setup::RENTAL_COUNT && options.build.max_depth >= 1 &&
+           options.build.max_depth <= engine::ai::MAX_SEARCH_DEPTH &&
+           options.build.chance_samples >= 1;
+}
+
+/// Rental indices listed in `path`; false if unreadable or out of range
+bool read_leads(const char* path, std::vector<uint16_t>& leads) {
+    std::FILE* file = std::fopen(path, "r");
+    if (!file)
+        return false;
+    unsigned index = 0;
+    bool ok = true;
+    while (ok && std::fscanf(file, "%u", &index) == 1) {
+        ok = index < logic::setup::RENTAL_COUNT;
+        leads.push_back(static_cast<uint16_t>(index));
+    }
+    ok = ok && std::feof(file);
+    std::fclose(file);
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<uint16_t> leads;
+    if (options.leads_path) {
+        if (!read_leads(options.leads_path, leads)) {
+            std::fprintf(stderr, "cannot read the rental indices in %s\n", options.leads_path);
+            return 1;
+        }
+    } else {
+        for (uint16_t i = 0; i < options.rentals; ++i) {
+            leads.push_back(i);
+        }
+    }
+
+    engine::BatchRunner runner(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    engine::book::BookBuildStats stats{};
+    const auto entries = engine::book::build_opening_book(runner, leads, options.build, &stats);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (entries.empty()) {
+        std::fprintf(stderr, "no leads, or more pairs than a book holds (%zu)\n",
+                     engine::book::BOOK_MAX_ENTRIES);
+        return 1;
+    }
+    if (!engine::book::write_opening_book(entries, options.build.level)) {
+        std::fprintf(stderr, "cannot write the %s AppVar\n", engine::book::BOOK_APPVAR);
+        return 1;
+    }
+
+    std::printf("entries:          %zu (%zu bytes)\n", entries.size(),
+                entries.size() * sizeof(engine::book::BookEntry));
+    std::printf("search:           depth %u, %llu turns in %.3f s\n", options.build.max_depth,
+                static_cast<unsigned long long>(stats.nodes), seconds);
+    std::printf("written:          %s.bin\n", engine::book::BOOK_APPVAR);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_league - self-play league over search AI configurations
+ *
+ * Keeps a population of engine::ai::Searcher configurations (leaf weights,
+ * depth, chance samples) and plays rounds of mirrored matches between them
+ * on all cores, close-rated pairs first, with Elo ratings updated game by
+ * game (engine/league.hpp). The league is checkpointed after every round,
+ * so a stopped run resumes where it left off.
+ *
+ * Usage:
+ *   battlemon_league --checkpoint FILE [--rounds R] [--matches M] [--drafts D]
+ *                    [--seed S] [--level L] [--max-turns T] [--threads J] [--k K]
+ *   battlemon_league ... --spawn N [--spread P] [--depth D] [--samples C]
+ *
+ * An existing checkpoint is resumed; without one, --spawn N starts a new
+ * league of the built-in weights and N - 1 perturbations of them (each
+ * weight moved by up to P percent). The checkpoint is text: entrants can be
+ * added or edited by hand between runs (engine::league::League::write()).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "engine/batch.hpp"
+#include "engine/league.hpp"
+
+namespace {
+
+struct Options {
+    const char* checkpoint = nullptr;
+    engine::league::LeagueOptions league{};
+    uint32_t rounds = 10;
+    uint16_t spawn = 0;
+    uint8_t spread = 25;
+    uint8_t depth = 1;
+    uint8_t samples = 2;
+    unsigned threads = 0;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s --checkpoint FILE [--rounds R] [--matches M] [--drafts D] "
+                 "[--seed S]\n"
+                 "          [--level 50|100] [--max-turns T] [--threads J] [--k K]\n"
+                 "          [--spawn N] [--spread P] [--depth D] [--samples C]\n",
+                 argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--checkpoint") == 0) {
+            options.checkpoint = argv[++i];
+            continue;
+        }
+        if (std::strcmp(arg, "--k") == 0) {
+            options.league.k_factor = std::strtod(argv[++i], nullptr);
+            continue;
+        }
+        unsigned long long value = std::strtoull(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--rounds") == 0) {
+            options.rounds = static_cast<uint32_t>(value);
+        } else if (std::strcmp(arg, "--matches") == 0) {
+            options.league.matches_per_round = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--drafts") == 0) {
+            options.league.drafts_per_match = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.league.seed = static_cast<uint64_t>(value);
+        } else if (std::strcmp(arg, "--level") == 0) {
+            options.league.level = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--max-turns") == 0) {
+            options.league.max_turns = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(arg, "--spawn") == 0) {
+            options.spawn = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--spread") == 0) {
+            options.spread = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--depth") == 0) {
+            options.depth = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--samples") == 0) {
+            options.samples = static_cast<uint8_t>(value);
+        } else {
+            return false;
+        }
+    }
+    return options.checkpoint != nullptr && options.league.drafts_per_match > 0 &&
+           options.league.k_factor > 0.0 && options.depth >= 1 &&
+           options.depth <= engine::ai::MAX_SEARCH_DEPTH && options.samples >= 1 &&
+           options.spread <= 100;
+}
+
+void print_standings(const engine::league::League& league) {
+    const auto& population = league.population();
+    std::vector<size_t> order(population.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return population[x].rating > population[y].rating;
+    });
+
+    std::printf("%-12s %7s %7s %6s  %s\n", "entrant", "rating", "games", "score", "weights");
+    for (const size_t i : order) {
+        const auto& entrant = population[i];
+        const double score = entrant.games > 0 ? entrant.points / (2.0 * entrant.games) : 0.0;
+        std::printf("%-12s %7.1f %7u %5.1f%%  {", entrant.name.c_str(), entrant.rating,
+                    entrant.games, 100.0 * score);
+        for (uint8_t f = 0; f < engine::ai::EVAL_FEATURE_COUNT; ++f) {
+            std::printf(f == 0 ? "%d" : ", %d", entrant.weights.weight[f]);
+        }
+        std::printf("} d%u s%u\n", entrant.max_depth, entrant.chance_samples);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    engine::league::League league({}, options.league);
+    if (league.read(options.checkpoint)) {
+        std::printf("resumed:          %s (round %u, %zu entrants)\n", options.checkpoint,
+                    league.round(), league.population().size());
+    } else if (options.spawn >= 2) {
+        league = engine::league::League(
+            engine::league::spawn_population(options.spawn, options.league.seed, options.spread,
+                                             options.depth, options.samples),
+            options.league);
+        std::printf("spawned:          %u entrants\n", options.spawn);
+    } else {
+        std::fprintf(stderr, "%s: no checkpoint to resume; --spawn N (N >= 2) starts one\n",
+                     options.checkpoint);
+        return 1;
+    }
+    if (league.population().size() < 2) {
+        std::fprintf(stderr, "%s: a league needs two entrants\n", options.checkpoint);
+        return 1;
+    }
+
+    engine::BatchRunner runner(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t games = 0;
+    for (uint32_t r = 0; r < options.rounds; ++r) {
+        const engine::league::RoundReport report = league.play_round(runner);
+        games += report.games;
+
+        double priority = 0.0;
+        for (const auto& match : report.matches) {
+            priority += match.match.priority;
+        }
+        std::printf("round %-5u %3zu matches %6llu games %8llu turns  mean p(1-p)/repeat %.3f\n",
+                    report.round, report.matches.size(),
+                    static_cast<unsigned long long>(report.games),
+                    static_cast<unsigned long long>(report.turns),
+                    report.matches.empty() ? 0.0 : priority / report.matches.size());
+
+        if (!league.write(options.checkpoint)) {
+            std::fprintf(stderr, "cannot write %s\n", options.checkpoint);
+            return 1;
+        }
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("\n");
+    print_standings(league);
+    std::printf("\ngames:            %llu in %.3f s", static_cast<unsigned long long>(games),
+                seconds);
+    if (seconds > 0.0 && games > 0) {
+        std::printf(" (%.0f games/s)", static_cast<double>(games) / seconds);
+    }
+    std::printf("\nwritten:          %s\n", options.checkpoint);
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_matrix - rental x rental matchup matrix generator
+ *
+ * Plays every ordered pair of g_RENTAL_SETS a fixed number of times on all
+ * cores and writes win rates and expected battle lengths to a matrix file
+ * (engine/matchup_matrix.hpp) that readers mmap.
+ *
+ * Usage:
+ *   battlemon_matrix --out FILE [--battles N] [--seed S] [--level L] [--max-turns T]
+ *                    [--threads J] [--ai] [--rentals R]
+ *   battlemon_matrix --out FILE --update [--effect E]...
+ *   battlemon_matrix ... --advisor   also write the calculator's advisor AppVars
+ *                                    (BMAV0.bin, BMAV1.bin, ... in the working directory)
+ *
+ * --update reuses FILE if it was generated with the same parameters and
+ * replays only the rows and columns of rentals whose fingerprint changed;
+ * --effect E also replays every rental with a move of effect id E (for a
+ * routine whose code changed while its data did not). Incompatible or
+ * missing files are regenerated in full.
+ *
+ * Advisor AppVars (engine/advisor.hpp) are sent to the calculator after
+ * conversion, e.g. `convbin -j bin -k 8xv -r -n BMAV0 -i BMAV0.bin -o BMAV0.8xv`
+ * (-r: archived).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "engine/batch.hpp"
+#include "engine/matchup_matrix.hpp"
+#include "logic/setup/rental.hpp"
+
+namespace {
+
+struct Options {
+    const char* out_path = nullptr;
+    engine::MatrixParams params{};
+    unsigned threads = 0;
+    uint16_t rentals = logic::setup::RENTAL_COUNT;
+    bool update = false;
+    bool advisor = false;
+    std::vector<uint16_t> effects;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s --out FILE [--battles N] [--seed S] [--level 50|100] "
+                 "[--max-turns T]\n"
+                 "          [--threads J] [--ai] [--rentals R] [--update] [--effect E]...\n"
+                 "          [--advisor]\n",
+                 argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--ai") == 0) {
+            options.params.policy = engine::MatrixPolicy::SEARCH;
+            continue;
+        }
+        if (std::strcmp(arg, "--update") == 0) {
+            options.update = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--advisor") == 0) {
+            options.advisor = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--out") == 0) {
+            options.out_path = argv[++i];
+            continue;
+        }
+        unsigned long long value = std::strtoull(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--battles") == 0) {
+            options.params.battles_per_pair = static_cast<uint32_t>(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.params.seed = static_cast<uint64_t>(value);
+        } else if (std::strcmp(arg, "--level") == 0) {
+            options.params.level = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--max-turns") == 0) {
+            options.params.max_turns = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(arg, "--rentals") == 0) {
+            options.rentals = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--effect") == 0) {
+            options.effects.push_back(static_cast<uint16_t>(value));
+        } else {
+            return false;
+        }
+    }
+    return options.out_path != nullptr && options.rentals > 0 &&
+           options.rentals <= logic::setup::RENTAL_COUNT;
+}
+
+/// An existing matrix whose cells are comparable with a run of `options`
+bool compatible(const engine::MatchupMatrixView& view, const Options& options) {
+    const engine::MatrixHeader& header = view.header();
+    const engine::MatrixParams& params = options.params;
+    return header.rules_version == engine::MATRIX_RULES_VERSION &&
+           header.rental_count == options.rentals &&
+           header.battles_per_pair == params.battles_per_pair && header.seed == params.seed &&
+           header.level == params.level && header.max_turns == params.max_turns &&
+           header.policy == static_cast<uint8_t>(params.policy);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    const size_t count = options.rentals;
+    std::vector<uint64_t> fingerprints(count);
+    for (size_t i = 0; i < count; ++i) {
+        fingerprints[i] = engine::rental_fingerprint(i);
+    }
+
+    std::vector<engine::MatchupCell> cells(count * count);
+    std::vector<uint8_t> dirty(count, 1);
+    if (options.update) {
+        engine::MatchupMatrixView existing;
+        if (existing.open(options.out_path) && compatible(existing, options)) {
+            const auto old_cells = existing.cells();
+            const auto old_fingerprints = existing.fingerprints();
+            cells.assign(old_cells.begin(), old_cells.end());
+            for (size_t i = 0; i < count; ++i) {
+                dirty[i] = old_fingerprints[i] != fingerprints[i];
+                for (const uint16_t effect : options.effects) {
+                    dirty[i] |= engine::rental_uses_effect(i, effect);
+                }
+            }
+        } else {
+            std::printf("%s: no compatible matrix, regenerating in full\n", options.out_path);
+        }
+    }
+
+    size_t dirty_rows = 0;
+    for (const uint8_t flag : dirty) {
+        dirty_rows += flag;
+    }
+
+    engine::BatchRunner runner(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    const size_t computed =
+        engine::compute_matchups(runner, options.params, count, dirty, cells);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!engine::write_matrix(options.out_path, options.params, fingerprints, cells)) {
+        std::fprintf(stderr, "cannot write %s\n", options.out_path);
+        return 1;
+    }
+
+    const double battles = static_cast<double>(computed) * options.params.battles_per_pair;
+    std::printf("rentals:          %zu (%zu changed)\n", count, dirty_rows);
+    std::printf("cells computed:   %zu of %zu\n", computed, cells.size());
+    std::printf("battles:          %.0f in %.3f s", battles, seconds);
+    if (seconds > 0.0 && battles > 0.0) {
+        std::printf(" (%.0f battles/s)", battles / seconds);
+    }
+    std::printf("\nwritten:          %s\n", options.out_path);
+
+    if (options.advisor) {
+        engine::MatchupMatrixView matrix;
+        const uint8_t parts = matrix.open(options.out_path) ? engine::write_advisor_appvars(matrix)
+                                                            : 0;
+        if (parts == 0) {
+            std::fprintf(stderr, "cannot write the advisor AppVars\n");
+            return 1;
+        }
+        std::printf("advisor:          %s0-%u (%u AppVars)\n",
+                    engine::factory::ADVISOR_APPVAR_PREFIX, parts - 1u,
+                    static_cast<unsigned>(parts));
+    }
+    return 0;
+}
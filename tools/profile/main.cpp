@@ -0,0 +1,106 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_profile - print a BMPROF section profile
+ *
+ * Reads a dump written by util::profile::dump(): either the AppVar pulled off
+ * the calculator (BMPROF.8xv) or the BMPROF.bin a host profiling build
+ * writes. The dump is located by its magic, so the .8xv file header needs no
+ * parsing.
+ *
+ * Usage:
+ *   battlemon_profile BMPROF.8xv
+ */
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "util/profile.hpp"
+
+namespace {
+
+bool read_file(const char* path, std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+    return true;
+}
+
+/// Offset of the dump header within the file, or -1
+long find_dump(const std::vector<uint8_t>& bytes) {
+    for (size_t i = 0; i + sizeof(util::profile::DumpHeader) <= bytes.size(); ++i) {
+        uint32_t magic;
+        std::memcpy(&magic, &bytes[i], sizeof(magic));
+        if (magic == util::profile::DUMP_MAGIC) {
+            return static_cast<long>(i);
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using util::profile::DumpHeader;
+    using util::profile::SectionRecord;
+
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s BMPROF.8xv|BMPROF.bin\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> bytes;
+    if (!read_file(argv[1], bytes)) {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    const long offset = find_dump(bytes);
+    if (offset < 0) {
+        std::fprintf(stderr, "%s: no profile dump found\n", argv[1]);
+        return 1;
+    }
+
+    DumpHeader header;
+    std::memcpy(&header, &bytes[offset], sizeof(header));
+    if (header.version != util::profile::DUMP_VERSION) {
+        std::fprintf(stderr, "%s: unsupported dump version %u\n", argv[1], header.version);
+        return 1;
+    }
+    const size_t records_at = static_cast<size_t>(offset) + sizeof(header);
+    if (records_at + header.section_count * sizeof(SectionRecord) > bytes.size()) {
+        std::fprintf(stderr, "%s: truncated dump\n", argv[1]);
+        return 1;
+    }
+
+    const double us_per_tick = 1e6 / header.clock_hz;
+    std::printf("clock %" PRIu32 " Hz, %" PRIu32 " ticks overhead per sample\n\n",
+                header.clock_hz, header.overhead);
+    std::printf("%-16s %10s %10s %12s %10s %12s\n", "section", "count", "min", "mean", "max",
+                "total us");
+
+    for (uint8_t i = 0; i < header.section_count; ++i) {
+        SectionRecord rec;
+        std::memcpy(&rec, &bytes[records_at + i * sizeof(SectionRecord)], sizeof(rec));
+        rec.name[sizeof(rec.name) - 1] = '\0';
+        if (rec.count == 0) {
+            std::printf("%-16s %10s\n", rec.name, "-");
+            continue;
+        }
+
+        const uint64_t total = (static_cast<uint64_t>(rec.total_hi) << 32) | rec.total_lo;
+        std::printf("%-16s %10" PRIu32 " %10" PRIu32 " %12.1f %10" PRIu32 " %12.1f\n", rec.name,
+                    rec.count, rec.min, static_cast<double>(total) / rec.count, rec.max,
+                    static_cast<double>(total) * us_per_tick);
+    }
+    return 0;
+}
@@ -0,0 +1,552 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_server - long-lived battle server over a line protocol
+ *
+ * Serves battles to an orchestrator without a process per battle: one
+ * request per line, one reply line per request, in order. Requests can be
+ * pipelined: each read is processed as a whole and its replies go out in
+ * one write. Battles are multiplexed by id within a connection.
+ *
+ * Usage:
+ *   battlemon_server [--threads J]                 serve stdin / stdout
+ *   battlemon_server --listen PORT [--bind ADDR]   serve TCP (default 127.0.0.1),
+ *                                                  one thread per connection
+ *
+ * Protocol (RENTAL is an index or * for a seeded pick, MOVE a slot 0-3 or
+ * a POLICY: random, greedy or search; RESULT is ongoing, p1 or p2):
+ *
+ *   new RENTAL RENTAL [LEVEL] [SEED]        -> ok ID
+ *   act ID MOVE MOVE                        -> ok ID RESULT TURNS
+ *   state ID                                -> state ID RESULT TURNS HP/MAX HP/MAX LEGAL LEGAL
+ *   run ID POLICY POLICY [MAX_TURNS]        -> done ID RESULT TURNS
+ *   bulk N POLICY POLICY [LEVEL] [SEED] [MAX_TURNS]
+ *                                           -> bulk N P1_WINS P2_WINS UNFINISHED TURNS
+ *   drop ID                                 -> ok ID
+ *   quit                                    closes the connection
+ *
+ * Errors reply `err MESSAGE`. LEGAL is the side's engine::ActionMask in hex;
+ * `act` with a slot outside it (no PP, disabled, taunted, ...) is an error.
+ * A battle plays at most 65535 turns (MAX_TURNS included); `act` past that
+ * is an error.
+ *
+ * Seeding matches battlemon_sim: battle SEED runs its rentals on the streams
+ * engine::run_job() derives from it (a `new` battle played out with `run`
+ * matches the job of the same rentals and seed), * picks rentals like the
+ * sim's random pairings, and `bulk N random random L S` reports the totals
+ * of `battlemon_sim --battles N --level L --seed S`.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/ai.hpp"
+#include "engine/batch.hpp"
+#include "engine/policy.hpp"
+#include "engine/simulate.hpp"
+#include "logic/setup/rental.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+using engine::BattleAction;
+using engine::BattleEngine;
+using engine::BattleResult;
+
+constexpr size_t MAX_TOKENS = 8;
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+// Largest batch one `bulk` request may run
+constexpr uint64_t MAX_BULK_BATTLES = 10'000'000;
+
+// Jobs a `bulk` request builds and runs at a time: bounds its memory, and
+// connections waiting on the shared runner get a turn between chunks
+constexpr uint64_t BULK_CHUNK = 65'536;
+
+// ServedBattle::turns is 16-bit
+constexpr unsigned MAX_SERVED_TURNS = 0xFFFF;
+
+struct Options {
+    unsigned threads = 0;
+    int port = -1;
+    const char* bind_address = "127.0.0.1";
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--threads J]\n"
+                 "       %s --listen PORT [--bind ADDR] [--threads J]\n",
+                 argv0, argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--bind") == 0) {
+            options.bind_address = argv[++i];
+            continue;
+        }
+        unsigned long value = std::strtoul(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(arg, "--listen") == 0 && value <= 0xFFFF) {
+            options.port = static_cast<int>(value);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+//                                REQUESTS
+// ============================================================================
+
+struct Request {
+    std::string_view tokens[MAX_TOKENS];
+    size_t count{0};
+};
+
+Request tokenize(std::string_view line) {
+    Request request;
+    size_t at = 0;
+    while (at < line.size() && request.count < MAX_TOKENS) {
+        while (at < line.size() && (line[at] == ' ' || line[at] == '\t' || line[at] == '\r'))
+            ++at;
+        const size_t begin = at;
+        while (at < line.size() && line[at] != ' ' && line[at] != '\t' && line[at] != '\r')
+            ++at;
+        if (at > begin)
+            request.tokens[request.count++] = line.substr(begin, at - begin);
+    }
+    return request;
+}
+
+template <typename T>
+bool parse_number(std::string_view token, T& value) {
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+    return error == std::errc{} && end == token.data() + token.size();
+}
+
+bool parse_policy(std::string_view token, engine::Policy& policy) {
+    if (token == "random") {
+        policy = engine::random_move_policy;
+    } else if (token == "greedy") {
+        policy = engine::greedy_damage_policy;
+    } else if (token == "search") {
+        policy = engine::ai::search_policy;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* result_name(BattleResult result) {
+    switch (result) {
+        case BattleResult::P1_WINS:
+            return "p1";
+        case BattleResult::P2_WINS:
+            return "p2";
+        default:
+            return "ongoing";
+    }
+}
+
+/// Printf-append to a reply buffer
+template <typename... Args>
+void reply(std::string& out, const char* format, Args... args) {
+    char line[256];
+    const int length = std::snprintf(line, sizeof(line), format, args...);
+    if (length > 0)
+        out.append(line, static_cast<size_t>(length) < sizeof(line) ? length : sizeof(line) - 1);
+    out.push_back('\n');
+}
+
+// ============================================================================
+//                                SESSION
+// ============================================================================
+//
+// One connection's battles. Bulk runs share the process-wide BatchRunner,
+// one request at a time.
+//
+// ============================================================================
+
+struct ServedBattle {
+    BattleEngine battle;
+    util::random::Rng policy_rng;
+    uint16_t turns{0};
+};
+
+struct Shared {
+    engine::BatchRunner runner;
+    std::mutex runner_mutex;
+
+    explicit Shared(unsigned threads) : runner(threads) {}
+};
+
+class Session {
+   public:
+    explicit Session(Shared& shared) : shared_(shared) {}
+
+    /// Handle one request line; false once the client asked to quit
+    bool handle(std::string_view line, std::string& out) {
+        const Request request = tokenize(line);
+        if (request.count == 0)
+            return true;
+        const std::string_view command = request.tokens[0];
+
+        if (command == "quit")
+            return false;
+        if (command == "new") {
+            create(request, out);
+        } else if (command == "act") {
+            act(request, out);
+        } else if (command == "state") {
+            state(request, out);
+        } else if (command == "run") {
+            run(request, out);
+        } else if (command == "bulk") {
+            bulk(request, out);
+        } else if (command == "drop") {
+            drop(request, out);
+        } else {
+            reply(out, "err unknown command");
+        }
+        return true;
+    }
+
+   private:
+    ServedBattle* find(const Request& request, std::string& out) {
+        uint32_t id = 0;
+        if (request.count < 2 || !parse_number(request.tokens[1], id)) {
+            reply(out, "err expected a battle id");
+            return nullptr;
+        }
+        const auto it = battles_.find(id);
+        if (it == battles_.end()) {
+            reply(out, "err no battle %u", id);
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    void create(const Request& request, std::string& out) {
+        uint16_t rentals[2] = {0, 0};
+        unsigned level = 50;
+        uint64_t seed = 0;
+        if (request.count < 3 || (request.count > 3 && !parse_number(request.tokens[3], level)) ||
+            (request.count > 4 && !parse_number(request.tokens[4], seed))) {
+            reply(out, "err usage: new RENTAL RENTAL [LEVEL] [SEED]");
+            return;
+        }
+        if (level < 1 || level > 100) {
+            reply(out, "err level must be 1-100");
+            return;
+        }
+
+        // * draws like battlemon_sim's random pairings
+        util::random::Rng pairing{};
+        pairing.seed(seed, ~seed);
+        for (uint8_t side = 0; side < 2; ++side) {
+            const std::string_view token = request.tokens[1 + side];
+            const uint16_t drawn = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+            if (token == "*") {
+                rentals[side] = drawn;
+            } else if (!parse_number(token, rentals[side]) ||
+                       rentals[side] >= logic::setup::RENTAL_COUNT) {
+                reply(out, "err rental out of range (0-%u)", logic::setup::RENTAL_COUNT - 1u);
+                return;
+            }
+        }
+
+        // Streams as engine::run_job() derives them
+        auto served = std::make_unique<ServedBattle>();
+        util::random::Rng root{};
+        root.seed(seed, seed);
+        served->battle.init(rentals[0], rentals[1], static_cast<uint8_t>(level), root.split(0));
+        served->policy_rng = root.split(1);
+
+        const uint32_t id = next_id_++;
+        battles_.emplace(id, std::move(served));
+        reply(out, "ok %u", id);
+    }
+
+    void act(const Request& request, std::string& out) {
+        ServedBattle* served = find(request, out);
+        if (served == nullptr)
+            return;
+        if (request.count < 4) {
+            reply(out, "err usage: act ID MOVE MOVE");
+            return;
+        }
+        auto& battle = served->battle;
+        if (battle.result() != BattleResult::ONGOING) {
+            reply(out, "err battle is over");
+            return;
+        }
+
+        BattleAction actions[2];
+        for (uint8_t side = 0; side < 2; ++side) {
+            const std::string_view token = request.tokens[2 + side];
+            unsigned slot = 0;
+            engine::Policy policy = nullptr;
+            if (parse_number(token, slot) && slot < 4) {
+                actions[side] = BattleAction::move(static_cast<uint8_t>(slot));
+                if ((battle.legal_actions(side) & engine::action_bit(actions[side])) == 0) {
+                    reply(out, "err move %u is not legal for p%u", slot, side + 1u);
+                    return;
+                }
+            } else if (parse_policy(token, policy)) {
+                actions[side] = policy(battle, side, served->policy_rng);
+            } else {
+                reply(out, "err move must be a slot 0-3 or a policy");
+                return;
+            }
+        }
+        if (served->turns >= MAX_SERVED_TURNS) {
+            reply(out, "err turn limit reached (%u)", MAX_SERVED_TURNS);
+            return;
+        }
+        battle.execute_turn(actions[0], actions[1]);
+        ++served->turns;
+        reply(out, "ok %s %s %u", std::string(request.tokens[1]).c_str(),
+              result_name(battle.result()), served->turns);
+    }
+
+    void state(const Request& request, std::string& out) {
+        const ServedBattle* served = find(request, out);
+        if (served == nullptr)
+            return;
+        const auto& battle = served->battle;
+        reply(out, "state %s %s %u %u/%u %u/%u %x %x", std::string(request.tokens[1]).c_str(),
+              result_name(battle.result()), served->turns, battle.p1_mon().current_hp,
+              battle.p1_mon().max_hp, battle.p2_mon().current_hp, battle.p2_mon().max_hp,
+              battle.legal_actions(0), battle.legal_actions(1));
+    }
+
+    void run(const Request& request, std::string& out) {
+        ServedBattle* served = find(request, out);
+        if (served == nullptr)
+            return;
+        engine::Policy policies[2] = {nullptr, nullptr};
+        unsigned max_turns = engine::DEFAULT_MAX_TURNS;
+        if (request.count < 4 || !parse_policy(request.tokens[2], policies[0]) ||
+            !parse_policy(request.tokens[3], policies[1]) ||
+            (request.count > 4 && !parse_number(request.tokens[4], max_turns))) {
+            reply(out, "err usage: run ID POLICY POLICY [MAX_TURNS]");
+            return;
+        }
+        if (max_turns > MAX_SERVED_TURNS) {
+            reply(out, "err max turns must be <= %u", MAX_SERVED_TURNS);
+            return;
+        }
+
+        // MAX_TURNS caps the battle's total turns, those already played included
+        if (served->turns < max_turns) {
+            const engine::BattleOutcome outcome =
+                engine::run_battle(served->battle, policies[0], policies[1], served->policy_rng,
+                                   static_cast<uint16_t>(max_turns - served->turns));
+            served->turns = static_cast<uint16_t>(served->turns + outcome.turns);
+        }
+        auto& battle = served->battle;
+        reply(out, "done %s %s %u", std::string(request.tokens[1]).c_str(),
+              result_name(battle.result()), served->turns);
+    }
+
+    void bulk(const Request& request, std::string& out) {
+        uint64_t count = 0;
+        engine::Policy policies[2] = {nullptr, nullptr};
+        unsigned level = 50;
+        uint64_t seed = 0;
+        unsigned max_turns = engine::DEFAULT_MAX_TURNS;
+        if (request.count < 4 || !parse_number(request.tokens[1], count) ||
+            !parse_policy(request.tokens[2], policies[0]) ||
+            !parse_policy(request.tokens[3], policies[1]) ||
+            (request.count > 4 && !parse_number(request.tokens[4], level)) ||
+            (request.count > 5 && !parse_number(request.tokens[5], seed)) ||
+            (request.count > 6 && !parse_number(request.tokens[6], max_turns))) {
+            reply(out, "err usage: bulk N POLICY POLICY [LEVEL] [SEED] [MAX_TURNS]");
+            return;
+        }
+        if (count > MAX_BULK_BATTLES || level < 1 || level > 100 ||
+            max_turns > MAX_SERVED_TURNS) {
+            reply(out, "err bulk limits: N <= %llu, level 1-100, max turns <= %u",
+                  static_cast<unsigned long long>(MAX_BULK_BATTLES), MAX_SERVED_TURNS);
+            return;
+        }
+
+        // Jobs as battlemon_sim's make_random_jobs() builds them, a chunk at a time
+        engine::BatchTotals totals{};
+        std::vector<engine::BatchJob> jobs;
+        for (uint64_t begin = 0; begin < count; begin += BULK_CHUNK) {
+            const uint64_t end = count - begin < BULK_CHUNK ? count : begin + BULK_CHUNK;
+            jobs.assign(end - begin, engine::BatchJob{});
+            for (uint64_t i = begin; i < end; ++i) {
+                auto& job = jobs[i - begin];
+                job.seed = util::random::mix64(seed + i);
+                util::random::Rng pairing{};
+                pairing.seed(job.seed, ~job.seed);
+                job.rental_a = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+                job.rental_b = static_cast<uint16_t>(pairing.random(logic::setup::RENTAL_COUNT));
+                job.policy_a = policies[0];
+                job.policy_b = policies[1];
+                job.level = static_cast<uint8_t>(level);
+                job.max_turns = static_cast<uint16_t>(max_turns);
+            }
+
+            std::vector<engine::BattleOutcome> outcomes;
+            {
+                const std::lock_guard lock(shared_.runner_mutex);
+                outcomes = shared_.runner.run(jobs);
+            }
+            const engine::BatchTotals chunk = engine::summarize(outcomes);
+            totals.p1_wins += chunk.p1_wins;
+            totals.p2_wins += chunk.p2_wins;
+            totals.unfinished += chunk.unfinished;
+            totals.turns += chunk.turns;
+        }
+        reply(out, "bulk %llu %llu %llu %llu %llu", static_cast<unsigned long long>(count),
+              static_cast<unsigned long long>(totals.p1_wins),
+              static_cast<unsigned long long>(totals.p2_wins),
+              static_cast<unsigned long long>(totals.unfinished),
+              static_cast<unsigned long long>(totals.turns));
+    }
+
+    void drop(const Request& request, std::string& out) {
+        if (find(request, out) == nullptr)
+            return;
+        uint32_t id = 0;
+        parse_number(request.tokens[1], id);
+        battles_.erase(id);
+        reply(out, "ok %u", id);
+    }
+
+    Shared& shared_;
+    std::unordered_map<uint32_t, std::unique_ptr<ServedBattle>> battles_;
+    uint32_t next_id_{1};
+};
+
+// ============================================================================
+//                               TRANSPORT
+// ============================================================================
+
+bool write_all(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/// Serve one connection until EOF or quit: every read's complete lines, then one write
+void serve(Shared& shared, int in_fd, int out_fd) {
+    Session session(shared);
+    std::string pending;
+    std::string replies;
+    std::vector<char> chunk(READ_CHUNK);
+
+    bool open = true;
+    while (open) {
+        const ssize_t n = ::read(in_fd, chunk.data(), chunk.size());
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        pending.append(chunk.data(), static_cast<size_t>(n));
+
+        size_t begin = 0;
+        for (size_t end; open && (end = pending.find('\n', begin)) != std::string::npos;
+             begin = end + 1) {
+            open = session.handle(std::string_view(pending).substr(begin, end - begin), replies);
+        }
+        pending.erase(0, begin);
+
+        if (!replies.empty() && !write_all(out_fd, replies))
+            break;
+        replies.clear();
+    }
+}
+
+int listen_on(const Options& options) {
+    const int server = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server < 0) {
+        std::perror("socket");
+        return 1;
+    }
+    const int reuse = 1;
+    ::setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+    if (::inet_pton(AF_INET, options.bind_address, &address.sin_addr) != 1) {
+        std::fprintf(stderr, "bad bind address %s\n", options.bind_address);
+        return 1;
+    }
+    if (::bind(server, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(server, 64) != 0) {
+        std::perror("bind");
+        return 1;
+    }
+
+    Shared shared(options.threads);
+    std::fprintf(stderr, "listening on %s:%d\n", options.bind_address, options.port);
+    for (;;) {
+        const int client = ::accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR)
+                continue;
+            std::perror("accept");
+            return 1;
+        }
+        std::thread([&shared, client] {
+            serve(shared, client, client);
+            ::close(client);
+        }).detach();
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // A client hanging up mid-reply fails the write instead of killing the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (options.port >= 0) {
+        return listen_on(options);
+    }
+    Shared shared(options.threads);
+    serve(shared, STDIN_FILENO, STDOUT_FILENO);
+    return 0;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_sim - headless host battle simulator
+ *
+ * Plays random rental-vs-rental battles with a uniform random move policy on
+ * all cores and reports aggregate results and throughput.
+ *
+ * Usage:
+ *   battlemon_sim [--battles N] [--seed S] [--level L] [--max-turns T] [--threads J]
+ *   battlemon_sim --sweep [--seed S] [--level L] [--threads J]
+ *   battlemon_sim ... --log FILE     also write every battle's log to FILE
+ *   battlemon_sim ... --ai           player 1 searches (engine::ai::search_policy)
+ *   battlemon_sim ... --crn          common random numbers (per-site roll streams)
+ *   battlemon_sim --replay FILE      re-execute the logs in FILE and verify them
+ *   battlemon_sim --estimate A B [--epsilon E] [--delta D]
+ *                                    win rate of rental A vs. B to +-E at 1-D confidence
+ *   battlemon_sim --factory RUNS [--rounds R] [--matrix FILE] [--fast]
+ *                                    Battle Factory streak distribution; with a matrix
+ *                                    (battlemon_matrix) drafts by rating, --fast decides
+ *                                    fights from it
+ *
+ * Battle i of a run is reproducible from (seed, i) alone, independent of
+ * the thread count. Logs are written in job order with an RNG checkpoint
+ * every LOG_CHECKPOINT_INTERVAL turns.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "data/rental.hpp"
+#include "engine/ai.hpp"
+#include "engine/batch.hpp"
+#include "engine/battle_log.hpp"
+#include "engine/estimate.hpp"
+#include "engine/factory.hpp"
+#include "engine/matchup_matrix.hpp"
+#include "util/random.hpp"
+
+namespace {
+
+constexpr uint16_t RENTAL_COUNT = sizeof(data::g_RENTAL_SETS) / sizeof(data::g_RENTAL_SETS[0]);
+constexpr uint16_t LOG_CHECKPOINT_INTERVAL = 16;
+
+struct Options {
+    uint32_t battles = 10000;
+    uint64_t seed = 0x12345678;
+    uint8_t level = 50;
+    uint16_t max_turns = engine::DEFAULT_MAX_TURNS;
+    unsigned threads = 0;
+    bool sweep = false;
+    bool ai = false;
+    bool crn = false;
+    const char* log_path = nullptr;
+    const char* replay_path = nullptr;
+    bool estimate = false;
+    uint16_t estimate_a = 0;
+    uint16_t estimate_b = 0;
+    double epsilon = 0.02;
+    double delta = 0.05;
+    uint64_t factory_runs = 0;
+    uint16_t factory_rounds = 10;
+    const char* matrix_path = nullptr;
+    bool fast = false;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--battles N | --sweep] [--seed S] [--level 50|100] "
+                 "[--max-turns T] [--threads J] [--log FILE] [--ai] [--crn]\n"
+                 "       %s --replay FILE\n"
+                 "       %s --estimate A B [--epsilon E] [--delta D] [--seed S] [--level L]\n"
+                 "       %s --factory RUNS [--rounds R] [--matrix FILE] [--fast] [--ai]\n",
+                 argv0, argv0, argv0, argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--sweep") == 0) {
+            options.sweep = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--ai") == 0) {
+            options.ai = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--crn") == 0) {
+            options.crn = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--fast") == 0) {
+            options.fast = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--log") == 0) {
+            options.log_path = argv[++i];
+            continue;
+        }
+        if (std::strcmp(arg, "--matrix") == 0) {
+            options.matrix_path = argv[++i];
+            continue;
+        }
+        if (std::strcmp(arg, "--replay") == 0) {
+            options.replay_path = argv[++i];
+            continue;
+        }
+        if (std::strcmp(arg, "--estimate") == 0) {
+            if (i + 2 >= argc) {
+                return false;
+            }
+            options.estimate = true;
+            options.estimate_a = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 0));
+            options.estimate_b = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 0));
+            continue;
+        }
+        if (std::strcmp(arg, "--epsilon") == 0) {
+            options.epsilon = std::strtod(argv[++i], nullptr);
+            continue;
+        }
+        if (std::strcmp(arg, "--delta") == 0) {
+            options.delta = std::strtod(argv[++i], nullptr);
+            continue;
+        }
+        unsigned long long value = std::strtoull(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--battles") == 0) {
+            options.battles = static_cast<uint32_t>(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = static_cast<uint64_t>(value);
+        } else if (std::strcmp(arg, "--level") == 0) {
+            options.level = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--max-turns") == 0) {
+            options.max_turns = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(arg, "--factory") == 0) {
+            options.factory_runs = static_cast<uint64_t>(value);
+        } else if (std::strcmp(arg, "--rounds") == 0) {
+            options.factory_rounds = static_cast<uint16_t>(value);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Random pairings; pairing i depends only on (seed, i)
+std::vector<engine::BatchJob> make_random_jobs(const Options& options) {
+    std::vector<engine::BatchJob> jobs(options.battles);
+
+    for (uint32_t i = 0; i < options.battles; ++i) {
+        auto& job = jobs[i];
+        job.seed = util::random::mix64(options.seed + i);
+
+        util::random::Rng pairing{};
+        pairing.seed(job.seed, ~job.seed);
+        job.rental_a = pairing.random(RENTAL_COUNT);
+        job.rental_b = pairing.random(RENTAL_COUNT);
+        job.level = options.level;
+        job.max_turns = options.max_turns;
+    }
+    return jobs;
+}
+
+/// Play every job, writing the concatenated battle logs to options.log_path
+bool run_logged(engine::BatchRunner& runner, const Options& options,
+                const std::vector<engine::BatchJob>& jobs,
+                std::vector<engine::BattleOutcome>& outcomes) {
+    std::vector<std::vector<uint8_t>> logs(jobs.size());
+    outcomes.resize(jobs.size());
+
+    runner.parallel_for(jobs.size(), [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            logs[i].resize(engine::log_capacity(jobs[i].max_turns, LOG_CHECKPOINT_INTERVAL));
+            engine::BattleLogWriter writer(logs[i].data(), logs[i].size(),
+                                           LOG_CHECKPOINT_INTERVAL);
+            outcomes[i] = engine::run_job(jobs[i], &writer);
+            logs[i].resize(writer.ok() ? writer.size() : 0);
+        }
+    });
+
+    std::FILE* file = std::fopen(options.log_path, "wb");
+    if (!file) {
+        std::perror(options.log_path);
+        return false;
+    }
+    size_t bytes = 0;
+    for (const auto& log : logs) {
+        bytes += std::fwrite(log.data(), 1, log.size(), file);
+    }
+    std::fclose(file);
+    std::printf("log bytes   %zu (%.2f per battle)\n", bytes,
+                jobs.empty() ? 0.0 : static_cast<double>(bytes) / jobs.size());
+    return true;
+}
+
+/// Re-execute every log in options.replay_path and report the statuses
+int replay_logs(const Options& options) {
+    std::FILE* file = std::fopen(options.replay_path, "rb");
+    if (!file) {
+        std::perror(options.replay_path);
+        return 1;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[1 << 16];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+        bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+
+    uint64_t replayed = 0;
+    uint64_t failed = 0;
+    uint64_t p1_wins = 0;
+    engine::BattleEngine battle;
+    for (size_t offset = 0; offset < bytes.size();) {
+        const size_t extent = engine::log_extent(bytes.data() + offset, bytes.size() - offset);
+        if (extent == 0) {
+            std::fprintf(stderr, "invalid log at byte %zu\n", offset);
+            return 1;
+        }
+        const auto status = battle.replay(engine::BattleLog{bytes.data() + offset, extent});
+        if (status != engine::ReplayStatus::OK) {
+            std::fprintf(stderr, "log %llu (byte %zu): replay status %u\n",
+                         static_cast<unsigned long long>(replayed), offset,
+                         static_cast<unsigned>(status));
+            ++failed;
+        }
+        p1_wins += battle.result() == engine::BattleResult::P1_WINS;
+        ++replayed;
+        offset += extent;
+    }
+
+    std::printf("replayed    %llu\n", static_cast<unsigned long long>(replayed));
+    std::printf("failed      %llu\n", static_cast<unsigned long long>(failed));
+    std::printf("p1 wins     %llu\n", static_cast<unsigned long long>(p1_wins));
+    return failed == 0 ? 0 : 1;
+}
+
+/// Sequential win-rate estimate of one matchup
+int estimate_matchup(const Options& options) {
+    if (options.estimate_a >= RENTAL_COUNT || options.estimate_b >= RENTAL_COUNT) {
+        std::fprintf(stderr, "rental index out of range (0-%u)\n", RENTAL_COUNT - 1u);
+        return 1;
+    }
+    engine::BatchRunner runner(options.threads);
+    engine::EstimateOptions estimate_options{};
+    estimate_options.seed = options.seed;
+    estimate_options.level = options.level;
+    estimate_options.max_turns = options.max_turns;
+
+    const engine::Policy policy_a =
+        options.ai ? engine::ai::search_policy : engine::random_move_policy;
+    const auto estimate = engine::estimate_win_rate(
+        runner, options.estimate_a, options.estimate_b, policy_a, engine::random_move_policy,
+        options.epsilon, options.delta, estimate_options);
+
+    std::printf("battles     %llu\n", static_cast<unsigned long long>(estimate.battles));
+    std::printf("p1 wins     %llu\n", static_cast<unsigned long long>(estimate.p1_wins));
+    std::printf("unfinished  %llu\n", static_cast<unsigned long long>(estimate.unfinished));
+    std::printf("win rate    %.4f [%.4f, %.4f]%s\n", estimate.win_rate, estimate.lower,
+                estimate.upper, estimate.converged ? "" : " (not converged)");
+    return 0;
+}
+
+/// Streak-length distribution of Battle Factory runs
+int simulate_factory(const Options& options) {
+    engine::MatchupMatrixView matrix;
+    if (options.matrix_path && !matrix.open(options.matrix_path)) {
+        std::fprintf(stderr, "%s: not a matchup matrix\n", options.matrix_path);
+        return 1;
+    }
+
+    engine::factory::RunOptions run_options{};
+    run_options.seed = options.seed;
+    run_options.level = options.level;
+    run_options.max_rounds = options.factory_rounds;
+    run_options.max_turns = options.max_turns;
+    if (options.ai) {
+        run_options.player = engine::ai::search_policy;
+    }
+    run_options.matrix = matrix.valid() ? &matrix : nullptr;
+    run_options.matrix_fast_path = options.fast;
+
+    const engine::factory::DraftStrategy& strategy =
+        matrix.valid() ? engine::factory::RATED_STRATEGY : engine::factory::RANDOM_STRATEGY;
+
+    engine::BatchRunner runner(options.threads);
+    engine::factory::RunSimulator simulator(runner, strategy, run_options);
+    if (options.fast && !simulator.fast_path()) {
+        std::printf("matrix does not match these settings: playing every fight\n");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto report = simulator.simulate(options.factory_runs);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("runs        %llu (%s draft%s)\n", static_cast<unsigned long long>(report.runs),
+                strategy.name, simulator.fast_path() ? ", matrix fights" : "");
+    std::printf("streak      mean %.2f  median %u  p90 %u  p99 %u\n", report.mean(),
+                report.quantile(0.5), report.quantile(0.9), report.quantile(0.99));
+    for (size_t round = 0; round < options.factory_rounds; ++round) {
+        uint64_t ended = 0;
+        for (size_t s = 0; s < engine::factory::BATTLES_PER_ROUND; ++s) {
+            ended += report.histogram[round * engine::factory::BATTLES_PER_ROUND + s];
+        }
+        std::printf("round %-5zu %llu runs ended\n", round + 1,
+                    static_cast<unsigned long long>(ended));
+    }
+    std::printf("max streak  %llu runs\n",
+                static_cast<unsigned long long>(report.histogram.back()));
+    std::printf("fights      %llu\n", static_cast<unsigned long long>(report.fights));
+    std::printf("elapsed     %.3f s\n", seconds);
+    std::printf("runs/s      %.0f\n", seconds > 0 ? report.runs / seconds : 0.0);
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (options.crn && options.log_path) {
+        std::fprintf(stderr, "--crn battles cannot be logged (the log has no mode bit)\n");
+        return 1;
+    }
+    if (options.replay_path) {
+        return replay_logs(options);
+    }
+    if (options.estimate) {
+        return estimate_matchup(options);
+    }
+    if (options.factory_runs) {
+        return simulate_factory(options);
+    }
+
+    std::vector<engine::BatchJob> jobs = options.sweep
+                                             ? engine::make_sweep_jobs(options.seed, options.level)
+                                             : make_random_jobs(options);
+    for (auto& job : jobs) {
+        if (options.ai) {
+            job.policy_a = engine::ai::search_policy;
+        }
+        job.common_random_numbers = options.crn;
+    }
+
+    engine::BatchRunner runner(options.threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<engine::BattleOutcome> outcomes;
+    if (options.log_path) {
+        if (!run_logged(runner, options, jobs, outcomes)) {
+            return 1;
+        }
+    } else {
+        outcomes = runner.run(jobs);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    const auto totals = engine::summarize(outcomes);
+    const double seconds = elapsed.count();
+    const double battles = static_cast<double>(jobs.size());
+
+    std::printf("battles     %zu\n", jobs.size());
+    std::printf("threads     %u\n", runner.thread_count());
+    std::printf("p1 wins     %llu\n", static_cast<unsigned long long>(totals.p1_wins));
+    std::printf("p2 wins     %llu\n", static_cast<unsigned long long>(totals.p2_wins));
+    std::printf("unfinished  %llu\n", static_cast<unsigned long long>(totals.unfinished));
+    std::printf("avg turns   %.2f\n", battles > 0 ? totals.turns / battles : 0.0);
+    std::printf("elapsed     %.3f s\n", seconds);
+    std::printf("battles/s   %.0f\n", seconds > 0 ? battles / seconds : 0.0);
+    return 0;
+}
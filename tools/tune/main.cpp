@@ -0,0 +1,140 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_tune - fits the search's evaluation weights to simulated games
+ *
+ * Plays random pairings, labels every turn-start position with the game's
+ * result and fits the fixed-point weights of engine::ai::evaluate() by
+ * Texel-style local search (engine/eval_tuning.hpp). Prints the fitted
+ * weights as a DEFAULT_EVAL_WEIGHTS initializer and, with --appvar, writes
+ * them in the calculator's format.
+ *
+ * Usage:
+ *   battlemon_tune [--games N] [--seed S] [--level L] [--max-turns T] [--threads J]
+ *                  [--policy random|greedy] [--scale K] [--passes P]
+ *   battlemon_tune ... --appvar   also write BMEVAL.bin (engine/eval.hpp) in the
+ *                                 working directory
+ *
+ * The AppVar is sent to the calculator after conversion, e.g.
+ * `convbin -j bin -k 8xv -r -n BMEVAL -i BMEVAL.bin -o BMEVAL.8xv` (-r: archived).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "engine/eval.hpp"
+#include "engine/eval_tuning.hpp"
+
+namespace {
+
+struct Options {
+    engine::EvalSampleOptions samples{};
+    engine::EvalTuneOptions tune{};
+    unsigned threads = 0;
+    bool appvar = false;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--games N] [--seed S] [--level 50|100] [--max-turns T] "
+                 "[--threads J]\n"
+                 "          [--policy random|greedy] [--scale K] [--passes P] [--appvar]\n",
+                 argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--appvar") == 0) {
+            options.appvar = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--policy") == 0) {
+            const char* name = argv[++i];
+            engine::Policy policy = nullptr;
+            if (std::strcmp(name, "random") == 0) {
+                policy = engine::random_move_policy;
+            } else if (std::strcmp(name, "greedy") == 0) {
+                policy = engine::greedy_damage_policy;
+            } else {
+                return false;
+            }
+            options.samples.policy_a = policy;
+            options.samples.policy_b = policy;
+            continue;
+        }
+        if (std::strcmp(arg, "--scale") == 0) {
+            options.tune.scale = std::strtod(argv[++i], nullptr);
+            continue;
+        }
+        unsigned long long value = std::strtoull(argv[++i], nullptr, 0);
+
+        if (std::strcmp(arg, "--games") == 0) {
+            options.samples.games = static_cast<uint32_t>(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.samples.seed = static_cast<uint64_t>(value);
+        } else if (std::strcmp(arg, "--level") == 0) {
+            options.samples.level = static_cast<uint8_t>(value);
+        } else if (std::strcmp(arg, "--max-turns") == 0) {
+            options.samples.max_turns = static_cast<uint16_t>(value);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(arg, "--passes") == 0) {
+            options.tune.max_passes = static_cast<uint16_t>(value);
+        } else {
+            return false;
+        }
+    }
+    return options.samples.games > 0 && options.tune.scale > 0.0;
+}
+
+void print_weights(const char* label, const engine::ai::EvalWeights& weights) {
+    std::printf("%-18s{{", label);
+    for (uint8_t f = 0; f < engine::ai::EVAL_FEATURE_COUNT; ++f) {
+        std::printf(f == 0 ? "%d" : ", %d", weights.weight[f]);
+    }
+    std::printf("}}\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    engine::BatchRunner runner(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    const auto samples = engine::collect_eval_samples(runner, options.samples);
+    const double start_loss = engine::eval_loss(runner, samples, engine::ai::DEFAULT_EVAL_WEIGHTS,
+                                                options.tune.scale);
+
+    double loss = 0.0;
+    const engine::ai::EvalWeights weights = engine::tune_eval_weights(
+        runner, samples, engine::ai::DEFAULT_EVAL_WEIGHTS, options.tune, loss);
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("games:            %u\n", options.samples.games);
+    std::printf("positions:        %zu\n", samples.size());
+    std::printf("loss:             %.6f -> %.6f\n", start_loss, loss);
+    print_weights("default weights:", engine::ai::DEFAULT_EVAL_WEIGHTS);
+    print_weights("fitted weights:", weights);
+    std::printf("elapsed:          %.3f s\n", seconds);
+
+    if (options.appvar) {
+        if (!engine::ai::write_eval_weights(weights)) {
+            std::fprintf(stderr, "cannot write the %s AppVar\n", engine::ai::EVAL_APPVAR);
+            return 1;
+        }
+        std::printf("written:          %s.bin\n", engine::ai::EVAL_APPVAR);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file main.cpp
+ * @brief battlemon_usage - which effects, commands, transitions and items battles run
+ *
+ * Joins the rental pool with the move table (how many rental move slots
+ * reach each effect, how many sets hold each item) and, given battle logs,
+ * replays them to count what actually executes (engine/usage_report.hpp).
+ * Rows are sorted by battle count, so the top of each table is where
+ * per-turn latency goes; read it next to a battlemon_profile cycle report,
+ * whose transition and item sections the rows are named after.
+ *
+ * Usage:
+ *   battlemon_usage [--log FILE] [--top N]
+ *
+ * FILE is a log written by `battlemon_sim --log` (any policy). Without one
+ * only the rental weights are reported. --top limits every table to its
+ * first N rows (default 20, 0 = all).
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "engine/usage_report.hpp"
+
+namespace {
+
+struct Options {
+    const char* log_path = nullptr;
+    size_t top = 20;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr, "usage: %s [--log FILE] [--top N]\n", argv0);
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (std::strcmp(arg, "--log") == 0) {
+            options.log_path = argv[++i];
+        } else if (std::strcmp(arg, "--top") == 0) {
+            options.top = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool read_file(const char* path, std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t chunk[1 << 16];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+        bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    return true;
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+/**
+ * @brief Print one table.
+ *
+ * @param rental_total Denominator of the rental share column
+ * @param battle_total Denominator of the battle share column
+ * @param exposure Print the holder-turn column (items)
+ */
+void print_table(const char* title, const char* detail,
+                 const std::vector<engine::usage::UsageRow>& rows, const Options& options,
+                 uint64_t rental_total, uint64_t battle_total, uint64_t turns,
+                 bool exposure = false) {
+    const size_t count = options.top == 0 || options.top > rows.size() ? rows.size() : options.top;
+    int width = 28;
+    for (size_t i = 0; i < count; ++i) {
+        width = std::max(width, static_cast<int>(rows[i].name.size()));
+    }
+
+    std::printf("\n%s\n", title);
+    std::printf("  %-*s %-22s %7s %6s %10s %6s %8s", width, "name", detail, "rental", "%",
+                "battle", "%", "/turn");
+    if (exposure) {
+        std::printf(" %10s", "held turns");
+    }
+    std::printf("\n");
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& row = rows[i];
+        std::printf("  %-*s %-22s %7llu %5.1f%% %10llu %5.1f%% %8.3f", width, row.name.c_str(),
+                    row.detail.c_str(), static_cast<unsigned long long>(row.rental),
+                    percent(row.rental, rental_total), static_cast<unsigned long long>(row.battle),
+                    percent(row.battle, battle_total),
+                    turns > 0 ? static_cast<double>(row.battle) / static_cast<double>(turns)
+                              : 0.0);
+        if (exposure) {
+            std::printf(" %10llu", static_cast<unsigned long long>(row.exposure));
+        }
+        std::printf("\n");
+    }
+    if (count < rows.size()) {
+        std::printf("  ... %zu more\n", rows.size() - count);
+    }
+}
+
+uint64_t battle_total(const std::vector<engine::usage::UsageRow>& rows) {
+    uint64_t total = 0;
+    for (const auto& row : rows) {
+        total += row.battle;
+    }
+    return total;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    engine::usage::UsageCounts counts;
+    if (options.log_path) {
+        std::vector<uint8_t> bytes;
+        if (!read_file(options.log_path, bytes)) {
+            std::perror(options.log_path);
+            return 1;
+        }
+        if (!engine::usage::tally_logs(bytes.data(), bytes.size(), counts)) {
+            std::fprintf(stderr, "%s: invalid log after %llu battles\n", options.log_path,
+                         static_cast<unsigned long long>(counts.battles));
+            return 1;
+        }
+    }
+
+    const engine::usage::UsageReport report = engine::usage::build_report(counts);
+    std::printf("rental slots %llu\n", static_cast<unsigned long long>(report.rental_slots));
+    std::printf("battles      %llu (%llu failed to replay)\n",
+                static_cast<unsigned long long>(counts.battles),
+                static_cast<unsigned long long>(counts.failed));
+    std::printf("turns        %llu\n", static_cast<unsigned long long>(counts.turns));
+    if (counts.dropped_events > 0) {
+        std::printf("dropped      %llu events (not counted)\n",
+                    static_cast<unsigned long long>(counts.dropped_events));
+    }
+    if (options.log_path && counts.turns > 0 && battle_total(report.effects) == 0) {
+        std::printf("note         no events recorded: built with BATTLEMON_BATTLE_EVENTS=0?\n");
+    }
+
+    const uint64_t effect_runs = battle_total(report.effects);
+    print_table("effects", "routine", report.effects, options, report.rental_slots, effect_runs,
+                counts.turns);
+    print_table("stubs (TODO effects running Hit)", "routine", report.stubs, options,
+                report.rental_slots, effect_runs, counts.turns);
+    print_table("commands (from routine bodies)", "", report.commands, options,
+                report.rental_slots, effect_runs, counts.turns);
+    print_table("stage transitions (profiler sections)", "", report.transitions, options,
+                report.rental_slots, effect_runs, counts.turns);
+
+    uint64_t holders = 0;
+    for (const auto& row : report.items) {
+        holders += row.rental;
+    }
+    print_table("items (battle: activations)", "handled events", report.items, options, holders,
+                battle_total(report.items), counts.turns, true);
+    return 0;
+}